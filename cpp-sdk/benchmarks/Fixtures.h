@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+#include "dataapi/Types.h"
+
+namespace dataapi {
+namespace bench {
+
+/**
+ * 工作流分页响应体，items条记录
+ */
+inline std::string workflowPageJson(size_t items) {
+    Json content = Json::array();
+    for (size_t i = 0; i < items; ++i) {
+        content.push_back({
+            {"id", "wf-" + std::to_string(i)},
+            {"name", "Nightly export " + std::to_string(i)},
+            {"description", "Exports the orders table to the warehouse"},
+            {"definition", R"({"nodes":[{"id":"start","type":"trigger"},{"id":"sql","type":"query"}],"edges":[["start","sql"]]})"},
+            {"projectId", "proj-42"},
+            {"userId", "user-7"},
+            {"createTime", "2024-05-01T08:00:00Z"},
+            {"updateTime", "2024-05-02T09:30:00Z"},
+            {"status", 1},
+            {"version", 3}
+        });
+    }
+    Json page = {
+        {"content", std::move(content)},
+        {"pageNumber", 0},
+        {"pageSize", items},
+        {"totalElements", items},
+        {"totalPages", 1},
+        {"first", true},
+        {"last", true},
+        {"empty", items == 0}
+    };
+    return page.dump();
+}
+
+/**
+ * 查询结果响应体，rows行6列
+ */
+inline std::string queryResultJson(size_t rows) {
+    Json data = Json::array();
+    for (size_t i = 0; i < rows; ++i) {
+        data.push_back({
+            {"id", i},
+            {"customer", "customer-" + std::to_string(i % 97)},
+            {"amount", 19.99 + static_cast<double>(i)},
+            {"currency", "CNY"},
+            {"paid", i % 3 != 0},
+            {"createdAt", "2024-05-01T08:00:00Z"}
+        });
+    }
+    Json result = {
+        {"rows", std::move(data)},
+        {"columns", {"id", "customer", "amount", "currency", "paid", "createdAt"}},
+        {"totalRows", rows},
+        {"metadata", {{"executionTime", 12}}}
+    };
+    return result.dump();
+}
+
+} // namespace bench
+} // namespace dataapi
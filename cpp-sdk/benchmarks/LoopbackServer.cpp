@@ -0,0 +1,221 @@
+#include "LoopbackServer.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace dataapi {
+namespace bench {
+
+namespace {
+
+const char* reasonPhrase(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 201: return "Created";
+        case 204: return "No Content";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 429: return "Too Many Requests";
+        case 500: return "Internal Server Error";
+        case 503: return "Service Unavailable";
+        default: return "Unknown";
+    }
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    return a.size() == b.size() &&
+           std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+               return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+           });
+}
+
+std::string_view trim(std::string_view value) {
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) value.remove_prefix(1);
+    while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) value.remove_suffix(1);
+    return value;
+}
+
+bool sendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
+LoopbackServer::LoopbackServer(Response defaultResponse)
+    : defaultRendered(render(defaultResponse)) {
+    listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        throw std::runtime_error("LoopbackServer: socket() failed");
+    }
+    int on = 1;
+    ::setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    socklen_t length = sizeof(address);
+    if (::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listenFd, SOMAXCONN) != 0 ||
+        ::getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        ::close(listenFd);
+        throw std::runtime_error("LoopbackServer: cannot listen on 127.0.0.1");
+    }
+    port = ntohs(address.sin_port);
+    acceptor = std::thread([this] { acceptLoop(); });
+}
+
+LoopbackServer::~LoopbackServer() {
+    stopping = true;
+    ::shutdown(listenFd, SHUT_RDWR);
+    acceptor.join();
+    ::close(listenFd);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int fd : connections) {
+            ::shutdown(fd, SHUT_RDWR);
+        }
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void LoopbackServer::route(const std::string& path, Response response) {
+    std::string rendered = render(response);
+    std::lock_guard<std::mutex> lock(mutex);
+    routes[path] = std::move(rendered);
+}
+
+std::string LoopbackServer::getBaseUrl() const {
+    return "http://127.0.0.1:" + std::to_string(port);
+}
+
+std::string LoopbackServer::render(const Response& response) {
+    std::string rendered = "HTTP/1.1 " + std::to_string(response.status) + " " + reasonPhrase(response.status) + "\r\n";
+    if (!response.contentType.empty()) {
+        rendered += "Content-Type: " + response.contentType + "\r\n";
+    }
+    rendered += "Content-Length: " + std::to_string(response.body.size()) + "\r\n";
+    rendered += "Connection: keep-alive\r\n\r\n";
+    rendered += response.body;
+    return rendered;
+}
+
+void LoopbackServer::acceptLoop() {
+    while (!stopping) {
+        int fd = ::accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (stopping) {
+                return;
+            }
+            continue;
+        }
+        int on = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) {
+            ::close(fd);
+            return;
+        }
+        connections.push_back(fd);
+        workers.emplace_back([this, fd] { serve(fd); });
+    }
+}
+
+void LoopbackServer::serve(int fd) {
+    std::string buffer;
+    char chunk[16 * 1024];
+    bool keepAlive = true;
+
+    while (keepAlive && !stopping) {
+        size_t headerEnd;
+        while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+            ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+            if (n <= 0) {
+                keepAlive = false;
+                break;
+            }
+            buffer.append(chunk, static_cast<size_t>(n));
+        }
+        if (!keepAlive) {
+            break;
+        }
+
+        std::string_view head(buffer.data(), headerEnd);
+        size_t lineEnd = head.find("\r\n");
+        std::string_view requestLine = head.substr(0, lineEnd);
+        size_t pathStart = requestLine.find(' ');
+        size_t pathEnd = requestLine.find(' ', pathStart + 1);
+        std::string_view target = pathStart == std::string_view::npos
+            ? std::string_view()
+            : requestLine.substr(pathStart + 1, pathEnd - pathStart - 1);
+        std::string path(target.substr(0, target.find('?')));
+
+        size_t contentLength = 0;
+        while (lineEnd != std::string_view::npos && lineEnd < head.size()) {
+            size_t next = head.find("\r\n", lineEnd + 2);
+            std::string_view line = head.substr(lineEnd + 2, next == std::string_view::npos ? std::string_view::npos : next - lineEnd - 2);
+            size_t colon = line.find(':');
+            if (colon != std::string_view::npos) {
+                std::string_view name = trim(line.substr(0, colon));
+                std::string_view value = trim(line.substr(colon + 1));
+                if (equalsIgnoreCase(name, "Content-Length")) {
+                    contentLength = std::strtoul(std::string(value).c_str(), nullptr, 10);
+                } else if (equalsIgnoreCase(name, "Connection") && equalsIgnoreCase(value, "close")) {
+                    keepAlive = false;
+                }
+            }
+            lineEnd = next;
+        }
+
+        size_t requestSize = headerEnd + 4 + contentLength;
+        while (buffer.size() < requestSize) {
+            ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+            if (n <= 0) {
+                keepAlive = false;
+                break;
+            }
+            buffer.append(chunk, static_cast<size_t>(n));
+        }
+        if (buffer.size() < requestSize) {
+            break;
+        }
+        buffer.erase(0, requestSize);
+
+        const std::string* response = &defaultRendered;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = routes.find(path);
+            if (it != routes.end()) {
+                response = &it->second;
+            }
+        }
+        requestCount.fetch_add(1, std::memory_order_relaxed);
+        if (!sendAll(fd, *response)) {
+            break;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    connections.erase(std::remove(connections.begin(), connections.end(), fd), connections.end());
+    ::close(fd);
+}
+
+} // namespace bench
+} // namespace dataapi
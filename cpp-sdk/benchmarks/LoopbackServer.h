@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dataapi {
+namespace bench {
+
+/**
+ * 嵌入式回环HTTP/1.1服务器，返回预置响应
+ *
+ * 监听127.0.0.1的临时端口，每个连接一个线程，支持keep-alive和Content-Length请求体。
+ * 按路径（不含查询串）匹配预置响应，未匹配时返回默认响应。只用于基准测试和压测，
+ * 不解析分块请求体，也不支持HTTP/2（客户端开启HTTP/2时在明文连接上回落到HTTP/1.1）。
+ */
+class LoopbackServer {
+public:
+    struct Response {
+        int status = 200;
+        std::string contentType = "application/json";
+        std::string body;
+    };
+
+    /**
+     * 构造并开始监听，失败时抛出std::runtime_error
+     * @param defaultResponse 未匹配路径时的响应
+     */
+    explicit LoopbackServer(Response defaultResponse);
+
+    /**
+     * 停止监听并关闭全部连接
+     */
+    ~LoopbackServer();
+
+    LoopbackServer(const LoopbackServer&) = delete;
+    LoopbackServer& operator=(const LoopbackServer&) = delete;
+
+    /**
+     * 设置路径的预置响应，应在发出请求前调用
+     */
+    void route(const std::string& path, Response response);
+
+    uint16_t getPort() const { return port; }
+
+    /**
+     * 基础URL，例如http://127.0.0.1:40123
+     */
+    std::string getBaseUrl() const;
+
+    /**
+     * 已处理的请求数
+     */
+    uint64_t getRequestCount() const { return requestCount.load(std::memory_order_relaxed); }
+
+private:
+    void acceptLoop();
+    void serve(int fd);
+    static std::string render(const Response& response);
+
+    int listenFd = -1;
+    uint16_t port = 0;
+    std::atomic<bool> stopping{false};
+    std::atomic<uint64_t> requestCount{0};
+    const std::string defaultRendered;
+    std::mutex mutex;
+    std::map<std::string, std::string> routes; // 路径 -> 已渲染的完整响应
+    std::vector<int> connections;
+    std::vector<std::thread> workers;
+    std::thread acceptor;
+};
+
+} // namespace bench
+} // namespace dataapi
@@ -0,0 +1,40 @@
+#include <benchmark/benchmark.h>
+#include "Fixtures.h"
+#include "client/ResponseDecoder.h"
+
+using namespace dataapi;
+
+static http::HttpResponse makeResponse(const std::string& body) {
+    http::HttpResponse response;
+    response.statusCode = 200;
+    response.body = body;
+    return response;
+}
+
+// 参数：分页中的记录数
+static void BM_DecodeWorkflowPage(benchmark::State& state) {
+    const std::string body = bench::workflowPageJson(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto response = makeResponse(body);
+        state.ResumeTiming();
+        auto page = client::detail::decodePage<SysWorkflow>(std::move(response));
+        benchmark::DoNotOptimize(page);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * body.size()));
+}
+BENCHMARK(BM_DecodeWorkflowPage)->Arg(10)->Arg(100)->Arg(1000);
+
+// 参数：结果行数
+static void BM_DecodeQueryResult(benchmark::State& state) {
+    const std::string body = bench::queryResultJson(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto response = makeResponse(body);
+        state.ResumeTiming();
+        auto result = client::detail::decode<QueryResult>(std::move(response));
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * body.size()));
+}
+BENCHMARK(BM_DecodeQueryResult)->Arg(10)->Arg(1000)->Arg(10000);
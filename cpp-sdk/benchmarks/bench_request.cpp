@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include "dataapi/http/ResponseHeaders.h"
+#include "dataapi/utils/UrlUtils.h"
+#include "client/ResponseDecoder.h"
+
+using namespace dataapi;
+
+// 构建并序列化一个创建工作流的请求
+static void BM_BuildJsonRequest(benchmark::State& state) {
+    for (auto _ : state) {
+        Json payload = {
+            {"name", "Nightly export"},
+            {"description", "Exports the orders table to the warehouse"},
+            {"definition", R"({"nodes":[{"id":"start","type":"trigger"}],"edges":[]})"},
+            {"projectId", "proj-42"}
+        };
+        auto request = client::detail::jsonRequest(HttpMethod::POST, "/workflows", std::move(payload));
+        request.headers["X-Request-Id"] = "3f2a9c1e-6b1d-4d8e-9a57-0c4b5e7f8a21";
+        std::string body = request.data.dump();
+        benchmark::DoNotOptimize(body);
+    }
+}
+BENCHMARK(BM_BuildJsonRequest);
+
+static void BM_BuildQueryString(benchmark::State& state) {
+    Parameters params = {
+        {"page", "3"},
+        {"size", "50"},
+        {"projectId", "proj-42"},
+        {"search", "nightly export & sync"},
+        {"sort", "updateTime,desc"}
+    };
+    for (auto _ : state) {
+        std::string url = "/workflows?" + utils::UrlUtils::buildQueryString(params);
+        benchmark::DoNotOptimize(url);
+    }
+}
+BENCHMARK(BM_BuildQueryString);
+
+// 参数：输入长度；一半字符需要转义
+static void BM_UrlEncode(benchmark::State& state) {
+    std::string input;
+    while (input.size() < static_cast<size_t>(state.range(0))) {
+        input += "order id/";
+    }
+    input.resize(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        std::string encoded = utils::UrlUtils::encode(input);
+        benchmark::DoNotOptimize(encoded);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_UrlEncode)->Arg(16)->Arg(256)->Arg(4096);
+
+// 解析一组典型的响应头并查找其中几个
+static void BM_ParseResponseHeaders(benchmark::State& state) {
+    static const char* const lines[] = {
+        "HTTP/1.1 200 OK\r\n",
+        "Date: Wed, 01 May 2024 08:00:00 GMT\r\n",
+        "Content-Type: application/json; charset=utf-8\r\n",
+        "Content-Length: 18234\r\n",
+        "Connection: keep-alive\r\n",
+        "Cache-Control: no-cache\r\n",
+        "ETag: \"5d8c72a5edda8d6a\"\r\n",
+        "Vary: Accept-Encoding\r\n",
+        "X-Request-Id: 3f2a9c1e-6b1d-4d8e-9a57-0c4b5e7f8a21\r\n",
+        "X-RateLimit-Limit: 1000\r\n",
+        "X-RateLimit-Remaining: 998\r\n",
+        "Strict-Transport-Security: max-age=31536000\r\n",
+        "\r\n"
+    };
+    size_t lengths[sizeof(lines) / sizeof(lines[0])];
+    for (size_t i = 0; i < sizeof(lines) / sizeof(lines[0]); ++i) {
+        lengths[i] = std::strlen(lines[i]);
+    }
+    http::ResponseHeaders headers;
+    for (auto _ : state) {
+        for (size_t i = 0; i < sizeof(lines) / sizeof(lines[0]); ++i) {
+            headers.append(lines[i], lengths[i]);
+        }
+        benchmark::DoNotOptimize(headers.get("content-type"));
+        benchmark::DoNotOptimize(headers.get("etag"));
+        benchmark::DoNotOptimize(headers.get("retry-after"));
+    }
+}
+BENCHMARK(BM_ParseResponseHeaders);
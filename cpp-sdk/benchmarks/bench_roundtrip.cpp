@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include "Fixtures.h"
+#include "LoopbackServer.h"
+#include "dataapi/ClientConfig.h"
+#include "dataapi/http/HttpClient.h"
+#include "dataapi/http/Transport.h"
+#include "client/ResponseDecoder.h"
+
+using namespace dataapi;
+
+static bench::LoopbackServer& server() {
+    static bench::LoopbackServer instance({200, "application/json", bench::workflowPageJson(20)});
+    return instance;
+}
+
+static std::unique_ptr<http::HttpClient> makeClient(int poolSize) {
+    ClientConfig config;
+    config.baseUrl = server().getBaseUrl();
+    config.connectionPoolSize = poolSize;
+    config.enableRetry = false;
+    return std::make_unique<http::HttpClient>(config, nullptr);
+}
+
+// 同步GET并解码分页，经由回环连接（含libcurl、连接复用与解码的完整路径）
+static void BM_RoundTripGetPage(benchmark::State& state) {
+    auto client = makeClient(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        auto response = client->get("/workflows", Parameters{{"page", "0"}, {"size", "20"}});
+        auto page = client::detail::decodePage<SysWorkflow>(std::move(response));
+        benchmark::DoNotOptimize(page);
+    }
+}
+BENCHMARK(BM_RoundTripGetPage)->Arg(1)->Arg(10)->UseRealTime();
+
+// 异步请求，每轮state.range(0)个请求在途
+static void BM_RoundTripAsyncBatch(benchmark::State& state) {
+    auto client = makeClient(static_cast<int>(state.range(0)));
+    std::vector<std::future<http::HttpResponse>> inFlight;
+    for (auto _ : state) {
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            HttpRequestConfig request;
+            request.method = HttpMethod::GET;
+            request.url = "/workflows";
+            inFlight.push_back(client->requestAsync(std::move(request)));
+        }
+        for (auto& future : inFlight) {
+            benchmark::DoNotOptimize(future.get());
+        }
+        inFlight.clear();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_RoundTripAsyncBatch)->Arg(8)->Arg(32)->UseRealTime();
+
+// 同样的请求经进程内传输完成，衡量客户端自身（重试、头部合并、指标、解码）的开销
+static void BM_InMemoryGetPage(benchmark::State& state) {
+    const std::string body = bench::workflowPageJson(20);
+    ClientConfig config("http://sidecar");
+    config.enableRetry = false;
+    config.transport = std::make_shared<http::InMemoryTransport>([&body](const http::TransportRequest&) {
+        http::HttpResponse response;
+        response.statusCode = 200;
+        response.body = body;
+        return response;
+    });
+    http::HttpClient client(config, nullptr);
+    for (auto _ : state) {
+        auto response = client.get("/workflows", Parameters{{"page", "0"}, {"size", "20"}});
+        auto page = client::detail::decodePage<SysWorkflow>(std::move(response));
+        benchmark::DoNotOptimize(page);
+    }
+}
+BENCHMARK(BM_InMemoryGetPage);
@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include "dataapi/utils/StringUtils.h"
+#include "dataapi/utils/UrlUtils.h"
+
+using namespace dataapi;
+using utils::StringUtils;
+using utils::UrlUtils;
+
+// 参数：值的长度；大部分字节无需编码，每32字节一个空格（逐字节转义的情形见bench_request.cpp）
+static std::string queryValue(size_t length) {
+    std::string value;
+    for (size_t i = 0; i < length; ++i) {
+        value += (i % 32 == 31) ? ' ' : "nightly-export_orders.2024~"[i % 27];
+    }
+    return value;
+}
+
+static void BM_UrlEncodeSparse(benchmark::State& state) {
+    const std::string value = queryValue(static_cast<size_t>(state.range(0)));
+    std::string out;
+    for (auto _ : state) {
+        out.clear();
+        UrlUtils::appendEncoded(out, value);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * value.size()));
+}
+BENCHMARK(BM_UrlEncodeSparse)->Arg(16)->Arg(256)->Arg(4096);
+
+static void BM_UrlDecode(benchmark::State& state) {
+    const std::string encoded = UrlUtils::encode(queryValue(static_cast<size_t>(state.range(0))));
+    std::string out;
+    for (auto _ : state) {
+        out.clear();
+        UrlUtils::appendDecoded(out, encoded);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * encoded.size()));
+}
+BENCHMARK(BM_UrlDecode)->Arg(16)->Arg(256)->Arg(4096);
+
+static const char kQuery[] = "page=3&size=50&projectId=proj-42&search=nightly%20export%20%26%20sync&sort=updateTime%2Cdesc";
+
+static void BM_ParseQueryString(benchmark::State& state) {
+    const std::string query = kQuery;
+    for (auto _ : state) {
+        auto params = UrlUtils::parseQueryString(query);
+        benchmark::DoNotOptimize(params);
+    }
+}
+BENCHMARK(BM_ParseQueryString);
+
+static void BM_VisitQueryParams(benchmark::State& state) {
+    std::string value;
+    for (auto _ : state) {
+        size_t total = 0;
+        UrlUtils::forEachQueryParam(kQuery, [&](std::string_view, std::string_view raw) {
+            value.clear();
+            UrlUtils::appendDecoded(value, raw);
+            total += value.size();
+        });
+        benchmark::DoNotOptimize(total);
+    }
+}
+BENCHMARK(BM_VisitQueryParams);
+
+static const char kHeaderList[] = "gzip, deflate, br, zstd, identity, compress, x-gzip, x-compress";
+
+static void BM_SplitVector(benchmark::State& state) {
+    const std::string list = kHeaderList;
+    for (auto _ : state) {
+        auto pieces = StringUtils::split(list, ',');
+        benchmark::DoNotOptimize(pieces);
+    }
+}
+BENCHMARK(BM_SplitVector);
+
+static void BM_SplitView(benchmark::State& state) {
+    for (auto _ : state) {
+        size_t count = 0;
+        for (std::string_view piece : StringUtils::splitView(kHeaderList, ',')) {
+            count += StringUtils::trimView(piece).size();
+        }
+        benchmark::DoNotOptimize(count);
+    }
+}
+BENCHMARK(BM_SplitView);
+
+// 参数：字符串长度
+static void BM_ToLowerInPlace(benchmark::State& state) {
+    const std::string source = queryValue(static_cast<size_t>(state.range(0)));
+    std::string value;
+    for (auto _ : state) {
+        value = source;
+        StringUtils::toLowerInPlace(value);
+        benchmark::DoNotOptimize(value.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * source.size()));
+}
+BENCHMARK(BM_ToLowerInPlace)->Arg(16)->Arg(256)->Arg(4096);
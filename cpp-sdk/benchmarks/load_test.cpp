@@ -0,0 +1,301 @@
+// 压测驱动：按给定并发向回环服务器（或--url指定的服务器）发送请求，报告吞吐量和延迟分位数
+//
+// 用法：dataapi_loadtest [--concurrency N] [--requests N | --duration 秒] [--mode sync|async]
+//                         [--pool N] [--http2] [--path /workflows] [--items N] [--warmup N] [--url URL]
+//                         [--unix-socket PATH]
+//
+// sync模式：N个线程各自阻塞调用get()；async模式：单个线程通过requestAsync保持N个请求在途。
+// 比较连接池大小、HTTP/2、simdjson后端（DATAAPI_ENABLE_SIMDJSON）等配置时，固定其余参数分别运行。
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Fixtures.h"
+#include "LoopbackServer.h"
+#include "dataapi/ClientConfig.h"
+#include "dataapi/http/HttpClient.h"
+#include "client/ResponseDecoder.h"
+
+using namespace dataapi;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Options {
+    int concurrency = 16;
+    long requests = 20000;
+    double duration = 0; // 秒，大于0时按时长运行并忽略requests
+    bool async = false;
+    int pool = 0; // 0表示等于并发数
+    bool http2 = false;
+    std::string path = "/workflows";
+    size_t items = 20;
+    long warmup = 200;
+    std::string url;
+    std::string unixSocket; // 经Unix域套接字连接--url指定的服务（例如同机的sidecar）
+};
+
+[[noreturn]] void usage(const char* program) {
+    std::fprintf(stderr,
+                 "usage: %s [--concurrency N] [--requests N | --duration SECONDS] [--mode sync|async]\n"
+                 "          [--pool N] [--http2] [--path PATH] [--items N] [--warmup N] [--url URL]\n"
+                 "          [--unix-socket PATH]\n",
+                 program);
+    std::exit(2);
+}
+
+Options parseOptions(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> const char* {
+            if (i + 1 >= argc) {
+                usage(argv[0]);
+            }
+            return argv[++i];
+        };
+        if (arg == "--concurrency") {
+            options.concurrency = std::max(1, std::atoi(value()));
+        } else if (arg == "--requests") {
+            options.requests = std::max(1L, std::atol(value()));
+        } else if (arg == "--duration") {
+            options.duration = std::atof(value());
+        } else if (arg == "--mode") {
+            std::string mode = value();
+            if (mode != "sync" && mode != "async") {
+                usage(argv[0]);
+            }
+            options.async = mode == "async";
+        } else if (arg == "--pool") {
+            options.pool = std::atoi(value());
+        } else if (arg == "--http2") {
+            options.http2 = true;
+        } else if (arg == "--path") {
+            options.path = value();
+        } else if (arg == "--items") {
+            options.items = static_cast<size_t>(std::atol(value()));
+        } else if (arg == "--warmup") {
+            options.warmup = std::atol(value());
+        } else if (arg == "--url") {
+            options.url = value();
+        } else if (arg == "--unix-socket") {
+            options.unixSocket = value();
+        } else {
+            usage(argv[0]);
+        }
+    }
+    if (!options.unixSocket.empty() && options.url.empty()) {
+        options.url = "http://localhost";
+    }
+    if (options.pool <= 0) {
+        options.pool = options.concurrency;
+    }
+    return options;
+}
+
+/**
+ * 请求配额：按次数或截止时间分发请求名额，线程安全
+ */
+class Budget {
+public:
+    Budget(long requests, std::optional<Clock::time_point> deadline)
+        : remaining(requests), deadline(deadline) {}
+
+    bool take() {
+        if (deadline) {
+            return Clock::now() < *deadline;
+        }
+        return remaining.fetch_sub(1, std::memory_order_relaxed) > 0;
+    }
+
+private:
+    std::atomic<long> remaining;
+    std::optional<Clock::time_point> deadline;
+};
+
+struct Samples {
+    std::vector<double> latencies; // 微秒
+    long errors = 0;
+
+    void record(Clock::time_point start, bool ok) {
+        latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+        if (!ok) {
+            ++errors;
+        }
+    }
+
+    void merge(Samples&& other) {
+        latencies.insert(latencies.end(), other.latencies.begin(), other.latencies.end());
+        errors += other.errors;
+    }
+};
+
+bool consume(http::HttpResponse&& response) {
+    if (!response.isSuccess()) {
+        return false;
+    }
+    // 计入解码开销，使--items和simdjson后端的差异反映在结果中
+    client::detail::parseBody(std::move(response));
+    return true;
+}
+
+Samples runSync(http::HttpClient& client, const Options& options, Budget& budget) {
+    std::vector<Samples> perThread(static_cast<size_t>(options.concurrency));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < options.concurrency; ++t) {
+        threads.emplace_back([&, t] {
+            Samples& samples = perThread[static_cast<size_t>(t)];
+            while (budget.take()) {
+                auto start = Clock::now();
+                bool ok = false;
+                try {
+                    ok = consume(client.get(options.path));
+                } catch (...) {
+                }
+                samples.record(start, ok);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    Samples all;
+    for (auto& samples : perThread) {
+        all.merge(std::move(samples));
+    }
+    return all;
+}
+
+Samples runAsync(http::HttpClient& client, const Options& options, Budget& budget) {
+    struct State {
+        std::mutex mutex;
+        std::condition_variable done;
+        int inFlight = 0;
+        Samples samples;
+    };
+    auto state = std::make_shared<State>();
+
+    // 完成回调在引擎线程上立即补发下一个请求，保持并发数不变
+    std::function<void()> issue = [&client, &options, &budget, state, &issue] {
+        if (!budget.take()) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (--state->inFlight == 0) {
+                state->done.notify_all();
+            }
+            return;
+        }
+        auto start = Clock::now();
+        HttpRequestConfig request;
+        request.method = HttpMethod::GET;
+        request.url = options.path;
+        try {
+            client.requestAsync(std::move(request),
+                                [state, start, &issue](http::HttpResponse response, std::exception_ptr error) {
+                                    bool ok = false;
+                                    if (!error) {
+                                        try {
+                                            ok = consume(std::move(response));
+                                        } catch (...) {
+                                        }
+                                    }
+                                    {
+                                        std::lock_guard<std::mutex> lock(state->mutex);
+                                        state->samples.record(start, ok);
+                                    }
+                                    issue();
+                                });
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->samples.record(start, false);
+            if (--state->inFlight == 0) {
+                state->done.notify_all();
+            }
+        }
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->inFlight = options.concurrency;
+    }
+    for (int i = 0; i < options.concurrency; ++i) {
+        issue();
+    }
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&] { return state->inFlight == 0; });
+    return std::move(state->samples);
+}
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options = parseOptions(argc, argv);
+
+    std::unique_ptr<bench::LoopbackServer> server;
+    std::string baseUrl = options.url;
+    if (baseUrl.empty()) {
+        server = std::make_unique<bench::LoopbackServer>(
+            bench::LoopbackServer::Response{200, "application/json", bench::workflowPageJson(options.items)});
+        baseUrl = server->getBaseUrl();
+    }
+
+    ClientConfig config;
+    config.baseUrl = baseUrl;
+    config.connectionPoolSize = options.pool;
+    config.enableHttp2 = options.http2;
+    config.enableRetry = false;
+    config.unixSocketPath = options.unixSocket;
+    http::HttpClient client(config, nullptr);
+
+    if (options.warmup > 0) {
+        Budget warmup(options.warmup, std::nullopt);
+        options.async ? runAsync(client, options, warmup) : runSync(client, options, warmup);
+    }
+
+    std::optional<Clock::time_point> deadline;
+    if (options.duration > 0) {
+        deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.duration));
+    }
+    Budget budget(options.requests, deadline);
+    auto start = Clock::now();
+    Samples samples = options.async ? runAsync(client, options, budget) : runSync(client, options, budget);
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::sort(samples.latencies.begin(), samples.latencies.end());
+    double total = 0;
+    for (double latency : samples.latencies) {
+        total += latency;
+    }
+    size_t count = samples.latencies.size();
+
+    std::printf("target       %s%s\n", baseUrl.c_str(), options.path.c_str());
+    std::printf("mode         %s, concurrency %d, pool %d, http2 %s\n",
+                options.async ? "async" : "sync", options.concurrency, options.pool, options.http2 ? "on" : "off");
+    std::printf("requests     %zu (%ld errors) in %.3f s\n", count, samples.errors, elapsed);
+    std::printf("throughput   %.1f req/s\n", elapsed > 0 ? static_cast<double>(count) / elapsed : 0.0);
+    std::printf("latency us   mean %.1f  p50 %.1f  p90 %.1f  p99 %.1f  p99.9 %.1f  max %.1f\n",
+                count ? total / static_cast<double>(count) : 0.0,
+                percentile(samples.latencies, 0.50),
+                percentile(samples.latencies, 0.90),
+                percentile(samples.latencies, 0.99),
+                percentile(samples.latencies, 0.999),
+                count ? samples.latencies.back() : 0.0);
+    return samples.errors == 0 ? 0 : 1;
+}
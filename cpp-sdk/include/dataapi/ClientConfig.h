@@ -1,28 +1,112 @@
 #pragma once
 
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <vector>
 
 namespace dataapi {
 
+namespace http {
+class Transport;
+class SpanExporter;
+}
+
+/**
+ * 批量结果响应的编码
+ * 非Json时，查询、批量执行和嵌入请求通过Accept优先请求该编码，服务端不支持时仍返回JSON；
+ * 解码得到的类型与JSON相同
+ */
+enum class WireFormat {
+    Json,
+    MessagePack,
+    Cbor
+};
+
+/**
+ * 服务端点（地区或副本）
+ */
+struct ServiceEndpoint {
+    std::string baseUrl;
+    double weight = 1.0; // 相对权重，按比例分配请求
+
+    ServiceEndpoint() = default;
+    ServiceEndpoint(std::string baseUrl, double weight = 1.0) : baseUrl(std::move(baseUrl)), weight(weight) {}
+};
+
+/**
+ * 多端点负载均衡策略，见http::LoadBalancer
+ */
+enum class LoadBalancingPolicy {
+    LeastOutstanding,  // 在途请求数最少
+    PowerOfTwoChoices, // 随机取两个，选在途请求数较少者
+    LatencyEwma        // 随机取两个，按延迟EWMA与在途请求数选择
+};
+
 /**
  * 客户端配置类
  */
 class ClientConfig {
 public:
     std::string baseUrl;
-    int timeout = 30000; // 默认30秒超时
-    bool enableLogging = false;
+    int timeout = 30000; // 单次请求的总超时（毫秒），默认30秒
+    int connectTimeout = 0; // 连接超时（毫秒，含DNS解析和TLS握手），0表示只受总超时限制
+    int lowSpeedLimit = 1; // 低速阈值（字节/秒）
+    int lowSpeedTime = 0; // 传输速度持续低于lowSpeedLimit达到该秒数时中止，用于发现停滞的连接，0表示不检查
+    bool enableLogging = false; // 结构化请求日志：在后台线程格式化并写出，请求路径只复制必要字段
+    double logSampleRate = 1.0; // 记录的请求比例（0~1），按请求计数均匀采样
+    size_t logMaxBodyBytes = 1024; // 日志中请求体和响应体保留的最大字节数，超出部分截断，0表示不记录请求体和响应体
+    size_t logBufferCapacity = 4096; // 日志缓冲区容量（条），写入线程跟不上时丢弃新记录并计数；在首次启用日志时确定
+    std::function<void(const std::string& line)> logSink; // 接收格式化后的日志行（JSON），在后台线程调用，为空时写到标准错误；与缓冲区容量一样在首次启用日志时确定
     bool enableRetry = true;
     int maxRetries = 3;
     int retryDelay = 1000; // 重试延迟（毫秒）
+    int maxRetryDelay = 30000; // 最大重试退避时间（毫秒），Retry-After超过该值时不再重试
+    double retryBudgetRatio = 0.2; // 重试预算：每个请求可累积的重试令牌数
+    int retryBudgetCapacity = 10; // 重试预算：允许的突发重试次数
     std::string version = "1.0.0";
     std::unordered_map<std::string, std::string> defaultHeaders;
     std::string userAgent;
     bool verifySSL = true;
+    std::string caBundlePath; // CA证书文件（PEM），空表示使用libcurl默认证书；进程内只解析一次，所有连接共享
+    bool enableTlsSessionCache = true; // 复用TLS会话（会话票据/会话ID），会话缓存在进程内所有客户端之间共享
     std::string proxyUrl;
+    std::string unixSocketPath; // 经Unix域套接字连接（例如同机部署的sidecar），baseUrl的主机名只用于Host头部；为空时使用TCP
     int connectionPoolSize = 10;
+    int dnsCacheTimeout = 60; // DNS缓存有效期（秒），进程内所有客户端共享，-1表示永久缓存
+    int happyEyeballsTimeoutMs = 200; // 优先地址族的连接未完成多久后并行尝试另一地址族（毫秒）
+    bool spreadAcrossAddresses = false; // 把池中连接按槽位分散到域名解析出的全部地址，连接失败的地址暂时跳过
+    int warmUpConnections = 0; // DataApiClient构造时预先解析域名并建立的连接数，不超过connectionPoolSize
+    bool enableHttp2 = false; // 通过ALPN协商HTTP/2，服务端不支持时回退到HTTP/1.1 keep-alive
+    int maxConcurrentStreams = 100; // 每个HTTP/2连接上的最大并发流数
+    bool acceptCompressedResponses = true; // 通过Accept-Encoding协商gzip/br/zstd响应压缩，由libcurl透明解压
+    bool compressRequests = false; // 请求体超过阈值时以gzip流式压缩发送（服务端需支持Content-Encoding: gzip）
+    size_t requestCompressionThreshold = 16 * 1024; // 请求体压缩阈值（字节）
+    bool enableCircuitBreaker = false; // 按端点组（路径首段，如/workflows）熔断，断开期间请求直接失败
+    int circuitBreakerWindow = 20; // 熔断：统计最近多少次请求
+    int circuitBreakerMinimumRequests = 10; // 熔断：窗口内至少有多少次请求才判断失败率
+    double circuitBreakerFailureRate = 0.5; // 熔断：超时、网络错误和502/503/504占比达到该值时断开
+    int circuitBreakerOpenMs = 5000; // 熔断：断开持续时间（毫秒），之后放行探测请求
+    bool enableAdaptiveConcurrency = false; // 按观测到的延迟调整并发上限，超出上限的请求直接失败
+    int initialConcurrencyLimit = 20; // 自适应并发：初始上限
+    int minConcurrencyLimit = 1; // 自适应并发：最小上限
+    int maxConcurrencyLimit = 200; // 自适应并发：最大上限
+    bool enableHedging = false; // 幂等GET/HEAD超过近期延迟分位数仍未完成时，在另一连接上发出副本，先到的响应胜出
+    double hedgePercentile = 0.95; // 对冲：等待时间取客户端总延迟直方图的该分位数
+    int hedgeMinDelayMs = 5; // 对冲：等待时间下限（毫秒）
+    double hedgeBudgetRatio = 0.05; // 对冲预算：每个可对冲请求累积的令牌数，即对冲副本的最大占比
+    int hedgeBudgetCapacity = 10; // 对冲预算：允许的突发对冲次数
+    std::shared_ptr<http::Transport> transport; // 可替换的传输层（见http/Transport.h），为空时使用内置的libcurl传输
+    std::vector<ServiceEndpoint> endpoints; // 多个服务端点；非空时每次尝试在其中负载均衡、重试换到其他端点，baseUrl不再使用。与下列负载均衡参数一样在构造时确定
+    LoadBalancingPolicy loadBalancingPolicy = LoadBalancingPolicy::PowerOfTwoChoices;
+    int healthCheckIntervalMs = 5000; // 后台以HEAD <端点>/health探测各端点的间隔（毫秒），失败的端点被摘除直到探测恢复；0表示不探测
+    int healthCheckTimeoutMs = 2000; // 健康探测的超时（毫秒）
+    int endpointFailureThreshold = 3; // 端点连续失败（连接错误、超时、502/503/504）多少次后摘除，0表示不按请求结果摘除
+    int endpointEjectionMs = 30000; // 按请求结果摘除的时长（毫秒），探测成功时提前恢复
+    WireFormat wireFormat = WireFormat::Json; // 批量结果（QueryResult、BatchResult、EmbeddingResult）优先请求的编码
+    std::shared_ptr<http::SpanExporter> spanExporter; // 分布式追踪（见http/Tracing.h）：为每次传输生成客户端span并导出，注入traceparent；为空时只传递TraceScope设置的上游上下文
+    double traceSampleRate = 1.0; // 没有上游上下文时新建trace的采样比例（0~1）；有上游上下文时跟随其采样标志
     
     /**
      * 默认构造函数
@@ -67,7 +151,8 @@ public:
      * @return 配置是否有效
      */
     bool isValid() const {
-        return !baseUrl.empty() && timeout > 0 && maxRetries >= 0;
+        return !baseUrl.empty() && timeout > 0 && connectTimeout >= 0 && lowSpeedTime >= 0 && maxRetries >= 0 &&
+            maxConcurrentStreams > 0 && dnsCacheTimeout >= -1 && happyEyeballsTimeoutMs >= 0 && warmUpConnections >= 0;
     }
     
     /**
@@ -16,6 +16,9 @@ namespace dataapi {
 
 /**
  * DataAPI C++ SDK主客户端类
+ *
+ * 各服务客户端在首次调用对应的getXxxClient()时创建（线程安全），只使用部分服务的进程不为其余服务付出构造开销。
+ * 冷启动敏感的场景（如serverless函数）可以在初始化阶段调用prewarmRuntime()，之后按调用创建的客户端共享已初始化的运行时。
  */
 class DataApiClient {
 public:
@@ -26,6 +29,16 @@ public:
      */
     DataApiClient(const ClientConfig& config, std::shared_ptr<auth::AuthenticationProvider> authProvider);
     
+    /**
+     * 在已初始化的运行时上构造，跳过curl_global_init、共享句柄和证书包的加载
+     * @param config 客户端配置
+     * @param authProvider 认证提供者
+     * @param runtime 共享CURL运行时（通常来自prewarmRuntime()），为空时使用进程级实例
+     */
+    DataApiClient(const ClientConfig& config,
+                  std::shared_ptr<auth::AuthenticationProvider> authProvider,
+                  std::shared_ptr<http::CurlRuntime> runtime);
+    
     /**
      * 析构函数
      */
@@ -36,31 +49,31 @@ public:
     DataApiClient& operator=(const DataApiClient&) = delete;
     
     // 启用移动构造和赋值
-    DataApiClient(DataApiClient&&) = default;
-    DataApiClient& operator=(DataApiClient&&) = default;
+    DataApiClient(DataApiClient&&) noexcept;
+    DataApiClient& operator=(DataApiClient&&) noexcept;
     
     /**
-     * 获取工作流客户端
+     * 获取工作流客户端（首次调用时创建）
      */
     client::WorkflowClient& getWorkflowClient();
     
     /**
-     * 获取项目客户端
+     * 获取项目客户端（首次调用时创建）
      */
     client::ProjectClient& getProjectClient();
     
     /**
-     * 获取数据库客户端
+     * 获取数据库客户端（首次调用时创建）
      */
     client::DatabaseClient& getDatabaseClient();
     
     /**
-     * 获取AI提供者客户端
+     * 获取AI提供者客户端（首次调用时创建）
      */
     client::AiProviderClient& getAiProviderClient();
     
     /**
-     * 获取用户客户端
+     * 获取用户客户端（首次调用时创建）
      */
     client::UserClient& getUserClient();
     
@@ -120,17 +133,22 @@ public:
         const std::string& baseUrl = "https://api.dataapi.com"
     );
     
+    /**
+     * 预先初始化进程级CURL运行时，并加载配置使用的CA证书包
+     * 在serverless函数的初始化阶段调用，把全局初始化和证书解析移出按调用计费的请求处理路径
+     * @param config 之后创建客户端时使用的配置
+     * @return 共享运行时，传给DataApiClient的构造函数
+     */
+    static std::shared_ptr<http::CurlRuntime> prewarmRuntime(const ClientConfig& config = ClientConfig());
+    
 private:
     ClientConfig config_;
     std::shared_ptr<auth::AuthenticationProvider> authProvider_;
     std::shared_ptr<http::HttpClient> httpClient_;
     
-    // 各种服务客户端
-    std::unique_ptr<client::WorkflowClient> workflowClient_;
-    std::unique_ptr<client::ProjectClient> projectClient_;
-    std::unique_ptr<client::DatabaseClient> databaseClient_;
-    std::unique_ptr<client::AiProviderClient> aiProviderClient_;
-    std::unique_ptr<client::UserClient> userClient_;
+    // 按需创建的各种服务客户端；once_flag不可移动，放在堆上使客户端保持可移动
+    struct Services;
+    std::unique_ptr<Services> services_;
     
     /**
      * 初始化客户端
@@ -7,6 +7,7 @@
 #include "types/ProjectTypes.h"
 #include "types/DatabaseTypes.h"
 #include "types/WorkflowTypes.h"
+#include "types/TimeSeries.h"
 
 // 为了向后兼容，保留原有的命名空间
 namespace dataapi {
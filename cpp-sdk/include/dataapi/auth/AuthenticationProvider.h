@@ -3,6 +3,8 @@
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <atomic>
+#include <cstdint>
 
 namespace dataapi {
 namespace auth {
@@ -23,6 +25,14 @@ enum class AuthenticationType {
  */
 class AuthenticationProvider {
 public:
+    AuthenticationProvider() = default;
+    AuthenticationProvider(const AuthenticationProvider& other)
+        : revision(other.revision.load(std::memory_order_acquire)) {}
+    AuthenticationProvider& operator=(const AuthenticationProvider& other) {
+        revision.store(other.revision.load(std::memory_order_acquire) + 1, std::memory_order_release);
+        return *this;
+    }
+    
     /**
      * 虚析构函数
      */
@@ -52,6 +62,16 @@ public:
      */
     virtual bool refresh() { return false; }
     
+    /**
+     * 服务端以401拒绝了使用revision版本认证信息的请求时由HttpClient调用
+     * 认证信息在此期间已经更新时直接返回true，否则尝试refresh()
+     * @param revision 发出请求时的版本号
+     * @return 是否应以新的认证信息重放请求
+     */
+    virtual bool refreshAfterRejection(uint64_t revision) {
+        return getRevision() != revision || refresh();
+    }
+    
     /**
      * 清除认证信息
      */
@@ -62,6 +82,27 @@ public:
      * @return 认证信息字符串
      */
     virtual std::string toString() const = 0;
+    
+    /**
+     * 获取认证信息的版本号
+     * HttpClient缓存格式化后的认证头部，版本号变化时重新调用getAuthHeaders()。
+     * 子类在认证头部发生变化时必须调用markChanged()
+     * @return 版本号
+     */
+    virtual uint64_t getRevision() const {
+        return revision.load(std::memory_order_acquire);
+    }
+    
+protected:
+    /**
+     * 标记认证信息已变化
+     */
+    void markChanged() {
+        revision.fetch_add(1, std::memory_order_acq_rel);
+    }
+    
+private:
+    std::atomic<uint64_t> revision{0};
 };
 
 /**
@@ -104,6 +145,7 @@ public:
      */
     void clearAuthentication() override {
         token.clear();
+        markChanged();
     }
     
     /**
@@ -125,6 +167,7 @@ public:
      */
     void setToken(const std::string& newToken) {
         token = newToken;
+        markChanged();
     }
 };
 
@@ -171,6 +214,7 @@ public:
      */
     void clearAuthentication() override {
         apiKey.clear();
+        markChanged();
     }
     
     /**
@@ -237,6 +281,7 @@ public:
     void clearAuthentication() override {
         username.clear();
         password.clear();
+        markChanged();
     }
     
     /**
@@ -302,6 +347,7 @@ public:
      */
     void clearAuthentication() override {
         headers.clear();
+        markChanged();
     }
     
     /**
@@ -316,6 +362,7 @@ public:
      */
     void addHeader(const std::string& key, const std::string& value) {
         headers[key] = value;
+        markChanged();
     }
     
     /**
@@ -323,6 +370,7 @@ public:
      */
     void removeHeader(const std::string& key) {
         headers.erase(key);
+        markChanged();
     }
 };
 
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "AuthenticationProvider.h"
+#include "../Types.h"
+
+namespace dataapi {
+namespace auth {
+
+/**
+ * OAuth2认证参数
+ */
+struct OAuth2Options {
+    std::string tokenUrl;                        // 令牌端点的完整URL
+    std::string clientId;
+    std::string clientSecret;
+    std::string scope;                           // 可选
+    std::string refreshToken;                    // 初始刷新令牌，非空时以refresh_token授权，否则以client_credentials授权
+    std::chrono::seconds refreshAhead{60};       // 到期前多久在后台刷新，有效期较短时在有效期过半时刷新
+    bool backgroundRefresh = true;               // 是否启动后台刷新线程
+    int timeoutMs = 10000;                       // 令牌请求超时
+    bool verifySSL = true;
+};
+
+/**
+ * OAuth2认证提供者
+ *
+ * 以Bearer令牌认证，按TokenResponse::expiresIn跟踪有效期：后台线程在到期前刷新，
+ * 失败时退避重试；令牌已过期而刷新尚未成功时，下一个请求同步刷新。
+ * 并发的刷新合并为一个令牌请求，其余调用等待其结果。
+ * HttpClient收到401时调用refreshAfterRejection()，令牌更新后重放请求一次。
+ */
+class OAuth2AuthProvider : public AuthenticationProvider {
+public:
+    /**
+     * 获取令牌的回调
+     * @param refreshToken 当前的刷新令牌，为空时应以客户端凭据获取
+     * @throws 任意异常表示获取失败，保留原令牌
+     */
+    using TokenFetcher = std::function<TokenResponse(const std::string& refreshToken)>;
+
+    /**
+     * 通过options.tokenUrl获取令牌
+     */
+    explicit OAuth2AuthProvider(const OAuth2Options& options);
+
+    /**
+     * 通过自定义回调获取令牌，options中只使用refreshToken、refreshAhead和backgroundRefresh
+     */
+    OAuth2AuthProvider(TokenFetcher fetcher, const OAuth2Options& options = {});
+
+    /**
+     * 析构函数，停止后台刷新线程
+     */
+    ~OAuth2AuthProvider() override;
+
+    OAuth2AuthProvider(const OAuth2AuthProvider&) = delete;
+    OAuth2AuthProvider& operator=(const OAuth2AuthProvider&) = delete;
+
+    AuthenticationType getType() const override {
+        return AuthenticationType::OAUTH2;
+    }
+
+    /**
+     * 获取认证头部信息，尚无令牌时为空
+     */
+    std::unordered_map<std::string, std::string> getAuthHeaders() const override;
+
+    /**
+     * 持有未过期的令牌时有效
+     */
+    bool isValid() const override;
+
+    /**
+     * 立即获取新令牌
+     * 已有刷新在进行时等待其完成并返回其结果
+     * @return 是否获取成功
+     */
+    bool refresh() override;
+
+    /**
+     * 令牌自revision之后已更新时直接返回true，否则刷新
+     */
+    bool refreshAfterRejection(uint64_t revision) override;
+
+    /**
+     * 清除令牌并停止自动刷新，直到下一次显式调用refresh()
+     */
+    void clearAuthentication() override;
+
+    std::string toString() const override;
+
+    /**
+     * 获取版本号；令牌已过期时先同步刷新
+     * 刷新失败后一秒内不再同步重试，避免令牌端点故障时每个请求都发起刷新
+     */
+    uint64_t getRevision() const override;
+
+    /**
+     * 当前令牌的到期时间，无令牌或未给出有效期时为time_point::max()
+     */
+    std::chrono::steady_clock::time_point getExpiry() const;
+
+    /**
+     * 最近一次刷新失败的原因，成功后清空
+     */
+    std::string getLastError() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static int64_t ticks(Clock::time_point time) {
+        return time.time_since_epoch().count();
+    }
+
+    bool fetchToken();
+    void backgroundLoop();
+
+    TokenFetcher fetcher;
+    std::chrono::seconds refreshAhead;
+
+    mutable std::mutex mutex;
+    std::condition_variable refreshed;  // 单次刷新完成
+    std::condition_variable wake;       // 唤醒后台线程
+    std::string token;
+    std::string refreshToken;
+    std::string lastError;
+    bool refreshing = false;
+    bool lastSucceeded = false;
+    bool stopping = false;
+    uint64_t rounds = 0;                // 已完成的刷新次数
+    Clock::time_point refreshAt;        // 后台线程下一次刷新的时间
+    std::chrono::seconds backoff{1};
+
+    // 供getRevision()无锁判断是否需要同步刷新
+    std::atomic<int64_t> expiresAt;     // 无令牌时为最小值，视为已过期
+    std::atomic<int64_t> retryNotBefore{0};
+    std::atomic<bool> cleared{false};
+
+    std::thread worker;
+};
+
+} // namespace auth
+} // namespace dataapi
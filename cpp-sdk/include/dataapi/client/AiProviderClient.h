@@ -6,10 +6,28 @@
 #include <functional>
 #include "../Types.h"
 #include "../http/HttpClient.h"
+#include "../http/RateLimiter.h"
+#include "EmbeddingCache.h"
+#include "MetadataCache.h"
+#include "MediaOutput.h"
+#include "Paginator.h"
+#include "TimeSeriesTracker.h"
+#ifdef DATAAPI_WITH_COROUTINES
+#include "../coro/Task.h"
+#endif
 
 namespace dataapi {
 namespace client {
 
+/**
+ * 批量调用参数
+ */
+struct AiBatchOptions {
+    int concurrency = 8;                          // 同时在途的请求数
+    std::shared_ptr<http::RateLimiter> rateLimiter; // 发出每个请求前获取一个令牌，可在多次调用间共享
+    bool limitByQuota = false;                    // 未指定rateLimiter时按getQuotaInfo()的剩余配额限流
+};
+
 /**
  * AI提供者客户端类
  * 提供AI服务相关的API操作
@@ -17,6 +35,8 @@ namespace client {
 class AiProviderClient {
 private:
     std::shared_ptr<http::HttpClient> httpClient;
+    std::shared_ptr<EmbeddingCache> embeddingCache;
+    std::shared_ptr<MetadataCache> metadataCache;
     
 public:
     /**
@@ -59,6 +79,17 @@ public:
     PageResult<AiProvider> list(int page = 1, int size = 20,
                                const std::string& type = "");
     
+    /**
+     * 遍历全部AI提供商，按需逐页请求并预取后续页
+     * @param size 每页大小
+     * @param type 类型（可选）
+     * @param options 遍历参数
+     * @return 分页遍历器，使用期间本客户端不得移动或销毁
+     */
+    Paginator<AiProvider> paginate(int size = 20,
+                                 const std::string& type = "",
+                                 const PaginatorOptions& options = {});
+    
     /**
      * 根据ID获取AI提供者详情
      * @param id AI提供者ID
@@ -98,22 +129,42 @@ public:
     
     /**
      * 流式调用AI服务
+     * 响应按server-sent events或按行分隔的JSON增量解析，每个片段到达时立即回调；
+     * 最后一次回调的isComplete为true。回调在执行请求的线程上调用
      * @param providerId AI提供者ID
      * @param request AI服务请求
-     * @param callback 流式响应回调函数
+     * @param callback 流式响应回调函数，返回false取消生成并关闭连接
      */
     void invokeStream(const std::string& providerId,
                      const AiServiceRequest& request,
-                     std::function<void(const AiStreamResponse&)> callback);
+                     std::function<bool(const AiStreamResponse&)> callback);
     
     /**
      * 批量调用AI服务
+     * 请求通过异步引擎并发发出，最多options.concurrency个同时在途，并按限流器控制发出速率。
+     * 结果按输入顺序返回；单个请求失败记录在对应的结果项中，不影响其他请求。
+     * 异步路径不重试，被限流（429）的请求同样作为失败项返回
      * @param providerId AI提供者ID
      * @param requests AI服务请求列表
-     * @return AI服务响应列表
+     * @param options 批量调用参数
+     * @return 与请求一一对应的结果列表
      */
-    std::vector<AiServiceResponse> invokeBatch(const std::string& providerId,
-                                              const std::vector<AiServiceRequest>& requests);
+    std::vector<AiBatchItem> invokeBatch(const std::string& providerId,
+                                        const std::vector<AiServiceRequest>& requests,
+                                        const AiBatchOptions& options = {});
+    
+    /**
+     * 按配额设置创建限流器
+     * 速率为maxRequests除以period（second、minute、hour、day）的时长，突发量约为一秒的请求数；
+     * maxRequests不大于0时不限流
+     * @throws std::invalid_argument period无法识别
+     */
+    static std::shared_ptr<http::RateLimiter> rateLimiterFor(const AiQuotaSettings& quota);
+    
+    /**
+     * 按剩余配额创建限流器，剩余请求数在重置时间之前均匀发出
+     */
+    static std::shared_ptr<http::RateLimiter> rateLimiterFor(const AiQuotaInfo& quota);
     
     /**
      * 获取AI模型列表
@@ -156,6 +207,30 @@ public:
                                          const std::string& startTime,
                                          const std::string& endTime);
     
+    /**
+     * 获取AI服务使用量的时间序列（请求数、token数、费用等）
+     * 时间范围按options.window切分后并行请求，响应直接解码为列
+     * @param providerId AI提供者ID
+     * @param start 开始时间（含）
+     * @param end 结束时间（不含）
+     * @param options 聚合间隔、窗口长度和并发数
+     * @return 各字段的时间序列
+     */
+    TimeSeries getUsageSeries(const std::string& providerId,
+                              Timestamp start,
+                              Timestamp end,
+                              const TimeSeriesOptions& options = TimeSeriesOptions());
+    
+    /**
+     * 创建按增量刷新的使用量序列，每次refresh()只获取上次之后的新点
+     * @param providerId AI提供者ID
+     * @param range 保留的时间范围
+     * @param options 获取参数
+     */
+    TimeSeriesTracker trackUsage(const std::string& providerId,
+                                 std::chrono::milliseconds range,
+                                 const TimeSeriesOptions& options = TimeSeriesOptions());
+    
     /**
      * 获取AI服务配额信息
      * @param providerId AI提供者ID
@@ -183,14 +258,15 @@ public:
     
     /**
      * 流式文本生成
+     * 每个文本片段到达时立即回调，分帧方式同invokeStream
      * @param providerId AI提供者ID
      * @param prompt 提示文本
-     * @param callback 流式响应回调
+     * @param callback 流式响应回调，返回false取消生成并关闭连接
      * @param options 生成选项
      */
     void generateTextStream(const std::string& providerId,
                            const std::string& prompt,
-                           std::function<void(const std::string&)> callback,
+                           std::function<bool(const std::string&)> callback,
                            const TextGenerationOptions& options = {});
     
     /**
@@ -204,6 +280,20 @@ public:
                                        const std::string& prompt,
                                        const ImageGenerationOptions& options = {});
     
+    /**
+     * 图像生成，图像以原始二进制（Accept: image/任意子类型）按块写入output，不经过base64和JSON
+     * 只返回一张图像，options.n被忽略
+     * @param providerId AI提供者ID
+     * @param prompt 提示文本
+     * @param output 写入目标，见bufferOutput、fileOutput、fdOutput
+     * @param options 生成选项
+     * @return 内容类型和写入的字节数
+     */
+    MediaResult generateImage(const std::string& providerId,
+                              const std::string& prompt,
+                              MediaOutput output,
+                              const ImageGenerationOptions& options = {});
+    
     /**
      * 图像分析
      * @param providerId AI提供者ID
@@ -217,6 +307,22 @@ public:
                                     const std::string& prompt = "",
                                     const ImageAnalysisOptions& options = {});
     
+    /**
+     * 图像分析，图像作为原始请求体上传，提示和选项通过查询参数传递
+     * 请求体边读取边上传：http::memoryBody引用调用方的缓冲区而不复制，http::fileBody、http::mappedFileBody直接读取文件
+     * @param providerId AI提供者ID
+     * @param image 图像数据
+     * @param contentType 图像类型，例如image/png、image/jpeg
+     * @param prompt 分析提示（可选）
+     * @param options 分析选项
+     * @return 分析结果
+     */
+    ImageAnalysisResult analyzeImage(const std::string& providerId,
+                                    http::UploadBody image,
+                                    const std::string& contentType,
+                                    const std::string& prompt = "",
+                                    const ImageAnalysisOptions& options = {});
+    
     /**
      * 语音转文本
      * @param providerId AI提供者ID
@@ -228,6 +334,19 @@ public:
                                    const std::string& audioData,
                                    const SpeechToTextOptions& options = {});
     
+    /**
+     * 语音转文本，音频作为原始请求体上传（不经过base64），选项通过查询参数传递
+     * @param providerId AI提供者ID
+     * @param audio 音频数据，见http::memoryBody、http::fileBody、http::mappedFileBody
+     * @param contentType 音频类型，例如audio/wav、audio/mpeg
+     * @param options 转换选项
+     * @return 转换结果
+     */
+    SpeechToTextResult speechToText(const std::string& providerId,
+                                   http::UploadBody audio,
+                                   const std::string& contentType,
+                                   const SpeechToTextOptions& options = {});
+    
     /**
      * 文本转语音
      * @param providerId AI提供者ID
@@ -239,8 +358,23 @@ public:
                                    const std::string& text,
                                    const TextToSpeechOptions& options = {});
     
+    /**
+     * 文本转语音，音频以原始二进制（Accept: audio/任意子类型）按块写入output，不经过base64和JSON
+     * @param providerId AI提供者ID
+     * @param text 文本内容
+     * @param output 写入目标，见bufferOutput、fileOutput、fdOutput
+     * @param options 转换选项
+     * @return 内容类型和写入的字节数
+     */
+    MediaResult textToSpeech(const std::string& providerId,
+                             const std::string& text,
+                             MediaOutput output,
+                             const TextToSpeechOptions& options = {});
+    
     /**
      * 文本嵌入
+     * 设置了嵌入缓存时只请求未命中的文本，并与其他调用的相同或同批文本合并请求；
+     * 此时结果的usage不填充
      * @param providerId AI提供者ID
      * @param texts 文本列表
      * @param options 嵌入选项
@@ -250,6 +384,28 @@ public:
                                  const std::vector<std::string>& texts,
                                  const EmbeddingOptions& options = {});
     
+    /**
+     * 设置嵌入缓存，传入nullptr关闭
+     * 缓存键不包含服务地址，共享同一缓存的客户端应指向同一服务
+     */
+    void setEmbeddingCache(std::shared_ptr<EmbeddingCache> cache);
+    
+    /**
+     * 获取嵌入缓存，未设置时为nullptr
+     */
+    std::shared_ptr<EmbeddingCache> getEmbeddingCache() const;
+    
+    /**
+     * 设置元数据缓存，传入nullptr关闭
+     * 启用后getModels先查缓存，本客户端的update/deleteProvider使该提供者的模型列表失效
+     */
+    void setMetadataCache(std::shared_ptr<MetadataCache> cache);
+    
+    /**
+     * 获取元数据缓存，未设置时为nullptr
+     */
+    std::shared_ptr<MetadataCache> getMetadataCache() const;
+    
     /**
      * 文本分类
      * @param providerId AI提供者ID
@@ -310,6 +466,17 @@ public:
                                    const std::string& targetLanguage,
                                    const std::string& sourceLanguage = "",
                                    const TranslationOptions& options = {});
+
+#ifdef DATAAPI_WITH_COROUTINES
+    /**
+     * 协程接口（以DATAAPI_ENABLE_COROUTINES构建时可用）
+     * 请求在curl_multi引擎上发送，挂起期间不占用线程，完成后在引擎线程上恢复；
+     * 不经过元数据缓存，修改操作仍使缓存失效。Task须在客户端销毁前完成
+     */
+    coro::Task<PageResult<AiProvider>> listAsync(int page = 1, int size = 20, std::string type = "");
+    coro::Task<AiProvider> getByIdAsync(std::string id);
+    coro::Task<AiServiceResponse> invokeAsync(std::string providerId, AiServiceRequest request);
+#endif
 };
 
 } // namespace client
@@ -3,12 +3,27 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <iosfwd>
 #include "../Types.h"
+#include "../types/ColumnarResult.h"
 #include "../http/HttpClient.h"
+#include "MetadataCache.h"
+#include "Paginator.h"
+#include "PreparedQuery.h"
+#include "QueryCursor.h"
+#include "TimeSeriesTracker.h"
+#include "Transaction.h"
+#ifdef DATAAPI_WITH_COROUTINES
+#include "../coro/Task.h"
+#endif
 
 namespace dataapi {
 namespace client {
 
+namespace detail {
+class PreparedQueryCache;
+}
+
 /**
  * 数据库客户端类
  * 提供数据库相关的API操作
@@ -16,6 +31,8 @@ namespace client {
 class DatabaseClient {
 private:
     std::shared_ptr<http::HttpClient> httpClient;
+    std::shared_ptr<MetadataCache> metadataCache;
+    std::shared_ptr<detail::PreparedQueryCache> preparedQueries;
     
 public:
     /**
@@ -27,7 +44,7 @@ public:
     /**
      * 析构函数
      */
-    ~DatabaseClient() = default;
+    ~DatabaseClient();
     
     /**
      * 禁用拷贝构造和赋值
@@ -65,6 +82,17 @@ public:
     PageResult<DatabaseInfo> list(int page = 1, int size = 20,
                                  const std::string& projectId = "");
     
+    /**
+     * 遍历全部数据库，按需逐页请求并预取后续页
+     * @param size 每页大小
+     * @param projectId 项目ID（可选）
+     * @param options 遍历参数
+     * @return 分页遍历器，使用期间本客户端不得移动或销毁
+     */
+    Paginator<DatabaseInfo> paginate(int size = 20,
+                                 const std::string& projectId = "",
+                                 const PaginatorOptions& options = {});
+    
     /**
      * 创建数据库连接
      * @param request 数据库创建请求
@@ -107,6 +135,17 @@ public:
                               const std::string& tableName,
                               const std::string& schema = "");
     
+    /**
+     * 设置元数据缓存，传入nullptr关闭
+     * 启用后getTables和getTableSchema先查缓存，本客户端的update/deleteDatabase使该数据库的条目失效
+     */
+    void setMetadataCache(std::shared_ptr<MetadataCache> cache);
+    
+    /**
+     * 获取元数据缓存，未设置时为nullptr
+     */
+    std::shared_ptr<MetadataCache> getMetadataCache() const;
+    
     /**
      * 获取表数据预览
      * @param databaseId 数据库ID
@@ -131,6 +170,61 @@ public:
                             const std::string& sql,
                             const Parameters& params = {});
     
+    /**
+     * 预编译SQL查询
+     * 相同数据库和SQL返回同一句柄（最多缓存256个，最久未使用的先淘汰）；新句柄立即在服务端准备，
+     * 之后每次执行只发送绑定参数
+     * @param databaseId 数据库ID
+     * @param sql SQL语句
+     * @return 预编译查询句柄
+     */
+    std::shared_ptr<PreparedQuery> prepare(const std::string& databaseId, const std::string& sql);
+    
+    /**
+     * 释放预编译查询的服务端语句，并不再复用该句柄
+     * @param query 预编译查询句柄
+     */
+    void closePrepared(const std::shared_ptr<PreparedQuery>& query);
+    
+    /**
+     * 执行SQL查询，结果按列存放
+     * 响应体边接收边解析，每行直接写入类型化的列缓冲区，不保留中间的行对象
+     * @param databaseId 数据库ID
+     * @param sql SQL语句
+     * @param params 参数（可选）
+     * @return 列式查询结果
+     */
+    ColumnarResult executeQueryColumnar(const std::string& databaseId,
+                                        const std::string& sql,
+                                        const Parameters& params = {});
+    
+    /**
+     * 以游标方式执行SQL查询
+     * 结果逐行增量解析，适用于无法整体放入内存的大结果集
+     * @param databaseId 数据库ID
+     * @param sql SQL语句
+     * @param params 参数（可选）
+     * @param options 游标参数
+     * @return 查询游标
+     */
+    std::unique_ptr<QueryCursor> openCursor(const std::string& databaseId,
+                                            const std::string& sql,
+                                            const Parameters& params = {},
+                                            const CursorOptions& options = {});
+    
+    /**
+     * 流式执行SQL查询，在接收线程上逐行回调
+     * @param databaseId 数据库ID
+     * @param sql SQL语句
+     * @param onRow 行回调，返回false停止读取
+     * @param params 参数（可选）
+     * @return 已回调的行数
+     */
+    size_t streamQuery(const std::string& databaseId,
+                       const std::string& sql,
+                       const std::function<bool(const Json& row)>& onRow,
+                       const Parameters& params = {});
+    
     /**
      * 执行SQL更新操作
      * @param databaseId 数据库ID
@@ -144,12 +238,16 @@ public:
     
     /**
      * 批量执行SQL操作
+     * 语句列表超过分块上限时切分为多个请求，最多options.concurrency个同时在途，
+     * 结果按语句顺序合并；任一分块失败时等待在途请求结束后抛出异常
      * @param databaseId 数据库ID
      * @param sqls SQL语句列表
+     * @param options 分块参数
      * @return 批量执行结果
      */
     BatchResult executeBatch(const std::string& databaseId,
-                            const std::vector<std::string>& sqls);
+                            const std::vector<std::string>& sqls,
+                            const BatchOptions& options = {});
     
     /**
      * 执行存储过程
@@ -198,6 +296,17 @@ public:
                                    const std::string& sql,
                                    const Parameters& params = {});
     
+    /**
+     * 创建流水线事务
+     * 语句异步合并发送，begin和commit不单独占用往返；bundle模式下整个事务只有一个请求。
+     * 未提交的事务在析构时回滚
+     * @param databaseId 数据库ID
+     * @param options 事务参数
+     * @return 事务
+     */
+    std::unique_ptr<Transaction> transaction(const std::string& databaseId,
+                                             const TransactionOptions& options = {});
+    
     /**
      * 获取数据库统计信息
      * @param databaseId 数据库ID
@@ -225,6 +334,30 @@ public:
                               const std::string& startTime,
                               const std::string& endTime);
     
+    /**
+     * 获取数据库性能指标的时间序列
+     * 时间范围按options.window切分后并行请求，响应直接解码为列（不构建Json文档），适合长时间范围
+     * @param databaseId 数据库ID
+     * @param start 开始时间（含）
+     * @param end 结束时间（不含）
+     * @param options 聚合间隔、窗口长度和并发数
+     * @return 各指标的时间序列
+     */
+    TimeSeries getMetricsSeries(const std::string& databaseId,
+                                Timestamp start,
+                                Timestamp end,
+                                const TimeSeriesOptions& options = TimeSeriesOptions());
+    
+    /**
+     * 创建按增量刷新的性能指标序列，每次refresh()只获取上次之后的新点
+     * @param databaseId 数据库ID
+     * @param range 保留的时间范围
+     * @param options 获取参数
+     */
+    TimeSeriesTracker trackMetrics(const std::string& databaseId,
+                                   std::chrono::milliseconds range,
+                                   const TimeSeriesOptions& options = TimeSeriesOptions());
+    
     /**
      * 导出查询结果
      * @param databaseId 数据库ID
@@ -238,12 +371,76 @@ public:
                                  const std::string& format = "csv",
                                  const Parameters& params = {});
     
+    /**
+     * 导出查询结果到输出流
+     * 响应体边接收边写入输出流，不在内存中保留完整的导出数据
+     * @param databaseId 数据库ID
+     * @param sql SQL语句
+     * @param out 输出流
+     * @param format 导出格式（csv, json, excel等）
+     * @param params 参数（可选）
+     */
+    void exportQueryResult(const std::string& databaseId,
+                           const std::string& sql,
+                           std::ostream& out,
+                           const std::string& format = "csv",
+                           const Parameters& params = {});
+    
+    /**
+     * 导出查询结果到接收器
+     * @param databaseId 数据库ID
+     * @param sql SQL语句
+     * @param sink 响应体接收器，返回false中止导出
+     * @param format 导出格式（csv, json, excel等）
+     * @param params 参数（可选）
+     */
+    void exportQueryResult(const std::string& databaseId,
+                           const std::string& sql,
+                           http::BodySink sink,
+                           const std::string& format = "csv",
+                           const Parameters& params = {});
+    
+    /**
+     * 导出查询结果到文件
+     * 响应体经缓冲区合并后直接写入文件；传输中断时按已写入的长度发送Range请求续传，
+     * options.resume为true时从已有文件的末尾开始。服务端忽略Range时重新写入整个文件
+     * @param databaseId 数据库ID
+     * @param sql SQL语句
+     * @param path 文件路径
+     * @param options 导出选项
+     * @param params 参数（可选）
+     * @return 文件中导出数据的字节数
+     */
+    uint64_t exportQueryResultToFile(const std::string& databaseId,
+                                     const std::string& sql,
+                                     const std::string& path,
+                                     const ExportOptions& options = {},
+                                     const Parameters& params = {});
+    
+    /**
+     * 导出查询结果到文件描述符
+     * 从fd的当前位置开始写入，不关闭fd；续传回退需要fd支持截断（普通文件）
+     * options.resume不适用于文件描述符
+     * @param databaseId 数据库ID
+     * @param sql SQL语句
+     * @param fd 文件描述符
+     * @param options 导出选项
+     * @param params 参数（可选）
+     * @return 写入的字节数
+     */
+    uint64_t exportQueryResultToFd(const std::string& databaseId,
+                                   const std::string& sql,
+                                   int fd,
+                                   const ExportOptions& options = {},
+                                   const Parameters& params = {});
+    
     /**
      * 导入数据到表
+     * 数据直接作为请求体发送，不复制
      * @param databaseId 数据库ID
      * @param tableName 表名
      * @param data 数据
-     * @param format 数据格式
+     * @param format 数据格式（为空时使用options.format）
      * @param options 导入选项
      * @return 导入结果
      */
@@ -253,6 +450,38 @@ public:
                            const std::string& format = "csv",
                            const ImportOptions& options = {});
     
+    /**
+     * 流式导入数据到表
+     * 请求体边读取边上传，内存占用与数据量无关；可通过http::fileBody、
+     * http::mappedFileBody或自定义来源构造body。上传失败不会重试
+     * @param databaseId 数据库ID
+     * @param tableName 表名
+     * @param body 请求体
+     * @param options 导入选项（format为空时按csv处理）
+     * @param onProgress 上传进度回调（可选）
+     * @return 导入结果
+     */
+    ImportResult importData(const std::string& databaseId,
+                           const std::string& tableName,
+                           http::UploadBody body,
+                           const ImportOptions& options = {},
+                           http::UploadProgress onProgress = {});
+    
+    /**
+     * 从文件流式导入数据到表
+     * @param databaseId 数据库ID
+     * @param tableName 表名
+     * @param path 文件路径
+     * @param options 导入选项（format为空时按csv处理）
+     * @param onProgress 上传进度回调（可选）
+     * @return 导入结果
+     */
+    ImportResult importFile(const std::string& databaseId,
+                           const std::string& tableName,
+                           const std::string& path,
+                           const ImportOptions& options = {},
+                           http::UploadProgress onProgress = {});
+    
     /**
      * 创建数据库备份
      * @param databaseId 数据库ID
@@ -288,6 +517,17 @@ public:
      */
     void deleteBackup(const std::string& databaseId,
                      const std::string& backupId);
+
+#ifdef DATAAPI_WITH_COROUTINES
+    /**
+     * 协程接口（以DATAAPI_ENABLE_COROUTINES构建时可用）
+     * 请求在curl_multi引擎上发送，挂起期间不占用线程，完成后在引擎线程上恢复；
+     * 不经过元数据缓存，修改操作仍使缓存失效。Task须在客户端销毁前完成
+     */
+    coro::Task<PageResult<DatabaseInfo>> listAsync(int page = 1, int size = 20, std::string projectId = "");
+    coro::Task<DatabaseInfo> getInfoAsync(std::string databaseId);
+    coro::Task<QueryResult> executeQueryAsync(std::string databaseId, std::string sql, Parameters params = {});
+#endif
 };
 
 } // namespace client
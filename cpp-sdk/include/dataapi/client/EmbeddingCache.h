@@ -0,0 +1,133 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace dataapi {
+namespace client {
+
+/**
+ * 嵌入缓存参数
+ */
+struct EmbeddingCacheOptions {
+    size_t maxEntries = 10000;                    // 内存层最多缓存的向量数，按最近最少使用淘汰
+    std::string diskPath;                         // 磁盘层文件路径，为空时不启用
+    uint64_t maxDiskBytes = 1ull << 30;           // 磁盘层文件上限，达到后不再追加
+    size_t maxBatchSize = 256;                    // 单个嵌入请求最多包含的文本数
+    std::chrono::milliseconds batchWindow{0};     // 合批等待时长，0表示不等待其他调用
+};
+
+/**
+ * 嵌入缓存统计
+ */
+struct EmbeddingCacheStats {
+    uint64_t memoryHits = 0; // 内存层命中的文本数
+    uint64_t diskHits = 0;   // 磁盘层命中的文本数
+    uint64_t coalesced = 0;  // 与在途请求合并的文本数
+    uint64_t fetched = 0;    // 实际请求的文本数
+    uint64_t requests = 0;   // 发出的嵌入请求数
+};
+
+/**
+ * 按内容寻址的嵌入向量缓存
+ *
+ * 键为提供者、模型及参数（scope）与文本的SHA-256摘要。内存层为LRU，磁盘层为
+ * 只追加的文件，打开时建立索引并以内存映射读取，进程重启后仍然有效。
+ * 未命中的文本按scope排队：同一文本已在途时等待该请求而不重复发出；
+ * 第一个排队的调用负责在batchWindow内收集其他调用的文本并合并为一个请求发出。
+ * 线程安全，可由多个AiProviderClient共享；磁盘文件不支持多个进程同时写入。
+ */
+class EmbeddingCache {
+public:
+    using Key = std::array<unsigned char, 32>;
+    using Vector = std::vector<float>;
+
+    /**
+     * 请求一组文本的嵌入向量，返回值与texts一一对应
+     */
+    using Fetcher = std::function<std::vector<Vector>(const std::vector<std::string>& texts)>;
+
+    /**
+     * 构造函数
+     * @throws std::runtime_error 磁盘层文件无法打开或格式不符
+     */
+    explicit EmbeddingCache(const EmbeddingCacheOptions& options = {});
+    ~EmbeddingCache();
+
+    EmbeddingCache(const EmbeddingCache&) = delete;
+    EmbeddingCache& operator=(const EmbeddingCache&) = delete;
+
+    /**
+     * 计算缓存键
+     */
+    static Key makeKey(const std::string& scope, const std::string& text);
+
+    /**
+     * 获取一组文本的嵌入向量
+     * 命中的文本直接返回，其余按上述规则合并请求；请求失败时抛出fetch的异常，
+     * 与该请求合并的其他调用同样失败
+     * @param scope 决定向量取值的全部参数，相同scope的文本可以合并到同一请求
+     * @param texts 文本列表
+     * @param fetch 请求未命中文本的回调，在本线程上执行，可能同时请求其他调用排队的文本
+     */
+    std::vector<Vector> resolve(const std::string& scope,
+                                const std::vector<std::string>& texts,
+                                const Fetcher& fetch);
+
+    /**
+     * 查找缓存的向量，不发出请求
+     */
+    bool lookup(const Key& key, Vector& vector);
+
+    /**
+     * 写入缓存
+     */
+    void store(const Key& key, const Vector& vector);
+
+    /**
+     * 清空内存层，磁盘层保持不变
+     */
+    void clear();
+
+    /**
+     * 内存层的向量数
+     */
+    size_t size() const;
+
+    EmbeddingCacheStats getStats() const;
+
+private:
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+    struct Batch;
+    class DiskTier;
+    using Entry = std::pair<Key, Vector>;
+
+    bool lookupLocked(const Key& key, Vector& vector);
+    void storeLocked(const Key& key, const Vector& vector, bool persist);
+    void dispatch(const std::shared_ptr<Batch>& batch, const Fetcher& fetch);
+
+    EmbeddingCacheOptions options;
+    mutable std::mutex mutex;
+    std::condition_variable sealed;
+    std::list<Entry> entries; // 最近使用的在前
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+    std::unordered_map<Key, std::shared_future<Vector>, KeyHash> inflight;
+    std::unordered_map<std::string, std::shared_ptr<Batch>> open; // 按scope排队中的批次
+    std::unique_ptr<DiskTier> disk;
+    EmbeddingCacheStats stats;
+};
+
+} // namespace client
+} // namespace dataapi
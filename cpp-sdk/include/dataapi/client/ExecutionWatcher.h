@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "../Types.h"
+#include "../http/HttpClient.h"
+
+namespace dataapi {
+namespace client {
+
+namespace detail {
+class CompletionRegistry;
+}
+
+/**
+ * 执行监听参数
+ */
+struct ExecutionWatcherOptions {
+    std::chrono::milliseconds reconnectDelay{1000}; // 连接失败后重连前的等待
+    std::chrono::milliseconds streamTimeout{std::chrono::hours(24)}; // 一条连接的最长时间，到期后携带Last-Event-ID重连
+    std::chrono::seconds idleTimeout{90}; // 连接上持续这么久没有数据（包括心跳）时视为断开并重连，只在内置传输中生效
+    size_t retainCompleted = 4096;                  // 保留的无人等待的完成结果数，用于稍后登记的等待者
+};
+
+/**
+ * 通过一条事件流监听大量工作流执行的完成
+ *
+ * 后台线程保持一个GET /workflows/executions/events的server-sent events连接，
+ * 每个事件的data为一次执行的WorkflowExecutionResult，状态为终态时通知该执行的等待者。
+ * 连接断开后携带Last-Event-ID重连，由服务端补发期间的事件。事件流请求不使用ClientConfig::timeout
+ * 和重试，重连由监听线程负责；已收到数据的连接超时断开不计入熔断和并发限制。
+ * 在waitConnected()返回之后发起的执行不会错过完成事件；登记前已完成的执行
+ * 只要仍在保留范围内也会立即得到结果。
+ */
+class ExecutionWatcher {
+public:
+    /**
+     * 完成回调，在监听线程上调用，应尽快返回；监听停止时error非空
+     */
+    using Callback = std::function<void(WorkflowExecutionResult result, std::exception_ptr error)>;
+
+    /**
+     * 构造函数，立即在后台建立连接
+     * @param httpClient HTTP客户端
+     * @param options 监听参数
+     */
+    explicit ExecutionWatcher(std::shared_ptr<http::HttpClient> httpClient,
+                              const ExecutionWatcherOptions& options = {});
+
+    /**
+     * 析构函数，停止监听
+     */
+    ~ExecutionWatcher();
+
+    ExecutionWatcher(const ExecutionWatcher&) = delete;
+    ExecutionWatcher& operator=(const ExecutionWatcher&) = delete;
+
+    /**
+     * 等待执行完成
+     * @param executionId 执行ID
+     * @return 完成时就绪的future；监听停止时以DataApiError失败
+     */
+    std::future<WorkflowExecutionResult> watch(const std::string& executionId);
+
+    /**
+     * 执行完成时回调
+     */
+    void watch(const std::string& executionId, Callback callback);
+
+    /**
+     * 等待事件流建立
+     * @return 在timeout内连接成功时返回true
+     */
+    bool waitConnected(std::chrono::milliseconds timeout);
+
+    /**
+     * 等待中的执行数
+     */
+    size_t size() const;
+
+    /**
+     * 停止监听并关闭连接，未完成的等待者以代码为WATCHER_STOPPED的DataApiError失败
+     */
+    void stop();
+
+private:
+    void run();
+    void handleEvent(const std::string& data);
+
+    std::shared_ptr<http::HttpClient> httpClient;
+    ExecutionWatcherOptions options;
+    std::unique_ptr<detail::CompletionRegistry> registry;
+    std::shared_ptr<std::atomic<bool>> cancel;
+    mutable std::mutex mutex;
+    std::condition_variable changed;
+    bool connected = false;
+    bool stopping = false;
+    std::string lastEventId;
+    std::thread worker;
+};
+
+} // namespace client
+} // namespace dataapi
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include "../http/HttpClient.h"
+
+namespace dataapi {
+namespace client {
+
+/**
+ * 二进制媒体响应（图像、音频）的写入目标
+ * 响应体按到达的块直接写入目标，SDK内不累积完整内容；只能使用一次
+ */
+struct MediaOutput {
+    http::BodySink sink;           // 接收响应体的数据块，返回false中止传输
+    std::function<void()> finish;  // 响应体接收完成后调用（例如写出文件缓冲），可为空
+    const char* buffer = nullptr;  // 目标为调用方缓冲区时指向其起始位置，结果中的bytes据此给出
+};
+
+/**
+ * 写入调用方的缓冲区，不复制、不分配
+ * 响应体超过capacity时抛出std::length_error
+ */
+MediaOutput bufferOutput(char* data, size_t capacity);
+
+/**
+ * 写入文件（截断已有内容），经固定大小的缓冲区写出，内存占用与媒体大小无关
+ * @throws std::runtime_error 文件无法打开
+ */
+MediaOutput fileOutput(const std::string& path);
+
+/**
+ * 写入调用方的文件描述符（例如管道或套接字），从其当前位置开始，不取得所有权
+ */
+MediaOutput fdOutput(int fd);
+
+} // namespace client
+} // namespace dataapi
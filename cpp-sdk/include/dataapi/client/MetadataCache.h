@@ -0,0 +1,152 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <vector>
+
+namespace dataapi {
+namespace client {
+
+/**
+ * 可缓存的元数据类别，每类有独立的有效期
+ */
+enum class MetadataKind {
+    Workflow,           // WorkflowClient::getById
+    TableList,          // DatabaseClient::getTables
+    TableSchema,        // DatabaseClient::getTableSchema
+    ModelList,          // AiProviderClient::getModels
+    ProjectConfig,      // ProjectClient::getConfig
+    UserPermissions,    // UserClient::hasPermission(s)使用的权限快照
+    ProjectPermissions, // ProjectClient::hasPermission(s)的判断结果
+    WorkflowSchema      // WorkflowClient::getSchema编译后的工作流定义Schema
+};
+
+/**
+ * 元数据缓存参数，有效期为0表示不缓存该类
+ */
+struct MetadataCacheOptions {
+    std::chrono::milliseconds workflowTtl{30000};
+    std::chrono::milliseconds tableTtl{300000};        // 表列表与表结构
+    std::chrono::milliseconds modelTtl{600000};
+    std::chrono::milliseconds projectConfigTtl{60000};
+    std::chrono::milliseconds permissionTtl{5000};     // 权限快照与判断结果，过期前不感知服务端的权限变更
+    std::chrono::milliseconds schemaTtl{3600000};      // 工作流定义Schema，只随服务端版本变化
+    size_t shards = 16;                                // 分片数，每个分片一把锁
+    size_t maxEntries = 4096;                          // 总条目上限，平均分配到各分片，按最近最少使用淘汰
+};
+
+/**
+ * 元数据缓存统计
+ */
+struct MetadataCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;     // 因容量淘汰的条目数
+    uint64_t invalidations = 0; // 调用invalidate的次数
+};
+
+/**
+ * 读多写少的元数据的进程内缓存
+ *
+ * 条目以（类别, 所属对象ID, 键）标识，按所属对象ID分片，同一对象的条目位于同一分片。
+ * 通过setMetadataCache挂到客户端后，对应的读取接口先查缓存，同一客户端的
+ * update/delete调用使所属对象的条目失效。失效之前已发出的读取不会把旧值写回缓存。
+ * 绕过客户端的修改（如通过executeQuery执行DDL）需调用invalidate。
+ * 线程安全，可由多个客户端共享；键不含服务地址，只应在访问同一服务的客户端之间共享。
+ */
+class MetadataCache {
+public:
+    explicit MetadataCache(const MetadataCacheOptions& options = {});
+    ~MetadataCache();
+
+    MetadataCache(const MetadataCache&) = delete;
+    MetadataCache& operator=(const MetadataCache&) = delete;
+
+    /**
+     * 读取缓存的值，未命中或已过期时调用load并缓存其结果
+     * load抛出的异常原样传出，不缓存失败
+     * @param kind 类别，决定有效期
+     * @param owner 所属对象ID，invalidate的粒度
+     * @param key 对象内的键，如表名
+     * @param load 返回T的回调，在本线程上执行，不持有锁
+     */
+    template<typename T, typename Loader>
+    T get(MetadataKind kind, const std::string& owner, const std::string& key, Loader&& load) {
+        T value{};
+        uint64_t generation = 0;
+        if (peek(kind, owner, key, value, generation)) {
+            return value;
+        }
+        value = load();
+        put(kind, owner, key, value, generation);
+        return value;
+    }
+
+    /**
+     * 读取缓存的值，不加载
+     * 未命中时generation记录当前的失效计数，加载后传给put
+     * @return 是否命中
+     */
+    template<typename T>
+    bool peek(MetadataKind kind, const std::string& owner, const std::string& key, T& value, uint64_t& generation) {
+        std::shared_ptr<const void> cached = find(kind, owner, key, typeid(T), generation);
+        if (!cached) {
+            return false;
+        }
+        value = *static_cast<const T*>(cached.get());
+        return true;
+    }
+
+    /**
+     * 写入peek未命中后加载的值；peek之后该对象发生过失效时丢弃
+     */
+    template<typename T>
+    void put(MetadataKind kind, const std::string& owner, const std::string& key, const T& value, uint64_t generation) {
+        if (ttl(kind).count() > 0) {
+            insert(kind, owner, key, typeid(T), std::make_shared<const T>(value), generation);
+        }
+    }
+
+    /**
+     * 使某对象在某类别下的全部条目失效
+     */
+    void invalidate(MetadataKind kind, const std::string& owner);
+
+    /**
+     * 清空全部条目
+     */
+    void clear();
+
+    /**
+     * 当前条目数，含已过期但尚未清理的条目
+     */
+    size_t size() const;
+
+    std::chrono::milliseconds ttl(MetadataKind kind) const;
+
+    MetadataCacheStats getStats() const;
+
+private:
+    struct Shard;
+
+    Shard& shardFor(const std::string& owner) const;
+    std::shared_ptr<const void> find(MetadataKind kind, const std::string& owner, const std::string& key,
+                                     std::type_index type, uint64_t& generation);
+    void insert(MetadataKind kind, const std::string& owner, const std::string& key,
+                std::type_index type, std::shared_ptr<const void> value, uint64_t generation);
+
+    MetadataCacheOptions options;
+    size_t shardCapacity;
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint64_t> evictions{0};
+    std::atomic<uint64_t> invalidations{0};
+};
+
+} // namespace client
+} // namespace dataapi
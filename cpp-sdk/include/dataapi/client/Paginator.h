@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <utility>
+#include "../Types.h"
+
+namespace dataapi {
+namespace client {
+
+/**
+ * 分页遍历参数
+ */
+struct PaginatorOptions {
+    int concurrency = 2; // 同时在途的页请求数，1表示不预取
+    int pageBase = 1;    // 服务端第一页的页码，用于根据totalPages确定最后一页
+};
+
+/**
+ * 分页结果的惰性遍历器
+ *
+ * 按页码顺序逐页返回结果，每返回一页之前补足预取，调用方处理当前页时后台预取后续的concurrency - 1页。
+ * 第一页返回前只发出一个请求，之后按totalPages限制预取范围；服务端未返回totalPages时只预取下一页。
+ * 遇到last为true或空页时结束。分页器通过回调引用创建它的客户端，
+ * 使用期间客户端不得移动或销毁；析构时等待在途请求完成。
+ */
+template<typename T>
+class Paginator {
+public:
+    /**
+     * 按页码获取一页
+     */
+    using PageFetcher = std::function<PageResult<T>(int page)>;
+
+    /**
+     * 构造函数，不立即发出请求
+     * @param fetch 获取一页的回调
+     * @param startPage 起始页码
+     * @param options 遍历参数
+     */
+    Paginator(PageFetcher fetch, int startPage = 1, const PaginatorOptions& options = {})
+        : fetch(std::move(fetch)), options(options), nextRequest(startPage) {
+        this->options.concurrency = std::max(1, options.concurrency);
+    }
+
+    Paginator(Paginator&&) = default;
+    Paginator& operator=(Paginator&&) = default;
+
+    /**
+     * 读取下一页
+     * 请求失败时抛出异常，之后遍历结束
+     * @param page 输出页
+     * @return 读取到一页时返回true，遍历结束时返回false
+     */
+    bool nextPage(PageResult<T>& page) {
+        if (done) {
+            return false;
+        }
+        schedule();
+        if (inflight.empty()) {
+            done = true;
+            return false;
+        }
+
+        std::future<PageResult<T>> pending = std::move(inflight.front());
+        inflight.pop_front();
+        try {
+            page = pending.get();
+        } catch (...) {
+            finish();
+            throw;
+        }
+
+        if (lastPage < 0 && page.totalPages > 0) {
+            lastPage = options.pageBase + page.totalPages - 1;
+        }
+        if (page.last || page.content.empty()) {
+            finish();
+        } else {
+            // 在调用方处理本页之前发出后续页的请求
+            schedule();
+        }
+        return true;
+    }
+
+    /**
+     * 读取下一个元素
+     * @param item 输出元素
+     * @return 读取到元素时返回true，遍历结束时返回false
+     */
+    bool next(T& item) {
+        while (position >= current.content.size()) {
+            if (!nextPage(current)) {
+                return false;
+            }
+            position = 0;
+        }
+        item = std::move(current.content[position++]);
+        return true;
+    }
+
+    /**
+     * 读取剩余的全部元素
+     */
+    std::vector<T> collect() {
+        std::vector<T> items;
+        T item;
+        while (next(item)) {
+            items.push_back(std::move(item));
+        }
+        return items;
+    }
+
+    /**
+     * 逐元素输入迭代器
+     */
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        iterator() = default;
+        explicit iterator(Paginator* paginator) : paginator(paginator) {
+            ++(*this);
+        }
+
+        reference operator*() const {
+            return current;
+        }
+        pointer operator->() const {
+            return &current;
+        }
+        iterator& operator++() {
+            if (paginator && !paginator->next(current)) {
+                paginator = nullptr;
+            }
+            return *this;
+        }
+        bool operator==(const iterator& other) const {
+            return paginator == other.paginator;
+        }
+        bool operator!=(const iterator& other) const {
+            return paginator != other.paginator;
+        }
+
+    private:
+        Paginator* paginator = nullptr;
+        T current{};
+    };
+
+    iterator begin() {
+        return iterator(this);
+    }
+    iterator end() {
+        return iterator();
+    }
+
+private:
+    /**
+     * 补足在途请求；总页数未知时只保留一个
+     */
+    void schedule() {
+        size_t limit = lastPage < 0 ? 1 : static_cast<size_t>(options.concurrency);
+        while (inflight.size() < limit && (lastPage < 0 || nextRequest <= lastPage)) {
+            inflight.push_back(std::async(std::launch::async, fetch, nextRequest++));
+        }
+    }
+
+    /**
+     * 结束遍历，丢弃预取的页（future析构时等待请求完成）
+     */
+    void finish() {
+        done = true;
+        inflight.clear();
+    }
+
+    PageFetcher fetch;
+    PaginatorOptions options;
+    int nextRequest;
+    int lastPage = -1;
+    bool done = false;
+    std::deque<std::future<PageResult<T>>> inflight;
+    PageResult<T> current{};
+    size_t position = 0;
+};
+
+} // namespace client
+} // namespace dataapi
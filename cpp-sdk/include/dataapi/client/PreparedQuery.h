@@ -0,0 +1,79 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include "../Types.h"
+#include "../http/HttpClient.h"
+
+namespace dataapi {
+namespace client {
+
+/**
+ * 预编译查询句柄
+ *
+ * 首次执行前在服务端准备语句并缓存语句ID，之后每次执行只发送绑定参数，不再发送SQL文本。
+ * 服务端语句失效（执行返回404）时重新准备一次后重试；服务端不支持预编译语句（405/501）时
+ * 退化为每次发送SQL。线程安全，同一句柄可在多个线程中并发执行。
+ * 通常通过DatabaseClient::prepare获取，相同数据库和SQL的句柄被复用。
+ */
+class PreparedQuery {
+public:
+    /**
+     * 构造函数，不发起请求
+     * @param httpClient HTTP客户端
+     * @param databaseId 数据库ID
+     * @param sql SQL语句
+     */
+    PreparedQuery(std::shared_ptr<http::HttpClient> httpClient, std::string databaseId, std::string sql);
+
+    PreparedQuery(const PreparedQuery&) = delete;
+    PreparedQuery& operator=(const PreparedQuery&) = delete;
+
+    /**
+     * 在服务端准备语句，已准备时直接返回
+     */
+    void prepare();
+
+    /**
+     * 以绑定参数执行
+     * @param params 参数（可选）
+     * @return 查询结果
+     */
+    QueryResult execute(const Parameters& params = {});
+
+    /**
+     * 释放服务端语句，之后再执行时重新准备
+     */
+    void close();
+
+    const std::string& getDatabaseId() const { return databaseId; }
+    const std::string& getSql() const { return sql; }
+
+    /**
+     * 服务端语句ID，未准备或服务端不支持预编译语句时为空
+     */
+    std::string getStatementId() const;
+
+private:
+    /**
+     * 取得语句ID，未准备时先准备；服务端不支持时返回空
+     */
+    std::string statementFor();
+
+    /**
+     * 语句失效时清除缓存的ID，其他线程已重新准备时保留
+     */
+    void invalidate(const std::string& staleId);
+
+    std::shared_ptr<http::HttpClient> httpClient;
+    std::string databaseId;
+    std::string sql;
+
+    mutable std::mutex mutex;
+    std::string statementId;
+    bool unsupported = false;
+};
+
+} // namespace client
+} // namespace dataapi
@@ -5,6 +5,11 @@
 #include <memory>
 #include "../Types.h"
 #include "../http/HttpClient.h"
+#include "MetadataCache.h"
+#include "Paginator.h"
+#ifdef DATAAPI_WITH_COROUTINES
+#include "../coro/Task.h"
+#endif
 
 namespace dataapi {
 namespace client {
@@ -16,6 +21,7 @@ namespace client {
 class ProjectClient {
 private:
     std::shared_ptr<http::HttpClient> httpClient;
+    std::shared_ptr<MetadataCache> metadataCache;
     
 public:
     /**
@@ -51,6 +57,17 @@ public:
     PageResult<SysProject> list(int page = 1, int size = 20, 
                                const std::string& userId = "");
     
+    /**
+     * 遍历全部项目，按需逐页请求并预取后续页
+     * @param size 每页大小
+     * @param userId 用户ID（可选）
+     * @param options 遍历参数
+     * @return 分页遍历器，使用期间本客户端不得移动或销毁
+     */
+    Paginator<SysProject> paginate(int size = 20,
+                                 const std::string& userId = "",
+                                 const PaginatorOptions& options = {});
+    
     /**
      * 根据ID获取项目详情
      * @param id 项目ID
@@ -142,6 +159,19 @@ public:
                       const std::string& userId,
                       const std::string& permission);
     
+    /**
+     * 批量检查用户在项目中的权限
+     * 设置了元数据缓存且permissionTtl大于0时，先使用缓存的判断结果，只请求未缓存的权限；
+     * 未缓存的权限在一次请求中检查
+     * @param projectId 项目ID
+     * @param userId 用户ID
+     * @param permissions 权限名称列表
+     * @return 与permissions一一对应的结果
+     */
+    std::vector<bool> hasPermissions(const std::string& projectId,
+                                     const std::string& userId,
+                                     const std::vector<std::string>& permissions);
+    
     /**
      * 获取项目配置
      * @param projectId 项目ID
@@ -158,6 +188,18 @@ public:
     ProjectConfig updateConfig(const std::string& projectId, 
                               const ProjectConfig& config);
     
+    /**
+     * 设置元数据缓存，传入nullptr关闭
+     * 启用后getConfig先查缓存，本客户端的updateConfig/deleteProject使该项目的配置失效；
+     * hasPermission(s)缓存判断结果，setPermissions/removeMember/deleteProject使其失效
+     */
+    void setMetadataCache(std::shared_ptr<MetadataCache> cache);
+    
+    /**
+     * 获取元数据缓存，未设置时为nullptr
+     */
+    std::shared_ptr<MetadataCache> getMetadataCache() const;
+    
     /**
      * 获取项目统计信息
      * @param projectId 项目ID
@@ -211,6 +253,33 @@ public:
                            const std::string& data,
                            const std::string& format = "json");
     
+    /**
+     * 流式导入项目数据
+     * 请求体边读取边上传，内存占用与数据量无关。上传失败不会重试
+     * @param projectId 项目ID
+     * @param body 请求体
+     * @param format 数据格式
+     * @param onProgress 上传进度回调（可选）
+     * @return 导入结果
+     */
+    ImportResult importData(const std::string& projectId,
+                           http::UploadBody body,
+                           const std::string& format = "json",
+                           http::UploadProgress onProgress = {});
+    
+    /**
+     * 从文件流式导入项目数据
+     * @param projectId 项目ID
+     * @param path 文件路径
+     * @param format 数据格式
+     * @param onProgress 上传进度回调（可选）
+     * @return 导入结果
+     */
+    ImportResult importFile(const std::string& projectId,
+                           const std::string& path,
+                           const std::string& format = "json",
+                           http::UploadProgress onProgress = {});
+    
     /**
      * 复制项目
      * @param sourceProjectId 源项目ID
@@ -240,6 +309,19 @@ public:
      */
     SysProject createFromTemplate(const std::string& templateId,
                                  const ProjectCreateRequest& request);
+
+#ifdef DATAAPI_WITH_COROUTINES
+    /**
+     * 协程接口（以DATAAPI_ENABLE_COROUTINES构建时可用）
+     * 请求在curl_multi引擎上发送，挂起期间不占用线程，完成后在引擎线程上恢复；
+     * 不经过元数据缓存，修改操作仍使缓存失效。Task须在客户端销毁前完成
+     */
+    coro::Task<PageResult<SysProject>> listAsync(int page = 1, int size = 20, std::string userId = "");
+    coro::Task<SysProject> getByIdAsync(std::string id);
+    coro::Task<SysProject> createAsync(ProjectCreateRequest request);
+    coro::Task<SysProject> updateAsync(std::string id, ProjectUpdateRequest request);
+    coro::Task<void> deleteProjectAsync(std::string id);
+#endif
 };
 
 } // namespace client
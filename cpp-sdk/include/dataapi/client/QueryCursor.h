@@ -0,0 +1,166 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../Types.h"
+#include "../http/HttpClient.h"
+
+namespace dataapi {
+namespace client {
+
+/**
+ * 游标参数
+ */
+struct CursorOptions {
+    size_t prefetchRows = 1024; // 已解析但未被取走的最大行数，达到后暂停读取网络数据
+};
+
+/**
+ * 查询结果游标
+ *
+ * 后台线程接收响应体，边接收边切分并解析rows中的每一行，放入容量为prefetchRows的队列；
+ * 队列满时接收线程阻塞，由TCP流控向服务端施加背压。内存占用与prefetchRows成正比，
+ * 与结果集大小无关。游标在整个读取期间占用一个连接，不使用时应尽快close()。
+ */
+class QueryCursor {
+public:
+    /**
+     * 响应检查，非成功响应时抛出异常
+     */
+    using ResponseCheck = std::function<void(const http::HttpResponse&)>;
+
+    /**
+     * 构造函数，立即在后台发起请求
+     * @param httpClient HTTP客户端
+     * @param request 查询请求
+     * @param check 响应检查
+     * @param options 游标参数
+     */
+    QueryCursor(std::shared_ptr<http::HttpClient> httpClient,
+                HttpRequestConfig request,
+                ResponseCheck check,
+                const CursorOptions& options = {});
+
+    /**
+     * 析构函数，关闭游标
+     */
+    ~QueryCursor();
+
+    QueryCursor(const QueryCursor&) = delete;
+    QueryCursor& operator=(const QueryCursor&) = delete;
+
+    /**
+     * 读取下一行
+     * 阻塞直到有可用的行或结果结束；请求或解析失败时抛出异常
+     * @param row 输出行
+     * @return 读取到一行时返回true，结果结束时返回false
+     */
+    bool next(Json& row);
+
+    /**
+     * 获取列名
+     * 列信息位于rows之前时，读取第一行后即可用；否则在结果结束后可用
+     */
+    std::vector<std::string> getColumns() const;
+
+    /**
+     * 获取总行数（服务端返回totalRows时）
+     */
+    std::optional<int> getTotalRows() const;
+
+    /**
+     * 获取元数据
+     */
+    Json getMetadata() const;
+
+    /**
+     * 关闭游标，中止未完成的传输
+     * 传输在下一块数据到达时中止，因此可能短暂阻塞
+     */
+    void close();
+
+    /**
+     * 逐行输入迭代器
+     */
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Json;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Json*;
+        using reference = const Json&;
+
+        iterator() = default;
+        explicit iterator(QueryCursor* cursor) : cursor(cursor) {
+            ++(*this);
+        }
+
+        reference operator*() const {
+            return current;
+        }
+        pointer operator->() const {
+            return &current;
+        }
+        iterator& operator++() {
+            if (cursor && !cursor->next(current)) {
+                cursor = nullptr;
+            }
+            return *this;
+        }
+        bool operator==(const iterator& other) const {
+            return cursor == other.cursor;
+        }
+        bool operator!=(const iterator& other) const {
+            return cursor != other.cursor;
+        }
+
+    private:
+        QueryCursor* cursor = nullptr;
+        Json current;
+    };
+
+    iterator begin() {
+        return iterator(this);
+    }
+    iterator end() {
+        return iterator();
+    }
+
+private:
+    /**
+     * 后台线程：执行请求并解析响应
+     */
+    void produce();
+
+    std::shared_ptr<http::HttpClient> httpClient;
+    HttpRequestConfig request;
+    ResponseCheck check;
+    CursorOptions options;
+
+    mutable std::mutex mutex;
+    std::condition_variable rowsAvailable;
+    std::condition_variable spaceAvailable;
+    std::deque<Json> rows;
+    bool finished = false;
+    bool closed = false;
+    std::exception_ptr error;
+
+    std::vector<std::string> columns;
+    std::optional<int> totalRows;
+    Json metadata;
+
+    std::thread worker;
+};
+
+} // namespace client
+} // namespace dataapi
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include "../types/TimeSeries.h"
+
+namespace dataapi {
+namespace client {
+
+/**
+ * 滑动时间范围内的时间序列，按增量刷新
+ *
+ * 首次refresh()获取[now - range, now)的完整序列；之后只获取自上次最后一个点起的增量，
+ * 用其替换可能尚未完结的最后一个聚合桶并追加新点，同时丢弃滑出范围的点。
+ * 适合定时刷新的仪表盘：每次刷新的数据量与刷新间隔成正比，而不是与范围成正比。
+ * 不是线程安全的，每个使用方持有自己的实例。
+ */
+class TimeSeriesTracker {
+public:
+    /**
+     * 获取[start, end)内的序列
+     */
+    using Fetch = std::function<TimeSeries(Timestamp start, Timestamp end)>;
+
+    /**
+     * @param fetch 获取函数，通常来自DatabaseClient::trackMetrics或AiProviderClient::trackUsage
+     * @param range 保留的时间范围
+     */
+    TimeSeriesTracker(Fetch fetch, std::chrono::milliseconds range);
+
+    /**
+     * 刷新到now；获取失败时抛出异常，已有序列保持不变
+     * @return 刷新后的序列
+     */
+    const TimeSeries& refresh(Timestamp now = std::chrono::system_clock::now());
+
+    const TimeSeries& getSeries() const {
+        return series;
+    }
+
+    /**
+     * 清空序列，下次刷新时重新获取完整范围
+     */
+    void reset() {
+        series = TimeSeries();
+    }
+
+private:
+    Fetch fetch;
+    std::chrono::milliseconds range;
+    TimeSeries series;
+};
+
+} // namespace client
+} // namespace dataapi
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <future>
+#include <memory>
+#include <string>
+#include "../Types.h"
+#include "../http/HttpClient.h"
+
+namespace dataapi {
+namespace client {
+
+namespace detail {
+class TransactionPipeline;
+}
+
+/**
+ * 事务参数
+ */
+struct TransactionOptions {
+    bool bundle = false; // true：语句在本地缓冲，提交时begin、全部语句和commit合并为一个请求
+};
+
+/**
+ * 流水线事务
+ *
+ * execute()立即返回future，语句异步发送：同一时刻最多一个请求在途，在途期间加入的语句
+ * 合并进下一个请求；begin随第一个请求、commit随最后一个请求发送，不单独占用往返。
+ * 语句按加入顺序执行；任一语句失败后事务失败，之后的语句和commit()均以该错误失败。
+ * 未提交的事务在rollback()或析构时回滚（析构时不抛异常）。
+ */
+class Transaction {
+public:
+    /**
+     * 构造函数，不发起请求
+     * @param httpClient HTTP客户端
+     * @param databaseId 数据库ID
+     * @param options 事务参数
+     */
+    Transaction(std::shared_ptr<http::HttpClient> httpClient,
+                std::string databaseId,
+                const TransactionOptions& options = {});
+
+    /**
+     * 析构函数，未提交时回滚
+     */
+    ~Transaction();
+
+    Transaction(const Transaction&) = delete;
+    Transaction& operator=(const Transaction&) = delete;
+
+    /**
+     * 在事务中执行SQL
+     * @param sql SQL语句
+     * @param params 参数（可选）
+     * @return 执行结果的future
+     */
+    std::future<QueryResult> execute(std::string sql, Parameters params = {});
+
+    /**
+     * 提交事务，等待全部语句完成；任一语句或提交失败时抛出异常
+     */
+    void commit();
+
+    /**
+     * 回滚事务，丢弃尚未发送的语句；已提交或从未开始时不发起请求
+     */
+    void rollback();
+
+    /**
+     * 服务端事务ID，第一个请求完成前为空
+     */
+    std::string getTransactionId() const;
+
+private:
+    /**
+     * 发送下一批语句（如有），完成回调中继续发送
+     */
+    static void pump(std::shared_ptr<http::HttpClient> httpClient,
+                     std::shared_ptr<detail::TransactionPipeline> pipeline,
+                     const std::string& databaseId);
+
+    std::shared_ptr<http::HttpClient> httpClient;
+    std::string databaseId;
+    std::shared_ptr<detail::TransactionPipeline> pipeline;
+    bool closed = false;
+};
+
+} // namespace client
+} // namespace dataapi
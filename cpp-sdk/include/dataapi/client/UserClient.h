@@ -5,6 +5,11 @@
 #include <memory>
 #include "../Types.h"
 #include "../http/HttpClient.h"
+#include "MetadataCache.h"
+#include "Paginator.h"
+#ifdef DATAAPI_WITH_COROUTINES
+#include "../coro/Task.h"
+#endif
 
 namespace dataapi {
 namespace client {
@@ -16,6 +21,7 @@ namespace client {
 class UserClient {
 private:
     std::shared_ptr<http::HttpClient> httpClient;
+    std::shared_ptr<MetadataCache> metadataCache;
     
 public:
     /**
@@ -66,6 +72,19 @@ public:
                             const std::string& search = "",
                             const std::string& role = "");
     
+    /**
+     * 遍历全部用户，按需逐页请求并预取后续页
+     * @param size 每页大小
+     * @param search 搜索关键字（可选）
+     * @param role 角色（可选）
+     * @param options 遍历参数
+     * @return 分页遍历器，使用期间本客户端不得移动或销毁
+     */
+    Paginator<SysUser> paginate(int size = 20,
+                                 const std::string& search = "",
+                                 const std::string& role = "",
+                                 const PaginatorOptions& options = {});
+    
     /**
      * 根据ID获取用户详情
      * @param id 用户ID
@@ -160,6 +179,28 @@ public:
      */
     bool hasPermission(const std::string& userId, const std::string& permission);
     
+    /**
+     * 批量检查用户权限
+     * 设置了元数据缓存且permissionTtl大于0时，按getUserPermissions的快照在本地判断：
+     * 权限名称为"resource:action"（resource为空时为action），未列出的权限视为无权限，
+     * 同名条目中有拒绝时以拒绝为准。否则一次请求检查全部权限
+     * @param userId 用户ID
+     * @param permissions 权限名称列表
+     * @return 与permissions一一对应的结果
+     */
+    std::vector<bool> hasPermissions(const std::string& userId, const std::vector<std::string>& permissions);
+    
+    /**
+     * 设置元数据缓存，传入nullptr关闭
+     * 启用后hasPermission(s)使用缓存的权限快照，本客户端修改用户角色或删除用户时使该用户的快照失效
+     */
+    void setMetadataCache(std::shared_ptr<MetadataCache> cache);
+    
+    /**
+     * 获取元数据缓存，未设置时为nullptr
+     */
+    std::shared_ptr<MetadataCache> getMetadataCache() const;
+    
     /**
      * 获取用户偏好设置
      * @param userId 用户ID（可选，默认当前用户）
@@ -348,6 +389,20 @@ public:
      * @return 新的API密钥
      */
     ApiKey refreshApiKey(const std::string& keyId, const std::string& userId = "");
+
+#ifdef DATAAPI_WITH_COROUTINES
+    /**
+     * 协程接口（以DATAAPI_ENABLE_COROUTINES构建时可用）
+     * 请求在curl_multi引擎上发送，挂起期间不占用线程，完成后在引擎线程上恢复；
+     * 不经过元数据缓存，修改操作仍使缓存失效。Task须在客户端销毁前完成
+     */
+    coro::Task<PageResult<SysUser>> listAsync(int page = 1, int size = 20, std::string search = "", std::string role = "");
+    coro::Task<SysUser> getByIdAsync(std::string id);
+    coro::Task<SysUser> getCurrentUserAsync();
+    coro::Task<SysUser> createAsync(UserCreateRequest request);
+    coro::Task<SysUser> updateAsync(std::string id, UserUpdateRequest request);
+    coro::Task<void> deleteUserAsync(std::string id);
+#endif
 };
 
 } // namespace client
@@ -1,14 +1,63 @@
 #pragma once
 
+#include <chrono>
 #include <string>
 #include <vector>
 #include <memory>
 #include "../Types.h"
 #include "../http/HttpClient.h"
+#include "../http/RateLimiter.h"
+#include "ExecutionWatcher.h"
+#include "MetadataCache.h"
+#include "Paginator.h"
+#include "WorkflowValidator.h"
+#ifdef DATAAPI_WITH_COROUTINES
+#include "../coro/Task.h"
+#endif
 
 namespace dataapi {
 namespace client {
 
+/**
+ * 等待执行完成的参数
+ */
+struct WaitOptions {
+    std::chrono::milliseconds pollWait{20000};      // 单次长轮询在服务端挂起的最长时间，不超过客户端超时的3/4
+    std::chrono::milliseconds minPollInterval{1000}; // 服务端未挂起请求而立即返回时，两次请求之间的最短间隔
+};
+
+/**
+ * 待提交的一次执行
+ */
+struct WorkflowSubmission {
+    std::string workflowId;
+    Json input;
+};
+
+/**
+ * 批量提交参数
+ */
+struct ExecuteManyOptions {
+    int concurrency = 32;                              // 同时在途的提交请求数
+    std::shared_ptr<http::RateLimiter> rateLimiter;    // 发出每个提交前获取一个令牌（可选）
+    std::shared_ptr<ExecutionWatcher> watcher;         // 提交成功后立即登记到监听器，结果就绪时completion可用（可选）
+};
+
+/**
+ * 一次提交的结果
+ */
+struct ExecutionHandle {
+    std::string workflowId;
+    std::string executionId;                               // 提交失败时为空
+    std::shared_future<WorkflowExecutionResult> completion; // 指定了监听器且提交成功时有效
+    std::exception_ptr error;                              // 提交失败的原因
+    std::string errorMessage;
+    
+    bool submitted() const {
+        return !error;
+    }
+};
+
 /**
  * 工作流客户端类
  * 提供工作流相关的API操作
@@ -16,6 +65,8 @@ namespace client {
 class WorkflowClient {
 private:
     std::shared_ptr<http::HttpClient> httpClient;
+    std::shared_ptr<MetadataCache> metadataCache;
+    std::shared_ptr<const WorkflowSchema> compiledSchema; // 未设置元数据缓存时getSchema()保留的编译结果
     
 public:
     /**
@@ -53,6 +104,19 @@ public:
                                 const std::string& projectId = "",
                                 const std::string& userId = "");
     
+    /**
+     * 遍历全部工作流，按需逐页请求并预取后续页
+     * @param size 每页大小
+     * @param projectId 项目ID（可选）
+     * @param userId 用户ID（可选）
+     * @param options 遍历参数
+     * @return 分页遍历器，使用期间本客户端不得移动或销毁
+     */
+    Paginator<SysWorkflow> paginate(int size = 20,
+                                 const std::string& projectId = "",
+                                 const std::string& userId = "",
+                                 const PaginatorOptions& options = {});
+    
     /**
      * 根据ID获取工作流详情
      * @param id 工作流ID
@@ -81,6 +145,17 @@ public:
      */
     void deleteWorkflow(const std::string& id);
     
+    /**
+     * 设置元数据缓存，传入nullptr关闭
+     * 启用后getById先查缓存，本客户端的update/deleteWorkflow使该工作流的条目失效
+     */
+    void setMetadataCache(std::shared_ptr<MetadataCache> cache);
+    
+    /**
+     * 获取元数据缓存，未设置时为nullptr
+     */
+    std::shared_ptr<MetadataCache> getMetadataCache() const;
+    
     /**
      * 执行工作流
      * @param id 工作流ID
@@ -89,6 +164,11 @@ public:
      */
     WorkflowExecutionResult execute(const std::string& id, const Json& input = {});
     
+    /**
+     * 执行工作流，取得输入参数的所有权，大型输入不被复制
+     */
+    WorkflowExecutionResult execute(const std::string& id, Json&& input);
+    
     /**
      * 异步执行工作流
      * @param id 工作流ID
@@ -97,6 +177,11 @@ public:
      */
     std::string executeAsync(const std::string& id, const Json& input = {});
     
+    /**
+     * 异步执行工作流，取得输入参数的所有权
+     */
+    std::string executeAsync(const std::string& id, Json&& input);
+    
     /**
      * 获取工作流执行状态
      * @param executionId 执行ID
@@ -111,6 +196,38 @@ public:
      */
     WorkflowExecutionResult getExecutionResult(const std::string& executionId);
     
+    /**
+     * 等待执行完成并返回结果
+     * 以长轮询请求GET /workflows/executions/{id}/result?waitMs=N，服务端在执行结束或N毫秒后返回；
+     * 202/204或非终态的结果表示尚未完成。每次检查只需一次往返，不再分别查询状态和结果
+     * @param executionId 执行ID
+     * @param timeout 最长等待时间
+     * @param options 等待参数
+     * @return 执行结果，状态为COMPLETED、FAILED或CANCELLED
+     * @throws error::TimeoutError 超时仍未完成
+     */
+    WorkflowExecutionResult waitForCompletion(const std::string& executionId,
+                                              std::chrono::milliseconds timeout,
+                                              const WaitOptions& options = {});
+    
+    /**
+     * 批量异步执行工作流
+     * 提交请求通过异步引擎流水线发出，最多options.concurrency个同时在途；
+     * 返回时全部提交已完成，句柄按输入顺序排列，单个提交失败不影响其他提交。
+     * 指定监听器时，每个执行ID在提交响应到达时即登记，可随后逐个等待completion
+     * @param submissions 待提交的执行
+     * @param options 批量提交参数
+     * @return 与submissions一一对应的句柄
+     */
+    std::vector<ExecutionHandle> executeMany(const std::vector<WorkflowSubmission>& submissions,
+                                             const ExecuteManyOptions& options = {});
+    
+    /**
+     * 创建执行监听器，通过一条事件流等待任意多个执行完成
+     * @param options 监听参数
+     */
+    std::unique_ptr<ExecutionWatcher> createWatcher(const ExecutionWatcherOptions& options = {});
+    
     /**
      * 停止工作流执行
      * @param executionId 执行ID
@@ -128,12 +245,27 @@ public:
         const std::string& workflowId, int page = 1, int size = 20);
     
     /**
-     * 验证工作流定义
+     * 由服务端验证工作流定义
+     * 编辑过程中的频繁验证使用createValidator()在本地进行，服务端的结果是最终依据
      * @param definition 工作流定义
      * @return 验证结果
      */
     WorkflowValidationResult validate(const Json& definition);
     
+    /**
+     * 获取并编译工作流定义的JSON Schema
+     * 设置了元数据缓存时按MetadataKind::WorkflowSchema缓存编译结果（按schemaTtl过期），
+     * 否则编译结果保留在本客户端中，只获取一次
+     * @return 编译后的Schema，可在多个验证器和线程之间共享
+     */
+    std::shared_ptr<const WorkflowSchema> getSchema();
+    
+    /**
+     * 创建本地验证器，Schema通过getSchema()获取
+     * @return 验证器，每个编辑会话持有一个，以便增量验证
+     */
+    WorkflowValidator createValidator();
+    
     /**
      * 导出工作流
      * @param id 工作流ID
@@ -202,6 +334,27 @@ public:
      * @param versionId 版本ID
      */
     void rollbackToVersion(const std::string& workflowId, const std::string& versionId);
+
+#ifdef DATAAPI_WITH_COROUTINES
+    /**
+     * 协程接口（以DATAAPI_ENABLE_COROUTINES构建时可用）
+     * 请求在curl_multi引擎上发送，挂起期间不占用线程，完成后在引擎线程上恢复；
+     * 不经过元数据缓存，修改操作仍使缓存失效。Task须在客户端销毁前完成
+     */
+    coro::Task<PageResult<SysWorkflow>> listAsync(int page = 1, int size = 20,
+                                                  std::string projectId = "", std::string userId = "");
+    coro::Task<SysWorkflow> getByIdAsync(std::string id);
+    coro::Task<SysWorkflow> createAsync(WorkflowCreateRequest request);
+    coro::Task<SysWorkflow> updateAsync(std::string id, WorkflowUpdateRequest request);
+    coro::Task<void> deleteWorkflowAsync(std::string id);
+    
+    /**
+     * 同步执行工作流（协程），与execute相同；executeAsync是服务端异步执行，返回执行ID
+     */
+    coro::Task<WorkflowExecutionResult> runAsync(std::string id, Json input = {});
+    coro::Task<WorkflowExecutionStatus> getExecutionStatusAsync(std::string executionId);
+    coro::Task<WorkflowExecutionResult> getExecutionResultAsync(std::string executionId);
+#endif
 };
 
 } // namespace client
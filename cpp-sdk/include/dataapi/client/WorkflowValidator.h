@@ -0,0 +1,113 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../Types.h"
+
+namespace dataapi {
+namespace client {
+
+/**
+ * 编译后的工作流定义JSON Schema
+ *
+ * 编译时把Schema展开为节点数组：$ref解析为节点下标，properties预先建立查找表，
+ * 各关键字的参数（类型掩码、长度和数值范围、正则表达式等）预先解析；验证时按实例的类型分派，
+ * 不再读取Schema的Json。支持的关键字：type、properties、required、additionalProperties、
+ * min/maxProperties、items、min/maxItems、uniqueItems、minLength、maxLength、pattern、
+ * minimum、maximum、exclusiveMinimum、exclusiveMaximum、enum、const、allOf、anyOf、oneOf、
+ * 指向本文档内的$ref（#/definitions/...、#/$defs/...等）；其他关键字（format、default等）被忽略。
+ * 编译后不可变，可在线程之间共享。
+ */
+class WorkflowSchema {
+public:
+    /**
+     * 一个验证错误
+     */
+    struct Issue {
+        std::string path;    // 实例中的位置（JSON Pointer，根为空）
+        std::string message;
+    };
+
+    /**
+     * 编译Schema
+     * @throws std::invalid_argument Schema无效或$ref无法解析
+     */
+    static std::shared_ptr<const WorkflowSchema> compile(const Json& schema);
+
+    ~WorkflowSchema();
+
+    /**
+     * 验证整个实例，错误追加到issues
+     */
+    void validate(const Json& instance, std::vector<Issue>& issues) const;
+
+    /**
+     * 验证实例中path处的值
+     * 所用的Schema节点沿path从根确定；途经allOf/anyOf/oneOf时无法唯一确定，返回false且不追加错误
+     * @param instance 完整的实例
+     * @param path 位置（JSON Pointer），实例中不存在时不做检查
+     * @param issues 错误输出
+     * @param deep true验证整个子树；false只检查该值自身（类型、required、元素个数等），不深入子节点
+     * @return 是否完成了验证
+     */
+    bool validateAt(const Json& instance, const std::string& path, std::vector<Issue>& issues,
+                    bool deep = true) const;
+
+    /**
+     * 编译后的节点数
+     */
+    size_t size() const;
+
+private:
+    struct Node;
+    struct Compiler;
+    struct Checker;
+
+    WorkflowSchema();
+
+    std::vector<Node> nodes;
+};
+
+/**
+ * 工作流定义的本地验证器
+ *
+ * validate()完整验证并按实例位置记录错误；之后revalidate()只重新验证变化的子树，
+ * 其余位置沿用上次的错误，适合编辑器在每次输入后验证。变化的位置只影响自身子树和各级祖先，
+ * 与之无关的兄弟节点不重新检查。数组中插入或删除元素会改变后续元素的位置，此时应传入数组本身的路径。
+ * 本地验证只用于即时反馈，服务端在create/importWorkflow时的验证是最终依据。
+ * 不是线程安全的，每个编辑会话持有自己的实例，编译后的Schema可以共享。
+ */
+class WorkflowValidator {
+public:
+    explicit WorkflowValidator(std::shared_ptr<const WorkflowSchema> schema);
+
+    /**
+     * 完整验证
+     */
+    WorkflowValidationResult validate(const Json& definition);
+
+    /**
+     * 增量验证：只重新验证changedPaths处的子树及其祖先
+     * 尚未做过完整验证，或变化位置途经allOf/anyOf/oneOf时退化为完整验证
+     * @param definition 修改后的完整定义
+     * @param changedPaths 自上次验证以来变化的位置（JSON Pointer，""表示整个定义）
+     */
+    WorkflowValidationResult revalidate(const Json& definition, const std::vector<std::string>& changedPaths);
+
+    const std::shared_ptr<const WorkflowSchema>& getSchema() const {
+        return schema;
+    }
+
+private:
+    void record(std::vector<WorkflowSchema::Issue>& found);
+    WorkflowValidationResult result() const;
+
+    std::shared_ptr<const WorkflowSchema> schema;
+    std::map<std::string, std::vector<std::string>> issues; // 实例位置 -> 该位置上的错误
+    bool validated = false;
+};
+
+} // namespace client
+} // namespace dataapi
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+#include "Task.h"
+#include "../http/HttpClient.h"
+
+namespace dataapi {
+namespace coro {
+
+/**
+ * 在curl_multi引擎上发送请求的awaitable
+ *
+ * 挂起期间不占用线程，请求完成后在引擎线程上恢复协程。
+ * 与requestAsync相同，不经过同步路径的重试；client须在完成前保持有效。
+ */
+class RequestAwaitable {
+public:
+    RequestAwaitable(http::HttpClient& client, HttpRequestConfig config)
+        : client(client), config(std::move(config)) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        // 回调可能在requestAsync返回前于引擎线程上恢复并销毁协程帧，请求配置先移到栈上
+        HttpRequestConfig request = std::move(config);
+        client.requestAsync(std::move(request), [this, handle](http::HttpResponse result, std::exception_ptr failure) {
+            response = std::move(result);
+            error = failure;
+            handle.resume();
+        });
+    }
+
+    http::HttpResponse await_resume() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return std::move(response);
+    }
+
+private:
+    http::HttpClient& client;
+    HttpRequestConfig config;
+    http::HttpResponse response;
+    std::exception_ptr error;
+};
+
+/**
+ * 发送请求并在完成时恢复
+ * 例：auto response = co_await coro::request(client, std::move(config));
+ */
+inline RequestAwaitable request(http::HttpClient& client, HttpRequestConfig config) {
+    return RequestAwaitable(client, std::move(config));
+}
+
+} // namespace coro
+} // namespace dataapi
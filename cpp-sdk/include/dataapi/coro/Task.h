@@ -0,0 +1,255 @@
+#pragma once
+
+#ifndef DATAAPI_WITH_COROUTINES
+#error "dataapi/coro/Task.h requires building with DATAAPI_ENABLE_COROUTINES=ON (C++20)"
+#endif
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace dataapi {
+namespace coro {
+
+/**
+ * 执行器：接收一个任务并在执行器自己的线程上运行
+ * 用于把协程从引擎线程切换到调用方的线程池或事件循环
+ */
+using Executor = std::function<void(std::function<void()> task)>;
+
+template<typename T>
+class Task;
+
+namespace detail {
+
+/**
+ * 结束时恢复等待者（对称转移，不增加栈深度）
+ */
+struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+
+    template<typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+        auto continuation = handle.promise().continuation;
+        return continuation ? continuation : std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+};
+
+struct PromiseBase {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr error;
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { error = std::current_exception(); }
+};
+
+template<typename T>
+struct Promise : PromiseBase {
+    std::optional<T> value;
+
+    Task<T> get_return_object() noexcept;
+
+    template<typename U>
+    void return_value(U&& result) {
+        value.emplace(std::forward<U>(result));
+    }
+
+    T take() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return std::move(*value);
+    }
+};
+
+template<>
+struct Promise<void> : PromiseBase {
+    Task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept {}
+
+    void take() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+} // namespace detail
+
+/**
+ * 惰性协程任务
+ *
+ * 创建时不执行，被co_await时开始运行，结束后在完成它的线程上恢复等待者。
+ * SDK的异步接口在curl_multi引擎线程上完成，因此默认在引擎线程上恢复；
+ * 不应在该线程上长时间阻塞，需要时用on()切换到自己的执行器。
+ * 只能被co_await一次。
+ */
+template<typename T = void>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::Promise<T>;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept : handle(handle) {}
+
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            reset();
+            handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() { reset(); }
+
+    bool await_ready() const noexcept { return !handle || handle.done(); }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+
+    T await_resume() { return handle.promise().take(); }
+
+private:
+    void reset() {
+        if (handle) {
+            handle.destroy();
+            handle = {};
+        }
+    }
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+template<typename T>
+Task<T> detail::Promise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+inline Task<void> detail::Promise<void>::get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+/**
+ * 在executor上恢复当前协程
+ */
+class ResumeOn {
+public:
+    explicit ResumeOn(Executor executor) : executor(std::move(executor)) {}
+
+    bool await_ready() const noexcept { return !executor; }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        executor([handle] { handle.resume(); });
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    Executor executor;
+};
+
+inline ResumeOn resumeOn(Executor executor) {
+    return ResumeOn(std::move(executor));
+}
+
+/**
+ * 运行task，完成后在executor上恢复等待者
+ * 例：auto workflow = co_await coro::on(pool, workflows.getByIdAsync(id));
+ */
+template<typename T>
+Task<T> on(Executor executor, Task<T> task) {
+    if constexpr (std::is_void_v<T>) {
+        std::exception_ptr error;
+        try {
+            co_await std::move(task);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        co_await resumeOn(std::move(executor));
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    } else {
+        std::optional<T> value;
+        std::exception_ptr error;
+        try {
+            value.emplace(co_await std::move(task));
+        } catch (...) {
+            error = std::current_exception();
+        }
+        co_await resumeOn(std::move(executor));
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        co_return std::move(*value);
+    }
+}
+
+namespace detail {
+
+/**
+ * 立即开始、结束时自行销毁的协程，用于syncWait和spawn
+ */
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+template<typename T>
+Detached fulfil(Task<T> task, std::shared_ptr<std::promise<T>> result) {
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await std::move(task);
+            result->set_value();
+        } else {
+            result->set_value(co_await std::move(task));
+        }
+    } catch (...) {
+        result->set_exception(std::current_exception());
+    }
+}
+
+} // namespace detail
+
+/**
+ * 启动task并返回其结果的future，不阻塞
+ */
+template<typename T>
+std::future<T> spawn(Task<T> task) {
+    auto result = std::make_shared<std::promise<T>>();
+    auto future = result->get_future();
+    detail::fulfil(std::move(task), result);
+    return future;
+}
+
+/**
+ * 阻塞当前线程直到task完成，返回结果或重新抛出异常
+ * 不能在引擎线程或task依赖的执行器线程上调用
+ */
+template<typename T>
+T syncWait(Task<T> task) {
+    return spawn(std::move(task)).get();
+}
+
+} // namespace coro
+} // namespace dataapi
@@ -414,6 +414,40 @@ public:
     }
 };
 
+/**
+ * 连接错误类
+ * 连接建立阶段失败（DNS解析、TCP连接），请求尚未发送到服务端，
+ * 因此即使是非幂等请求也可以安全重试
+ */
+class ConnectionError : public NetworkError {
+public:
+    /**
+     * 构造函数
+     * @param message 错误消息
+     */
+    ConnectionError(const std::string& message);
+};
+
+/**
+ * 响应体接收中止错误类
+ * 调用方的BodySink返回false时抛出，表示调用方主动停止接收，与服务端健康无关，也不应重试
+ */
+class SinkAbortedError : public NetworkError {
+public:
+    /**
+     * 构造函数
+     * @param message 错误消息
+     */
+    SinkAbortedError(const std::string& message = "Response body sink aborted the transfer");
+    
+    /**
+     * 是否可重试
+     */
+    bool isRetryable() const override {
+        return false;
+    }
+};
+
 /**
  * 服务不可用错误类
  */
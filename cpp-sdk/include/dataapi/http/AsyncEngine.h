@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "CurlRuntime.h"
+
+namespace dataapi {
+namespace http {
+
+/**
+ * 基于curl_multi的异步请求引擎
+ *
+ * 单个后台线程驱动一个multi句柄，所有提交的easy句柄在该线程上并发执行，
+ * 一个线程即可同时保持成千上万个请求在途。multi句柄维护自己的连接缓存，
+ * 总连接数受Limits::maxConnections限制，超出的请求由libcurl排队等待空闲连接；
+ * 启用多路复用时，多个请求作为HTTP/2流共享同一个连接。
+ */
+class AsyncEngine {
+public:
+    /**
+     * 连接与多路复用限制
+     */
+    struct Limits {
+        size_t maxConnections = 10;        // 最大并发连接数
+        bool multiplex = false;            // 是否在HTTP/2连接上多路复用
+        long maxConcurrentStreams = 100;   // 每个连接的最大并发流数
+    };
+
+    /**
+     * 请求完成回调，参数为CURLcode
+     * 回调在引擎线程上执行，不应阻塞
+     */
+    using Completion = std::function<void(int curlCode)>;
+
+    /**
+     * 构造函数，启动事件循环线程
+     * @param runtime 共享CURL运行时
+     * @param limits 连接与多路复用限制
+     */
+    AsyncEngine(std::shared_ptr<CurlRuntime> runtime, const Limits& limits);
+
+    /**
+     * 析构函数，停止事件循环，未完成的请求以CURLE_ABORTED_BY_CALLBACK结束
+     */
+    ~AsyncEngine();
+
+    AsyncEngine(const AsyncEngine&) = delete;
+    AsyncEngine& operator=(const AsyncEngine&) = delete;
+
+    /**
+     * 提交一个已配置好的easy句柄
+     * 句柄在完成回调返回前归引擎使用，调用方负责在回调之后释放
+     * @param handle CURL easy句柄
+     * @param done 完成回调
+     */
+    void submit(void* handle, Completion done);
+
+    /**
+     * 调整连接与多路复用限制
+     */
+    void setLimits(const Limits& limits);
+
+    /**
+     * 获取在途请求数量（包括排队中的请求）
+     */
+    size_t getInFlightCount() const {
+        return inFlight.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Submission {
+        void* handle;
+        Completion done;
+    };
+
+    /**
+     * 事件循环
+     */
+    void run();
+
+    /**
+     * 将待提交队列中的句柄加入multi句柄
+     */
+    void drainSubmissions();
+
+    /**
+     * 处理已完成的请求
+     */
+    void processCompletions();
+
+    std::shared_ptr<CurlRuntime> runtime;
+    void* multiHandle;
+
+    std::mutex mutex;
+    std::vector<Submission> pending;
+    Limits pendingLimits;
+    bool limitsChanged;
+
+    // 仅由引擎线程访问
+    std::unordered_map<void*, Completion> active;
+
+    std::atomic<size_t> inFlight;
+    std::atomic<bool> stopping;
+    std::thread worker;
+};
+
+} // namespace http
+} // namespace dataapi
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace dataapi {
+namespace http {
+
+/**
+ * 熔断参数
+ */
+struct CircuitBreakerOptions {
+    size_t windowSize = 20;                       // 统计最近多少次调用的结果
+    size_t minimumCalls = 10;                     // 窗口内调用数达到该值后才判断失败率
+    double failureRateThreshold = 0.5;            // 失败率达到该值时熔断
+    std::chrono::milliseconds openDuration{5000}; // 熔断持续时间，之后进入半开状态
+    size_t halfOpenCalls = 1;                     // 半开状态放行的探测调用数，全部成功后恢复
+};
+
+/**
+ * 熔断器
+ *
+ * 闭合状态下按滑动窗口统计失败率，超过阈值后断开：openDuration内的调用直接拒绝，
+ * 不再等待已失效的服务端超时。随后进入半开状态放行少量探测调用，全部成功则闭合，
+ * 任一失败则重新断开。
+ * 每次准入返回一个票据，上报结果时传回；状态切换后，切换前放行的调用的结果被忽略。
+ * 线程安全。
+ */
+class CircuitBreaker {
+public:
+    enum class State {
+        Closed,
+        Open,
+        HalfOpen
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    explicit CircuitBreaker(const CircuitBreakerOptions& options = {});
+
+    /**
+     * 请求准入
+     * @param ticket 放行时写入票据
+     * @return 是否放行
+     */
+    bool tryAcquire(uint64_t& ticket);
+
+    /**
+     * 上报成功
+     */
+    void onSuccess(uint64_t ticket);
+
+    /**
+     * 上报失败（超时、网络错误、服务不可用）
+     */
+    void onFailure(uint64_t ticket);
+
+    /**
+     * 上报与服务端健康无关的结果（如取消），只归还半开状态的探测名额
+     */
+    void onIgnored(uint64_t ticket);
+
+    /**
+     * 当前状态；断开时间已到但尚无调用时仍为Open
+     */
+    State getState() const;
+
+    /**
+     * 当前窗口内的失败率，窗口为空时为0
+     */
+    double getFailureRate() const;
+
+private:
+    void transition(State next, Clock::time_point now);
+
+    CircuitBreakerOptions options;
+    mutable std::mutex mutex;
+    State state = State::Closed;
+    uint64_t epoch = 0;                  // 每次状态切换递增，作为票据
+    std::vector<bool> window;            // 环形缓冲区，true表示失败
+    size_t next = 0;
+    size_t calls = 0;
+    size_t failures = 0;
+    size_t probes = 0;                   // 半开状态已放行的探测调用数
+    size_t probeSuccesses = 0;
+    Clock::time_point openUntil;
+};
+
+/**
+ * 按端点组管理熔断器
+ * 端点组为请求路径的首段，如"/workflows/42/execute"属于"/workflows"，
+ * 一个服务模块故障时不影响其他模块的请求。
+ */
+class CircuitBreakerRegistry {
+public:
+    explicit CircuitBreakerRegistry(const CircuitBreakerOptions& options = {});
+
+    /**
+     * 获取端点组的熔断器，不存在时创建
+     */
+    std::shared_ptr<CircuitBreaker> get(const std::string& group);
+
+    /**
+     * 计算请求路径所属的端点组
+     */
+    static std::string groupOf(const std::string& path);
+
+private:
+    CircuitBreakerOptions options;
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<CircuitBreaker>> breakers;
+};
+
+} // namespace http
+} // namespace dataapi
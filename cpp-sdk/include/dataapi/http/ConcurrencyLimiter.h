@@ -0,0 +1,79 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+
+namespace dataapi {
+namespace http {
+
+/**
+ * 自适应并发限制参数
+ */
+struct ConcurrencyLimitOptions {
+    int initialLimit = 20;
+    int minLimit = 1;
+    int maxLimit = 200;
+    double backoffRatio = 0.9;    // 超时、服务不可用或429时上限乘以该系数
+    double alpha = 3;             // 估算的排队请求数低于alpha时上限加一
+    double beta = 6;              // 高于beta时上限减一
+    size_t baselineSamples = 500; // 每隔多少个样本以该段内的最小延迟更新基准延迟
+};
+
+/**
+ * 自适应并发限制器
+ *
+ * 按TCP Vegas的思路由延迟估算服务端排队：queue = limit * (1 - 基准延迟 / 本次延迟)。
+ * 排队少且并发已用到上限一半以上时加性增加上限，排队多时减一，
+ * 超时或服务端过载时乘性减小（AIMD）。在途请求数达到上限时新请求直接拒绝，
+ * 在服务端排队增长之前削减负载。基准延迟为最近一段样本内的最小延迟，
+ * 服务端延迟整体变化后随之更新。
+ * 线程安全。
+ */
+class AdaptiveConcurrencyLimiter {
+public:
+    explicit AdaptiveConcurrencyLimiter(const ConcurrencyLimitOptions& options = {});
+
+    /**
+     * 请求准入，放行后必须以下列方法之一上报结果
+     * @return 在途请求数未达到上限时返回true
+     */
+    bool tryAcquire();
+
+    /**
+     * 上报成功完成的请求及其延迟
+     */
+    void onSample(std::chrono::microseconds latency);
+
+    /**
+     * 上报超时或服务端过载
+     */
+    void onDropped();
+
+    /**
+     * 上报不反映服务端负载的结果（如流式下载、取消），只释放名额
+     */
+    void onIgnored();
+
+    /**
+     * 当前并发上限
+     */
+    int getLimit() const;
+
+    /**
+     * 当前在途请求数
+     */
+    int getInFlight() const;
+
+private:
+    ConcurrencyLimitOptions options;
+    mutable std::mutex mutex;
+    double limit;
+    int inFlight = 0;
+    std::chrono::microseconds baseline{0};   // 基准延迟，0表示尚无样本
+    std::chrono::microseconds windowMin{0};  // 当前段内的最小延迟
+    size_t windowSamples = 0;
+};
+
+} // namespace http
+} // namespace dataapi
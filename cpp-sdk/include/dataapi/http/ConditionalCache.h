@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include "../Types.h"
+#include "ResponseHeaders.h"
+
+namespace dataapi {
+namespace http {
+
+/**
+ * 条件请求的校验器
+ */
+struct Validators {
+    std::string etag;
+    std::string lastModified;
+
+    bool empty() const {
+        return etag.empty() && lastModified.empty();
+    }
+
+    /**
+     * 从响应头提取ETag和Last-Modified
+     * Cache-Control含no-store时返回空校验器，响应不应被保存
+     */
+    static Validators from(const ResponseHeaders& headers);
+
+    /**
+     * 添加If-None-Match/If-Modified-Since请求头
+     */
+    void apply(Headers& headers) const;
+};
+
+/**
+ * 条件请求缓存统计
+ */
+struct ConditionalCacheStats {
+    uint64_t notModified = 0; // 服务端返回304、复用已解码对象的次数
+    uint64_t stored = 0;      // 保存的完整响应数
+};
+
+/**
+ * 按URL保存GET响应的校验器和已解码的对象
+ *
+ * 通过HttpClient::setConditionalCache启用后，SDK中读多写少的GET接口在再次请求时
+ * 携带上次响应的校验器；服务端返回304时直接返回上次解码的对象，不传输也不解析响应体。
+ * 没有ETag和Last-Modified的响应不保存。按最近最少使用淘汰，线程安全。
+ */
+class ConditionalCache {
+public:
+    struct Entry {
+        Validators validators;
+        std::type_index type;               // 解码后对象的类型，读取时类型不符视为未命中
+        std::shared_ptr<const void> value;
+    };
+
+    /**
+     * 构造函数
+     * @param maxEntries 最多保存的URL数
+     */
+    explicit ConditionalCache(size_t maxEntries = 1024);
+
+    /**
+     * 查找URL对应的条目
+     */
+    std::shared_ptr<const Entry> find(const std::string& url);
+
+    /**
+     * 保存响应，替换URL已有的条目
+     */
+    void store(const std::string& url, Validators validators,
+               std::type_index type, std::shared_ptr<const void> value);
+
+    /**
+     * 记录一次304响应
+     */
+    void recordNotModified() {
+        ++notModified;
+    }
+
+    void erase(const std::string& url);
+    void clear();
+    size_t size() const;
+
+    ConditionalCacheStats getStats() const;
+
+private:
+    using Item = std::pair<std::string, std::shared_ptr<const Entry>>;
+
+    size_t maxEntries;
+    mutable std::mutex mutex;
+    std::list<Item> items; // 最近使用的在前
+    std::unordered_map<std::string, std::list<Item>::iterator> index;
+    std::atomic<uint64_t> notModified{0};
+    std::atomic<uint64_t> stored{0};
+};
+
+} // namespace http
+} // namespace dataapi
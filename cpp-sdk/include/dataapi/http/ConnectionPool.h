@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_map>
+#include <vector>
+#include "CurlRuntime.h"
+
+namespace dataapi {
+namespace http {
+
+/**
+ * CURL easy句柄连接池
+ *
+ * 池中的句柄在请求之间复用，从而保留各自连接缓存中已建立的TCP/TLS连接；
+ * 所有句柄还绑定到CurlRuntime的共享句柄，共享DNS缓存和TLS会话，
+ * 新建连接时可以跳过DNS解析并恢复TLS会话。
+ */
+class ConnectionPool {
+public:
+    /**
+     * 池中句柄的租约，析构时自动归还句柄
+     */
+    class Lease {
+    private:
+        ConnectionPool* pool;
+        void* handle;
+        size_t slot;
+
+    public:
+        Lease(ConnectionPool* pool, void* handle, size_t slot) : pool(pool), handle(handle), slot(slot) {}
+        ~Lease();
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        Lease(Lease&& other) noexcept : pool(other.pool), handle(other.handle), slot(other.slot) {
+            other.pool = nullptr;
+            other.handle = nullptr;
+        }
+        Lease& operator=(Lease&& other) noexcept;
+
+        /**
+         * 获取CURL句柄
+         */
+        void* get() const {
+            return handle;
+        }
+
+        /**
+         * 句柄的槽位编号，按创建顺序分配，在句柄的生命周期内不变
+         */
+        size_t getSlot() const {
+            return slot;
+        }
+    };
+
+    /**
+     * 构造函数
+     * @param maxSize 池中最多同时存在的句柄数量
+     * @param runtime 共享CURL运行时
+     */
+    ConnectionPool(size_t maxSize, std::shared_ptr<CurlRuntime> runtime);
+
+    /**
+     * 析构函数，释放所有空闲句柄
+     */
+    ~ConnectionPool();
+
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+    /**
+     * 获取一个句柄，池已满且无空闲句柄时阻塞等待
+     * @return 句柄租约
+     */
+    Lease acquire();
+
+    /**
+     * 调整池大小，多出的空闲句柄会被释放
+     * @param maxSize 新的最大句柄数量
+     */
+    void setMaxSize(size_t maxSize);
+
+    /**
+     * 获取最大句柄数量
+     */
+    size_t getMaxSize() const;
+
+    /**
+     * 获取当前空闲句柄数量
+     */
+    size_t getIdleCount() const;
+
+    /**
+     * 获取当前已创建的句柄数量（包括正在使用的）
+     */
+    size_t getTotalCount() const;
+
+private:
+    /**
+     * 归还句柄
+     */
+    void release(void* handle);
+
+    /**
+     * 创建新句柄并绑定共享句柄
+     */
+    void* createHandle();
+
+    /**
+     * 释放多出的空闲句柄，调用时需持有mutex
+     */
+    void trimIdleLocked();
+
+    std::shared_ptr<CurlRuntime> runtime;
+
+    mutable std::mutex mutex;
+    std::condition_variable available;
+    std::vector<void*> idle;
+    std::unordered_map<void*, size_t> slots;
+    size_t nextSlot = 0;
+    size_t maxSize;
+    size_t totalCount;
+};
+
+} // namespace http
+} // namespace dataapi
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace dataapi {
+namespace http {
+
+/**
+ * 进程级CURL运行时
+ *
+ * 负责一次性完成curl_global_init（包括OpenSSL初始化），并持有在所有HttpClient
+ * 实例之间共享的CURLSH（DNS缓存、TLS会话缓存）和已解析的CA证书存储。运行时在首次使用时创建，
+ * 由静态引用和所有使用它的客户端共同持有，进程退出且最后一个客户端销毁后才清理，
+ * 因此频繁创建和销毁HttpClient不会重复初始化全局状态。
+ */
+class CurlRuntime {
+public:
+    /**
+     * 获取进程级共享运行时（线程安全）
+     * @return 运行时实例
+     */
+    static std::shared_ptr<CurlRuntime> instance();
+
+    /**
+     * 析构函数，执行curl_global_cleanup
+     */
+    ~CurlRuntime();
+
+    CurlRuntime(const CurlRuntime&) = delete;
+    CurlRuntime& operator=(const CurlRuntime&) = delete;
+
+    /**
+     * 获取共享句柄（CURLSH*），所有easy句柄通过CURLOPT_SHARE绑定
+     */
+    void* getShareHandle() const {
+        return shareHandle;
+    }
+
+    /**
+     * 当前libcurl是否支持HTTP/2
+     */
+    bool supportsHttp2() const {
+        return http2Supported;
+    }
+
+    /**
+     * 获取进程内共享的CA证书存储（X509_STORE*），每个证书来源只解析一次
+     * 新建TLS连接时通过CURLOPT_SSL_CTX_FUNCTION安装，免去每次握手重新读取和解析证书包
+     * @param caFile CA证书文件，空表示libcurl默认的证书文件和目录
+     * @return 证书存储；libcurl的TLS后端不是本进程链接的OpenSSL或加载失败时返回nullptr
+     */
+    void* getCertificateStore(const std::string& caFile);
+
+private:
+    CurlRuntime();
+
+    void* shareHandle;
+    std::mutex shareLocks[8];
+    bool http2Supported;
+    bool sharedStoreSupported;
+    std::mutex storeMutex;
+    std::unordered_map<std::string, void*> certificateStores; // 证书来源 -> X509_STORE*，加载失败时为nullptr
+};
+
+} // namespace http
+} // namespace dataapi
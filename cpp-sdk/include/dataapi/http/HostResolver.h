@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace dataapi {
+namespace http {
+
+/**
+ * 服务域名的地址缓存，用于把连接分散到域名解析出的多个后端地址
+ *
+ * 地址按RFC 8305交替排列IPv6和IPv4，每个连接按槽位固定选用其中一个，
+ * 池中的连接因此均匀分布在各地址上且各自保持复用。连接失败的地址在一段时间内
+ * 被跳过，此时重试会落到下一个地址（可能是另一地址族）上。
+ * 线程安全。
+ */
+class HostResolver {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * 构造函数
+     * @param ttl 解析结果的有效期
+     */
+    explicit HostResolver(std::chrono::seconds ttl = std::chrono::seconds(60));
+
+    /**
+     * 解析主机名，有效期内返回缓存的结果
+     * @return 交替排列IPv6和IPv4的地址列表，解析失败时为空
+     */
+    std::vector<std::string> resolve(const std::string& host);
+
+    /**
+     * 为槽位选择地址，跳过暂不可用的地址；全部不可用时仍按槽位选择
+     * @return 地址，解析失败时为空
+     */
+    std::string select(const std::string& host, size_t slot);
+
+    /**
+     * 为不占用固定槽位的连接（异步请求）分配轮换的槽位
+     */
+    size_t nextSlot() {
+        return rotation.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * 标记地址暂不可用
+     */
+    void markUnreachable(const std::string& host, const std::string& address,
+                         std::chrono::milliseconds duration = std::chrono::milliseconds(30000));
+
+    /**
+     * 将地址格式化为CURLOPT_CONNECT_TO条目，替换发往host任意端口的连接的目标地址
+     */
+    static std::string connectTo(const std::string& host, const std::string& address);
+
+private:
+    struct Entry {
+        std::vector<std::string> addresses;
+        std::unordered_map<std::string, Clock::time_point> unreachableUntil;
+        Clock::time_point expires;
+    };
+
+    Entry& lookupLocked(const std::string& host, std::unique_lock<std::mutex>& lock);
+
+    std::chrono::seconds ttl;
+    std::mutex mutex;
+    std::unordered_map<std::string, Entry> entries;
+    std::atomic<size_t> rotation{0};
+};
+
+} // namespace http
+} // namespace dataapi
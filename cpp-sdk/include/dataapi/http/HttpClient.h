@@ -1,12 +1,29 @@
 #pragma once
 
+#include <chrono>
 #include <string>
 #include <unordered_map>
 #include <memory>
 #include <functional>
+#include <future>
+#include <exception>
+#include <mutex>
+#include <iosfwd>
+#include <string_view>
 #include "../Types.h"
 #include "../ClientConfig.h"
 #include "../auth/AuthenticationProvider.h"
+#include "ConnectionPool.h"
+#include "CurlRuntime.h"
+#include "AsyncEngine.h"
+#include "RetryPolicy.h"
+#include "RequestMetrics.h"
+#include "ResponseHeaders.h"
+#include "ConditionalCache.h"
+#include "CircuitBreaker.h"
+#include "ConcurrencyLimiter.h"
+#include "HostResolver.h"
+#include "UploadBody.h"
 
 namespace dataapi {
 namespace http {
@@ -17,7 +34,7 @@ namespace http {
 struct HttpResponse {
     int statusCode;
     std::string body;
-    Headers headers;
+    ResponseHeaders headers;
     std::string errorMessage;
     
     HttpResponse() : statusCode(0) {}
@@ -27,21 +44,154 @@ struct HttpResponse {
     }
 };
 
+/**
+ * 异步请求完成回调
+ * 请求成功时error为空；失败时error携带异常，response无效
+ * 回调在异步引擎线程上执行，不应阻塞
+ */
+using ResponseCallback = std::function<void(HttpResponse response, std::exception_ptr error)>;
+
+/**
+ * 流式响应体接收器
+ * 按到达顺序接收成功响应（2xx）的数据块，返回false中止传输
+ * 在执行请求的线程上调用，data仅在调用期间有效
+ */
+using BodySink = std::function<bool(const char* data, size_t size)>;
+
+/**
+ * 流式响应开始回调
+ * 成功响应（2xx）的首个数据块交给sink之前调用，可按状态码和响应头准备输出；抛出异常时中止传输
+ * 重试时每次尝试都可能调用
+ */
+using StreamStart = std::function<void(int statusCode, const ResponseHeaders& headers)>;
+
+struct TransportRequest;
+class LoadBalancer;
+
+namespace detail {
+struct Transfer;
+struct HeaderBlock;
+struct LogRecord;
+class RequestLogger;
+class Admission;
+
+/**
+ * 客户端配置快照
+ * 创建后不再修改；更新时整体替换，在途请求继续使用各自开始时的快照
+ */
+struct ClientState {
+    ClientConfig config;
+    std::shared_ptr<auth::AuthenticationProvider> authProvider;
+};
+}
+
 /**
  * HTTP客户端类
+ *
+ * 线程安全：同一实例可被多个线程（包括共享它的各个服务客户端）并发调用。
+ * 配置和认证提供者保存在不可变快照中，请求路径只做一次原子加载；
+ * updateConfig()、updateAuthProvider()及各setter复制当前快照、修改后原子替换，
+ * 不阻塞正在进行的请求。认证提供者自身的修改方法（如setToken）不与请求同步，
+ * 并发场景下应通过updateAuthProvider()替换提供者。
  */
 class HttpClient {
 private:
-    ClientConfig config;
-    std::shared_ptr<auth::AuthenticationProvider> authProvider;
+    // 当前配置快照，通过std::atomic_load/std::atomic_store访问
+    std::shared_ptr<const detail::ClientState> state;
+    
+    // 串行化快照更新
+    std::mutex updateMutex;
+    
+    // 进程级CURL运行时，所有HttpClient共享
+    std::shared_ptr<CurlRuntime> runtime;
+    
+    // 可复用的CURL句柄池，大小由config.connectionPoolSize决定
+    std::unique_ptr<ConnectionPool> connectionPool;
+    
+    // 客户端级重试预算，防止故障期间重试放大流量
+    std::shared_ptr<RetryBudget> retryBudget;
     
-    // 内部实现细节
-    void* curlHandle; // CURL句柄
+    // 客户端级对冲预算，限制对冲副本占请求量的比例
+    std::shared_ptr<RetryBudget> hedgeBudget;
+    
+    // 请求指标与观察者，异步回调持有共享所有权
+    std::shared_ptr<RequestMetrics> metrics;
+    
+    // 条件请求缓存，未设置时为空；通过std::atomic_load/std::atomic_store访问
+    std::shared_ptr<ConditionalCache> conditionalCache;
+
+    // 按端点组的熔断器与自适应并发限制，构造时按配置创建，未启用时为空
+    std::shared_ptr<CircuitBreakerRegistry> circuitBreakers;
+    std::shared_ptr<AdaptiveConcurrencyLimiter> concurrencyLimiter;
+
+    // 把连接分散到多个后端地址时使用的地址缓存，未启用时为空
+    std::shared_ptr<HostResolver> resolver;
+    
+    // 多端点负载均衡，构造时按config.endpoints创建，未配置时为空
+    std::shared_ptr<LoadBalancer> balancer;
+    
+    // 缓存的认证头部和默认头部，快照或认证信息变化时重建
+    mutable std::mutex headerMutex;
+    mutable std::shared_ptr<const detail::HeaderBlock> headerBlock;
+    
+    // 请求日志，首次启用日志时创建；通过std::atomic_load/std::atomic_store访问
+    std::shared_ptr<detail::RequestLogger> logger;
+    
+    /**
+     * 获取当前配置快照
+     */
+    std::shared_ptr<const detail::ClientState> snapshot() const {
+        return std::atomic_load(&state);
+    }
+    
+    /**
+     * 复制当前快照，修改后原子替换
+     */
+    void updateState(const std::function<void(detail::ClientState&)>& mutate);
+    
+    /**
+     * 获取与快照匹配的头部缓存（按需重建）
+     */
+    std::shared_ptr<const detail::HeaderBlock> getHeaderBlock(const std::shared_ptr<const detail::ClientState>& current) const;
+    
+    // 异步请求引擎，首次发起异步请求时创建
+    std::mutex engineMutex;
+    std::unique_ptr<AsyncEngine> asyncEngine;
+    
+    /**
+     * 获取异步引擎（按需创建）
+     */
+    AsyncEngine& getAsyncEngine();
+    
+    /**
+     * 根据当前配置计算异步引擎的连接限制
+     */
+    AsyncEngine::Limits engineLimits(const ClientConfig& config) const;
+    
+    /**
+     * 给定配置下是否使用HTTP/2
+     */
+    bool useHttp2(const ClientConfig& config) const;
+    
+    /**
+     * 按请求配置设置CURL句柄，同步和异步路径共用
+     */
+    void prepareTransfer(detail::Transfer& transfer, const HttpRequestConfig& requestConfig) const;
+    
+    /**
+     * 根据CURL结果构建响应对象
+     */
+    static HttpResponse finishTransfer(detail::Transfer& transfer, int curlCode);
+    
+    /**
+     * 采集传输统计信息并记录到指标
+     */
+    static void recordTransfer(RequestMetrics& metrics, detail::Transfer& transfer, int curlCode);
     
     /**
      * 初始化CURL
      */
-    void initializeCurl();
+    void initializeCurl(const ClientConfig& config);
     
     /**
      * 清理CURL
@@ -50,13 +200,10 @@ private:
     
     /**
      * 设置通用请求选项
+     * @param handle CURL句柄
+     * @param config 本次请求使用的配置快照
      */
-    void setCommonOptions();
-    
-    /**
-     * 构建完整URL
-     */
-    std::string buildUrl(const std::string& endpoint) const;
+    void setCommonOptions(void* handle, const ClientConfig& config) const;
     
     /**
      * 准备请求头部
@@ -65,23 +212,68 @@ private:
     
     /**
      * 执行HTTP请求的内部方法
+     * @param tried 本请求已使用过的端点（位掩码），选择端点时尽量避开，返回前加入本次使用的端点；未配置多端点时忽略
      */
-    HttpResponse executeRequest(const HttpRequestConfig& config);
+    HttpResponse executeRequest(const HttpRequestConfig& config,
+                                const BodySink* sink = nullptr,
+                                const StreamStart* onStart = nullptr,
+                                uint64_t* tried = nullptr);
     
     /**
-     * 处理重试逻辑
+     * 以对冲方式执行请求：delay内未完成时在另一连接上发出副本，先到的响应胜出，另一个被取消
+     * 两个副本都经异步引擎执行；先完成的副本失败时等待另一个
+     */
+    HttpResponse executeHedged(const HttpRequestConfig& config, std::chrono::microseconds delay, uint64_t* tried);
+    
+    /**
+     * 提交异步请求，admission为空时不经过熔断和并发限制
+     * ownedBody指向config.body时直接取走请求体，否则复制
+     */
+    void submitAsync(const HttpRequestConfig& config, ResponseCallback callback,
+                     std::shared_ptr<detail::Admission> admission, std::string* ownedBody = nullptr,
+                     uint64_t* tried = nullptr);
+    
+    /**
+     * 构建交给可替换传输层的请求
+     * retain为true时请求体保存在storage中（异步请求在调用返回后仍需要），否则直接引用config中的请求体；
+     * ownedBody指向config.body时直接取走；baseUrl为本次选择的端点
      */
-    HttpResponse executeWithRetry(const HttpRequestConfig& config);
+    TransportRequest transportRequest(const std::shared_ptr<const detail::ClientState>& current,
+                                      const HttpRequestConfig& config, std::string_view baseUrl,
+                                      std::string& storage, bool retain, std::string* ownedBody) const;
     
     /**
-     * 记录请求日志
+     * 经可替换传输层同步执行一次请求；成功响应的响应体整体交给sink
      */
-    void logRequest(const HttpRequestConfig& config) const;
+    HttpResponse executeTransport(const std::shared_ptr<const detail::ClientState>& current,
+                                  const HttpRequestConfig& config,
+                                  const BodySink* sink,
+                                  const StreamStart* onStart,
+                                  uint64_t* tried);
     
     /**
-     * 记录响应日志
+     * 经可替换传输层提交异步请求
      */
-    void logResponse(const HttpResponse& response) const;
+    void submitTransport(const std::shared_ptr<const detail::ClientState>& current,
+                         const HttpRequestConfig& config, ResponseCallback callback,
+                         std::shared_ptr<detail::Admission> admission, std::string* ownedBody,
+                         uint64_t* tried);
+    
+    /**
+     * 处理重试逻辑
+     */
+    HttpResponse executeWithRetry(const HttpRequestConfig& config,
+                                  const BodySink* sink = nullptr,
+                                  const StreamStart* onStart = nullptr);
+    
+    /**
+     * 开始一条请求日志；未启用日志或未被采样时返回空
+     * @param url 完整URL
+     * @param body 实际发送的请求体
+     */
+    std::unique_ptr<detail::LogRecord> beginLog(const std::shared_ptr<const detail::ClientState>& current,
+                                                const HttpRequestConfig& config,
+                                                std::string_view url, std::string_view body) const;
     
 public:
     /**
@@ -91,6 +283,16 @@ public:
      */
     HttpClient(const ClientConfig& config, std::shared_ptr<auth::AuthenticationProvider> authProvider);
     
+    /**
+     * 构造函数
+     * @param config 客户端配置
+     * @param authProvider 认证提供者
+     * @param runtime 共享CURL运行时（为空时使用进程级实例）
+     */
+    HttpClient(const ClientConfig& config,
+               std::shared_ptr<auth::AuthenticationProvider> authProvider,
+               std::shared_ptr<CurlRuntime> runtime);
+    
     /**
      * 析构函数
      */
@@ -115,6 +317,74 @@ public:
      */
     HttpResponse request(const HttpRequestConfig& config);
     
+    /**
+     * 执行HTTP请求，成功响应的响应体以流的方式交给sink
+     * 返回的HttpResponse不包含响应体；非2xx响应的响应体仍保存在body中
+     * sink收到数据后的失败不会重试
+     * @param config 请求配置
+     * @param sink 响应体接收器
+     * @return HTTP响应
+     */
+    HttpResponse request(const HttpRequestConfig& config, BodySink sink);
+    
+    /**
+     * 执行HTTP请求，成功响应的响应体以流的方式交给sink
+     * onStart在首个数据块之前收到状态码和响应头，例如区分206续传和200完整响应
+     * @param config 请求配置
+     * @param sink 响应体接收器
+     * @param onStart 流式响应开始回调
+     * @return HTTP响应
+     */
+    HttpResponse request(const HttpRequestConfig& config, BodySink sink, StreamStart onStart);
+    
+    /**
+     * 执行HTTP请求，成功响应的响应体直接写入输出流
+     * @param config 请求配置
+     * @param out 输出流，写入失败时中止传输
+     * @return HTTP响应
+     */
+    HttpResponse request(const HttpRequestConfig& config, std::ostream& out);
+    
+    /**
+     * 流式上传请求体
+     * 请求体由body.source按需拉取，不在内存中保留完整数据；长度未知时使用分块传输。
+     * 开启请求压缩时边读取边gzip压缩。来源只能读取一次，因此上传失败不会重试
+     * @param config 请求配置，方法必须为POST、PUT或PATCH，忽略data和body
+     * @param body 请求体
+     * @param onProgress 上传进度回调（可选）
+     * @return HTTP响应
+     */
+    HttpResponse upload(const HttpRequestConfig& config, UploadBody body, UploadProgress onProgress = {});
+    
+    /**
+     * 异步执行HTTP请求
+     * 请求由后台事件循环在curl_multi上执行，调用线程不阻塞
+     * @param config 请求配置
+     * @return 响应的future
+     */
+    std::future<HttpResponse> requestAsync(const HttpRequestConfig& config);
+    
+    /**
+     * 异步执行HTTP请求（回调形式）
+     * @param config 请求配置
+     * @param callback 完成回调
+     */
+    void requestAsync(const HttpRequestConfig& config, ResponseCallback callback);
+    
+    /**
+     * 异步执行HTTP请求，取得请求配置的所有权，请求体不再复制
+     * @param config 请求配置
+     * @return 响应的future
+     */
+    std::future<HttpResponse> requestAsync(HttpRequestConfig&& config);
+    
+    /**
+     * 异步执行HTTP请求（回调形式），取得请求配置的所有权
+     * @param config 请求配置
+     * @param callback 完成回调
+     */
+    void requestAsync(HttpRequestConfig&& config, ResponseCallback callback);
+    
     /**
      * 执行GET请求
      * @param endpoint API端点
@@ -126,6 +396,11 @@ public:
                     const Parameters& params = {},
                     const Headers& headers = {});
     
+    /**
+     * 执行GET请求，取得查询参数和头部的所有权
+     */
+    HttpResponse get(const std::string& endpoint, Parameters&& params, Headers headers = {});
+    
     /**
      * 执行POST请求
      * @param endpoint API端点
@@ -137,6 +412,16 @@ public:
                      const Json& data = {},
                      const Headers& headers = {});
     
+    /**
+     * 执行POST请求，取得请求体和头部的所有权，不复制Json
+     */
+    HttpResponse post(const std::string& endpoint, Json&& data, Headers headers = {});
+    
+    /**
+     * 执行POST请求，请求体为Json或已序列化的字节（RequestBody::raw）
+     */
+    HttpResponse post(const std::string& endpoint, RequestBody body, Headers headers = {});
+    
     /**
      * 执行PUT请求
      * @param endpoint API端点
@@ -148,6 +433,16 @@ public:
                     const Json& data = {},
                     const Headers& headers = {});
     
+    /**
+     * 执行PUT请求，取得请求体和头部的所有权，不复制Json
+     */
+    HttpResponse put(const std::string& endpoint, Json&& data, Headers headers = {});
+    
+    /**
+     * 执行PUT请求，请求体为Json或已序列化的字节（RequestBody::raw）
+     */
+    HttpResponse put(const std::string& endpoint, RequestBody body, Headers headers = {});
+    
     /**
      * 执行DELETE请求
      * @param endpoint API端点
@@ -177,6 +472,16 @@ public:
                       const Json& data = {},
                       const Headers& headers = {});
     
+    /**
+     * 执行PATCH请求，取得请求体和头部的所有权，不复制Json
+     */
+    HttpResponse patch(const std::string& endpoint, Json&& data, Headers headers = {});
+    
+    /**
+     * 执行PATCH请求，请求体为Json或已序列化的字节（RequestBody::raw）
+     */
+    HttpResponse patch(const std::string& endpoint, RequestBody body, Headers headers = {});
+    
     /**
      * 测试连接
      * @return 是否连接成功
@@ -184,17 +489,32 @@ public:
     bool testConnection();
     
     /**
-     * 获取配置
+     * 预热连接：解析服务域名并在连接池中预先建立连接，降低冷启动后首批请求的延迟
+     * 每个连接发送一次HEAD /health，失败的连接被忽略
+     * @param connections 预热的连接数，不超过连接池大小
+     * @return 成功建立的连接数
+     */
+    size_t warmUp(size_t connections);
+    
+    /**
+     * 获取配置（当前快照的副本）
      */
-    const ClientConfig& getConfig() const {
-        return config;
+    ClientConfig getConfig() const {
+        return snapshot()->config;
     }
     
     /**
      * 获取认证提供者
      */
     std::shared_ptr<auth::AuthenticationProvider> getAuthProvider() const {
-        return authProvider;
+        return snapshot()->authProvider;
+    }
+    
+    /**
+     * 获取共享CURL运行时
+     */
+    std::shared_ptr<CurlRuntime> getRuntime() const {
+        return runtime;
     }
     
     /**
@@ -225,15 +545,74 @@ public:
     /**
      * 获取最后一次请求的统计信息
      */
-    struct RequestStats {
-        double totalTime;
-        double connectTime;
-        double downloadTime;
-        long downloadSize;
-        long uploadSize;
-    };
+    using RequestStats = http::RequestStats;
     
     RequestStats getLastRequestStats() const;
+    
+    /**
+     * 获取请求指标（各阶段延迟直方图）
+     */
+    const RequestMetrics& getMetrics() const {
+        return *metrics;
+    }
+    
+    /**
+     * 等待已提交的请求日志全部写出，未启用日志时立即返回
+     */
+    void flushLogs() const;
+    
+    /**
+     * 因日志缓冲区已满被丢弃的日志条数
+     */
+    uint64_t getDroppedLogCount() const;
+    
+    /**
+     * 添加请求观察者
+     * @param observer 观察者，每次传输结束后收到RequestEvent
+     */
+    void addObserver(std::shared_ptr<RequestObserver> observer);
+    
+    /**
+     * 移除请求观察者
+     */
+    void removeObserver(const std::shared_ptr<RequestObserver>& observer);
+    
+    /**
+     * 设置条件请求缓存，传入nullptr关闭
+     * 缓存以相对URL为键，不应在指向不同服务或使用不同身份的客户端之间共享
+     */
+    void setConditionalCache(std::shared_ptr<ConditionalCache> cache) {
+        std::atomic_store(&conditionalCache, std::move(cache));
+    }
+    
+    /**
+     * 获取条件请求缓存，未设置时为nullptr
+     */
+    std::shared_ptr<ConditionalCache> getConditionalCache() const {
+        return std::atomic_load(&conditionalCache);
+    }
+
+    /**
+     * 获取端点组的熔断器，未启用config.enableCircuitBreaker时为nullptr
+     * @param group 端点组，如"/workflows"，见CircuitBreakerRegistry::groupOf
+     */
+    std::shared_ptr<CircuitBreaker> getCircuitBreaker(const std::string& group) const {
+        return circuitBreakers ? circuitBreakers->get(group) : nullptr;
+    }
+
+    /**
+     * 获取自适应并发限制器，未启用config.enableAdaptiveConcurrency时为nullptr
+     */
+    std::shared_ptr<AdaptiveConcurrencyLimiter> getConcurrencyLimiter() const {
+        return concurrencyLimiter;
+    }
+
+    /**
+     * 获取多端点负载均衡器（可查看各端点状态），未配置config.endpoints时为nullptr
+     */
+    std::shared_ptr<LoadBalancer> getLoadBalancer() const {
+        return balancer;
+    }
 };
 
 /**
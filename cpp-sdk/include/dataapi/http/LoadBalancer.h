@@ -0,0 +1,175 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../ClientConfig.h"
+
+namespace dataapi {
+namespace http {
+
+/**
+ * 负载均衡参数
+ */
+struct LoadBalancerOptions {
+    LoadBalancingPolicy policy = LoadBalancingPolicy::PowerOfTwoChoices;
+    size_t failureThreshold = 3;                        // 连续失败达到该次数后摘除端点，0表示不按请求结果摘除
+    std::chrono::milliseconds ejectionTime{30000};      // 按请求结果摘除的时长，健康探测成功时提前恢复
+    std::chrono::milliseconds healthCheckInterval{0};   // 健康探测间隔，0表示不探测
+    double ewmaWeight = 0.3;                            // 延迟EWMA中新样本的权重
+};
+
+/**
+ * 端点状态快照
+ */
+struct EndpointStats {
+    std::string baseUrl;
+    double weight = 1.0;
+    bool available = true;    // 当前是否参与选择
+    int64_t outstanding = 0;  // 在途请求数
+    double latencyEwma = 0.0; // 延迟EWMA（毫秒），尚无样本时为0
+    uint64_t requests = 0;    // 已完成的请求数
+    uint64_t failures = 0;    // 其中失败的请求数
+};
+
+/**
+ * 多端点负载均衡
+ *
+ * 每次尝试按策略选择一个可用端点，返回的租约在传输结束时上报延迟和结果：
+ * - LeastOutstanding：在途请求数/权重最小的端点
+ * - PowerOfTwoChoices：按权重随机取两个端点，选在途请求数/权重较小者
+ * - LatencyEwma：同样随机取两个，比较 延迟EWMA × (在途请求数 + 1) / 权重；EWMA对变慢立即跟随（peak EWMA），
+ *   变快时按ewmaWeight平滑，没有样本的端点优先被选中以获得样本
+ * 连续失败（连接错误、超时、502/503/504）达到阈值的端点被摘除ejectionTime；设置健康探测后，
+ * 后台线程定期探测各端点，探测失败的端点被摘除直到探测恢复。所有端点都不可用时仍在全部端点中选择。
+ * 线程安全。
+ */
+class LoadBalancer : public std::enable_shared_from_this<LoadBalancer> {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * 健康探测函数，返回端点是否健康；在后台线程上调用
+     */
+    using Probe = std::function<bool(const std::string& baseUrl)>;
+
+    /**
+     * 一次尝试占用的端点
+     * 在途期间计入端点的在途请求数；complete()上报结果，未上报即析构时只归还在途计数
+     */
+    class Lease {
+    public:
+        Lease() = default;
+        ~Lease();
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        explicit operator bool() const {
+            return balancer != nullptr;
+        }
+
+        size_t getIndex() const {
+            return index;
+        }
+
+        const std::string& getBaseUrl() const;
+
+        /**
+         * 上报结果并归还
+         * @param latencyMs 本次尝试的耗时
+         * @param failure 是否为端点故障（连接错误、超时、502/503/504）
+         */
+        void complete(double latencyMs, bool failure);
+
+        /**
+         * 不上报结果直接归还（例如被取消的对冲副本）
+         */
+        void release();
+
+    private:
+        friend class LoadBalancer;
+        Lease(std::shared_ptr<LoadBalancer> balancer, size_t index)
+            : balancer(std::move(balancer)), index(index) {}
+
+        std::shared_ptr<LoadBalancer> balancer;
+        size_t index = 0;
+    };
+
+    /**
+     * @param endpoints 端点列表，不能为空；权重不大于0的端点按1处理
+     */
+    LoadBalancer(std::vector<ServiceEndpoint> endpoints, const LoadBalancerOptions& options = {});
+
+    /**
+     * 停止健康探测线程
+     */
+    ~LoadBalancer();
+
+    LoadBalancer(const LoadBalancer&) = delete;
+    LoadBalancer& operator=(const LoadBalancer&) = delete;
+
+    /**
+     * 选择端点
+     * @param avoid 尽量避开的端点（按下标的位掩码，例如本请求已失败过的端点）；没有其他可用端点时忽略
+     */
+    Lease acquire(uint64_t avoid = 0);
+
+    /**
+     * 启动后台健康探测，options.healthCheckInterval为0时不启动；只能调用一次
+     */
+    void startHealthChecks(Probe probe);
+
+    /**
+     * 立即探测所有端点一次（在调用线程上执行）
+     */
+    void checkHealth();
+
+    size_t size() const {
+        return endpoints.size();
+    }
+
+    /**
+     * 各端点的状态
+     */
+    std::vector<EndpointStats> getStats() const;
+
+private:
+    struct Endpoint {
+        ServiceEndpoint config;
+        std::atomic<int64_t> outstanding{0};
+        std::atomic<uint64_t> ewmaMicros{0};
+        std::atomic<uint32_t> consecutiveFailures{0};
+        std::atomic<int64_t> ejectedUntil{0}; // Clock纳秒，按请求结果摘除
+        std::atomic<bool> probeHealthy{true};
+        std::atomic<uint64_t> requests{0};
+        std::atomic<uint64_t> failures{0};
+    };
+
+    bool isAvailable(const Endpoint& endpoint, int64_t now) const;
+    size_t pickWeighted(const std::vector<size_t>& candidates);
+    double cost(const Endpoint& endpoint) const;
+    void record(size_t index, double latencyMs, bool failure);
+    void runHealthChecks();
+
+    std::vector<Endpoint> endpoints;
+    LoadBalancerOptions options;
+    std::atomic<uint64_t> cursor{0};
+
+    Probe probe;
+    std::mutex mutex;
+    std::condition_variable stopped;
+    bool stopping = false;
+    std::thread checker;
+};
+
+} // namespace http
+} // namespace dataapi
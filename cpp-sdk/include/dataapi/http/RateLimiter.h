@@ -0,0 +1,71 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+
+namespace dataapi {
+namespace http {
+
+/**
+ * 令牌桶限流器
+ *
+ * 令牌以rate每秒的速度补充，桶容量为burst。acquire()在令牌不足时预支令牌并睡眠到
+ * 预支的令牌补足为止，多个线程并发调用时按调用顺序排队，总体速率不超过rate。
+ * 线程安全，可在多个批量调用之间共享同一个实例以共同遵守配额。
+ */
+class RateLimiter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * 构造函数，桶初始为满
+     * @param ratePerSecond 每秒补充的令牌数，小于等于0表示不限流
+     * @param burst 桶容量（允许的突发请求数），至少为1
+     */
+    RateLimiter(double ratePerSecond, double burst);
+
+    /**
+     * 获取令牌，必要时阻塞等待
+     * @param count 令牌数
+     */
+    void acquire(double count = 1.0);
+
+    /**
+     * 尝试获取令牌，不阻塞
+     * @return 令牌充足时返回true
+     */
+    bool tryAcquire(double count = 1.0);
+
+    /**
+     * 预支令牌
+     * @return 调用方需要等待的时长，令牌充足时为0
+     */
+    Clock::duration reserve(double count = 1.0);
+
+    /**
+     * 调整速率和桶容量，已有令牌不超过新的容量
+     */
+    void setRate(double ratePerSecond, double burst);
+
+    /**
+     * 获取当前令牌数，预支后可能为负
+     */
+    double getTokens() const;
+
+    /**
+     * 获取每秒补充的令牌数
+     */
+    double getRate() const;
+
+private:
+    void refill(Clock::time_point now);
+
+    mutable std::mutex mutex;
+    double rate;
+    double capacity;
+    double tokens;
+    Clock::time_point last;
+};
+
+} // namespace http
+} // namespace dataapi
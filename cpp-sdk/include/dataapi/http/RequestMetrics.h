@@ -0,0 +1,172 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../Types.h"
+
+namespace dataapi {
+namespace http {
+
+/**
+ * 单次请求的统计信息
+ * 各时间为自请求开始起的累计时间（毫秒），与CURLINFO_*_TIME语义一致
+ */
+struct RequestStats {
+    double nameLookupTime = 0.0;    // DNS解析完成
+    double connectTime = 0.0;       // TCP连接建立
+    double appConnectTime = 0.0;    // TLS握手完成（明文连接或连接复用时为0）
+    double startTransferTime = 0.0; // 收到首字节
+    double downloadTime = 0.0;      // 首字节到传输结束
+    double totalTime = 0.0;         // 总耗时
+    long downloadSize = 0;          // 下载字节数
+    long uploadSize = 0;            // 上传字节数
+};
+
+/**
+ * 请求完成事件
+ */
+struct RequestEvent {
+    HttpMethod method;
+    std::string endpoint;      // 端点模板，例如"/api/workflows/{id}"
+    int statusCode = 0;        // 传输失败时为0
+    bool transportError = false;
+    RequestStats stats;
+};
+
+/**
+ * 请求观察者接口
+ * 每次传输（包括每次重试）结束后调用，在执行请求的线程或异步引擎线程上执行，不应阻塞
+ */
+class RequestObserver {
+public:
+    virtual ~RequestObserver() = default;
+
+    /**
+     * 请求完成
+     * @param event 请求事件
+     */
+    virtual void onRequestComplete(const RequestEvent& event) = 0;
+};
+
+/**
+ * 无锁延迟直方图
+ *
+ * 以微秒为单位记录，小于16微秒的值精确计数，其余按2的幂分段、每段8个子桶，
+ * 相对误差不超过12.5%。记录只做原子加法，可在任意线程并发调用。
+ */
+class LatencyHistogram {
+public:
+    static constexpr size_t kLinearBuckets = 16;
+    static constexpr size_t kSubBuckets = 8;
+    static constexpr size_t kBucketCount = kLinearBuckets + (64 - 4) * kSubBuckets;
+
+    LatencyHistogram();
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * 记录一个样本
+     * @param micros 延迟（微秒）
+     */
+    void record(uint64_t micros);
+
+    /**
+     * 样本数量
+     */
+    uint64_t getCount() const;
+
+    /**
+     * 平均值（毫秒）
+     */
+    double getMean() const;
+
+    /**
+     * 最大值（毫秒）
+     */
+    double getMax() const;
+
+    /**
+     * 分位数（毫秒），返回所在桶的上界
+     * @param quantile 分位点，范围[0, 1]
+     */
+    double getPercentile(double quantile) const;
+
+    /**
+     * 清空所有样本
+     */
+    void reset();
+
+private:
+    static size_t bucketIndex(uint64_t micros);
+    static uint64_t bucketUpperBound(size_t index);
+
+    std::array<std::atomic<uint64_t>, kBucketCount> buckets;
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> sum;
+    std::atomic<uint64_t> max;
+};
+
+/**
+ * 客户端级请求指标
+ * 维护各阶段延迟直方图、最近一次请求统计和观察者列表
+ */
+class RequestMetrics {
+public:
+    LatencyHistogram nameLookup;
+    LatencyHistogram connect;
+    LatencyHistogram appConnect;
+    LatencyHistogram startTransfer;
+    LatencyHistogram total;
+
+    RequestMetrics();
+
+    /**
+     * 记录请求事件，更新直方图并通知观察者
+     */
+    void record(const RequestEvent& event);
+
+    /**
+     * 添加观察者
+     */
+    void addObserver(std::shared_ptr<RequestObserver> observer);
+
+    /**
+     * 移除观察者
+     */
+    void removeObserver(const std::shared_ptr<RequestObserver>& observer);
+
+    /**
+     * 获取最近一次请求的统计信息
+     */
+    RequestStats getLastStats() const;
+
+    /**
+     * 清空直方图
+     */
+    void reset();
+
+    /**
+     * 将URL归一化为端点模板
+     * 去掉查询串，并将数字或UUID/十六进制形式的路径段替换为"{id}"
+     */
+    static std::string normalizeEndpoint(const std::string& url);
+
+private:
+    using ObserverList = std::vector<std::shared_ptr<RequestObserver>>;
+
+    // 写时复制，记录路径只做一次原子加载
+    std::shared_ptr<const ObserverList> observers;
+    std::mutex observerMutex;
+
+    mutable std::mutex statsMutex;
+    RequestStats lastStats;
+};
+
+} // namespace http
+} // namespace dataapi
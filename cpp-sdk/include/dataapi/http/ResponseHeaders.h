@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../Types.h"
+
+namespace dataapi {
+namespace http {
+
+/**
+ * HTTP响应头集合
+ *
+ * 所有头部名称和值连续存放在一个缓冲区中，只记录各字段的偏移和长度，
+ * 解析时不为单个头部分配内存。查找不区分大小写，按需线性扫描；
+ * 需要std::map形式时调用toMap()。
+ */
+class ResponseHeaders {
+public:
+    ResponseHeaders() = default;
+
+    /**
+     * 追加一行原始头部（可包含结尾的CRLF）
+     * 状态行会清空之前的头部，使重定向或100-continue后只保留最终响应的头部
+     * @return 是否解析出一个头部字段
+     */
+    bool append(const char* line, size_t length);
+
+    /**
+     * 获取头部值（不区分大小写），同名头部返回最后一个
+     * @param name 头部名称
+     * @return 头部值，不存在时为空；视图在本对象修改或销毁前有效
+     */
+    std::optional<std::string_view> get(std::string_view name) const;
+
+    /**
+     * 是否包含头部（不区分大小写）
+     */
+    bool contains(std::string_view name) const {
+        return get(name).has_value();
+    }
+
+    /**
+     * 头部字段数量
+     */
+    size_t size() const {
+        return fields.size();
+    }
+
+    bool empty() const {
+        return fields.empty();
+    }
+
+    /**
+     * 按位置获取头部名称
+     */
+    std::string_view nameAt(size_t index) const {
+        const Field& field = fields[index];
+        return std::string_view(buffer.data() + field.nameOffset, field.nameLength);
+    }
+
+    /**
+     * 按位置获取头部值
+     */
+    std::string_view valueAt(size_t index) const {
+        const Field& field = fields[index];
+        return std::string_view(buffer.data() + field.valueOffset, field.valueLength);
+    }
+
+    /**
+     * 转换为Headers映射
+     */
+    Headers toMap() const;
+
+    /**
+     * 清空所有头部
+     */
+    void clear();
+
+private:
+    struct Field {
+        uint32_t nameOffset;
+        uint32_t nameLength;
+        uint32_t valueOffset;
+        uint32_t valueLength;
+    };
+
+    std::string buffer;
+    std::vector<Field> fields;
+};
+
+} // namespace http
+} // namespace dataapi
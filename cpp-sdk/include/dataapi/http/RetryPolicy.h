@@ -0,0 +1,130 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <string>
+#include "../Types.h"
+#include "../ClientConfig.h"
+#include "../error/DataApiError.h"
+
+namespace dataapi {
+namespace http {
+
+/**
+ * 重试预算（令牌桶）
+ *
+ * 每个请求向桶中存入ratio个令牌，每次重试消耗一个令牌，桶容量为capacity。
+ * 正常情况下桶保持满额；后端整体故障时重试量被限制在请求量的ratio比例以内，
+ * 避免重试放大故障流量。
+ */
+class RetryBudget {
+private:
+    mutable std::mutex mutex;
+    double ratio;
+    double capacity;
+    double tokens;
+
+public:
+    /**
+     * 构造函数
+     * @param ratio 每个请求存入的令牌数（允许的重试比例）
+     * @param capacity 桶容量（允许的突发重试次数）
+     */
+    RetryBudget(double ratio, double capacity);
+
+    /**
+     * 记录一次请求（首次尝试），存入ratio个令牌
+     */
+    void recordRequest();
+
+    /**
+     * 尝试为一次重试消耗令牌
+     * @return 预算充足时返回true
+     */
+    bool tryAcquire();
+
+    /**
+     * 获取当前令牌数
+     */
+    double getTokens() const;
+};
+
+/**
+ * 重试策略
+ *
+ * 使用decorrelated jitter退避：delay = min(maxDelay, random(baseDelay, previous * 3))，
+ * 并遵循服务端返回的Retry-After。只有幂等请求会因响应状态码或传输错误重试；
+ * 非幂等请求仅在请求未发出（连接失败）或服务端明确拒绝处理（429/503）时重试。
+ */
+class RetryPolicy {
+public:
+    /**
+     * 重试参数
+     */
+    struct Settings {
+        int maxRetries = 3;      // 最大重试次数
+        int baseDelayMs = 1000;  // 基础退避时间（毫秒）
+        int maxDelayMs = 30000;  // 最大退避时间（毫秒）
+    };
+
+    /**
+     * 构造函数
+     * @param settings 重试参数
+     */
+    explicit RetryPolicy(const Settings& settings);
+
+    /**
+     * 根据客户端配置创建重试策略
+     */
+    static RetryPolicy fromConfig(const ClientConfig& config);
+
+    /**
+     * 获取最大重试次数
+     */
+    int getMaxRetries() const {
+        return settings.maxRetries;
+    }
+
+    /**
+     * 获取参数
+     */
+    const Settings& getSettings() const {
+        return settings;
+    }
+
+    /**
+     * 请求是否幂等（显式设置优先，否则按HTTP方法判断）
+     */
+    static bool isIdempotent(const HttpRequestConfig& request);
+
+    /**
+     * 根据响应状态码判断是否重试
+     */
+    bool shouldRetryStatus(const HttpRequestConfig& request, int statusCode) const;
+
+    /**
+     * 根据传输错误判断是否重试
+     */
+    bool shouldRetryError(const HttpRequestConfig& request, const error::DataApiError& error) const;
+
+    /**
+     * 计算下一次退避时间
+     * @param previous 上一次退避时间（首次重试传0）
+     * @return 退避时间
+     */
+    std::chrono::milliseconds nextDelay(std::chrono::milliseconds previous) const;
+
+    /**
+     * 解析Retry-After头部（秒数或HTTP日期）
+     * @param value 头部值
+     * @return 等待时间，无法解析时为空
+     */
+    static std::optional<std::chrono::milliseconds> parseRetryAfter(const std::string& value);
+
+private:
+    Settings settings;
+};
+
+} // namespace http
+} // namespace dataapi
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../Types.h"
+#include "RequestMetrics.h"
+
+namespace dataapi {
+namespace http {
+
+/**
+ * W3C Trace Context（traceparent/tracestate）
+ */
+struct TraceContext {
+    std::string traceId;    // 32位小写十六进制
+    std::string spanId;     // 16位小写十六进制
+    bool sampled = false;
+    std::string traceState; // tracestate头部的原值，原样向下游传递
+
+    /**
+     * 解析traceparent和tracestate头部，格式无效时返回空
+     */
+    static std::optional<TraceContext> parse(std::string_view traceparent, std::string_view tracestate = {});
+
+    /**
+     * 新建一条trace
+     * 按trace id的低位判断是否采样（与OpenTelemetry的TraceIdRatioBased一致），同一trace在各服务上的判断相同
+     * @param sampleRate 采样比例（0~1）
+     */
+    static TraceContext root(double sampleRate);
+
+    /**
+     * 同一trace下的子上下文：新的span id，继承采样标志和tracestate
+     */
+    TraceContext child() const;
+
+    /**
+     * 格式化为traceparent头部的值，例如00-<trace id>-<span id>-01
+     */
+    std::string traceparent() const;
+
+    /**
+     * 当前线程的上下文（由TraceScope设置），没有时为nullptr
+     */
+    static const TraceContext* current();
+};
+
+/**
+ * 在作用域内把上下文设为当前线程的上游上下文
+ * 作用域内发出的请求（包括异步请求的提交）作为其子span，并向服务端传递traceparent。可以嵌套
+ *
+ *   auto parent = http::TraceContext::parse(incoming.header("traceparent"), incoming.header("tracestate"));
+ *   http::TraceScope scope(*parent);
+ *   client.getWorkflowClient().getById(id);
+ */
+class TraceScope {
+public:
+    explicit TraceScope(TraceContext context);
+    ~TraceScope();
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    TraceContext context;
+    const TraceContext* previous;
+};
+
+/**
+ * 一次HTTP传输的客户端span（每次重试和对冲副本各一个）
+ */
+struct TraceSpan {
+    std::string name;          // 方法和端点模板，例如"GET /workflows/{id}"
+    TraceContext context;      // 本span的上下文，即发给服务端的traceparent
+    std::string parentSpanId;  // 上游span，新建trace时为空
+    std::chrono::system_clock::time_point startTime;
+    std::chrono::system_clock::time_point endTime;
+    HttpMethod method = HttpMethod::GET;
+    std::string url;
+    std::string endpoint;
+    int statusCode = 0;        // 传输失败时为0
+    std::string error;         // 传输失败的原因
+    RequestStats stats;        // DNS、连接、TLS、首字节等阶段的累计耗时
+};
+
+/**
+ * span导出接口
+ * 只导出采样的span。在完成传输的线程（请求线程或异步引擎线程）上调用，不应阻塞，
+ * 需要经网络发送时应在内部缓冲、由后台线程批量发送；抛出的异常被忽略。实现必须线程安全
+ */
+class SpanExporter {
+public:
+    virtual ~SpanExporter() = default;
+
+    virtual void exportSpan(const TraceSpan& span) = 0;
+};
+
+/**
+ * 把span转换为OTLP/HTTP JSON格式的ExportTraceServiceRequest，可直接发往OpenTelemetry Collector的/v1/traces
+ * 各阶段耗时作为span事件（dns、connect、tls、first_byte），状态码和URL使用HTTP语义约定的属性名
+ * @param spans 待导出的span
+ * @param serviceName resource的service.name
+ */
+Json toOtlpJson(const std::vector<TraceSpan>& spans, const std::string& serviceName);
+
+} // namespace http
+} // namespace dataapi
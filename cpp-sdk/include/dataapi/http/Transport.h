@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "HttpClient.h"
+
+namespace dataapi {
+namespace http {
+
+/**
+ * 交给传输层的请求
+ * url已包含基础URL和编码后的查询串；headers已合并认证头部、默认头部和请求级头部（后者优先），
+ * 有请求体且未指定Content-Type时附加application/json。
+ * body指向HttpClient持有的缓冲区，在send()返回或sendAsync()的回调执行之前有效，不复制。
+ */
+struct TransportRequest {
+    HttpMethod method = HttpMethod::GET;
+    std::string url;
+    std::vector<std::pair<std::string, std::string>> headers;
+    std::string_view body;
+    int timeoutMs = 0; // 本次尝试的超时（毫秒），已按截止时间收紧
+
+    /**
+     * url中的路径和查询串部分（去掉scheme和authority），例如/api/workflows?page=0
+     */
+    std::string_view target() const;
+
+    /**
+     * 获取头部值（不区分大小写），不存在时为空
+     */
+    std::string_view header(std::string_view name) const;
+};
+
+/**
+ * 可替换的传输层
+ *
+ * 设置ClientConfig::transport后，HttpClient的请求经由它发送；重试、熔断、并发限制、认证、
+ * 对冲和指标照常生效，请求体压缩、取消标志和上传进度只在内置传输中生效。
+ * 未设置时使用内置的libcurl传输（TCP/TLS，或ClientConfig::unixSocketPath指定的Unix域套接字），
+ * 流式响应、连接池和HTTP/2多路复用都依赖libcurl句柄，因此不通过本接口暴露。
+ *
+ * 传输失败时应抛出error::ConnectionError、error::TimeoutError或error::NetworkError，
+ * 重试策略据此判断是否重试；返回的任何状态码都视为一次完成的请求。实现必须线程安全。
+ */
+class Transport {
+public:
+    virtual ~Transport() = default;
+
+    /**
+     * 发送请求并等待响应
+     */
+    virtual HttpResponse send(const TransportRequest& request) = 0;
+
+    /**
+     * 异步发送，完成时调用callback（成功时error为空）
+     * request在callback执行之前保持有效。默认实现在调用线程上执行send()
+     */
+    virtual void sendAsync(const TransportRequest& request, ResponseCallback callback);
+};
+
+/**
+ * 进程内传输
+ *
+ * 把请求直接交给处理函数，不经过套接字、HTTP报文的格式化和解析：请求体以视图传入，
+ * 响应体移回调用方。用于测试、基准测试以及与服务端同进程部署的场景。
+ * 处理函数在发起请求的线程上执行（异步请求同样如此），可被多个线程并发调用。
+ */
+class InMemoryTransport : public Transport {
+public:
+    using Handler = std::function<HttpResponse(const TransportRequest& request)>;
+
+    explicit InMemoryTransport(Handler handler);
+
+    HttpResponse send(const TransportRequest& request) override;
+
+    /**
+     * 已处理的请求数
+     */
+    uint64_t getRequestCount() const {
+        return requestCount.load(std::memory_order_relaxed);
+    }
+
+private:
+    Handler handler;
+    std::atomic<uint64_t> requestCount{0};
+};
+
+} // namespace http
+} // namespace dataapi
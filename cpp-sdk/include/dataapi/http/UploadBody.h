@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace dataapi {
+namespace http {
+
+/**
+ * 流式请求体来源
+ * 向buffer写入最多size字节并返回写入的字节数，返回0表示数据结束；抛出异常时中止传输
+ * 在执行请求的线程上调用
+ */
+using BodySource = std::function<size_t(char* buffer, size_t size)>;
+
+/**
+ * 上传进度回调
+ * sent为已从来源读取的字节数，total为请求体长度（未知时为0）；返回false中止传输
+ */
+using UploadProgress = std::function<bool(uint64_t sent, uint64_t total)>;
+
+/**
+ * 流式上传的请求体
+ * 来源按需拉取，只能读取一次；长度未知时HTTP/1.1下使用分块传输编码
+ */
+struct UploadBody {
+    BodySource source;
+    int64_t length = -1; // 字节数，-1表示未知
+};
+
+/**
+ * 引用内存中的数据，不复制
+ * data在上传完成前必须保持有效
+ */
+UploadBody memoryBody(std::string_view data);
+
+/**
+ * 以固定大小的块顺序读取文件，内存占用与文件大小无关
+ * @throws std::runtime_error 文件无法打开
+ */
+UploadBody fileBody(const std::string& path);
+
+/**
+ * 以只读方式内存映射文件，读取时直接从映射区域复制到传输缓冲区
+ * 映射在请求体（及其副本）销毁时解除
+ * @throws std::runtime_error 文件无法打开或映射
+ */
+UploadBody mappedFileBody(const std::string& path);
+
+} // namespace http
+} // namespace dataapi
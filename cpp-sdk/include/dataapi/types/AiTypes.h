@@ -1,6 +1,8 @@
 #pragma once
 
+#include <exception>
 #include "CommonTypes.h"
+#include "EmbeddingMatrix.h"
 
 namespace dataapi {
 
@@ -118,6 +120,17 @@ struct AiQuotaSettings {
     Json restrictions;
 };
 
+// AI Batch Item
+struct AiBatchItem {
+    std::optional<AiServiceResponse> response; // 成功时的响应
+    std::exception_ptr error;                  // 失败时的异常，可重新抛出
+    std::string errorMessage;
+    
+    bool ok() const {
+        return response.has_value();
+    }
+};
+
 // Text Generation Options
 struct TextGenerationOptions {
     double temperature = 0.7;
@@ -171,12 +184,13 @@ struct TextToSpeechOptions {
 struct EmbeddingOptions {
     std::string model;
     int dimensions = 0;
+    EmbeddingPrecision precision = EmbeddingPrecision::Float32; // 客户端存储精度，不发送给服务端
     Json additionalParams;
 };
 
 // Embedding Result
 struct EmbeddingResult {
-    std::vector<std::vector<double>> embeddings;
+    EmbeddingMatrix embeddings; // 每个输入文本一行
     std::string model;
     Json usage;
     Json metadata;
@@ -227,6 +241,15 @@ struct TextToSpeechResult {
     Json metadata;
 };
 
+// Binary Media Result
+// 图像、音频以原始二进制写入MediaOutput时的结果，媒体内容本身不在结果中
+struct MediaResult {
+    std::string contentType; // 响应的Content-Type，例如image/png、audio/mpeg
+    uint64_t size = 0;       // 写入目标的字节数
+    Span<char> bytes;        // 目标为调用方缓冲区时指向其中已写入的部分，否则为空
+    std::string model;       // X-Model响应头，服务端未提供时为空
+};
+
 // Sentiment Analysis Options
 struct SentimentAnalysisOptions {
     std::string language;
@@ -341,10 +364,26 @@ void from_json(const Json& j, AiInvokeResponse& a);
 void to_json(Json& j, const AiProviderConfig& a);
 void from_json(const Json& j, AiProviderConfig& a);
 
+void to_json(Json& j, const AiProviderUpdateRequest& a);
+
+void from_json(const Json& j, AiModel& a);
+
 void to_json(Json& j, const AiServiceRequest& a);
 void from_json(const Json& j, AiServiceRequest& a);
 
 void to_json(Json& j, const AiServiceResponse& a);
 void from_json(const Json& j, AiServiceResponse& a);
 
+void from_json(const Json& j, AiQuotaInfo& a);
+void from_json(const Json& j, AiUsageStatistics& a);
+
+void to_json(Json& j, const AiQuotaSettings& a);
+
+void from_json(const Json& j, EmbeddingResult& a);
+
+void from_json(const Json& j, ImageGenerationResult& a);
+void from_json(const Json& j, ImageAnalysisResult& a);
+void from_json(const Json& j, SpeechToTextResult& a);
+void from_json(const Json& j, TextToSpeechResult& a);
+
 } // namespace dataapi
\ No newline at end of file
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "DatabaseTypes.h"
+
+#ifdef DATAAPI_WITH_ARROW
+namespace arrow {
+class RecordBatch;
+}
+#endif
+
+namespace dataapi {
+
+/**
+ * 列数据类型
+ */
+enum class ColumnType {
+    Null,     // 目前只有空值
+    Boolean,
+    Int64,
+    Double,
+    String,
+    Json      // 类型不一致或嵌套值，按行保存Json
+};
+
+/**
+ * 类型化的列
+ *
+ * 值连续存放在对应类型的缓冲区中，布局与Apache Arrow一致：空值在值缓冲区中占位，
+ * 有效性位图按LSB顺序每行一位（1表示非空）；字符串存放在一个字符区中，
+ * 第i行为chars[offsets[i], offsets[i + 1])。
+ * 类型由首个非空值推断；整数列遇到浮点数时提升为Double，其他不一致时退化为Json。
+ */
+class Column {
+public:
+    /**
+     * 追加一个值
+     */
+    void append(const Json& value);
+
+    /**
+     * 追加空值
+     */
+    void appendNull();
+
+    ColumnType getType() const {
+        return type;
+    }
+
+    size_t size() const {
+        return length;
+    }
+
+    size_t getNullCount() const {
+        return nullCount;
+    }
+
+    bool isNull(size_t row) const {
+        return (validity[row / 8] & (1u << (row % 8))) == 0;
+    }
+
+    /**
+     * 有效性位图
+     */
+    const std::vector<uint8_t>& getValidity() const {
+        return validity;
+    }
+
+    /**
+     * 类型化访问，类型不匹配时抛出std::logic_error
+     */
+    const std::vector<int64_t>& int64Values() const;
+    const std::vector<double>& doubleValues() const;
+    const std::vector<uint8_t>& boolValues() const;
+    const std::vector<Json>& jsonValues() const;
+
+    /**
+     * 字符串列的字符区和偏移
+     */
+    const std::string& stringData() const;
+    const std::vector<int32_t>& stringOffsets() const;
+
+    /**
+     * 获取字符串值（视图在列修改前有效）
+     */
+    std::string_view stringAt(size_t row) const;
+
+    /**
+     * 以Json形式获取任意类型的值
+     */
+    Json valueAt(size_t row) const;
+
+private:
+    void setValid(bool valid);
+    void appendPlaceholder();
+    void becomeType(ColumnType newType);
+    void promoteToDouble();
+    void promoteToJson();
+    [[noreturn]] void typeMismatch(const char* expected) const;
+
+    ColumnType type = ColumnType::Null;
+    size_t length = 0;
+    size_t nullCount = 0;
+    std::vector<uint8_t> validity;
+    std::vector<uint8_t> bools;
+    std::vector<int64_t> ints;
+    std::vector<double> doubles;
+    std::string chars;
+    std::vector<int32_t> offsets{0};
+    std::vector<Json> json;
+};
+
+/**
+ * 列式查询结果
+ *
+ * QueryResult::rows的替代表示：每列一个类型化缓冲区，不重复保存列名，
+ * 数值列可直接按连续数组做聚合。
+ */
+class ColumnarResult {
+public:
+    ColumnarResult() = default;
+
+    /**
+     * 构造函数
+     * @param columns 列名
+     */
+    explicit ColumnarResult(const std::vector<std::string>& columns);
+
+    /**
+     * 设置列名，只能在追加行之前调用
+     */
+    void setColumns(const std::vector<std::string>& columns);
+
+    /**
+     * 追加一行
+     * 对象行按列名取值，缺失的列为空，新出现的键追加为新列；数组行按位置取值
+     */
+    void appendRow(const Json& row);
+
+    size_t getRowCount() const {
+        return rowCount;
+    }
+
+    size_t getColumnCount() const {
+        return names.size();
+    }
+
+    const std::vector<std::string>& getColumns() const {
+        return names;
+    }
+
+    /**
+     * 按位置获取列
+     */
+    const Column& column(size_t index) const {
+        return data.at(index);
+    }
+
+    /**
+     * 按名称获取列
+     * @throws std::out_of_range 列不存在
+     */
+    const Column& column(const std::string& name) const;
+
+    /**
+     * 从QueryResult转换
+     */
+    static ColumnarResult fromQueryResult(const QueryResult& result);
+
+#ifdef DATAAPI_WITH_ARROW
+    /**
+     * 导出为Arrow RecordBatch（Json列序列化为字符串列）
+     */
+    std::shared_ptr<arrow::RecordBatch> toArrow() const;
+#endif
+
+    std::optional<int> totalRows;
+    Json metadata;
+
+private:
+    size_t addColumn(const std::string& name);
+
+    std::vector<std::string> names;
+    std::unordered_map<std::string, size_t> index;
+    std::vector<Column> data;
+    size_t rowCount = 0;
+};
+
+} // namespace dataapi
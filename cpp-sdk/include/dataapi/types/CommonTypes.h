@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <map>
@@ -8,6 +9,8 @@
 #include <chrono>
 #include <cstdint>
 #include <memory>
+#include <type_traits>
+#include <utility>
 #include <nlohmann/json.hpp>
 
 namespace dataapi {
@@ -74,9 +77,62 @@ struct HttpRequestConfig {
     HttpMethod method;
     std::string url;
     Headers headers;
-    Parameters params;
+    Parameters params; // 查询参数，发送时编码后追加到url
     Json data;
-    int timeout = 30000; // 默认30秒
+    std::string body; // 已序列化的请求体，非空时直接发送且忽略data
+    int timeout = 0; // 本次请求每次尝试的超时（毫秒），0表示使用ClientConfig::timeout
+    std::optional<std::chrono::steady_clock::time_point> deadline; // 整个调用（含重试与退避）的截止时间，到期后抛出TimeoutError，不再重试
+    std::optional<bool> idempotent; // 覆盖按HTTP方法推断的幂等性，用于决定是否重试
+    std::optional<int> maxRetries; // 覆盖ClientConfig::maxRetries，0表示不重试
+    int lowSpeedTime = 0; // 本次请求的低速检测（秒），传输速度持续低于ClientConfig::lowSpeedLimit时中止，0表示使用ClientConfig::lowSpeedTime；只在内置传输中生效
+    std::string endpointTemplate; // 指标中使用的端点模板，例如"/api/workflows/{id}"，为空时由url归一化得到
+    std::shared_ptr<const std::atomic<bool>> cancel; // 置为true后约一秒内中止传输，抛出代码为REQUEST_CANCELLED的DataApiError，不重试
+    bool binaryResponse = false; // 调用方能解码MessagePack/CBOR响应时设置，HttpClient按ClientConfig::wireFormat协商Accept
+};
+
+/**
+ * 请求体：Json文档或已序列化的字节
+ * 按值传入HttpClient的请求方法，之后移入请求配置，大型请求体不会被复制
+ */
+class RequestBody {
+public:
+    /**
+     * Json请求体，发送时序列化一次
+     */
+    RequestBody(Json data) : data(std::move(data)) {}
+
+    /**
+     * 已序列化的请求体，原样发送
+     * @param bytes 请求体
+     * @param contentType Content-Type，为空时按application/json发送
+     */
+    static RequestBody raw(std::string bytes, std::string contentType = "") {
+        RequestBody body(nullptr);
+        body.bytes = std::move(bytes);
+        body.contentType = std::move(contentType);
+        body.isRaw = true;
+        return body;
+    }
+
+    /**
+     * 移入请求配置：Json写入data，字节写入body；请求配置中已有的Content-Type优先
+     */
+    void applyTo(HttpRequestConfig& config) && {
+        if (!isRaw) {
+            config.data = std::move(data);
+            return;
+        }
+        config.body = std::move(bytes);
+        if (!contentType.empty()) {
+            config.headers.emplace("Content-Type", std::move(contentType));
+        }
+    }
+
+private:
+    Json data;
+    std::string bytes;
+    std::string contentType;
+    bool isRaw = false;
 };
 
 /**
@@ -224,6 +280,12 @@ struct LoginRequest {
     std::optional<std::string> twoFactorCode;
 };
 
+/**
+ * 解析令牌响应，接受OAuth2的access_token/refresh_token/expires_in/token_type
+ * 或accessToken等驼峰字段
+ */
+void from_json(const Json& j, TokenResponse& t);
+
 // PageResult JSON serialization templates
 template<typename T>
 void to_json(Json& j, const PageResult<T>& p) {
@@ -251,4 +313,54 @@ void from_json(const Json& j, PageResult<T>& p) {
     j.at("empty").get_to(p.empty);
 }
 
+namespace detail {
+
+template<typename T, typename = void>
+struct HasFromJson : std::false_type {};
+
+template<typename T>
+struct HasFromJson<T, std::void_t<decltype(from_json(std::declval<Json>(), std::declval<T&>()))>> : std::true_type {};
+
+} // namespace detail
+
+/**
+ * 从即将丢弃的Json中取值
+ * 字符串和Json直接移动；类型提供from_json(Json&&, T&)重载时调用该重载移动其中的大字段，
+ * 否则退回from_json(const Json&, T&)
+ */
+template<typename T>
+void takeFromJson(Json&& j, T& out) {
+    if constexpr (std::is_same_v<T, Json>) {
+        out = std::move(j);
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        out = std::move(j.get_ref<std::string&>());
+    } else if constexpr (detail::HasFromJson<T>::value) {
+        from_json(std::move(j), out);
+    } else {
+        j.get_to(out);
+    }
+}
+
+/**
+ * 解析服务端返回的分页响应
+ * 兼容Spring风格的number/size字段和pageNumber/pageSize字段
+ */
+template<typename T>
+PageResult<T> parsePageResult(Json j) {
+    PageResult<T> result;
+    Json& content = j.at("content");
+    result.content.resize(content.size());
+    for (size_t i = 0; i < content.size(); ++i) {
+        takeFromJson(std::move(content[i]), result.content[i]);
+    }
+    result.totalElements = j.value("totalElements", 0L);
+    result.totalPages = j.value("totalPages", 0);
+    result.pageSize = j.contains("size") ? j["size"].get<int>() : j.value("pageSize", 0);
+    result.pageNumber = j.contains("number") ? j["number"].get<int>() : j.value("pageNumber", 0);
+    result.first = j.value("first", false);
+    result.last = j.value("last", false);
+    result.empty = j.value("empty", result.content.empty());
+    return result;
+}
+
 } // namespace dataapi
\ No newline at end of file
@@ -93,6 +93,14 @@ struct BatchResult {
     Json errors;
 };
 
+// Batch Options
+struct BatchOptions {
+    size_t maxStatements = 1000;     // 每个请求的最大语句数
+    size_t maxBytes = 1 << 20;       // 每个请求中语句的最大总字节数，超长的单条语句独占一个请求
+    int concurrency = 4;             // 同时在途的请求数
+    bool retryChunks = true;         // 按重试策略重试失败的分块；响应丢失时分块中的语句可能被执行两次
+};
+
 // Backup Info
 struct BackupInfo {
     std::string id;
@@ -157,6 +165,14 @@ struct ImportOptions {
     Json additionalOptions;
 };
 
+// Export Options
+struct ExportOptions {
+    std::string format = "csv";
+    bool resume = false;          // 目标文件已存在时通过Range请求从其末尾续传，否则覆盖
+    int maxResumeAttempts = 3;    // 传输中断后按已写入长度续传的最大次数，需要服务端支持Range
+    size_t bufferSize = 1 << 20;  // 合并小块写入的缓冲区大小
+};
+
 /**
  * SQL执行结果
  */
@@ -179,10 +195,21 @@ void from_json(const Json& j, DatabaseConfig& d);
 void to_json(Json& j, const DatabaseInfo& d);
 void from_json(const Json& j, DatabaseInfo& d);
 
+void to_json(Json& j, const DatabaseUpdateRequest& d);
+
+void from_json(const Json& j, TableInfo& t);
+void from_json(const Json& j, TableSchema& t);
+
+void from_json(const Json& j, DatabaseMetrics& m);
+
 void to_json(Json& j, const QueryResult& q);
 void from_json(const Json& j, QueryResult& q);
+void from_json(Json&& j, QueryResult& q); // 移动rows和metadata，不复制行数据
 
 void to_json(Json& j, const SqlExecutionResult& s);
 void from_json(const Json& j, SqlExecutionResult& s);
 
+void from_json(const Json& j, BatchResult& b);
+void from_json(Json&& j, BatchResult& b); // 移动results和errors
+
 } // namespace dataapi
\ No newline at end of file
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace dataapi {
+
+/**
+ * 连续内存的只读视图，不持有数据
+ */
+template<typename T>
+class Span {
+public:
+    Span() = default;
+    Span(const T* data, size_t size) : pointer(data), count(size) {}
+
+    const T* data() const {
+        return pointer;
+    }
+    size_t size() const {
+        return count;
+    }
+    bool empty() const {
+        return count == 0;
+    }
+    const T& operator[](size_t index) const {
+        return pointer[index];
+    }
+    const T* begin() const {
+        return pointer;
+    }
+    const T* end() const {
+        return pointer + count;
+    }
+
+private:
+    const T* pointer = nullptr;
+    size_t count = 0;
+};
+
+/**
+ * 嵌入向量的存储精度
+ */
+enum class EmbeddingPrecision {
+    Float32,
+    Float16  // IEEE 754半精度，内存减半，按元素访问时转换为float
+};
+
+/**
+ * float与半精度之间的转换，舍入到最近的偶数
+ */
+uint16_t floatToHalf(float value);
+float halfToFloat(uint16_t value);
+
+/**
+ * 行优先连续存放的嵌入向量矩阵
+ *
+ * 第i个向量位于data() + i * stride()，所有向量维数相同。
+ * 以Float32存储时row()和operator[]返回指向内部缓冲区的视图，可直接交给向量检索；
+ * 以Float16存储时通过halfData()访问原始数据，或用at()/toVector()逐元素转换。
+ */
+class EmbeddingMatrix {
+public:
+    explicit EmbeddingMatrix(EmbeddingPrecision precision = EmbeddingPrecision::Float32)
+        : precisionValue(precision) {}
+
+    /**
+     * 追加一个向量，第一个向量确定维数
+     * @throws std::invalid_argument 维数与已有向量不同
+     */
+    void appendRow(const float* values, size_t count);
+
+    void appendRow(const std::vector<float>& values) {
+        appendRow(values.data(), values.size());
+    }
+
+    /**
+     * 预留行数
+     */
+    void reserve(size_t rows);
+
+    size_t rows() const {
+        return rowCount;
+    }
+
+    size_t dimensions() const {
+        return columns;
+    }
+
+    /**
+     * 相邻向量起始位置之间的元素数
+     */
+    size_t stride() const {
+        return columns;
+    }
+
+    EmbeddingPrecision precision() const {
+        return precisionValue;
+    }
+
+    /**
+     * 兼容按向量列表使用的写法
+     */
+    size_t size() const {
+        return rowCount;
+    }
+    bool empty() const {
+        return rowCount == 0;
+    }
+
+    /**
+     * Float32缓冲区，Float16存储时抛出std::logic_error
+     */
+    const float* data() const;
+
+    /**
+     * Float16缓冲区，Float32存储时抛出std::logic_error
+     */
+    const uint16_t* halfData() const;
+
+    /**
+     * 第index个向量的视图，仅限Float32存储
+     */
+    Span<float> row(size_t index) const {
+        return Span<float>(data() + index * columns, columns);
+    }
+
+    Span<float> operator[](size_t index) const {
+        return row(index);
+    }
+
+    /**
+     * 按元素读取，任意精度
+     */
+    float at(size_t row, size_t column) const;
+
+    /**
+     * 复制第row个向量
+     */
+    std::vector<float> toVector(size_t row) const;
+
+private:
+    EmbeddingPrecision precisionValue;
+    size_t rowCount = 0;
+    size_t columns = 0;
+    std::vector<float> values;
+    std::vector<uint16_t> halves;
+};
+
+} // namespace dataapi
@@ -136,4 +136,14 @@ void from_json(const Json& j, ProjectCreateRequest& p);
 void to_json(Json& j, const ProjectUpdateRequest& p);
 void from_json(const Json& j, ProjectUpdateRequest& p);
 
+void from_json(const Json& j, ImportResult& r);
+
+void to_json(Json& j, const ProjectConfig& c);
+void from_json(const Json& j, ProjectConfig& c);
+
+void from_json(const Json& j, ProjectStatistics& s);
+
+void to_json(Json& j, const ProjectPermission& p);
+void from_json(const Json& j, ProjectPermission& p);
+
 } // namespace dataapi
\ No newline at end of file
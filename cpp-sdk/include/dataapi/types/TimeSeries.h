@@ -0,0 +1,109 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "CommonTypes.h"
+#include "EmbeddingMatrix.h"
+
+namespace dataapi {
+
+/**
+ * 列式存放的时间序列
+ *
+ * 时间戳（Unix毫秒）严格递增，连续存放在一个数组中；每个字段的取值各占一个与时间戳等长的double数组，
+ * 某个时间点缺失的值为NaN。相比逐点的JSON对象，一个点只占8字节时间戳加每字段8字节。
+ */
+class TimeSeries {
+public:
+    TimeSeries() = default;
+
+    size_t size() const {
+        return timestamps.size();
+    }
+
+    bool empty() const {
+        return timestamps.empty();
+    }
+
+    const std::vector<std::string>& getFields() const {
+        return fields;
+    }
+
+    Span<int64_t> getTimestamps() const {
+        return Span<int64_t>(timestamps.data(), timestamps.size());
+    }
+
+    /**
+     * 字段的取值，与getTimestamps()按下标对应；字段不存在时为空
+     */
+    Span<double> getValues(std::string_view field) const;
+
+    /**
+     * 最后一个点的时间戳，序列为空时为INT64_MIN
+     */
+    int64_t lastTimestamp() const;
+
+    /**
+     * 追加一个点，各字段的值先记为NaN
+     * @param timestamp Unix毫秒，必须大于已有的最后一个时间戳
+     * @throws std::invalid_argument 时间戳不递增
+     */
+    void appendPoint(int64_t timestamp);
+
+    /**
+     * 设置最后一个点的字段值，字段不存在时新增（之前的点为NaN）
+     * @throws std::logic_error 序列为空
+     */
+    void setValue(std::string_view field, double value);
+
+    /**
+     * 追加另一个序列中晚于本序列最后时间戳的点，字段按名称对齐
+     */
+    void append(const TimeSeries& other);
+
+    /**
+     * 删除时间戳不小于timestamp的点（刷新时被重新获取的尾部）
+     */
+    void truncateFrom(int64_t timestamp);
+
+    /**
+     * 删除时间戳小于timestamp的点（滑出时间范围的头部）
+     */
+    void dropBefore(int64_t timestamp);
+
+    /**
+     * 解析列式JSON响应，不构建中间的Json文档：
+     * {"timestamps":[t0, t1, ...], "values":{"field":[v0, v1, ...], ...}}
+     * 时间戳为Unix毫秒；值为数字或null（记为NaN），长度与timestamps不同的字段按NaN补齐或截断
+     * @throws std::invalid_argument 格式无效
+     */
+    static TimeSeries parse(std::string_view json);
+
+private:
+    size_t fieldIndex(std::string_view field);
+
+    std::vector<int64_t> timestamps;
+    std::vector<std::string> fields;
+    std::vector<std::vector<double>> columns;
+};
+
+/**
+ * 时间序列的获取参数
+ * 时间范围按window切分为多个窗口并行请求，结果按时间顺序合并
+ */
+struct TimeSeriesOptions {
+    std::chrono::milliseconds step{0};                     // 聚合间隔，0表示由服务端决定；非0时窗口边界按其对齐
+    std::chrono::milliseconds window{std::chrono::hours(6)}; // 每个请求覆盖的时长
+    int concurrency = 4;                                   // 同时在途的窗口请求数
+};
+
+/**
+ * Timestamp与Unix毫秒之间的转换
+ */
+int64_t toUnixMillis(Timestamp time);
+Timestamp fromUnixMillis(int64_t millis);
+
+} // namespace dataapi
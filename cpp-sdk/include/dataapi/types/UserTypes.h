@@ -130,4 +130,6 @@ void from_json(const Json& j, UserCreateRequest& u);
 void to_json(Json& j, const UserUpdateRequest& u);
 void from_json(const Json& j, UserUpdateRequest& u);
 
+void from_json(const Json& j, UserPermission& p);
+
 } // namespace dataapi
\ No newline at end of file
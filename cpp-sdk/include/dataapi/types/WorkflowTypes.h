@@ -135,6 +135,7 @@ struct WorkflowExecutionRequest {
 // JSON序列化/反序列化函数声明
 void to_json(Json& j, const SysWorkflow& w);
 void from_json(const Json& j, SysWorkflow& w);
+void from_json(Json&& j, SysWorkflow& w); // 移动字符串字段，不复制definition
 
 void to_json(Json& j, const WorkflowCreateRequest& w);
 void from_json(const Json& j, WorkflowCreateRequest& w);
@@ -147,5 +148,15 @@ void from_json(const Json& j, WorkflowExecutionRequest& w);
 
 void to_json(Json& j, const WorkflowExecutionResult& w);
 void from_json(const Json& j, WorkflowExecutionResult& w);
+void from_json(Json&& j, WorkflowExecutionResult& w); // 移动result和metadata
+
+void from_json(const Json& j, WorkflowExecutionStatus& w);
+
+void from_json(const Json& j, WorkflowValidationResult& w);
+
+/**
+ * 执行状态是否为终态（COMPLETED、FAILED、CANCELLED，不区分大小写）
+ */
+bool isTerminalExecutionStatus(const std::string& status);
 
 } // namespace dataapi
\ No newline at end of file
@@ -1,11 +1,104 @@
 #pragma once
 
+#include <cstddef>
+#include <cstring>
+#include <iterator>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace dataapi {
 namespace utils {
 
+/**
+ * 按单字节分隔符惰性分割的视图，遍历时逐段查找，不分配内存
+ * 分段规则与StringUtils::split相同：空字符串没有分段，末尾分隔符之后的空段被省略
+ */
+class SplitRange {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = const std::string_view&;
+        
+        iterator() = default;
+        
+        reference operator*() const {
+            return piece;
+        }
+        
+        pointer operator->() const {
+            return &piece;
+        }
+        
+        iterator& operator++() {
+            next();
+            return *this;
+        }
+        
+        iterator operator++(int) {
+            iterator previous = *this;
+            next();
+            return previous;
+        }
+        
+        bool operator==(const iterator& other) const {
+            return done == other.done && (done || piece.data() == other.piece.data());
+        }
+        
+        bool operator!=(const iterator& other) const {
+            return !(*this == other);
+        }
+        
+    private:
+        friend class SplitRange;
+        
+        iterator(std::string_view str, char delimiter) : rest(str), delimiter(delimiter), done(false) {
+            next();
+        }
+        
+        void next() {
+            if (rest.empty()) {
+                done = true;
+                return;
+            }
+            // memchr在常见C库中是向量化实现
+            auto hit = static_cast<const char*>(std::memchr(rest.data(), delimiter, rest.size()));
+            if (hit == nullptr) {
+                piece = rest;
+                rest = std::string_view();
+            } else {
+                size_t length = static_cast<size_t>(hit - rest.data());
+                piece = rest.substr(0, length);
+                rest.remove_prefix(length + 1);
+            }
+        }
+        
+        std::string_view rest;
+        std::string_view piece;
+        char delimiter = 0;
+        bool done = true;
+    };
+    
+    SplitRange(std::string_view str, char delimiter) : str(str), delimiter(delimiter) {
+    }
+    
+    iterator begin() const {
+        return iterator(str, delimiter);
+    }
+    
+    iterator end() const {
+        return iterator();
+    }
+    
+private:
+    std::string_view str;
+    char delimiter;
+};
+
 /**
  * 字符串工具类
  */
@@ -18,6 +111,13 @@ public:
      */
     static std::string trim(const std::string& str);
     
+    /**
+     * 去除首尾空白字符，返回原字符串的子视图
+     * @param str 输入字符串
+     * @return 去除空白字符后的视图
+     */
+    static std::string_view trimView(std::string_view str);
+    
     /**
      * 将字符串转换为小写
      * @param str 输入字符串
@@ -32,13 +132,28 @@ public:
      */
     static std::string toUpper(const std::string& str);
     
+    /**
+     * 就地将ASCII字母转换为小写/大写，不分配内存
+     * @param str 输入输出字符串
+     */
+    static void toLowerInPlace(std::string& str);
+    static void toUpperInPlace(std::string& str);
+    
+    /**
+     * 忽略ASCII大小写比较两个字符串（HTTP头部名称等）
+     * @param a 字符串
+     * @param b 字符串
+     * @return 是否相等
+     */
+    static bool equalsIgnoreCase(std::string_view a, std::string_view b);
+    
     /**
      * 检查字符串是否以指定前缀开始
      * @param str 输入字符串
      * @param prefix 前缀
      * @return 是否以前缀开始
      */
-    static bool startsWith(const std::string& str, const std::string& prefix);
+    static bool startsWith(std::string_view str, std::string_view prefix);
     
     /**
      * 检查字符串是否以指定后缀结束
@@ -46,7 +161,7 @@ public:
      * @param suffix 后缀
      * @return 是否以后缀结束
      */
-    static bool endsWith(const std::string& str, const std::string& suffix);
+    static bool endsWith(std::string_view str, std::string_view suffix);
     
     /**
      * 按分隔符分割字符串
@@ -56,6 +171,27 @@ public:
      */
     static std::vector<std::string> split(const std::string& str, char delimiter);
     
+    /**
+     * 按分隔符惰性分割，分段为原字符串的子视图
+     * @param str 输入字符串，遍历期间必须有效
+     * @param delimiter 分隔符
+     * @return 可用于范围for的分段视图
+     */
+    static SplitRange splitView(std::string_view str, char delimiter) {
+        return SplitRange(str, delimiter);
+    }
+    
+    /**
+     * 按分隔符分割到调用方提供的数组，不分配内存
+     * 分段多于capacity时，最后一个元素为剩余的未分割部分
+     * @param str 输入字符串
+     * @param delimiter 分隔符
+     * @param out 输出数组
+     * @param capacity 输出数组的长度
+     * @return 写入的分段数
+     */
+    static size_t splitInto(std::string_view str, char delimiter, std::string_view* out, size_t capacity);
+    
     /**
      * 用分隔符连接字符串数组
      * @param strings 字符串数组
@@ -73,6 +209,27 @@ public:
      */
     static std::string replace(const std::string& str, const std::string& from, const std::string& to);
     
+    /**
+     * 替换子串并追加到out末尾，from为空时原样追加
+     * @param out 输出缓冲区（任意分配器的std::basic_string<char>）
+     * @param str 输入字符串
+     * @param from 要替换的子串
+     * @param to 替换为的子串
+     */
+    template<typename String>
+    static void appendReplaced(String& out, std::string_view str, std::string_view from, std::string_view to) {
+        if (from.empty()) {
+            out.append(str.data(), str.size());
+            return;
+        }
+        size_t start = 0;
+        for (size_t pos; (pos = str.find(from, start)) != std::string_view::npos; start = pos + from.size()) {
+            out.append(str.data() + start, pos - start);
+            out.append(to.data(), to.size());
+        }
+        out.append(str.data() + start, str.size() - start);
+    }
+    
     /**
      * 检查字符串是否为空
      * @param str 输入字符串
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
+#include <string_view>
 #include <map>
+#include "StringUtils.h"
 
 namespace dataapi {
 namespace utils {
@@ -21,6 +24,33 @@ public:
      */
     static std::string encode(const std::string& value);
     
+    /**
+     * URL编码后的长度
+     * @param value 要编码的字符串
+     * @return 编码后的字节数
+     */
+    static size_t encodedSize(std::string_view value);
+    
+    /**
+     * URL编码并写入dest，dest至少有encodedSize(value)字节
+     * @param dest 输出位置
+     * @param value 要编码的字符串
+     * @return 写入结束的位置
+     */
+    static char* encodeTo(char* dest, std::string_view value);
+    
+    /**
+     * URL编码并追加到out末尾，只在out容量不足时分配一次
+     * @param out 输出缓冲区（任意分配器的std::basic_string<char>）
+     * @param value 要编码的字符串
+     */
+    template<typename String>
+    static void appendEncoded(String& out, std::string_view value) {
+        size_t offset = out.size();
+        out.resize(offset + encodedSize(value));
+        encodeTo(&out[offset], value);
+    }
+    
     /**
      * URL解码
      * @param value 要解码的字符串
@@ -28,6 +58,27 @@ public:
      */
     static std::string decode(const std::string& value);
     
+    /**
+     * URL解码并写入dest，dest至少有value.size()字节（解码不会变长）
+     * %后不是两位十六进制数字时按原样保留
+     * @param dest 输出位置
+     * @param value 要解码的字符串
+     * @return 写入结束的位置
+     */
+    static char* decodeTo(char* dest, std::string_view value);
+    
+    /**
+     * URL解码并追加到out末尾
+     * @param out 输出缓冲区（任意分配器的std::basic_string<char>）
+     * @param value 要解码的字符串
+     */
+    template<typename String>
+    static void appendDecoded(String& out, std::string_view value) {
+        size_t offset = out.size();
+        out.resize(offset + value.size());
+        out.resize(static_cast<size_t>(decodeTo(&out[offset], value) - &out[0]));
+    }
+    
     /**
      * 构建查询字符串
      * @param params 参数映射
@@ -35,6 +86,31 @@ public:
      */
     static std::string buildQueryString(const Parameters& params);
     
+    /**
+     * 构建查询字符串并追加到out末尾（不含开头的?）
+     * @param out 输出缓冲区（任意分配器的std::basic_string<char>）
+     * @param params 参数映射
+     */
+    template<typename String>
+    static void appendQueryString(String& out, const Parameters& params) {
+        size_t size = out.size();
+        for (const auto& param : params) {
+            size += encodedSize(param.first) + encodedSize(param.second) + 2;
+        }
+        out.reserve(size);
+        
+        bool first = true;
+        for (const auto& param : params) {
+            if (!first) {
+                out += '&';
+            }
+            appendEncoded(out, param.first);
+            out += '=';
+            appendEncoded(out, param.second);
+            first = false;
+        }
+    }
+    
     /**
      * 解析查询字符串
      * @param queryString 查询字符串
@@ -42,6 +118,25 @@ public:
      */
     static Parameters parseQueryString(const std::string& queryString);
     
+    /**
+     * 逐个遍历查询字符串中的参数，不分配内存
+     * 键和值是原字符串中未解码的子视图，需要时用appendDecoded解码；没有=的参数被跳过
+     * @param queryString 查询字符串，开头的?可选
+     * @param callback 以(std::string_view key, std::string_view value)调用
+     */
+    template<typename Callback>
+    static void forEachQueryParam(std::string_view queryString, Callback&& callback) {
+        if (!queryString.empty() && queryString.front() == '?') {
+            queryString.remove_prefix(1);
+        }
+        for (std::string_view pair : SplitRange(queryString, '&')) {
+            size_t equalPos = pair.find('=');
+            if (equalPos != std::string_view::npos) {
+                callback(pair.substr(0, equalPos), pair.substr(equalPos + 1));
+            }
+        }
+    }
+    
     /**
      * 连接URL路径
      * @param base 基础路径
@@ -1,25 +1,62 @@
 #include "dataapi/DataApiClient.h"
 #include "dataapi/exceptions/DataApiException.h"
+#include <mutex>
 #include <stdexcept>
 
 using namespace dataapi::exceptions;
 
 namespace dataapi {
 
+/**
+ * 按需创建的服务客户端
+ */
+struct DataApiClient::Services {
+    std::once_flag workflowOnce;
+    std::once_flag projectOnce;
+    std::once_flag databaseOnce;
+    std::once_flag aiProviderOnce;
+    std::once_flag userOnce;
+    std::unique_ptr<client::WorkflowClient> workflowClient;
+    std::unique_ptr<client::ProjectClient> projectClient;
+    std::unique_ptr<client::DatabaseClient> databaseClient;
+    std::unique_ptr<client::AiProviderClient> aiProviderClient;
+    std::unique_ptr<client::UserClient> userClient;
+};
+
+/**
+ * 首次调用时创建服务客户端，并发的首次调用只创建一次
+ */
+template <typename T>
+static T& lazyClient(std::once_flag& once, std::unique_ptr<T>& instance,
+                     const std::shared_ptr<http::HttpClient>& httpClient) {
+    std::call_once(once, [&] {
+        instance = std::make_unique<T>(httpClient);
+    });
+    return *instance;
+}
+
 DataApiClient::DataApiClient(const ClientConfig& config, std::shared_ptr<auth::AuthenticationProvider> authProvider)
+    : DataApiClient(config, std::move(authProvider), nullptr) {
+}
+
+DataApiClient::DataApiClient(const ClientConfig& config,
+                             std::shared_ptr<auth::AuthenticationProvider> authProvider,
+                             std::shared_ptr<http::CurlRuntime> runtime)
     : config_(config)
     , authProvider_(authProvider)
-    , httpClient_(std::make_shared<http::HttpClient>(config, authProvider))
-    , workflowClient_(std::make_unique<client::WorkflowClient>(httpClient_))
-    , projectClient_(std::make_unique<client::ProjectClient>(httpClient_))
-    , databaseClient_(std::make_unique<client::DatabaseClient>(httpClient_))
-    , aiProviderClient_(std::make_unique<client::AiProviderClient>(httpClient_))
-    , userClient_(std::make_unique<client::UserClient>(httpClient_)) {
+    , httpClient_(std::make_shared<http::HttpClient>(config, authProvider, std::move(runtime)))
+    , services_(std::make_unique<Services>()) {
     initialize();
+    if (config_.warmUpConnections > 0) {
+        httpClient_->warmUp(static_cast<size_t>(config_.warmUpConnections));
+    }
 }
 
 DataApiClient::~DataApiClient() = default;
 
+DataApiClient::DataApiClient(DataApiClient&&) noexcept = default;
+DataApiClient& DataApiClient::operator=(DataApiClient&&) noexcept = default;
+
 bool DataApiClient::testConnection() {
     try {
         auto response = httpClient_->get("/health");
@@ -64,23 +101,23 @@ HealthStatus DataApiClient::getHealth() {
 }
 
 client::WorkflowClient& DataApiClient::getWorkflowClient() {
-    return *workflowClient_;
+    return lazyClient(services_->workflowOnce, services_->workflowClient, httpClient_);
 }
 
 client::ProjectClient& DataApiClient::getProjectClient() {
-    return *projectClient_;
+    return lazyClient(services_->projectOnce, services_->projectClient, httpClient_);
 }
 
 client::DatabaseClient& DataApiClient::getDatabaseClient() {
-    return *databaseClient_;
+    return lazyClient(services_->databaseOnce, services_->databaseClient, httpClient_);
 }
 
 client::AiProviderClient& DataApiClient::getAiProviderClient() {
-    return *aiProviderClient_;
+    return lazyClient(services_->aiProviderOnce, services_->aiProviderClient, httpClient_);
 }
 
 client::UserClient& DataApiClient::getUserClient() {
-    return *userClient_;
+    return lazyClient(services_->userOnce, services_->userClient, httpClient_);
 }
 
 const ClientConfig& DataApiClient::getConfig() const {
@@ -97,8 +134,8 @@ std::shared_ptr<http::HttpClient> DataApiClient::getHttpClient() {
 
 void DataApiClient::updateConfig(const ClientConfig& newConfig) {
     config_ = newConfig;
-    httpClient_ = std::make_shared<http::HttpClient>(config_, authProvider_);
-    initialize();
+    // 原地更新共享的HttpClient，各服务客户端持有的指针保持有效
+    httpClient_->updateConfig(config_);
 }
 
 void DataApiClient::close() {
@@ -117,6 +154,15 @@ std::unique_ptr<DataApiClient> DataApiClient::createForDevelopment(
     return std::make_unique<DataApiClient>(config, authProvider);
 }
 
+std::shared_ptr<http::CurlRuntime> DataApiClient::prewarmRuntime(const ClientConfig& config) {
+    auto runtime = http::CurlRuntime::instance();
+    // 证书存储按来源缓存在运行时中，之后的TLS握手直接复用
+    if (config.verifySSL && !config.transport) {
+        runtime->getCertificateStore(config.caBundlePath);
+    }
+    return runtime;
+}
+
 std::unique_ptr<DataApiClient> DataApiClient::createForProduction(
     const std::string& apiKey,
     const std::string& baseUrl) {
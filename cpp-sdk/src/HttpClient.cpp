@@ -1,67 +1,635 @@
 #include "dataapi/http/HttpClient.h"
+#include "dataapi/http/Transport.h"
+#include "dataapi/http/Tracing.h"
+#include "dataapi/http/LoadBalancer.h"
 #include "dataapi/exceptions/DataApiException.h"
+#include "dataapi/error/DataApiError.h"
 #include "dataapi/ClientConfig.h"
 #include "dataapi/Types.h"
+#include "dataapi/utils/UrlUtils.h"
+#include "http/Transfer.h"
+#include "http/GzipStream.h"
+#include "http/RequestArena.h"
+#include "http/RequestLogger.h"
 #include <curl/curl.h>
+#include <openssl/ssl.h>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <memory>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <condition_variable>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <thread>
+#include <vector>
+#include <strings.h>
+#include <arpa/inet.h>
 
 namespace dataapi {
 namespace http {
 
+// 根据Content-Length预留响应体缓冲区时的上限，防止异常的长度声明导致过量分配
+static constexpr size_t kMaxBodyReserve = 256 * 1024 * 1024;
+
+// 总延迟直方图的样本数达到该值后才启用对冲，样本过少时分位数没有意义
+static constexpr uint64_t kHedgeMinSamples = 100;
+
 // CURL写入回调函数
-static size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::string* userp) {
+static size_t WriteCallback(char* contents, size_t size, size_t nmemb, void* userp) {
+    auto* transfer = static_cast<detail::Transfer*>(userp);
     size_t totalSize = size * nmemb;
-    userp->append(static_cast<char*>(contents), totalSize);
+    
+    if (transfer->sink && transfer->sinkMode == detail::Transfer::SinkMode::Undecided) {
+        // 收到首个数据块时状态码已确定：成功响应交给sink，错误响应仍缓冲以便读取错误信息
+        long statusCode = 0;
+        curl_easy_getinfo(transfer->curl, CURLINFO_RESPONSE_CODE, &statusCode);
+        transfer->sinkMode = statusCode >= 200 && statusCode < 300
+            ? detail::Transfer::SinkMode::Stream
+            : detail::Transfer::SinkMode::Buffer;
+        if (transfer->sinkMode == detail::Transfer::SinkMode::Stream && transfer->onStart) {
+            try {
+                (*transfer->onStart)(static_cast<int>(statusCode), transfer->responseHeaders);
+            } catch (...) {
+                transfer->sinkError = std::current_exception();
+                return 0;
+            }
+        }
+    }
+    
+    if (transfer->sinkMode == detail::Transfer::SinkMode::Stream) {
+        try {
+            if (!(*transfer->sink)(contents, totalSize)) {
+                return 0; // 中止传输
+            }
+        } catch (...) {
+            // 异常不能穿过libcurl，保存后在finishTransfer中重新抛出
+            transfer->sinkError = std::current_exception();
+            return 0;
+        }
+        return totalSize;
+    }
+    
+    transfer->responseBody.append(contents, totalSize);
     return totalSize;
 }
 
+// CURL读取回调函数
+static size_t ReadCallback(char* buffer, size_t size, size_t nitems, void* userp) {
+    auto* transfer = static_cast<detail::Transfer*>(userp);
+    try {
+        return transfer->bodyReader(buffer, size * nitems);
+    } catch (...) {
+        transfer->readError = std::current_exception();
+        return CURL_READFUNC_ABORT;
+    }
+}
+
+// CURL进度回调：检查取消标志，并按已读取的上传字节数报告进度
+static int ProgressCallback(void* clientp, curl_off_t, curl_off_t, curl_off_t, curl_off_t) {
+    auto* transfer = static_cast<detail::Transfer*>(clientp);
+    if (transfer->cancel && transfer->cancel->load()) {
+        transfer->cancelled = true;
+        return 1;
+    }
+    if (!transfer->onProgress) {
+        return 0;
+    }
+    uint64_t total = transfer->uploadLength < 0 ? 0 : static_cast<uint64_t>(transfer->uploadLength);
+    try {
+        return (*transfer->onProgress)(transfer->uploadedBytes, total) ? 0 : 1;
+    } catch (...) {
+        transfer->readError = std::current_exception();
+        return 1;
+    }
+}
+
 // CURL头部回调函数
-static size_t HeaderCallback(char* buffer, size_t size, size_t nitems, Headers* headers) {
+static size_t HeaderCallback(char* buffer, size_t size, size_t nitems, void* userp) {
+    auto* transfer = static_cast<detail::Transfer*>(userp);
     size_t totalSize = size * nitems;
-    std::string header(buffer, totalSize);
+    ResponseHeaders& headers = transfer->responseHeaders;
     
-    // 查找冒号分隔符
-    size_t colonPos = header.find(':');
-    if (colonPos != std::string::npos) {
-        std::string key = header.substr(0, colonPos);
-        std::string value = header.substr(colonPos + 1);
-        
-        // 去除前后空白字符
-        key.erase(0, key.find_first_not_of(" \t\r\n"));
-        key.erase(key.find_last_not_of(" \t\r\n") + 1);
-        value.erase(0, value.find_first_not_of(" \t\r\n"));
-        value.erase(value.find_last_not_of(" \t\r\n") + 1);
-        
-        (*headers)[key] = value;
+    if (headers.append(buffer, totalSize) && !transfer->sink && transfer->method != HttpMethod::HEAD) {
+        // 已知长度时一次性预留响应体，避免逐块追加时反复扩容
+        std::string_view name = headers.nameAt(headers.size() - 1);
+        if (name.size() == 14 && strncasecmp(name.data(), "Content-Length", 14) == 0) {
+            std::string value(headers.valueAt(headers.size() - 1));
+            unsigned long long length = std::strtoull(value.c_str(), nullptr, 10);
+            transfer->responseBody.reserve(static_cast<size_t>(std::min<unsigned long long>(length, kMaxBodyReserve)));
+        }
     }
     
     return totalSize;
 }
 
+/**
+ * 将Json直接序列化到out末尾，与Json::dump()输出相同但不分配新的字符串
+ */
+static void serializeJson(const Json& json, std::string& out) {
+    nlohmann::detail::serializer<Json> serializer(nlohmann::detail::output_adapter<char>(out), ' ');
+    serializer.dump(json, false, false, 0);
+}
+
+static void setPayload(CURL* curl, const std::string& payload) {
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, payload.data());
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(payload.size()));
+}
+
+/**
+ * 使用transfer.bodyReader流式发送请求体
+ * PUT/PATCH保留CURLOPT_CUSTOMREQUEST设置的方法，以POST语义发送请求体
+ */
+static void setBodyReader(CURL* curl, detail::Transfer& transfer) {
+    curl_easy_setopt(curl, CURLOPT_POST, 1L);
+    curl_easy_setopt(curl, CURLOPT_READFUNCTION, ReadCallback);
+    curl_easy_setopt(curl, CURLOPT_READDATA, &transfer);
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(-1));
+}
+
+static bool hasHeader(const Headers& headers, const char* name) {
+    return std::any_of(headers.begin(), headers.end(), [name](const auto& header) {
+        return strcasecmp(header.first.c_str(), name) == 0;
+    });
+}
+
+/**
+ * 按ClientConfig::wireFormat协商的Accept值
+ * 请求未标记binaryResponse、编码为Json，或请求级/默认头部已指定Accept时返回nullptr
+ */
+static const char* binaryAccept(const ClientConfig& config, const HttpRequestConfig& request) {
+    if (!request.binaryResponse || config.wireFormat == WireFormat::Json || hasHeader(request.headers, "Accept")) {
+        return nullptr;
+    }
+    for (const auto& header : config.defaultHeaders) {
+        if (strcasecmp(header.first.c_str(), "Accept") == 0) {
+            return nullptr;
+        }
+    }
+    return config.wireFormat == WireFormat::MessagePack
+        ? "application/msgpack, application/json;q=0.5"
+        : "application/cbor, application/json;q=0.5";
+}
+
+/**
+ * 为一次传输开始客户端span
+ * 没有导出器且当前线程没有上游上下文时不追踪；请求级头部已带traceparent时由调用方负责传递，同样不追踪。
+ * 只有会被导出的span才复制名称和URL，未采样的请求只生成新的span id
+ */
+static std::unique_ptr<TraceSpan> startSpan(const ClientConfig& config, const HttpRequestConfig& request,
+                                       std::string_view url, const std::string& endpoint) {
+    const TraceContext* parent = TraceContext::current();
+    if ((!parent && !config.spanExporter) || hasHeader(request.headers, "traceparent")) {
+        return nullptr;
+    }
+    auto span = std::make_unique<TraceSpan>();
+    if (parent) {
+        span->context = parent->child();
+        span->parentSpanId = parent->spanId;
+    } else {
+        span->context = TraceContext::root(config.traceSampleRate);
+    }
+    if (span->context.sampled && config.spanExporter) {
+        span->name.assign(detail::methodName(request.method));
+        if (!endpoint.empty()) {
+            span->name.append(" ").append(endpoint);
+        }
+        span->method = request.method;
+        span->url.assign(url.data(), url.size());
+        span->endpoint = endpoint;
+        span->startTime = std::chrono::system_clock::now();
+    }
+    return span;
+}
+
+/**
+ * 结束span并交给导出器，error为空表示传输完成（任意状态码）
+ */
+static void finishSpan(TraceSpan* span, const ClientConfig& config, const RequestEvent& event, std::string error) {
+    if (!span || !span->context.sampled || !config.spanExporter) {
+        return;
+    }
+    span->endTime = std::chrono::system_clock::now();
+    span->statusCode = event.statusCode;
+    span->stats = event.stats;
+    span->error = std::move(error);
+    try {
+        config.spanExporter->exportSpan(*span);
+    } catch (...) {
+        // 导出失败不影响请求
+    }
+}
+
+static std::string describe(const std::exception_ptr& error) {
+    try {
+        std::rethrow_exception(error);
+    } catch (const std::exception& e) {
+        return e.what();
+    } catch (...) {
+        return "unknown error";
+    }
+}
+
+/**
+ * 把本次使用的端点加入已尝试集合
+ */
+static void markTried(uint64_t* tried, const LoadBalancer::Lease& lease) {
+    if (tried && lease && lease.getIndex() < 64) {
+        *tried |= uint64_t(1) << lease.getIndex();
+    }
+}
+
+/**
+ * 按传输结果上报端点：连接错误、超时和502/503/504视为端点故障
+ */
+static void completeLease(LoadBalancer::Lease& lease, const RequestEvent& event) {
+    bool failure = event.transportError || event.statusCode == 502 || event.statusCode == 503 || event.statusCode == 504;
+    lease.complete(event.stats.totalTime, failure);
+}
+
+namespace detail {
+
+/**
+ * 一次尝试的准入许可
+ * 构造时依次通过熔断器和并发限制，被拒绝时抛出不可重试的DataApiError；
+ * 请求结束后以complete()上报结果，未上报即析构时视为与服务端健康无关
+ */
+class Admission {
+public:
+    Admission(const std::shared_ptr<CircuitBreakerRegistry>& breakers,
+              const std::shared_ptr<AdaptiveConcurrencyLimiter>& limiter,
+              const std::string& url,
+              bool streaming)
+        : streaming(streaming) {
+        if (breakers) {
+            std::string group = CircuitBreakerRegistry::groupOf(url);
+            breaker = breakers->get(group);
+            if (!breaker->tryAcquire(ticket)) {
+                throw error::DataApiError("Circuit breaker is open for " + group, "CIRCUIT_OPEN");
+            }
+        }
+        if (limiter) {
+            if (!limiter->tryAcquire()) {
+                if (breaker) {
+                    breaker->onIgnored(ticket);
+                }
+                throw error::DataApiError("Concurrency limit of " + std::to_string(limiter->getLimit()) +
+                                          " requests reached", "CONCURRENCY_LIMITED");
+            }
+            this->limiter = limiter;
+        }
+        start = std::chrono::steady_clock::now();
+    }
+
+    Admission(const Admission&) = delete;
+    Admission& operator=(const Admission&) = delete;
+
+    ~Admission() {
+        finish(Outcome::Ignored);
+    }
+
+    void complete(int statusCode) {
+        switch (statusCode) {
+            case 502:
+            case 503:
+            case 504:
+                finish(Outcome::Failure);
+                break;
+            case 429:
+                finish(Outcome::Overload);
+                break;
+            default:
+                finish(Outcome::Success);
+                break;
+        }
+    }
+
+    /**
+     * @param delivered 流式响应是否已有数据交给sink；此后的超时是长连接到达时限或空闲，不是服务端故障
+     */
+    void complete(const std::exception& e, bool delivered = false) {
+        // 调用方的sink主动中止不是服务端故障
+        if (dynamic_cast<const error::SinkAbortedError*>(&e) ||
+            (streaming && delivered && dynamic_cast<const error::TimeoutError*>(&e))) {
+            finish(Outcome::Ignored);
+            return;
+        }
+        bool unhealthy = dynamic_cast<const error::TimeoutError*>(&e) ||
+                         dynamic_cast<const error::NetworkError*>(&e) ||
+                         dynamic_cast<const error::ServiceUnavailableError*>(&e);
+        finish(unhealthy ? Outcome::Failure : Outcome::Ignored);
+    }
+
+    void complete(std::exception_ptr error) {
+        try {
+            std::rethrow_exception(error);
+        } catch (const std::exception& e) {
+            complete(e);
+        } catch (...) {
+            finish(Outcome::Ignored);
+        }
+    }
+
+private:
+    // Overload为429：服务端正常响应但要求降低速率，只影响并发上限
+    enum class Outcome { Success, Failure, Overload, Ignored };
+
+    void finish(Outcome outcome) {
+        if (done) {
+            return;
+        }
+        done = true;
+        if (breaker) {
+            if (outcome == Outcome::Failure) {
+                breaker->onFailure(ticket);
+            } else if (outcome == Outcome::Ignored) {
+                breaker->onIgnored(ticket);
+            } else {
+                breaker->onSuccess(ticket);
+            }
+        }
+        if (limiter) {
+            if (outcome == Outcome::Failure || outcome == Outcome::Overload) {
+                limiter->onDropped();
+            } else if (outcome == Outcome::Success && !streaming) {
+                // 流式响应的耗时取决于数据量，不作为延迟样本
+                limiter->onSample(std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start));
+            } else {
+                limiter->onIgnored();
+            }
+        }
+    }
+
+    std::shared_ptr<CircuitBreaker> breaker;
+    std::shared_ptr<AdaptiveConcurrencyLimiter> limiter;
+    uint64_t ticket = 0;
+    bool streaming;
+    bool done = false;
+    std::chrono::steady_clock::time_point start;
+};
+
+} // namespace detail
+
+/**
+ * 本次尝试的超时（毫秒）：请求级超时优先于客户端配置，且不超过截止时间的剩余时间
+ */
+static int attemptTimeout(const ClientConfig& config, const HttpRequestConfig& request) {
+    long long timeout = request.timeout > 0 ? request.timeout : config.timeout;
+    if (request.deadline) {
+        auto remaining = std::chrono::ceil<std::chrono::milliseconds>(*request.deadline - std::chrono::steady_clock::now());
+        // 0会被libcurl视为不限时，剩余时间耗尽时取1毫秒
+        long long cap = std::max<long long>(1, remaining.count());
+        timeout = timeout > 0 ? std::min(timeout, cap) : cap;
+    }
+    return static_cast<int>(std::min<long long>(timeout, std::numeric_limits<int>::max()));
+}
+
+static bool isCancelled(const HttpRequestConfig& request) {
+    return request.cancel && request.cancel->load(std::memory_order_relaxed);
+}
+
+/**
+ * 重试前的退避等待；请求带取消标志时分段等待，标志置位后立即返回
+ */
+static void waitBeforeRetry(const HttpRequestConfig& request, std::chrono::milliseconds delay) {
+    if (!request.cancel) {
+        std::this_thread::sleep_for(delay);
+        return;
+    }
+    constexpr std::chrono::milliseconds kSlice(20);
+    auto until = std::chrono::steady_clock::now() + delay;
+    for (auto now = std::chrono::steady_clock::now(); now < until && !isCancelled(request);
+         now = std::chrono::steady_clock::now()) {
+        std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(kSlice, until - now));
+    }
+}
+
+static CircuitBreakerOptions circuitBreakerOptions(const ClientConfig& config) {
+    CircuitBreakerOptions options;
+    options.windowSize = static_cast<size_t>(std::max(1, config.circuitBreakerWindow));
+    options.minimumCalls = static_cast<size_t>(std::max(1, config.circuitBreakerMinimumRequests));
+    options.failureRateThreshold = config.circuitBreakerFailureRate;
+    options.openDuration = std::chrono::milliseconds(config.circuitBreakerOpenMs);
+    return options;
+}
+
+static ConcurrencyLimitOptions concurrencyLimitOptions(const ClientConfig& config) {
+    ConcurrencyLimitOptions options;
+    options.initialLimit = config.initialConcurrencyLimit;
+    options.minLimit = config.minConcurrencyLimit;
+    options.maxLimit = config.maxConcurrencyLimit;
+    return options;
+}
+
+static LoadBalancerOptions loadBalancerOptions(const ClientConfig& config) {
+    LoadBalancerOptions options;
+    options.policy = config.loadBalancingPolicy;
+    options.failureThreshold = static_cast<size_t>(std::max(0, config.endpointFailureThreshold));
+    options.ejectionTime = std::chrono::milliseconds(config.endpointEjectionMs);
+    options.healthCheckInterval = std::chrono::milliseconds(std::max(0, config.healthCheckIntervalMs));
+    return options;
+}
+
+/**
+ * 健康探测：HEAD <baseUrl>/health，2xx视为健康
+ * 在负载均衡的后台线程上执行，只使用按值捕获的配置，不引用HttpClient本身（客户端可以被移动）
+ */
+static bool probeEndpoint(const ClientConfig& config, const std::string& baseUrl) {
+    if (config.transport) {
+        TransportRequest request;
+        request.method = HttpMethod::HEAD;
+        request.url = baseUrl + "/health";
+        request.timeoutMs = config.healthCheckTimeoutMs;
+        HttpResponse response = config.transport->send(request);
+        return response.statusCode >= 200 && response.statusCode < 300;
+    }
+    
+    std::unique_ptr<CURL, decltype(&curl_easy_cleanup)> curl(curl_easy_init(), curl_easy_cleanup);
+    if (!curl) {
+        return false;
+    }
+    std::string url = baseUrl + "/health";
+    curl_easy_setopt(curl.get(), CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl.get(), CURLOPT_NOBODY, 1L);
+    curl_easy_setopt(curl.get(), CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl.get(), CURLOPT_TIMEOUT_MS, static_cast<long>(config.healthCheckTimeoutMs));
+    if (!config.verifySSL) {
+        curl_easy_setopt(curl.get(), CURLOPT_SSL_VERIFYPEER, 0L);
+        curl_easy_setopt(curl.get(), CURLOPT_SSL_VERIFYHOST, 0L);
+    } else if (!config.caBundlePath.empty()) {
+        curl_easy_setopt(curl.get(), CURLOPT_CAINFO, config.caBundlePath.c_str());
+    }
+    if (!config.proxyUrl.empty()) {
+        curl_easy_setopt(curl.get(), CURLOPT_PROXY, config.proxyUrl.c_str());
+    }
+    if (!config.unixSocketPath.empty()) {
+        curl_easy_setopt(curl.get(), CURLOPT_UNIX_SOCKET_PATH, config.unixSocketPath.c_str());
+    }
+    if (curl_easy_perform(curl.get()) != CURLE_OK) {
+        return false;
+    }
+    long status = 0;
+    curl_easy_getinfo(curl.get(), CURLINFO_RESPONSE_CODE, &status);
+    return status >= 200 && status < 300;
+}
+
 HttpClient::HttpClient(const ClientConfig& config, std::shared_ptr<auth::AuthenticationProvider> authProvider) 
-    : config(config), authProvider(authProvider) {
-    curl_global_init(CURL_GLOBAL_DEFAULT);
+    : HttpClient(config, std::move(authProvider), nullptr) {
+}
+
+HttpClient::HttpClient(const ClientConfig& config,
+                       std::shared_ptr<auth::AuthenticationProvider> authProvider,
+                       std::shared_ptr<CurlRuntime> runtime)
+    : state(std::make_shared<const detail::ClientState>(detail::ClientState{config, std::move(authProvider)})),
+      runtime(runtime ? std::move(runtime) : CurlRuntime::instance()),
+      retryBudget(std::make_shared<RetryBudget>(config.retryBudgetRatio, config.retryBudgetCapacity)),
+      hedgeBudget(std::make_shared<RetryBudget>(config.hedgeBudgetRatio, config.hedgeBudgetCapacity)),
+      metrics(std::make_shared<RequestMetrics>()) {
+    if (config.enableCircuitBreaker) {
+        circuitBreakers = std::make_shared<CircuitBreakerRegistry>(circuitBreakerOptions(config));
+    }
+    if (config.enableAdaptiveConcurrency) {
+        concurrencyLimiter = std::make_shared<AdaptiveConcurrencyLimiter>(concurrencyLimitOptions(config));
+    }
+    if (config.spreadAcrossAddresses) {
+        resolver = std::make_shared<HostResolver>(
+            std::chrono::seconds(config.dnsCacheTimeout >= 0 ? config.dnsCacheTimeout : 24 * 3600));
+    }
+    if (config.enableLogging) {
+        logger = std::make_shared<detail::RequestLogger>(config.logBufferCapacity, config.logSink);
+    }
+    if (!config.endpoints.empty()) {
+        balancer = std::make_shared<LoadBalancer>(config.endpoints, loadBalancerOptions(config));
+        balancer->startHealthChecks([config](const std::string& baseUrl) {
+            return probeEndpoint(config, baseUrl);
+        });
+    }
+    initializeCurl(config);
 }
 
 HttpClient::~HttpClient() {
-    curl_global_cleanup();
+    // 先停止异步引擎，让在途请求在其余成员仍然有效时完成回调
+    asyncEngine.reset();
+    cleanupCurl();
 }
 
 HttpClient::HttpClient(HttpClient&& other) noexcept 
-    : config(std::move(other.config)), authProvider(std::move(other.authProvider)) {
+    : state(std::atomic_load(&other.state)),
+      runtime(std::move(other.runtime)), connectionPool(std::move(other.connectionPool)),
+      retryBudget(std::move(other.retryBudget)), hedgeBudget(std::move(other.hedgeBudget)),
+      metrics(std::move(other.metrics)),
+      conditionalCache(std::atomic_load(&other.conditionalCache)),
+      circuitBreakers(std::move(other.circuitBreakers)), concurrencyLimiter(std::move(other.concurrencyLimiter)),
+      resolver(std::move(other.resolver)), balancer(std::move(other.balancer)),
+      logger(std::atomic_load(&other.logger)) {
+    std::lock_guard<std::mutex> lock(other.engineMutex);
+    asyncEngine = std::move(other.asyncEngine);
 }
 
 HttpClient& HttpClient::operator=(HttpClient&& other) noexcept {
     if (this != &other) {
-        config = std::move(other.config);
-        authProvider = std::move(other.authProvider);
+        asyncEngine.reset();
+        cleanupCurl();
+        std::atomic_store(&state, std::atomic_load(&other.state));
+        runtime = std::move(other.runtime);
+        connectionPool = std::move(other.connectionPool);
+        retryBudget = std::move(other.retryBudget);
+        hedgeBudget = std::move(other.hedgeBudget);
+        metrics = std::move(other.metrics);
+        std::atomic_store(&conditionalCache, std::atomic_load(&other.conditionalCache));
+        circuitBreakers = std::move(other.circuitBreakers);
+        concurrencyLimiter = std::move(other.concurrencyLimiter);
+        resolver = std::move(other.resolver);
+        std::atomic_store(&logger, std::atomic_load(&other.logger));
+        balancer = std::move(other.balancer);
+        std::lock_guard<std::mutex> lock(other.engineMutex);
+        asyncEngine = std::move(other.asyncEngine);
     }
     return *this;
 }
 
+void HttpClient::initializeCurl(const ClientConfig& config) {
+    size_t poolSize = config.connectionPoolSize > 0 ? static_cast<size_t>(config.connectionPoolSize) : 1;
+    connectionPool = std::make_unique<ConnectionPool>(poolSize, runtime);
+}
+
+void HttpClient::cleanupCurl() {
+    connectionPool.reset();
+}
+
+// CURLOPT_SSL_CTX_FUNCTION回调：为新建的TLS连接安装共享的证书存储（增加引用计数，不转移所有权）
+static CURLcode InstallCertificateStore(CURL* /*curl*/, void* sslContext, void* store) {
+    SSL_CTX_set1_cert_store(static_cast<SSL_CTX*>(sslContext), static_cast<X509_STORE*>(store));
+    return CURLE_OK;
+}
+
+void HttpClient::setCommonOptions(void* handle, const ClientConfig& config) const {
+    CURL* curl = static_cast<CURL*>(handle);
+    // 多线程环境下禁用信号，避免DNS超时通过SIGALRM实现
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl, CURLOPT_DNS_CACHE_TIMEOUT, static_cast<long>(config.dnsCacheTimeout));
+    curl_easy_setopt(curl, CURLOPT_HAPPY_EYEBALLS_TIMEOUT_MS, static_cast<long>(config.happyEyeballsTimeoutMs));
+    // 总超时按请求在prepareTransfer中设置
+    if (config.connectTimeout > 0) {
+        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, static_cast<long>(config.connectTimeout));
+    }
+    // 总是设置，池中句柄不保留上一个请求的低速检测；0表示不检查
+    curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, static_cast<long>(std::max(1, config.lowSpeedLimit)));
+    curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, static_cast<long>(std::max(0, config.lowSpeedTime)));
+    if (!config.userAgent.empty()) {
+        curl_easy_setopt(curl, CURLOPT_USERAGENT, config.userAgent.c_str());
+    }
+    
+    if (!config.verifySSL) {
+        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
+        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
+    } else if (void* store = runtime->getCertificateStore(config.caBundlePath)) {
+        // 使用进程内共享的已解析证书，libcurl不再为每次握手读取证书包
+        curl_easy_setopt(curl, CURLOPT_CAINFO, nullptr);
+        curl_easy_setopt(curl, CURLOPT_CAPATH, nullptr);
+        curl_easy_setopt(curl, CURLOPT_SSL_CTX_FUNCTION, InstallCertificateStore);
+        curl_easy_setopt(curl, CURLOPT_SSL_CTX_DATA, store);
+    } else if (!config.caBundlePath.empty()) {
+        curl_easy_setopt(curl, CURLOPT_CAINFO, config.caBundlePath.c_str());
+    }
+    curl_easy_setopt(curl, CURLOPT_SSL_SESSIONID_CACHE, config.enableTlsSessionCache ? 1L : 0L);
+    if (!config.proxyUrl.empty()) {
+        curl_easy_setopt(curl, CURLOPT_PROXY, config.proxyUrl.c_str());
+    }
+    // 池中句柄跨配置更新复用，未配置时显式清除
+    curl_easy_setopt(curl, CURLOPT_UNIX_SOCKET_PATH,
+                     config.unixSocketPath.empty() ? nullptr : config.unixSocketPath.c_str());
+    // 空字符串表示声明libcurl支持的全部编码
+    curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, config.acceptCompressedResponses ? "" : nullptr);
+    
+    if (useHttp2(config)) {
+        // HTTPS上通过ALPN协商HTTP/2，失败时保持HTTP/1.1；明文HTTP直接使用HTTP/1.1
+        curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+        // 优先等待可多路复用的现有连接，而不是新建连接
+        curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+    } else {
+        curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_1_1);
+    }
+}
+
+bool HttpClient::useHttp2(const ClientConfig& config) const {
+    return config.enableHttp2 && runtime->supportsHttp2();
+}
+
+AsyncEngine::Limits HttpClient::engineLimits(const ClientConfig& config) const {
+    AsyncEngine::Limits limits;
+    limits.maxConnections = config.connectionPoolSize > 0 ? static_cast<size_t>(config.connectionPoolSize) : 1;
+    limits.multiplex = useHttp2(config);
+    limits.maxConcurrentStreams = config.maxConcurrentStreams;
+    return limits;
+}
+
 HttpResponse HttpClient::get(const std::string& endpoint, const Parameters& params, const Headers& headers) {
     HttpRequestConfig config;
     config.method = HttpMethod::GET;
@@ -114,50 +682,711 @@ HttpResponse HttpClient::patch(const std::string& endpoint, const Json& data, co
     return request(config);
 }
 
+/**
+ * 构建带请求体的请求，请求体和头部移入请求配置
+ */
+static HttpRequestConfig bodyRequest(HttpMethod method, const std::string& endpoint, RequestBody&& body, Headers&& headers) {
+    HttpRequestConfig config;
+    config.method = method;
+    config.url = endpoint;
+    config.headers = std::move(headers);
+    std::move(body).applyTo(config);
+    return config;
+}
+
+HttpResponse HttpClient::get(const std::string& endpoint, Parameters&& params, Headers headers) {
+    HttpRequestConfig config;
+    config.method = HttpMethod::GET;
+    config.url = endpoint;
+    config.params = std::move(params);
+    config.headers = std::move(headers);
+    return request(config);
+}
+
+HttpResponse HttpClient::post(const std::string& endpoint, Json&& data, Headers headers) {
+    return request(bodyRequest(HttpMethod::POST, endpoint, RequestBody(std::move(data)), std::move(headers)));
+}
+
+HttpResponse HttpClient::post(const std::string& endpoint, RequestBody body, Headers headers) {
+    return request(bodyRequest(HttpMethod::POST, endpoint, std::move(body), std::move(headers)));
+}
+
+HttpResponse HttpClient::put(const std::string& endpoint, Json&& data, Headers headers) {
+    return request(bodyRequest(HttpMethod::PUT, endpoint, RequestBody(std::move(data)), std::move(headers)));
+}
+
+HttpResponse HttpClient::put(const std::string& endpoint, RequestBody body, Headers headers) {
+    return request(bodyRequest(HttpMethod::PUT, endpoint, std::move(body), std::move(headers)));
+}
+
+HttpResponse HttpClient::patch(const std::string& endpoint, Json&& data, Headers headers) {
+    return request(bodyRequest(HttpMethod::PATCH, endpoint, RequestBody(std::move(data)), std::move(headers)));
+}
+
+HttpResponse HttpClient::patch(const std::string& endpoint, RequestBody body, Headers headers) {
+    return request(bodyRequest(HttpMethod::PATCH, endpoint, std::move(body), std::move(headers)));
+}
+
 HttpResponse HttpClient::request(const HttpRequestConfig& requestConfig) {
+    return executeWithRetry(requestConfig);
+}
+
+HttpResponse HttpClient::request(const HttpRequestConfig& requestConfig, BodySink sink) {
+    return executeWithRetry(requestConfig, &sink);
+}
+
+HttpResponse HttpClient::request(const HttpRequestConfig& requestConfig, BodySink sink, StreamStart onStart) {
+    return executeWithRetry(requestConfig, &sink, onStart ? &onStart : nullptr);
+}
+
+HttpResponse HttpClient::request(const HttpRequestConfig& requestConfig, std::ostream& out) {
+    return request(requestConfig, [&out](const char* data, size_t size) {
+        out.write(data, static_cast<std::streamsize>(size));
+        return static_cast<bool>(out);
+    });
+}
+
+HttpResponse HttpClient::executeWithRetry(const HttpRequestConfig& requestConfig,
+                                          const BodySink* sink,
+                                          const StreamStart* onStart) {
+    auto current = snapshot();
+    const ClientConfig& config = current->config;
+    RetryPolicy policy = RetryPolicy::fromConfig(config);
+    std::chrono::milliseconds maxDelay(policy.getSettings().maxDelayMs);
+    std::chrono::milliseconds delay(0);
+    retryBudget->recordRequest();
+    
+    // 只对冲无副作用且结果不流式交付的请求；调用方自带取消标志时不对冲
+    bool hedged = config.enableHedging && !sink && !requestConfig.cancel &&
+        (requestConfig.method == HttpMethod::GET || requestConfig.method == HttpMethod::HEAD) &&
+        RetryPolicy::isIdempotent(requestConfig);
+    if (hedged) {
+        hedgeBudget->recordRequest();
+    }
+    
+    // 数据一旦交给sink就无法撤回，此后的失败不再重试
+    bool delivered = false;
+    BodySink trackedSink;
+    if (sink) {
+        trackedSink = [sink, &delivered](const char* data, size_t size) {
+            delivered = true;
+            return (*sink)(data, size);
+        };
+    }
+    
+    // 401后以更新的认证信息重放一次，不计入重试次数
+    bool replayed = false;
+    
+    // 已使用过的端点，重试时换到其他端点
+    uint64_t tried = 0;
+    
+    // 计算下一次退避时间；退避结束时已超过截止时间则返回false，不再重试
+    auto backoff = [&](std::optional<std::chrono::milliseconds> retryAfter) {
+        delay = policy.nextDelay(delay);
+        if (retryAfter) {
+            delay = std::max(delay, *retryAfter);
+        }
+        return !requestConfig.deadline || std::chrono::steady_clock::now() + delay < *requestConfig.deadline;
+    };
+    
+    int maxRetries = requestConfig.maxRetries ? std::max(0, *requestConfig.maxRetries) : policy.getMaxRetries();
+    for (int attempt = 0; ; ++attempt) {
+        bool attemptsLeft = attempt < maxRetries;
+        if (isCancelled(requestConfig)) {
+            throw error::DataApiError("Request cancelled", "REQUEST_CANCELLED");
+        }
+        if (requestConfig.deadline && std::chrono::steady_clock::now() >= *requestConfig.deadline) {
+            throw error::TimeoutError("Request deadline exceeded before the request was sent", 0);
+        }
+        auto authProvider = snapshot()->authProvider;
+        uint64_t revision = authProvider ? authProvider->getRevision() : 0;
+        
+        // 熔断或并发限制拒绝时直接抛出，不进入重试
+        detail::Admission admission(circuitBreakers, concurrencyLimiter, requestConfig.url, sink != nullptr);
+        try {
+            HttpResponse response;
+            std::chrono::microseconds hedgeDelay(0);
+            if (hedged && metrics->total.getCount() >= kHedgeMinSamples) {
+                double millis = std::max<double>(config.hedgeMinDelayMs, metrics->total.getPercentile(config.hedgePercentile));
+                hedgeDelay = std::chrono::microseconds(static_cast<int64_t>(millis * 1000));
+            }
+            if (hedgeDelay.count() > 0) {
+                response = executeHedged(requestConfig, hedgeDelay, &tried);
+            } else {
+                response = executeRequest(requestConfig, sink ? &trackedSink : nullptr, onStart, &tried);
+            }
+            admission.complete(response.statusCode);
+            if (response.statusCode == 401 && !replayed && authProvider &&
+                authProvider->refreshAfterRejection(revision)) {
+                replayed = true;
+                --attempt;
+                continue;
+            }
+            if (!attemptsLeft || !policy.shouldRetryStatus(requestConfig, response.statusCode)) {
+                return response;
+            }
+            std::optional<std::chrono::milliseconds> retryAfter;
+            if (auto value = response.headers.get("Retry-After")) {
+                retryAfter = RetryPolicy::parseRetryAfter(std::string(*value));
+            }
+            // 服务端要求的等待超出上限、截止时间不够退避，或预算耗尽时，直接返回最后一次响应
+            if ((retryAfter && *retryAfter > maxDelay) || !backoff(retryAfter) || !retryBudget->tryAcquire()) {
+                return response;
+            }
+        } catch (const error::DataApiError& e) {
+            admission.complete(e, delivered);
+            if (delivered || !attemptsLeft || !policy.shouldRetryError(requestConfig, e) ||
+                !backoff(std::nullopt) || !retryBudget->tryAcquire()) {
+                throw;
+            }
+        }
+        
+        waitBeforeRetry(requestConfig, delay);
+    }
+}
+
+HttpResponse HttpClient::executeHedged(const HttpRequestConfig& requestConfig, std::chrono::microseconds delay,
+                                       uint64_t* tried) {
+    // 两个副本共享的结果，回调可能晚于本函数返回，由副本共同持有
+    struct Race {
+        std::mutex mutex;
+        std::condition_variable settled;
+        int pending = 0;
+        bool done = false;
+        HttpResponse response;
+        std::exception_ptr error;
+        std::vector<std::shared_ptr<std::atomic<bool>>> cancels;
+    };
+    auto race = std::make_shared<Race>();
+    
+    auto launch = [&] {
+        HttpRequestConfig copy = requestConfig;
+        auto cancel = std::make_shared<std::atomic<bool>>(false);
+        copy.cancel = cancel;
+        {
+            std::lock_guard<std::mutex> lock(race->mutex);
+            race->cancels.push_back(cancel);
+            ++race->pending;
+        }
+        try {
+            submitAsync(copy, [race](HttpResponse response, std::exception_ptr error) {
+                std::lock_guard<std::mutex> lock(race->mutex);
+                --race->pending;
+                // 先到的响应胜出；失败时若另一个副本仍在途则等待它
+                if (race->done || (error && race->pending > 0)) {
+                    return;
+                }
+                race->done = true;
+                race->response = std::move(response);
+                race->error = error;
+                for (auto& flag : race->cancels) {
+                    flag->store(true);
+                }
+                race->settled.notify_all();
+            }, nullptr, nullptr, tried); // 副本避开先发出的请求所用的端点
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(race->mutex);
+            --race->pending;
+            throw;
+        }
+    };
+    
+    launch();
+    std::unique_lock<std::mutex> lock(race->mutex);
+    if (!race->settled.wait_for(lock, delay, [&] { return race->done; })) {
+        lock.unlock();
+        if (hedgeBudget->tryAcquire()) {
+            try {
+                launch();
+            } catch (const std::exception&) {
+                // 副本未能发出时继续等待原请求
+            }
+        }
+        lock.lock();
+        race->settled.wait(lock, [&] { return race->done; });
+    }
+    if (race->error) {
+        std::rethrow_exception(race->error);
+    }
+    return std::move(race->response);
+}
+
+HttpResponse HttpClient::upload(const HttpRequestConfig& requestConfig, UploadBody body, UploadProgress onProgress) {
+    if (!body.source) {
+        throw std::invalid_argument("Upload body has no source");
+    }
+    retryBudget->recordRequest();
+    detail::Admission admission(circuitBreakers, concurrencyLimiter, requestConfig.url, true);
+    
+    if (auto current = snapshot(); current->config.transport) {
+        // 可替换传输层不支持流式请求体，先读入内存
+        HttpRequestConfig buffered = requestConfig;
+        buffered.data = nullptr;
+        buffered.body.clear();
+        char chunk[64 * 1024];
+        while (size_t count = body.source(chunk, sizeof(chunk))) {
+            if (count > sizeof(chunk)) {
+                throw std::length_error("Upload source returned more data than requested");
+            }
+            buffered.body.append(chunk, count);
+        }
+        try {
+            HttpResponse response = executeTransport(current, buffered, nullptr, nullptr, nullptr);
+            admission.complete(response.statusCode);
+            return response;
+        } catch (const std::exception& e) {
+            admission.complete(e);
+            throw;
+        }
+    }
+    
+    auto lease = connectionPool->acquire();
+    detail::RequestArena::Scope arena;
+    detail::Transfer transfer(static_cast<CURL*>(lease.get()), false, detail::RequestArena::current());
+    transfer.slot = lease.getSlot();
+    transfer.upload = true;
+    transfer.uploadLength = body.length;
+    transfer.bodyReader = [&transfer, &source = body.source](char* buffer, size_t size) {
+        size_t count = source(buffer, size);
+        if (count > size) {
+            throw std::length_error("Upload source returned more data than requested");
+        }
+        transfer.uploadedBytes += count;
+        return count;
+    };
+    if (onProgress) {
+        transfer.onProgress = &onProgress;
+    }
+    prepareTransfer(transfer, requestConfig);
+    // 流式请求体不保留，日志只记录URL、头部和响应
+    transfer.log = beginLog(transfer.state, requestConfig, transfer.url, {});
+    
+    CURLcode res = curl_easy_perform(transfer.curl);
+    recordTransfer(*metrics, transfer, res);
+    try {
+        HttpResponse response = finishTransfer(transfer, res);
+        admission.complete(response.statusCode);
+        detail::RequestLogger::complete(std::move(transfer.log), &response, nullptr);
+        return response;
+    } catch (const std::exception& e) {
+        admission.complete(e);
+        detail::RequestLogger::complete(std::move(transfer.log), nullptr, std::current_exception());
+        throw;
+    }
+}
+
+HttpResponse HttpClient::executeRequest(const HttpRequestConfig& requestConfig,
+                                        const BodySink* sink,
+                                        const StreamStart* onStart,
+                                        uint64_t* tried) {
+    if (auto current = snapshot(); current->config.transport) {
+        return executeTransport(current, requestConfig, sink, onStart, tried);
+    }
+    // 从池中租用句柄，作用域结束时归还，保留其连接以供后续请求复用
+    auto lease = connectionPool->acquire();
+    // 本次传输的临时对象分配在线程内缓冲区中，传输结束后整体释放
+    detail::RequestArena::Scope arena;
+    detail::Transfer transfer(static_cast<CURL*>(lease.get()), false, detail::RequestArena::current());
+    transfer.slot = lease.getSlot();
+    transfer.sink = sink;
+    transfer.onStart = onStart;
+    transfer.avoidEndpoints = tried ? *tried : 0;
+    prepareTransfer(transfer, requestConfig);
+    markTried(tried, transfer.endpointLease);
+    transfer.log = beginLog(transfer.state, requestConfig, transfer.url,
+                            transfer.payload ? std::string_view(*transfer.payload) : std::string_view());
+    
+    // 执行请求
+    CURLcode res = curl_easy_perform(transfer.curl);
+    recordTransfer(*metrics, transfer, res);
+    if (!transfer.log) {
+        return finishTransfer(transfer, res);
+    }
+    try {
+        HttpResponse response = finishTransfer(transfer, res);
+        detail::RequestLogger::complete(std::move(transfer.log), &response, nullptr);
+        return response;
+    } catch (...) {
+        detail::RequestLogger::complete(std::move(transfer.log), nullptr, std::current_exception());
+        throw;
+    }
+}
+
+std::future<HttpResponse> HttpClient::requestAsync(const HttpRequestConfig& requestConfig) {
+    auto promise = std::make_shared<std::promise<HttpResponse>>();
+    auto future = promise->get_future();
+    requestAsync(requestConfig, [promise](HttpResponse response, std::exception_ptr error) {
+        if (error) {
+            promise->set_exception(error);
+        } else {
+            promise->set_value(std::move(response));
+        }
+    });
+    return future;
+}
+
+void HttpClient::requestAsync(const HttpRequestConfig& requestConfig, ResponseCallback callback) {
+    submitAsync(requestConfig, std::move(callback),
+                std::make_shared<detail::Admission>(circuitBreakers, concurrencyLimiter, requestConfig.url, false));
+}
+
+std::future<HttpResponse> HttpClient::requestAsync(HttpRequestConfig&& requestConfig) {
+    auto promise = std::make_shared<std::promise<HttpResponse>>();
+    auto future = promise->get_future();
+    requestAsync(std::move(requestConfig), [promise](HttpResponse response, std::exception_ptr error) {
+        if (error) {
+            promise->set_exception(error);
+        } else {
+            promise->set_value(std::move(response));
+        }
+    });
+    return future;
+}
+
+void HttpClient::requestAsync(HttpRequestConfig&& requestConfig, ResponseCallback callback) {
+    submitAsync(requestConfig, std::move(callback),
+                std::make_shared<detail::Admission>(circuitBreakers, concurrencyLimiter, requestConfig.url, false),
+                &requestConfig.body);
+}
+
+void HttpClient::submitAsync(const HttpRequestConfig& requestConfig, ResponseCallback callback,
+                             std::shared_ptr<detail::Admission> admission, std::string* ownedBody,
+                             uint64_t* tried) {
+    if (auto current = snapshot(); current->config.transport) {
+        submitTransport(current, requestConfig, std::move(callback), std::move(admission), ownedBody, tried);
+        return;
+    }
+    // 异步请求使用独立句柄，连接由multi句柄的连接缓存复用
     CURL* curl = curl_easy_init();
     if (!curl) {
         throw std::runtime_error("Failed to initialize CURL");
     }
+    curl_easy_setopt(curl, CURLOPT_SHARE, static_cast<CURLSH*>(runtime->getShareHandle()));
+    auto transfer = std::make_shared<detail::Transfer>(curl, true);
+    if (resolver) {
+        transfer->slot = resolver->nextSlot();
+    }
+    transfer->avoidEndpoints = tried ? *tried : 0;
+    prepareTransfer(*transfer, requestConfig);
+    markTried(tried, transfer->endpointLease);
+    if (transfer->payload == &requestConfig.body) {
+        // 异步传输在调用返回后继续执行，持有请求体；调用方移交了请求配置时直接取走
+        if (ownedBody == &requestConfig.body) {
+            transfer->body = std::move(*ownedBody);
+        } else {
+            transfer->body = requestConfig.body;
+        }
+        transfer->payload = &transfer->body;
+        if (!transfer->bodyReader) {
+            setPayload(curl, transfer->body);
+        }
+    }
+    transfer->log = beginLog(transfer->state, requestConfig, transfer->url,
+                             transfer->payload ? std::string_view(*transfer->payload) : std::string_view());
     
+    getAsyncEngine().submit(curl, [transfer, admission, metrics = metrics, callback = std::move(callback)](int code) {
+        HttpResponse response;
+        std::exception_ptr error;
+        try {
+            recordTransfer(*metrics, *transfer, code);
+            response = finishTransfer(*transfer, static_cast<CURLcode>(code));
+            if (admission) {
+                admission->complete(response.statusCode);
+            }
+        } catch (...) {
+            error = std::current_exception();
+            if (admission) {
+                admission->complete(error);
+            }
+        }
+        detail::RequestLogger::complete(std::move(transfer->log), error ? nullptr : &response, error);
+        callback(std::move(response), error);
+    });
+}
+
+TransportRequest HttpClient::transportRequest(const std::shared_ptr<const detail::ClientState>& current,
+                                             const HttpRequestConfig& requestConfig, std::string_view baseUrl,
+                                             std::string& storage, bool retain, std::string* ownedBody) const {
+    const ClientConfig& config = current->config;
+    TransportRequest request;
+    request.method = requestConfig.method;
+    request.url.reserve(baseUrl.size() + requestConfig.url.size());
+    request.url.assign(baseUrl).append(requestConfig.url);
+    if (!requestConfig.params.empty()) {
+        request.url += requestConfig.url.find('?') == std::string::npos ? '?' : '&';
+        utils::UrlUtils::appendQueryString(request.url, requestConfig.params);
+    }
+    request.timeoutMs = attemptTimeout(config, requestConfig);
+    
+    // 请求体以视图传给传输层；异步请求在调用返回后仍需要，保存在storage中
+    if (!requestConfig.body.empty()) {
+        if (ownedBody == &requestConfig.body) {
+            storage = std::move(*ownedBody);
+            request.body = storage;
+        } else if (retain) {
+            storage = requestConfig.body;
+            request.body = storage;
+        } else {
+            request.body = requestConfig.body;
+        }
+    } else if (!requestConfig.data.is_null()) {
+        serializeJson(requestConfig.data, storage);
+        request.body = storage;
+    }
+    
+    // 客户端级头部取自头部缓存，被请求级头部覆盖的跳过
+    auto block = getHeaderBlock(current);
+    bool hasContentType = false;
+    request.headers.reserve(block->fields.size() + requestConfig.headers.size() + 1);
+    for (const auto& field : block->fields) {
+        bool overridden = std::any_of(requestConfig.headers.begin(), requestConfig.headers.end(), [&](const auto& header) {
+            return strcasecmp(header.first.c_str(), field.first.c_str()) == 0;
+        });
+        if (!overridden) {
+            hasContentType = hasContentType || strcasecmp(field.first.c_str(), "Content-Type") == 0;
+            request.headers.push_back(field);
+        }
+    }
+    for (const auto& header : requestConfig.headers) {
+        hasContentType = hasContentType || strcasecmp(header.first.c_str(), "Content-Type") == 0;
+        request.headers.emplace_back(header.first, header.second);
+    }
+    if (!request.body.empty() && !hasContentType) {
+        request.headers.emplace_back("Content-Type", "application/json");
+    }
+    if (const char* accept = binaryAccept(config, requestConfig)) {
+        request.headers.emplace_back("Accept", accept);
+    }
+    return request;
+}
+
+/**
+ * 经可替换传输层完成的请求的指标事件，耗时只有总耗时
+ */
+static void recordTransport(RequestMetrics& metrics, RequestEvent& event,
+                            std::chrono::steady_clock::time_point start, size_t uploaded,
+                            const HttpResponse* response) {
+    event.transportError = response == nullptr;
+    event.statusCode = response ? response->statusCode : 0;
+    event.stats.totalTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    event.stats.startTransferTime = event.stats.totalTime;
+    event.stats.downloadSize = response ? static_cast<long>(response->body.size()) : 0;
+    event.stats.uploadSize = static_cast<long>(uploaded);
+    metrics.record(event);
+}
+
+static void injectTraceHeaders(TransportRequest& request, const TraceContext& context) {
+    request.headers.emplace_back("traceparent", context.traceparent());
+    if (!context.traceState.empty()) {
+        request.headers.emplace_back("tracestate", context.traceState);
+    }
+}
+
+static RequestEvent transportEvent(const HttpRequestConfig& requestConfig) {
+    RequestEvent event;
+    event.method = requestConfig.method;
+    event.endpoint = requestConfig.endpointTemplate.empty()
+        ? RequestMetrics::normalizeEndpoint(requestConfig.url)
+        : requestConfig.endpointTemplate;
+    return event;
+}
+
+HttpResponse HttpClient::executeTransport(const std::shared_ptr<const detail::ClientState>& current,
+                                          const HttpRequestConfig& requestConfig,
+                                          const BodySink* sink,
+                                          const StreamStart* onStart,
+                                          uint64_t* tried) {
+    LoadBalancer::Lease lease = balancer ? balancer->acquire(tried ? *tried : 0) : LoadBalancer::Lease();
+    markTried(tried, lease);
+    std::string storage;
+    TransportRequest request = transportRequest(current, requestConfig, lease ? lease.getBaseUrl() : current->config.baseUrl,
+                                                storage, false, nullptr);
+    RequestEvent event = transportEvent(requestConfig);
+    auto span = startSpan(current->config, requestConfig, request.url, event.endpoint);
+    if (span) {
+        injectTraceHeaders(request, span->context);
+    }
+    auto log = beginLog(current, requestConfig, request.url, request.body);
+    auto start = std::chrono::steady_clock::now();
     HttpResponse response;
-    std::string responseBody;
-    Headers responseHeaders;
+    try {
+        response = current->config.transport->send(request);
+    } catch (...) {
+        recordTransport(*metrics, event, start, request.body.size(), nullptr);
+        completeLease(lease, event);
+        finishSpan(span.get(), current->config, event, describe(std::current_exception()));
+        detail::RequestLogger::complete(std::move(log), nullptr, std::current_exception());
+        throw;
+    }
+    recordTransport(*metrics, event, start, request.body.size(), &response);
+    completeLease(lease, event);
+    finishSpan(span.get(), current->config, event, {});
+    detail::RequestLogger::complete(std::move(log), &response, nullptr);
+    
+    // 成功响应整体交给sink，与内置传输的流式语义一致：response.body为空
+    if (sink && response.isSuccess()) {
+        if (onStart) {
+            (*onStart)(response.statusCode, response.headers);
+        }
+        if (!response.body.empty() && !(*sink)(response.body.data(), response.body.size())) {
+            throw error::SinkAbortedError();
+        }
+        response.body.clear();
+    }
+    return response;
+}
+
+void HttpClient::submitTransport(const std::shared_ptr<const detail::ClientState>& current,
+                                 const HttpRequestConfig& requestConfig, ResponseCallback callback,
+                                 std::shared_ptr<detail::Admission> admission, std::string* ownedBody,
+                                 uint64_t* tried) {
+    // 请求及其请求体在回调执行前保持有效
+    struct Pending {
+        std::shared_ptr<const detail::ClientState> state;
+        std::string storage;
+        TransportRequest request;
+        RequestEvent event;
+        std::chrono::steady_clock::time_point start;
+        std::unique_ptr<detail::LogRecord> log;
+        std::unique_ptr<TraceSpan> span;
+        LoadBalancer::Lease lease;
+    };
+    auto pending = std::make_shared<Pending>();
+    pending->state = current;
+    if (balancer) {
+        pending->lease = balancer->acquire(tried ? *tried : 0);
+        markTried(tried, pending->lease);
+    }
+    pending->request = transportRequest(current, requestConfig,
+                                        pending->lease ? pending->lease.getBaseUrl() : current->config.baseUrl,
+                                        pending->storage, true, ownedBody);
+    pending->event = transportEvent(requestConfig);
+    pending->span = startSpan(current->config, requestConfig, pending->request.url, pending->event.endpoint);
+    if (pending->span) {
+        injectTraceHeaders(pending->request, pending->span->context);
+    }
+    pending->log = beginLog(current, requestConfig, pending->request.url, pending->request.body);
+    pending->start = std::chrono::steady_clock::now();
+    
+    const TransportRequest& request = pending->request;
+    current->config.transport->sendAsync(request,
+        [pending, admission, metrics = metrics, callback = std::move(callback)](HttpResponse response, std::exception_ptr error) {
+            recordTransport(*metrics, pending->event, pending->start, pending->request.body.size(), error ? nullptr : &response);
+            completeLease(pending->lease, pending->event);
+            finishSpan(pending->span.get(), pending->state->config, pending->event, error ? describe(error) : std::string());
+            detail::RequestLogger::complete(std::move(pending->log), error ? nullptr : &response, error);
+            if (admission) {
+                if (error) {
+                    admission->complete(error);
+                } else {
+                    admission->complete(response.statusCode);
+                }
+            }
+            callback(std::move(response), error);
+        });
+}
+
+AsyncEngine& HttpClient::getAsyncEngine() {
+    std::lock_guard<std::mutex> lock(engineMutex);
+    if (!asyncEngine) {
+        asyncEngine = std::make_unique<AsyncEngine>(runtime, engineLimits(snapshot()->config));
+    }
+    return *asyncEngine;
+}
+
+/**
+ * 取基础URL中的主机名；IP字面量或解析失败时返回空字符串，此类地址无需分散
+ */
+static std::string serviceHost(const std::string& baseUrl) {
+    std::string host;
+    CURLU* url = curl_url();
+    char* part = nullptr;
+    if (url && curl_url_set(url, CURLUPART_URL, baseUrl.c_str(), 0) == CURLUE_OK &&
+        curl_url_get(url, CURLUPART_HOST, &part, 0) == CURLUE_OK) {
+        host = part;
+        curl_free(part);
+    }
+    curl_url_cleanup(url);
+    unsigned char address[sizeof(in6_addr)];
+    if (host.empty() || host.front() == '[' || inet_pton(AF_INET, host.c_str(), address) == 1) {
+        return {};
+    }
+    return host;
+}
+
+void HttpClient::prepareTransfer(detail::Transfer& transfer, const HttpRequestConfig& requestConfig) const {
+    CURL* curl = transfer.curl;
+    transfer.state = snapshot();
+    const ClientConfig& config = transfer.state->config;
     
-    // 构建完整URL
-    std::string url = config.baseUrl + requestConfig.url;
+    // 配置了多端点时为本次传输选择端点
+    if (balancer) {
+        transfer.endpointLease = balancer->acquire(transfer.avoidEndpoints);
+    }
+    const std::string& baseUrl = transfer.endpointLease ? transfer.endpointLease.getBaseUrl() : config.baseUrl;
+    
+    // 构建完整URL，查询参数编码后直接追加在同一缓冲区中
+    transfer.url.reserve(baseUrl.size() + requestConfig.url.size());
+    transfer.url.assign(baseUrl).append(requestConfig.url);
+    if (!requestConfig.params.empty()) {
+        transfer.url += requestConfig.url.find('?') == std::string::npos ? '?' : '&';
+        utils::UrlUtils::appendQueryString(transfer.url, requestConfig.params);
+    }
+    transfer.method = requestConfig.method;
+    transfer.endpoint = requestConfig.endpointTemplate.empty()
+        ? RequestMetrics::normalizeEndpoint(requestConfig.url)
+        : requestConfig.endpointTemplate;
+    transfer.timeoutMs = attemptTimeout(config, requestConfig);
     
     // 设置基本选项
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_URL, transfer.url.c_str());
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBody);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &transfer);
     curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, HeaderCallback);
-    curl_easy_setopt(curl, CURLOPT_HEADERDATA, &responseHeaders);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, config.timeout / 1000);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, &transfer);
+    setCommonOptions(curl, config);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, static_cast<long>(transfer.timeoutMs));
+    if (requestConfig.lowSpeedTime > 0) {
+        curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, static_cast<long>(requestConfig.lowSpeedTime));
+    }
     
-    // 准备请求体
-    std::string body;
-    if (!requestConfig.data.is_null()) {
-        body = requestConfig.data.dump();
+    // 分散连接：按槽位把连接固定到一个解析出的地址，TLS校验和Host头部仍使用原域名
+    if (resolver && config.proxyUrl.empty() && config.unixSocketPath.empty()) {
+        transfer.host = serviceHost(baseUrl);
+        transfer.address = transfer.host.empty() ? std::string() : resolver->select(transfer.host, transfer.slot);
+        if (!transfer.address.empty()) {
+            transfer.resolver = resolver;
+            transfer.connectTo.reset(
+                curl_slist_append(nullptr, HostResolver::connectTo(transfer.host, transfer.address).c_str()));
+            curl_easy_setopt(curl, CURLOPT_CONNECT_TO, transfer.connectTo.get());
+        }
     }
     
+    // 准备请求体：data直接序列化到复用的缓冲区，curl不复制请求体
+    if (transfer.upload) {
+        // 上传的请求体由bodyReader按需提供
+    } else if (!requestConfig.body.empty()) {
+        transfer.payload = &requestConfig.body;
+    } else if (!requestConfig.data.is_null()) {
+        transfer.body.swap(detail::spareBodyBuffer());
+        transfer.body.clear();
+        serializeJson(requestConfig.data, transfer.body);
+        transfer.payload = &transfer.body;
+    }
+    const std::string& body = transfer.payload ? *transfer.payload : transfer.body;
+    
     // 设置HTTP方法
+    bool sendsBody = false;
     switch (requestConfig.method) {
         case HttpMethod::GET:
             break; // GET是默认方法
         case HttpMethod::POST:
             curl_easy_setopt(curl, CURLOPT_POST, 1L);
-            if (!body.empty()) {
-                curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.c_str());
-                curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, body.length());
-            }
+            sendsBody = true;
             break;
         case HttpMethod::PUT:
             curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PUT");
-            if (!body.empty()) {
-                curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.c_str());
-                curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, body.length());
-            }
+            sendsBody = true;
             break;
         case HttpMethod::DELETE:
             curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
@@ -167,101 +1396,436 @@ HttpResponse HttpClient::request(const HttpRequestConfig& requestConfig) {
             break;
         case HttpMethod::PATCH:
             curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PATCH");
-            if (!body.empty()) {
-                curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.c_str());
-                curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, body.length());
-            }
+            sendsBody = true;
             break;
     }
+    if (transfer.upload && !sendsBody) {
+        throw std::invalid_argument("Upload requires POST, PUT or PATCH");
+    }
+    // 长度未知的上传总是达到压缩阈值
+    bool largeBody = transfer.upload
+        ? transfer.uploadLength < 0 || static_cast<uint64_t>(transfer.uploadLength) >= config.requestCompressionThreshold
+        : body.size() >= config.requestCompressionThreshold;
+    bool compressBody = sendsBody && config.compressRequests && largeBody &&
+        !hasHeader(requestConfig.headers, "Content-Encoding");
+    if (compressBody) {
+        detail::GzipReader::Source source;
+        if (transfer.upload) {
+            source = std::move(transfer.bodyReader);
+        } else {
+            // 通过transfer.payload读取，异步路径替换请求体副本后仍然有效
+            source = [&transfer, offset = size_t(0)](char* buffer, size_t size) mutable {
+                size_t count = std::min(size, transfer.payload->size() - offset);
+                std::memcpy(buffer, transfer.payload->data() + offset, count);
+                offset += count;
+                return count;
+            };
+        }
+        auto gzip = std::make_shared<detail::GzipReader>(std::move(source));
+        transfer.bodyReader = [gzip](char* buffer, size_t size) {
+            return gzip->read(buffer, size);
+        };
+        setBodyReader(curl, transfer);
+    } else if (transfer.upload) {
+        setBodyReader(curl, transfer);
+        if (transfer.uploadLength >= 0) {
+            // 长度已知时发送Content-Length，不使用分块传输
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(transfer.uploadLength));
+        }
+    } else if (sendsBody) {
+        // 空请求体同样显式设置，否则curl从标准输入读取请求体
+        setPayload(curl, body);
+    }
+    transfer.cancel = requestConfig.cancel;
+    if (transfer.onProgress || transfer.cancel) {
+        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+        curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, ProgressCallback);
+        curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &transfer);
+    }
     
-    // 设置请求头
-    struct curl_slist* headerList = nullptr;
-    
-    // 添加认证头
-    if (authProvider) {
-        auto authHeaders = authProvider->getAuthHeaders();
-        for (const auto& header : authHeaders) {
-            std::string headerStr = header.first + ": " + header.second;
-            headerList = curl_slist_append(headerList, headerStr.c_str());
+    // 设置请求头：请求级头部单独分配，客户端级头部直接链接到缓存的共享链表
+    auto block = getHeaderBlock(transfer.state);
+    bool hasContentType = false;
+    bool overridesBlock = false;
+    for (const auto& header : requestConfig.headers) {
+        hasContentType = hasContentType || strcasecmp(header.first.c_str(), "Content-Type") == 0;
+        for (const auto& field : block->fields) {
+            overridesBlock = overridesBlock || strcasecmp(header.first.c_str(), field.first.c_str()) == 0;
         }
     }
+    bool jsonBody = !body.empty() && !hasContentType;
     
-    // 添加自定义头
+    curl_slist* headerList = nullptr;
+    std::pmr::string headerStr(transfer.url.get_allocator());
     for (const auto& header : requestConfig.headers) {
-        std::string headerStr = header.first + ": " + header.second;
+        headerStr.assign(header.first).append(": ").append(header.second);
+        headerList = curl_slist_append(headerList, headerStr.c_str());
+    }
+    if (compressBody) {
+        headerList = curl_slist_append(headerList, "Content-Encoding: gzip");
+    }
+    if (const char* accept = binaryAccept(config, requestConfig)) {
+        headerStr.assign("Accept: ").append(accept);
+        headerList = curl_slist_append(headerList, headerStr.c_str());
+    }
+    // 追踪头部每次传输不同，与请求级头部一起分配，客户端级头部的共享链表不变
+    transfer.span = startSpan(config, requestConfig, transfer.url, transfer.endpoint);
+    if (transfer.span) {
+        headerStr.assign("traceparent: ").append(transfer.span->context.traceparent());
         headerList = curl_slist_append(headerList, headerStr.c_str());
+        if (!transfer.span->context.traceState.empty()) {
+            headerStr.assign("tracestate: ").append(transfer.span->context.traceState);
+            headerList = curl_slist_append(headerList, headerStr.c_str());
+        }
+    }
+    if (transfer.bodyReader) {
+        // 流式请求体不等待100-continue
+        headerList = curl_slist_append(headerList, "Expect:");
     }
     
-    // 添加Content-Type头（如果有body）
-    if (!body.empty() && requestConfig.headers.find("Content-Type") == requestConfig.headers.end()) {
-        headerList = curl_slist_append(headerList, "Content-Type: application/json");
+    if (overridesBlock) {
+        // 请求级头部覆盖了客户端级头部，复制未被覆盖的部分
+        size_t index = 0;
+        for (curl_slist* node = block->headers.get(); node; node = node->next, ++index) {
+            bool overridden = requestConfig.headers.end() != std::find_if(
+                requestConfig.headers.begin(), requestConfig.headers.end(), [&](const auto& header) {
+                    return strcasecmp(header.first.c_str(), block->fields[index].first.c_str()) == 0;
+                });
+            if (!overridden) {
+                headerList = curl_slist_append(headerList, node->data);
+            }
+        }
+        if (jsonBody) {
+            headerList = curl_slist_append(headerList, "Content-Type: application/json");
+        }
+        transfer.headerList.reset(headerList);
+    } else {
+        curl_slist* shared = jsonBody ? block->jsonHeaders.get() : block->headers.get();
+        transfer.headerBlock = block;
+        transfer.headerList.reset(headerList);
+        if (headerList && shared) {
+            curl_slist* tail = headerList;
+            while (tail->next) {
+                tail = tail->next;
+            }
+            tail->next = shared;
+            transfer.headerTail = tail;
+        } else if (!headerList) {
+            headerList = shared;
+        }
     }
     
     if (headerList) {
         curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headerList);
     }
+}
+
+std::unique_ptr<detail::LogRecord> HttpClient::beginLog(const std::shared_ptr<const detail::ClientState>& current,
+                                                       const HttpRequestConfig& requestConfig,
+                                                       std::string_view url, std::string_view body) const {
+    if (!current->config.enableLogging) {
+        return nullptr;
+    }
+    auto active = std::atomic_load(&logger);
+    if (!active) {
+        return nullptr;
+    }
+    auto record = active->begin(current->config, requestConfig, url, body);
+    if (record) {
+        record->clientHeaders = getHeaderBlock(current);
+    }
+    return record;
+}
+
+void HttpClient::flushLogs() const {
+    if (auto active = std::atomic_load(&logger)) {
+        active->flush();
+    }
+}
+
+uint64_t HttpClient::getDroppedLogCount() const {
+    auto active = std::atomic_load(&logger);
+    return active ? active->getDropped() : 0;
+}
+
+std::shared_ptr<const detail::HeaderBlock> HttpClient::getHeaderBlock(
+    const std::shared_ptr<const detail::ClientState>& current) const {
+    const auto& authProvider = current->authProvider;
+    uint64_t revision = authProvider ? authProvider->getRevision() : 0;
+    auto cached = std::atomic_load(&headerBlock);
+    if (cached && cached->state == current && cached->revision == revision) {
+        return cached;
+    }
     
-    // 执行请求
-    CURLcode res = curl_easy_perform(curl);
+    // 缓存失效时串行重建，避免并发请求重复格式化
+    std::lock_guard<std::mutex> lock(headerMutex);
+    cached = std::atomic_load(&headerBlock);
+    if (cached && cached->state == current && cached->revision == revision) {
+        return cached;
+    }
+    
+    auto block = std::make_shared<detail::HeaderBlock>();
+    block->state = current;
+    block->revision = revision;
+    const ClientConfig& config = current->config;
+    
+    // 认证头部优先于同名的默认头部
+    std::vector<std::pair<std::string, std::string>> fields;
+    if (authProvider) {
+        for (const auto& header : authProvider->getAuthHeaders()) {
+            fields.emplace_back(header.first, header.second);
+        }
+    }
+    size_t authCount = fields.size();
+    for (const auto& header : config.defaultHeaders) {
+        bool shadowed = std::any_of(fields.begin(), fields.begin() + authCount, [&](const auto& field) {
+            return strcasecmp(field.first.c_str(), header.first.c_str()) == 0;
+        });
+        if (!shadowed) {
+            fields.emplace_back(header.first, header.second);
+        }
+    }
     
+    curl_slist* headers = nullptr;
+    curl_slist* jsonHeaders = nullptr;
+    bool hasContentType = false;
+    for (const auto& field : fields) {
+        std::string headerStr = field.first + ": " + field.second;
+        headers = curl_slist_append(headers, headerStr.c_str());
+        jsonHeaders = curl_slist_append(jsonHeaders, headerStr.c_str());
+        hasContentType = hasContentType || strcasecmp(field.first.c_str(), "Content-Type") == 0;
+    }
+    if (!hasContentType) {
+        jsonHeaders = curl_slist_append(jsonHeaders, "Content-Type: application/json");
+    }
+    block->headers.reset(headers);
+    block->jsonHeaders.reset(jsonHeaders);
+    block->fields = std::move(fields);
+    block->authCount = authCount;
+    
+    std::shared_ptr<const detail::HeaderBlock> result = std::move(block);
+    std::atomic_store(&headerBlock, result);
+    return result;
+}
+
+HttpResponse HttpClient::finishTransfer(detail::Transfer& transfer, int curlCode) {
+    CURLcode res = static_cast<CURLcode>(curlCode);
+    if (transfer.cancelled) {
+        throw error::DataApiError("Request cancelled", "REQUEST_CANCELLED");
+    }
+    if (transfer.sinkError) {
+        std::rethrow_exception(transfer.sinkError);
+    }
+    if (transfer.readError) {
+        std::rethrow_exception(transfer.readError);
+    }
+    if (res == CURLE_WRITE_ERROR && transfer.sinkMode == detail::Transfer::SinkMode::Stream) {
+        throw error::SinkAbortedError();
+    }
     if (res != CURLE_OK) {
-        curl_slist_free_all(headerList);
-        curl_easy_cleanup(curl);
-        throw std::runtime_error("CURL request failed: " + std::string(curl_easy_strerror(res)));
+        std::string message = "CURL request failed: " + std::string(curl_easy_strerror(res));
+        switch (res) {
+            case CURLE_OPERATION_TIMEDOUT:
+                throw error::TimeoutError(message, transfer.timeoutMs);
+            case CURLE_COULDNT_CONNECT:
+                if (transfer.resolver) {
+                    // 暂时跳过该地址，重试时连接到下一个地址
+                    transfer.resolver->markUnreachable(transfer.host, transfer.address);
+                }
+                throw error::ConnectionError(message);
+            case CURLE_COULDNT_RESOLVE_HOST:
+            case CURLE_COULDNT_RESOLVE_PROXY:
+                throw error::ConnectionError(message);
+            default:
+                throw error::NetworkError(message);
+        }
     }
     
     // 获取响应状态码
     long statusCode;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &statusCode);
-    
-    // 清理
-    curl_slist_free_all(headerList);
-    curl_easy_cleanup(curl);
+    curl_easy_getinfo(transfer.curl, CURLINFO_RESPONSE_CODE, &statusCode);
     
     // 构建响应对象
+    HttpResponse response;
     response.statusCode = static_cast<int>(statusCode);
-    response.headers = responseHeaders;
-    response.body = responseBody;
+    response.headers = std::move(transfer.responseHeaders);
+    response.body = std::move(transfer.responseBody);
     
     return response;
 }
 
+// 读取CURLINFO_*_TIME_T（微秒）并转换为毫秒
+static double elapsedMillis(CURL* curl, CURLINFO info) {
+    curl_off_t micros = 0;
+    curl_easy_getinfo(curl, info, &micros);
+    return static_cast<double>(micros) / 1000.0;
+}
+
+void HttpClient::recordTransfer(RequestMetrics& metrics, detail::Transfer& transfer, int curlCode) {
+    CURL* curl = transfer.curl;
+    RequestEvent event;
+    event.method = transfer.method;
+    event.endpoint = transfer.endpoint;
+    event.transportError = curlCode != CURLE_OK;
+    
+    long statusCode = 0;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &statusCode);
+    event.statusCode = static_cast<int>(statusCode);
+    
+    RequestStats& stats = event.stats;
+    stats.nameLookupTime = elapsedMillis(curl, CURLINFO_NAMELOOKUP_TIME_T);
+    stats.connectTime = elapsedMillis(curl, CURLINFO_CONNECT_TIME_T);
+    stats.appConnectTime = elapsedMillis(curl, CURLINFO_APPCONNECT_TIME_T);
+    stats.startTransferTime = elapsedMillis(curl, CURLINFO_STARTTRANSFER_TIME_T);
+    stats.totalTime = elapsedMillis(curl, CURLINFO_TOTAL_TIME_T);
+    stats.downloadTime = std::max(0.0, stats.totalTime - stats.startTransferTime);
+    
+    curl_off_t downloaded = 0;
+    curl_off_t uploaded = 0;
+    curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &downloaded);
+    curl_easy_getinfo(curl, CURLINFO_SIZE_UPLOAD_T, &uploaded);
+    stats.downloadSize = static_cast<long>(downloaded);
+    stats.uploadSize = static_cast<long>(uploaded);
+    
+    metrics.record(event);
+    bool sinkStopped = curlCode == CURLE_WRITE_ERROR && transfer.sinkMode == detail::Transfer::SinkMode::Stream;
+    if (transfer.cancelled || sinkStopped) {
+        // 被取消的对冲副本和调用方的sink主动中止都不代表端点故障，耗时也不作为延迟样本
+        transfer.endpointLease.release();
+    } else {
+        completeLease(transfer.endpointLease, event);
+    }
+    if (transfer.span) {
+        finishSpan(transfer.span.get(), transfer.state->config, event,
+                   curlCode != CURLE_OK ? curl_easy_strerror(static_cast<CURLcode>(curlCode)) : "");
+    }
+}
+
 bool HttpClient::testConnection() {
     try {
         HttpRequestConfig config;
         config.method = HttpMethod::HEAD;
         config.url = "/health";
-        auto response = request(config);
+        // 连接测试不重试，尽快返回结果
+        auto response = executeRequest(config);
         return response.statusCode >= 200 && response.statusCode < 300;
     } catch (...) {
         return false;
     }
 }
 
+size_t HttpClient::warmUp(size_t connections) {
+    if (snapshot()->config.transport) {
+        // 可替换传输层自行管理连接
+        return 0;
+    }
+    connections = std::min(connections, connectionPool->getMaxSize());
+    if (connections == 0) {
+        return 0;
+    }
+    // 同时租用所有句柄，确保每个请求在各自的句柄上建立连接
+    std::vector<ConnectionPool::Lease> leases;
+    leases.reserve(connections);
+    for (size_t i = 0; i < connections; ++i) {
+        leases.push_back(connectionPool->acquire());
+    }
+    
+    HttpRequestConfig probe;
+    probe.method = HttpMethod::HEAD;
+    probe.url = "/health";
+    std::atomic<size_t> opened{0};
+    std::vector<std::thread> workers;
+    workers.reserve(connections);
+    for (auto& lease : leases) {
+        workers.emplace_back([this, &lease, &probe, &opened] {
+            try {
+                detail::RequestArena::Scope arena;
+                detail::Transfer transfer(static_cast<CURL*>(lease.get()), false, detail::RequestArena::current());
+                transfer.slot = lease.getSlot();
+                prepareTransfer(transfer, probe);
+                // 只关心连接是否建立，不统计指标也不检查状态码
+                if (curl_easy_perform(transfer.curl) == CURLE_OK) {
+                    opened.fetch_add(1, std::memory_order_relaxed);
+                }
+            } catch (...) {
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    return opened.load();
+}
+
+void HttpClient::updateState(const std::function<void(detail::ClientState&)>& mutate) {
+    std::lock_guard<std::mutex> lock(updateMutex);
+    auto updated = std::make_shared<detail::ClientState>(*std::atomic_load(&state));
+    mutate(*updated);
+    std::atomic_store(&state, std::shared_ptr<const detail::ClientState>(std::move(updated)));
+}
+
 void HttpClient::updateConfig(const ClientConfig& newConfig) {
-    config = newConfig;
+    updateState([&newConfig](detail::ClientState& next) {
+        next.config = newConfig;
+    });
+    if (connectionPool && newConfig.connectionPoolSize > 0) {
+        connectionPool->setMaxSize(static_cast<size_t>(newConfig.connectionPoolSize));
+    }
+    std::lock_guard<std::mutex> lock(engineMutex);
+    if (newConfig.enableLogging && !std::atomic_load(&logger)) {
+        std::atomic_store(&logger, std::make_shared<detail::RequestLogger>(newConfig.logBufferCapacity, newConfig.logSink));
+    }
+    if (asyncEngine) {
+        asyncEngine->setLimits(engineLimits(newConfig));
+    }
 }
 
 void HttpClient::updateAuthProvider(std::shared_ptr<auth::AuthenticationProvider> newAuthProvider) {
-    authProvider = newAuthProvider;
+    updateState([&newAuthProvider](detail::ClientState& next) {
+        next.authProvider = std::move(newAuthProvider);
+    });
 }
 
 void HttpClient::setTimeout(int timeoutMs) {
-    config.timeout = timeoutMs;
+    updateState([timeoutMs](detail::ClientState& next) {
+        next.config.timeout = timeoutMs;
+    });
 }
 
 void HttpClient::setVerifySSL(bool verify) {
-    config.verifySSL = verify;
+    updateState([verify](detail::ClientState& next) {
+        next.config.verifySSL = verify;
+    });
 }
 
 void HttpClient::setProxy(const std::string& proxyUrl) {
-    config.proxyUrl = proxyUrl;
+    updateState([&proxyUrl](detail::ClientState& next) {
+        next.config.proxyUrl = proxyUrl;
+    });
 }
 
 HttpClient::RequestStats HttpClient::getLastRequestStats() const {
-    // 这里应该实现获取最后一次请求统计信息的逻辑
-    // 目前返回默认值
-    return RequestStats{0.0, 0.0, 0.0, 0, 0};
+    return metrics->getLastStats();
+}
+
+void HttpClient::addObserver(std::shared_ptr<RequestObserver> observer) {
+    metrics->addObserver(std::move(observer));
+}
+
+void HttpClient::removeObserver(const std::shared_ptr<RequestObserver>& observer) {
+    metrics->removeObserver(observer);
+}
+
+std::unique_ptr<HttpClient> HttpClientFactory::create(
+    const ClientConfig& config,
+    std::shared_ptr<auth::AuthenticationProvider> authProvider) {
+    return std::make_unique<HttpClient>(config, std::move(authProvider), CurlRuntime::instance());
+}
+
+std::unique_ptr<HttpClient> HttpClientFactory::createDefault(
+    const std::string& baseUrl,
+    std::shared_ptr<auth::AuthenticationProvider> authProvider) {
+    return create(ClientConfig(baseUrl), std::move(authProvider));
 }
 
 } // namespace http
@@ -0,0 +1,249 @@
+#include "dataapi/auth/OAuth2AuthProvider.h"
+#include "dataapi/error/DataApiError.h"
+#include "dataapi/http/CurlRuntime.h"
+#include <curl/curl.h>
+#include <algorithm>
+#include <limits>
+
+namespace dataapi {
+namespace auth {
+
+static std::string formEscape(CURL* curl, const std::string& value) {
+    char* escaped = curl_easy_escape(curl, value.c_str(), static_cast<int>(value.size()));
+    std::string result = escaped ? escaped : "";
+    curl_free(escaped);
+    return result;
+}
+
+static size_t collectBody(char* data, size_t size, size_t count, void* userdata) {
+    static_cast<std::string*>(userdata)->append(data, size * count);
+    return size * count;
+}
+
+/**
+ * 向令牌端点发送表单请求（RFC 6749 4.4 / 6）
+ */
+static TokenResponse requestToken(const OAuth2Options& options,
+                                  const std::shared_ptr<http::CurlRuntime>& runtime,
+                                  const std::string& refreshToken) {
+    std::unique_ptr<CURL, decltype(&curl_easy_cleanup)> curl(curl_easy_init(), &curl_easy_cleanup);
+    if (!curl) {
+        throw error::AuthenticationError("Failed to create token request");
+    }
+
+    std::string form;
+    if (!refreshToken.empty()) {
+        form = "grant_type=refresh_token&refresh_token=" + formEscape(curl.get(), refreshToken);
+    } else {
+        form = "grant_type=client_credentials";
+    }
+    if (!options.clientId.empty()) {
+        form += "&client_id=" + formEscape(curl.get(), options.clientId);
+    }
+    if (!options.clientSecret.empty()) {
+        form += "&client_secret=" + formEscape(curl.get(), options.clientSecret);
+    }
+    if (!options.scope.empty()) {
+        form += "&scope=" + formEscape(curl.get(), options.scope);
+    }
+
+    std::string body;
+    std::unique_ptr<curl_slist, decltype(&curl_slist_free_all)> headers(
+        curl_slist_append(nullptr, "Accept: application/json"), &curl_slist_free_all);
+    curl_easy_setopt(curl.get(), CURLOPT_SHARE, runtime->getShareHandle());
+    curl_easy_setopt(curl.get(), CURLOPT_URL, options.tokenUrl.c_str());
+    curl_easy_setopt(curl.get(), CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl.get(), CURLOPT_TIMEOUT_MS, static_cast<long>(options.timeoutMs));
+    curl_easy_setopt(curl.get(), CURLOPT_POSTFIELDS, form.c_str());
+    curl_easy_setopt(curl.get(), CURLOPT_POSTFIELDSIZE, static_cast<long>(form.size()));
+    curl_easy_setopt(curl.get(), CURLOPT_HTTPHEADER, headers.get());
+    curl_easy_setopt(curl.get(), CURLOPT_WRITEFUNCTION, collectBody);
+    curl_easy_setopt(curl.get(), CURLOPT_WRITEDATA, &body);
+    if (!options.verifySSL) {
+        curl_easy_setopt(curl.get(), CURLOPT_SSL_VERIFYPEER, 0L);
+        curl_easy_setopt(curl.get(), CURLOPT_SSL_VERIFYHOST, 0L);
+    }
+
+    CURLcode code = curl_easy_perform(curl.get());
+    if (code != CURLE_OK) {
+        throw error::AuthenticationError(std::string("Token request failed: ") + curl_easy_strerror(code));
+    }
+    long status = 0;
+    curl_easy_getinfo(curl.get(), CURLINFO_RESPONSE_CODE, &status);
+    if (status != 200) {
+        throw error::AuthenticationError("Token request failed with HTTP " + std::to_string(status) + ": " +
+                                         body.substr(0, 200));
+    }
+    return Json::parse(body).get<TokenResponse>();
+}
+
+OAuth2AuthProvider::OAuth2AuthProvider(const OAuth2Options& options)
+    : OAuth2AuthProvider([options, runtime = http::CurlRuntime::instance()](const std::string& refreshToken) {
+          return requestToken(options, runtime, refreshToken);
+      }, options) {
+}
+
+OAuth2AuthProvider::OAuth2AuthProvider(TokenFetcher fetcher, const OAuth2Options& options)
+    : fetcher(std::move(fetcher)),
+      refreshAhead(options.refreshAhead),
+      refreshToken(options.refreshToken),
+      refreshAt(Clock::now()),
+      expiresAt(std::numeric_limits<int64_t>::min()) {
+    if (options.backgroundRefresh) {
+        worker = std::thread([this] { backgroundLoop(); });
+    }
+}
+
+OAuth2AuthProvider::~OAuth2AuthProvider() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+std::unordered_map<std::string, std::string> OAuth2AuthProvider::getAuthHeaders() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (token.empty()) {
+        return {};
+    }
+    return {{"Authorization", "Bearer " + token}};
+}
+
+bool OAuth2AuthProvider::isValid() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return !token.empty() && ticks(Clock::now()) < expiresAt.load();
+}
+
+bool OAuth2AuthProvider::refresh() {
+    cleared = false;
+    return fetchToken();
+}
+
+bool OAuth2AuthProvider::refreshAfterRejection(uint64_t revision) {
+    if (cleared) {
+        return false;
+    }
+    return AuthenticationProvider::getRevision() != revision || fetchToken();
+}
+
+bool OAuth2AuthProvider::fetchToken() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (refreshing) {
+        // 合并到进行中的刷新
+        uint64_t round = rounds;
+        refreshed.wait(lock, [&] { return rounds != round; });
+        return lastSucceeded;
+    }
+    refreshing = true;
+    std::string currentRefreshToken = refreshToken;
+    lock.unlock();
+
+    TokenResponse response;
+    std::string failure;
+    try {
+        response = fetcher(currentRefreshToken);
+        if (response.accessToken.empty()) {
+            failure = "Token response has no access token";
+        }
+    } catch (const std::exception& e) {
+        failure = e.what();
+    } catch (...) {
+        failure = "Unknown error";
+    }
+
+    lock.lock();
+    auto now = Clock::now();
+    lastSucceeded = failure.empty();
+    lastError = failure;
+    if (lastSucceeded) {
+        token = response.accessToken;
+        if (response.refreshToken) {
+            refreshToken = *response.refreshToken;
+        }
+        if (response.expiresIn && *response.expiresIn > 0) {
+            std::chrono::milliseconds lifetime = std::chrono::seconds(*response.expiresIn);
+            expiresAt = ticks(now + lifetime);
+            // 有效期不足两倍提前量时在有效期过半时刷新
+            refreshAt = now + std::max<std::chrono::milliseconds>(lifetime - refreshAhead, lifetime / 2);
+        } else {
+            expiresAt = std::numeric_limits<int64_t>::max();
+            refreshAt = Clock::time_point::max();
+        }
+        backoff = std::chrono::seconds(1);
+        retryNotBefore = 0;
+        markChanged();
+    } else {
+        refreshAt = now + backoff;
+        backoff = std::min<std::chrono::seconds>(backoff * 2, std::chrono::seconds(30));
+        retryNotBefore = ticks(now + std::chrono::seconds(1));
+    }
+    refreshing = false;
+    ++rounds;
+    refreshed.notify_all();
+    wake.notify_all();
+    return lastSucceeded;
+}
+
+void OAuth2AuthProvider::backgroundLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        if (cleared || Clock::now() < refreshAt) {
+            if (cleared || refreshAt == Clock::time_point::max()) {
+                wake.wait(lock);
+            } else {
+                wake.wait_until(lock, refreshAt);
+            }
+            continue;
+        }
+        lock.unlock();
+        fetchToken();
+        lock.lock();
+    }
+}
+
+void OAuth2AuthProvider::clearAuthentication() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        token.clear();
+        refreshToken.clear();
+        expiresAt = std::numeric_limits<int64_t>::min();
+        cleared = true;
+    }
+    markChanged();
+    wake.notify_all();
+}
+
+std::string OAuth2AuthProvider::toString() const {
+    return "OAuth2Auth[token=***]";
+}
+
+uint64_t OAuth2AuthProvider::getRevision() const {
+    int64_t now = ticks(Clock::now());
+    if (now >= expiresAt.load(std::memory_order_relaxed) && now >= retryNotBefore.load(std::memory_order_relaxed) &&
+        !cleared.load(std::memory_order_relaxed)) {
+        // 版本号是HttpClient发出每个请求前的检查点，令牌过期时在此补刷新；
+        // 接口为const，刷新只改变内部的同步状态
+        const_cast<OAuth2AuthProvider*>(this)->fetchToken();
+    }
+    return AuthenticationProvider::getRevision();
+}
+
+std::chrono::steady_clock::time_point OAuth2AuthProvider::getExpiry() const {
+    int64_t value = expiresAt.load();
+    if (value == std::numeric_limits<int64_t>::min() || value == std::numeric_limits<int64_t>::max()) {
+        return Clock::time_point::max();
+    }
+    return Clock::time_point(Clock::duration(value));
+}
+
+std::string OAuth2AuthProvider::getLastError() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return lastError;
+}
+
+} // namespace auth
+} // namespace dataapi
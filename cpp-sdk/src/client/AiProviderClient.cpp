@@ -1,7 +1,18 @@
 #include "dataapi/client/AiProviderClient.h"
 #include "dataapi/Types.h"
 #include "dataapi/exceptions/DataApiException.h"
-#include <sstream>
+#include "dataapi/error/DataApiError.h"
+#include "client/ResponseDecoder.h"
+#include "client/EventStreamParser.h"
+#include "client/EmbeddingDecoder.h"
+#include "client/AsyncBatch.h"
+#include "client/CachedLookup.h"
+#include "client/TimeSeriesFetch.h"
+#ifdef DATAAPI_WITH_COROUTINES
+#include "client/AsyncRequests.h"
+#endif
+#include <algorithm>
+#include <strings.h>
 #include <stdexcept>
 #include <string>
 #include <memory>
@@ -12,85 +23,653 @@ namespace client {
 AiProviderClient::AiProviderClient(std::shared_ptr<http::HttpClient> httpClient) : httpClient(httpClient) {
 }
 
+/**
+ * 列表查询参数，过滤条件为空时省略
+ */
+static Parameters listParams(int page, int size, const std::string& type) {
+    Parameters params{{"page", std::to_string(page)}, {"size", std::to_string(size)}};
+    if (!type.empty()) {
+        params["type"] = type;
+    }
+    return params;
+}
+
 PageResult<AiProvider> AiProviderClient::list(int page, int size, const std::string& type) {
-    std::ostringstream oss;
-    oss << "/ai-providers?page=" << page << "&size=" << size;
+    auto response = httpClient->get("/ai-providers", listParams(page, size, type));
+    detail::expectStatus(response, 200, "Failed to list AI providers");
+    return detail::decodePage<AiProvider>(std::move(response));
+}
+
+Paginator<AiProvider> AiProviderClient::paginate(int size, const std::string& type, const PaginatorOptions& options) {
+    return Paginator<AiProvider>(
+        [this, size, type](int page) {
+            return list(page, size, type);
+        },
+        options.pageBase, options);
+}
+
+AiProvider AiProviderClient::getById(const std::string& id) {
+    auto response = httpClient->get("/ai-providers/" + id);
+    detail::expectStatus(response, 200, "Failed to get AI provider", "AI provider not found: " + id);
+    return detail::decode<AiProvider>(std::move(response));
+}
+
+AiProvider AiProviderClient::update(const std::string& id, const AiProviderUpdateRequest& request) {
+    detail::ScopedInvalidation invalidation(metadataCache, {MetadataKind::ModelList}, id);
+    auto response = httpClient->request(detail::jsonRequest(HttpMethod::PUT, "/ai-providers/" + id, request));
+    detail::expectStatus(response, 200, "Failed to update AI provider", "AI provider not found: " + id);
+    return detail::decode<AiProvider>(std::move(response));
+}
+
+void AiProviderClient::deleteProvider(const std::string& id) {
+    detail::ScopedInvalidation invalidation(metadataCache, {MetadataKind::ModelList}, id);
+    auto response = httpClient->del("/ai-providers/" + id);
+    detail::expectStatus(response, 204, "Failed to delete AI provider", "AI provider not found: " + id);
+}
+
+std::vector<AiModel> AiProviderClient::getModels(const std::string& providerId) {
+    return detail::cachedLookup<std::vector<AiModel>>(metadataCache, MetadataKind::ModelList, providerId, "", [&] {
+        return detail::conditionalGet<std::vector<AiModel>>(*httpClient, "/ai-providers/" + providerId + "/models",
+                                                            "Failed to get AI models", "AI provider not found: " + providerId);
+    });
+}
+
+AiProviderTestResult AiProviderClient::testConfiguration(const AiProviderConfig& config) {
+    auto response = httpClient->request(detail::jsonRequest(HttpMethod::POST, "/ai-providers/test", config));
+    detail::expectStatus(response, 200, "Failed to test AI provider", "AI provider configuration test failed");
+    return detail::decode<AiProviderTestResult>(std::move(response));
+}
+
+AiServiceResponse AiProviderClient::invoke(const std::string& providerId, const AiServiceRequest& request) {
+    auto response = httpClient->request(detail::jsonRequest(HttpMethod::POST, "/ai-providers/" + providerId + "/invoke", request));
+    detail::expectStatus(response, 200, "Failed to invoke AI", "AI provider not found: " + providerId);
+    return detail::decode<AiServiceResponse>(std::move(response));
+}
+
+AiQuotaInfo AiProviderClient::getQuotaInfo(const std::string& providerId) {
+    auto response = httpClient->get("/ai-providers/" + providerId + "/quota");
+    detail::expectStatus(response, 200, "Failed to get AI quota", "AI provider not found: " + providerId);
+    return detail::decode<AiQuotaInfo>(std::move(response));
+}
+
+AiUsageStatistics AiProviderClient::getUsageStatistics(const std::string& providerId,
+                                                       const std::string& startTime,
+                                                       const std::string& endTime) {
+    Parameters params;
+    if (!startTime.empty()) {
+        params["startTime"] = startTime;
+    }
+    if (!endTime.empty()) {
+        params["endTime"] = endTime;
+    }
+    auto response = httpClient->get("/ai-providers/" + providerId + "/usage", std::move(params));
+    detail::expectStatus(response, 200, "Failed to get AI usage statistics", "AI provider not found: " + providerId);
+    return detail::decode<AiUsageStatistics>(std::move(response));
+}
+
+TimeSeries AiProviderClient::getUsageSeries(const std::string& providerId,
+                                            Timestamp start,
+                                            Timestamp end,
+                                            const TimeSeriesOptions& options) {
+    return detail::fetchTimeSeries(*httpClient, "/ai-providers/" + providerId + "/usage/series", start, end, options,
+                                   "Failed to get AI usage statistics", "AI provider not found: " + providerId);
+}
+
+TimeSeriesTracker AiProviderClient::trackUsage(const std::string& providerId,
+                                               std::chrono::milliseconds range,
+                                               const TimeSeriesOptions& options) {
+    return TimeSeriesTracker([client = httpClient, providerId, options](Timestamp start, Timestamp end) {
+        return detail::fetchTimeSeries(*client, "/ai-providers/" + providerId + "/usage/series", start, end, options,
+                                       "Failed to get AI usage statistics", "AI provider not found: " + providerId);
+    }, range);
+}
+
+void AiProviderClient::setQuota(const std::string& providerId, const AiQuotaSettings& quota) {
+    auto response = httpClient->request(detail::jsonRequest(HttpMethod::PUT, "/ai-providers/" + providerId + "/quota", quota));
+    detail::expectStatus(response, 200, "Failed to set AI quota", "AI provider not found: " + providerId);
+}
+
+std::shared_ptr<http::RateLimiter> AiProviderClient::rateLimiterFor(const AiQuotaSettings& quota) {
+    double seconds;
+    if (quota.period == "second") {
+        seconds = 1;
+    } else if (quota.period == "minute") {
+        seconds = 60;
+    } else if (quota.period == "hour") {
+        seconds = 3600;
+    } else if (quota.period == "day") {
+        seconds = 86400;
+    } else {
+        throw std::invalid_argument("Unknown quota period: " + quota.period);
+    }
+    double rate = quota.maxRequests > 0 ? quota.maxRequests / seconds : 0.0;
+    return std::make_shared<http::RateLimiter>(rate, std::max(1.0, rate));
+}
+
+std::shared_ptr<http::RateLimiter> AiProviderClient::rateLimiterFor(const AiQuotaInfo& quota) {
+    std::chrono::duration<double> window = quota.resetTime - std::chrono::system_clock::now();
+    if (window.count() <= 0) {
+        // 配额已重置，不限流
+        return std::make_shared<http::RateLimiter>(0.0, 1.0);
+    }
+    double remaining = std::max(0, quota.remainingRequests);
+    double rate = std::max(1.0, remaining) / window.count();
+    auto limiter = std::make_shared<http::RateLimiter>(rate, std::max(1.0, std::min(remaining, rate)));
+    if (remaining == 0) {
+        // 配额已用完，第一个请求等到重置时间
+        limiter->tryAcquire();
+    }
+    return limiter;
+}
+
+std::vector<AiBatchItem> AiProviderClient::invokeBatch(const std::string& providerId,
+                                                       const std::vector<AiServiceRequest>& requests,
+                                                       const AiBatchOptions& options) {
+    std::vector<AiBatchItem> results(requests.size());
+    std::shared_ptr<http::RateLimiter> limiter = options.rateLimiter;
+    if (!limiter && options.limitByQuota) {
+        limiter = rateLimiterFor(getQuotaInfo(providerId));
+    }
+    
+    // 完成回调在异步引擎线程上执行，各自写入对应的结果项；
+    // 返回前等待所有在途请求完成，回调引用的局部状态在此期间有效
+    detail::AsyncWindow window(options.concurrency);
+    const std::string url = "/ai-providers/" + providerId + "/invoke";
+    const std::string notFound = "AI provider not found: " + providerId;
+    
+    for (size_t i = 0; i < requests.size(); ++i) {
+        window.acquire();
+        if (limiter) {
+            limiter->acquire();
+        }
+        try {
+            httpClient->requestAsync(
+                detail::jsonRequest(HttpMethod::POST, url, requests[i]),
+                [&, i](http::HttpResponse response, std::exception_ptr error) {
+                    AiBatchItem& item = results[i];
+                    if (!error) {
+                        try {
+                            detail::expectStatus(response, 200, "Failed to invoke AI", notFound);
+                            item.response = detail::decode<AiServiceResponse>(std::move(response));
+                        } catch (...) {
+                            error = std::current_exception();
+                        }
+                    }
+                    if (error) {
+                        detail::recordFailure(item, error);
+                    }
+                    window.release();
+                });
+        } catch (...) {
+            detail::recordFailure(results[i], std::current_exception());
+            window.release();
+        }
+    }
+    
+    window.wait();
+    return results;
+}
+
+/**
+ * 取JSON对象中第一个存在的字符串字段
+ */
+static const std::string* findText(const Json& json, std::initializer_list<const char*> keys) {
+    for (const char* key : keys) {
+        auto it = json.find(key);
+        if (it != json.end() && it->is_string()) {
+            return &it->get_ref<const std::string&>();
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * 将一个流式事件转换为响应片段
+ * data为[DONE]时表示结束；JSON数据依次从chunk、content、text、delta、response字段
+ * 或OpenAI风格的choices[0]中取文本，非JSON数据整体作为文本
+ */
+static AiStreamResponse toStreamResponse(std::string& data) {
+    AiStreamResponse response{};
+    if (data == "[DONE]") {
+        response.isComplete = true;
+        return response;
+    }
+    Json json = Json::parse(data, nullptr, false);
+    if (json.is_discarded() || !json.is_object()) {
+        response.chunk = std::move(data);
+        return response;
+    }
     
-    auto response = httpClient->get(oss.str());
-    if (response.statusCode != 200) {
-        throw std::runtime_error("Failed to list AI providers");
+    if (const std::string* text = findText(json, {"chunk", "content", "text", "delta", "response"})) {
+        response.chunk = *text;
     }
+    response.isComplete = json.value("isComplete", false) || json.value("done", false);
+    auto choices = json.find("choices");
+    if (choices != json.end() && choices->is_array() && !choices->empty() && (*choices)[0].is_object()) {
+        const Json& choice = (*choices)[0];
+        auto delta = choice.find("delta");
+        if (delta != choice.end() && delta->is_object()) {
+            if (const std::string* text = findText(*delta, {"content"})) {
+                response.chunk = *text;
+            }
+        } else if (const std::string* text = findText(choice, {"text"})) {
+            response.chunk = *text;
+        }
+        auto finish = choice.find("finish_reason");
+        response.isComplete = response.isComplete || (finish != choice.end() && finish->is_string());
+    }
+    auto metadata = json.find("metadata");
+    response.metadata = metadata != json.end() ? std::move(*metadata) : std::move(json);
+    return response;
+}
+
+/**
+ * 执行流式请求并逐个片段回调
+ * 服务端未发送结束标记时，在响应正常结束后补发一个isComplete的空片段
+ */
+static void streamResponses(http::HttpClient& httpClient,
+                            HttpRequestConfig request,
+                            const std::string& providerId,
+                            const std::function<bool(const AiStreamResponse&)>& callback) {
+    using detail::EventStreamParser;
+    bool stopped = false;
+    bool completed = false;
+    bool whole = false; // 服务端不支持流式时返回完整的JSON响应
+    std::string body;
+    
+    auto deliver = [&](std::string& data) {
+        AiStreamResponse response = toStreamResponse(data);
+        completed = response.isComplete;
+        stopped = !callback(response);
+        return !stopped;
+    };
+    EventStreamParser parser([&](EventStreamParser::Event& event) {
+        if (event.type == "error") {
+            throw error::DataApiError("AI stream error: " + event.data, "STREAM_ERROR");
+        }
+        // 结束后的事件忽略，让传输正常结束以便复用连接
+        return completed || deliver(event.data);
+    });
     
-    Json json = Json::parse(response.body);
-    PageResult<AiProvider> result;
+    request.headers["Accept"] = "text/event-stream, application/x-ndjson";
+    http::HttpResponse response;
+    try {
+        response = httpClient.request(
+            request,
+            [&](const char* data, size_t size) {
+                if (whole) {
+                    body.append(data, size);
+                    return true;
+                }
+                return parser.feed(data, size);
+            },
+            [&](int, const http::ResponseHeaders& headers) {
+                std::string type(headers.get("Content-Type").value_or(""));
+                if (strncasecmp(type.c_str(), "text/event-stream", 17) == 0) {
+                    parser.setFraming(EventStreamParser::Framing::ServerSentEvents);
+                } else if (strncasecmp(type.c_str(), "application/json", 16) == 0) {
+                    whole = true;
+                } else {
+                    parser.setFraming(EventStreamParser::Framing::NewlineDelimited);
+                }
+            });
+    } catch (const error::NetworkError&) {
+        // 回调取消时传输被主动中止
+        if (stopped) {
+            return;
+        }
+        throw;
+    }
+    detail::expectStatus(response, 200, "Failed to stream AI response", "AI provider not found: " + providerId);
     
-    result.content.clear();
-    for (const auto& item : json["content"]) {
-        AiProvider provider;
-        from_json(item, provider);
-        result.content.push_back(provider);
+    if (whole) {
+        if (!deliver(body)) {
+            return;
+        }
+    } else if (!completed && !parser.finish()) {
+        return;
+    }
+    if (!completed) {
+        AiStreamResponse last{};
+        last.isComplete = true;
+        callback(last);
     }
+}
+
+void AiProviderClient::invokeStream(const std::string& providerId,
+                                    const AiServiceRequest& request,
+                                    std::function<bool(const AiStreamResponse&)> callback) {
+    streamResponses(*httpClient,
+                    detail::jsonRequest(HttpMethod::POST, "/ai-providers/" + providerId + "/invoke/stream", request),
+                    providerId, callback);
+}
+
+void AiProviderClient::generateTextStream(const std::string& providerId,
+                                          const std::string& prompt,
+                                          std::function<bool(const std::string&)> callback,
+                                          const TextGenerationOptions& options) {
+    Json payload = options.additionalParams.is_object() ? options.additionalParams : Json::object();
+    payload["prompt"] = prompt;
+    payload["temperature"] = options.temperature;
+    payload["maxTokens"] = options.maxTokens;
+    payload["topP"] = options.topP;
+    payload["stream"] = true;
     
-    result.totalElements = json["totalElements"].get<long>();
-    result.totalPages = json["totalPages"].get<int>();
-    result.pageSize = json["size"].get<int>();
-    result.pageNumber = json["number"].get<int>();
-    result.empty = json.value("empty", false);
-    result.first = json["first"].get<bool>();
-    result.last = json["last"].get<bool>();
+    streamResponses(*httpClient,
+                    detail::jsonRequest(HttpMethod::POST, "/ai-providers/" + providerId + "/generate/text", payload),
+                    providerId,
+                    [&callback](const AiStreamResponse& response) {
+                        return response.chunk.empty() || callback(response.chunk);
+                    });
+}
+
+/**
+ * 以对象形式的additionalParams为基础构建请求体
+ */
+static Json basePayload(const Json& additionalParams) {
+    return additionalParams.is_object() ? additionalParams : Json::object();
+}
+
+/**
+ * 把附加参数追加为查询参数，字符串取原值，其余类型取JSON文本
+ */
+static void appendParams(Parameters& params, const Json& additionalParams) {
+    if (additionalParams.is_object()) {
+        for (const auto& item : additionalParams.items()) {
+            const Json& value = item.value();
+            params.emplace(item.key(), value.is_string() ? value.get<std::string>() : value.dump());
+        }
+    }
+}
+
+/**
+ * 原始二进制上传的请求：媒体作为请求体，其余参数在查询串中
+ */
+static HttpRequestConfig mediaUploadRequest(std::string url, const std::string& contentType) {
+    HttpRequestConfig request;
+    request.method = HttpMethod::POST;
+    request.url = std::move(url);
+    request.headers["Content-Type"] = contentType;
+    return request;
+}
+
+/**
+ * 请求原始二进制响应并按块写入output
+ * 服务端仍返回JSON（不支持原始媒体）时不写入目标，抛出error::ValidationError
+ */
+static MediaResult downloadMedia(http::HttpClient& httpClient, HttpRequestConfig request, const char* accept,
+                                 MediaOutput& output, const std::string& providerId, const char* failure) {
+    request.headers["Accept"] = accept;
+    uint64_t size = 0;
+    auto response = httpClient.request(
+        request,
+        [&output, &size](const char* data, size_t length) {
+            size += length;
+            return output.sink(data, length);
+        },
+        [](int, const http::ResponseHeaders& headers) {
+            auto type = headers.get("Content-Type");
+            if (type && type->find("json") != std::string_view::npos) {
+                throw error::ValidationError("Provider returned JSON instead of binary media");
+            }
+        });
+    detail::expectStatus(response, 200, failure, "AI provider not found: " + providerId);
+    if (output.finish) {
+        output.finish();
+    }
     
+    MediaResult result;
+    result.size = size;
+    if (auto type = response.headers.get("Content-Type")) {
+        result.contentType.assign(*type);
+    }
+    if (auto model = response.headers.get("X-Model")) {
+        result.model.assign(*model);
+    }
+    if (output.buffer) {
+        result.bytes = Span<char>(output.buffer, static_cast<size_t>(size));
+    }
     return result;
 }
 
-AiProvider AiProviderClient::getById(const std::string& id) {
-    auto response = httpClient->get("/ai-providers/" + id);
-    if (response.statusCode == 404) {
-        throw std::runtime_error("AI provider not found: " + id);
+static Json imagePayload(const std::string& prompt, const ImageGenerationOptions& options) {
+    Json payload = basePayload(options.additionalParams);
+    payload["prompt"] = prompt;
+    payload["size"] = options.size;
+    payload["quality"] = options.quality;
+    payload["n"] = options.n;
+    return payload;
+}
+
+ImageGenerationResult AiProviderClient::generateImage(const std::string& providerId,
+                                                      const std::string& prompt,
+                                                      const ImageGenerationOptions& options) {
+    auto response = httpClient->request(
+        detail::jsonRequest(HttpMethod::POST, "/ai-providers/" + providerId + "/generate/image", imagePayload(prompt, options)));
+    detail::expectStatus(response, 200, "Failed to generate image", "AI provider not found: " + providerId);
+    return detail::decode<ImageGenerationResult>(std::move(response));
+}
+
+MediaResult AiProviderClient::generateImage(const std::string& providerId,
+                                            const std::string& prompt,
+                                            MediaOutput output,
+                                            const ImageGenerationOptions& options) {
+    Json payload = imagePayload(prompt, options);
+    payload["n"] = 1;
+    return downloadMedia(*httpClient,
+                         detail::jsonRequest(HttpMethod::POST, "/ai-providers/" + providerId + "/generate/image", std::move(payload)),
+                         "image/*", output, providerId, "Failed to generate image");
+}
+
+ImageAnalysisResult AiProviderClient::analyzeImage(const std::string& providerId,
+                                                   const std::string& imageData,
+                                                   const std::string& prompt,
+                                                   const ImageAnalysisOptions& options) {
+    Json payload = basePayload(options.additionalParams);
+    payload["image"] = imageData;
+    if (!prompt.empty()) {
+        payload["prompt"] = prompt;
     }
-    if (response.statusCode != 200) {
-        throw std::runtime_error("Failed to get AI provider");
+    if (!options.model.empty()) {
+        payload["model"] = options.model;
     }
+    payload["maxTokens"] = options.maxTokens;
     
-    Json json = Json::parse(response.body);
-    AiProvider provider;
-    from_json(json, provider);
-    return provider;
+    auto response = httpClient->request(
+        detail::jsonRequest(HttpMethod::POST, "/ai-providers/" + providerId + "/analyze/image", std::move(payload)));
+    detail::expectStatus(response, 200, "Failed to analyze image", "AI provider not found: " + providerId);
+    return detail::decode<ImageAnalysisResult>(std::move(response));
 }
 
-AiProviderTestResult AiProviderClient::testConfiguration(const AiProviderConfig& config) {
-    Json configJson;
-    to_json(configJson, config);
-    auto response = httpClient->post("/ai-providers/test", configJson);
-    if (response.statusCode == 404) {
-        throw std::runtime_error("AI provider configuration test failed");
+ImageAnalysisResult AiProviderClient::analyzeImage(const std::string& providerId,
+                                                   http::UploadBody image,
+                                                   const std::string& contentType,
+                                                   const std::string& prompt,
+                                                   const ImageAnalysisOptions& options) {
+    auto request = mediaUploadRequest("/ai-providers/" + providerId + "/analyze/image", contentType);
+    if (!prompt.empty()) {
+        request.params["prompt"] = prompt;
     }
-    if (response.statusCode != 200) {
-        throw std::runtime_error("Failed to test AI provider");
+    if (!options.model.empty()) {
+        request.params["model"] = options.model;
     }
+    request.params["maxTokens"] = std::to_string(options.maxTokens);
+    appendParams(request.params, options.additionalParams);
     
-    Json json = Json::parse(response.body);
-    AiProviderTestResult result;
-    from_json(json, result);
-    return result;
+    auto response = httpClient->upload(request, std::move(image));
+    detail::expectStatus(response, 200, "Failed to analyze image", "AI provider not found: " + providerId);
+    return detail::decode<ImageAnalysisResult>(std::move(response));
 }
 
-AiServiceResponse AiProviderClient::invoke(const std::string& providerId, const AiServiceRequest& request) {
-    Json json;
-    to_json(json, request);
+SpeechToTextResult AiProviderClient::speechToText(const std::string& providerId,
+                                                  const std::string& audioData,
+                                                  const SpeechToTextOptions& options) {
+    Json payload = basePayload(options.additionalParams);
+    payload["audio"] = audioData;
+    if (!options.language.empty()) {
+        payload["language"] = options.language;
+    }
+    if (!options.model.empty()) {
+        payload["model"] = options.model;
+    }
+    payload["temperature"] = options.temperature;
+    
+    auto response = httpClient->request(
+        detail::jsonRequest(HttpMethod::POST, "/ai-providers/" + providerId + "/speech-to-text", std::move(payload)));
+    detail::expectStatus(response, 200, "Failed to transcribe audio", "AI provider not found: " + providerId);
+    return detail::decode<SpeechToTextResult>(std::move(response));
+}
+
+SpeechToTextResult AiProviderClient::speechToText(const std::string& providerId,
+                                                  http::UploadBody audio,
+                                                  const std::string& contentType,
+                                                  const SpeechToTextOptions& options) {
+    auto request = mediaUploadRequest("/ai-providers/" + providerId + "/speech-to-text", contentType);
+    if (!options.language.empty()) {
+        request.params["language"] = options.language;
+    }
+    if (!options.model.empty()) {
+        request.params["model"] = options.model;
+    }
+    request.params["temperature"] = Json(options.temperature).dump();
+    appendParams(request.params, options.additionalParams);
+    
+    auto response = httpClient->upload(request, std::move(audio));
+    detail::expectStatus(response, 200, "Failed to transcribe audio", "AI provider not found: " + providerId);
+    return detail::decode<SpeechToTextResult>(std::move(response));
+}
+
+static Json speechPayload(const std::string& text, const TextToSpeechOptions& options) {
+    Json payload = basePayload(options.additionalParams);
+    payload["text"] = text;
+    if (!options.voice.empty()) {
+        payload["voice"] = options.voice;
+    }
+    if (!options.model.empty()) {
+        payload["model"] = options.model;
+    }
+    payload["speed"] = options.speed;
+    return payload;
+}
+
+TextToSpeechResult AiProviderClient::textToSpeech(const std::string& providerId,
+                                                  const std::string& text,
+                                                  const TextToSpeechOptions& options) {
+    auto response = httpClient->request(
+        detail::jsonRequest(HttpMethod::POST, "/ai-providers/" + providerId + "/text-to-speech", speechPayload(text, options)));
+    detail::expectStatus(response, 200, "Failed to synthesize speech", "AI provider not found: " + providerId);
+    return detail::decode<TextToSpeechResult>(std::move(response));
+}
+
+MediaResult AiProviderClient::textToSpeech(const std::string& providerId,
+                                           const std::string& text,
+                                           MediaOutput output,
+                                           const TextToSpeechOptions& options) {
+    return downloadMedia(*httpClient,
+                         detail::jsonRequest(HttpMethod::POST, "/ai-providers/" + providerId + "/text-to-speech",
+                                             speechPayload(text, options)),
+                         "audio/*", output, providerId, "Failed to synthesize speech");
+}
+
+static EmbeddingResult fetchEmbeddings(http::HttpClient& httpClient,
+                                       const std::string& providerId,
+                                       const std::vector<std::string>& texts,
+                                       const EmbeddingOptions& options) {
+    Json payload = options.additionalParams.is_object() ? options.additionalParams : Json::object();
+    payload["texts"] = texts;
+    if (!options.model.empty()) {
+        payload["model"] = options.model;
+    }
+    if (options.dimensions > 0) {
+        payload["dimensions"] = options.dimensions;
+    }
     
-    auto response = httpClient->post("/ai-providers/" + providerId + "/invoke", json);
-    if (response.statusCode == 404) {
-        throw std::runtime_error("AI provider not found: " + providerId);
+    auto request = detail::jsonRequest(HttpMethod::POST, "/ai-providers/" + providerId + "/embeddings", std::move(payload));
+    request.binaryResponse = true;
+    auto response = httpClient.request(request);
+    detail::expectStatus(response, 200, "Failed to get embeddings", "AI provider not found: " + providerId);
+    if (detail::bodyEncoding(response) != detail::BodyEncoding::Json) {
+        // 二进制编码中的浮点数已是原生表示，按通用路径解码
+        EmbeddingResult result;
+        result.embeddings = EmbeddingMatrix(options.precision);
+        from_json(detail::parseBody(std::move(response)), result);
+        return result;
     }
-    if (response.statusCode != 200) {
-        throw std::runtime_error("Failed to invoke AI");
+    return detail::decodeEmbeddings(response.body, options.precision);
+}
+
+EmbeddingResult AiProviderClient::getEmbeddings(const std::string& providerId,
+                                                const std::vector<std::string>& texts,
+                                                const EmbeddingOptions& options) {
+    if (!embeddingCache || texts.empty()) {
+        return fetchEmbeddings(*httpClient, providerId, texts, options);
     }
     
-    Json responseJson = Json::parse(response.body);
-    AiServiceResponse result;
-    from_json(responseJson, result);
+    // 影响向量取值的参数都计入scope，只有scope相同的文本才能共用缓存和请求
+    std::string scope = providerId + '\n' + options.model + '\n' +
+                        std::to_string(options.dimensions) + '\n' + options.additionalParams.dump();
+    EmbeddingResult result;
+    result.model = options.model;
+    EmbeddingOptions fetchOptions = options;
+    fetchOptions.precision = EmbeddingPrecision::Float32; // 缓存保存单精度，组装结果时再转换
+    auto vectors = embeddingCache->resolve(scope, texts, [&](const std::vector<std::string>& batch) {
+        EmbeddingResult fetched = fetchEmbeddings(*httpClient, providerId, batch, fetchOptions);
+        if (result.model.empty()) {
+            result.model = fetched.model;
+        }
+        std::vector<EmbeddingCache::Vector> rows;
+        rows.reserve(fetched.embeddings.rows());
+        for (size_t i = 0; i < fetched.embeddings.rows(); ++i) {
+            rows.push_back(fetched.embeddings.toVector(i));
+        }
+        return rows;
+    });
+    
+    result.embeddings = EmbeddingMatrix(options.precision);
+    for (const auto& vector : vectors) {
+        result.embeddings.appendRow(vector);
+        if (result.embeddings.rows() == 1) {
+            result.embeddings.reserve(vectors.size());
+        }
+    }
     return result;
 }
 
+void AiProviderClient::setEmbeddingCache(std::shared_ptr<EmbeddingCache> cache) {
+    embeddingCache = std::move(cache);
+}
+
+std::shared_ptr<EmbeddingCache> AiProviderClient::getEmbeddingCache() const {
+    return embeddingCache;
+}
+
+void AiProviderClient::setMetadataCache(std::shared_ptr<MetadataCache> cache) {
+    metadataCache = std::move(cache);
+}
+
+std::shared_ptr<MetadataCache> AiProviderClient::getMetadataCache() const {
+    return metadataCache;
+}
+
+#ifdef DATAAPI_WITH_COROUTINES
+
+coro::Task<PageResult<AiProvider>> AiProviderClient::listAsync(int page, int size, std::string type) {
+    return detail::fetchPageAsync<AiProvider>(*httpClient, detail::getRequest("/ai-providers", listParams(page, size, type)),
+                                              "Failed to list AI providers");
+}
+
+coro::Task<AiProvider> AiProviderClient::getByIdAsync(std::string id) {
+    return detail::fetchAsync<AiProvider>(*httpClient, detail::getRequest("/ai-providers/" + id),
+                                          200, "Failed to get AI provider", "AI provider not found: " + id);
+}
+
+coro::Task<AiServiceResponse> AiProviderClient::invokeAsync(std::string providerId, AiServiceRequest request) {
+    return detail::fetchAsync<AiServiceResponse>(
+        *httpClient, detail::jsonRequest(HttpMethod::POST, "/ai-providers/" + providerId + "/invoke", request),
+        200, "Failed to invoke AI", "AI provider not found: " + providerId);
+}
+
+#endif
+
 } // namespace client
 } // namespace dataapi
\ No newline at end of file
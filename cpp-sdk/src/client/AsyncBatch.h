@@ -0,0 +1,63 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+
+namespace dataapi {
+namespace client {
+namespace detail {
+
+/**
+ * 限制在途异步请求数的窗口
+ * 发出请求前acquire()，完成回调中release()；wait()等待全部完成，
+ * 调用方据此保证回调引用的局部状态在返回前有效
+ */
+class AsyncWindow {
+public:
+    explicit AsyncWindow(int limit) : limit(static_cast<size_t>(std::max(1, limit))) {}
+
+    void acquire() {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this] { return inflight < limit; });
+        ++inflight;
+    }
+
+    void release() {
+        std::lock_guard<std::mutex> lock(mutex);
+        --inflight;
+        changed.notify_all();
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this] { return inflight == 0; });
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable changed;
+    size_t inflight = 0;
+    size_t limit;
+};
+
+/**
+ * 在结果项中记录失败原因，Item需有error和errorMessage字段
+ */
+template<typename Item>
+void recordFailure(Item& item, std::exception_ptr error) {
+    item.error = error;
+    try {
+        std::rethrow_exception(error);
+    } catch (const std::exception& e) {
+        item.errorMessage = e.what();
+    } catch (...) {
+        item.errorMessage = "Unknown error";
+    }
+}
+
+} // namespace detail
+} // namespace client
+} // namespace dataapi
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include "dataapi/coro/Request.h"
+#include "client/ResponseDecoder.h"
+
+namespace dataapi {
+namespace client {
+namespace detail {
+
+/**
+ * 协程版本的请求、状态检查与解码，参数按值持有，挂起期间有效
+ */
+template<typename T>
+coro::Task<T> fetchAsync(http::HttpClient& client, HttpRequestConfig request, int expected,
+                         std::string message, std::string notFound = "") {
+    auto response = co_await coro::request(client, std::move(request));
+    expectStatus(response, expected, message, notFound);
+    co_return decode<T>(std::move(response));
+}
+
+template<typename T>
+coro::Task<PageResult<T>> fetchPageAsync(http::HttpClient& client, HttpRequestConfig request, std::string message) {
+    auto response = co_await coro::request(client, std::move(request));
+    expectStatus(response, 200, message);
+    co_return decodePage<T>(std::move(response));
+}
+
+inline coro::Task<void> sendAsync(http::HttpClient& client, HttpRequestConfig request, int expected,
+                                  std::string message, std::string notFound = "") {
+    auto response = co_await coro::request(client, std::move(request));
+    expectStatus(response, expected, message, notFound);
+}
+
+/**
+ * 构建GET请求
+ */
+inline HttpRequestConfig getRequest(std::string url, Parameters params = {}) {
+    HttpRequestConfig request;
+    request.method = HttpMethod::GET;
+    request.url = std::move(url);
+    request.params = std::move(params);
+    return request;
+}
+
+/**
+ * 构建DELETE请求
+ */
+inline HttpRequestConfig deleteRequest(std::string url) {
+    HttpRequestConfig request;
+    request.method = HttpMethod::DELETE;
+    request.url = std::move(url);
+    return request;
+}
+
+} // namespace detail
+} // namespace client
+} // namespace dataapi
@@ -0,0 +1,58 @@
+#include "client/BatchPlanner.h"
+#include <algorithm>
+
+namespace dataapi {
+namespace client {
+namespace detail {
+
+std::vector<BatchRange> splitBatch(const std::vector<std::string>& sqls, const BatchOptions& options) {
+    size_t maxStatements = std::max<size_t>(1, options.maxStatements);
+    std::vector<BatchRange> ranges;
+    size_t first = 0;
+    size_t bytes = 0;
+    for (size_t i = 0; i < sqls.size(); ++i) {
+        bool full = i - first >= maxStatements || (i > first && bytes + sqls[i].size() > options.maxBytes);
+        if (full) {
+            ranges.emplace_back(first, i);
+            first = i;
+            bytes = 0;
+        }
+        bytes += sqls[i].size();
+    }
+    if (first < sqls.size()) {
+        ranges.emplace_back(first, sqls.size());
+    }
+    return ranges;
+}
+
+void mergeBatch(BatchResult& total, BatchResult&& part, size_t offset) {
+    total.results.insert(total.results.end(),
+                         std::make_move_iterator(part.results.begin()),
+                         std::make_move_iterator(part.results.end()));
+    total.successCount += part.successCount;
+    total.errorCount += part.errorCount;
+
+    if (part.errors.is_null()) {
+        return;
+    }
+    if (!total.errors.is_array()) {
+        total.errors = Json::array();
+    }
+    if (!part.errors.is_array()) {
+        total.errors.push_back(std::move(part.errors));
+        return;
+    }
+    for (auto& error : part.errors) {
+        if (error.is_object()) {
+            auto index = error.find("index");
+            if (index != error.end() && index->is_number_integer()) {
+                *index = index->get<int64_t>() + static_cast<int64_t>(offset);
+            }
+        }
+        total.errors.push_back(std::move(error));
+    }
+}
+
+} // namespace detail
+} // namespace client
+} // namespace dataapi
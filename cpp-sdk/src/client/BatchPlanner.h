@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+#include "dataapi/Types.h"
+
+namespace dataapi {
+namespace client {
+namespace detail {
+
+/**
+ * 语句区间[first, second)
+ */
+using BatchRange = std::pair<size_t, size_t>;
+
+/**
+ * 按语句数和字节数上限将语句列表依次切分为分块
+ * 超过字节上限的单条语句独占一个分块；空列表返回空结果
+ */
+std::vector<BatchRange> splitBatch(const std::vector<std::string>& sqls, const BatchOptions& options);
+
+/**
+ * 将分块结果按顺序合并到total
+ * errors为数组时逐项追加，对象中的index字段加上分块起始位置offset，换算为整个列表中的下标
+ */
+void mergeBatch(BatchResult& total, BatchResult&& part, size_t offset);
+
+} // namespace detail
+} // namespace client
+} // namespace dataapi
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "dataapi/client/MetadataCache.h"
+
+namespace dataapi {
+namespace client {
+namespace detail {
+
+/**
+ * 通过缓存读取元数据，未设置缓存时直接调用load
+ */
+template<typename T, typename Loader>
+T cachedLookup(const std::shared_ptr<MetadataCache>& cache, MetadataKind kind,
+               const std::string& owner, const std::string& key, Loader&& load) {
+    if (!cache) {
+        return load();
+    }
+    return cache->template get<T>(kind, owner, key, std::forward<Loader>(load));
+}
+
+/**
+ * 修改请求结束时使缓存条目失效
+ * 请求失败时同样失效：超时等错误下无法确定服务端是否已应用修改
+ */
+class ScopedInvalidation {
+public:
+    ScopedInvalidation(std::shared_ptr<MetadataCache> cache, std::initializer_list<MetadataKind> kinds, std::string owner)
+        : cache(std::move(cache)), kinds(kinds), owner(std::move(owner)) {}
+
+    ~ScopedInvalidation() {
+        if (cache) {
+            for (MetadataKind kind : kinds) {
+                cache->invalidate(kind, owner);
+            }
+        }
+    }
+
+    ScopedInvalidation(const ScopedInvalidation&) = delete;
+    ScopedInvalidation& operator=(const ScopedInvalidation&) = delete;
+
+private:
+    std::shared_ptr<MetadataCache> cache;
+    std::vector<MetadataKind> kinds;
+    std::string owner;
+};
+
+} // namespace detail
+} // namespace client
+} // namespace dataapi
@@ -0,0 +1,111 @@
+#include "client/CompletionRegistry.h"
+
+namespace dataapi {
+namespace client {
+namespace detail {
+
+void CompletionRegistry::notify(Waiters& waiters, const WorkflowExecutionResult& result, std::exception_ptr error) {
+    for (auto& promise : waiters.promises) {
+        if (error) {
+            promise.set_exception(error);
+        } else {
+            promise.set_value(result);
+        }
+    }
+    for (auto& callback : waiters.callbacks) {
+        // 回调的异常不影响其他等待者
+        try {
+            callback(result, error);
+        } catch (...) {
+        }
+    }
+}
+
+std::future<WorkflowExecutionResult> CompletionRegistry::watch(const std::string& executionId) {
+    std::promise<WorkflowExecutionResult> promise;
+    std::future<WorkflowExecutionResult> future = promise.get_future();
+    Waiters ready;
+    WorkflowExecutionResult result;
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = retained.find(executionId);
+        if (found == retained.end() && !closed) {
+            waiting[executionId].promises.push_back(std::move(promise));
+            return future;
+        }
+        if (found != retained.end()) {
+            result = found->second;
+        } else {
+            error = closed;
+        }
+        ready.promises.push_back(std::move(promise));
+    }
+    notify(ready, result, error);
+    return future;
+}
+
+void CompletionRegistry::watch(const std::string& executionId, Callback callback) {
+    Waiters ready;
+    WorkflowExecutionResult result;
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = retained.find(executionId);
+        if (found == retained.end() && !closed) {
+            waiting[executionId].callbacks.push_back(std::move(callback));
+            return;
+        }
+        if (found != retained.end()) {
+            result = found->second;
+        } else {
+            error = closed;
+        }
+        ready.callbacks.push_back(std::move(callback));
+    }
+    notify(ready, result, error);
+}
+
+bool CompletionRegistry::complete(WorkflowExecutionResult result) {
+    Waiters waiters;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = waiting.find(result.executionId);
+        if (found == waiting.end()) {
+            if (retainLimit > 0 && retained.find(result.executionId) == retained.end()) {
+                retainOrder.push_back(result.executionId);
+                if (retainOrder.size() > retainLimit) {
+                    retained.erase(retainOrder.front());
+                    retainOrder.pop_front();
+                }
+                retained.emplace(result.executionId, std::move(result));
+            }
+            return false;
+        }
+        waiters = std::move(found->second);
+        waiting.erase(found);
+    }
+    notify(waiters, result, nullptr);
+    return true;
+}
+
+void CompletionRegistry::close(std::exception_ptr error) {
+    std::unordered_map<std::string, Waiters> pending;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = error;
+        pending.swap(waiting);
+    }
+    for (auto& entry : pending) {
+        notify(entry.second, WorkflowExecutionResult{}, error);
+    }
+}
+
+size_t CompletionRegistry::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return waiting.size();
+}
+
+} // namespace detail
+} // namespace client
+} // namespace dataapi
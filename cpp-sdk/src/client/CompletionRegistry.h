@@ -0,0 +1,70 @@
+#pragma once
+
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "dataapi/Types.h"
+
+namespace dataapi {
+namespace client {
+namespace detail {
+
+/**
+ * 按执行ID登记等待者，收到完成事件时通知
+ *
+ * 无人等待的完成结果保留最近retainLimit个，之后再登记的等待者立即得到结果，
+ * 避免执行在登记之前完成而错过事件。线程安全；通知在调用complete/close的线程上、
+ * 释放内部锁之后进行。
+ */
+class CompletionRegistry {
+public:
+    using Callback = std::function<void(WorkflowExecutionResult result, std::exception_ptr error)>;
+
+    explicit CompletionRegistry(size_t retainLimit) : retainLimit(retainLimit) {}
+
+    /**
+     * 登记等待者，结果已保留时立即通知
+     */
+    std::future<WorkflowExecutionResult> watch(const std::string& executionId);
+    void watch(const std::string& executionId, Callback callback);
+
+    /**
+     * 通知等待该执行的全部等待者
+     * @return 有等待者时返回true
+     */
+    bool complete(WorkflowExecutionResult result);
+
+    /**
+     * 以error通知全部等待者，此后登记的等待者同样立即失败
+     */
+    void close(std::exception_ptr error);
+
+    /**
+     * 等待中的执行数
+     */
+    size_t size() const;
+
+private:
+    struct Waiters {
+        std::vector<std::promise<WorkflowExecutionResult>> promises;
+        std::vector<Callback> callbacks;
+    };
+
+    static void notify(Waiters& waiters, const WorkflowExecutionResult& result, std::exception_ptr error);
+
+    mutable std::mutex mutex;
+    size_t retainLimit;
+    std::unordered_map<std::string, Waiters> waiting;
+    std::unordered_map<std::string, WorkflowExecutionResult> retained;
+    std::deque<std::string> retainOrder; // 最早保留的在前
+    std::exception_ptr closed;
+};
+
+} // namespace detail
+} // namespace client
+} // namespace dataapi
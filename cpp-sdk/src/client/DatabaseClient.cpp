@@ -1,96 +1,644 @@
 #include "dataapi/client/DatabaseClient.h"
 #include "dataapi/Types.h"
 #include "dataapi/exceptions/DataApiException.h"
-#include <sstream>
+#include "dataapi/utils/UrlUtils.h"
+#include "dataapi/error/DataApiError.h"
+#include "client/ResponseDecoder.h"
+#include "client/RowStreamParser.h"
+#include "client/FileWriter.h"
+#include "client/BatchPlanner.h"
+#include "client/CachedLookup.h"
+#include "client/PreparedQueryCache.h"
+#include "client/TimeSeriesFetch.h"
+#ifdef DATAAPI_WITH_COROUTINES
+#include "client/AsyncRequests.h"
+#endif
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <deque>
+#include <future>
 #include <stdexcept>
 #include <string>
 #include <memory>
+#include <ostream>
 
 namespace dataapi {
 namespace client {
 
-DatabaseClient::DatabaseClient(std::shared_ptr<http::HttpClient> httpClient) : httpClient(httpClient) {
+// 复用的预编译查询句柄上限
+static constexpr size_t kPreparedQueryCapacity = 256;
+
+DatabaseClient::DatabaseClient(std::shared_ptr<http::HttpClient> httpClient)
+    : httpClient(httpClient), preparedQueries(std::make_shared<detail::PreparedQueryCache>(kPreparedQueryCapacity)) {
+}
+
+DatabaseClient::~DatabaseClient() = default;
+
+/**
+ * 列表查询参数，过滤条件为空时省略
+ */
+static Parameters listParams(int page, int size, const std::string& projectId) {
+    Parameters params{{"page", std::to_string(page)}, {"size", std::to_string(size)}};
+    if (!projectId.empty()) {
+        params["projectId"] = projectId;
+    }
+    return params;
 }
 
 PageResult<DatabaseInfo> DatabaseClient::list(int page, int size, const std::string& projectId) {
-    std::ostringstream oss;
-    oss << "/databases?page=" << page << "&size=" << size;
-    
-    auto response = httpClient->get(oss.str());
-    if (response.statusCode != 200) {
-        throw std::runtime_error("Failed to list databases");
+    auto response = httpClient->get("/databases", listParams(page, size, projectId));
+    detail::expectStatus(response, 200, "Failed to list databases");
+    return detail::decodePage<DatabaseInfo>(std::move(response));
+}
+
+Paginator<DatabaseInfo> DatabaseClient::paginate(int size, const std::string& projectId, const PaginatorOptions& options) {
+    return Paginator<DatabaseInfo>(
+        [this, size, projectId](int page) {
+            return list(page, size, projectId);
+        },
+        options.pageBase, options);
+}
+
+DatabaseInfo DatabaseClient::getInfo(const std::string& databaseId) {
+    auto response = httpClient->get("/databases/" + databaseId);
+    detail::expectStatus(response, 200, "Failed to get database", "Database not found: " + databaseId);
+    return detail::decode<DatabaseInfo>(std::move(response));
+}
+
+DatabaseInfo DatabaseClient::update(const std::string& databaseId, const DatabaseUpdateRequest& request) {
+    detail::ScopedInvalidation invalidation(metadataCache, {MetadataKind::TableList, MetadataKind::TableSchema}, databaseId);
+    auto response = httpClient->request(detail::jsonRequest(HttpMethod::PUT, "/databases/" + databaseId, request));
+    detail::expectStatus(response, 200, "Failed to update database", "Database not found: " + databaseId);
+    return detail::decode<DatabaseInfo>(std::move(response));
+}
+
+void DatabaseClient::deleteDatabase(const std::string& databaseId) {
+    detail::ScopedInvalidation invalidation(metadataCache, {MetadataKind::TableList, MetadataKind::TableSchema}, databaseId);
+    auto response = httpClient->del("/databases/" + databaseId);
+    detail::expectStatus(response, 204, "Failed to delete database", "Database not found: " + databaseId);
+}
+
+// 空schema表示默认schema，不发送该参数
+static Parameters schemaParams(const std::string& schema) {
+    if (schema.empty()) {
+        return {};
     }
-    
-    Json json = Json::parse(response.body);
-    PageResult<DatabaseInfo> result;
-    
-    result.content.clear();
-    for (const auto& item : json["content"]) {
-        DatabaseInfo database;
-        from_json(item, database);
-        result.content.push_back(database);
+    return {{"schema", schema}};
+}
+
+std::vector<TableInfo> DatabaseClient::getTables(const std::string& databaseId, const std::string& schema) {
+    return detail::cachedLookup<std::vector<TableInfo>>(metadataCache, MetadataKind::TableList, databaseId, schema, [&] {
+        return detail::conditionalGet<std::vector<TableInfo>>(*httpClient, "/databases/" + databaseId + "/tables",
+                                                              "Failed to get tables", "Database not found: " + databaseId,
+                                                              schemaParams(schema));
+    });
+}
+
+TableSchema DatabaseClient::getTableSchema(const std::string& databaseId,
+                                           const std::string& tableName,
+                                           const std::string& schema) {
+    std::string key = schema + '\0' + tableName;
+    return detail::cachedLookup<TableSchema>(metadataCache, MetadataKind::TableSchema, databaseId, key, [&] {
+        return detail::conditionalGet<TableSchema>(*httpClient,
+                                                   "/databases/" + databaseId + "/tables/" + utils::UrlUtils::encode(tableName) + "/schema",
+                                                   "Failed to get table schema", "Table not found: " + tableName,
+                                                   schemaParams(schema));
+    });
+}
+
+void DatabaseClient::setMetadataCache(std::shared_ptr<MetadataCache> cache) {
+    metadataCache = std::move(cache);
+}
+
+std::shared_ptr<MetadataCache> DatabaseClient::getMetadataCache() const {
+    return metadataCache;
+}
+
+DatabaseConnectionResult DatabaseClient::testConnection(const DatabaseConfig& config) {
+    auto response = httpClient->request(detail::jsonRequest(HttpMethod::POST, "/databases/test-connection", config));
+    detail::expectStatus(response, 200, "Failed to test database connection", "Database configuration test failed");
+    return detail::decode<DatabaseConnectionResult>(std::move(response));
+}
+
+static HttpRequestConfig queryRequest(const std::string& databaseId,
+                                      const std::string& sql,
+                                      const Parameters& params) {
+    Json requestJson;
+    requestJson["sql"] = sql;
+    if (!params.empty()) {
+        requestJson["params"] = params;
     }
     
-    result.totalElements = json["totalElements"].get<long>();
-    result.totalPages = json["totalPages"].get<int>();
-    result.pageSize = json["size"].get<int>();
-    result.pageNumber = json["number"].get<int>();
-    result.first = json["first"].get<bool>();
-    result.last = json["last"].get<bool>();
-    result.empty = json.value("empty", false);
+    HttpRequestConfig request;
+    request.method = HttpMethod::POST;
+    request.url = "/databases/" + databaseId + "/execute";
+    request.data = std::move(requestJson);
+    return request;
+}
+
+static void checkQueryResponse(const http::HttpResponse& response, const std::string& databaseId) {
+    detail::expectStatus(response, 200, "Failed to execute SQL", "Database not found: " + databaseId);
+}
+
+/**
+ * 整体解码为QueryResult的查询请求，可协商二进制编码（流式解析的调用仍使用JSON）
+ */
+static HttpRequestConfig bulkQueryRequest(const std::string& databaseId, const std::string& sql, const Parameters& params) {
+    HttpRequestConfig request = queryRequest(databaseId, sql, params);
+    request.binaryResponse = true;
+    return request;
+}
+
+QueryResult DatabaseClient::executeQuery(const std::string& databaseId, const std::string& sql, const Parameters& params) {
+    auto response = httpClient->request(bulkQueryRequest(databaseId, sql, params));
+    checkQueryResponse(response, databaseId);
+    return detail::decode<QueryResult>(std::move(response));
+}
+
+std::shared_ptr<PreparedQuery> DatabaseClient::prepare(const std::string& databaseId, const std::string& sql) {
+    return preparedQueries->get(databaseId, sql, [&] {
+        auto query = std::make_shared<PreparedQuery>(httpClient, databaseId, sql);
+        query->prepare();
+        return query;
+    });
+}
+
+void DatabaseClient::closePrepared(const std::shared_ptr<PreparedQuery>& query) {
+    preparedQueries->erase(query->getDatabaseId(), query->getSql());
+    query->close();
+}
+
+std::string DatabaseClient::beginTransaction(const std::string& databaseId) {
+    auto response = httpClient->post("/databases/" + databaseId + "/transactions");
+    if (response.statusCode != 200 && response.statusCode != 201) {
+        detail::throwStatusError(response, "Failed to begin transaction", "Database not found: " + databaseId);
+    }
+    return detail::parseBody(std::move(response)).at("transactionId").get<std::string>();
+}
+
+/**
+ * 结束事务（commit或rollback）
+ */
+static void finishTransaction(http::HttpClient& httpClient, const std::string& databaseId,
+                              const std::string& transactionId, const char* action, const std::string& message) {
+    auto response = httpClient.post("/databases/" + databaseId + "/transactions/" + transactionId + "/" + action);
+    if (response.statusCode != 200 && response.statusCode != 204) {
+        detail::throwStatusError(response, message, "Transaction not found: " + transactionId);
+    }
+}
+
+void DatabaseClient::commitTransaction(const std::string& databaseId, const std::string& transactionId) {
+    finishTransaction(*httpClient, databaseId, transactionId, "commit", "Failed to commit transaction");
+}
+
+void DatabaseClient::rollbackTransaction(const std::string& databaseId, const std::string& transactionId) {
+    finishTransaction(*httpClient, databaseId, transactionId, "rollback", "Failed to rollback transaction");
+}
+
+QueryResult DatabaseClient::executeInTransaction(const std::string& databaseId,
+                                                 const std::string& transactionId,
+                                                 const std::string& sql,
+                                                 const Parameters& params) {
+    auto request = bulkQueryRequest(databaseId, sql, params);
+    request.url = "/databases/" + databaseId + "/transactions/" + transactionId + "/execute";
+    auto response = httpClient->request(request);
+    detail::expectStatus(response, 200, "Failed to execute SQL in transaction", "Transaction not found: " + transactionId);
+    return detail::decode<QueryResult>(std::move(response));
+}
+
+std::unique_ptr<Transaction> DatabaseClient::transaction(const std::string& databaseId, const TransactionOptions& options) {
+    return std::make_unique<Transaction>(httpClient, databaseId, options);
+}
+
+ColumnarResult DatabaseClient::executeQueryColumnar(const std::string& databaseId,
+                                                    const std::string& sql,
+                                                    const Parameters& params) {
+    ColumnarResult result;
+    detail::RowStreamParser parser(
+        "rows",
+        [&result](std::string_view text) {
+            result.appendRow(detail::parseJson(text));
+            return true;
+        },
+        [&result](const std::string& name, std::string_view text) {
+            Json value = detail::parseJson(text);
+            if (name == "columns") {
+                // 列信息在rows之后时，列已按行中的键建立
+                if (result.getRowCount() == 0) {
+                    result.setColumns(value.get<std::vector<std::string>>());
+                }
+            } else if (name == "totalRows" && value.is_number_integer()) {
+                result.totalRows = value.get<int>();
+            } else if (name == "metadata") {
+                result.metadata = std::move(value);
+            }
+        });
     
+    http::HttpResponse response = httpClient->request(queryRequest(databaseId, sql, params),
+                                                      [&parser](const char* data, size_t size) {
+                                                          return parser.feed(data, size);
+                                                      });
+    checkQueryResponse(response, databaseId);
+    if (!parser.isComplete()) {
+        throw std::runtime_error("Incomplete query result stream");
+    }
     return result;
 }
 
-DatabaseInfo DatabaseClient::getInfo(const std::string& databaseId) {
-    auto response = httpClient->get("/databases/" + databaseId);
-    if (response.statusCode == 404) {
-        throw std::runtime_error("Database not found: " + databaseId);
+BatchResult DatabaseClient::executeBatch(const std::string& databaseId,
+                                         const std::vector<std::string>& sqls,
+                                         const BatchOptions& options) {
+    auto sendChunk = [this, &databaseId, &sqls, &options](detail::BatchRange range) {
+        Json statements = Json::array();
+        auto& items = statements.get_ref<Json::array_t&>();
+        items.reserve(range.second - range.first);
+        for (size_t i = range.first; i < range.second; ++i) {
+            items.emplace_back(sqls[i]);
+        }
+        
+        HttpRequestConfig request;
+        request.method = HttpMethod::POST;
+        request.url = "/databases/" + databaseId + "/batch";
+        request.data = Json::object();
+        request.data["sqls"] = std::move(statements);
+        request.binaryResponse = true;
+        if (options.retryChunks) {
+            request.idempotent = true;
+        }
+        auto response = httpClient->request(request);
+        detail::expectStatus(response, 200, "Failed to execute batch", "Database not found: " + databaseId);
+        return detail::decode<BatchResult>(std::move(response));
+    };
+    
+    BatchResult total{};
+    std::vector<detail::BatchRange> chunks = detail::splitBatch(sqls, options);
+    if (chunks.size() == 1) {
+        return sendChunk(chunks.front());
     }
-    if (response.statusCode != 200) {
-        throw std::runtime_error("Failed to get database");
+    
+    // 按顺序合并：队首完成后立即补发下一个分块，保持在途数不超过concurrency
+    size_t window = static_cast<size_t>(std::max(1, options.concurrency));
+    std::deque<std::future<BatchResult>> inflight;
+    size_t next = 0;
+    for (size_t merged = 0; merged < chunks.size(); ++merged) {
+        while (inflight.size() < window && next < chunks.size()) {
+            inflight.push_back(std::async(std::launch::async, sendChunk, chunks[next++]));
+        }
+        BatchResult part = inflight.front().get();
+        inflight.pop_front();
+        detail::mergeBatch(total, std::move(part), chunks[merged].first);
     }
+    return total;
+}
+
+std::unique_ptr<QueryCursor> DatabaseClient::openCursor(const std::string& databaseId,
+                                                        const std::string& sql,
+                                                        const Parameters& params,
+                                                        const CursorOptions& options) {
+    return std::make_unique<QueryCursor>(
+        httpClient, queryRequest(databaseId, sql, params),
+        [databaseId](const http::HttpResponse& response) { checkQueryResponse(response, databaseId); },
+        options);
+}
+
+size_t DatabaseClient::streamQuery(const std::string& databaseId,
+                                   const std::string& sql,
+                                   const std::function<bool(const Json& row)>& onRow,
+                                   const Parameters& params) {
+    size_t count = 0;
+    bool stopped = false;
+    detail::RowStreamParser parser(
+        "rows",
+        [&](std::string_view text) {
+            ++count;
+            if (!onRow(detail::parseJson(text))) {
+                stopped = true;
+                return false;
+            }
+            return true;
+        },
+        nullptr);
     
-    Json json = Json::parse(response.body);
-    DatabaseInfo database;
-    from_json(json, database);
-    return database;
+    http::HttpResponse response;
+    try {
+        response = httpClient->request(queryRequest(databaseId, sql, params), [&parser](const char* data, size_t size) {
+            return parser.feed(data, size);
+        });
+    } catch (const error::NetworkError&) {
+        // 回调要求停止时传输被主动中止
+        if (stopped) {
+            return count;
+        }
+        throw;
+    }
+    checkQueryResponse(response, databaseId);
+    if (!parser.isComplete()) {
+        throw std::runtime_error("Incomplete query result stream");
+    }
+    return count;
 }
 
-DatabaseConnectionResult DatabaseClient::testConnection(const DatabaseConfig& config) {
-    Json configJson;
-    to_json(configJson, config);
-    auto response = httpClient->post("/databases/test-connection", configJson);
-    if (response.statusCode == 404) {
-        throw std::runtime_error("Database configuration test failed");
+DatabaseMetrics DatabaseClient::getMetrics(const std::string& databaseId,
+                                           const std::string& startTime,
+                                           const std::string& endTime) {
+    Parameters params;
+    if (!startTime.empty()) {
+        params["startTime"] = startTime;
+    }
+    if (!endTime.empty()) {
+        params["endTime"] = endTime;
     }
-    if (response.statusCode != 200) {
-        throw std::runtime_error("Failed to test database connection");
+    auto response = httpClient->get("/databases/" + databaseId + "/metrics", std::move(params));
+    detail::expectStatus(response, 200, "Failed to get database metrics", "Database not found: " + databaseId);
+    return detail::decode<DatabaseMetrics>(std::move(response));
+}
+
+TimeSeries DatabaseClient::getMetricsSeries(const std::string& databaseId,
+                                            Timestamp start,
+                                            Timestamp end,
+                                            const TimeSeriesOptions& options) {
+    return detail::fetchTimeSeries(*httpClient, "/databases/" + databaseId + "/metrics/series", start, end, options,
+                                   "Failed to get database metrics", "Database not found: " + databaseId);
+}
+
+TimeSeriesTracker DatabaseClient::trackMetrics(const std::string& databaseId,
+                                               std::chrono::milliseconds range,
+                                               const TimeSeriesOptions& options) {
+    // 捕获HttpClient的共享指针，跟踪器可比DatabaseClient存活更久
+    return TimeSeriesTracker([client = httpClient, databaseId, options](Timestamp start, Timestamp end) {
+        return detail::fetchTimeSeries(*client, "/databases/" + databaseId + "/metrics/series", start, end, options,
+                                       "Failed to get database metrics", "Database not found: " + databaseId);
+    }, range);
+}
+
+QueryResult DatabaseClient::getTablePreview(const std::string& databaseId,
+                                            const std::string& tableName,
+                                            int limit,
+                                            const std::string& schema) {
+    HttpRequestConfig request;
+    request.method = HttpMethod::GET;
+    request.url = "/databases/" + databaseId + "/tables/" + utils::UrlUtils::encode(tableName) + "/preview";
+    request.params = {{"limit", std::to_string(limit)}};
+    if (!schema.empty()) {
+        request.params["schema"] = schema;
     }
+    request.binaryResponse = true;
     
-    Json json = Json::parse(response.body);
-    DatabaseConnectionResult result;
-    from_json(json, result);
-    return result;
+    auto response = httpClient->request(request);
+    detail::expectStatus(response, 200, "Failed to get table preview", "Table not found: " + tableName);
+    return detail::decode<QueryResult>(std::move(response));
 }
 
-QueryResult DatabaseClient::executeQuery(const std::string& databaseId, const std::string& sql, const Parameters& params) {
+static HttpRequestConfig exportRequest(const std::string& databaseId,
+                                       const std::string& sql,
+                                       const std::string& format,
+                                       const Parameters& params) {
     Json requestJson;
     requestJson["sql"] = sql;
+    requestJson["format"] = format;
+    if (!params.empty()) {
+        requestJson["params"] = params;
+    }
     
-    auto response = httpClient->post("/databases/" + databaseId + "/execute", requestJson);
-    if (response.statusCode == 404) {
-        throw std::runtime_error("Database not found: " + databaseId);
+    HttpRequestConfig request;
+    request.method = HttpMethod::POST;
+    request.url = "/databases/" + databaseId + "/export";
+    request.data = std::move(requestJson);
+    return request;
+}
+
+std::string DatabaseClient::exportQueryResult(const std::string& databaseId,
+                                              const std::string& sql,
+                                              const std::string& format,
+                                              const Parameters& params) {
+    auto response = httpClient->request(exportRequest(databaseId, sql, format, params));
+    detail::expectStatus(response, 200, "Failed to export query result", "Database not found: " + databaseId);
+    return std::move(response.body);
+}
+
+void DatabaseClient::exportQueryResult(const std::string& databaseId,
+                                       const std::string& sql,
+                                       std::ostream& out,
+                                       const std::string& format,
+                                       const Parameters& params) {
+    auto response = httpClient->request(exportRequest(databaseId, sql, format, params), out);
+    detail::expectStatus(response, 200, "Failed to export query result", "Database not found: " + databaseId);
+}
+
+void DatabaseClient::exportQueryResult(const std::string& databaseId,
+                                       const std::string& sql,
+                                       http::BodySink sink,
+                                       const std::string& format,
+                                       const Parameters& params) {
+    bool stopped = false;
+    http::HttpResponse response;
+    try {
+        response = httpClient->request(exportRequest(databaseId, sql, format, params),
+                                       [&sink, &stopped](const char* data, size_t size) {
+                                           stopped = !sink(data, size);
+                                           return !stopped;
+                                       });
+    } catch (const error::NetworkError&) {
+        // 接收器要求停止时传输被主动中止
+        if (stopped) {
+            return;
+        }
+        throw;
+    }
+    detail::expectStatus(response, 200, "Failed to export query result", "Database not found: " + databaseId);
+}
+
+/**
+ * 解析Content-Range头部（bytes start-end/total，416响应中start-end为*）
+ * @return 起始位置和总长度，无法解析的部分为-1
+ */
+static std::pair<int64_t, int64_t> parseContentRange(const http::ResponseHeaders& headers) {
+    std::pair<int64_t, int64_t> range(-1, -1);
+    auto value = headers.get("Content-Range");
+    if (!value) {
+        return range;
     }
-    if (response.statusCode != 200) {
-        throw std::runtime_error("Failed to execute SQL");
+    std::string text(*value);
+    size_t space = text.find(' ');
+    size_t slash = text.find('/');
+    if (space == std::string::npos || slash == std::string::npos || slash < space) {
+        return range;
     }
-    
-    Json json = Json::parse(response.body);
-    QueryResult result;
-    from_json(json, result);
-    return result;
+    if (std::isdigit(static_cast<unsigned char>(text[space + 1]))) {
+        range.first = std::strtoll(text.c_str() + space + 1, nullptr, 10);
+    }
+    if (slash + 1 < text.size() && std::isdigit(static_cast<unsigned char>(text[slash + 1]))) {
+        range.second = std::strtoll(text.c_str() + slash + 1, nullptr, 10);
+    }
+    return range;
+}
+
+/**
+ * 将导出的响应体写入writer，传输中断时按已写入的长度续传
+ */
+static uint64_t exportToWriter(http::HttpClient& httpClient,
+                               const HttpRequestConfig& exportConfig,
+                               detail::FileWriter& writer,
+                               const ExportOptions& options,
+                               const std::string& databaseId) {
+    // 续传已有文件时先假定服务端支持Range，之后以服务端的响应为准
+    bool rangeSupported = writer.size() > 0;
+    for (int attempt = 0; ; ++attempt) {
+        uint64_t offset = writer.size();
+        HttpRequestConfig request = exportConfig;
+        if (offset > 0) {
+            request.headers["Range"] = "bytes=" + std::to_string(offset) + "-";
+        }
+        
+        bool started = false;
+        http::HttpResponse response;
+        try {
+            response = httpClient.request(
+                request,
+                [&writer](const char* data, size_t size) {
+                    writer.write(data, size);
+                    return true;
+                },
+                [&](int statusCode, const http::ResponseHeaders& headers) {
+                    started = true;
+                    if (statusCode == 206) {
+                        int64_t start = parseContentRange(headers).first;
+                        if (start >= 0 && static_cast<uint64_t>(start) != offset) {
+                            throw std::runtime_error("Unexpected Content-Range in export response");
+                        }
+                    } else if (offset > 0) {
+                        // 服务端忽略了Range，返回完整内容
+                        writer.rewind();
+                    }
+                    auto ranges = headers.get("Accept-Ranges");
+                    rangeSupported = statusCode == 206 || (ranges && *ranges == "bytes");
+                });
+        } catch (const error::DataApiError& e) {
+            bool interrupted = dynamic_cast<const error::NetworkError*>(&e) ||
+                dynamic_cast<const error::TimeoutError*>(&e);
+            if (!interrupted || !rangeSupported || writer.size() == 0 || attempt >= options.maxResumeAttempts) {
+                throw;
+            }
+            continue;
+        }
+        
+        if (response.statusCode == 416 && offset > 0 &&
+            parseContentRange(response.headers).second == static_cast<int64_t>(offset)) {
+            // 续传的起点已是末尾，文件已完整
+            return offset;
+        }
+        if (response.statusCode != 200 && response.statusCode != 206) {
+            detail::throwStatusError(response, "Failed to export query result", "Database not found: " + databaseId);
+        }
+        if (!started && response.statusCode == 200 && offset > 0) {
+            writer.rewind();
+        }
+        writer.flush();
+        return writer.size();
+    }
+}
+
+uint64_t DatabaseClient::exportQueryResultToFile(const std::string& databaseId,
+                                                 const std::string& sql,
+                                                 const std::string& path,
+                                                 const ExportOptions& options,
+                                                 const Parameters& params) {
+    detail::FileWriter writer(path, options.resume, options.bufferSize);
+    return exportToWriter(*httpClient, exportRequest(databaseId, sql, options.format, params),
+                          writer, options, databaseId);
+}
+
+uint64_t DatabaseClient::exportQueryResultToFd(const std::string& databaseId,
+                                               const std::string& sql,
+                                               int fd,
+                                               const ExportOptions& options,
+                                               const Parameters& params) {
+    detail::FileWriter writer(fd, options.bufferSize);
+    return exportToWriter(*httpClient, exportRequest(databaseId, sql, options.format, params),
+                          writer, options, databaseId);
+}
+
+static HttpRequestConfig importRequest(const std::string& databaseId,
+                                       const std::string& tableName,
+                                       const std::string& format,
+                                       const ImportOptions& options) {
+    // 请求体为原始数据，导入选项通过查询参数传递
+    auto request = detail::uploadRequest("/databases/" + databaseId + "/tables/" + utils::UrlUtils::encode(tableName) + "/import",
+                                         format);
+    request.params["format"] = format;
+    request.params["hasHeader"] = options.hasHeader ? "true" : "false";
+    if (!options.delimiter.empty()) {
+        request.params["delimiter"] = options.delimiter;
+    }
+    if (!options.encoding.empty()) {
+        request.params["encoding"] = options.encoding;
+    }
+    if (!options.mappings.is_null()) {
+        request.params["mappings"] = options.mappings.dump();
+    }
+    if (options.additionalOptions.is_object()) {
+        for (const auto& item : options.additionalOptions.items()) {
+            const Json& value = item.value();
+            request.params.emplace(item.key(), value.is_string() ? value.get<std::string>() : value.dump());
+        }
+    }
+    return request;
 }
 
+static ImportResult finishImport(http::HttpResponse&& response, const std::string& tableName) {
+    detail::expectStatus(response, 200, "Failed to import data", "Table not found: " + tableName);
+    return detail::decode<ImportResult>(std::move(response));
+}
+
+ImportResult DatabaseClient::importData(const std::string& databaseId,
+                                        const std::string& tableName,
+                                        const std::string& data,
+                                        const std::string& format,
+                                        const ImportOptions& options) {
+    const std::string& dataFormat = format.empty() ? options.format : format;
+    auto response = httpClient->upload(importRequest(databaseId, tableName, dataFormat, options),
+                                       http::memoryBody(data));
+    return finishImport(std::move(response), tableName);
+}
+
+ImportResult DatabaseClient::importData(const std::string& databaseId,
+                                        const std::string& tableName,
+                                        http::UploadBody body,
+                                        const ImportOptions& options,
+                                        http::UploadProgress onProgress) {
+    const std::string format = options.format.empty() ? "csv" : options.format;
+    auto response = httpClient->upload(importRequest(databaseId, tableName, format, options),
+                                       std::move(body), std::move(onProgress));
+    return finishImport(std::move(response), tableName);
+}
+
+ImportResult DatabaseClient::importFile(const std::string& databaseId,
+                                        const std::string& tableName,
+                                        const std::string& path,
+                                        const ImportOptions& options,
+                                        http::UploadProgress onProgress) {
+    return importData(databaseId, tableName, http::fileBody(path), options, std::move(onProgress));
+}
+
+#ifdef DATAAPI_WITH_COROUTINES
+
+coro::Task<PageResult<DatabaseInfo>> DatabaseClient::listAsync(int page, int size, std::string projectId) {
+    return detail::fetchPageAsync<DatabaseInfo>(*httpClient, detail::getRequest("/databases", listParams(page, size, projectId)),
+                                                "Failed to list databases");
+}
+
+coro::Task<DatabaseInfo> DatabaseClient::getInfoAsync(std::string databaseId) {
+    return detail::fetchAsync<DatabaseInfo>(*httpClient, detail::getRequest("/databases/" + databaseId),
+                                            200, "Failed to get database", "Database not found: " + databaseId);
+}
+
+coro::Task<QueryResult> DatabaseClient::executeQueryAsync(std::string databaseId, std::string sql, Parameters params) {
+    return detail::fetchAsync<QueryResult>(*httpClient, bulkQueryRequest(databaseId, sql, params),
+                                           200, "Failed to execute SQL", "Database not found: " + databaseId);
+}
+
+#endif
+
 } // namespace client
 } // namespace dataapi
\ No newline at end of file
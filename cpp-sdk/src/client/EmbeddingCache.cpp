@@ -0,0 +1,398 @@
+#include "dataapi/client/EmbeddingCache.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <openssl/evp.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace dataapi {
+namespace client {
+
+namespace {
+
+// 文件头与记录头：32字节键 + 4字节维数 + 4字节保留，其后为主机字节序的float
+const char kDiskMagic[8] = {'D', 'A', 'E', 'M', 'B', 'C', '0', '2'};
+const size_t kRecordHeader = 40;
+
+std::runtime_error diskError(const char* action, const std::string& path) {
+    return std::runtime_error(std::string("Failed to ") + action + " embedding cache " + path + ": " + std::strerror(errno));
+}
+
+bool writeAll(int fd, const char* data, size_t size, off_t offset) {
+    while (size > 0) {
+        ssize_t count = ::pwrite(fd, data, size, offset);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += count;
+        size -= static_cast<size_t>(count);
+        offset += count;
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * 只追加的磁盘层
+ * 打开时扫描全部记录建立索引并截去不完整的尾部记录；读取通过只读映射，
+ * 映射范围落后于文件末尾时重新映射。写入失败或达到容量后静默停止追加
+ */
+class EmbeddingCache::DiskTier {
+public:
+    DiskTier(const std::string& path, uint64_t capacity) : path(path), capacity(capacity) {
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            throw diskError("open", path);
+        }
+        try {
+            load();
+        } catch (...) {
+            unmap();
+            ::close(fd);
+            throw;
+        }
+    }
+
+    ~DiskTier() {
+        unmap();
+        ::close(fd);
+    }
+
+    bool read(const Key& key, Vector& vector) {
+        auto found = offsets.find(key);
+        if (found == offsets.end()) {
+            return false;
+        }
+        if (found->second + kRecordHeader > mapped && !remap()) {
+            return false;
+        }
+        uint32_t count;
+        std::memcpy(&count, data + found->second + sizeof(Key), sizeof(count));
+        vector.resize(count);
+        std::memcpy(vector.data(), data + found->second + kRecordHeader, count * sizeof(float));
+        return true;
+    }
+
+    void append(const Key& key, const Vector& vector) {
+        uint64_t size = kRecordHeader + vector.size() * sizeof(float);
+        if (failed || end + size > capacity || offsets.count(key)) {
+            return;
+        }
+        std::vector<char> record(size, 0);
+        uint32_t count = static_cast<uint32_t>(vector.size());
+        std::memcpy(record.data(), key.data(), sizeof(Key));
+        std::memcpy(record.data() + sizeof(Key), &count, sizeof(count));
+        std::memcpy(record.data() + kRecordHeader, vector.data(), vector.size() * sizeof(float));
+        if (!writeAll(fd, record.data(), record.size(), static_cast<off_t>(end))) {
+            failed = true;
+            (void)::ftruncate(fd, static_cast<off_t>(end));
+            return;
+        }
+        offsets[key] = end;
+        end += size;
+    }
+
+private:
+    void load() {
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            throw diskError("stat", path);
+        }
+        uint64_t size = static_cast<uint64_t>(info.st_size);
+        if (size == 0) {
+            if (!writeAll(fd, kDiskMagic, sizeof(kDiskMagic), 0)) {
+                throw diskError("write", path);
+            }
+            end = sizeof(kDiskMagic);
+            return;
+        }
+
+        end = size;
+        if (!remap()) {
+            throw diskError("map", path);
+        }
+        if (size < sizeof(kDiskMagic) || std::memcmp(data, kDiskMagic, sizeof(kDiskMagic)) != 0) {
+            throw std::runtime_error("Failed to open embedding cache " + path + ": unrecognized format");
+        }
+
+        uint64_t offset = sizeof(kDiskMagic);
+        while (offset + kRecordHeader <= size) {
+            Key key;
+            uint32_t count;
+            std::memcpy(key.data(), data + offset, sizeof(Key));
+            std::memcpy(&count, data + offset + sizeof(Key), sizeof(count));
+            uint64_t length = kRecordHeader + uint64_t(count) * sizeof(float);
+            if (offset + length > size) {
+                break;
+            }
+            offsets[key] = offset;
+            offset += length;
+        }
+        if (offset < size) {
+            // 上次写入中断留下的半条记录
+            end = offset;
+            (void)::ftruncate(fd, static_cast<off_t>(end));
+            remap();
+        }
+    }
+
+    bool remap() {
+        unmap();
+        if (end == 0) {
+            return false;
+        }
+        void* region = ::mmap(nullptr, end, PROT_READ, MAP_SHARED, fd, 0);
+        if (region == MAP_FAILED) {
+            return false;
+        }
+        data = static_cast<const char*>(region);
+        mapped = end;
+        return true;
+    }
+
+    void unmap() {
+        if (data) {
+            ::munmap(const_cast<char*>(data), mapped);
+            data = nullptr;
+            mapped = 0;
+        }
+    }
+
+    std::string path;
+    int fd = -1;
+    uint64_t capacity;
+    uint64_t end = 0;
+    bool failed = false;
+    const char* data = nullptr;
+    uint64_t mapped = 0;
+    std::unordered_map<Key, uint64_t, KeyHash> offsets;
+};
+
+/**
+ * 同一scope下排队等待发出的文本
+ */
+struct EmbeddingCache::Batch {
+    std::string scope;
+    std::vector<std::string> texts;
+    std::vector<Key> keys;
+    std::vector<std::promise<Vector>> promises;
+    std::chrono::steady_clock::time_point deadline;
+    bool sealed = false; // 已不再接受新的文本
+};
+
+size_t EmbeddingCache::KeyHash::operator()(const Key& key) const {
+    size_t hash;
+    std::memcpy(&hash, key.data(), sizeof(hash));
+    return hash;
+}
+
+EmbeddingCache::EmbeddingCache(const EmbeddingCacheOptions& options) : options(options) {
+    this->options.maxBatchSize = std::max<size_t>(1, options.maxBatchSize);
+    if (!options.diskPath.empty()) {
+        disk = std::make_unique<DiskTier>(options.diskPath, options.maxDiskBytes);
+    }
+}
+
+EmbeddingCache::~EmbeddingCache() = default;
+
+EmbeddingCache::Key EmbeddingCache::makeKey(const std::string& scope, const std::string& text) {
+    // scope带长度前缀，避免不同的scope与文本拼接出相同的输入
+    uint64_t scopeLength = scope.size();
+    Key key;
+    unsigned int length = 0;
+    EVP_MD_CTX* context = EVP_MD_CTX_new();
+    bool ok = context &&
+              EVP_DigestInit_ex(context, EVP_sha256(), nullptr) == 1 &&
+              EVP_DigestUpdate(context, &scopeLength, sizeof(scopeLength)) == 1 &&
+              EVP_DigestUpdate(context, scope.data(), scope.size()) == 1 &&
+              EVP_DigestUpdate(context, text.data(), text.size()) == 1 &&
+              EVP_DigestFinal_ex(context, key.data(), &length) == 1;
+    EVP_MD_CTX_free(context);
+    if (!ok || length != key.size()) {
+        throw std::runtime_error("Failed to compute embedding cache key");
+    }
+    return key;
+}
+
+bool EmbeddingCache::lookupLocked(const Key& key, Vector& vector) {
+    auto found = index.find(key);
+    if (found != index.end()) {
+        entries.splice(entries.begin(), entries, found->second);
+        vector = found->second->second;
+        ++stats.memoryHits;
+        return true;
+    }
+    if (disk && disk->read(key, vector)) {
+        ++stats.diskHits;
+        storeLocked(key, vector, false);
+        return true;
+    }
+    return false;
+}
+
+void EmbeddingCache::storeLocked(const Key& key, const Vector& vector, bool persist) {
+    if (persist && disk) {
+        disk->append(key, vector);
+    }
+    if (options.maxEntries == 0) {
+        return;
+    }
+    auto found = index.find(key);
+    if (found != index.end()) {
+        found->second->second = vector;
+        entries.splice(entries.begin(), entries, found->second);
+        return;
+    }
+    entries.emplace_front(key, vector);
+    index[key] = entries.begin();
+    while (entries.size() > options.maxEntries) {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+}
+
+bool EmbeddingCache::lookup(const Key& key, Vector& vector) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return lookupLocked(key, vector);
+}
+
+void EmbeddingCache::store(const Key& key, const Vector& vector) {
+    std::lock_guard<std::mutex> lock(mutex);
+    storeLocked(key, vector, true);
+}
+
+void EmbeddingCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    index.clear();
+    entries.clear();
+}
+
+size_t EmbeddingCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+EmbeddingCacheStats EmbeddingCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+std::vector<EmbeddingCache::Vector> EmbeddingCache::resolve(const std::string& scope,
+                                                           const std::vector<std::string>& texts,
+                                                           const Fetcher& fetch) {
+    std::vector<Key> keys;
+    keys.reserve(texts.size());
+    for (const auto& text : texts) {
+        keys.push_back(makeKey(scope, text));
+    }
+
+    std::vector<Vector> results(texts.size());
+    std::vector<std::pair<size_t, std::shared_future<Vector>>> waits;
+    std::vector<std::shared_ptr<Batch>> led; // 本调用负责发出的批次
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 0; i < texts.size(); ++i) {
+            if (lookupLocked(keys[i], results[i])) {
+                continue;
+            }
+            auto pending = inflight.find(keys[i]);
+            if (pending != inflight.end()) {
+                ++stats.coalesced;
+                waits.emplace_back(i, pending->second);
+                continue;
+            }
+
+            std::shared_ptr<Batch>& slot = open[scope];
+            if (!slot) {
+                slot = std::make_shared<Batch>();
+                slot->scope = scope;
+                slot->deadline = std::chrono::steady_clock::now() + options.batchWindow;
+                led.push_back(slot);
+            }
+            std::shared_ptr<Batch> batch = slot;
+            batch->texts.push_back(texts[i]);
+            batch->keys.push_back(keys[i]);
+            batch->promises.emplace_back();
+            std::shared_future<Vector> future = batch->promises.back().get_future().share();
+            inflight.emplace(keys[i], future);
+            waits.emplace_back(i, std::move(future));
+            if (batch->texts.size() >= options.maxBatchSize) {
+                batch->sealed = true;
+                open.erase(scope);
+                sealed.notify_all();
+            }
+        }
+    }
+
+    for (const auto& batch : led) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            sealed.wait_until(lock, batch->deadline, [&] { return batch->sealed; });
+            if (!batch->sealed) {
+                batch->sealed = true;
+                auto found = open.find(batch->scope);
+                if (found != open.end() && found->second == batch) {
+                    open.erase(found);
+                }
+            }
+        }
+        dispatch(batch, fetch);
+    }
+
+    for (auto& wait : waits) {
+        results[wait.first] = wait.second.get();
+    }
+    return results;
+}
+
+void EmbeddingCache::dispatch(const std::shared_ptr<Batch>& batch, const Fetcher& fetch) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++stats.requests;
+        stats.fetched += batch->texts.size();
+    }
+
+    std::vector<Vector> vectors;
+    try {
+        vectors = fetch(batch->texts);
+        if (vectors.size() != batch->texts.size()) {
+            throw std::runtime_error("Embedding response count mismatch: expected " +
+                                     std::to_string(batch->texts.size()) + ", got " +
+                                     std::to_string(vectors.size()));
+        }
+    } catch (...) {
+        std::exception_ptr error = std::current_exception();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const auto& key : batch->keys) {
+                inflight.erase(key);
+            }
+        }
+        for (auto& promise : batch->promises) {
+            promise.set_exception(error);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 0; i < batch->keys.size(); ++i) {
+            storeLocked(batch->keys[i], vectors[i], true);
+            inflight.erase(batch->keys[i]);
+        }
+    }
+    for (size_t i = 0; i < vectors.size(); ++i) {
+        batch->promises[i].set_value(std::move(vectors[i]));
+    }
+}
+
+} // namespace client
+} // namespace dataapi
@@ -0,0 +1,189 @@
+#include "client/EmbeddingDecoder.h"
+#include "client/ResponseDecoder.h"
+#include <charconv>
+#include <stdexcept>
+#include <vector>
+
+namespace dataapi {
+namespace client {
+namespace detail {
+
+namespace {
+
+/**
+ * 单遍扫描响应体，只识别顶层对象的结构
+ */
+class Scanner {
+public:
+    explicit Scanner(std::string_view text) : position(text.data()), end(text.data() + text.size()) {}
+
+    void skipSpace() {
+        while (position < end && (*position == ' ' || *position == '\n' || *position == '\r' || *position == '\t')) {
+            ++position;
+        }
+    }
+
+    bool consume(char c) {
+        skipSpace();
+        if (position < end && *position == c) {
+            ++position;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(char c) {
+        if (!consume(c)) {
+            fail();
+        }
+    }
+
+    /**
+     * 读取字符串的原始内容（不处理转义）
+     */
+    std::string_view string() {
+        expect('"');
+        const char* begin = position;
+        while (position < end && *position != '"') {
+            position += *position == '\\' ? 2 : 1;
+        }
+        if (position >= end) {
+            fail();
+        }
+        return std::string_view(begin, static_cast<size_t>(position++ - begin));
+    }
+
+    /**
+     * 跳过任意值，返回其文本
+     */
+    std::string_view value() {
+        skipSpace();
+        const char* begin = position;
+        int depth = 0;
+        while (position < end) {
+            char c = *position;
+            if (c == '"') {
+                string();
+                continue;
+            }
+            if (c == '{' || c == '[') {
+                ++depth;
+            } else if (c == '}' || c == ']') {
+                if (depth == 0) {
+                    break;
+                }
+                --depth;
+            } else if (c == ',' && depth == 0) {
+                break;
+            }
+            ++position;
+        }
+        if (depth != 0 || position == begin) {
+            fail();
+        }
+        return std::string_view(begin, static_cast<size_t>(position - begin));
+    }
+
+    /**
+     * 解析数值的二维数组
+     */
+    void matrix(EmbeddingMatrix& matrix) {
+        expect('[');
+        if (consume(']')) {
+            return;
+        }
+        std::vector<float> row;
+        do {
+            skipSpace();
+            const char* rowStart = position;
+            expect('[');
+            row.clear();
+            if (!consume(']')) {
+                do {
+                    skipSpace();
+                    float number;
+                    auto parsed = std::from_chars(position, end, number);
+                    if (parsed.ec != std::errc()) {
+                        fail();
+                    }
+                    position = parsed.ptr;
+                    row.push_back(number);
+                } while (consume(','));
+                expect(']');
+            }
+            matrix.appendRow(row);
+            if (matrix.rows() == 1) {
+                // 按首行的文本长度估算总行数，避免逐行扩容
+                size_t perRow = static_cast<size_t>(position - rowStart) + 1;
+                matrix.reserve(1 + static_cast<size_t>(end - position) / perRow);
+            }
+        } while (consume(','));
+        expect(']');
+    }
+
+    bool atEnd() {
+        skipSpace();
+        return position == end;
+    }
+
+    [[noreturn]] static void fail() {
+        throw std::invalid_argument("Unexpected embedding response structure");
+    }
+
+private:
+    const char* position;
+    const char* end;
+};
+
+EmbeddingResult scan(std::string_view body, EmbeddingPrecision precision) {
+    EmbeddingResult result;
+    result.embeddings = EmbeddingMatrix(precision);
+    bool found = false;
+    Scanner scanner(body);
+    scanner.expect('{');
+    if (!scanner.consume('}')) {
+        do {
+            std::string_view key = scanner.string();
+            scanner.expect(':');
+            if (key == "embeddings") {
+                scanner.matrix(result.embeddings);
+                found = true;
+                continue;
+            }
+            std::string_view text = scanner.value();
+            if (key == "model") {
+                Json model = parseJson(text);
+                if (model.is_string()) {
+                    result.model = model.get<std::string>();
+                }
+            } else if (key == "usage") {
+                result.usage = parseJson(text);
+            } else if (key == "metadata") {
+                result.metadata = parseJson(text);
+            }
+        } while (scanner.consume(','));
+        scanner.expect('}');
+    }
+    if (!found || !scanner.atEnd()) {
+        Scanner::fail();
+    }
+    return result;
+}
+
+} // namespace
+
+EmbeddingResult decodeEmbeddings(std::string_view body, EmbeddingPrecision precision) {
+    try {
+        return scan(body, precision);
+    } catch (const std::invalid_argument&) {
+        // 行内出现对象、null等非数值元素时按通用路径解析，结构错误由from_json报告
+    }
+    EmbeddingResult result;
+    result.embeddings = EmbeddingMatrix(precision);
+    from_json(parseJson(body), result);
+    return result;
+}
+
+} // namespace detail
+} // namespace client
+} // namespace dataapi
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string_view>
+#include "dataapi/Types.h"
+
+namespace dataapi {
+namespace client {
+namespace detail {
+
+/**
+ * 解码嵌入响应体
+ * embeddings数组直接从文本解析为float写入连续缓冲区，不构建Json节点；
+ * 其余字段按Json解析。响应结构不符合预期时退回完整的Json解析
+ * @param body 响应体
+ * @param precision 存储精度
+ */
+EmbeddingResult decodeEmbeddings(std::string_view body, EmbeddingPrecision precision);
+
+} // namespace detail
+} // namespace client
+} // namespace dataapi
@@ -0,0 +1,103 @@
+#include "client/EventStreamParser.h"
+#include <cstring>
+
+namespace dataapi {
+namespace client {
+namespace detail {
+
+EventStreamParser::EventStreamParser(EventHandler onEvent, Framing framing)
+    : onEvent(std::move(onEvent)), framing(framing) {
+}
+
+bool EventStreamParser::feed(const char* data, size_t size) {
+    const char* end = data + size;
+    while (data < end && !stopped) {
+        if (skipLineFeed) {
+            skipLineFeed = false;
+            if (*data == '\n') {
+                ++data;
+                continue;
+            }
+        }
+        const char* lineEnd = data;
+        while (lineEnd < end && *lineEnd != '\n' && *lineEnd != '\r') {
+            ++lineEnd;
+        }
+        line.append(data, static_cast<size_t>(lineEnd - data));
+        if (lineEnd == end) {
+            break;
+        }
+        skipLineFeed = *lineEnd == '\r';
+        data = lineEnd + 1;
+        if (!processLine()) {
+            stopped = true;
+        }
+        line.clear();
+    }
+    return !stopped;
+}
+
+bool EventStreamParser::finish() {
+    if (!stopped && framing == Framing::NewlineDelimited && !line.empty()) {
+        stopped = !processLine();
+        line.clear();
+    }
+    return !stopped;
+}
+
+bool EventStreamParser::processLine() {
+    if (framing == Framing::NewlineDelimited) {
+        if (line.empty()) {
+            return true;
+        }
+        pending.data.swap(line);
+        hasData = true;
+        return dispatch();
+    }
+
+    if (line.empty()) {
+        return dispatch();
+    }
+    if (line[0] == ':') {
+        return true; // 注释，通常是保活消息
+    }
+
+    size_t colon = line.find(':');
+    std::string field = line.substr(0, colon);
+    size_t valueStart = colon == std::string::npos ? line.size() : colon + 1;
+    if (valueStart < line.size() && line[valueStart] == ' ') {
+        ++valueStart;
+    }
+    const char* value = line.data() + valueStart;
+    size_t valueSize = line.size() - valueStart;
+
+    if (field == "data") {
+        if (hasData) {
+            pending.data.push_back('\n');
+        }
+        pending.data.append(value, valueSize);
+        hasData = true;
+    } else if (field == "event") {
+        pending.type.assign(value, valueSize);
+    } else if (field == "id" && std::memchr(value, '\0', valueSize) == nullptr) {
+        pending.id.assign(value, valueSize);
+    }
+    return true;
+}
+
+bool EventStreamParser::dispatch() {
+    if (!hasData) {
+        // 没有data的事件不分发
+        pending.type.clear();
+        return true;
+    }
+    bool proceed = onEvent(pending);
+    pending.type.clear();
+    pending.data.clear();
+    hasData = false;
+    return proceed;
+}
+
+} // namespace detail
+} // namespace client
+} // namespace dataapi
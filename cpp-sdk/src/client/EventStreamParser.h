@@ -0,0 +1,74 @@
+#pragma once
+
+#include <functional>
+#include <string>
+
+namespace dataapi {
+namespace client {
+namespace detail {
+
+/**
+ * 流式响应的增量分帧解析器
+ *
+ * 在数据到达时逐块切分事件，支持两种分帧：
+ * server-sent events（text/event-stream，按空行分隔事件，合并多行data）和
+ * 按行分隔（NDJSON，每个非空行为一个事件）。跨块的半行保存在内部缓冲区中，
+ * 内存占用只与单个事件大小有关。
+ */
+class EventStreamParser {
+public:
+    enum class Framing { ServerSentEvents, NewlineDelimited };
+
+    /**
+     * 单个事件
+     * 按行分隔时只有data
+     */
+    struct Event {
+        std::string type; // SSE的event字段，未指定时为空
+        std::string data;
+        std::string id;
+    };
+
+    /**
+     * 事件回调，返回false停止解析
+     */
+    using EventHandler = std::function<bool(Event& event)>;
+
+    explicit EventStreamParser(EventHandler onEvent, Framing framing = Framing::ServerSentEvents);
+
+    /**
+     * 设置分帧方式，应在输入数据之前调用
+     */
+    void setFraming(Framing value) {
+        framing = value;
+    }
+
+    /**
+     * 输入一块数据
+     * @return 回调要求停止时返回false
+     */
+    bool feed(const char* data, size_t size);
+
+    /**
+     * 数据结束，按行分隔时交出没有换行结尾的最后一行
+     * SSE中未以空行结束的事件按规范丢弃
+     * @return 回调要求停止时返回false
+     */
+    bool finish();
+
+private:
+    bool processLine();
+    bool dispatch();
+
+    EventHandler onEvent;
+    Framing framing;
+    std::string line;
+    bool skipLineFeed = false; // 上一块以\r结尾，下一块开头的\n属于同一个换行
+    bool stopped = false;
+    Event pending;
+    bool hasData = false;
+};
+
+} // namespace detail
+} // namespace client
+} // namespace dataapi
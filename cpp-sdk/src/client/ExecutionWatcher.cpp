@@ -0,0 +1,137 @@
+#include "dataapi/client/ExecutionWatcher.h"
+#include "dataapi/error/DataApiError.h"
+#include "client/CompletionRegistry.h"
+#include "client/EventStreamParser.h"
+#include <algorithm>
+#include <limits>
+
+namespace dataapi {
+namespace client {
+
+ExecutionWatcher::ExecutionWatcher(std::shared_ptr<http::HttpClient> httpClient,
+                                   const ExecutionWatcherOptions& options)
+    : httpClient(std::move(httpClient)),
+      options(options),
+      registry(std::make_unique<detail::CompletionRegistry>(options.retainCompleted)),
+      cancel(std::make_shared<std::atomic<bool>>(false)) {
+    worker = std::thread([this] { run(); });
+}
+
+ExecutionWatcher::~ExecutionWatcher() {
+    stop();
+}
+
+std::future<WorkflowExecutionResult> ExecutionWatcher::watch(const std::string& executionId) {
+    return registry->watch(executionId);
+}
+
+void ExecutionWatcher::watch(const std::string& executionId, Callback callback) {
+    registry->watch(executionId, std::move(callback));
+}
+
+bool ExecutionWatcher::waitConnected(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mutex);
+    return changed.wait_for(lock, timeout, [this] { return connected || stopping; }) && connected;
+}
+
+size_t ExecutionWatcher::size() const {
+    return registry->size();
+}
+
+void ExecutionWatcher::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) {
+            return;
+        }
+        stopping = true;
+        changed.notify_all();
+    }
+    cancel->store(true);
+    if (worker.joinable()) {
+        worker.join();
+    }
+    registry->close(std::make_exception_ptr(error::DataApiError("Execution watcher stopped", "WATCHER_STOPPED")));
+}
+
+void ExecutionWatcher::handleEvent(const std::string& data) {
+    WorkflowExecutionResult result;
+    try {
+        Json json = Json::parse(data);
+        if (!json.is_object() || !isTerminalExecutionStatus(json.value("status", ""))) {
+            return;
+        }
+        if (!json.contains("result")) {
+            json["result"] = nullptr;
+        }
+        from_json(std::move(json), result);
+    } catch (const Json::exception&) {
+        // 无法识别的事件（心跳、进度等）忽略
+        return;
+    }
+    registry->complete(std::move(result));
+}
+
+void ExecutionWatcher::run() {
+    using detail::EventStreamParser;
+    for (;;) {
+        HttpRequestConfig request;
+        request.method = HttpMethod::GET;
+        request.url = "/workflows/executions/events";
+        request.headers["Accept"] = "text/event-stream";
+        request.cancel = cancel;
+        // 长连接不受普通请求的超时限制，停滞的连接由低速检测发现；失败后由本线程重连，不在请求内重试
+        request.timeout = static_cast<int>(std::min<std::chrono::milliseconds::rep>(
+            options.streamTimeout.count(), std::numeric_limits<int>::max()));
+        request.lowSpeedTime = static_cast<int>(options.idleTimeout.count());
+        request.maxRetries = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopping) {
+                return;
+            }
+            if (!lastEventId.empty()) {
+                request.headers["Last-Event-ID"] = lastEventId;
+            }
+        }
+
+        bool streamed = false;
+        auto started = std::chrono::steady_clock::now();
+        EventStreamParser parser([this](EventStreamParser::Event& event) {
+            if (!event.id.empty()) {
+                std::lock_guard<std::mutex> lock(mutex);
+                lastEventId = event.id;
+            }
+            handleEvent(event.data);
+            return true;
+        });
+        try {
+            httpClient->request(
+                request,
+                [&parser](const char* data, size_t size) {
+                    return parser.feed(data, size);
+                },
+                [&](int status, const http::ResponseHeaders&) {
+                    if (status == 200) {
+                        streamed = true;
+                        std::lock_guard<std::mutex> lock(mutex);
+                        connected = true;
+                        changed.notify_all();
+                    }
+                });
+            parser.finish();
+        } catch (const std::exception&) {
+            // 连接失败或被服务端、客户端超时中断，稍后重连
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        connected = false;
+        // 持续过一段时间的流断开（例如请求超时）时立即重连，Last-Event-ID保证不丢事件
+        if (!streamed || std::chrono::steady_clock::now() - started < options.reconnectDelay) {
+            changed.wait_for(lock, options.reconnectDelay, [this] { return stopping; });
+        }
+    }
+}
+
+} // namespace client
+} // namespace dataapi
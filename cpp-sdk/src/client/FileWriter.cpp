@@ -0,0 +1,103 @@
+#include "client/FileWriter.h"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace dataapi {
+namespace client {
+namespace detail {
+
+static std::runtime_error writeError(const char* action) {
+    return std::runtime_error(std::string("Failed to ") + action + " export output: " + std::strerror(errno));
+}
+
+FileWriter::FileWriter(const std::string& path, bool append, size_t bufferSize)
+    : fd(::open(path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : O_TRUNC), 0644)),
+      ownsFd(true),
+      capacity(bufferSize) {
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open file " + path + ": " + std::strerror(errno));
+    }
+    if (append) {
+        struct stat info;
+        if (::fstat(fd, &info) == 0) {
+            written = static_cast<uint64_t>(info.st_size);
+        }
+    }
+    buffer.reserve(capacity);
+}
+
+FileWriter::FileWriter(int fd, size_t bufferSize) : fd(fd), ownsFd(false), capacity(bufferSize) {
+    off_t position = ::lseek(fd, 0, SEEK_CUR);
+    origin = position < 0 ? -1 : static_cast<int64_t>(position);
+    buffer.reserve(capacity);
+}
+
+FileWriter::~FileWriter() {
+    // 异常路径上尽量保留已收到的数据，供之后续传
+    try {
+        flush();
+    } catch (...) {
+    }
+    if (ownsFd) {
+        ::close(fd);
+    }
+}
+
+void FileWriter::writeFully(const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t count = ::write(fd, data, size);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw writeError("write");
+        }
+        data += count;
+        size -= static_cast<size_t>(count);
+        written += static_cast<uint64_t>(count);
+    }
+}
+
+void FileWriter::write(const char* data, size_t size) {
+    if (buffer.size() + size <= capacity) {
+        buffer.insert(buffer.end(), data, data + size);
+        return;
+    }
+    flush();
+    if (size >= capacity) {
+        writeFully(data, size);
+    } else {
+        buffer.insert(buffer.end(), data, data + size);
+    }
+}
+
+void FileWriter::flush() {
+    if (buffer.empty()) {
+        return;
+    }
+    try {
+        writeFully(buffer.data(), buffer.size());
+    } catch (...) {
+        // 写入失败时丢弃缓冲区，size()只统计已写出的部分
+        buffer.clear();
+        throw;
+    }
+    buffer.clear();
+}
+
+void FileWriter::rewind() {
+    buffer.clear();
+    if (origin < 0 || ::ftruncate(fd, static_cast<off_t>(origin)) != 0 ||
+        ::lseek(fd, static_cast<off_t>(origin), SEEK_SET) < 0) {
+        throw writeError("rewind");
+    }
+    written = 0;
+}
+
+} // namespace detail
+} // namespace client
+} // namespace dataapi
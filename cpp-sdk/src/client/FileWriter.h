@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace dataapi {
+namespace client {
+namespace detail {
+
+/**
+ * 导出数据的缓冲文件写入器
+ *
+ * 小块数据合并到固定大小的缓冲区后一次write(2)写出，大块数据绕过缓冲区直接写入，
+ * 内存占用与数据总量无关。记录起始位置以便续传失败时回退重写。
+ */
+class FileWriter {
+public:
+    /**
+     * 打开文件
+     * @param path 文件路径
+     * @param append 为true时保留已有内容并从末尾续写，否则截断
+     * @param bufferSize 缓冲区大小
+     * @throws std::runtime_error 文件无法打开
+     */
+    FileWriter(const std::string& path, bool append, size_t bufferSize);
+
+    /**
+     * 写入调用方的文件描述符，从其当前位置开始，不取得所有权
+     */
+    FileWriter(int fd, size_t bufferSize);
+
+    ~FileWriter();
+
+    FileWriter(const FileWriter&) = delete;
+    FileWriter& operator=(const FileWriter&) = delete;
+
+    /**
+     * 写入数据
+     * @throws std::runtime_error 写入失败
+     */
+    void write(const char* data, size_t size);
+
+    /**
+     * 写出缓冲区中的数据
+     */
+    void flush();
+
+    /**
+     * 丢弃已写入的数据，回到起始位置
+     * @throws std::runtime_error 输出不支持截断（例如管道）
+     */
+    void rewind();
+
+    /**
+     * 自起始位置以来写入的字节数（含缓冲区中未写出的部分）
+     */
+    uint64_t size() const {
+        return written + buffer.size();
+    }
+
+private:
+    void writeFully(const char* data, size_t size);
+
+    int fd;
+    bool ownsFd;
+    int64_t origin = 0;
+    uint64_t written = 0;
+    size_t capacity;
+    std::vector<char> buffer;
+};
+
+} // namespace detail
+} // namespace client
+} // namespace dataapi
@@ -0,0 +1,50 @@
+#include "dataapi/client/MediaOutput.h"
+#include "client/FileWriter.h"
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+namespace dataapi {
+namespace client {
+
+static constexpr size_t kMediaBufferSize = 64 * 1024;
+
+MediaOutput bufferOutput(char* data, size_t capacity) {
+    MediaOutput output;
+    output.buffer = data;
+    output.sink = [data, capacity, used = size_t(0)](const char* chunk, size_t size) mutable {
+        if (size > capacity - used) {
+            throw std::length_error("Media payload exceeds the output buffer of " + std::to_string(capacity) + " bytes");
+        }
+        std::memcpy(data + used, chunk, size);
+        used += size;
+        return true;
+    };
+    return output;
+}
+
+/**
+ * 接收端和完成回调共享同一个写入器，写入器随两者一起释放
+ */
+static MediaOutput writerOutput(std::shared_ptr<detail::FileWriter> writer) {
+    MediaOutput output;
+    output.sink = [writer](const char* chunk, size_t size) {
+        writer->write(chunk, size);
+        return true;
+    };
+    output.finish = [writer] {
+        writer->flush();
+    };
+    return output;
+}
+
+MediaOutput fileOutput(const std::string& path) {
+    return writerOutput(std::make_shared<detail::FileWriter>(path, false, kMediaBufferSize));
+}
+
+MediaOutput fdOutput(int fd) {
+    return writerOutput(std::make_shared<detail::FileWriter>(fd, kMediaBufferSize));
+}
+
+} // namespace client
+} // namespace dataapi
@@ -0,0 +1,161 @@
+#include "dataapi/client/MetadataCache.h"
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace dataapi {
+namespace client {
+
+struct MetadataCache::Shard {
+    struct Entry {
+        std::string id;
+        MetadataKind kind;
+        std::string owner;
+        std::type_index type;
+        std::shared_ptr<const void> value;
+        std::chrono::steady_clock::time_point expires;
+    };
+
+    std::mutex mutex;
+    std::list<Entry> entries; // 最近使用的在前
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    uint64_t generation = 0;  // 每次失效递增，未命中时记录，写回前比较
+
+    void erase(std::list<Entry>::iterator it) {
+        index.erase(it->id);
+        entries.erase(it);
+    }
+};
+
+static std::string entryId(MetadataKind kind, const std::string& owner, const std::string& key) {
+    std::string id;
+    id.reserve(owner.size() + key.size() + 2);
+    id += static_cast<char>('0' + static_cast<int>(kind));
+    id += owner;
+    id += '\0';
+    id += key;
+    return id;
+}
+
+MetadataCache::MetadataCache(const MetadataCacheOptions& options) : options(options) {
+    size_t count = std::max<size_t>(1, options.shards);
+    shardCapacity = std::max<size_t>(1, (options.maxEntries + count - 1) / count);
+    shards.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        shards.push_back(std::make_unique<Shard>());
+    }
+}
+
+MetadataCache::~MetadataCache() = default;
+
+MetadataCache::Shard& MetadataCache::shardFor(const std::string& owner) const {
+    return *shards[std::hash<std::string>()(owner) % shards.size()];
+}
+
+std::shared_ptr<const void> MetadataCache::find(MetadataKind kind, const std::string& owner, const std::string& key,
+                                                std::type_index type, uint64_t& generation) {
+    Shard& shard = shardFor(owner);
+    std::string id = entryId(kind, owner, key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    generation = shard.generation;
+    auto found = shard.index.find(id);
+    if (found != shard.index.end()) {
+        auto it = found->second;
+        if (it->expires > std::chrono::steady_clock::now() && it->type == type) {
+            shard.entries.splice(shard.entries.begin(), shard.entries, it);
+            ++hits;
+            return it->value;
+        }
+        shard.erase(it);
+    }
+    ++misses;
+    return nullptr;
+}
+
+void MetadataCache::insert(MetadataKind kind, const std::string& owner, const std::string& key,
+                           std::type_index type, std::shared_ptr<const void> value, uint64_t generation) {
+    Shard& shard = shardFor(owner);
+    std::string id = entryId(kind, owner, key);
+    auto expires = std::chrono::steady_clock::now() + ttl(kind);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (shard.generation != generation) {
+        // 加载期间发生了失效，结果可能是修改前的值
+        return;
+    }
+    auto found = shard.index.find(id);
+    if (found != shard.index.end()) {
+        shard.erase(found->second);
+    }
+    while (shard.entries.size() >= shardCapacity) {
+        shard.erase(std::prev(shard.entries.end()));
+        ++evictions;
+    }
+    shard.entries.push_front(Shard::Entry{id, kind, owner, type, std::move(value), expires});
+    shard.index.emplace(std::move(id), shard.entries.begin());
+}
+
+void MetadataCache::invalidate(MetadataKind kind, const std::string& owner) {
+    Shard& shard = shardFor(owner);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    ++shard.generation;
+    for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+        auto next = std::next(it);
+        if (it->kind == kind && it->owner == owner) {
+            shard.erase(it);
+        }
+        it = next;
+    }
+    ++invalidations;
+}
+
+void MetadataCache::clear() {
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        ++shard->generation;
+        shard->entries.clear();
+        shard->index.clear();
+    }
+}
+
+size_t MetadataCache::size() const {
+    size_t total = 0;
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        total += shard->entries.size();
+    }
+    return total;
+}
+
+std::chrono::milliseconds MetadataCache::ttl(MetadataKind kind) const {
+    switch (kind) {
+        case MetadataKind::Workflow:
+            return options.workflowTtl;
+        case MetadataKind::TableList:
+        case MetadataKind::TableSchema:
+            return options.tableTtl;
+        case MetadataKind::ModelList:
+            return options.modelTtl;
+        case MetadataKind::ProjectConfig:
+            return options.projectConfigTtl;
+        case MetadataKind::UserPermissions:
+        case MetadataKind::ProjectPermissions:
+            return options.permissionTtl;
+        case MetadataKind::WorkflowSchema:
+            return options.schemaTtl;
+    }
+    return std::chrono::milliseconds(0);
+}
+
+MetadataCacheStats MetadataCache::getStats() const {
+    MetadataCacheStats stats;
+    stats.hits = hits.load();
+    stats.misses = misses.load();
+    stats.evictions = evictions.load();
+    stats.invalidations = invalidations.load();
+    return stats;
+}
+
+} // namespace client
+} // namespace dataapi
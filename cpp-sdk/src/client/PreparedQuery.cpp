@@ -0,0 +1,107 @@
+#include "dataapi/client/PreparedQuery.h"
+#include "client/ResponseDecoder.h"
+#include <utility>
+
+namespace dataapi {
+namespace client {
+
+PreparedQuery::PreparedQuery(std::shared_ptr<http::HttpClient> httpClient, std::string databaseId, std::string sql)
+    : httpClient(std::move(httpClient)), databaseId(std::move(databaseId)), sql(std::move(sql)) {
+}
+
+/**
+ * 服务端不支持预编译语句
+ */
+static bool isUnsupported(const http::HttpResponse& response) {
+    return response.statusCode == 405 || response.statusCode == 501;
+}
+
+void PreparedQuery::prepare() {
+    statementFor();
+}
+
+std::string PreparedQuery::statementFor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!statementId.empty() || unsupported) {
+            return statementId;
+        }
+    }
+    
+    Json payload;
+    payload["sql"] = sql;
+    auto response = httpClient->request(
+        detail::jsonRequest(HttpMethod::POST, "/databases/" + databaseId + "/statements", std::move(payload)));
+    std::lock_guard<std::mutex> lock(mutex);
+    if (isUnsupported(response)) {
+        unsupported = true;
+        return {};
+    }
+    if (response.statusCode != 200 && response.statusCode != 201) {
+        detail::throwStatusError(response, "Failed to prepare SQL", "Database not found: " + databaseId);
+    }
+    // 并发准备时保留先写入的ID，多余的服务端语句由服务端过期回收
+    if (statementId.empty()) {
+        statementId = detail::parseBody(std::move(response)).at("statementId").get<std::string>();
+    }
+    return statementId;
+}
+
+void PreparedQuery::invalidate(const std::string& staleId) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (statementId == staleId) {
+        statementId.clear();
+    }
+}
+
+QueryResult PreparedQuery::execute(const Parameters& params) {
+    for (int attempt = 0;; ++attempt) {
+        std::string id = statementFor();
+        Json payload = Json::object();
+        if (id.empty()) {
+            payload["sql"] = sql;
+        }
+        if (!params.empty()) {
+            payload["params"] = params;
+        }
+        std::string url = id.empty()
+            ? "/databases/" + databaseId + "/execute"
+            : "/databases/" + databaseId + "/statements/" + id + "/execute";
+        auto request = detail::jsonRequest(HttpMethod::POST, std::move(url), std::move(payload));
+        request.binaryResponse = true;
+        auto response = httpClient->request(request);
+        
+        // 服务端语句已失效：重新准备后重试一次
+        if (!id.empty() && response.statusCode == 404 && attempt == 0) {
+            invalidate(id);
+            continue;
+        }
+        detail::expectStatus(response, 200, "Failed to execute SQL", "Database not found: " + databaseId);
+        return detail::decode<QueryResult>(std::move(response));
+    }
+}
+
+void PreparedQuery::close() {
+    std::string id;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        id = std::move(statementId);
+        statementId.clear();
+    }
+    if (id.empty()) {
+        return;
+    }
+    auto response = httpClient->del("/databases/" + databaseId + "/statements/" + id);
+    // 语句已被服务端回收时视为成功
+    if (response.statusCode != 200 && response.statusCode != 204 && response.statusCode != 404) {
+        detail::throwStatusError(response, "Failed to close prepared statement");
+    }
+}
+
+std::string PreparedQuery::getStatementId() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return statementId;
+}
+
+} // namespace client
+} // namespace dataapi
@@ -0,0 +1,61 @@
+#include "client/PreparedQueryCache.h"
+
+namespace dataapi {
+namespace client {
+namespace detail {
+
+std::string PreparedQueryCache::keyOf(const std::string& databaseId, const std::string& sql) {
+    std::string key;
+    key.reserve(databaseId.size() + sql.size() + 1);
+    key += databaseId;
+    key += '\0';
+    key += sql;
+    return key;
+}
+
+std::shared_ptr<PreparedQuery> PreparedQueryCache::get(const std::string& databaseId, const std::string& sql,
+                                                       const Factory& create) {
+    std::string key = keyOf(databaseId, sql);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(key);
+        if (it != index.end()) {
+            entries.splice(entries.begin(), entries, it->second);
+            return it->second->second;
+        }
+    }
+    
+    auto query = create();
+    std::lock_guard<std::mutex> lock(mutex);
+    // 并发创建同一句柄时保留先写入的，两者都可用
+    auto it = index.find(key);
+    if (it != index.end()) {
+        entries.splice(entries.begin(), entries, it->second);
+        return it->second->second;
+    }
+    entries.emplace_front(key, query);
+    index.emplace(std::move(key), entries.begin());
+    while (entries.size() > capacity) {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+    return query;
+}
+
+void PreparedQueryCache::erase(const std::string& databaseId, const std::string& sql) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(keyOf(databaseId, sql));
+    if (it != index.end()) {
+        entries.erase(it->second);
+        index.erase(it);
+    }
+}
+
+size_t PreparedQueryCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+} // namespace detail
+} // namespace client
+} // namespace dataapi
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "dataapi/client/PreparedQuery.h"
+
+namespace dataapi {
+namespace client {
+namespace detail {
+
+/**
+ * 按数据库和SQL复用预编译查询句柄
+ *
+ * 键为数据库ID和SQL文本，按SQL哈希查找；最多保留capacity个句柄，超出时淘汰最久未使用的。
+ * 淘汰只是不再复用，持有者手中的句柄仍然可用，服务端语句由服务端过期回收。线程安全。
+ */
+class PreparedQueryCache {
+public:
+    using Factory = std::function<std::shared_ptr<PreparedQuery>()>;
+
+    explicit PreparedQueryCache(size_t capacity) : capacity(capacity) {}
+
+    /**
+     * 取得句柄，不存在时由create创建（在锁外调用）
+     */
+    std::shared_ptr<PreparedQuery> get(const std::string& databaseId, const std::string& sql, const Factory& create);
+
+    /**
+     * 移除句柄，用于close之后
+     */
+    void erase(const std::string& databaseId, const std::string& sql);
+
+    size_t size() const;
+
+private:
+    static std::string keyOf(const std::string& databaseId, const std::string& sql);
+
+    size_t capacity;
+    mutable std::mutex mutex;
+    std::list<std::pair<std::string, std::shared_ptr<PreparedQuery>>> entries; // 最近使用的在前
+    std::unordered_map<std::string, decltype(entries)::iterator> index;
+};
+
+} // namespace detail
+} // namespace client
+} // namespace dataapi
@@ -1,7 +1,11 @@
 #include "dataapi/client/ProjectClient.h"
 #include "dataapi/Types.h"
 #include "dataapi/exceptions/DataApiException.h"
-#include <sstream>
+#include "client/ResponseDecoder.h"
+#include "client/CachedLookup.h"
+#ifdef DATAAPI_WITH_COROUTINES
+#include "client/AsyncRequests.h"
+#endif
 #include <stdexcept>
 #include <string>
 #include <memory>
@@ -12,93 +16,209 @@ namespace client {
 ProjectClient::ProjectClient(std::shared_ptr<http::HttpClient> httpClient) : httpClient(httpClient) {
 }
 
-PageResult<SysProject> ProjectClient::list(int page, int size, const std::string& userId) {
-    std::ostringstream oss;
-    oss << "/projects?page=" << page << "&size=" << size;
-    
-    auto response = httpClient->get(oss.str());
-    if (response.statusCode != 200) {
-        throw std::runtime_error("Failed to list projects");
-    }
-    
-    Json json = Json::parse(response.body);
-    PageResult<SysProject> result;
-    
-    result.content.clear();
-    for (const auto& item : json["content"]) {
-        SysProject project;
-        from_json(item, project);
-        result.content.push_back(project);
+/**
+ * 列表查询参数，过滤条件为空时省略
+ */
+static Parameters listParams(int page, int size, const std::string& userId) {
+    Parameters params{{"page", std::to_string(page)}, {"size", std::to_string(size)}};
+    if (!userId.empty()) {
+        params["userId"] = userId;
     }
-    
-    result.totalElements = json["totalElements"].get<long>();
-    result.totalPages = json["totalPages"].get<int>();
-    result.pageSize = json["size"].get<int>();
-    result.pageNumber = json["number"].get<int>();
-    result.empty = json.value("empty", false);
-    result.first = json["first"].get<bool>();
-    result.last = json["last"].get<bool>();
-    
-    return result;
+    return params;
+}
+
+PageResult<SysProject> ProjectClient::list(int page, int size, const std::string& userId) {
+    auto response = httpClient->get("/projects", listParams(page, size, userId));
+    detail::expectStatus(response, 200, "Failed to list projects");
+    return detail::decodePage<SysProject>(std::move(response));
+}
+
+Paginator<SysProject> ProjectClient::paginate(int size, const std::string& userId, const PaginatorOptions& options) {
+    return Paginator<SysProject>(
+        [this, size, userId](int page) {
+            return list(page, size, userId);
+        },
+        options.pageBase, options);
 }
 
 SysProject ProjectClient::getById(const std::string& id) {
     auto response = httpClient->get("/projects/" + id);
-    if (response.statusCode == 404) {
-        throw std::runtime_error("Project not found: " + id);
-    }
-    if (response.statusCode != 200) {
-        throw std::runtime_error("Failed to get project");
-    }
-    
-    Json json = Json::parse(response.body);
-    SysProject project;
-    from_json(json, project);
-    return project;
+    detail::expectStatus(response, 200, "Failed to get project", "Project not found: " + id);
+    return detail::decode<SysProject>(std::move(response));
 }
 
 SysProject ProjectClient::create(const ProjectCreateRequest& request) {
-    Json json;
-    to_json(json, request);
-    
-    auto response = httpClient->post("/projects", json);
-    if (response.statusCode != 201) {
-        throw std::runtime_error("Failed to create project");
-    }
-    
-    Json responseJson = Json::parse(response.body);
-    SysProject project;
-    from_json(responseJson, project);
-    return project;
+    auto response = httpClient->request(detail::jsonRequest(HttpMethod::POST, "/projects", request));
+    detail::expectStatus(response, 201, "Failed to create project");
+    return detail::decode<SysProject>(std::move(response));
 }
 
 SysProject ProjectClient::update(const std::string& id, const ProjectUpdateRequest& request) {
-    Json json;
-    to_json(json, request);
-    
-    auto response = httpClient->put("/projects/" + id, json);
-    if (response.statusCode == 404) {
-        throw std::runtime_error("Project not found: " + id);
-    }
-    if (response.statusCode != 200) {
-        throw std::runtime_error("Failed to update project");
-    }
-    
-    Json responseJson = Json::parse(response.body);
-    SysProject project;
-    from_json(responseJson, project);
-    return project;
+    auto response = httpClient->request(detail::jsonRequest(HttpMethod::PUT, "/projects/" + id, request));
+    detail::expectStatus(response, 200, "Failed to update project", "Project not found: " + id);
+    return detail::decode<SysProject>(std::move(response));
 }
 
 void ProjectClient::deleteProject(const std::string& id) {
+    detail::ScopedInvalidation invalidation(metadataCache, {MetadataKind::ProjectConfig, MetadataKind::ProjectPermissions}, id);
     auto response = httpClient->del("/projects/" + id);
-    if (response.statusCode == 404) {
-        throw std::runtime_error("Project not found: " + id);
+    detail::expectStatus(response, 204, "Failed to delete project", "Project not found: " + id);
+}
+
+void ProjectClient::removeMember(const std::string& projectId, const std::string& userId) {
+    detail::ScopedInvalidation invalidation(metadataCache, {MetadataKind::ProjectPermissions}, projectId);
+    auto response = httpClient->del("/projects/" + projectId + "/members/" + userId);
+    detail::expectStatus(response, 204, "Failed to remove project member", "Project member not found: " + userId);
+}
+
+std::vector<ProjectPermission> ProjectClient::getPermissions(const std::string& projectId) {
+    return detail::conditionalGet<std::vector<ProjectPermission>>(*httpClient, "/projects/" + projectId + "/permissions",
+                                                                  "Failed to get project permissions", "Project not found: " + projectId);
+}
+
+void ProjectClient::setPermissions(const std::string& projectId, const std::vector<ProjectPermission>& permissions) {
+    detail::ScopedInvalidation invalidation(metadataCache, {MetadataKind::ProjectPermissions}, projectId);
+    auto response = httpClient->request(detail::jsonRequest(HttpMethod::PUT, "/projects/" + projectId + "/permissions", permissions));
+    if (!response.isSuccess()) {
+        detail::throwStatusError(response, "Failed to set project permissions", "Project not found: " + projectId);
+    }
+}
+
+bool ProjectClient::hasPermission(const std::string& projectId, const std::string& userId, const std::string& permission) {
+    return hasPermissions(projectId, userId, {permission}).front();
+}
+
+std::vector<bool> ProjectClient::hasPermissions(const std::string& projectId,
+                                                const std::string& userId,
+                                                const std::vector<std::string>& permissions) {
+    std::vector<bool> decisions(permissions.size());
+    std::vector<size_t> pending;
+    uint64_t generation = 0;
+    bool cached = metadataCache && metadataCache->ttl(MetadataKind::ProjectPermissions).count() > 0;
+    for (size_t i = 0; i < permissions.size(); ++i) {
+        bool allowed = false;
+        uint64_t seen = 0;
+        if (cached && metadataCache->peek(MetadataKind::ProjectPermissions, projectId, userId + '\0' + permissions[i], allowed, seen)) {
+            decisions[i] = allowed;
+            continue;
+        }
+        if (pending.empty()) {
+            // 以第一次未命中时的失效计数为准，之后发生的失效使本次结果不被缓存
+            generation = seen;
+        }
+        pending.push_back(i);
+    }
+    if (pending.empty()) {
+        return decisions;
     }
-    if (response.statusCode != 204) {
-        throw std::runtime_error("Failed to delete project");
+    
+    std::vector<std::string> names;
+    names.reserve(pending.size());
+    for (size_t i : pending) {
+        names.push_back(permissions[i]);
+    }
+    auto response = httpClient->request(detail::jsonRequest(HttpMethod::POST, "/projects/" + projectId + "/permissions/check",
+                                                            Json{{"userId", userId}, {"permissions", names}}));
+    detail::expectStatus(response, 200, "Failed to check project permissions", "Project not found: " + projectId);
+    auto results = detail::decodePermissionResults(std::move(response), names.size());
+    for (size_t n = 0; n < pending.size(); ++n) {
+        decisions[pending[n]] = results[n];
+        if (cached) {
+            metadataCache->put(MetadataKind::ProjectPermissions, projectId, userId + '\0' + names[n], bool(results[n]), generation);
+        }
     }
+    return decisions;
+}
+
+ProjectConfig ProjectClient::getConfig(const std::string& projectId) {
+    return detail::cachedLookup<ProjectConfig>(metadataCache, MetadataKind::ProjectConfig, projectId, "", [&] {
+        return detail::conditionalGet<ProjectConfig>(*httpClient, "/projects/" + projectId + "/config",
+                                                     "Failed to get project config", "Project not found: " + projectId);
+    });
+}
+
+ProjectConfig ProjectClient::updateConfig(const std::string& projectId, const ProjectConfig& config) {
+    detail::ScopedInvalidation invalidation(metadataCache, {MetadataKind::ProjectConfig}, projectId);
+    auto response = httpClient->request(detail::jsonRequest(HttpMethod::PUT, "/projects/" + projectId + "/config", config));
+    detail::expectStatus(response, 200, "Failed to update project config", "Project not found: " + projectId);
+    return detail::decode<ProjectConfig>(std::move(response));
+}
+
+ProjectStatistics ProjectClient::getStatistics(const std::string& projectId) {
+    return detail::conditionalGet<ProjectStatistics>(*httpClient, "/projects/" + projectId + "/statistics",
+                                                     "Failed to get project statistics", "Project not found: " + projectId);
+}
+
+void ProjectClient::setMetadataCache(std::shared_ptr<MetadataCache> cache) {
+    metadataCache = std::move(cache);
+}
+
+std::shared_ptr<MetadataCache> ProjectClient::getMetadataCache() const {
+    return metadataCache;
+}
+
+static HttpRequestConfig importRequest(const std::string& projectId, const std::string& format) {
+    auto request = detail::uploadRequest("/projects/" + projectId + "/import", format);
+    request.params["format"] = format;
+    return request;
+}
+
+static ImportResult finishImport(http::HttpResponse&& response, const std::string& projectId) {
+    detail::expectStatus(response, 200, "Failed to import project data", "Project not found: " + projectId);
+    return detail::decode<ImportResult>(std::move(response));
+}
+
+ImportResult ProjectClient::importData(const std::string& projectId,
+                                       const std::string& data,
+                                       const std::string& format) {
+    auto response = httpClient->upload(importRequest(projectId, format), http::memoryBody(data));
+    return finishImport(std::move(response), projectId);
+}
+
+ImportResult ProjectClient::importData(const std::string& projectId,
+                                       http::UploadBody body,
+                                       const std::string& format,
+                                       http::UploadProgress onProgress) {
+    auto response = httpClient->upload(importRequest(projectId, format), std::move(body), std::move(onProgress));
+    return finishImport(std::move(response), projectId);
+}
+
+ImportResult ProjectClient::importFile(const std::string& projectId,
+                                       const std::string& path,
+                                       const std::string& format,
+                                       http::UploadProgress onProgress) {
+    return importData(projectId, http::fileBody(path), format, std::move(onProgress));
 }
 
+#ifdef DATAAPI_WITH_COROUTINES
+
+coro::Task<PageResult<SysProject>> ProjectClient::listAsync(int page, int size, std::string userId) {
+    return detail::fetchPageAsync<SysProject>(*httpClient, detail::getRequest("/projects", listParams(page, size, userId)),
+                                              "Failed to list projects");
+}
+
+coro::Task<SysProject> ProjectClient::getByIdAsync(std::string id) {
+    return detail::fetchAsync<SysProject>(*httpClient, detail::getRequest("/projects/" + id),
+                                          200, "Failed to get project", "Project not found: " + id);
+}
+
+coro::Task<SysProject> ProjectClient::createAsync(ProjectCreateRequest request) {
+    return detail::fetchAsync<SysProject>(*httpClient, detail::jsonRequest(HttpMethod::POST, "/projects", request),
+                                          201, "Failed to create project");
+}
+
+coro::Task<SysProject> ProjectClient::updateAsync(std::string id, ProjectUpdateRequest request) {
+    return detail::fetchAsync<SysProject>(*httpClient, detail::jsonRequest(HttpMethod::PUT, "/projects/" + id, request),
+                                          200, "Failed to update project", "Project not found: " + id);
+}
+
+coro::Task<void> ProjectClient::deleteProjectAsync(std::string id) {
+    detail::ScopedInvalidation invalidation(metadataCache, {MetadataKind::ProjectConfig, MetadataKind::ProjectPermissions}, id);
+    co_await detail::sendAsync(*httpClient, detail::deleteRequest("/projects/" + id),
+                               204, "Failed to delete project", "Project not found: " + id);
+}
+
+#endif
+
 } // namespace client
 } // namespace dataapi
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "dataapi/client/QueryCursor.h"
+#include "client/ResponseDecoder.h"
+#include "client/RowStreamParser.h"
+#include <stdexcept>
+
+namespace dataapi {
+namespace client {
+
+QueryCursor::QueryCursor(std::shared_ptr<http::HttpClient> httpClient,
+                         HttpRequestConfig request,
+                         ResponseCheck check,
+                         const CursorOptions& options)
+    : httpClient(std::move(httpClient)), request(std::move(request)), check(std::move(check)), options(options) {
+    if (this->options.prefetchRows == 0) {
+        this->options.prefetchRows = 1;
+    }
+    worker = std::thread(&QueryCursor::produce, this);
+}
+
+QueryCursor::~QueryCursor() {
+    close();
+}
+
+void QueryCursor::produce() {
+    try {
+        detail::RowStreamParser parser(
+            "rows",
+            [this](std::string_view text) {
+                Json row = detail::parseJson(text);
+                std::unique_lock<std::mutex> lock(mutex);
+                spaceAvailable.wait(lock, [this] { return closed || rows.size() < options.prefetchRows; });
+                if (closed) {
+                    return false;
+                }
+                rows.push_back(std::move(row));
+                rowsAvailable.notify_one();
+                return true;
+            },
+            [this](const std::string& name, std::string_view text) {
+                Json value = detail::parseJson(text);
+                std::lock_guard<std::mutex> lock(mutex);
+                if (name == "columns") {
+                    value.get_to(columns);
+                } else if (name == "totalRows" && value.is_number_integer()) {
+                    totalRows = value.get<int>();
+                } else if (name == "metadata") {
+                    metadata = std::move(value);
+                }
+            });
+
+        auto response = httpClient->request(request, [&parser](const char* data, size_t size) {
+            return parser.feed(data, size);
+        });
+        check(response);
+        if (!parser.isComplete()) {
+            throw std::runtime_error("Incomplete query result stream");
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        // 主动关闭导致的中止不是错误
+        if (!closed) {
+            error = std::current_exception();
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    finished = true;
+    rowsAvailable.notify_all();
+}
+
+bool QueryCursor::next(Json& row) {
+    std::unique_lock<std::mutex> lock(mutex);
+    rowsAvailable.wait(lock, [this] { return !rows.empty() || finished || closed; });
+    if (!rows.empty()) {
+        row = std::move(rows.front());
+        rows.pop_front();
+        spaceAvailable.notify_one();
+        return true;
+    }
+    if (error) {
+        std::exception_ptr failure = error;
+        error = nullptr;
+        std::rethrow_exception(failure);
+    }
+    return false;
+}
+
+std::vector<std::string> QueryCursor::getColumns() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return columns;
+}
+
+std::optional<int> QueryCursor::getTotalRows() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return totalRows;
+}
+
+Json QueryCursor::getMetadata() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return metadata;
+}
+
+void QueryCursor::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        rows.clear();
+        spaceAvailable.notify_all();
+        rowsAvailable.notify_all();
+    }
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+} // namespace client
+} // namespace dataapi
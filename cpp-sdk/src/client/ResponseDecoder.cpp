@@ -0,0 +1,164 @@
+#include "client/ResponseDecoder.h"
+#include "dataapi/error/DataApiError.h"
+#include "dataapi/http/RetryPolicy.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+
+#ifdef DATAAPI_WITH_SIMDJSON
+#include "client/SimdJsonBackend.h"
+#endif
+
+namespace dataapi {
+namespace client {
+namespace detail {
+
+static const char* contentTypeFor(const std::string& format) {
+    if (format == "csv") {
+        return "text/csv";
+    }
+    if (format == "json") {
+        return "application/json";
+    }
+    if (format == "ndjson" || format == "jsonl") {
+        return "application/x-ndjson";
+    }
+    if (format == "excel" || format == "xlsx") {
+        return "application/vnd.openxmlformats-officedocument.spreadsheetml.sheet";
+    }
+    return "application/octet-stream";
+}
+
+HttpRequestConfig uploadRequest(std::string url, const std::string& format) {
+    HttpRequestConfig request;
+    request.method = HttpMethod::POST;
+    request.url = std::move(url);
+    request.headers["Content-Type"] = contentTypeFor(format);
+    return request;
+}
+
+void throwStatusError(const http::HttpResponse& response,
+                      const std::string& message,
+                      const std::string& notFound) {
+    switch (response.statusCode) {
+        case 400:
+            throw error::ValidationError(message);
+        case 401:
+            throw error::AuthenticationError(message);
+        case 403:
+            throw error::AuthorizationError(message);
+        case 404:
+            throw error::NotFoundError(notFound.empty() ? message : notFound);
+        case 409:
+            throw error::ConflictError(message);
+        case 429: {
+            int retryAfter = 0;
+            if (auto header = response.headers.get("Retry-After")) {
+                if (auto delay = http::RetryPolicy::parseRetryAfter(std::string(*header))) {
+                    retryAfter = static_cast<int>(std::chrono::duration_cast<std::chrono::seconds>(*delay).count());
+                }
+            }
+            throw error::RateLimitError(message, retryAfter);
+        }
+        case 503:
+            throw error::ServiceUnavailableError(message);
+        default:
+            break;
+    }
+
+    std::string requestId;
+    if (auto header = response.headers.get("X-Request-Id")) {
+        requestId = std::string(*header);
+    }
+    Json body;
+    switch (bodyEncoding(response)) {
+        case BodyEncoding::MessagePack:
+            body = Json::from_msgpack(response.body, true, false);
+            break;
+        case BodyEncoding::Cbor:
+            body = Json::from_cbor(response.body, true, false);
+            break;
+        case BodyEncoding::Json:
+            body = Json::parse(response.body, nullptr, false);
+            break;
+    }
+    if (body.is_discarded()) {
+        body = nullptr;
+    }
+    throw error::HttpError(message, response.statusCode, "", "", requestId, body);
+}
+
+Json parseJson(std::string_view text) {
+#ifdef DATAAPI_WITH_SIMDJSON
+    // simdjson要求输入带尾部填充，复用线程内的缓冲区
+    thread_local std::string buffer;
+    buffer.assign(text.data(), text.size());
+    return parseWithSimdjson(buffer);
+#else
+    return Json::parse(text.begin(), text.end());
+#endif
+}
+
+BodyEncoding bodyEncoding(const http::HttpResponse& response) {
+    auto header = response.headers.get("Content-Type");
+    if (!header) {
+        return BodyEncoding::Json;
+    }
+    std::string_view type = header->substr(0, header->find(';'));
+    while (!type.empty() && type.back() == ' ') {
+        type.remove_suffix(1);
+    }
+    auto is = [type](std::string_view expected) {
+        return type.size() == expected.size() &&
+               std::equal(type.begin(), type.end(), expected.begin(), [](char a, char b) {
+                   return std::tolower(static_cast<unsigned char>(a)) == b;
+               });
+    };
+    if (is("application/msgpack") || is("application/x-msgpack") || is("application/vnd.msgpack")) {
+        return BodyEncoding::MessagePack;
+    }
+    if (is("application/cbor")) {
+        return BodyEncoding::Cbor;
+    }
+    return BodyEncoding::Json;
+}
+
+Json parseBody(http::HttpResponse&& response) {
+    Json json;
+    switch (bodyEncoding(response)) {
+        case BodyEncoding::MessagePack:
+            json = Json::from_msgpack(response.body);
+            break;
+        case BodyEncoding::Cbor:
+            json = Json::from_cbor(response.body);
+            break;
+        case BodyEncoding::Json:
+#ifdef DATAAPI_WITH_SIMDJSON
+            json = parseWithSimdjson(response.body);
+#else
+            json = Json::parse(response.body);
+#endif
+            break;
+    }
+    std::string().swap(response.body);
+    return json;
+}
+
+std::vector<bool> decodePermissionResults(http::HttpResponse&& response, size_t expected) {
+    Json json = parseBody(std::move(response));
+    const Json& results = json.at("results");
+    if (!results.is_array() || results.size() != expected) {
+        throw std::runtime_error("Permission check returned " + std::to_string(results.size()) +
+                                 " results for " + std::to_string(expected) + " permissions");
+    }
+    std::vector<bool> decisions;
+    decisions.reserve(expected);
+    for (const auto& result : results) {
+        decisions.push_back(result.get<bool>());
+    }
+    return decisions;
+}
+
+} // namespace detail
+} // namespace client
+} // namespace dataapi
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+#include "dataapi/Types.h"
+#include "dataapi/http/HttpClient.h"
+#include "dataapi/utils/UrlUtils.h"
+
+namespace dataapi {
+namespace client {
+namespace detail {
+
+/**
+ * 构建JSON请求
+ * 请求体直接构建在请求配置中，发送时只序列化一次，不经过中间的Json副本；传入Json右值时直接移入
+ */
+template<typename T>
+HttpRequestConfig jsonRequest(HttpMethod method, std::string url, T&& payload) {
+    HttpRequestConfig request;
+    request.method = method;
+    request.url = std::move(url);
+    request.data = std::forward<T>(payload);
+    return request;
+}
+
+/**
+ * 构建上传请求
+ * 方法为POST，Content-Type按数据格式确定（csv、json、ndjson、xlsx，其余为application/octet-stream）
+ */
+HttpRequestConfig uploadRequest(std::string url, const std::string& format);
+
+/**
+ * 按响应状态码抛出对应的error异常
+ * 400/401/403/404/409/429/503映射到各自的异常类型，其余为HttpError
+ * @param response 响应
+ * @param message 错误消息
+ * @param notFound 404时的错误消息，为空时使用message
+ */
+[[noreturn]] void throwStatusError(const http::HttpResponse& response,
+                                   const std::string& message,
+                                   const std::string& notFound = "");
+
+/**
+ * 检查响应状态码，不等于expected时抛出异常
+ */
+inline void expectStatus(const http::HttpResponse& response,
+                         int expected,
+                         const std::string& message,
+                         const std::string& notFound = "") {
+    if (response.statusCode != expected) {
+        throwStatusError(response, message, notFound);
+    }
+}
+
+/**
+ * 解析JSON文本
+ * 默认使用nlohmann；以DATAAPI_ENABLE_SIMDJSON构建时使用simdjson
+ */
+Json parseJson(std::string_view text);
+
+/**
+ * 响应体编码，按Content-Type判断
+ */
+enum class BodyEncoding { Json, MessagePack, Cbor };
+
+BodyEncoding bodyEncoding(const http::HttpResponse& response);
+
+/**
+ * 解析响应体，解析后立即释放原始文本
+ * Content-Type为MessagePack或CBOR时按对应编码解析，得到与JSON相同的文档
+ */
+Json parseBody(http::HttpResponse&& response);
+
+/**
+ * 将响应体解码为T
+ * 只解析一次，字符串和Json字段尽量从DOM中移动而不是复制
+ */
+template<typename T>
+T decode(http::HttpResponse&& response) {
+    T value{};
+    takeFromJson(parseBody(std::move(response)), value);
+    return value;
+}
+
+/**
+ * 条件GET并解码为T
+ * HttpClient设置了ConditionalCache时携带上次响应的校验器，服务端返回304时
+ * 直接返回上次解码的对象；未设置时等同于get后decode
+ * 缓存以编码查询参数后的完整URL为键，不同参数的结果分别缓存
+ */
+template<typename T>
+T conditionalGet(http::HttpClient& client,
+                 const std::string& url,
+                 const std::string& message,
+                 const std::string& notFound = "",
+                 const Parameters& params = {}) {
+    auto cache = client.getConditionalCache();
+    std::shared_ptr<const http::ConditionalCache::Entry> cached;
+    std::string key;
+    Headers headers;
+    if (cache) {
+        key = url;
+        if (!params.empty()) {
+            key += url.find('?') == std::string::npos ? '?' : '&';
+            utils::UrlUtils::appendQueryString(key, params);
+        }
+        cached = cache->find(key);
+        if (cached && cached->type == typeid(T)) {
+            cached->validators.apply(headers);
+        } else {
+            cached.reset();
+        }
+    }
+    
+    auto response = client.get(url, params, headers);
+    if (cached && response.statusCode == 304) {
+        cache->recordNotModified();
+        return *static_cast<const T*>(cached->value.get());
+    }
+    expectStatus(response, 200, message, notFound);
+    if (!cache) {
+        return decode<T>(std::move(response));
+    }
+    auto validators = http::Validators::from(response.headers);
+    T value = decode<T>(std::move(response));
+    if (!validators.empty()) {
+        cache->store(key, std::move(validators), typeid(T), std::make_shared<const T>(value));
+    }
+    return value;
+}
+
+/**
+ * 解码批量权限检查的响应{"results": [bool, ...]}
+ * @throws std::runtime_error 结果数与请求的权限数不同
+ */
+std::vector<bool> decodePermissionResults(http::HttpResponse&& response, size_t expected);
+
+/**
+ * 将响应体解码为分页结果
+ */
+template<typename T>
+PageResult<T> decodePage(http::HttpResponse&& response) {
+    return parsePageResult<T>(parseBody(std::move(response)));
+}
+
+} // namespace detail
+} // namespace client
+} // namespace dataapi
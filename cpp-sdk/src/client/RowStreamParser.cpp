@@ -0,0 +1,191 @@
+#include "client/RowStreamParser.h"
+#include <stdexcept>
+
+namespace dataapi {
+namespace client {
+namespace detail {
+
+static bool isWhitespace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+RowStreamParser::RowStreamParser(std::string rowsKey, RowHandler onRow, FieldHandler onField)
+    : rowsKey(std::move(rowsKey)), onRow(std::move(onRow)), onField(std::move(onField)) {
+}
+
+void RowStreamParser::fail(char c) const {
+    throw std::runtime_error(std::string("Malformed query result stream near '") + c + "'");
+}
+
+bool RowStreamParser::scanValueChar(char c) {
+    if (inString) {
+        if (escape) {
+            escape = false;
+        } else if (c == '\\') {
+            escape = true;
+        } else if (c == '"') {
+            inString = false;
+        }
+        return false;
+    }
+    switch (c) {
+        case '"':
+            inString = true;
+            return false;
+        case '{':
+        case '[':
+            ++depth;
+            return false;
+        case '}':
+        case ']':
+            if (depth == 0) {
+                return true;
+            }
+            --depth;
+            return false;
+        case ',':
+            return depth == 0;
+        default:
+            return false;
+    }
+}
+
+bool RowStreamParser::feed(const char* data, size_t size) {
+    // 值内的连续字节按区间批量追加到capture，避免逐字符追加
+    size_t spanStart = std::string::npos;
+
+    for (size_t i = 0; i < size; ++i) {
+        char c = data[i];
+        switch (state) {
+            case State::Start:
+                if (c == '{') {
+                    state = State::ExpectKey;
+                } else if (!isWhitespace(c)) {
+                    fail(c);
+                }
+                break;
+
+            case State::ExpectKey:
+                if (c == '"') {
+                    key.clear();
+                    state = State::InKey;
+                } else if (c == '}') {
+                    state = State::Done;
+                } else if (!isWhitespace(c)) {
+                    fail(c);
+                }
+                break;
+
+            case State::InKey:
+                if (escape) {
+                    key += c;
+                    escape = false;
+                } else if (c == '\\') {
+                    escape = true;
+                } else if (c == '"') {
+                    state = State::ExpectColon;
+                } else {
+                    key += c;
+                }
+                break;
+
+            case State::ExpectColon:
+                if (c == ':') {
+                    state = State::ExpectValue;
+                } else if (!isWhitespace(c)) {
+                    fail(c);
+                }
+                break;
+
+            case State::ExpectValue:
+                if (isWhitespace(c)) {
+                    break;
+                }
+                if (c == '[' && key == rowsKey) {
+                    state = State::ExpectRow;
+                    break;
+                }
+                capture.clear();
+                depth = 0;
+                state = State::InValue;
+                spanStart = i;
+                if (scanValueChar(c)) {
+                    fail(c);
+                }
+                break;
+
+            case State::ExpectRow:
+                if (isWhitespace(c)) {
+                    break;
+                }
+                if (c == ']') {
+                    state = State::AfterValue;
+                    break;
+                }
+                capture.clear();
+                depth = 0;
+                state = State::InRow;
+                spanStart = i;
+                if (scanValueChar(c)) {
+                    fail(c);
+                }
+                break;
+
+            case State::InValue:
+            case State::InRow: {
+                if (spanStart == std::string::npos) {
+                    spanStart = i;
+                }
+                if (!scanValueChar(c)) {
+                    break;
+                }
+                capture.append(data + spanStart, i - spanStart);
+                spanStart = std::string::npos;
+
+                if (state == State::InValue) {
+                    if (c == ']') {
+                        fail(c);
+                    }
+                    if (onField) {
+                        onField(key, capture);
+                    }
+                    state = c == ',' ? State::ExpectKey : State::Done;
+                } else {
+                    if (c == '}') {
+                        fail(c);
+                    }
+                    if (!onRow(capture)) {
+                        return false;
+                    }
+                    state = c == ',' ? State::ExpectRow : State::AfterValue;
+                }
+                break;
+            }
+
+            case State::AfterValue:
+                if (c == ',') {
+                    state = State::ExpectKey;
+                } else if (c == '}') {
+                    state = State::Done;
+                } else if (!isWhitespace(c)) {
+                    fail(c);
+                }
+                break;
+
+            case State::Done:
+                if (!isWhitespace(c)) {
+                    fail(c);
+                }
+                break;
+        }
+    }
+
+    if (spanStart != std::string::npos) {
+        capture.append(data + spanStart, size - spanStart);
+    }
+    return true;
+}
+
+} // namespace detail
+} // namespace client
+} // namespace dataapi
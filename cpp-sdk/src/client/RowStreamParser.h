@@ -0,0 +1,87 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace dataapi {
+namespace client {
+namespace detail {
+
+/**
+ * 查询结果的增量解析器
+ *
+ * 按块接收形如{"columns": [...], "rows": [...], ...}的响应体，只跟踪JSON的嵌套层级和字符串状态，
+ * 将rows数组中的每个元素和其余顶层字段的原始文本切分出来交给回调，由回调各自解析。
+ * 内存占用只与单行大小有关，与结果集大小无关。
+ */
+class RowStreamParser {
+public:
+    /**
+     * 行回调，参数为一行的JSON文本，返回false停止解析
+     */
+    using RowHandler = std::function<bool(std::string_view text)>;
+
+    /**
+     * 字段回调，参数为顶层字段名和值的JSON文本
+     */
+    using FieldHandler = std::function<void(const std::string& name, std::string_view text)>;
+
+    /**
+     * 构造函数
+     * @param rowsKey 行数组所在的顶层字段名
+     * @param onRow 行回调
+     * @param onField 其他顶层字段的回调（可为空）
+     */
+    RowStreamParser(std::string rowsKey, RowHandler onRow, FieldHandler onField);
+
+    /**
+     * 输入一块数据
+     * @return 回调要求停止时返回false
+     * @throws std::runtime_error 响应体结构不合法
+     */
+    bool feed(const char* data, size_t size);
+
+    /**
+     * 顶层对象是否已完整解析
+     */
+    bool isComplete() const {
+        return state == State::Done;
+    }
+
+private:
+    enum class State {
+        Start,
+        ExpectKey,
+        InKey,
+        ExpectColon,
+        ExpectValue,
+        InValue,
+        ExpectRow,
+        InRow,
+        AfterValue,
+        Done
+    };
+
+    /**
+     * 扫描值内的一个字符，遇到深度为0的分隔符（, } ]）时返回true
+     */
+    bool scanValueChar(char c);
+
+    [[noreturn]] void fail(char c) const;
+
+    std::string rowsKey;
+    RowHandler onRow;
+    FieldHandler onField;
+
+    State state = State::Start;
+    std::string key;
+    std::string capture;
+    int depth = 0;
+    bool inString = false;
+    bool escape = false;
+};
+
+} // namespace detail
+} // namespace client
+} // namespace dataapi
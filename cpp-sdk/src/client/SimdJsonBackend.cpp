@@ -0,0 +1,74 @@
+#include "client/SimdJsonBackend.h"
+#include <simdjson.h>
+#include <stdexcept>
+#include <string_view>
+
+namespace dataapi {
+namespace client {
+namespace detail {
+
+// 文档和值的取值接口相同，统一按模板处理
+template<typename Node>
+static Json convert(Node&& node) {
+    using simdjson::ondemand::json_type;
+    using simdjson::ondemand::number_type;
+
+    switch (node.type().value()) {
+        case json_type::object: {
+            Json object = Json::object();
+            for (auto field : node.get_object()) {
+                std::string_view key = field.unescaped_key().value();
+                object[std::string(key)] = convert(field.value().value());
+            }
+            return object;
+        }
+        case json_type::array: {
+            Json array = Json::array();
+            for (auto element : node.get_array()) {
+                array.push_back(convert(element.value()));
+            }
+            return array;
+        }
+        case json_type::string:
+            return std::string(node.get_string().value());
+        case json_type::boolean:
+            return node.get_bool().value();
+        case json_type::null:
+            return nullptr;
+        case json_type::number:
+            switch (node.get_number_type().value()) {
+                case number_type::signed_integer:
+                    return node.get_int64().value();
+                case number_type::unsigned_integer:
+                    return node.get_uint64().value();
+                default:
+                    return node.get_double().value();
+            }
+    }
+    throw std::runtime_error("Unsupported JSON value");
+}
+
+Json parseWithSimdjson(std::string& text) {
+    thread_local simdjson::ondemand::parser parser;
+
+    size_t size = text.size();
+    if (text.capacity() < size + simdjson::SIMDJSON_PADDING) {
+        text.reserve(size + simdjson::SIMDJSON_PADDING);
+    }
+
+    try {
+        simdjson::padded_string_view view(text.data(), size, text.capacity());
+        auto document = parser.iterate(view).value();
+        Json json = convert(document);
+        if (!document.at_end()) {
+            throw std::runtime_error("trailing content");
+        }
+        return json;
+    } catch (const simdjson::simdjson_error& e) {
+        throw std::runtime_error(std::string("Invalid JSON response: ") + e.what());
+    }
+}
+
+} // namespace detail
+} // namespace client
+} // namespace dataapi
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string>
+#include "dataapi/Types.h"
+
+namespace dataapi {
+namespace client {
+namespace detail {
+
+/**
+ * 使用simdjson解析JSON文本并构建Json
+ * 在text的容量中补足simdjson要求的尾部填充，因此可能使text重新分配
+ * @throws std::runtime_error JSON格式无效
+ */
+Json parseWithSimdjson(std::string& text);
+
+} // namespace detail
+} // namespace client
+} // namespace dataapi
@@ -0,0 +1,89 @@
+#include "client/TimeSeriesFetch.h"
+#include "client/AsyncBatch.h"
+#include "client/ResponseDecoder.h"
+#include <algorithm>
+#include <exception>
+#include <vector>
+
+namespace dataapi {
+namespace client {
+namespace detail {
+
+TimeSeries fetchTimeSeries(http::HttpClient& httpClient,
+                           const std::string& url,
+                           Timestamp start,
+                           Timestamp end,
+                           const TimeSeriesOptions& options,
+                           const std::string& failure,
+                           const std::string& notFound) {
+    int64_t from = toUnixMillis(start);
+    int64_t to = toUnixMillis(end);
+    if (to <= from) {
+        return TimeSeries();
+    }
+    
+    // 窗口长度取step的整数倍，边界对齐到窗口长度的整数倍（自Unix纪元起），
+    // 服务端按step对齐的聚合桶不会跨越两个窗口
+    int64_t step = options.step.count();
+    int64_t window = std::max<int64_t>(options.window.count(), 1);
+    if (step > 0) {
+        window = std::max<int64_t>(1, (window + step - 1) / step) * step;
+    }
+    std::vector<std::pair<int64_t, int64_t>> windows;
+    for (int64_t begin = from; begin < to;) {
+        int64_t index = begin / window - (begin % window < 0 ? 1 : 0);
+        int64_t stop = std::min(to, (index + 1) * window);
+        windows.emplace_back(begin, stop);
+        begin = stop;
+    }
+    
+    std::vector<TimeSeries> parts(windows.size());
+    std::vector<std::exception_ptr> errors(windows.size());
+    AsyncWindow inflight(options.concurrency);
+    for (size_t i = 0; i < windows.size(); ++i) {
+        HttpRequestConfig request;
+        request.method = HttpMethod::GET;
+        request.url = url;
+        request.params = {{"start", std::to_string(windows[i].first)}, {"end", std::to_string(windows[i].second)}};
+        if (step > 0) {
+            request.params["step"] = std::to_string(step);
+        }
+        inflight.acquire();
+        try {
+            httpClient.requestAsync(std::move(request), [&, i](http::HttpResponse response, std::exception_ptr error) {
+                if (!error) {
+                    try {
+                        expectStatus(response, 200, failure, notFound);
+                        parts[i] = TimeSeries::parse(response.body);
+                    } catch (...) {
+                        error = std::current_exception();
+                    }
+                }
+                errors[i] = error;
+                inflight.release();
+            });
+        } catch (...) {
+            errors[i] = std::current_exception();
+            inflight.release();
+        }
+    }
+    inflight.wait();
+    
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    if (parts.size() == 1) {
+        return std::move(parts.front());
+    }
+    TimeSeries series = std::move(parts.front());
+    for (size_t i = 1; i < parts.size(); ++i) {
+        series.append(parts[i]);
+    }
+    return series;
+}
+
+} // namespace detail
+} // namespace client
+} // namespace dataapi
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include "dataapi/Types.h"
+#include "dataapi/types/TimeSeries.h"
+#include "dataapi/http/HttpClient.h"
+
+namespace dataapi {
+namespace client {
+namespace detail {
+
+/**
+ * 分窗口并行获取[start, end)内的时间序列
+ * 每个窗口发出一个GET url?start=<毫秒>&end=<毫秒>[&step=<毫秒>]请求，最多options.concurrency个同时在途；
+ * 响应流式解码为列，按时间顺序合并，窗口边界上重复的点只保留一个。任一窗口失败时抛出其异常
+ * @param failure 非200响应的错误消息
+ * @param notFound 404时的错误消息
+ */
+TimeSeries fetchTimeSeries(http::HttpClient& httpClient,
+                           const std::string& url,
+                           Timestamp start,
+                           Timestamp end,
+                           const TimeSeriesOptions& options,
+                           const std::string& failure,
+                           const std::string& notFound);
+
+} // namespace detail
+} // namespace client
+} // namespace dataapi
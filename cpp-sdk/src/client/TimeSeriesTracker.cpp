@@ -0,0 +1,28 @@
+#include "dataapi/client/TimeSeriesTracker.h"
+
+namespace dataapi {
+namespace client {
+
+TimeSeriesTracker::TimeSeriesTracker(Fetch fetch, std::chrono::milliseconds range)
+    : fetch(std::move(fetch)), range(range) {
+}
+
+const TimeSeries& TimeSeriesTracker::refresh(Timestamp now) {
+    Timestamp horizon = now - range;
+    if (series.empty()) {
+        series = fetch(horizon, now);
+    } else {
+        // 最后一个桶可能在上次获取后继续累积，从它开始重新获取
+        int64_t last = series.lastTimestamp();
+        TimeSeries tail = fetch(fromUnixMillis(last), now);
+        if (!tail.empty()) {
+            series.truncateFrom(last);
+            series.append(tail);
+        }
+    }
+    series.dropBefore(toUnixMillis(horizon));
+    return series;
+}
+
+} // namespace client
+} // namespace dataapi
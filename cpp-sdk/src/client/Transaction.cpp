@@ -0,0 +1,97 @@
+#include "dataapi/client/Transaction.h"
+#include "dataapi/error/DataApiError.h"
+#include "client/ResponseDecoder.h"
+#include "client/TransactionPipeline.h"
+#include <utility>
+
+namespace dataapi {
+namespace client {
+
+Transaction::Transaction(std::shared_ptr<http::HttpClient> httpClient,
+                         std::string databaseId,
+                         const TransactionOptions& options)
+    : httpClient(std::move(httpClient)),
+      databaseId(std::move(databaseId)),
+      pipeline(std::make_shared<detail::TransactionPipeline>(options.bundle)) {
+}
+
+Transaction::~Transaction() {
+    if (closed) {
+        return;
+    }
+    try {
+        rollback();
+    } catch (...) {
+        // 析构时回滚失败的事务由服务端超时回收
+    }
+}
+
+std::future<QueryResult> Transaction::execute(std::string sql, Parameters params) {
+    auto result = pipeline->add(std::move(sql), std::move(params));
+    pump(httpClient, pipeline, databaseId);
+    return result;
+}
+
+void Transaction::pump(std::shared_ptr<http::HttpClient> httpClient,
+                       std::shared_ptr<detail::TransactionPipeline> pipeline,
+                       const std::string& databaseId) {
+    auto batch = pipeline->takeBatch();
+    if (!batch) {
+        return;
+    }
+    auto request = detail::jsonRequest(HttpMethod::POST, "/databases/" + databaseId + "/transactions/pipeline",
+                                       std::move(*batch));
+    request.binaryResponse = true;
+    try {
+        httpClient->requestAsync(
+            std::move(request),
+            [httpClient, pipeline, databaseId](http::HttpResponse response, std::exception_ptr error) {
+                if (!error) {
+                    try {
+                        detail::expectStatus(response, 200, "Failed to execute transaction",
+                                             "Database not found: " + databaseId);
+                        pipeline->complete(detail::parseBody(std::move(response)));
+                    } catch (...) {
+                        error = std::current_exception();
+                    }
+                }
+                if (error) {
+                    pipeline->fail(error);
+                    return;
+                }
+                pump(httpClient, pipeline, databaseId);
+            });
+    } catch (...) {
+        pipeline->fail(std::current_exception());
+    }
+}
+
+void Transaction::commit() {
+    pipeline->requestCommit();
+    pump(httpClient, pipeline, databaseId);
+    // 失败时保持未关闭，析构时回滚
+    pipeline->waitCommitted();
+    closed = true;
+}
+
+void Transaction::rollback() {
+    closed = true;
+    pipeline->abandon(std::make_exception_ptr(error::DataApiError("Transaction rolled back", "TRANSACTION_ROLLED_BACK")));
+    pipeline->waitIdle();
+    std::string transactionId = pipeline->getTransactionId();
+    if (transactionId.empty() || pipeline->isCommitted()) {
+        return;
+    }
+    auto response = httpClient->post("/databases/" + databaseId + "/transactions/" + transactionId + "/rollback");
+    // 服务端已因语句失败自行回滚时视为成功
+    if (response.statusCode != 200 && response.statusCode != 204 && response.statusCode != 404) {
+        detail::throwStatusError(response, "Failed to rollback transaction");
+    }
+}
+
+std::string Transaction::getTransactionId() const {
+    return pipeline->getTransactionId();
+}
+
+} // namespace client
+} // namespace dataapi
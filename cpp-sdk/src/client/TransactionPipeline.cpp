@@ -0,0 +1,148 @@
+#include "client/TransactionPipeline.h"
+#include "dataapi/error/DataApiError.h"
+#include <stdexcept>
+#include <utility>
+
+namespace dataapi {
+namespace client {
+namespace detail {
+
+static std::exception_ptr closedError() {
+    return std::make_exception_ptr(error::DataApiError("Transaction is no longer active", "TRANSACTION_CLOSED"));
+}
+
+std::future<QueryResult> TransactionPipeline::add(std::string sql, Parameters params) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Statement statement{std::move(sql), std::move(params), {}};
+    auto result = statement.result.get_future();
+    if (error || commitRequested) {
+        statement.result.set_exception(error ? error : closedError());
+        return result;
+    }
+    queued.push_back(std::move(statement));
+    return result;
+}
+
+void TransactionPipeline::requestCommit() {
+    std::lock_guard<std::mutex> lock(mutex);
+    commitRequested = true;
+    // 从未发出过语句：服务端没有事务，无需提交
+    if (!begun && !sending && queued.empty()) {
+        committed = true;
+        idle.notify_all();
+    }
+}
+
+std::optional<Json> TransactionPipeline::takeBatch() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (sending || error || committed || commitSent) {
+        return std::nullopt;
+    }
+    bool commitNow = commitRequested;
+    if (queued.empty() ? !(commitNow && begun) : (bundle && !commitNow)) {
+        return std::nullopt;
+    }
+
+    Json batch = Json::object();
+    if (begun) {
+        batch["transactionId"] = transactionId;
+    }
+    batch["begin"] = !begun;
+    Json statements = Json::array();
+    auto& items = statements.get_ref<Json::array_t&>();
+    items.reserve(queued.size());
+    for (auto& statement : queued) {
+        Json item;
+        item["sql"] = std::move(statement.sql);
+        if (!statement.params.empty()) {
+            item["params"] = std::move(statement.params);
+        }
+        items.push_back(std::move(item));
+    }
+    batch["statements"] = std::move(statements);
+    batch["commit"] = commitNow;
+
+    inFlight = std::move(queued);
+    queued.clear();
+    sending = true;
+    begun = true;
+    commitSent = commitNow;
+    return batch;
+}
+
+void TransactionPipeline::complete(Json response) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto id = response.find("transactionId");
+    if (id != response.end() && id->is_string()) {
+        transactionId = id->get<std::string>();
+    }
+    auto results = response.find("results");
+    if (results == response.end() || !results->is_array() || results->size() != inFlight.size()) {
+        error = std::make_exception_ptr(std::runtime_error("Transaction result count mismatch"));
+        failAll(inFlight, error);
+        failAll(queued, error);
+    } else {
+        auto& items = results->get_ref<Json::array_t&>();
+        for (size_t i = 0; i < inFlight.size(); ++i) {
+            QueryResult result{};
+            takeFromJson(std::move(items[i]), result);
+            inFlight[i].result.set_value(std::move(result));
+        }
+        inFlight.clear();
+        committed = commitSent;
+    }
+    sending = false;
+    idle.notify_all();
+}
+
+void TransactionPipeline::fail(std::exception_ptr failure) {
+    std::lock_guard<std::mutex> lock(mutex);
+    error = failure;
+    failAll(inFlight, failure);
+    failAll(queued, failure);
+    sending = false;
+    idle.notify_all();
+}
+
+void TransactionPipeline::abandon(std::exception_ptr failure) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!error) {
+        error = failure;
+    }
+    failAll(queued, failure);
+    idle.notify_all();
+}
+
+void TransactionPipeline::failAll(std::deque<Statement>& statements, std::exception_ptr failure) {
+    for (auto& statement : statements) {
+        statement.result.set_exception(failure);
+    }
+    statements.clear();
+}
+
+void TransactionPipeline::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return !sending; });
+}
+
+void TransactionPipeline::waitCommitted() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return committed || error; });
+    if (!committed) {
+        std::rethrow_exception(error);
+    }
+}
+
+std::string TransactionPipeline::getTransactionId() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return transactionId;
+}
+
+bool TransactionPipeline::isCommitted() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return committed;
+}
+
+} // namespace detail
+} // namespace client
+} // namespace dataapi
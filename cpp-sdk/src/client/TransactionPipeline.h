@@ -0,0 +1,107 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+#include "dataapi/Types.h"
+
+namespace dataapi {
+namespace client {
+namespace detail {
+
+/**
+ * 事务语句流水线的状态
+ *
+ * 语句先进入队列；同一时刻最多一个批次在途，在途期间加入的语句合并进下一批次。
+ * 首个批次携带begin，提交请求到达时最后一个批次携带commit，因此begin、语句和commit
+ * 可以合并在一个请求中。bundle为true时只在提交时发出唯一的批次。
+ * 不发起网络请求，由调用方发送takeBatch()的请求体并以complete/fail回报结果。线程安全。
+ *
+ * 批次请求体：{"transactionId"?, "begin": bool, "statements": [{"sql", "params"?}], "commit": bool}
+ * 批次响应体：{"transactionId": string, "results": [QueryResult...]}
+ */
+class TransactionPipeline {
+public:
+    explicit TransactionPipeline(bool bundle) : bundle(bundle) {}
+
+    /**
+     * 加入语句，事务已结束或失败时返回已失败的future
+     */
+    std::future<QueryResult> add(std::string sql, Parameters params);
+
+    /**
+     * 请求提交，剩余语句与commit合并为最后一个批次
+     */
+    void requestCommit();
+
+    /**
+     * 取出下一批次的请求体并标记为在途；已有批次在途或无需发送时返回空
+     */
+    std::optional<Json> takeBatch();
+
+    /**
+     * 在途批次成功，按顺序完成其中语句的future
+     */
+    void complete(Json response);
+
+    /**
+     * 在途批次失败，该批次及队列中的语句均以error失败，之后加入的语句立即失败
+     */
+    void fail(std::exception_ptr error);
+
+    /**
+     * 放弃队列中尚未发送的语句（回滚时），之后加入的语句立即失败
+     */
+    void abandon(std::exception_ptr error);
+
+    /**
+     * 等待在途批次结束
+     */
+    void waitIdle();
+
+    /**
+     * 等待提交完成，失败时重新抛出错误
+     */
+    void waitCommitted();
+
+    /**
+     * 服务端事务ID，首个批次完成前为空
+     */
+    std::string getTransactionId() const;
+
+    /**
+     * 已提交
+     */
+    bool isCommitted() const;
+
+private:
+    struct Statement {
+        std::string sql;
+        Parameters params;
+        std::promise<QueryResult> result;
+    };
+
+    void failAll(std::deque<Statement>& statements, std::exception_ptr error);
+
+    const bool bundle;
+    mutable std::mutex mutex;
+    std::condition_variable idle;
+    std::deque<Statement> queued;
+    std::deque<Statement> inFlight;
+    bool sending = false;
+    bool begun = false;
+    bool commitRequested = false;
+    bool commitSent = false;
+    bool committed = false;
+    std::exception_ptr error;
+    std::string transactionId;
+};
+
+} // namespace detail
+} // namespace client
+} // namespace dataapi
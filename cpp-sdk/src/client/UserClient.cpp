@@ -1,10 +1,15 @@
 #include "dataapi/client/UserClient.h"
 #include "dataapi/Types.h"
 #include "dataapi/exceptions/DataApiException.h"
-#include <sstream>
+#include "client/ResponseDecoder.h"
+#include "client/CachedLookup.h"
+#ifdef DATAAPI_WITH_COROUTINES
+#include "client/AsyncRequests.h"
+#endif
 #include <stdexcept>
 #include <string>
 #include <memory>
+#include <unordered_map>
 
 namespace dataapi {
 namespace client {
@@ -12,105 +17,179 @@ namespace client {
 UserClient::UserClient(std::shared_ptr<http::HttpClient> httpClient) : httpClient(httpClient) {
 }
 
-PageResult<SysUser> UserClient::list(int page, int size, const std::string& search, const std::string& role) {
-    std::ostringstream oss;
-    oss << "/users?page=" << page << "&size=" << size;
-    
-    auto response = httpClient->get(oss.str());
-    if (response.statusCode != 200) {
-        throw std::runtime_error("Failed to list users");
+/**
+ * 列表查询参数，过滤条件为空时省略
+ */
+static Parameters listParams(int page, int size, const std::string& search, const std::string& role) {
+    Parameters params{{"page", std::to_string(page)}, {"size", std::to_string(size)}};
+    if (!search.empty()) {
+        params["search"] = search;
     }
-    
-    Json json = Json::parse(response.body);
-    PageResult<SysUser> result;
-    
-    result.content.clear();
-    for (const auto& item : json["content"]) {
-        SysUser user;
-        from_json(item, user);
-        result.content.push_back(user);
+    if (!role.empty()) {
+        params["role"] = role;
     }
-    
-    result.totalElements = json["totalElements"].get<long>();
-    result.totalPages = json["totalPages"].get<int>();
-    result.pageSize = json["size"].get<int>();
-    result.pageNumber = json["number"].get<int>();
-    result.empty = json.value("empty", false);
-    result.first = json["first"].get<bool>();
-    result.last = json["last"].get<bool>();
-    
-    return result;
+    return params;
+}
+
+PageResult<SysUser> UserClient::list(int page, int size, const std::string& search, const std::string& role) {
+    auto response = httpClient->get("/users", listParams(page, size, search, role));
+    detail::expectStatus(response, 200, "Failed to list users");
+    return detail::decodePage<SysUser>(std::move(response));
+}
+
+Paginator<SysUser> UserClient::paginate(int size, const std::string& search, const std::string& role, const PaginatorOptions& options) {
+    return Paginator<SysUser>(
+        [this, size, search, role](int page) {
+            return list(page, size, search, role);
+        },
+        options.pageBase, options);
 }
 
 SysUser UserClient::getById(const std::string& id) {
     auto response = httpClient->get("/users/" + id);
-    if (response.statusCode == 404) {
-        throw std::runtime_error("User not found: " + id);
-    }
-    if (response.statusCode != 200) {
-        throw std::runtime_error("Failed to get user");
-    }
-    
-    Json json = Json::parse(response.body);
-    SysUser user;
-    from_json(json, user);
-    return user;
+    detail::expectStatus(response, 200, "Failed to get user", "User not found: " + id);
+    return detail::decode<SysUser>(std::move(response));
 }
 
 SysUser UserClient::getCurrentUser() {
     auto response = httpClient->get("/users/me");
-    if (response.statusCode != 200) {
-        throw std::runtime_error("Failed to get current user");
-    }
-    
-    Json json = Json::parse(response.body);
-    SysUser user;
-    from_json(json, user);
-    return user;
+    detail::expectStatus(response, 200, "Failed to get current user");
+    return detail::decode<SysUser>(std::move(response));
 }
 
 SysUser UserClient::create(const UserCreateRequest& request) {
-    Json json;
-    to_json(json, request);
-    
-    auto response = httpClient->post("/users", json);
-    if (response.statusCode != 201) {
-        throw std::runtime_error("Failed to create user");
-    }
-    
-    Json responseJson = Json::parse(response.body);
-    SysUser user;
-    from_json(responseJson, user);
-    return user;
+    auto response = httpClient->request(detail::jsonRequest(HttpMethod::POST, "/users", request));
+    detail::expectStatus(response, 201, "Failed to create user");
+    return detail::decode<SysUser>(std::move(response));
 }
 
 SysUser UserClient::update(const std::string& id, const UserUpdateRequest& request) {
-    Json json;
-    to_json(json, request);
-    
-    auto response = httpClient->put("/users/" + id, json);
-    if (response.statusCode == 404) {
-        throw std::runtime_error("User not found: " + id);
-    }
-    if (response.statusCode != 200) {
-        throw std::runtime_error("Failed to update user");
-    }
-    
-    Json responseJson = Json::parse(response.body);
-    SysUser user;
-    from_json(responseJson, user);
-    return user;
+    auto response = httpClient->request(detail::jsonRequest(HttpMethod::PUT, "/users/" + id, request));
+    detail::expectStatus(response, 200, "Failed to update user", "User not found: " + id);
+    return detail::decode<SysUser>(std::move(response));
 }
 
 void UserClient::deleteUser(const std::string& id) {
+    detail::ScopedInvalidation invalidation(metadataCache, {MetadataKind::UserPermissions}, id);
     auto response = httpClient->del("/users/" + id);
-    if (response.statusCode == 404) {
-        throw std::runtime_error("User not found: " + id);
+    detail::expectStatus(response, 204, "Failed to delete user", "User not found: " + id);
+}
+
+void UserClient::setUserRoles(const std::string& userId, const std::vector<std::string>& roleIds) {
+    detail::ScopedInvalidation invalidation(metadataCache, {MetadataKind::UserPermissions}, userId);
+    auto response = httpClient->request(detail::jsonRequest(HttpMethod::PUT, "/users/" + userId + "/roles",
+                                                            Json{{"roleIds", roleIds}}));
+    if (!response.isSuccess()) {
+        detail::throwStatusError(response, "Failed to set user roles", "User not found: " + userId);
     }
-    if (response.statusCode != 204) {
-        throw std::runtime_error("Failed to delete user");
+}
+
+void UserClient::addUserRole(const std::string& userId, const std::string& roleId) {
+    detail::ScopedInvalidation invalidation(metadataCache, {MetadataKind::UserPermissions}, userId);
+    auto response = httpClient->post("/users/" + userId + "/roles/" + roleId);
+    if (!response.isSuccess()) {
+        detail::throwStatusError(response, "Failed to add user role", "User or role not found: " + userId + "/" + roleId);
     }
 }
 
+void UserClient::removeUserRole(const std::string& userId, const std::string& roleId) {
+    detail::ScopedInvalidation invalidation(metadataCache, {MetadataKind::UserPermissions}, userId);
+    auto response = httpClient->del("/users/" + userId + "/roles/" + roleId);
+    if (!response.isSuccess()) {
+        detail::throwStatusError(response, "Failed to remove user role", "User or role not found: " + userId + "/" + roleId);
+    }
+}
+
+std::vector<UserPermission> UserClient::getUserPermissions(const std::string& userId) {
+    return detail::conditionalGet<std::vector<UserPermission>>(*httpClient, "/users/" + userId + "/permissions",
+                                                               "Failed to get user permissions", "User not found: " + userId);
+}
+
+/**
+ * 用户权限快照，权限名称到是否允许
+ */
+using PermissionSnapshot = std::shared_ptr<const std::unordered_map<std::string, bool>>;
+
+static PermissionSnapshot makeSnapshot(const std::vector<UserPermission>& permissions) {
+    auto snapshot = std::make_shared<std::unordered_map<std::string, bool>>();
+    for (const auto& permission : permissions) {
+        std::string name = permission.resource.empty() ? permission.action
+                                                       : permission.resource + ":" + permission.action;
+        auto inserted = snapshot->emplace(std::move(name), permission.allowed);
+        // 同名条目中有拒绝时以拒绝为准
+        inserted.first->second = inserted.first->second && permission.allowed;
+    }
+    return snapshot;
+}
+
+bool UserClient::hasPermission(const std::string& userId, const std::string& permission) {
+    return hasPermissions(userId, {permission}).front();
+}
+
+std::vector<bool> UserClient::hasPermissions(const std::string& userId, const std::vector<std::string>& permissions) {
+    if (permissions.empty()) {
+        return {};
+    }
+    if (metadataCache && metadataCache->ttl(MetadataKind::UserPermissions).count() > 0) {
+        auto snapshot = metadataCache->get<PermissionSnapshot>(MetadataKind::UserPermissions, userId, "", [&] {
+            return makeSnapshot(getUserPermissions(userId));
+        });
+        std::vector<bool> decisions;
+        decisions.reserve(permissions.size());
+        for (const auto& permission : permissions) {
+            auto found = snapshot->find(permission);
+            decisions.push_back(found != snapshot->end() && found->second);
+        }
+        return decisions;
+    }
+    
+    auto response = httpClient->request(detail::jsonRequest(HttpMethod::POST, "/users/" + userId + "/permissions/check",
+                                                            Json{{"permissions", permissions}}));
+    detail::expectStatus(response, 200, "Failed to check user permissions", "User not found: " + userId);
+    return detail::decodePermissionResults(std::move(response), permissions.size());
+}
+
+void UserClient::setMetadataCache(std::shared_ptr<MetadataCache> cache) {
+    metadataCache = std::move(cache);
+}
+
+std::shared_ptr<MetadataCache> UserClient::getMetadataCache() const {
+    return metadataCache;
+}
+
+#ifdef DATAAPI_WITH_COROUTINES
+
+coro::Task<PageResult<SysUser>> UserClient::listAsync(int page, int size, std::string search, std::string role) {
+    return detail::fetchPageAsync<SysUser>(*httpClient, detail::getRequest("/users", listParams(page, size, search, role)),
+                                           "Failed to list users");
+}
+
+coro::Task<SysUser> UserClient::getByIdAsync(std::string id) {
+    return detail::fetchAsync<SysUser>(*httpClient, detail::getRequest("/users/" + id),
+                                       200, "Failed to get user", "User not found: " + id);
+}
+
+coro::Task<SysUser> UserClient::getCurrentUserAsync() {
+    return detail::fetchAsync<SysUser>(*httpClient, detail::getRequest("/users/me"), 200, "Failed to get current user");
+}
+
+coro::Task<SysUser> UserClient::createAsync(UserCreateRequest request) {
+    return detail::fetchAsync<SysUser>(*httpClient, detail::jsonRequest(HttpMethod::POST, "/users", request),
+                                       201, "Failed to create user");
+}
+
+coro::Task<SysUser> UserClient::updateAsync(std::string id, UserUpdateRequest request) {
+    return detail::fetchAsync<SysUser>(*httpClient, detail::jsonRequest(HttpMethod::PUT, "/users/" + id, request),
+                                       200, "Failed to update user", "User not found: " + id);
+}
+
+coro::Task<void> UserClient::deleteUserAsync(std::string id) {
+    detail::ScopedInvalidation invalidation(metadataCache, {MetadataKind::UserPermissions}, id);
+    co_await detail::sendAsync(*httpClient, detail::deleteRequest("/users/" + id),
+                               204, "Failed to delete user", "User not found: " + id);
+}
+
+#endif
+
 } // namespace client
 } // namespace dataapi
\ No newline at end of file
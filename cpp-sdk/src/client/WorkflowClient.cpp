@@ -1,6 +1,13 @@
 #include "dataapi/client/WorkflowClient.h"
 #include "dataapi/error/DataApiError.h"
-#include <sstream>
+#include "client/ResponseDecoder.h"
+#include "client/AsyncBatch.h"
+#include "client/CachedLookup.h"
+#ifdef DATAAPI_WITH_COROUTINES
+#include "client/AsyncRequests.h"
+#endif
+#include <algorithm>
+#include <thread>
 
 namespace dataapi {
 namespace client {
@@ -8,110 +15,288 @@ namespace client {
 WorkflowClient::WorkflowClient(std::shared_ptr<http::HttpClient> httpClient) : httpClient(httpClient) {
 }
 
-PageResult<SysWorkflow> WorkflowClient::list(int page, int size, const std::string& projectId, const std::string& userId) {
-    std::ostringstream oss;
-    oss << "/workflows?page=" << page << "&size=" << size;
-    
-    auto response = httpClient->get(oss.str());
-    if (response.statusCode != 200) {
-        throw error::HttpError("Failed to list workflows", response.statusCode);
+/**
+ * 列表查询参数，过滤条件为空时省略
+ */
+static Parameters listParams(int page, int size, const std::string& projectId, const std::string& userId) {
+    Parameters params{{"page", std::to_string(page)}, {"size", std::to_string(size)}};
+    if (!projectId.empty()) {
+        params["projectId"] = projectId;
     }
-    
-    auto json = Json::parse(response.body);
-    PageResult<SysWorkflow> result;
-    
-    result.content.clear();
-    for (const auto& item : json["content"]) {
-        SysWorkflow workflow;
-        from_json(item, workflow);
-        result.content.push_back(workflow);
+    if (!userId.empty()) {
+        params["userId"] = userId;
     }
-    
-    result.totalElements = json["totalElements"].get<long>();
-    result.totalPages = json["totalPages"].get<int>();
-    result.pageSize = json["size"].get<int>();
-    result.pageNumber = json["number"].get<int>();
-    result.first = json["first"].get<bool>();
-    result.last = json["last"].get<bool>();
-    result.empty = json.value("empty", false);
-    
-    return result;
+    return params;
+}
+
+PageResult<SysWorkflow> WorkflowClient::list(int page, int size, const std::string& projectId, const std::string& userId) {
+    auto response = httpClient->get("/workflows", listParams(page, size, projectId, userId));
+    detail::expectStatus(response, 200, "Failed to list workflows");
+    return detail::decodePage<SysWorkflow>(std::move(response));
+}
+
+Paginator<SysWorkflow> WorkflowClient::paginate(int size, const std::string& projectId, const std::string& userId, const PaginatorOptions& options) {
+    return Paginator<SysWorkflow>(
+        [this, size, projectId, userId](int page) {
+            return list(page, size, projectId, userId);
+        },
+        options.pageBase, options);
 }
 
 SysWorkflow WorkflowClient::getById(const std::string& id) {
-    auto response = httpClient->get("/workflows/" + id);
-    if (response.statusCode == 404) {
-        throw error::NotFoundError("Workflow not found: " + id);
-    }
-    if (response.statusCode != 200) {
-        throw error::HttpError("Failed to get workflow", response.statusCode);
-    }
-    
-    auto json = Json::parse(response.body);
-    SysWorkflow workflow;
-    from_json(json, workflow);
-    return workflow;
+    return detail::cachedLookup<SysWorkflow>(metadataCache, MetadataKind::Workflow, id, "", [&] {
+        return detail::conditionalGet<SysWorkflow>(*httpClient, "/workflows/" + id,
+                                                   "Failed to get workflow", "Workflow not found: " + id);
+    });
 }
 
 SysWorkflow WorkflowClient::create(const WorkflowCreateRequest& request) {
-    Json json;
-    to_json(json, request);
-    
-    auto response = httpClient->post("/workflows", json.dump());
-    if (response.statusCode != 201) {
-        throw error::HttpError("Failed to create workflow", response.statusCode);
-    }
-    
-    auto responseJson = Json::parse(response.body);
-    SysWorkflow workflow;
-    from_json(responseJson, workflow);
-    return workflow;
+    auto response = httpClient->request(detail::jsonRequest(HttpMethod::POST, "/workflows", request));
+    detail::expectStatus(response, 201, "Failed to create workflow");
+    return detail::decode<SysWorkflow>(std::move(response));
 }
 
 SysWorkflow WorkflowClient::update(const std::string& id, const WorkflowUpdateRequest& request) {
-    Json json;
-    to_json(json, request);
-    
-    auto response = httpClient->put("/workflows/" + id, json.dump());
-    if (response.statusCode == 404) {
-        throw error::NotFoundError("Workflow not found: " + id);
-    }
-    if (response.statusCode != 200) {
-        throw error::HttpError("Failed to update workflow", response.statusCode);
-    }
-    
-    auto responseJson = Json::parse(response.body);
-    SysWorkflow workflow;
-    from_json(responseJson, workflow);
-    return workflow;
+    detail::ScopedInvalidation invalidation(metadataCache, {MetadataKind::Workflow}, id);
+    auto response = httpClient->request(detail::jsonRequest(HttpMethod::PUT, "/workflows/" + id, request));
+    detail::expectStatus(response, 200, "Failed to update workflow", "Workflow not found: " + id);
+    return detail::decode<SysWorkflow>(std::move(response));
 }
 
 void WorkflowClient::deleteWorkflow(const std::string& id) {
+    detail::ScopedInvalidation invalidation(metadataCache, {MetadataKind::Workflow}, id);
     auto response = httpClient->del("/workflows/" + id);
-    if (response.statusCode == 404) {
-        throw error::NotFoundError("Workflow not found: " + id);
+    detail::expectStatus(response, 204, "Failed to delete workflow", "Workflow not found: " + id);
+}
+
+void WorkflowClient::setMetadataCache(std::shared_ptr<MetadataCache> cache) {
+    metadataCache = std::move(cache);
+}
+
+std::shared_ptr<MetadataCache> WorkflowClient::getMetadataCache() const {
+    return metadataCache;
+}
+
+WorkflowValidationResult WorkflowClient::validate(const Json& definition) {
+    auto response = httpClient->request(detail::jsonRequest(HttpMethod::POST, "/workflows/validate", definition));
+    detail::expectStatus(response, 200, "Failed to validate workflow");
+    return detail::decode<WorkflowValidationResult>(std::move(response));
+}
+
+static std::shared_ptr<const WorkflowSchema> fetchSchema(http::HttpClient& httpClient) {
+    auto response = httpClient.get("/workflows/schema");
+    detail::expectStatus(response, 200, "Failed to get workflow schema");
+    return WorkflowSchema::compile(detail::parseBody(std::move(response)));
+}
+
+std::shared_ptr<const WorkflowSchema> WorkflowClient::getSchema() {
+    if (metadataCache) {
+        return detail::cachedLookup<std::shared_ptr<const WorkflowSchema>>(metadataCache, MetadataKind::WorkflowSchema, "", "",
+                                                                           [&] { return fetchSchema(*httpClient); });
     }
-    if (response.statusCode != 204) {
-        throw error::HttpError("Failed to delete workflow", response.statusCode);
+    // 未设置元数据缓存时在客户端内保留编译结果；并发的首次调用可能各自获取一次，之后共用同一份
+    auto schema = std::atomic_load(&compiledSchema);
+    if (!schema) {
+        schema = fetchSchema(*httpClient);
+        std::atomic_store(&compiledSchema, schema);
     }
+    return schema;
+}
+
+WorkflowValidator WorkflowClient::createValidator() {
+    return WorkflowValidator(getSchema());
+}
+
+SysWorkflow WorkflowClient::importWorkflow(const Json& definition, const std::string& name, const std::string& description) {
+    Json payload = {{"definition", definition}, {"name", name}};
+    if (!description.empty()) {
+        payload["description"] = description;
+    }
+    auto response = httpClient->request(detail::jsonRequest(HttpMethod::POST, "/workflows/import", std::move(payload)));
+    detail::expectStatus(response, 201, "Failed to import workflow");
+    return detail::decode<SysWorkflow>(std::move(response));
+}
+
+/**
+ * 执行工作流并解码结果
+ */
+static WorkflowExecutionResult executeRequest(http::HttpClient& httpClient, const std::string& id, HttpRequestConfig&& request) {
+    auto response = httpClient.request(request);
+    detail::expectStatus(response, 200, "Failed to execute workflow", "Workflow not found: " + id);
+    return detail::decode<WorkflowExecutionResult>(std::move(response));
 }
 
 WorkflowExecutionResult WorkflowClient::execute(const std::string& id, const Json& input) {
-    Json json = input;
-    
-    auto response = httpClient->post("/workflows/" + id + "/execute", json.dump());
-    if (response.statusCode == 404) {
-        throw error::NotFoundError("Workflow not found: " + id);
+    return executeRequest(*httpClient, id, detail::jsonRequest(HttpMethod::POST, "/workflows/" + id + "/execute", input));
+}
+
+WorkflowExecutionResult WorkflowClient::execute(const std::string& id, Json&& input) {
+    return executeRequest(*httpClient, id,
+                          detail::jsonRequest(HttpMethod::POST, "/workflows/" + id + "/execute", std::move(input)));
+}
+
+/**
+ * 从异步执行的响应中取出执行ID
+ */
+static std::string takeExecutionId(http::HttpResponse&& response, const std::string& workflowId) {
+    if (response.statusCode != 200 && response.statusCode != 202) {
+        detail::throwStatusError(response, "Failed to execute workflow", "Workflow not found: " + workflowId);
     }
-    if (response.statusCode != 200) {
-        throw error::HttpError("Failed to execute workflow", response.statusCode);
+    return detail::parseBody(std::move(response)).at("executionId").get<std::string>();
+}
+
+std::string WorkflowClient::executeAsync(const std::string& id, const Json& input) {
+    return takeExecutionId(
+        httpClient->request(detail::jsonRequest(HttpMethod::POST, "/workflows/" + id + "/execute/async", input)), id);
+}
+
+std::string WorkflowClient::executeAsync(const std::string& id, Json&& input) {
+    return takeExecutionId(
+        httpClient->request(detail::jsonRequest(HttpMethod::POST, "/workflows/" + id + "/execute/async", std::move(input))),
+        id);
+}
+
+std::vector<ExecutionHandle> WorkflowClient::executeMany(const std::vector<WorkflowSubmission>& submissions,
+                                                         const ExecuteManyOptions& options) {
+    std::vector<ExecutionHandle> handles(submissions.size());
+    // 完成回调写入各自的句柄，返回前等待全部在途请求完成
+    detail::AsyncWindow window(options.concurrency);
+    
+    for (size_t i = 0; i < submissions.size(); ++i) {
+        const WorkflowSubmission& submission = submissions[i];
+        handles[i].workflowId = submission.workflowId;
+        window.acquire();
+        if (options.rateLimiter) {
+            options.rateLimiter->acquire();
+        }
+        try {
+            httpClient->requestAsync(
+                detail::jsonRequest(HttpMethod::POST, "/workflows/" + submission.workflowId + "/execute/async", submission.input),
+                [&, i](http::HttpResponse response, std::exception_ptr error) {
+                    ExecutionHandle& handle = handles[i];
+                    if (!error) {
+                        try {
+                            handle.executionId = takeExecutionId(std::move(response), handle.workflowId);
+                            if (options.watcher) {
+                                handle.completion = options.watcher->watch(handle.executionId).share();
+                            }
+                        } catch (...) {
+                            error = std::current_exception();
+                        }
+                    }
+                    if (error) {
+                        detail::recordFailure(handle, error);
+                    }
+                    window.release();
+                });
+        } catch (...) {
+            detail::recordFailure(handles[i], std::current_exception());
+            window.release();
+        }
     }
     
-    auto responseJson = Json::parse(response.body);
-    WorkflowExecutionResult result;
-    from_json(responseJson, result);
-    return result;
+    window.wait();
+    return handles;
+}
+
+WorkflowExecutionStatus WorkflowClient::getExecutionStatus(const std::string& executionId) {
+    auto response = httpClient->get("/workflows/executions/" + executionId + "/status");
+    detail::expectStatus(response, 200, "Failed to get execution status", "Execution not found: " + executionId);
+    return detail::decode<WorkflowExecutionStatus>(std::move(response));
+}
+
+WorkflowExecutionResult WorkflowClient::getExecutionResult(const std::string& executionId) {
+    auto response = httpClient->get("/workflows/executions/" + executionId + "/result");
+    detail::expectStatus(response, 200, "Failed to get execution result", "Execution not found: " + executionId);
+    return detail::decode<WorkflowExecutionResult>(std::move(response));
+}
+
+WorkflowExecutionResult WorkflowClient::waitForCompletion(const std::string& executionId,
+                                                          std::chrono::milliseconds timeout,
+                                                          const WaitOptions& options) {
+    using Clock = std::chrono::steady_clock;
+    auto deadline = Clock::now() + timeout;
+    // 挂起时长须留出传输时间，避免被客户端超时中断
+    std::chrono::milliseconds maxWait(std::max(1, httpClient->getConfig().timeout * 3 / 4));
+    const std::string url = "/workflows/executions/" + executionId + "/result";
+    
+    for (;;) {
+        auto started = Clock::now();
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - started);
+        if (remaining.count() <= 0) {
+            throw error::TimeoutError("Timed out waiting for workflow execution " + executionId,
+                                      static_cast<int>(timeout.count()));
+        }
+        
+        auto wait = std::min({options.pollWait, remaining, maxWait});
+        auto response = httpClient->get(url, Parameters{{"waitMs", std::to_string(wait.count())}});
+        if (response.statusCode == 200) {
+            auto result = detail::decode<WorkflowExecutionResult>(std::move(response));
+            if (isTerminalExecutionStatus(result.status)) {
+                return result;
+            }
+        } else if (response.statusCode != 202 && response.statusCode != 204) {
+            detail::throwStatusError(response, "Failed to wait for execution", "Execution not found: " + executionId);
+        }
+        
+        // 服务端不支持长轮询时退化为按最短间隔轮询
+        auto next = std::min(started + options.minPollInterval, deadline);
+        std::this_thread::sleep_until(next);
+    }
 }
 
+std::unique_ptr<ExecutionWatcher> WorkflowClient::createWatcher(const ExecutionWatcherOptions& options) {
+    return std::make_unique<ExecutionWatcher>(httpClient, options);
+}
+
+#ifdef DATAAPI_WITH_COROUTINES
+
+coro::Task<PageResult<SysWorkflow>> WorkflowClient::listAsync(int page, int size, std::string projectId, std::string userId) {
+    return detail::fetchPageAsync<SysWorkflow>(*httpClient, detail::getRequest("/workflows", listParams(page, size, projectId, userId)),
+                                               "Failed to list workflows");
+}
+
+coro::Task<SysWorkflow> WorkflowClient::getByIdAsync(std::string id) {
+    return detail::fetchAsync<SysWorkflow>(*httpClient, detail::getRequest("/workflows/" + id),
+                                           200, "Failed to get workflow", "Workflow not found: " + id);
+}
+
+coro::Task<SysWorkflow> WorkflowClient::createAsync(WorkflowCreateRequest request) {
+    return detail::fetchAsync<SysWorkflow>(*httpClient, detail::jsonRequest(HttpMethod::POST, "/workflows", request),
+                                           201, "Failed to create workflow");
+}
+
+coro::Task<SysWorkflow> WorkflowClient::updateAsync(std::string id, WorkflowUpdateRequest request) {
+    detail::ScopedInvalidation invalidation(metadataCache, {MetadataKind::Workflow}, id);
+    co_return co_await detail::fetchAsync<SysWorkflow>(*httpClient, detail::jsonRequest(HttpMethod::PUT, "/workflows/" + id, request),
+                                                       200, "Failed to update workflow", "Workflow not found: " + id);
+}
+
+coro::Task<void> WorkflowClient::deleteWorkflowAsync(std::string id) {
+    detail::ScopedInvalidation invalidation(metadataCache, {MetadataKind::Workflow}, id);
+    co_await detail::sendAsync(*httpClient, detail::deleteRequest("/workflows/" + id),
+                               204, "Failed to delete workflow", "Workflow not found: " + id);
+}
+
+coro::Task<WorkflowExecutionResult> WorkflowClient::runAsync(std::string id, Json input) {
+    return detail::fetchAsync<WorkflowExecutionResult>(
+        *httpClient, detail::jsonRequest(HttpMethod::POST, "/workflows/" + id + "/execute", std::move(input)),
+        200, "Failed to execute workflow", "Workflow not found: " + id);
+}
+
+coro::Task<WorkflowExecutionStatus> WorkflowClient::getExecutionStatusAsync(std::string executionId) {
+    return detail::fetchAsync<WorkflowExecutionStatus>(
+        *httpClient, detail::getRequest("/workflows/executions/" + executionId + "/status"),
+        200, "Failed to get execution status", "Execution not found: " + executionId);
+}
+
+coro::Task<WorkflowExecutionResult> WorkflowClient::getExecutionResultAsync(std::string executionId) {
+    return detail::fetchAsync<WorkflowExecutionResult>(
+        *httpClient, detail::getRequest("/workflows/executions/" + executionId + "/result"),
+        200, "Failed to get execution result", "Execution not found: " + executionId);
+}
+
+#endif
+
 } // namespace client
 } // namespace dataapi
\ No newline at end of file
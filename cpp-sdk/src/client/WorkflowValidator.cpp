@@ -0,0 +1,716 @@
+#include "dataapi/client/WorkflowValidator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <regex>
+#include <set>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+namespace dataapi {
+namespace client {
+
+namespace {
+
+// 实例类型的位掩码
+enum TypeBit : uint8_t {
+    kNull = 1,
+    kBoolean = 2,
+    kInteger = 4,
+    kNumber = 8,
+    kString = 16,
+    kArray = 32,
+    kObject = 64,
+    kAnyType = 127
+};
+
+// 子Schema为布尔值时不分配节点：true不约束，false不接受任何值
+constexpr int kAllowAny = -1;
+constexpr int kForbid = -2;
+// 沿路径无法唯一确定Schema节点
+constexpr int kAmbiguous = -3;
+
+const std::pair<const char*, uint8_t> kTypeNames[] = {
+    {"null", kNull}, {"boolean", kBoolean}, {"integer", kInteger}, {"number", kNumber},
+    {"string", kString}, {"array", kArray}, {"object", kObject}
+};
+
+// 整数值的边界按整数输出（0而不是0.0）
+std::string formatBound(double bound) {
+    if (std::abs(bound) < 9007199254740992.0 && bound == std::trunc(bound)) {
+        return std::to_string(static_cast<int64_t>(bound));
+    }
+    return Json(bound).dump();
+}
+
+uint8_t typeBit(const std::string& name) {
+    for (const auto& entry : kTypeNames) {
+        if (name == entry.first) {
+            return entry.second;
+        }
+    }
+    throw std::invalid_argument("Unknown type in schema: " + name);
+}
+
+std::string typeNames(uint8_t mask) {
+    std::string names;
+    for (const auto& entry : kTypeNames) {
+        if (mask & entry.second) {
+            names += (names.empty() ? "" : " or ") + std::string(entry.first);
+        }
+    }
+    return names;
+}
+
+uint8_t instanceType(const Json& value) {
+    switch (value.type()) {
+        case Json::value_t::null:
+            return kNull;
+        case Json::value_t::boolean:
+            return kBoolean;
+        case Json::value_t::number_integer:
+        case Json::value_t::number_unsigned:
+            return kInteger;
+        case Json::value_t::number_float: {
+            // 1.0按JSON Schema的规定也是integer
+            double number = value.get<double>();
+            return std::isfinite(number) && std::floor(number) == number ? kInteger : kNumber;
+        }
+        case Json::value_t::string:
+            return kString;
+        case Json::value_t::array:
+            return kArray;
+        case Json::value_t::object:
+            return kObject;
+        default:
+            return 0;
+    }
+}
+
+std::string escapeToken(const std::string& token) {
+    std::string escaped;
+    for (char c : token) {
+        if (c == '~') {
+            escaped += "~0";
+        } else if (c == '/') {
+            escaped += "~1";
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+std::vector<std::string> splitPointer(const std::string& pointer) {
+    if (!pointer.empty() && pointer.front() != '/') {
+        throw std::invalid_argument("Invalid JSON Pointer: " + pointer);
+    }
+    std::vector<std::string> tokens;
+    for (size_t start = 1; start <= pointer.size();) {
+        size_t end = std::min(pointer.find('/', start), pointer.size());
+        std::string token;
+        for (size_t i = start; i < end; ++i) {
+            if (pointer[i] == '~' && i + 1 < end && (pointer[i + 1] == '0' || pointer[i + 1] == '1')) {
+                token += pointer[++i] == '0' ? '~' : '/';
+            } else {
+                token += pointer[i];
+            }
+        }
+        tokens.push_back(std::move(token));
+        start = end + 1;
+    }
+    return tokens;
+}
+
+std::optional<size_t> arrayIndex(const std::string& token) {
+    if (token.empty() || token.size() > 18 || !std::all_of(token.begin(), token.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+        return std::nullopt;
+    }
+    return static_cast<size_t>(std::stoull(token));
+}
+
+/**
+ * UTF-8字符串的码点数，minLength/maxLength按码点计
+ */
+size_t codePoints(const std::string& value) {
+    size_t count = 0;
+    for (char c : value) {
+        if ((static_cast<unsigned char>(c) & 0xC0) != 0x80) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+struct WorkflowSchema::Node {
+    int ref = kAllowAny;
+    uint8_t types = kAnyType;
+    std::optional<std::vector<Json>> enumValues;
+    std::optional<Json> constValue;
+
+    // object
+    std::unordered_map<std::string, int> properties;
+    std::vector<std::string> required;
+    int additional = kAllowAny;
+    std::optional<size_t> minProperties;
+    std::optional<size_t> maxProperties;
+
+    // array
+    int items = kAllowAny;
+    std::optional<size_t> minItems;
+    std::optional<size_t> maxItems;
+    bool uniqueItems = false;
+
+    // string
+    std::optional<size_t> minLength;
+    std::optional<size_t> maxLength;
+    std::optional<std::regex> pattern;
+    std::string patternSource;
+
+    // number
+    std::optional<double> minimum;
+    std::optional<double> maximum;
+    std::optional<double> exclusiveMinimum;
+    std::optional<double> exclusiveMaximum;
+
+    std::vector<int> allOf;
+    std::vector<int> anyOf;
+    std::vector<int> oneOf;
+
+    bool combined() const {
+        return !allOf.empty() || !anyOf.empty() || !oneOf.empty();
+    }
+
+    bool structured() const {
+        return !properties.empty() || additional != kAllowAny || items != kAllowAny;
+    }
+};
+
+/**
+ * 把Schema的Json展开为节点数组
+ * 每个Schema对象按其在文档中的位置（JSON Pointer）只编译一次，$ref指向同一位置时共用节点，递归定义因此是有限的
+ */
+struct WorkflowSchema::Compiler {
+    const Json& root;
+    std::vector<Node>& nodes;
+    std::unordered_map<std::string, int> compiled;
+
+    int compile(const Json& schema, const std::string& pointer) {
+        if (schema.is_boolean()) {
+            return schema.get<bool>() ? kAllowAny : kForbid;
+        }
+        if (!schema.is_object()) {
+            throw std::invalid_argument("Schema at #" + pointer + " must be an object or a boolean");
+        }
+        auto found = compiled.find(pointer);
+        if (found != compiled.end()) {
+            return found->second;
+        }
+        int index = static_cast<int>(nodes.size());
+        compiled.emplace(pointer, index);
+        nodes.emplace_back();
+
+        // 子Schema的编译会扩充nodes，先填到局部变量中
+        Node node;
+        if (auto it = schema.find("$ref"); it != schema.end()) {
+            node.ref = resolve(it->get<std::string>());
+        }
+        if (auto it = schema.find("type"); it != schema.end()) {
+            node.types = 0;
+            if (it->is_array()) {
+                for (const auto& name : *it) {
+                    node.types |= typeBit(name.get<std::string>());
+                }
+            } else {
+                node.types = typeBit(it->get<std::string>());
+            }
+        }
+        if (auto it = schema.find("enum"); it != schema.end()) {
+            node.enumValues = it->get<std::vector<Json>>();
+        }
+        if (auto it = schema.find("const"); it != schema.end()) {
+            node.constValue = *it;
+        }
+
+        if (auto it = schema.find("properties"); it != schema.end()) {
+            for (const auto& property : it->items()) {
+                node.properties.emplace(property.key(),
+                                        compile(property.value(), pointer + "/properties/" + escapeToken(property.key())));
+            }
+        }
+        if (auto it = schema.find("required"); it != schema.end()) {
+            node.required = it->get<std::vector<std::string>>();
+        }
+        if (auto it = schema.find("additionalProperties"); it != schema.end()) {
+            node.additional = compile(*it, pointer + "/additionalProperties");
+        }
+        node.minProperties = size(schema, "minProperties");
+        node.maxProperties = size(schema, "maxProperties");
+
+        if (auto it = schema.find("items"); it != schema.end()) {
+            node.items = compile(*it, pointer + "/items");
+        }
+        node.minItems = size(schema, "minItems");
+        node.maxItems = size(schema, "maxItems");
+        node.uniqueItems = schema.value("uniqueItems", false);
+
+        node.minLength = size(schema, "minLength");
+        node.maxLength = size(schema, "maxLength");
+        if (auto it = schema.find("pattern"); it != schema.end()) {
+            node.patternSource = it->get<std::string>();
+            try {
+                node.pattern.emplace(node.patternSource, std::regex::ECMAScript | std::regex::optimize);
+            } catch (const std::regex_error&) {
+                throw std::invalid_argument("Invalid pattern in schema at #" + pointer + ": " + node.patternSource);
+            }
+        }
+
+        node.minimum = number(schema, "minimum");
+        node.maximum = number(schema, "maximum");
+        // draft-04中exclusiveMinimum/exclusiveMaximum是修饰minimum/maximum的布尔值
+        for (auto [key, bound, exclusive] : {std::make_tuple("exclusiveMinimum", &node.minimum, &node.exclusiveMinimum),
+                                             std::make_tuple("exclusiveMaximum", &node.maximum, &node.exclusiveMaximum)}) {
+            auto it = schema.find(key);
+            if (it == schema.end()) {
+                continue;
+            }
+            if (it->is_boolean()) {
+                if (it->get<bool>() && *bound) {
+                    *exclusive = *bound;
+                    bound->reset();
+                }
+            } else {
+                *exclusive = it->get<double>();
+            }
+        }
+
+        for (auto [key, list] : {std::make_pair("allOf", &node.allOf), std::make_pair("anyOf", &node.anyOf),
+                                 std::make_pair("oneOf", &node.oneOf)}) {
+            if (auto it = schema.find(key); it != schema.end()) {
+                for (size_t i = 0; i < it->size(); ++i) {
+                    list->push_back(compile(it->at(i), pointer + "/" + key + "/" + std::to_string(i)));
+                }
+            }
+        }
+
+        nodes[static_cast<size_t>(index)] = std::move(node);
+        return index;
+    }
+
+    int resolve(const std::string& ref) {
+        if (ref.empty() || ref.front() != '#') {
+            throw std::invalid_argument("Only local $ref is supported: " + ref);
+        }
+        std::string pointer = ref.substr(1);
+        const Json* target = nullptr;
+        try {
+            target = &root.at(Json::json_pointer(pointer));
+        } catch (const Json::exception&) {
+            throw std::invalid_argument("Unresolvable $ref: " + ref);
+        }
+        return compile(*target, pointer);
+    }
+
+    static std::optional<size_t> size(const Json& schema, const char* key) {
+        auto it = schema.find(key);
+        if (it == schema.end()) {
+            return std::nullopt;
+        }
+        return it->get<size_t>();
+    }
+
+    static std::optional<double> number(const Json& schema, const char* key) {
+        auto it = schema.find(key);
+        if (it == schema.end() || it->is_boolean()) {
+            return std::nullopt;
+        }
+        return it->get<double>();
+    }
+};
+
+/**
+ * 按节点验证一个值
+ * issues为空时只判断是否合法（anyOf/oneOf的分支），遇到第一个错误即结束
+ */
+struct WorkflowSchema::Checker {
+    const std::vector<Node>& nodes;
+    std::vector<Issue>* issues;
+    std::string path;
+    bool failed = false;
+
+    void fail(std::string message) {
+        failed = true;
+        if (issues) {
+            issues->push_back({path, std::move(message)});
+        }
+    }
+
+    bool done() const {
+        return failed && !issues;
+    }
+
+    bool matches(int index, const Json& value) const {
+        Checker probe{nodes, nullptr, std::string()};
+        probe.check(index, value, true);
+        return !probe.failed;
+    }
+
+    void child(int index, const Json& value, const std::string& token) {
+        size_t length = path.size();
+        path += '/';
+        path += escapeToken(token);
+        check(index, value, true);
+        path.resize(length);
+    }
+
+    void check(int index, const Json& value, bool deep) {
+        if (index == kAllowAny) {
+            return;
+        }
+        if (index == kForbid) {
+            fail("value is not allowed");
+            return;
+        }
+        const Node& node = nodes[static_cast<size_t>(index)];
+        if (node.ref != kAllowAny) {
+            check(node.ref, value, deep);
+            if (done()) {
+                return;
+            }
+        }
+
+        uint8_t type = instanceType(value);
+        if (!(node.types & type) && !(type == kInteger && (node.types & kNumber))) {
+            fail("expected " + typeNames(node.types) + ", got " + typeNames(type));
+            return;
+        }
+        if (node.enumValues && std::find(node.enumValues->begin(), node.enumValues->end(), value) == node.enumValues->end()) {
+            fail("value is not one of the allowed values");
+        }
+        if (node.constValue && *node.constValue != value) {
+            fail("value must be " + node.constValue->dump());
+        }
+
+        switch (type) {
+            case kObject:
+                checkObject(node, value, deep);
+                break;
+            case kArray:
+                checkArray(node, value, deep);
+                break;
+            case kString:
+                checkString(node, value.get_ref<const std::string&>());
+                break;
+            case kInteger:
+            case kNumber:
+                checkNumber(node, value.get<double>());
+                break;
+            default:
+                break;
+        }
+        if (done()) {
+            return;
+        }
+
+        for (int branch : node.allOf) {
+            check(branch, value, deep);
+            if (done()) {
+                return;
+            }
+        }
+        if (!node.anyOf.empty() &&
+            std::none_of(node.anyOf.begin(), node.anyOf.end(), [&](int branch) { return matches(branch, value); })) {
+            fail("value does not match any of the allowed schemas");
+        }
+        if (!node.oneOf.empty()) {
+            auto count = std::count_if(node.oneOf.begin(), node.oneOf.end(), [&](int branch) { return matches(branch, value); });
+            if (count == 0) {
+                fail("value does not match any of the allowed schemas");
+            } else if (count > 1) {
+                fail("value matches more than one of the exclusive schemas");
+            }
+        }
+    }
+
+    void checkObject(const Node& node, const Json& value, bool deep) {
+        if (node.minProperties && value.size() < *node.minProperties) {
+            fail("expected at least " + std::to_string(*node.minProperties) + " properties");
+        }
+        if (node.maxProperties && value.size() > *node.maxProperties) {
+            fail("expected at most " + std::to_string(*node.maxProperties) + " properties");
+        }
+        for (const auto& name : node.required) {
+            if (!value.contains(name)) {
+                fail("missing required property '" + name + "'");
+                if (done()) {
+                    return;
+                }
+            }
+        }
+        if (!deep && node.additional != kForbid) {
+            return;
+        }
+        for (const auto& property : value.items()) {
+            auto it = node.properties.find(property.key());
+            int schema = it != node.properties.end() ? it->second : node.additional;
+            if (schema == kForbid) {
+                // 记在对象自身的位置上，只检查对象本身时也能发现
+                fail("property '" + property.key() + "' is not allowed");
+            } else if (deep) {
+                child(schema, property.value(), property.key());
+            }
+            if (done()) {
+                return;
+            }
+        }
+    }
+
+    void checkArray(const Node& node, const Json& value, bool deep) {
+        if (node.minItems && value.size() < *node.minItems) {
+            fail("expected at least " + std::to_string(*node.minItems) + " items");
+        }
+        if (node.maxItems && value.size() > *node.maxItems) {
+            fail("expected at most " + std::to_string(*node.maxItems) + " items");
+        }
+        if (node.uniqueItems) {
+            for (size_t i = 1; i < value.size() && !failed; ++i) {
+                for (size_t j = 0; j < i; ++j) {
+                    if (value[i] == value[j]) {
+                        fail("items " + std::to_string(j) + " and " + std::to_string(i) + " are equal");
+                        break;
+                    }
+                }
+            }
+        }
+        if (!deep || node.items == kAllowAny) {
+            return;
+        }
+        for (size_t i = 0; i < value.size() && !done(); ++i) {
+            child(node.items, value[i], std::to_string(i));
+        }
+    }
+
+    void checkString(const Node& node, const std::string& value) {
+        if (node.minLength || node.maxLength) {
+            size_t length = codePoints(value);
+            if (node.minLength && length < *node.minLength) {
+                fail("expected at least " + std::to_string(*node.minLength) + " characters");
+            }
+            if (node.maxLength && length > *node.maxLength) {
+                fail("expected at most " + std::to_string(*node.maxLength) + " characters");
+            }
+        }
+        if (node.pattern && !std::regex_search(value, *node.pattern)) {
+            fail("value does not match pattern " + node.patternSource);
+        }
+    }
+
+    void checkNumber(const Node& node, double value) {
+        if (node.minimum && value < *node.minimum) {
+            fail("expected a value >= " + formatBound(*node.minimum));
+        }
+        if (node.maximum && value > *node.maximum) {
+            fail("expected a value <= " + formatBound(*node.maximum));
+        }
+        if (node.exclusiveMinimum && value <= *node.exclusiveMinimum) {
+            fail("expected a value > " + formatBound(*node.exclusiveMinimum));
+        }
+        if (node.exclusiveMaximum && value >= *node.exclusiveMaximum) {
+            fail("expected a value < " + formatBound(*node.exclusiveMaximum));
+        }
+    }
+};
+
+WorkflowSchema::WorkflowSchema() = default;
+
+WorkflowSchema::~WorkflowSchema() = default;
+
+std::shared_ptr<const WorkflowSchema> WorkflowSchema::compile(const Json& schema) {
+    std::shared_ptr<WorkflowSchema> compiled(new WorkflowSchema());
+    Compiler compiler{schema, compiled->nodes, {}};
+    int root = compiler.compile(schema, "");
+    if (root < 0) {
+        // 根为布尔值时用一个只含$ref的节点表示
+        compiled->nodes.emplace_back();
+        compiled->nodes.back().ref = root;
+    }
+
+    // 作用于同一个值的引用（$ref和allOf/anyOf/oneOf）不能成环，否则验证不会结束
+    std::vector<uint8_t> state(compiled->nodes.size(), 0); // 0未访问，1在栈上，2已完成
+    auto visit = [&](auto& self, int index) -> void {
+        if (index < 0 || state[static_cast<size_t>(index)] == 2) {
+            return;
+        }
+        if (state[static_cast<size_t>(index)] == 1) {
+            throw std::invalid_argument("Schema references itself without consuming any input");
+        }
+        state[static_cast<size_t>(index)] = 1;
+        const Node& node = compiled->nodes[static_cast<size_t>(index)];
+        self(self, node.ref);
+        for (const auto* list : {&node.allOf, &node.anyOf, &node.oneOf}) {
+            for (int branch : *list) {
+                self(self, branch);
+            }
+        }
+        state[static_cast<size_t>(index)] = 2;
+    };
+    for (size_t i = 0; i < compiled->nodes.size(); ++i) {
+        visit(visit, static_cast<int>(i));
+    }
+    return compiled;
+}
+
+size_t WorkflowSchema::size() const {
+    return nodes.size();
+}
+
+void WorkflowSchema::validate(const Json& instance, std::vector<Issue>& issues) const {
+    Checker checker{nodes, &issues, std::string()};
+    checker.check(0, instance, true);
+}
+
+bool WorkflowSchema::validateAt(const Json& instance, const std::string& path, std::vector<Issue>& issues, bool deep) const {
+    // 跟随只含$ref的节点；节点自身和引用目标都约束子节点或含组合关键字时无法确定子节点的Schema
+    auto descend = [this](int index) {
+        while (index >= 0) {
+            const Node& node = nodes[static_cast<size_t>(index)];
+            if (node.combined()) {
+                return kAmbiguous;
+            }
+            if (node.ref == kAllowAny) {
+                return index;
+            }
+            if (node.structured()) {
+                return kAmbiguous;
+            }
+            index = node.ref;
+        }
+        return index;
+    };
+
+    int index = 0;
+    const Json* value = &instance;
+    for (const auto& token : splitPointer(path)) {
+        index = descend(index);
+        if (index == kAmbiguous) {
+            return false;
+        }
+        if (index < 0) {
+            // 上层不约束该子树，或已在上层报告为不允许
+            return true;
+        }
+        const Node& node = nodes[static_cast<size_t>(index)];
+        if (value->is_object()) {
+            auto it = value->find(token);
+            if (it == value->end()) {
+                return true;
+            }
+            auto property = node.properties.find(token);
+            index = property != node.properties.end() ? property->second : node.additional;
+            value = &*it;
+        } else if (value->is_array()) {
+            auto position = arrayIndex(token);
+            if (!position || *position >= value->size()) {
+                return true;
+            }
+            index = node.items;
+            value = &(*value)[*position];
+        } else {
+            return true;
+        }
+    }
+
+    Checker checker{nodes, &issues, path};
+    checker.check(index, *value, deep);
+    return true;
+}
+
+WorkflowValidator::WorkflowValidator(std::shared_ptr<const WorkflowSchema> schema) : schema(std::move(schema)) {
+}
+
+WorkflowValidationResult WorkflowValidator::validate(const Json& definition) {
+    std::vector<WorkflowSchema::Issue> found;
+    schema->validate(definition, found);
+    issues.clear();
+    record(found);
+    validated = true;
+    return result();
+}
+
+WorkflowValidationResult WorkflowValidator::revalidate(const Json& definition, const std::vector<std::string>& changedPaths) {
+    if (!validated) {
+        return validate(definition);
+    }
+
+    // 去掉已被另一个变化位置包含的位置
+    std::set<std::string> sorted(changedPaths.begin(), changedPaths.end());
+    std::vector<std::string> roots;
+    for (const auto& path : sorted) {
+        if (path.empty()) {
+            return validate(definition);
+        }
+        bool covered = std::any_of(roots.begin(), roots.end(), [&](const std::string& root) {
+            return path.compare(0, root.size(), root) == 0 && path.size() > root.size() && path[root.size()] == '/';
+        });
+        if (!covered) {
+            roots.push_back(path);
+        }
+    }
+    std::set<std::string> ancestors;
+    for (const auto& root : roots) {
+        for (size_t slash = root.find('/'); slash != std::string::npos && slash < root.size(); slash = root.find('/', slash + 1)) {
+            ancestors.insert(root.substr(0, slash));
+        }
+    }
+
+    std::vector<WorkflowSchema::Issue> found;
+    for (const auto& ancestor : ancestors) {
+        if (!schema->validateAt(definition, ancestor, found, false)) {
+            return validate(definition);
+        }
+    }
+    for (const auto& root : roots) {
+        if (!schema->validateAt(definition, root, found, true)) {
+            return validate(definition);
+        }
+    }
+
+    for (const auto& ancestor : ancestors) {
+        issues.erase(ancestor);
+    }
+    for (const auto& root : roots) {
+        for (auto it = issues.lower_bound(root); it != issues.end() && it->first.compare(0, root.size(), root) == 0;) {
+            if (it->first.size() == root.size() || it->first[root.size()] == '/') {
+                it = issues.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    record(found);
+    return result();
+}
+
+void WorkflowValidator::record(std::vector<WorkflowSchema::Issue>& found) {
+    for (auto& issue : found) {
+        issues[std::move(issue.path)].push_back(std::move(issue.message));
+    }
+}
+
+WorkflowValidationResult WorkflowValidator::result() const {
+    WorkflowValidationResult result;
+    result.isValid = issues.empty();
+    for (const auto& entry : issues) {
+        for (const auto& message : entry.second) {
+            result.errors.push_back("#" + entry.first + ": " + message);
+        }
+    }
+    return result;
+}
+
+} // namespace client
+} // namespace dataapi
@@ -38,6 +38,43 @@ AuthenticationError::AuthenticationError(const std::string& message,
     : DataApiError(message, code, 401) {
 }
 
+AuthorizationError::AuthorizationError(const std::string& message,
+                                      const std::string& code)
+    : DataApiError(message, code, 403) {
+}
+
+ConflictError::ConflictError(const std::string& message,
+                            const std::string& code)
+    : DataApiError(message, code, 409) {
+}
+
+RateLimitError::RateLimitError(const std::string& message, int retryAfter)
+    : DataApiError(message, "RATE_LIMIT_ERROR", 429), retryAfter_(retryAfter) {
+}
+
+TimeoutError::TimeoutError(const std::string& message, int timeoutMs)
+    : DataApiError(message, "TIMEOUT_ERROR", 0), timeoutMs_(timeoutMs) {
+}
+
+NetworkError::NetworkError(const std::string& message,
+                          std::shared_ptr<std::exception> cause)
+    : DataApiError(message, "NETWORK_ERROR", 0, "", {}, cause) {
+}
+
+ConnectionError::ConnectionError(const std::string& message)
+    : NetworkError(message) {
+    code_ = "CONNECTION_ERROR";
+}
+
+SinkAbortedError::SinkAbortedError(const std::string& message)
+    : NetworkError(message) {
+    code_ = "SINK_ABORTED";
+}
+
+ServiceUnavailableError::ServiceUnavailableError(const std::string& message)
+    : DataApiError(message, "SERVICE_UNAVAILABLE", 503) {
+}
+
 ValidationError::ValidationError(const std::string& message,
                                 const std::string& field,
                                 const std::vector<std::string>& validationRules,
@@ -103,5 +140,19 @@ Json NotFoundError::toJson() const {
     return json;
 }
 
+// RateLimitError虚函数实现
+Json RateLimitError::toJson() const {
+    Json json = DataApiError::toJson();
+    json["retryAfter"] = retryAfter_;
+    return json;
+}
+
+// TimeoutError虚函数实现
+Json TimeoutError::toJson() const {
+    Json json = DataApiError::toJson();
+    json["timeoutMs"] = timeoutMs_;
+    return json;
+}
+
 } // namespace error
 } // namespace dataapi
\ No newline at end of file
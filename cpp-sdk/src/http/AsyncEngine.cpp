@@ -0,0 +1,152 @@
+#include "dataapi/http/AsyncEngine.h"
+#include <curl/curl.h>
+#include <stdexcept>
+
+namespace dataapi {
+namespace http {
+
+// 无事件时curl_multi_poll的最长等待（毫秒），提交请求时会通过curl_multi_wakeup提前唤醒
+static const int POLL_TIMEOUT_MS = 1000;
+
+static void applyLimits(CURLM* multi, const AsyncEngine::Limits& limits) {
+    long maxConnections = static_cast<long>(limits.maxConnections > 0 ? limits.maxConnections : 1);
+    curl_multi_setopt(multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, maxConnections);
+    curl_multi_setopt(multi, CURLMOPT_MAXCONNECTS, maxConnections);
+    curl_multi_setopt(multi, CURLMOPT_PIPELINING, limits.multiplex ? CURLPIPE_MULTIPLEX : CURLPIPE_NOTHING);
+    if (limits.multiplex) {
+        long streams = limits.maxConcurrentStreams > 0 ? limits.maxConcurrentStreams : 1;
+        curl_multi_setopt(multi, CURLMOPT_MAX_CONCURRENT_STREAMS, streams);
+    }
+}
+
+AsyncEngine::AsyncEngine(std::shared_ptr<CurlRuntime> runtime, const Limits& limits)
+    : runtime(std::move(runtime)), multiHandle(nullptr),
+      pendingLimits(limits), limitsChanged(false),
+      inFlight(0), stopping(false) {
+    CURLM* multi = curl_multi_init();
+    if (!multi) {
+        throw std::runtime_error("Failed to initialize CURL multi handle");
+    }
+    applyLimits(multi, limits);
+    multiHandle = multi;
+    worker = std::thread(&AsyncEngine::run, this);
+}
+
+AsyncEngine::~AsyncEngine() {
+    stopping.store(true);
+    curl_multi_wakeup(static_cast<CURLM*>(multiHandle));
+    if (worker.joinable()) {
+        worker.join();
+    }
+
+    CURLM* multi = static_cast<CURLM*>(multiHandle);
+    for (auto& entry : active) {
+        curl_multi_remove_handle(multi, static_cast<CURL*>(entry.first));
+        entry.second(CURLE_ABORTED_BY_CALLBACK);
+    }
+    active.clear();
+
+    std::vector<Submission> remaining;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        remaining.swap(pending);
+    }
+    for (auto& submission : remaining) {
+        submission.done(CURLE_ABORTED_BY_CALLBACK);
+    }
+
+    curl_multi_cleanup(multi);
+}
+
+void AsyncEngine::submit(void* handle, Completion done) {
+    if (stopping.load()) {
+        throw std::runtime_error("AsyncEngine is shutting down");
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back(Submission{handle, std::move(done)});
+    }
+    inFlight.fetch_add(1, std::memory_order_relaxed);
+    curl_multi_wakeup(static_cast<CURLM*>(multiHandle));
+}
+
+void AsyncEngine::setLimits(const Limits& limits) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pendingLimits = limits;
+        limitsChanged = true;
+    }
+    curl_multi_wakeup(static_cast<CURLM*>(multiHandle));
+}
+
+void AsyncEngine::run() {
+    CURLM* multi = static_cast<CURLM*>(multiHandle);
+    while (!stopping.load()) {
+        drainSubmissions();
+
+        int running = 0;
+        curl_multi_perform(multi, &running);
+        processCompletions();
+
+        curl_multi_poll(multi, nullptr, 0, POLL_TIMEOUT_MS, nullptr);
+    }
+}
+
+void AsyncEngine::drainSubmissions() {
+    std::vector<Submission> batch;
+    Limits limits;
+    bool applyNewLimits = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        batch.swap(pending);
+        if (limitsChanged) {
+            limits = pendingLimits;
+            limitsChanged = false;
+            applyNewLimits = true;
+        }
+    }
+
+    CURLM* multi = static_cast<CURLM*>(multiHandle);
+    if (applyNewLimits) {
+        applyLimits(multi, limits);
+    }
+
+    for (auto& submission : batch) {
+        CURLMcode rc = curl_multi_add_handle(multi, static_cast<CURL*>(submission.handle));
+        if (rc != CURLM_OK) {
+            inFlight.fetch_sub(1, std::memory_order_relaxed);
+            submission.done(CURLE_FAILED_INIT);
+            continue;
+        }
+        active.emplace(submission.handle, std::move(submission.done));
+    }
+}
+
+void AsyncEngine::processCompletions() {
+    CURLM* multi = static_cast<CURLM*>(multiHandle);
+    int remaining = 0;
+    while (CURLMsg* msg = curl_multi_info_read(multi, &remaining)) {
+        if (msg->msg != CURLMSG_DONE) {
+            continue;
+        }
+        CURL* handle = msg->easy_handle;
+        int result = msg->data.result;
+        curl_multi_remove_handle(multi, handle);
+
+        auto it = active.find(handle);
+        if (it == active.end()) {
+            continue;
+        }
+        Completion done = std::move(it->second);
+        active.erase(it);
+        inFlight.fetch_sub(1, std::memory_order_relaxed);
+        try {
+            done(result);
+        } catch (...) {
+            // 回调异常不能终止事件循环
+        }
+    }
+}
+
+} // namespace http
+} // namespace dataapi
@@ -0,0 +1,125 @@
+#include "dataapi/http/CircuitBreaker.h"
+#include <algorithm>
+
+namespace dataapi {
+namespace http {
+
+CircuitBreaker::CircuitBreaker(const CircuitBreakerOptions& options)
+    : options(options), window(std::max<size_t>(1, options.windowSize)) {
+    this->options.minimumCalls = std::max<size_t>(1, std::min(options.minimumCalls, window.size()));
+    this->options.halfOpenCalls = std::max<size_t>(1, options.halfOpenCalls);
+}
+
+bool CircuitBreaker::tryAcquire(uint64_t& ticket) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (state == State::Open) {
+        auto now = Clock::now();
+        if (now < openUntil) {
+            return false;
+        }
+        transition(State::HalfOpen, now);
+    }
+    if (state == State::HalfOpen) {
+        if (probes >= options.halfOpenCalls) {
+            return false;
+        }
+        ++probes;
+    }
+    ticket = epoch;
+    return true;
+}
+
+void CircuitBreaker::onSuccess(uint64_t ticket) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (ticket != epoch) {
+        return;
+    }
+    if (state == State::HalfOpen) {
+        if (++probeSuccesses >= options.halfOpenCalls) {
+            transition(State::Closed, Clock::now());
+        }
+        return;
+    }
+    if (calls == window.size()) {
+        failures -= window[next] ? 1 : 0;
+    } else {
+        ++calls;
+    }
+    window[next] = false;
+    next = (next + 1) % window.size();
+}
+
+void CircuitBreaker::onFailure(uint64_t ticket) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (ticket != epoch) {
+        return;
+    }
+    if (state == State::HalfOpen) {
+        transition(State::Open, Clock::now());
+        return;
+    }
+    if (calls == window.size()) {
+        failures -= window[next] ? 1 : 0;
+    } else {
+        ++calls;
+    }
+    window[next] = true;
+    ++failures;
+    next = (next + 1) % window.size();
+    if (calls >= options.minimumCalls &&
+        static_cast<double>(failures) >= options.failureRateThreshold * static_cast<double>(calls)) {
+        transition(State::Open, Clock::now());
+    }
+}
+
+void CircuitBreaker::onIgnored(uint64_t ticket) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (ticket == epoch && state == State::HalfOpen && probes > probeSuccesses) {
+        --probes;
+    }
+}
+
+CircuitBreaker::State CircuitBreaker::getState() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return state;
+}
+
+double CircuitBreaker::getFailureRate() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return calls == 0 ? 0.0 : static_cast<double>(failures) / static_cast<double>(calls);
+}
+
+void CircuitBreaker::transition(State nextState, Clock::time_point now) {
+    state = nextState;
+    ++epoch;
+    std::fill(window.begin(), window.end(), false);
+    next = 0;
+    calls = 0;
+    failures = 0;
+    probes = 0;
+    probeSuccesses = 0;
+    if (nextState == State::Open) {
+        openUntil = now + options.openDuration;
+    }
+}
+
+CircuitBreakerRegistry::CircuitBreakerRegistry(const CircuitBreakerOptions& options) : options(options) {
+}
+
+std::shared_ptr<CircuitBreaker> CircuitBreakerRegistry::get(const std::string& group) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& breaker = breakers[group];
+    if (!breaker) {
+        breaker = std::make_shared<CircuitBreaker>(options);
+    }
+    return breaker;
+}
+
+std::string CircuitBreakerRegistry::groupOf(const std::string& path) {
+    size_t start = path.empty() || path[0] != '/' ? 0 : 1;
+    size_t end = path.find_first_of("/?#", start);
+    return "/" + path.substr(start, end == std::string::npos ? std::string::npos : end - start);
+}
+
+} // namespace http
+} // namespace dataapi
@@ -0,0 +1,72 @@
+#include "dataapi/http/ConcurrencyLimiter.h"
+#include <algorithm>
+
+namespace dataapi {
+namespace http {
+
+AdaptiveConcurrencyLimiter::AdaptiveConcurrencyLimiter(const ConcurrencyLimitOptions& options) : options(options) {
+    this->options.minLimit = std::max(1, options.minLimit);
+    this->options.maxLimit = std::max(this->options.minLimit, options.maxLimit);
+    this->options.baselineSamples = std::max<size_t>(1, options.baselineSamples);
+    limit = std::min(std::max(options.initialLimit, this->options.minLimit), this->options.maxLimit);
+}
+
+bool AdaptiveConcurrencyLimiter::tryAcquire() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (inFlight >= static_cast<int>(limit)) {
+        return false;
+    }
+    ++inFlight;
+    return true;
+}
+
+void AdaptiveConcurrencyLimiter::onSample(std::chrono::microseconds latency) {
+    std::lock_guard<std::mutex> lock(mutex);
+    int used = inFlight--;
+    latency = std::max(latency, std::chrono::microseconds(1));
+    if (baseline.count() == 0 || latency < baseline) {
+        baseline = latency;
+    }
+    if (windowSamples == 0 || latency < windowMin) {
+        windowMin = latency;
+    }
+    if (++windowSamples >= options.baselineSamples) {
+        baseline = windowMin;
+        windowSamples = 0;
+    }
+
+    double queue = limit * (1.0 - static_cast<double>(baseline.count()) / static_cast<double>(latency.count()));
+    if (queue < options.alpha) {
+        // 并发远未用满时延迟低不说明上限还能提高
+        if (used * 2 >= static_cast<int>(limit)) {
+            limit += 1;
+        }
+    } else if (queue > options.beta) {
+        limit -= 1;
+    }
+    limit = std::min<double>(std::max<double>(limit, options.minLimit), options.maxLimit);
+}
+
+void AdaptiveConcurrencyLimiter::onDropped() {
+    std::lock_guard<std::mutex> lock(mutex);
+    --inFlight;
+    limit = std::max<double>(options.minLimit, limit * options.backoffRatio);
+}
+
+void AdaptiveConcurrencyLimiter::onIgnored() {
+    std::lock_guard<std::mutex> lock(mutex);
+    --inFlight;
+}
+
+int AdaptiveConcurrencyLimiter::getLimit() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<int>(limit);
+}
+
+int AdaptiveConcurrencyLimiter::getInFlight() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return inFlight;
+}
+
+} // namespace http
+} // namespace dataapi
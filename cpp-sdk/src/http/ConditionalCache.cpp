@@ -0,0 +1,99 @@
+#include "dataapi/http/ConditionalCache.h"
+#include <algorithm>
+#include <cctype>
+
+namespace dataapi {
+namespace http {
+
+static bool containsToken(std::string_view value, std::string_view token) {
+    auto it = std::search(value.begin(), value.end(), token.begin(), token.end(),
+                          [](char a, char b) { return std::tolower(static_cast<unsigned char>(a)) == b; });
+    return it != value.end();
+}
+
+Validators Validators::from(const ResponseHeaders& headers) {
+    Validators validators;
+    auto cacheControl = headers.get("Cache-Control");
+    if (cacheControl && containsToken(*cacheControl, "no-store")) {
+        return validators;
+    }
+    if (auto etag = headers.get("ETag")) {
+        validators.etag = std::string(*etag);
+    }
+    if (auto lastModified = headers.get("Last-Modified")) {
+        validators.lastModified = std::string(*lastModified);
+    }
+    return validators;
+}
+
+void Validators::apply(Headers& headers) const {
+    // 两者都有时服务端以If-None-Match为准
+    if (!etag.empty()) {
+        headers["If-None-Match"] = etag;
+    }
+    if (!lastModified.empty()) {
+        headers["If-Modified-Since"] = lastModified;
+    }
+}
+
+ConditionalCache::ConditionalCache(size_t maxEntries) : maxEntries(std::max<size_t>(1, maxEntries)) {
+}
+
+std::shared_ptr<const ConditionalCache::Entry> ConditionalCache::find(const std::string& url) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = index.find(url);
+    if (found == index.end()) {
+        return nullptr;
+    }
+    items.splice(items.begin(), items, found->second);
+    return found->second->second;
+}
+
+void ConditionalCache::store(const std::string& url, Validators validators,
+                             std::type_index type, std::shared_ptr<const void> value) {
+    auto entry = std::make_shared<const Entry>(Entry{std::move(validators), type, std::move(value)});
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = index.find(url);
+    if (found != index.end()) {
+        found->second->second = std::move(entry);
+        items.splice(items.begin(), items, found->second);
+    } else {
+        while (items.size() >= maxEntries) {
+            index.erase(items.back().first);
+            items.pop_back();
+        }
+        items.emplace_front(url, std::move(entry));
+        index.emplace(url, items.begin());
+    }
+    ++stored;
+}
+
+void ConditionalCache::erase(const std::string& url) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = index.find(url);
+    if (found != index.end()) {
+        items.erase(found->second);
+        index.erase(found);
+    }
+}
+
+void ConditionalCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    items.clear();
+    index.clear();
+}
+
+size_t ConditionalCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return items.size();
+}
+
+ConditionalCacheStats ConditionalCache::getStats() const {
+    ConditionalCacheStats stats;
+    stats.notModified = notModified.load();
+    stats.stored = stored.load();
+    return stats;
+}
+
+} // namespace http
+} // namespace dataapi
@@ -0,0 +1,124 @@
+#include "dataapi/http/ConnectionPool.h"
+#include <curl/curl.h>
+#include <stdexcept>
+
+namespace dataapi {
+namespace http {
+
+ConnectionPool::Lease::~Lease() {
+    if (pool && handle) {
+        pool->release(handle);
+    }
+}
+
+ConnectionPool::Lease& ConnectionPool::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        if (pool && handle) {
+            pool->release(handle);
+        }
+        pool = other.pool;
+        handle = other.handle;
+        slot = other.slot;
+        other.pool = nullptr;
+        other.handle = nullptr;
+    }
+    return *this;
+}
+
+ConnectionPool::ConnectionPool(size_t maxSize, std::shared_ptr<CurlRuntime> runtime)
+    : runtime(std::move(runtime)), maxSize(maxSize > 0 ? maxSize : 1), totalCount(0) {
+}
+
+ConnectionPool::~ConnectionPool() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (void* handle : idle) {
+        curl_easy_cleanup(static_cast<CURL*>(handle));
+    }
+    idle.clear();
+    slots.clear();
+}
+
+ConnectionPool::Lease ConnectionPool::acquire() {
+    std::unique_lock<std::mutex> lock(mutex);
+    available.wait(lock, [this] { return !idle.empty() || totalCount < maxSize; });
+
+    if (!idle.empty()) {
+        void* handle = idle.back();
+        idle.pop_back();
+        return Lease(this, handle, slots[handle]);
+    }
+
+    ++totalCount;
+    lock.unlock();
+    void* handle = nullptr;
+    try {
+        handle = createHandle();
+    } catch (...) {
+        lock.lock();
+        --totalCount;
+        available.notify_one();
+        throw;
+    }
+    lock.lock();
+    size_t slot = nextSlot++;
+    slots[handle] = slot;
+    return Lease(this, handle, slot);
+}
+
+void ConnectionPool::release(void* handle) {
+    // 重置选项但保留连接缓存，重新绑定共享句柄（curl_easy_reset会清除CURLOPT_SHARE）
+    curl_easy_reset(static_cast<CURL*>(handle));
+    curl_easy_setopt(static_cast<CURL*>(handle), CURLOPT_SHARE, static_cast<CURLSH*>(runtime->getShareHandle()));
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        idle.push_back(handle);
+        trimIdleLocked();
+    }
+    available.notify_one();
+}
+
+void* ConnectionPool::createHandle() {
+    CURL* curl = curl_easy_init();
+    if (!curl) {
+        throw std::runtime_error("Failed to initialize CURL");
+    }
+    curl_easy_setopt(curl, CURLOPT_SHARE, static_cast<CURLSH*>(runtime->getShareHandle()));
+    return curl;
+}
+
+void ConnectionPool::setMaxSize(size_t newMaxSize) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        maxSize = newMaxSize > 0 ? newMaxSize : 1;
+        trimIdleLocked();
+    }
+    available.notify_all();
+}
+
+size_t ConnectionPool::getMaxSize() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return maxSize;
+}
+
+size_t ConnectionPool::getIdleCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return idle.size();
+}
+
+size_t ConnectionPool::getTotalCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return totalCount;
+}
+
+void ConnectionPool::trimIdleLocked() {
+    while (totalCount > maxSize && !idle.empty()) {
+        curl_easy_cleanup(static_cast<CURL*>(idle.back()));
+        slots.erase(idle.back());
+        idle.pop_back();
+        --totalCount;
+    }
+}
+
+} // namespace http
+} // namespace dataapi
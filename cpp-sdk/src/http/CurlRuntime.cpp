@@ -0,0 +1,123 @@
+#include "dataapi/http/CurlRuntime.h"
+#include <curl/curl.h>
+#include <openssl/crypto.h>
+#include <openssl/x509_vfy.h>
+#include <stdexcept>
+#include <string>
+
+namespace dataapi {
+namespace http {
+
+static_assert(CURL_LOCK_DATA_LAST <= 8, "shareLocks too small for CURL_LOCK_DATA_LAST");
+
+// CURLSH锁回调，userptr指向CurlRuntime::shareLocks数组
+static void lockShared(CURL* /*handle*/, curl_lock_data data, curl_lock_access /*access*/, void* userptr) {
+    static_cast<std::mutex*>(userptr)[data].lock();
+}
+
+static void unlockShared(CURL* /*handle*/, curl_lock_data data, void* userptr) {
+    static_cast<std::mutex*>(userptr)[data].unlock();
+}
+
+/**
+ * libcurl是否使用与本进程相同版本的OpenSSL，只有这样才能把本进程创建的X509_STORE交给libcurl的SSL_CTX
+ */
+static bool curlUsesLinkedOpenSsl(const curl_version_info_data* info) {
+    static const std::string prefix = "OpenSSL/";
+    if (!info || !info->ssl_version || std::string(info->ssl_version).compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    // OpenSSL_version形如"OpenSSL 3.0.13 30 Jan 2024"，libcurl形如"OpenSSL/3.0.13"
+    std::string curlVersion = std::string(info->ssl_version).substr(prefix.size());
+    std::string linked = OpenSSL_version(OPENSSL_VERSION);
+    size_t start = linked.find(' ');
+    size_t end = linked.find(' ', start + 1);
+    return start != std::string::npos && linked.substr(start + 1, end - start - 1) == curlVersion;
+}
+
+std::shared_ptr<CurlRuntime> CurlRuntime::instance() {
+    // 静态局部变量保证只初始化一次；静态副本让运行时在客户端之间保持存活
+    static std::shared_ptr<CurlRuntime> runtime(new CurlRuntime());
+    return runtime;
+}
+
+CurlRuntime::CurlRuntime() : shareHandle(nullptr), http2Supported(false), sharedStoreSupported(false) {
+    if (curl_global_init(CURL_GLOBAL_DEFAULT) != CURLE_OK) {
+        throw std::runtime_error("Failed to initialize CURL global state");
+    }
+
+    const curl_version_info_data* info = curl_version_info(CURLVERSION_NOW);
+    http2Supported = info && (info->features & CURL_VERSION_HTTP2) != 0;
+    sharedStoreSupported = curlUsesLinkedOpenSsl(info);
+
+    CURLSH* share = curl_share_init();
+    if (!share) {
+        curl_global_cleanup();
+        throw std::runtime_error("Failed to initialize CURL share handle");
+    }
+    curl_share_setopt(share, CURLSHOPT_LOCKFUNC, lockShared);
+    curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, unlockShared);
+    curl_share_setopt(share, CURLSHOPT_USERDATA, shareLocks);
+    // 连接缓存不在线程间共享（libcurl已知问题），由每个句柄自己的连接缓存保持复用
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    shareHandle = share;
+}
+
+CurlRuntime::~CurlRuntime() {
+    for (auto& entry : certificateStores) {
+        X509_STORE_free(static_cast<X509_STORE*>(entry.second));
+    }
+    if (shareHandle) {
+        curl_share_cleanup(static_cast<CURLSH*>(shareHandle));
+    }
+    curl_global_cleanup();
+}
+
+void* CurlRuntime::getCertificateStore(const std::string& caFile) {
+    if (!sharedStoreSupported) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(storeMutex);
+    auto found = certificateStores.find(caFile);
+    if (found != certificateStores.end()) {
+        return found->second;
+    }
+
+    // 未指定证书文件时使用libcurl编译时的默认证书文件和目录
+    std::string file = caFile;
+    std::string directory;
+    if (file.empty()) {
+        CURL* probe = curl_easy_init();
+        char* value = nullptr;
+        if (probe && curl_easy_getinfo(probe, CURLINFO_CAINFO, &value) == CURLE_OK && value) {
+            file = value;
+        }
+        value = nullptr;
+        if (probe && curl_easy_getinfo(probe, CURLINFO_CAPATH, &value) == CURLE_OK && value) {
+            directory = value;
+        }
+        curl_easy_cleanup(probe);
+    }
+
+    X509_STORE* store = X509_STORE_new();
+    bool loaded = false;
+    if (store) {
+        if (file.empty() && directory.empty()) {
+            loaded = X509_STORE_set_default_paths(store) == 1;
+        } else {
+            loaded = X509_STORE_load_locations(store, file.empty() ? nullptr : file.c_str(),
+                                               directory.empty() ? nullptr : directory.c_str()) == 1;
+        }
+    }
+    if (!loaded) {
+        // 交给libcurl按常规方式加载，由它报告证书错误
+        X509_STORE_free(store);
+        store = nullptr;
+    }
+    certificateStores[caFile] = store;
+    return store;
+}
+
+} // namespace http
+} // namespace dataapi
@@ -0,0 +1,45 @@
+#include "http/GzipStream.h"
+#include <stdexcept>
+
+namespace dataapi {
+namespace http {
+namespace detail {
+
+static constexpr size_t kInputChunk = 64 * 1024;
+
+GzipReader::GzipReader(Source source, int level) : source(std::move(source)), input(kInputChunk) {
+    // windowBits加16输出gzip格式（含头部和CRC）
+    if (deflateInit2(&stream, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw std::runtime_error("Failed to initialize gzip compression");
+    }
+}
+
+GzipReader::~GzipReader() {
+    deflateEnd(&stream);
+}
+
+size_t GzipReader::read(char* out, size_t size) {
+    stream.next_out = reinterpret_cast<Bytef*>(out);
+    stream.avail_out = static_cast<uInt>(size);
+
+    while (stream.avail_out > 0 && !finished) {
+        if (stream.avail_in == 0 && !inputDone) {
+            size_t count = source(input.data(), input.size());
+            inputDone = count == 0;
+            stream.next_in = reinterpret_cast<Bytef*>(input.data());
+            stream.avail_in = static_cast<uInt>(count);
+        }
+
+        int result = deflate(&stream, inputDone ? Z_FINISH : Z_NO_FLUSH);
+        if (result == Z_STREAM_END) {
+            finished = true;
+        } else if (result != Z_OK && result != Z_BUF_ERROR) {
+            throw std::runtime_error("gzip compression failed");
+        }
+    }
+    return size - stream.avail_out;
+}
+
+} // namespace detail
+} // namespace http
+} // namespace dataapi
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include <zlib.h>
+
+namespace dataapi {
+namespace http {
+namespace detail {
+
+/**
+ * 流式gzip压缩
+ *
+ * 从source按块拉取原始数据，按调用方提供的缓冲区大小输出压缩数据，
+ * 内存占用固定为一个输入块加zlib的内部状态，与数据总量无关。
+ */
+class GzipReader {
+public:
+    /**
+     * 原始数据来源，写入最多size字节并返回写入的字节数，返回0表示结束
+     */
+    using Source = std::function<size_t(char* buffer, size_t size)>;
+
+    /**
+     * 构造函数
+     * @param source 原始数据来源
+     * @param level 压缩级别（0-9，-1为zlib默认）
+     */
+    explicit GzipReader(Source source, int level = Z_DEFAULT_COMPRESSION);
+    ~GzipReader();
+
+    GzipReader(const GzipReader&) = delete;
+    GzipReader& operator=(const GzipReader&) = delete;
+
+    /**
+     * 读取压缩数据
+     * @return 写入out的字节数，返回0表示压缩流结束
+     * @throws std::runtime_error 压缩失败
+     */
+    size_t read(char* out, size_t size);
+
+private:
+    Source source;
+    z_stream stream{};
+    std::vector<char> input;
+    bool inputDone = false;
+    bool finished = false;
+};
+
+} // namespace detail
+} // namespace http
+} // namespace dataapi
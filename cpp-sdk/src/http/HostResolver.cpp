@@ -0,0 +1,111 @@
+#include "dataapi/http/HostResolver.h"
+#include <netdb.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <algorithm>
+
+namespace dataapi {
+namespace http {
+
+/**
+ * 调用getaddrinfo解析主机名，结果去重后交替排列两个地址族，首个地址族与系统排序一致
+ */
+static std::vector<std::string> lookupAddresses(const std::string& host) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* result = nullptr;
+    if (getaddrinfo(host.c_str(), nullptr, &hints, &result) != 0) {
+        return {};
+    }
+
+    std::vector<std::string> preferred;
+    std::vector<std::string> other;
+    int firstFamily = result ? result->ai_family : AF_UNSPEC;
+    for (addrinfo* info = result; info; info = info->ai_next) {
+        char text[INET6_ADDRSTRLEN] = {0};
+        const void* address = info->ai_family == AF_INET6
+            ? static_cast<const void*>(&reinterpret_cast<sockaddr_in6*>(info->ai_addr)->sin6_addr)
+            : static_cast<const void*>(&reinterpret_cast<sockaddr_in*>(info->ai_addr)->sin_addr);
+        if ((info->ai_family != AF_INET && info->ai_family != AF_INET6) ||
+            !inet_ntop(info->ai_family, address, text, sizeof(text))) {
+            continue;
+        }
+        auto& list = info->ai_family == firstFamily ? preferred : other;
+        if (std::find(list.begin(), list.end(), text) == list.end()) {
+            list.emplace_back(text);
+        }
+    }
+    freeaddrinfo(result);
+
+    std::vector<std::string> addresses;
+    for (size_t i = 0; i < std::max(preferred.size(), other.size()); ++i) {
+        if (i < preferred.size()) {
+            addresses.push_back(std::move(preferred[i]));
+        }
+        if (i < other.size()) {
+            addresses.push_back(std::move(other[i]));
+        }
+    }
+    return addresses;
+}
+
+HostResolver::HostResolver(std::chrono::seconds ttl) : ttl(ttl) {
+}
+
+HostResolver::Entry& HostResolver::lookupLocked(const std::string& host, std::unique_lock<std::mutex>& lock) {
+    auto now = Clock::now();
+    auto found = entries.find(host);
+    if (found != entries.end() && found->second.expires > now) {
+        return found->second;
+    }
+    // 解析可能耗时较长，期间不持有锁；并发的解析各自写回，结果相同
+    lock.unlock();
+    std::vector<std::string> addresses = lookupAddresses(host);
+    lock.lock();
+    Entry& entry = entries[host];
+    entry.addresses = std::move(addresses);
+    // 解析失败时很快重新解析
+    entry.expires = now + (entry.addresses.empty() ? std::chrono::seconds(1) : ttl);
+    return entry;
+}
+
+std::vector<std::string> HostResolver::resolve(const std::string& host) {
+    std::unique_lock<std::mutex> lock(mutex);
+    return lookupLocked(host, lock).addresses;
+}
+
+std::string HostResolver::select(const std::string& host, size_t slot) {
+    std::unique_lock<std::mutex> lock(mutex);
+    Entry& entry = lookupLocked(host, lock);
+    size_t count = entry.addresses.size();
+    if (count == 0) {
+        return {};
+    }
+    auto now = Clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        const std::string& address = entry.addresses[(slot + i) % count];
+        auto down = entry.unreachableUntil.find(address);
+        if (down == entry.unreachableUntil.end() || down->second <= now) {
+            return address;
+        }
+    }
+    return entry.addresses[slot % count];
+}
+
+void HostResolver::markUnreachable(const std::string& host, const std::string& address,
+                                   std::chrono::milliseconds duration) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto found = entries.find(host);
+    if (found != entries.end()) {
+        found->second.unreachableUntil[address] = Clock::now() + duration;
+    }
+}
+
+std::string HostResolver::connectTo(const std::string& host, const std::string& address) {
+    bool ipv6 = address.find(':') != std::string::npos;
+    return host + "::" + (ipv6 ? "[" + address + "]" : address) + ":";
+}
+
+} // namespace http
+} // namespace dataapi
@@ -0,0 +1,231 @@
+#include "dataapi/http/LoadBalancer.h"
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+namespace dataapi {
+namespace http {
+
+static int64_t nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(LoadBalancer::Clock::now().time_since_epoch()).count();
+}
+
+static std::minstd_rand& randomEngine() {
+    thread_local std::minstd_rand engine(std::random_device{}());
+    return engine;
+}
+
+LoadBalancer::Lease::~Lease() {
+    release();
+}
+
+LoadBalancer::Lease::Lease(Lease&& other) noexcept
+    : balancer(std::move(other.balancer)), index(other.index) {
+}
+
+LoadBalancer::Lease& LoadBalancer::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        release();
+        balancer = std::move(other.balancer);
+        index = other.index;
+    }
+    return *this;
+}
+
+const std::string& LoadBalancer::Lease::getBaseUrl() const {
+    return balancer->endpoints[index].config.baseUrl;
+}
+
+void LoadBalancer::Lease::complete(double latencyMs, bool failure) {
+    if (balancer) {
+        balancer->record(index, latencyMs, failure);
+        release();
+    }
+}
+
+void LoadBalancer::Lease::release() {
+    if (balancer) {
+        balancer->endpoints[index].outstanding.fetch_sub(1, std::memory_order_relaxed);
+        balancer.reset();
+    }
+}
+
+LoadBalancer::LoadBalancer(std::vector<ServiceEndpoint> configured, const LoadBalancerOptions& options)
+    : endpoints(configured.size()), options(options) {
+    if (configured.empty()) {
+        throw std::invalid_argument("LoadBalancer requires at least one endpoint");
+    }
+    for (size_t i = 0; i < configured.size(); ++i) {
+        endpoints[i].config = std::move(configured[i]);
+        if (!(endpoints[i].config.weight > 0)) {
+            endpoints[i].config.weight = 1.0;
+        }
+    }
+}
+
+LoadBalancer::~LoadBalancer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    stopped.notify_all();
+    if (checker.joinable()) {
+        checker.join();
+    }
+}
+
+bool LoadBalancer::isAvailable(const Endpoint& endpoint, int64_t now) const {
+    return endpoint.probeHealthy.load(std::memory_order_relaxed) &&
+        endpoint.ejectedUntil.load(std::memory_order_relaxed) <= now;
+}
+
+double LoadBalancer::cost(const Endpoint& endpoint) const {
+    double load = static_cast<double>(endpoint.outstanding.load(std::memory_order_relaxed) + 1);
+    if (options.policy == LoadBalancingPolicy::LatencyEwma) {
+        load *= static_cast<double>(endpoint.ewmaMicros.load(std::memory_order_relaxed));
+    }
+    return load / endpoint.config.weight;
+}
+
+size_t LoadBalancer::pickWeighted(const std::vector<size_t>& candidates) {
+    double total = 0;
+    for (size_t index : candidates) {
+        total += endpoints[index].config.weight;
+    }
+    double point = std::uniform_real_distribution<double>(0.0, total)(randomEngine());
+    for (size_t index : candidates) {
+        point -= endpoints[index].config.weight;
+        if (point < 0) {
+            return index;
+        }
+    }
+    return candidates.back();
+}
+
+LoadBalancer::Lease LoadBalancer::acquire(uint64_t avoid) {
+    size_t chosen = 0;
+    if (endpoints.size() > 1) {
+        int64_t now = nowNanos();
+        std::vector<size_t> candidates;
+        candidates.reserve(endpoints.size());
+        // 依次放宽：可用且未尝试过 -> 可用 -> 全部
+        for (int pass = 0; pass < 3 && candidates.empty(); ++pass) {
+            for (size_t i = 0; i < endpoints.size(); ++i) {
+                bool tried = i < 64 && (avoid >> i) & 1;
+                if ((pass == 0 && (tried || !isAvailable(endpoints[i], now))) ||
+                    (pass == 1 && !isAvailable(endpoints[i], now))) {
+                    continue;
+                }
+                candidates.push_back(i);
+            }
+        }
+
+        if (candidates.size() == 1) {
+            chosen = candidates.front();
+        } else if (options.policy == LoadBalancingPolicy::LeastOutstanding) {
+            // 从轮转的起点开始扫描，成本相同的端点轮流被选中
+            size_t start = cursor.fetch_add(1, std::memory_order_relaxed) % candidates.size();
+            double best = std::numeric_limits<double>::infinity();
+            for (size_t k = 0; k < candidates.size(); ++k) {
+                size_t index = candidates[(start + k) % candidates.size()];
+                double value = cost(endpoints[index]);
+                if (value < best) {
+                    best = value;
+                    chosen = index;
+                }
+            }
+        } else {
+            size_t first = pickWeighted(candidates);
+            candidates.erase(std::find(candidates.begin(), candidates.end(), first));
+            size_t second = pickWeighted(candidates);
+            chosen = cost(endpoints[second]) < cost(endpoints[first]) ? second : first;
+        }
+    }
+    endpoints[chosen].outstanding.fetch_add(1, std::memory_order_relaxed);
+    return Lease(shared_from_this(), chosen);
+}
+
+void LoadBalancer::record(size_t index, double latencyMs, bool failure) {
+    Endpoint& endpoint = endpoints[index];
+    endpoint.requests.fetch_add(1, std::memory_order_relaxed);
+    if (failure) {
+        endpoint.failures.fetch_add(1, std::memory_order_relaxed);
+        uint32_t count = endpoint.consecutiveFailures.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (options.failureThreshold > 0 && count >= options.failureThreshold) {
+            auto ejection = std::chrono::duration_cast<std::chrono::nanoseconds>(options.ejectionTime).count();
+            endpoint.ejectedUntil.store(nowNanos() + ejection, std::memory_order_relaxed);
+            endpoint.consecutiveFailures.store(0, std::memory_order_relaxed);
+        }
+        return;
+    }
+    endpoint.consecutiveFailures.store(0, std::memory_order_relaxed);
+
+    // peak EWMA：变慢时直接取新样本，变快时平滑
+    uint64_t sample = static_cast<uint64_t>(std::max(1.0, latencyMs * 1000.0));
+    uint64_t current = endpoint.ewmaMicros.load(std::memory_order_relaxed);
+    uint64_t next;
+    do {
+        next = current == 0 || sample > current
+            ? sample
+            : static_cast<uint64_t>(static_cast<double>(current) + options.ewmaWeight * (static_cast<double>(sample) - static_cast<double>(current)));
+    } while (!endpoint.ewmaMicros.compare_exchange_weak(current, next, std::memory_order_relaxed));
+}
+
+void LoadBalancer::startHealthChecks(Probe healthProbe) {
+    if (options.healthCheckInterval.count() <= 0 || !healthProbe || checker.joinable()) {
+        return;
+    }
+    probe = std::move(healthProbe);
+    checker = std::thread([this] { runHealthChecks(); });
+}
+
+void LoadBalancer::checkHealth() {
+    if (!probe) {
+        return;
+    }
+    for (auto& endpoint : endpoints) {
+        bool healthy = false;
+        try {
+            healthy = probe(endpoint.config.baseUrl);
+        } catch (...) {
+            healthy = false;
+        }
+        endpoint.probeHealthy.store(healthy, std::memory_order_relaxed);
+        if (healthy) {
+            // 探测恢复时提前结束按请求结果的摘除
+            endpoint.ejectedUntil.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void LoadBalancer::runHealthChecks() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        lock.unlock();
+        checkHealth();
+        lock.lock();
+        stopped.wait_for(lock, options.healthCheckInterval, [this] { return stopping; });
+    }
+}
+
+std::vector<EndpointStats> LoadBalancer::getStats() const {
+    int64_t now = nowNanos();
+    std::vector<EndpointStats> stats;
+    stats.reserve(endpoints.size());
+    for (const auto& endpoint : endpoints) {
+        EndpointStats entry;
+        entry.baseUrl = endpoint.config.baseUrl;
+        entry.weight = endpoint.config.weight;
+        entry.available = isAvailable(endpoint, now);
+        entry.outstanding = endpoint.outstanding.load(std::memory_order_relaxed);
+        entry.latencyEwma = static_cast<double>(endpoint.ewmaMicros.load(std::memory_order_relaxed)) / 1000.0;
+        entry.requests = endpoint.requests.load(std::memory_order_relaxed);
+        entry.failures = endpoint.failures.load(std::memory_order_relaxed);
+        stats.push_back(std::move(entry));
+    }
+    return stats;
+}
+
+} // namespace http
+} // namespace dataapi
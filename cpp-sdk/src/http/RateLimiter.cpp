@@ -0,0 +1,73 @@
+#include "dataapi/http/RateLimiter.h"
+#include <algorithm>
+#include <thread>
+
+namespace dataapi {
+namespace http {
+
+RateLimiter::RateLimiter(double ratePerSecond, double burst)
+    : rate(std::max(0.0, ratePerSecond)),
+      capacity(std::max(1.0, burst)),
+      tokens(std::max(1.0, burst)),
+      last(Clock::now()) {
+}
+
+void RateLimiter::refill(Clock::time_point now) {
+    std::chrono::duration<double> elapsed = now - last;
+    last = now;
+    tokens = std::min(capacity, tokens + elapsed.count() * rate);
+}
+
+RateLimiter::Clock::duration RateLimiter::reserve(double count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (rate <= 0.0) {
+        return Clock::duration::zero();
+    }
+    refill(Clock::now());
+    tokens -= count;
+    if (tokens >= 0.0) {
+        return Clock::duration::zero();
+    }
+    return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(-tokens / rate));
+}
+
+void RateLimiter::acquire(double count) {
+    Clock::duration wait = reserve(count);
+    if (wait > Clock::duration::zero()) {
+        std::this_thread::sleep_for(wait);
+    }
+}
+
+bool RateLimiter::tryAcquire(double count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (rate <= 0.0) {
+        return true;
+    }
+    refill(Clock::now());
+    if (tokens < count) {
+        return false;
+    }
+    tokens -= count;
+    return true;
+}
+
+void RateLimiter::setRate(double ratePerSecond, double burst) {
+    std::lock_guard<std::mutex> lock(mutex);
+    refill(Clock::now());
+    rate = std::max(0.0, ratePerSecond);
+    capacity = std::max(1.0, burst);
+    tokens = std::min(tokens, capacity);
+}
+
+double RateLimiter::getTokens() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return tokens;
+}
+
+double RateLimiter::getRate() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return rate;
+}
+
+} // namespace http
+} // namespace dataapi
@@ -0,0 +1,58 @@
+#include "http/RequestArena.h"
+#include <cstddef>
+
+namespace dataapi {
+namespace http {
+namespace detail {
+
+#ifdef DATAAPI_WITH_REQUEST_ARENA
+
+// 常见请求的临时对象远小于该大小；超出部分向上游申请，作用域结束时归还
+static constexpr size_t kInitialArenaSize = 16 * 1024;
+
+namespace {
+
+struct ThreadArena {
+    alignas(std::max_align_t) std::byte initial[kInitialArenaSize];
+    std::pmr::monotonic_buffer_resource resource{initial, sizeof(initial), std::pmr::new_delete_resource()};
+    int depth = 0;
+};
+
+ThreadArena& threadArena() {
+    thread_local ThreadArena arena;
+    return arena;
+}
+
+} // namespace
+
+RequestArena::Scope::Scope() {
+    ++threadArena().depth;
+}
+
+RequestArena::Scope::~Scope() {
+    ThreadArena& arena = threadArena();
+    if (--arena.depth == 0) {
+        arena.resource.release();
+    }
+}
+
+std::pmr::memory_resource* RequestArena::current() {
+    ThreadArena& arena = threadArena();
+    return arena.depth > 0 ? &arena.resource : std::pmr::get_default_resource();
+}
+
+#else
+
+RequestArena::Scope::Scope() = default;
+
+RequestArena::Scope::~Scope() = default;
+
+std::pmr::memory_resource* RequestArena::current() {
+    return std::pmr::get_default_resource();
+}
+
+#endif
+
+} // namespace detail
+} // namespace http
+} // namespace dataapi
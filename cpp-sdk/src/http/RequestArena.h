@@ -0,0 +1,40 @@
+#pragma once
+
+#include <memory_resource>
+
+namespace dataapi {
+namespace http {
+namespace detail {
+
+/**
+ * 线程内的请求级临时内存
+ *
+ * 同步请求期间的临时对象（完整URL、请求级头部等）从线程独占的单调缓冲区分配，
+ * 不经过全局分配器，多线程并发请求时没有分配器争用。最外层作用域结束时整体释放，
+ * 嵌套的请求（如在响应体回调中发起的请求）共用外层的缓冲区。
+ * 异步请求的状态跨线程存活，不使用该缓冲区；以DATAAPI_ENABLE_REQUEST_ARENA=OFF
+ * 构建时始终使用默认内存资源。
+ */
+class RequestArena {
+public:
+    /**
+     * 请求作用域，最外层作用域析构时释放本线程缓冲区中的所有分配
+     */
+    class Scope {
+    public:
+        Scope();
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    /**
+     * 本线程当前的内存资源，不在任何作用域内时为默认内存资源
+     */
+    static std::pmr::memory_resource* current();
+};
+
+} // namespace detail
+} // namespace http
+} // namespace dataapi
@@ -0,0 +1,243 @@
+#include "http/RequestLogger.h"
+#include "http/Transfer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+#include <strings.h>
+
+namespace dataapi {
+namespace http {
+namespace detail {
+
+static constexpr const char* kRedacted = "[REDACTED]";
+
+// 不论认证提供者如何配置都视为凭据的头部
+static constexpr const char* kSensitiveHeaders[] = {
+    "Authorization", "Proxy-Authorization", "Cookie", "X-Api-Key", "X-Auth-Token"
+};
+
+static std::string timestamp(std::chrono::system_clock::time_point time) {
+    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+    std::time_t seconds = static_cast<std::time_t>(millis / 1000);
+    std::tm utc{};
+    gmtime_r(&seconds, &utc);
+    char buffer[64];
+    size_t length = std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", &utc);
+    std::snprintf(buffer + length, sizeof(buffer) - length, ".%03dZ", static_cast<int>(millis % 1000));
+    return buffer;
+}
+
+static size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 2;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+RequestLogger::RequestLogger(size_t capacity, Sink sink)
+    : slots(roundUpToPowerOfTwo(std::max<size_t>(capacity, 2))),
+      mask(slots.size() - 1),
+      sink(std::move(sink)) {
+    for (size_t i = 0; i < slots.size(); ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    writer = std::thread([this] { run(); });
+}
+
+RequestLogger::~RequestLogger() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    writer.join();
+}
+
+bool RequestLogger::sample(double rate) {
+    if (rate >= 1.0) {
+        return true;
+    }
+    if (!(rate > 0.0)) {
+        return false;
+    }
+    // 第n个请求在floor(n * rate)增加时命中，任意长度的窗口内命中比例与rate的误差不超过1条
+    uint64_t n = sampled.fetch_add(1, std::memory_order_relaxed);
+    return std::floor(static_cast<double>(n + 1) * rate) > std::floor(static_cast<double>(n) * rate);
+}
+
+std::unique_ptr<LogRecord> RequestLogger::begin(const ClientConfig& config,
+                                                const HttpRequestConfig& request,
+                                                std::string_view url,
+                                                std::string_view body) {
+    if (!sample(config.logSampleRate)) {
+        return nullptr;
+    }
+    auto record = std::make_unique<LogRecord>();
+    record->logger = shared_from_this();
+    record->time = std::chrono::system_clock::now();
+    record->start = std::chrono::steady_clock::now();
+    record->method = request.method;
+    record->url.assign(url.data(), url.size());
+    record->requestHeaders = request.headers;
+    record->maxBodyBytes = config.logMaxBodyBytes;
+    record->requestBytes = body.size();
+    record->requestBody.assign(body.data(), std::min(body.size(), config.logMaxBodyBytes));
+    return record;
+}
+
+void RequestLogger::complete(std::unique_ptr<LogRecord> record, const HttpResponse* response, std::exception_ptr error) {
+    if (!record) {
+        return;
+    }
+    record->durationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - record->start).count();
+    if (response) {
+        record->statusCode = response->statusCode;
+        record->responseBytes = response->body.size();
+        record->responseBody.assign(response->body, 0, std::min(response->body.size(), record->maxBodyBytes));
+    } else if (error) {
+        try {
+            std::rethrow_exception(error);
+        } catch (const std::exception& e) {
+            record->error = e.what();
+        } catch (...) {
+            record->error = "unknown error";
+        }
+    }
+    // 队列中的记录不持有日志器，最后一个引用不会在写入线程上释放
+    auto logger = std::move(record->logger);
+    if (!logger->push(record)) {
+        logger->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    logger->accepted.fetch_add(1, std::memory_order_release);
+    if (logger->idle.load(std::memory_order_acquire)) {
+        logger->wake.notify_one();
+    }
+}
+
+bool RequestLogger::push(std::unique_ptr<LogRecord>& record) {
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = slots[pos & mask];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.record = std::move(record);
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false; // 已满
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+std::unique_ptr<LogRecord> RequestLogger::pop() {
+    Slot& slot = slots[dequeuePos & mask];
+    if (slot.sequence.load(std::memory_order_acquire) != dequeuePos + 1) {
+        return nullptr;
+    }
+    auto record = std::move(slot.record);
+    slot.sequence.store(dequeuePos + slots.size(), std::memory_order_release);
+    ++dequeuePos;
+    return record;
+}
+
+void RequestLogger::run() {
+    for (;;) {
+        while (auto record = pop()) {
+            try {
+                std::string line = format(*record);
+                if (sink) {
+                    sink(line);
+                } else {
+                    std::cerr << line << '\n';
+                }
+            } catch (...) {
+                // 日志写入失败不影响请求
+            }
+            written.fetch_add(1, std::memory_order_release);
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        if (stopping && written.load(std::memory_order_acquire) == accepted.load(std::memory_order_acquire)) {
+            return;
+        }
+        // 生产者只在写入线程空闲时通知；定时唤醒兜底通知与进入等待之间的竞争
+        idle.store(true, std::memory_order_release);
+        wake.wait_for(lock, std::chrono::milliseconds(50));
+        idle.store(false, std::memory_order_release);
+    }
+}
+
+void RequestLogger::flush() {
+    uint64_t target = accepted.load(std::memory_order_acquire);
+    while (written.load(std::memory_order_acquire) < target) {
+        wake.notify_one();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+std::string RequestLogger::format(const LogRecord& record) {
+    std::vector<std::string_view> redacted(std::begin(kSensitiveHeaders), std::end(kSensitiveHeaders));
+    if (record.clientHeaders) {
+        for (size_t i = 0; i < record.clientHeaders->authCount; ++i) {
+            redacted.push_back(record.clientHeaders->fields[i].first);
+        }
+    }
+    auto isRedacted = [&redacted](const std::string& name) {
+        return std::any_of(redacted.begin(), redacted.end(), [&name](std::string_view candidate) {
+            return candidate.size() == name.size() && strncasecmp(candidate.data(), name.c_str(), name.size()) == 0;
+        });
+    };
+
+    Json headers = Json::object();
+    if (record.clientHeaders) {
+        for (const auto& field : record.clientHeaders->fields) {
+            bool overridden = std::any_of(record.requestHeaders.begin(), record.requestHeaders.end(), [&](const auto& header) {
+                return strcasecmp(header.first.c_str(), field.first.c_str()) == 0;
+            });
+            if (!overridden) {
+                headers[field.first] = isRedacted(field.first) ? kRedacted : field.second;
+            }
+        }
+    }
+    for (const auto& header : record.requestHeaders) {
+        headers[header.first] = isRedacted(header.first) ? kRedacted : header.second;
+    }
+
+    Json line = Json::object();
+    line["time"] = timestamp(record.time);
+    line["method"] = methodName(record.method);
+    line["url"] = record.url;
+    line["durationMs"] = std::round(record.durationMs * 1000.0) / 1000.0;
+    if (record.error.empty()) {
+        line["status"] = record.statusCode;
+    } else {
+        line["error"] = record.error;
+    }
+    line["requestHeaders"] = std::move(headers);
+    line["requestBytes"] = record.requestBytes;
+    if (!record.requestBody.empty()) {
+        line["requestBody"] = record.requestBody;
+        line["requestTruncated"] = record.requestBody.size() < record.requestBytes;
+    }
+    if (record.error.empty()) {
+        line["responseBytes"] = record.responseBytes;
+        if (!record.responseBody.empty()) {
+            line["responseBody"] = record.responseBody;
+            line["responseTruncated"] = record.responseBody.size() < record.responseBytes;
+        }
+    }
+    // 截断可能落在多字节字符中间，二进制请求体也不一定是UTF-8，替换无效字节而不是抛出异常
+    return line.dump(-1, ' ', false, Json::error_handler_t::replace);
+}
+
+} // namespace detail
+} // namespace http
+} // namespace dataapi
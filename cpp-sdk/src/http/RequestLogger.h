@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "dataapi/Types.h"
+#include "dataapi/http/HttpClient.h"
+
+namespace dataapi {
+namespace http {
+namespace detail {
+
+struct HeaderBlock;
+class RequestLogger;
+
+/**
+ * 一次传输的日志记录
+ * 请求路径上只复制字段（请求体和响应体只保留前maxBodyBytes字节），格式化在写入线程进行
+ */
+struct LogRecord {
+    std::shared_ptr<RequestLogger> logger;
+    std::chrono::system_clock::time_point time;
+    std::chrono::steady_clock::time_point start;
+    double durationMs = 0;
+    HttpMethod method = HttpMethod::GET;
+    std::string url;
+    Headers requestHeaders;
+    std::shared_ptr<const HeaderBlock> clientHeaders; // 客户端级头部（认证头部 + 默认头部），未被请求级头部覆盖的一并记录
+    size_t maxBodyBytes = 0;
+    std::string requestBody;
+    size_t requestBytes = 0;
+    int statusCode = 0;
+    std::string responseBody;
+    size_t responseBytes = 0;
+    std::string error;
+};
+
+/**
+ * 异步请求日志
+ *
+ * 请求线程把记录放入有界的无锁多生产者单消费者环形缓冲区，后台线程取出、格式化为一行JSON
+ * 并交给sink。缓冲区满时丢弃新记录并计数，请求路径从不等待写入。
+ * 认证提供者给出的头部及Authorization、Cookie等常见凭据头部在格式化时替换为[REDACTED]。
+ */
+class RequestLogger : public std::enable_shared_from_this<RequestLogger> {
+public:
+    using Sink = std::function<void(const std::string& line)>;
+
+    /**
+     * @param capacity 缓冲区容量（条），向上取整为2的幂
+     * @param sink 日志行的接收者，为空时写到标准错误
+     */
+    RequestLogger(size_t capacity, Sink sink);
+
+    /**
+     * 写出缓冲区中剩余的记录后停止写入线程
+     */
+    ~RequestLogger();
+
+    RequestLogger(const RequestLogger&) = delete;
+    RequestLogger& operator=(const RequestLogger&) = delete;
+
+    /**
+     * 按比例采样，连续调用中命中的比例精确等于rate
+     */
+    bool sample(double rate);
+
+    /**
+     * 开始一条记录；未被采样时返回空，调用方随后填入clientHeaders
+     * @param url 完整URL（含查询串）
+     * @param body 已序列化的请求体
+     */
+    std::unique_ptr<LogRecord> begin(const ClientConfig& config,
+                                     const HttpRequestConfig& request,
+                                     std::string_view url,
+                                     std::string_view body);
+
+    /**
+     * 补充结果并提交记录，response和error二选一
+     */
+    static void complete(std::unique_ptr<LogRecord> record, const HttpResponse* response, std::exception_ptr error);
+
+    /**
+     * 等待已提交的记录全部写出
+     */
+    void flush();
+
+    /**
+     * 因缓冲区已满被丢弃的记录数
+     */
+    uint64_t getDropped() const {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * 把记录格式化为一行JSON（不含换行）
+     */
+    static std::string format(const LogRecord& record);
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        std::unique_ptr<LogRecord> record;
+    };
+
+    bool push(std::unique_ptr<LogRecord>& record);
+    std::unique_ptr<LogRecord> pop();
+    void run();
+
+    std::vector<Slot> slots;
+    size_t mask;
+    alignas(64) std::atomic<size_t> enqueuePos{0};
+    alignas(64) size_t dequeuePos = 0; // 只由写入线程访问
+    std::atomic<uint64_t> sampled{0};
+    std::atomic<uint64_t> accepted{0};
+    std::atomic<uint64_t> written{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<bool> idle{false};
+    std::atomic<bool> stopping{false};
+    Sink sink;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::thread writer;
+};
+
+} // namespace detail
+} // namespace http
+} // namespace dataapi
@@ -0,0 +1,193 @@
+#include "dataapi/http/RequestMetrics.h"
+#include <algorithm>
+#include <cctype>
+#include <string_view>
+
+namespace dataapi {
+namespace http {
+
+LatencyHistogram::LatencyHistogram() : count(0), sum(0), max(0) {
+    for (auto& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+size_t LatencyHistogram::bucketIndex(uint64_t micros) {
+    if (micros < kLinearBuckets) {
+        return static_cast<size_t>(micros);
+    }
+    size_t exponent = 63 - static_cast<size_t>(__builtin_clzll(micros));
+    size_t sub = static_cast<size_t>(micros >> (exponent - 3)) & (kSubBuckets - 1);
+    return kLinearBuckets + (exponent - 4) * kSubBuckets + sub;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < kLinearBuckets) {
+        return index;
+    }
+    size_t exponent = (index - kLinearBuckets) / kSubBuckets + 4;
+    uint64_t sub = (index - kLinearBuckets) % kSubBuckets;
+    uint64_t width = uint64_t(1) << (exponent - 3);
+    return ((kSubBuckets + sub) << (exponent - 3)) + width - 1;
+}
+
+void LatencyHistogram::record(uint64_t micros) {
+    buckets[bucketIndex(micros)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(micros, std::memory_order_relaxed);
+    uint64_t current = max.load(std::memory_order_relaxed);
+    while (micros > current && !max.compare_exchange_weak(current, micros, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t LatencyHistogram::getCount() const {
+    return count.load(std::memory_order_relaxed);
+}
+
+double LatencyHistogram::getMean() const {
+    uint64_t n = count.load(std::memory_order_relaxed);
+    return n == 0 ? 0.0 : static_cast<double>(sum.load(std::memory_order_relaxed)) / n / 1000.0;
+}
+
+double LatencyHistogram::getMax() const {
+    return static_cast<double>(max.load(std::memory_order_relaxed)) / 1000.0;
+}
+
+double LatencyHistogram::getPercentile(double quantile) const {
+    // 基于桶计数求和而非count，避免并发记录时两者短暂不一致
+    std::array<uint64_t, kBucketCount> snapshot;
+    uint64_t n = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        snapshot[i] = buckets[i].load(std::memory_order_relaxed);
+        n += snapshot[i];
+    }
+    if (n == 0) {
+        return 0.0;
+    }
+    quantile = std::min(1.0, std::max(0.0, quantile));
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(quantile * static_cast<double>(n) + 0.5));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        seen += snapshot[i];
+        if (seen >= rank) {
+            uint64_t upper = std::min(bucketUpperBound(i), max.load(std::memory_order_relaxed));
+            return static_cast<double>(upper) / 1000.0;
+        }
+    }
+    return getMax();
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+}
+
+RequestMetrics::RequestMetrics() : observers(std::make_shared<const ObserverList>()) {
+}
+
+static uint64_t toMicros(double millis) {
+    return millis > 0.0 ? static_cast<uint64_t>(millis * 1000.0) : 0;
+}
+
+void RequestMetrics::record(const RequestEvent& event) {
+    const RequestStats& stats = event.stats;
+    nameLookup.record(toMicros(stats.nameLookupTime));
+    connect.record(toMicros(stats.connectTime));
+    if (stats.appConnectTime > 0.0) {
+        appConnect.record(toMicros(stats.appConnectTime));
+    }
+    if (!event.transportError) {
+        startTransfer.record(toMicros(stats.startTransferTime));
+    }
+    total.record(toMicros(stats.totalTime));
+
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        lastStats = stats;
+    }
+
+    auto current = std::atomic_load(&observers);
+    for (const auto& observer : *current) {
+        try {
+            observer->onRequestComplete(event);
+        } catch (...) {
+            // 观察者异常不影响请求结果
+        }
+    }
+}
+
+void RequestMetrics::addObserver(std::shared_ptr<RequestObserver> observer) {
+    if (!observer) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(observerMutex);
+    auto updated = std::make_shared<ObserverList>(*std::atomic_load(&observers));
+    updated->push_back(std::move(observer));
+    std::atomic_store(&observers, std::shared_ptr<const ObserverList>(std::move(updated)));
+}
+
+void RequestMetrics::removeObserver(const std::shared_ptr<RequestObserver>& observer) {
+    std::lock_guard<std::mutex> lock(observerMutex);
+    auto updated = std::make_shared<ObserverList>(*std::atomic_load(&observers));
+    updated->erase(std::remove(updated->begin(), updated->end(), observer), updated->end());
+    std::atomic_store(&observers, std::shared_ptr<const ObserverList>(std::move(updated)));
+}
+
+RequestStats RequestMetrics::getLastStats() const {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    return lastStats;
+}
+
+void RequestMetrics::reset() {
+    nameLookup.reset();
+    connect.reset();
+    appConnect.reset();
+    startTransfer.reset();
+    total.reset();
+}
+
+// 路径段是否像资源ID：纯数字，或长度不小于16的十六进制/UUID
+static bool looksLikeId(std::string_view segment) {
+    if (segment.empty()) {
+        return false;
+    }
+    if (std::all_of(segment.begin(), segment.end(), [](unsigned char c) { return std::isdigit(c); })) {
+        return true;
+    }
+    return segment.size() >= 16 &&
+           std::all_of(segment.begin(), segment.end(),
+                       [](unsigned char c) { return std::isxdigit(c) || c == '-'; });
+}
+
+std::string RequestMetrics::normalizeEndpoint(const std::string& url) {
+    // 按视图切分路径段，只为结果分配一次
+    std::string_view path = std::string_view(url).substr(0, url.find_first_of("?#"));
+    std::string result;
+    result.reserve(path.size());
+
+    size_t start = 0;
+    while (start <= path.size()) {
+        size_t end = path.find('/', start);
+        if (end == std::string::npos) {
+            end = path.size();
+        }
+        std::string_view segment = path.substr(start, end - start);
+        if (looksLikeId(segment)) {
+            result += "{id}";
+        } else {
+            result.append(segment);
+        }
+        if (end < path.size()) {
+            result += '/';
+        }
+        start = end + 1;
+    }
+    return result;
+}
+
+} // namespace http
+} // namespace dataapi
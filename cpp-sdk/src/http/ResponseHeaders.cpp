@@ -0,0 +1,64 @@
+#include "dataapi/http/ResponseHeaders.h"
+#include "dataapi/utils/StringUtils.h"
+
+namespace dataapi {
+namespace http {
+
+static constexpr size_t kInitialBufferSize = 1024;
+
+bool ResponseHeaders::append(const char* line, size_t length) {
+    std::string_view raw(line, length);
+
+    if (raw.size() >= 5 && raw.compare(0, 5, "HTTP/") == 0) {
+        clear();
+        return false;
+    }
+
+    size_t colon = raw.find(':');
+    if (colon == std::string_view::npos) {
+        return false;
+    }
+    std::string_view name = utils::StringUtils::trimView(raw.substr(0, colon));
+    std::string_view value = utils::StringUtils::trimView(raw.substr(colon + 1));
+    if (name.empty()) {
+        return false;
+    }
+
+    if (buffer.capacity() < kInitialBufferSize) {
+        buffer.reserve(kInitialBufferSize);
+    }
+    Field field;
+    field.nameOffset = static_cast<uint32_t>(buffer.size());
+    field.nameLength = static_cast<uint32_t>(name.size());
+    buffer.append(name.data(), name.size());
+    field.valueOffset = static_cast<uint32_t>(buffer.size());
+    field.valueLength = static_cast<uint32_t>(value.size());
+    buffer.append(value.data(), value.size());
+    fields.push_back(field);
+    return true;
+}
+
+std::optional<std::string_view> ResponseHeaders::get(std::string_view name) const {
+    for (size_t i = fields.size(); i-- > 0;) {
+        if (utils::StringUtils::equalsIgnoreCase(nameAt(i), name)) {
+            return valueAt(i);
+        }
+    }
+    return std::nullopt;
+}
+
+Headers ResponseHeaders::toMap() const {
+    Headers result;
+    for (size_t i = 0; i < fields.size(); ++i) {
+        result[std::string(nameAt(i))] = std::string(valueAt(i));
+    }
+    return result;
+}
+
+void ResponseHeaders::clear() {
+    buffer.clear();
+    fields.clear();
+}
+
+} // namespace http
+} // namespace dataapi
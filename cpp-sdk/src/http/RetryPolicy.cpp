@@ -0,0 +1,130 @@
+#include "dataapi/http/RetryPolicy.h"
+#include <curl/curl.h>
+#include <algorithm>
+#include <cctype>
+#include <ctime>
+#include <random>
+
+namespace dataapi {
+namespace http {
+
+static std::mt19937_64& randomEngine() {
+    thread_local std::mt19937_64 engine(std::random_device{}());
+    return engine;
+}
+
+RetryBudget::RetryBudget(double ratio, double capacity)
+    : ratio(std::max(0.0, ratio)), capacity(std::max(1.0, capacity)), tokens(std::max(1.0, capacity)) {
+}
+
+void RetryBudget::recordRequest() {
+    std::lock_guard<std::mutex> lock(mutex);
+    tokens = std::min(capacity, tokens + ratio);
+}
+
+bool RetryBudget::tryAcquire() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (tokens < 1.0) {
+        return false;
+    }
+    tokens -= 1.0;
+    return true;
+}
+
+double RetryBudget::getTokens() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return tokens;
+}
+
+RetryPolicy::RetryPolicy(const Settings& settings) : settings(settings) {
+    this->settings.maxRetries = std::max(0, this->settings.maxRetries);
+    this->settings.baseDelayMs = std::max(1, this->settings.baseDelayMs);
+    this->settings.maxDelayMs = std::max(this->settings.baseDelayMs, this->settings.maxDelayMs);
+}
+
+RetryPolicy RetryPolicy::fromConfig(const ClientConfig& config) {
+    Settings settings;
+    settings.maxRetries = config.enableRetry ? config.maxRetries : 0;
+    settings.baseDelayMs = config.retryDelay;
+    settings.maxDelayMs = config.maxRetryDelay;
+    return RetryPolicy(settings);
+}
+
+bool RetryPolicy::isIdempotent(const HttpRequestConfig& request) {
+    if (request.idempotent) {
+        return *request.idempotent;
+    }
+    switch (request.method) {
+        case HttpMethod::GET:
+        case HttpMethod::HEAD:
+        case HttpMethod::PUT:
+        case HttpMethod::DELETE:
+            return true;
+        case HttpMethod::POST:
+        case HttpMethod::PATCH:
+            return false;
+    }
+    return false;
+}
+
+bool RetryPolicy::shouldRetryStatus(const HttpRequestConfig& request, int statusCode) const {
+    switch (statusCode) {
+        case 429: // Too Many Requests：服务端未处理请求
+        case 503: // Service Unavailable：服务端未处理请求
+            return true;
+        case 408: // Request Timeout
+        case 500: // Internal Server Error
+        case 502: // Bad Gateway
+        case 504: // Gateway Timeout
+            return isIdempotent(request);
+        default:
+            return false;
+    }
+}
+
+bool RetryPolicy::shouldRetryError(const HttpRequestConfig& request, const error::DataApiError& error) const {
+    if (!error.isRetryable()) {
+        return false;
+    }
+    // 连接未建立时请求尚未发出，可安全重试任何方法
+    if (dynamic_cast<const error::ConnectionError*>(&error)) {
+        return true;
+    }
+    return isIdempotent(request);
+}
+
+std::chrono::milliseconds RetryPolicy::nextDelay(std::chrono::milliseconds previous) const {
+    long long base = settings.baseDelayMs;
+    long long upper = std::max(base, static_cast<long long>(previous.count()) * 3);
+    std::uniform_int_distribution<long long> distribution(base, upper);
+    long long delay = std::min<long long>(settings.maxDelayMs, distribution(randomEngine()));
+    return std::chrono::milliseconds(delay);
+}
+
+std::optional<std::chrono::milliseconds> RetryPolicy::parseRetryAfter(const std::string& value) {
+    size_t start = value.find_first_not_of(" \t");
+    if (start == std::string::npos) {
+        return std::nullopt;
+    }
+    size_t end = value.find_last_not_of(" \t\r\n");
+    std::string trimmed = value.substr(start, end - start + 1);
+
+    if (std::all_of(trimmed.begin(), trimmed.end(), [](unsigned char c) { return std::isdigit(c); })) {
+        if (trimmed.size() > 9) {
+            return std::nullopt;
+        }
+        return std::chrono::milliseconds(std::stoll(trimmed) * 1000);
+    }
+
+    // HTTP日期格式，例如 "Wed, 21 Oct 2015 07:28:00 GMT"
+    time_t when = curl_getdate(trimmed.c_str(), nullptr);
+    if (when < 0) {
+        return std::nullopt;
+    }
+    time_t now = std::time(nullptr);
+    long long seconds = when > now ? static_cast<long long>(when - now) : 0;
+    return std::chrono::milliseconds(seconds * 1000);
+}
+
+} // namespace http
+} // namespace dataapi
@@ -0,0 +1,208 @@
+#include "dataapi/http/Tracing.h"
+#include "http/Transfer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <thread>
+
+namespace dataapi {
+namespace http {
+
+static thread_local const TraceContext* currentContext = nullptr;
+
+static bool isLowerHex(std::string_view text) {
+    for (char c : text) {
+        if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool isZero(std::string_view text) {
+    return text.find_first_not_of('0') == std::string_view::npos;
+}
+
+static void appendHex(std::string& out, uint64_t value, int digits) {
+    static constexpr char kDigits[] = "0123456789abcdef";
+    for (int shift = (digits - 1) * 4; shift >= 0; shift -= 4) {
+        out += kDigits[(value >> shift) & 0xf];
+    }
+}
+
+/**
+ * 线程内的随机数生成器，首次使用时以random_device、线程和时间混合播种
+ */
+static std::mt19937_64& generator() {
+    thread_local std::mt19937_64 engine([] {
+        std::random_device device;
+        uint64_t seed = (static_cast<uint64_t>(device()) << 32) ^ device();
+        seed ^= std::hash<std::thread::id>()(std::this_thread::get_id());
+        seed ^= static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        return seed;
+    }());
+    return engine;
+}
+
+static uint64_t randomNonZero() {
+    uint64_t value;
+    do {
+        value = generator()();
+    } while (value == 0);
+    return value;
+}
+
+std::optional<TraceContext> TraceContext::parse(std::string_view traceparent, std::string_view tracestate) {
+    // version(2)-trace-id(32)-parent-id(16)-flags(2)；未来版本可以在其后追加字段
+    if (traceparent.size() < 55 || traceparent[2] != '-' || traceparent[35] != '-' || traceparent[52] != '-') {
+        return std::nullopt;
+    }
+    std::string_view version = traceparent.substr(0, 2);
+    std::string_view traceId = traceparent.substr(3, 32);
+    std::string_view spanId = traceparent.substr(36, 16);
+    std::string_view flags = traceparent.substr(53, 2);
+    if (!isLowerHex(version) || version == "ff" || !isLowerHex(traceId) || !isLowerHex(spanId) || !isLowerHex(flags) ||
+        isZero(traceId) || isZero(spanId)) {
+        return std::nullopt;
+    }
+    if (version == "00" ? traceparent.size() != 55 : traceparent.size() > 55 && traceparent[55] != '-') {
+        return std::nullopt;
+    }
+    TraceContext context;
+    context.traceId.assign(traceId);
+    context.spanId.assign(spanId);
+    context.sampled = (std::stoi(std::string(flags), nullptr, 16) & 0x01) != 0;
+    context.traceState.assign(tracestate);
+    return context;
+}
+
+TraceContext TraceContext::root(double sampleRate) {
+    uint64_t high = generator()();
+    uint64_t low = randomNonZero();
+    TraceContext context;
+    context.traceId.reserve(32);
+    appendHex(context.traceId, high, 16);
+    appendHex(context.traceId, low, 16);
+    context.spanId.reserve(16);
+    appendHex(context.spanId, randomNonZero(), 16);
+    // 取trace id低56位与比例比较
+    uint64_t bound = static_cast<uint64_t>(std::max(0.0, std::min(sampleRate, 1.0)) * static_cast<double>(1ULL << 56));
+    context.sampled = sampleRate >= 1.0 || (low & ((1ULL << 56) - 1)) < bound;
+    return context;
+}
+
+TraceContext TraceContext::child() const {
+    TraceContext context;
+    context.traceId = traceId;
+    context.spanId.reserve(16);
+    appendHex(context.spanId, randomNonZero(), 16);
+    context.sampled = sampled;
+    context.traceState = traceState;
+    return context;
+}
+
+std::string TraceContext::traceparent() const {
+    std::string value;
+    value.reserve(55);
+    value.append("00-").append(traceId).append("-").append(spanId).append(sampled ? "-01" : "-00");
+    return value;
+}
+
+const TraceContext* TraceContext::current() {
+    return currentContext;
+}
+
+TraceScope::TraceScope(TraceContext context) : context(std::move(context)), previous(currentContext) {
+    currentContext = &this->context;
+}
+
+TraceScope::~TraceScope() {
+    currentContext = previous;
+}
+
+static std::string unixNanos(std::chrono::system_clock::time_point time) {
+    return std::to_string(std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count());
+}
+
+static Json stringAttribute(const char* key, const std::string& value) {
+    return Json{{"key", key}, {"value", {{"stringValue", value}}}};
+}
+
+static Json intAttribute(const char* key, int64_t value) {
+    // OTLP JSON中64位整数以字符串表示
+    return Json{{"key", key}, {"value", {{"intValue", std::to_string(value)}}}};
+}
+
+static Json otlpSpan(const TraceSpan& span) {
+    Json attributes = Json::array();
+    attributes.push_back(stringAttribute("http.request.method", detail::methodName(span.method)));
+    attributes.push_back(stringAttribute("url.full", span.url));
+    attributes.push_back(stringAttribute("http.route", span.endpoint));
+    if (span.statusCode != 0) {
+        attributes.push_back(intAttribute("http.response.status_code", span.statusCode));
+    }
+    attributes.push_back(intAttribute("http.request.body.size", span.stats.uploadSize));
+    attributes.push_back(intAttribute("http.response.body.size", span.stats.downloadSize));
+    if (!span.error.empty()) {
+        attributes.push_back(stringAttribute("error.type", span.error));
+    }
+
+    // 各阶段为自开始起的累计耗时，转换为事件时间；连接复用时为0的阶段省略
+    Json events = Json::array();
+    auto phase = [&](const char* name, double millis) {
+        if (millis > 0) {
+            auto offset = std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                std::chrono::duration<double, std::milli>(millis));
+            events.push_back({{"timeUnixNano", unixNanos(span.startTime + offset)}, {"name", name}});
+        }
+    };
+    phase("dns", span.stats.nameLookupTime);
+    phase("connect", span.stats.connectTime);
+    phase("tls", span.stats.appConnectTime);
+    phase("first_byte", span.stats.startTransferTime);
+
+    Json status = Json::object();
+    if (!span.error.empty() || span.statusCode >= 500) {
+        status["code"] = 2; // STATUS_CODE_ERROR
+        status["message"] = span.error.empty() ? "HTTP " + std::to_string(span.statusCode) : span.error;
+    }
+
+    Json result = {
+        {"traceId", span.context.traceId},
+        {"spanId", span.context.spanId},
+        {"name", span.name},
+        {"kind", 3}, // SPAN_KIND_CLIENT
+        {"startTimeUnixNano", unixNanos(span.startTime)},
+        {"endTimeUnixNano", unixNanos(span.endTime)},
+        {"attributes", std::move(attributes)},
+        {"events", std::move(events)},
+        {"status", std::move(status)}
+    };
+    if (!span.parentSpanId.empty()) {
+        result["parentSpanId"] = span.parentSpanId;
+    }
+    if (!span.context.traceState.empty()) {
+        result["traceState"] = span.context.traceState;
+    }
+    return result;
+}
+
+Json toOtlpJson(const std::vector<TraceSpan>& spans, const std::string& serviceName) {
+    Json otlpSpans = Json::array();
+    for (const auto& span : spans) {
+        otlpSpans.push_back(otlpSpan(span));
+    }
+    return {
+        {"resourceSpans", Json::array({{
+            {"resource", {{"attributes", Json::array({stringAttribute("service.name", serviceName)})}}},
+            {"scopeSpans", Json::array({{
+                {"scope", {{"name", "dataapi-cpp-sdk"}}},
+                {"spans", std::move(otlpSpans)}
+            }})}
+        }})}
+    };
+}
+
+} // namespace http
+} // namespace dataapi
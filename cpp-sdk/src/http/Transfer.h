@@ -0,0 +1,139 @@
+#pragma once
+
+#include <curl/curl.h>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory_resource>
+#include <memory>
+#include <string>
+#include <vector>
+#include "dataapi/Types.h"
+#include "dataapi/http/HttpClient.h"
+#include "dataapi/http/Tracing.h"
+#include "dataapi/http/LoadBalancer.h"
+#include "http/RequestLogger.h"
+
+namespace dataapi {
+namespace http {
+namespace detail {
+
+// curl_slist的RAII释放器
+struct SlistDeleter {
+    void operator()(curl_slist* list) const {
+        curl_slist_free_all(list);
+    }
+};
+using SlistPtr = std::unique_ptr<curl_slist, SlistDeleter>;
+
+/**
+ * HTTP方法名，用于日志和span
+ */
+inline const char* methodName(HttpMethod method) {
+    switch (method) {
+        case HttpMethod::GET: return "GET";
+        case HttpMethod::POST: return "POST";
+        case HttpMethod::PUT: return "PUT";
+        case HttpMethod::DELETE: return "DELETE";
+        case HttpMethod::PATCH: return "PATCH";
+        case HttpMethod::HEAD: return "HEAD";
+    }
+    return "UNKNOWN";
+}
+
+/**
+ * 预格式化的客户端级请求头部
+ * 认证头部和默认头部只在认证信息或配置变化时格式化一次，之后所有请求只读共享
+ */
+struct HeaderBlock {
+    std::shared_ptr<const ClientState> state; // 生成时的配置快照
+    uint64_t revision = 0;                    // 生成时的认证信息版本号
+    SlistPtr headers;                // 认证头部 + 默认头部
+    SlistPtr jsonHeaders;            // 同上，附加Content-Type: application/json
+    std::vector<std::pair<std::string, std::string>> fields; // headers中的名称和值，用于判断请求级头部是否覆盖及可替换传输层
+    size_t authCount = 0;            // fields中前authCount项来自认证提供者，记录日志时替换为[REDACTED]
+};
+
+/**
+ * 线程内复用的请求体缓冲区
+ * 传输开始时取走，结束时归还，避免每次请求重新分配；超过上限的缓冲区不保留
+ */
+inline std::string& spareBodyBuffer() {
+    thread_local std::string buffer;
+    return buffer;
+}
+
+constexpr size_t kMaxSpareBodyCapacity = 1 << 20;
+
+/**
+ * 单次传输的内部状态
+ * 持有在curl执行期间必须保持有效的所有缓冲区，同步和异步路径共用
+ */
+struct Transfer {
+    CURL* curl;
+    bool ownsHandle;
+    std::shared_ptr<const ClientState> state; // 本次请求使用的配置快照
+    std::pmr::string url; // 完整URL，同步请求时分配在RequestArena中
+    HttpMethod method = HttpMethod::GET;
+    std::string endpoint; // 指标使用的端点模板
+    int timeoutMs = 0;
+    size_t slot = 0;                         // 选择后端地址的槽位，池中句柄固定，异步请求轮换
+    std::shared_ptr<HostResolver> resolver;  // 分散连接时选择地址的缓存，未分散时为空
+    uint64_t avoidEndpoints = 0;             // 选择端点时尽量避开的端点（位掩码）
+    LoadBalancer::Lease endpointLease;       // 本次传输使用的端点，未配置多端点时为空
+    std::string host;
+    std::string address;                     // 本次连接的后端地址
+    SlistPtr connectTo;
+    std::string body;                      // 由data序列化得到的请求体
+    const std::string* payload = nullptr;  // 实际发送的请求体，指向body或请求配置中的body
+    // 流式请求体：bodyReader非空时由READFUNCTION按需拉取，长度未知，HTTP/1.1下使用分块传输
+    std::function<size_t(char* buffer, size_t size)> bodyReader;
+    std::exception_ptr readError;
+    bool upload = false;                     // bodyReader由调用方提供（HttpClient::upload）
+    int64_t uploadLength = -1;               // 上传请求体长度，-1表示未知
+    uint64_t uploadedBytes = 0;              // 已从上传来源读取的字节数
+    const UploadProgress* onProgress = nullptr;
+    std::shared_ptr<const std::atomic<bool>> cancel; // 由进度回调检查的取消标志
+    bool cancelled = false;
+    // 请求头：headerList为请求级头部，headerTail非空时其next指向headerBlock中共享的头部链表
+    std::shared_ptr<const HeaderBlock> headerBlock;
+    SlistPtr headerList;
+    curl_slist* headerTail = nullptr;
+    std::string responseBody;
+    ResponseHeaders responseHeaders;
+    
+    // 流式响应体：sink非空时成功响应的数据直接交给sink，不写入responseBody
+    enum class SinkMode { Undecided, Stream, Buffer };
+    const BodySink* sink = nullptr;
+    const StreamStart* onStart = nullptr;
+    SinkMode sinkMode = SinkMode::Undecided;
+    std::exception_ptr sinkError;
+    
+    std::unique_ptr<LogRecord> log; // 本次请求的日志记录，未记录时为空
+    std::unique_ptr<TraceSpan> span;     // 本次传输的客户端span，未追踪时为空
+
+    Transfer(CURL* curl, bool ownsHandle, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : curl(curl), ownsHandle(ownsHandle), url(resource) {}
+
+    ~Transfer() {
+        // 断开与共享头部链表的连接，避免释放请求级头部时一并释放
+        if (headerTail) {
+            headerTail->next = nullptr;
+        }
+        if (ownsHandle && curl) {
+            curl_easy_cleanup(curl);
+        }
+        std::string& spare = spareBodyBuffer();
+        if (body.capacity() > spare.capacity() && body.capacity() <= kMaxSpareBodyCapacity) {
+            body.clear();
+            spare.swap(body);
+        }
+    }
+
+    Transfer(const Transfer&) = delete;
+    Transfer& operator=(const Transfer&) = delete;
+};
+
+} // namespace detail
+} // namespace http
+} // namespace dataapi
@@ -0,0 +1,54 @@
+#include "dataapi/http/Transport.h"
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+namespace dataapi {
+namespace http {
+
+std::string_view TransportRequest::target() const {
+    std::string_view view(url);
+    size_t scheme = view.find("://");
+    if (scheme == std::string_view::npos) {
+        return view;
+    }
+    size_t path = view.find_first_of("/?", scheme + 3);
+    return path == std::string_view::npos ? std::string_view("/") : view.substr(path);
+}
+
+std::string_view TransportRequest::header(std::string_view name) const {
+    for (const auto& field : headers) {
+        if (field.first.size() == name.size() &&
+            std::equal(name.begin(), name.end(), field.first.begin(), [](char a, char b) {
+                return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+            })) {
+            return field.second;
+        }
+    }
+    return {};
+}
+
+void Transport::sendAsync(const TransportRequest& request, ResponseCallback callback) {
+    HttpResponse response;
+    std::exception_ptr error;
+    try {
+        response = send(request);
+    } catch (...) {
+        error = std::current_exception();
+    }
+    callback(std::move(response), error);
+}
+
+InMemoryTransport::InMemoryTransport(Handler handler) : handler(std::move(handler)) {
+    if (!this->handler) {
+        throw std::invalid_argument("InMemoryTransport requires a handler");
+    }
+}
+
+HttpResponse InMemoryTransport::send(const TransportRequest& request) {
+    requestCount.fetch_add(1, std::memory_order_relaxed);
+    return handler(request);
+}
+
+} // namespace http
+} // namespace dataapi
@@ -0,0 +1,124 @@
+#include "dataapi/http/UploadBody.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace dataapi {
+namespace http {
+
+static std::runtime_error fileError(const char* action, const std::string& path) {
+    return std::runtime_error(std::string("Failed to ") + action + " file " + path + ": " + std::strerror(errno));
+}
+
+/**
+ * 只读文件描述符，析构时关闭
+ */
+struct FileHandle {
+    int fd;
+    explicit FileHandle(const std::string& path) : fd(::open(path.c_str(), O_RDONLY | O_CLOEXEC)) {
+        if (fd < 0) {
+            throw fileError("open", path);
+        }
+    }
+    ~FileHandle() {
+        ::close(fd);
+    }
+    FileHandle(const FileHandle&) = delete;
+    FileHandle& operator=(const FileHandle&) = delete;
+};
+
+/**
+ * 只读内存映射，析构时解除
+ */
+struct Mapping {
+    void* data = nullptr;
+    size_t size = 0;
+    ~Mapping() {
+        if (data) {
+            ::munmap(data, size);
+        }
+    }
+};
+
+// 按区间复制数据的来源，offset随读取推进
+static BodySource spanSource(const char* data, size_t size, std::shared_ptr<const void> owner = nullptr) {
+    return [data, size, owner = std::move(owner), offset = size_t(0)](char* buffer, size_t capacity) mutable {
+        size_t count = std::min(capacity, size - offset);
+        if (count > 0) {
+            std::memcpy(buffer, data + offset, count);
+            offset += count;
+        }
+        return count;
+    };
+}
+
+UploadBody memoryBody(std::string_view data) {
+    UploadBody body;
+    body.source = spanSource(data.data(), data.size());
+    body.length = static_cast<int64_t>(data.size());
+    return body;
+}
+
+UploadBody fileBody(const std::string& path) {
+    auto file = std::make_shared<FileHandle>(path);
+    struct stat info;
+    if (::fstat(file->fd, &info) != 0) {
+        throw fileError("stat", path);
+    }
+#ifdef POSIX_FADV_SEQUENTIAL
+    ::posix_fadvise(file->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    UploadBody body;
+    // 管道等非普通文件长度未知
+    body.length = S_ISREG(info.st_mode) ? static_cast<int64_t>(info.st_size) : -1;
+    body.source = [file, path](char* buffer, size_t size) {
+        for (;;) {
+            ssize_t count = ::read(file->fd, buffer, size);
+            if (count >= 0) {
+                return static_cast<size_t>(count);
+            }
+            if (errno != EINTR) {
+                throw fileError("read", path);
+            }
+        }
+    };
+    return body;
+}
+
+UploadBody mappedFileBody(const std::string& path) {
+    FileHandle file(path);
+    struct stat info;
+    if (::fstat(file.fd, &info) != 0) {
+        throw fileError("stat", path);
+    }
+    if (!S_ISREG(info.st_mode)) {
+        throw std::runtime_error("Failed to map file " + path + ": not a regular file");
+    }
+
+    auto mapping = std::make_shared<Mapping>();
+    mapping->size = static_cast<size_t>(info.st_size);
+    if (mapping->size > 0) {
+        // 映射建立后即可关闭描述符
+        void* data = ::mmap(nullptr, mapping->size, PROT_READ, MAP_PRIVATE, file.fd, 0);
+        if (data == MAP_FAILED) {
+            throw fileError("map", path);
+        }
+        mapping->data = data;
+        ::madvise(data, mapping->size, MADV_SEQUENTIAL);
+    }
+
+    UploadBody body;
+    body.source = spanSource(static_cast<const char*>(mapping->data), mapping->size, mapping);
+    body.length = static_cast<int64_t>(mapping->size);
+    return body;
+}
+
+} // namespace http
+} // namespace dataapi
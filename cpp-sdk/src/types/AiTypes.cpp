@@ -105,6 +105,22 @@ void from_json(const Json& j, AiProviderConfig& a) {
     j.at("settings").get_to(a.settings);
 }
 
+// AiProviderUpdateRequest JSON serialization
+void to_json(Json& j, const AiProviderUpdateRequest& a) {
+    j = Json{
+        {"name", a.name},
+        {"config", a.config}
+    };
+}
+
+// AiModel JSON deserialization
+void from_json(const Json& j, AiModel& a) {
+    j.at("id").get_to(a.id);
+    a.name = j.value("name", a.id);
+    a.provider = j.value("provider", "");
+    a.capabilities = j.contains("capabilities") ? j["capabilities"] : Json();
+}
+
 // AiServiceRequest JSON serialization
 void to_json(Json& j, const AiServiceRequest& a) {
     j = Json{
@@ -135,4 +151,81 @@ void from_json(const Json& j, AiServiceResponse& a) {
     j.at("requestId").get_to(a.requestId);
 }
 
+// AiUsageStatistics JSON deserialization
+void from_json(const Json& j, AiUsageStatistics& a) {
+    a.totalRequests = j.value("totalRequests", 0);
+    a.totalTokens = j.value("totalTokens", 0);
+    a.totalCost = j.value("totalCost", 0.0);
+    a.breakdown = j.contains("breakdown") ? j["breakdown"] : Json();
+}
+
+// AiQuotaInfo JSON deserialization
+void from_json(const Json& j, AiQuotaInfo& a) {
+    a.remainingRequests = j.value("remainingRequests", 0);
+    a.remainingTokens = j.value("remainingTokens", 0);
+    if (j.contains("resetTime") && j["resetTime"].is_number()) {
+        auto resetTimeMs = j["resetTime"].get<int64_t>();
+        a.resetTime = std::chrono::system_clock::time_point(std::chrono::milliseconds(resetTimeMs));
+    }
+}
+
+// AiQuotaSettings JSON serialization
+void to_json(Json& j, const AiQuotaSettings& a) {
+    j = Json{
+        {"maxRequests", a.maxRequests},
+        {"maxTokens", a.maxTokens},
+        {"period", a.period},
+        {"restrictions", a.restrictions}
+    };
+}
+
+// EmbeddingResult JSON deserialization
+void from_json(const Json& j, EmbeddingResult& a) {
+    // 保持目标已设定的存储精度
+    EmbeddingMatrix embeddings(a.embeddings.precision());
+    const Json& rows = j.at("embeddings");
+    embeddings.reserve(rows.size());
+    std::vector<float> row;
+    for (const auto& values : rows) {
+        row.clear();
+        for (const auto& value : values) {
+            row.push_back(value.get<float>());
+        }
+        embeddings.appendRow(row);
+    }
+    a.embeddings = std::move(embeddings);
+    a.model = j.value("model", "");
+    a.usage = j.value("usage", Json());
+    a.metadata = j.value("metadata", Json());
+}
+
+// ImageGenerationResult JSON deserialization
+void from_json(const Json& j, ImageGenerationResult& a) {
+    a.urls = j.value("urls", std::vector<std::string>());
+    a.model = j.value("model", "");
+    a.metadata = j.value("metadata", Json());
+}
+
+// ImageAnalysisResult JSON deserialization
+void from_json(const Json& j, ImageAnalysisResult& a) {
+    a.description = j.value("description", "");
+    a.objects = j.value("objects", std::vector<Json>());
+    a.model = j.value("model", "");
+    a.metadata = j.value("metadata", Json());
+}
+
+// SpeechToTextResult JSON deserialization
+void from_json(const Json& j, SpeechToTextResult& a) {
+    a.text = j.value("text", "");
+    a.language = j.value("language", "");
+    a.metadata = j.value("metadata", Json());
+}
+
+// TextToSpeechResult JSON deserialization
+void from_json(const Json& j, TextToSpeechResult& a) {
+    a.audioUrl = j.value("audioUrl", "");
+    a.format = j.value("format", "");
+    a.metadata = j.value("metadata", Json());
+}
+
 } // namespace dataapi
\ No newline at end of file
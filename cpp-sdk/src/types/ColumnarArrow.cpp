@@ -0,0 +1,106 @@
+#include "dataapi/types/ColumnarResult.h"
+#include <arrow/api.h>
+#include <cstring>
+#include <stdexcept>
+
+namespace dataapi {
+
+template<typename T>
+static T unwrap(arrow::Result<T> result) {
+    if (!result.ok()) {
+        throw std::runtime_error("Arrow export failed: " + result.status().ToString());
+    }
+    return std::move(result).ValueUnsafe();
+}
+
+static void check(const arrow::Status& status) {
+    if (!status.ok()) {
+        throw std::runtime_error("Arrow export failed: " + status.ToString());
+    }
+}
+
+static std::shared_ptr<arrow::Buffer> copyBuffer(const void* data, size_t size) {
+    std::shared_ptr<arrow::Buffer> buffer = unwrap(arrow::AllocateBuffer(static_cast<int64_t>(size)));
+    if (size > 0) {
+        std::memcpy(buffer->mutable_data(), data, size);
+    }
+    return buffer;
+}
+
+static std::shared_ptr<arrow::Buffer> validityBuffer(const Column& column) {
+    if (column.getNullCount() == 0) {
+        return nullptr;
+    }
+    const auto& bits = column.getValidity();
+    return copyBuffer(bits.data(), bits.size());
+}
+
+static std::shared_ptr<arrow::Array> exportColumn(const Column& column) {
+    int64_t length = static_cast<int64_t>(column.size());
+    int64_t nullCount = static_cast<int64_t>(column.getNullCount());
+
+    switch (column.getType()) {
+        case ColumnType::Null:
+            return std::make_shared<arrow::NullArray>(length);
+        case ColumnType::Int64: {
+            const auto& values = column.int64Values();
+            auto data = arrow::ArrayData::Make(
+                arrow::int64(), length,
+                {validityBuffer(column), copyBuffer(values.data(), values.size() * sizeof(int64_t))}, nullCount);
+            return arrow::MakeArray(data);
+        }
+        case ColumnType::Double: {
+            const auto& values = column.doubleValues();
+            auto data = arrow::ArrayData::Make(
+                arrow::float64(), length,
+                {validityBuffer(column), copyBuffer(values.data(), values.size() * sizeof(double))}, nullCount);
+            return arrow::MakeArray(data);
+        }
+        case ColumnType::String: {
+            const auto& offsets = column.stringOffsets();
+            const auto& chars = column.stringData();
+            auto data = arrow::ArrayData::Make(
+                arrow::utf8(), length,
+                {validityBuffer(column),
+                 copyBuffer(offsets.data(), offsets.size() * sizeof(int32_t)),
+                 copyBuffer(chars.data(), chars.size())},
+                nullCount);
+            return arrow::MakeArray(data);
+        }
+        case ColumnType::Boolean: {
+            // Arrow的布尔值按位存储
+            arrow::BooleanBuilder builder;
+            check(builder.Reserve(length));
+            const auto& values = column.boolValues();
+            for (int64_t i = 0; i < length; ++i) {
+                if (column.isNull(static_cast<size_t>(i))) {
+                    builder.UnsafeAppendNull();
+                } else {
+                    builder.UnsafeAppend(values[static_cast<size_t>(i)] != 0);
+                }
+            }
+            return unwrap(builder.Finish());
+        }
+        case ColumnType::Json: {
+            arrow::StringBuilder builder;
+            for (const auto& value : column.jsonValues()) {
+                check(value.is_null() ? builder.AppendNull() : builder.Append(value.dump()));
+            }
+            return unwrap(builder.Finish());
+        }
+    }
+    throw std::logic_error("Unknown column type");
+}
+
+std::shared_ptr<arrow::RecordBatch> ColumnarResult::toArrow() const {
+    std::vector<std::shared_ptr<arrow::Field>> fields;
+    std::vector<std::shared_ptr<arrow::Array>> arrays;
+    for (size_t i = 0; i < names.size(); ++i) {
+        auto array = exportColumn(data[i]);
+        fields.push_back(arrow::field(names[i], array->type()));
+        arrays.push_back(std::move(array));
+    }
+    return arrow::RecordBatch::Make(arrow::schema(fields), static_cast<int64_t>(rowCount), arrays);
+}
+
+} // namespace dataapi
@@ -0,0 +1,296 @@
+#include "dataapi/types/ColumnarResult.h"
+#include <limits>
+#include <stdexcept>
+
+namespace dataapi {
+
+static ColumnType classify(const Json& value) {
+    switch (value.type()) {
+        case Json::value_t::boolean:
+            return ColumnType::Boolean;
+        case Json::value_t::number_integer:
+            return ColumnType::Int64;
+        case Json::value_t::number_unsigned:
+            return value.get<uint64_t>() <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max())
+                ? ColumnType::Int64
+                : ColumnType::Double;
+        case Json::value_t::number_float:
+            return ColumnType::Double;
+        case Json::value_t::string:
+            return ColumnType::String;
+        default:
+            return ColumnType::Json;
+    }
+}
+
+void Column::setValid(bool valid) {
+    if (length % 8 == 0) {
+        validity.push_back(0);
+    }
+    if (valid) {
+        validity.back() |= static_cast<uint8_t>(1u << (length % 8));
+    }
+}
+
+void Column::appendPlaceholder() {
+    switch (type) {
+        case ColumnType::Null:
+            break;
+        case ColumnType::Boolean:
+            bools.push_back(0);
+            break;
+        case ColumnType::Int64:
+            ints.push_back(0);
+            break;
+        case ColumnType::Double:
+            doubles.push_back(0.0);
+            break;
+        case ColumnType::String:
+            offsets.push_back(static_cast<int32_t>(chars.size()));
+            break;
+        case ColumnType::Json:
+            json.emplace_back(nullptr);
+            break;
+    }
+}
+
+void Column::becomeType(ColumnType newType) {
+    // 之前的行全部为空值，在新类型的缓冲区中补齐占位
+    type = newType;
+    for (size_t i = 0; i < length; ++i) {
+        appendPlaceholder();
+    }
+}
+
+void Column::promoteToDouble() {
+    doubles.assign(ints.begin(), ints.end());
+    std::vector<int64_t>().swap(ints);
+    type = ColumnType::Double;
+}
+
+void Column::promoteToJson() {
+    std::vector<Json> values;
+    values.reserve(length);
+    for (size_t i = 0; i < length; ++i) {
+        values.push_back(valueAt(i));
+    }
+    std::vector<uint8_t>().swap(bools);
+    std::vector<int64_t>().swap(ints);
+    std::vector<double>().swap(doubles);
+    std::string().swap(chars);
+    offsets.assign(1, 0);
+    json = std::move(values);
+    type = ColumnType::Json;
+}
+
+void Column::append(const Json& value) {
+    if (value.is_null()) {
+        appendNull();
+        return;
+    }
+
+    ColumnType kind = classify(value);
+    if (type == ColumnType::Null) {
+        becomeType(kind);
+    } else if (type != kind && type != ColumnType::Json) {
+        if (type == ColumnType::Int64 && kind == ColumnType::Double) {
+            promoteToDouble();
+        } else if (!(type == ColumnType::Double && kind == ColumnType::Int64)) {
+            promoteToJson();
+        }
+    }
+
+    switch (type) {
+        case ColumnType::Boolean:
+            bools.push_back(value.get<bool>() ? 1 : 0);
+            break;
+        case ColumnType::Int64:
+            ints.push_back(value.get<int64_t>());
+            break;
+        case ColumnType::Double:
+            doubles.push_back(value.get<double>());
+            break;
+        case ColumnType::String: {
+            const auto& text = value.get_ref<const std::string&>();
+            if (chars.size() + text.size() > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+                throw std::length_error("String column exceeds 2 GiB");
+            }
+            chars.append(text);
+            offsets.push_back(static_cast<int32_t>(chars.size()));
+            break;
+        }
+        case ColumnType::Json:
+            json.push_back(value);
+            break;
+        case ColumnType::Null:
+            break;
+    }
+    setValid(true);
+    ++length;
+}
+
+void Column::appendNull() {
+    appendPlaceholder();
+    setValid(false);
+    ++length;
+    ++nullCount;
+}
+
+void Column::typeMismatch(const char* expected) const {
+    throw std::logic_error(std::string("Column is not of type ") + expected);
+}
+
+const std::vector<int64_t>& Column::int64Values() const {
+    if (type != ColumnType::Int64) {
+        typeMismatch("Int64");
+    }
+    return ints;
+}
+
+const std::vector<double>& Column::doubleValues() const {
+    if (type != ColumnType::Double) {
+        typeMismatch("Double");
+    }
+    return doubles;
+}
+
+const std::vector<uint8_t>& Column::boolValues() const {
+    if (type != ColumnType::Boolean) {
+        typeMismatch("Boolean");
+    }
+    return bools;
+}
+
+const std::vector<Json>& Column::jsonValues() const {
+    if (type != ColumnType::Json) {
+        typeMismatch("Json");
+    }
+    return json;
+}
+
+const std::string& Column::stringData() const {
+    if (type != ColumnType::String) {
+        typeMismatch("String");
+    }
+    return chars;
+}
+
+const std::vector<int32_t>& Column::stringOffsets() const {
+    if (type != ColumnType::String) {
+        typeMismatch("String");
+    }
+    return offsets;
+}
+
+std::string_view Column::stringAt(size_t row) const {
+    if (type != ColumnType::String) {
+        typeMismatch("String");
+    }
+    return std::string_view(chars.data() + offsets[row], static_cast<size_t>(offsets[row + 1] - offsets[row]));
+}
+
+Json Column::valueAt(size_t row) const {
+    if (row >= length) {
+        throw std::out_of_range("Column row out of range");
+    }
+    if (isNull(row)) {
+        return nullptr;
+    }
+    switch (type) {
+        case ColumnType::Boolean:
+            return bools[row] != 0;
+        case ColumnType::Int64:
+            return ints[row];
+        case ColumnType::Double:
+            return doubles[row];
+        case ColumnType::String:
+            return std::string(stringAt(row));
+        case ColumnType::Json:
+            return json[row];
+        case ColumnType::Null:
+            break;
+    }
+    return nullptr;
+}
+
+ColumnarResult::ColumnarResult(const std::vector<std::string>& columns) {
+    setColumns(columns);
+}
+
+void ColumnarResult::setColumns(const std::vector<std::string>& columns) {
+    if (rowCount > 0) {
+        throw std::logic_error("Columns must be set before appending rows");
+    }
+    names.clear();
+    index.clear();
+    data.clear();
+    for (const auto& name : columns) {
+        addColumn(name);
+    }
+}
+
+size_t ColumnarResult::addColumn(const std::string& name) {
+    size_t position = names.size();
+    names.push_back(name);
+    index.emplace(name, position);
+    data.emplace_back();
+    for (size_t i = 0; i < rowCount; ++i) {
+        data.back().appendNull();
+    }
+    return position;
+}
+
+void ColumnarResult::appendRow(const Json& row) {
+    if (row.is_object()) {
+        size_t matched = 0;
+        for (size_t i = 0; i < names.size(); ++i) {
+            auto it = row.find(names[i]);
+            if (it == row.end()) {
+                data[i].appendNull();
+            } else {
+                data[i].append(*it);
+                ++matched;
+            }
+        }
+        if (matched < row.size()) {
+            for (const auto& item : row.items()) {
+                if (index.find(item.key()) == index.end()) {
+                    data[addColumn(item.key())].append(item.value());
+                }
+            }
+        }
+    } else if (row.is_array()) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            if (i >= names.size()) {
+                addColumn("column" + std::to_string(i));
+            }
+            data[i].append(row[i]);
+        }
+        for (size_t i = row.size(); i < names.size(); ++i) {
+            data[i].appendNull();
+        }
+    } else {
+        throw std::invalid_argument("Query row must be an object or an array");
+    }
+    ++rowCount;
+}
+
+const Column& ColumnarResult::column(const std::string& name) const {
+    auto it = index.find(name);
+    if (it == index.end()) {
+        throw std::out_of_range("Column not found: " + name);
+    }
+    return data[it->second];
+}
+
+ColumnarResult ColumnarResult::fromQueryResult(const QueryResult& result) {
+    ColumnarResult columnar(result.columns);
+    for (const auto& row : result.rows) {
+        columnar.appendRow(row);
+    }
+    columnar.totalRows = result.totalRows;
+    columnar.metadata = result.metadata;
+    return columnar;
+}
+
+} // namespace dataapi
@@ -1,6 +1,7 @@
 #include "dataapi/types/CommonTypes.h"
 #include <chrono>
 #include <cstdint>
+#include <stdexcept>
 
 namespace dataapi {
 
@@ -8,4 +9,33 @@ namespace dataapi {
 // 由于CommonTypes.h主要包含模板和基础类型定义，
 // 大部分序列化函数已经在头文件中实现
 
+// TokenResponse JSON deserialization
+void from_json(const Json& j, TokenResponse& t) {
+    auto field = [&j](const char* snake, const char* camel) -> const Json* {
+        for (const char* name : {snake, camel}) {
+            auto it = j.find(name);
+            if (it != j.end() && !it->is_null()) {
+                return &*it;
+            }
+        }
+        return nullptr;
+    };
+    
+    const Json* accessToken = field("access_token", "accessToken");
+    if (!accessToken) {
+        throw std::invalid_argument("Token response has no access token");
+    }
+    accessToken->get_to(t.accessToken);
+    if (const Json* refreshToken = field("refresh_token", "refreshToken")) {
+        t.refreshToken = refreshToken->get<std::string>();
+    }
+    if (const Json* expiresIn = field("expires_in", "expiresIn")) {
+        // 部分服务端以字符串返回有效期
+        t.expiresIn = expiresIn->is_string() ? std::stoi(expiresIn->get<std::string>()) : expiresIn->get<int>();
+    }
+    if (const Json* tokenType = field("token_type", "tokenType")) {
+        t.tokenType = tokenType->get<std::string>();
+    }
+}
+
 } // namespace dataapi
\ No newline at end of file
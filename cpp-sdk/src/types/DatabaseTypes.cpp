@@ -39,6 +39,13 @@ void from_json(const Json& j, QueryResult& q) {
     j.at("metadata").get_to(q.metadata);
 }
 
+void from_json(Json&& j, QueryResult& q) {
+    q.rows = std::move(j.at("rows").get_ref<Json::array_t&>());
+    j.at("columns").get_to(q.columns);
+    j.at("totalRows").get_to(q.totalRows);
+    q.metadata = std::move(j.at("metadata"));
+}
+
 // SqlExecutionResult JSON serialization
 void to_json(Json& j, const SqlExecutionResult& s) {
     j = Json{{"success", s.success}};
@@ -115,4 +122,57 @@ void from_json(const Json& j, DatabaseInfo& d) {
     }
 }
 
+// DatabaseUpdateRequest JSON serialization
+void to_json(Json& j, const DatabaseUpdateRequest& d) {
+    j = Json{
+        {"name", d.name},
+        {"config", d.config}
+    };
+}
+
+// TableInfo JSON deserialization
+void from_json(const Json& j, TableInfo& t) {
+    j.at("name").get_to(t.name);
+    t.schema = j.value("schema", "");
+    t.rowCount = j.value("rowCount", 0);
+    t.metadata = j.contains("metadata") ? j["metadata"] : Json();
+}
+
+// TableSchema JSON deserialization
+void from_json(const Json& j, TableSchema& t) {
+    j.at("tableName").get_to(t.tableName);
+    j.at("columns").get_to(t.columns);
+    t.indexes = j.value("indexes", std::vector<Json>());
+}
+
+// DatabaseMetrics JSON deserialization
+void from_json(const Json& j, DatabaseMetrics& m) {
+    m.connectionCount = j.value("connectionCount", 0);
+    m.cpuUsage = j.value("cpuUsage", 0.0);
+    m.memoryUsage = j.value("memoryUsage", 0.0);
+    m.diskUsage = j.value("diskUsage", 0.0);
+    m.queryCount = j.value("queryCount", 0);
+    m.averageQueryTime = j.value("averageQueryTime", 0.0);
+    m.details = j.contains("details") ? j["details"] : Json();
+}
+
+// BatchResult JSON deserialization
+void from_json(const Json& j, BatchResult& b) {
+    from_json(Json(j), b);
+}
+
+void from_json(Json&& j, BatchResult& b) {
+    b.results.clear();
+    if (j.contains("results") && j["results"].is_array()) {
+        auto& results = j["results"].get_ref<Json::array_t&>();
+        b.results.reserve(results.size());
+        for (auto& item : results) {
+            b.results.push_back(std::move(item));
+        }
+    }
+    b.successCount = j.value("successCount", 0);
+    b.errorCount = j.value("errorCount", 0);
+    b.errors = j.contains("errors") ? std::move(j["errors"]) : Json();
+}
+
 } // namespace dataapi
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "dataapi/types/EmbeddingMatrix.h"
+#include <cstring>
+#include <string>
+
+namespace dataapi {
+
+uint16_t floatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    uint32_t exponent = (bits >> 23) & 0xffu;
+    uint32_t mantissa = bits & 0x7fffffu;
+
+    if (exponent == 0xff) {
+        // 无穷大保持，NaN保留为静默NaN
+        return static_cast<uint16_t>(sign | 0x7c00u | (mantissa ? 0x200u : 0));
+    }
+    int biased = static_cast<int>(exponent) - 127 + 15;
+    if (biased >= 31) {
+        return static_cast<uint16_t>(sign | 0x7c00u);
+    }
+    if (biased <= 0) {
+        // 半精度非规格化数
+        if (biased < -10) {
+            return static_cast<uint16_t>(sign);
+        }
+        mantissa |= 0x800000u;
+        int shift = 14 - biased;
+        uint32_t half = mantissa >> shift;
+        uint32_t rest = mantissa & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (rest > halfway || (rest == halfway && (half & 1))) {
+            ++half;
+        }
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    uint32_t half = (static_cast<uint32_t>(biased) << 10) | (mantissa >> 13);
+    uint32_t rest = mantissa & 0x1fffu;
+    if (rest > 0x1000u || (rest == 0x1000u && (half & 1))) {
+        ++half; // 进位可能进入指数位，溢出时恰好得到无穷大
+    }
+    return static_cast<uint16_t>(sign | half);
+}
+
+float halfToFloat(uint16_t value) {
+    uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+    uint32_t exponent = (value >> 10) & 0x1fu;
+    uint32_t mantissa = value & 0x3ffu;
+    uint32_t bits;
+
+    if (exponent == 0) {
+        if (mantissa == 0) {
+            bits = sign;
+        } else {
+            int shift = 0;
+            while (!(mantissa & 0x400u)) {
+                mantissa <<= 1;
+                ++shift;
+            }
+            bits = sign | (static_cast<uint32_t>(113 - shift) << 23) | ((mantissa & 0x3ffu) << 13);
+        }
+    } else if (exponent == 31) {
+        bits = sign | 0x7f800000u | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+void EmbeddingMatrix::appendRow(const float* row, size_t count) {
+    if (rowCount == 0) {
+        columns = count;
+    } else if (count != columns) {
+        throw std::invalid_argument("Embedding dimension mismatch: expected " + std::to_string(columns) +
+                                    ", got " + std::to_string(count));
+    }
+    if (precisionValue == EmbeddingPrecision::Float32) {
+        values.insert(values.end(), row, row + count);
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            halves.push_back(floatToHalf(row[i]));
+        }
+    }
+    ++rowCount;
+}
+
+void EmbeddingMatrix::reserve(size_t rows) {
+    if (columns == 0) {
+        return;
+    }
+    if (precisionValue == EmbeddingPrecision::Float32) {
+        values.reserve(rows * columns);
+    } else {
+        halves.reserve(rows * columns);
+    }
+}
+
+const float* EmbeddingMatrix::data() const {
+    if (precisionValue != EmbeddingPrecision::Float32) {
+        throw std::logic_error("Embedding matrix is stored as float16");
+    }
+    return values.data();
+}
+
+const uint16_t* EmbeddingMatrix::halfData() const {
+    if (precisionValue != EmbeddingPrecision::Float16) {
+        throw std::logic_error("Embedding matrix is stored as float32");
+    }
+    return halves.data();
+}
+
+float EmbeddingMatrix::at(size_t row, size_t column) const {
+    if (row >= rowCount || column >= columns) {
+        throw std::out_of_range("Embedding index out of range");
+    }
+    size_t index = row * columns + column;
+    return precisionValue == EmbeddingPrecision::Float32 ? values[index] : halfToFloat(halves[index]);
+}
+
+std::vector<float> EmbeddingMatrix::toVector(size_t row) const {
+    if (row >= rowCount) {
+        throw std::out_of_range("Embedding index out of range");
+    }
+    size_t begin = row * columns;
+    if (precisionValue == EmbeddingPrecision::Float32) {
+        return std::vector<float>(values.begin() + begin, values.begin() + begin + columns);
+    }
+    std::vector<float> vector(columns);
+    for (size_t i = 0; i < columns; ++i) {
+        vector[i] = halfToFloat(halves[begin + i]);
+    }
+    return vector;
+}
+
+} // namespace dataapi
@@ -99,4 +99,46 @@ void from_json(const Json& j, ProjectUpdateRequest& p) {
     }
 }
 
+// ImportResult JSON deserialization
+void from_json(const Json& j, ImportResult& r) {
+    // 成功响应可能省略success字段
+    r.success = j.value("success", true);
+    r.message = j.value("message", "");
+    r.details = j.contains("details") ? j["details"] : Json();
+}
+
+// ProjectConfig JSON serialization
+void to_json(Json& j, const ProjectConfig& c) {
+    j = Json{
+        {"settings", c.settings},
+        {"permissions", c.permissions}
+    };
+}
+
+void from_json(const Json& j, ProjectConfig& c) {
+    c.settings = j.contains("settings") ? j["settings"] : Json::object();
+    c.permissions = j.contains("permissions") ? j["permissions"] : Json::object();
+}
+
+// ProjectPermission JSON serialization
+void to_json(Json& j, const ProjectPermission& p) {
+    j = Json{
+        {"action", p.action},
+        {"allowed", p.allowed}
+    };
+}
+
+void from_json(const Json& j, ProjectPermission& p) {
+    j.at("action").get_to(p.action);
+    p.allowed = j.value("allowed", true);
+}
+
+// ProjectStatistics JSON deserialization
+void from_json(const Json& j, ProjectStatistics& s) {
+    s.totalWorkflows = j.value("totalWorkflows", 0);
+    s.totalExecutions = j.value("totalExecutions", 0);
+    s.totalMembers = j.value("totalMembers", 0);
+    s.details = j.contains("details") ? j["details"] : Json();
+}
+
 } // namespace dataapi
\ No newline at end of file
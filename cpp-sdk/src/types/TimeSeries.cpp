@@ -0,0 +1,224 @@
+#include "dataapi/types/TimeSeries.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace dataapi {
+
+static constexpr double kMissing = std::numeric_limits<double>::quiet_NaN();
+
+Span<double> TimeSeries::getValues(std::string_view field) const {
+    for (size_t i = 0; i < fields.size(); ++i) {
+        if (fields[i] == field) {
+            return Span<double>(columns[i].data(), columns[i].size());
+        }
+    }
+    return Span<double>();
+}
+
+int64_t TimeSeries::lastTimestamp() const {
+    return timestamps.empty() ? std::numeric_limits<int64_t>::min() : timestamps.back();
+}
+
+size_t TimeSeries::fieldIndex(std::string_view field) {
+    for (size_t i = 0; i < fields.size(); ++i) {
+        if (fields[i] == field) {
+            return i;
+        }
+    }
+    fields.emplace_back(field);
+    columns.emplace_back(timestamps.size(), kMissing);
+    return fields.size() - 1;
+}
+
+void TimeSeries::appendPoint(int64_t timestamp) {
+    if (!timestamps.empty() && timestamp <= timestamps.back()) {
+        throw std::invalid_argument("Time series timestamps must be strictly increasing");
+    }
+    timestamps.push_back(timestamp);
+    for (auto& column : columns) {
+        column.push_back(kMissing);
+    }
+}
+
+void TimeSeries::setValue(std::string_view field, double value) {
+    if (timestamps.empty()) {
+        throw std::logic_error("Time series has no point to set a value on");
+    }
+    columns[fieldIndex(field)].back() = value;
+}
+
+void TimeSeries::append(const TimeSeries& other) {
+    // 跳过与本序列重叠的部分
+    size_t first = static_cast<size_t>(
+        std::upper_bound(other.timestamps.begin(), other.timestamps.end(), lastTimestamp()) - other.timestamps.begin());
+    if (first == other.timestamps.size()) {
+        return;
+    }
+    size_t previous = timestamps.size();
+    timestamps.insert(timestamps.end(), other.timestamps.begin() + static_cast<std::ptrdiff_t>(first), other.timestamps.end());
+    for (auto& column : columns) {
+        column.resize(timestamps.size(), kMissing);
+    }
+    for (size_t i = 0; i < other.fields.size(); ++i) {
+        std::vector<double>& column = columns[fieldIndex(other.fields[i])];
+        std::copy(other.columns[i].begin() + static_cast<std::ptrdiff_t>(first), other.columns[i].end(),
+                  column.begin() + static_cast<std::ptrdiff_t>(previous));
+    }
+}
+
+void TimeSeries::truncateFrom(int64_t timestamp) {
+    size_t keep = static_cast<size_t>(
+        std::lower_bound(timestamps.begin(), timestamps.end(), timestamp) - timestamps.begin());
+    timestamps.resize(keep);
+    for (auto& column : columns) {
+        column.resize(keep);
+    }
+}
+
+void TimeSeries::dropBefore(int64_t timestamp) {
+    auto count = std::lower_bound(timestamps.begin(), timestamps.end(), timestamp) - timestamps.begin();
+    timestamps.erase(timestamps.begin(), timestamps.begin() + count);
+    for (auto& column : columns) {
+        column.erase(column.begin(), column.begin() + count);
+    }
+}
+
+namespace {
+
+/**
+ * SAX解析列式响应，数值直接写入列数组
+ * depth为当前打开的容器层数：顶层对象为1，timestamps数组和values对象为2，各字段的数组为3；
+ * 其余顶层字段的内容整体跳过
+ */
+class SeriesHandler : public nlohmann::json_sax<Json> {
+public:
+    std::vector<int64_t> timestamps;
+    std::vector<std::string> fields;
+    std::vector<std::vector<double>> columns;
+
+    bool null() override {
+        if (skipping()) {
+            return true;
+        }
+        return inColumn() ? (columns.back().push_back(kMissing), true) : fail();
+    }
+    bool boolean(bool) override {
+        return skipping() || fail();
+    }
+    bool number_integer(number_integer_t value) override {
+        return number(static_cast<double>(value), value);
+    }
+    bool number_unsigned(number_unsigned_t value) override {
+        return number(static_cast<double>(value), static_cast<int64_t>(value));
+    }
+    bool number_float(number_float_t value, const string_t&) override {
+        return number(value, static_cast<int64_t>(value));
+    }
+    bool string(string_t&) override {
+        return skipping() || fail();
+    }
+    bool binary(binary_t&) override {
+        return skipping() || fail();
+    }
+    bool start_object(std::size_t) override {
+        if (depth == 0 || skipping() || (section == Section::Values && depth == 1)) {
+            ++depth;
+            return true;
+        }
+        return fail();
+    }
+    bool end_object() override {
+        --depth;
+        return true;
+    }
+    bool start_array(std::size_t) override {
+        if (skipping() || (section == Section::Timestamps && depth == 1) || (section == Section::Values && depth == 2)) {
+            if (section == Section::Values && depth == 2) {
+                columns.back().reserve(timestamps.size());
+            }
+            ++depth;
+            return true;
+        }
+        return fail();
+    }
+    bool end_array() override {
+        --depth;
+        return true;
+    }
+    bool key(string_t& name) override {
+        if (depth == 1) {
+            section = name == "timestamps" ? Section::Timestamps
+                : name == "values" ? Section::Values
+                : Section::Other;
+        } else if (section == Section::Values && depth == 2) {
+            fields.push_back(name);
+            columns.emplace_back();
+        }
+        return true;
+    }
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) override {
+        return fail();
+    }
+
+private:
+    enum class Section { None, Timestamps, Values, Other };
+
+    bool number(double value, int64_t integer) {
+        if (skipping()) {
+            return true;
+        }
+        if (section == Section::Timestamps && depth == 2) {
+            timestamps.push_back(integer);
+            return true;
+        }
+        return inColumn() ? (columns.back().push_back(value), true) : fail();
+    }
+
+    bool skipping() const {
+        return section == Section::Other && depth >= 1;
+    }
+
+    bool inColumn() const {
+        return section == Section::Values && depth == 3;
+    }
+
+    [[noreturn]] static bool fail() {
+        throw std::invalid_argument("Unexpected time series response structure");
+    }
+
+    int depth = 0;
+    Section section = Section::None;
+};
+
+} // namespace
+
+TimeSeries TimeSeries::parse(std::string_view json) {
+    SeriesHandler handler;
+    nlohmann::json::sax_parse(json.begin(), json.end(), &handler);
+
+    TimeSeries series;
+    for (size_t i = 1; i < handler.timestamps.size(); ++i) {
+        if (handler.timestamps[i] <= handler.timestamps[i - 1]) {
+            throw std::invalid_argument("Time series timestamps must be strictly increasing");
+        }
+    }
+    series.timestamps = std::move(handler.timestamps);
+    series.fields = std::move(handler.fields);
+    series.columns = std::move(handler.columns);
+    for (auto& column : series.columns) {
+        column.resize(series.timestamps.size(), kMissing);
+    }
+    return series;
+}
+
+int64_t toUnixMillis(Timestamp time) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+}
+
+Timestamp fromUnixMillis(int64_t millis) {
+    return Timestamp(std::chrono::duration_cast<Timestamp::duration>(std::chrono::milliseconds(millis)));
+}
+
+} // namespace dataapi
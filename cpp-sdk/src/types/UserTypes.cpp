@@ -102,4 +102,11 @@ void from_json(const Json& j, UserUpdateRequest& u) {
     }
 }
 
+// UserPermission JSON deserialization
+void from_json(const Json& j, UserPermission& p) {
+    j.at("resource").get_to(p.resource);
+    j.at("action").get_to(p.action);
+    p.allowed = j.value("allowed", true);
+}
+
 } // namespace dataapi
\ No newline at end of file
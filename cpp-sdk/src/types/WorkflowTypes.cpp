@@ -1,6 +1,7 @@
 #include "dataapi/types/WorkflowTypes.h"
 #include <chrono>
 #include <cstdint>
+#include <strings.h>
 
 namespace dataapi {
 
@@ -36,6 +37,36 @@ void from_json(const Json& j, WorkflowExecutionResult& w) {
     }
 }
 
+void from_json(Json&& j, WorkflowExecutionResult& w) {
+    Json result = std::move(j.at("result"));
+    Json metadata = j.contains("metadata") ? std::move(j["metadata"]) : Json();
+    from_json(static_cast<const Json&>(j), w);
+    w.result = std::move(result);
+    w.metadata = std::move(metadata);
+}
+
+void from_json(const Json& j, WorkflowExecutionStatus& w) {
+    w.executionId = j.value("executionId", "");
+    w.status = j.value("status", "");
+    w.progress = j.value("progress", 0.0);
+    w.currentStep = j.value("currentStep", Json());
+}
+
+void from_json(const Json& j, WorkflowValidationResult& w) {
+    w.isValid = j.value("isValid", j.value("valid", false));
+    w.errors = j.value("errors", std::vector<std::string>());
+    w.warnings = j.value("warnings", std::vector<std::string>());
+}
+
+bool isTerminalExecutionStatus(const std::string& status) {
+    for (const char* terminal : {"COMPLETED", "FAILED", "CANCELLED"}) {
+        if (strcasecmp(status.c_str(), terminal) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
 // SysWorkflow JSON serialization
 void to_json(Json& j, const SysWorkflow& w) {
     j = Json{
@@ -78,6 +109,32 @@ void from_json(const Json& j, SysWorkflow& w) {
     }
 }
 
+static std::optional<std::string> takeOptionalString(Json& j, const char* key) {
+    auto it = j.find(key);
+    if (it == j.end() || it->is_null()) {
+        return std::nullopt;
+    }
+    return std::move(it->get_ref<std::string&>());
+}
+
+void from_json(Json&& j, SysWorkflow& w) {
+    w.name = std::move(j.at("name").get_ref<std::string&>());
+    w.definition = std::move(j.at("definition").get_ref<std::string&>());
+    w.projectId = std::move(j.at("projectId").get_ref<std::string&>());
+    w.userId = std::move(j.at("userId").get_ref<std::string&>());
+    w.id = takeOptionalString(j, "id");
+    w.description = takeOptionalString(j, "description");
+    w.createTime = takeOptionalString(j, "createTime");
+    w.updateTime = takeOptionalString(j, "updateTime");
+    
+    if (j.contains("status") && !j["status"].is_null()) {
+        w.status = static_cast<WorkflowStatus>(j["status"].get<int>());
+    }
+    if (j.contains("version") && !j["version"].is_null()) {
+        w.version = j["version"].get<int>();
+    }
+}
+
 // WorkflowCreateRequest JSON serialization
 void to_json(Json& j, const WorkflowCreateRequest& w) {
     j = Json{
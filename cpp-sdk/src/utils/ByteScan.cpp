@@ -0,0 +1,226 @@
+#include "utils/ByteScan.h"
+#include <bitset>
+#include <cstdint>
+
+#if defined(DATAAPI_WITH_SIMD) && defined(__SSE2__)
+#define DATAAPI_SCAN_SSE2 1
+#include <emmintrin.h>
+#elif defined(DATAAPI_WITH_SIMD) && defined(__ARM_NEON) && defined(__aarch64__)
+#define DATAAPI_SCAN_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace dataapi {
+namespace utils {
+namespace detail {
+
+namespace {
+
+/**
+ * 无需编码的字符表（字母、数字和-_.~），用于不足一个块的尾部
+ */
+struct UnreservedTable {
+    bool safe[256] = {};
+
+    constexpr UnreservedTable() {
+        for (int c = '0'; c <= '9'; ++c) safe[c] = true;
+        for (int c = 'A'; c <= 'Z'; ++c) safe[c] = true;
+        for (int c = 'a'; c <= 'z'; ++c) safe[c] = true;
+        safe[static_cast<unsigned char>('-')] = true;
+        safe[static_cast<unsigned char>('_')] = true;
+        safe[static_cast<unsigned char>('.')] = true;
+        safe[static_cast<unsigned char>('~')] = true;
+    }
+};
+
+constexpr UnreservedTable kUnreserved;
+
+bool isUnreserved(char c) {
+    return kUnreserved.safe[static_cast<unsigned char>(c)];
+}
+
+#if defined(DATAAPI_SCAN_SSE2) || defined(DATAAPI_SCAN_NEON)
+
+constexpr size_t kBlock = 16;
+
+#if defined(DATAAPI_SCAN_SSE2)
+
+// 块内匹配的字节在掩码中各占1位
+constexpr unsigned kBitsPerByte = 1;
+
+__m128i load(const char* p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+/**
+ * 落在[lo, hi]内的字节置为0xFF；有符号比较下高位字节为负，不会落入ASCII区间
+ */
+__m128i inRange(__m128i v, char lo, char hi) {
+    return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(static_cast<char>(lo - 1))),
+                         _mm_cmplt_epi8(v, _mm_set1_epi8(static_cast<char>(hi + 1))));
+}
+
+__m128i equals(__m128i v, char c) {
+    return _mm_cmpeq_epi8(v, _mm_set1_epi8(c));
+}
+
+uint64_t reservedBits(const char* p) {
+    __m128i v = load(p);
+    // 或上0x20后大写字母落入小写区间，其余字符不会
+    __m128i safe = _mm_or_si128(inRange(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 'z'), inRange(v, '0', '9'));
+    safe = _mm_or_si128(safe, _mm_or_si128(_mm_or_si128(equals(v, '-'), equals(v, '_')),
+                                           _mm_or_si128(equals(v, '.'), equals(v, '~'))));
+    return ~static_cast<unsigned>(_mm_movemask_epi8(safe)) & 0xFFFFu;
+}
+
+uint64_t percentOrPlusBits(const char* p) {
+    __m128i v = load(p);
+    return static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(equals(v, '%'), equals(v, '+'))));
+}
+
+void lowerBlock(char* p) {
+    __m128i v = load(p);
+    __m128i flip = _mm_and_si128(inRange(v, 'A', 'Z'), _mm_set1_epi8(0x20));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_or_si128(v, flip));
+}
+
+void upperBlock(char* p) {
+    __m128i v = load(p);
+    __m128i flip = _mm_and_si128(inRange(v, 'a', 'z'), _mm_set1_epi8(0x20));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_andnot_si128(flip, v));
+}
+
+#else
+
+// NEON没有movemask，按16位通道右移4位再收窄，每个字节得到4位
+constexpr unsigned kBitsPerByte = 4;
+
+uint8x16_t load(const char* p) {
+    return vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+}
+
+uint8x16_t inRange(uint8x16_t v, char lo, char hi) {
+    return vandq_u8(vcgeq_u8(v, vdupq_n_u8(static_cast<uint8_t>(lo))), vcleq_u8(v, vdupq_n_u8(static_cast<uint8_t>(hi))));
+}
+
+uint8x16_t equals(uint8x16_t v, char c) {
+    return vceqq_u8(v, vdupq_n_u8(static_cast<uint8_t>(c)));
+}
+
+uint64_t toBits(uint8x16_t bytes) {
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(bytes), 4)), 0);
+}
+
+uint64_t reservedBits(const char* p) {
+    uint8x16_t v = load(p);
+    uint8x16_t safe = vorrq_u8(inRange(vorrq_u8(v, vdupq_n_u8(0x20)), 'a', 'z'), inRange(v, '0', '9'));
+    safe = vorrq_u8(safe, vorrq_u8(vorrq_u8(equals(v, '-'), equals(v, '_')), vorrq_u8(equals(v, '.'), equals(v, '~'))));
+    return toBits(vmvnq_u8(safe));
+}
+
+uint64_t percentOrPlusBits(const char* p) {
+    uint8x16_t v = load(p);
+    return toBits(vorrq_u8(equals(v, '%'), equals(v, '+')));
+}
+
+void lowerBlock(char* p) {
+    uint8x16_t v = load(p);
+    uint8x16_t flip = vandq_u8(inRange(v, 'A', 'Z'), vdupq_n_u8(0x20));
+    vst1q_u8(reinterpret_cast<uint8_t*>(p), vorrq_u8(v, flip));
+}
+
+void upperBlock(char* p) {
+    uint8x16_t v = load(p);
+    uint8x16_t flip = vandq_u8(inRange(v, 'a', 'z'), vdupq_n_u8(0x20));
+    vst1q_u8(reinterpret_cast<uint8_t*>(p), vbicq_u8(v, flip));
+}
+
+#endif
+
+size_t firstByte(uint64_t bits) {
+    return static_cast<size_t>(__builtin_ctzll(bits)) / kBitsPerByte;
+}
+
+size_t byteCount(uint64_t bits) {
+    return std::bitset<64>(bits).count() / kBitsPerByte;
+}
+
+#endif
+
+} // namespace
+
+size_t unreservedPrefix(const char* data, size_t size) {
+    size_t i = 0;
+#if defined(DATAAPI_SCAN_SSE2) || defined(DATAAPI_SCAN_NEON)
+    for (; i + kBlock <= size; i += kBlock) {
+        if (uint64_t bits = reservedBits(data + i)) {
+            return i + firstByte(bits);
+        }
+    }
+#endif
+    while (i < size && isUnreserved(data[i])) {
+        ++i;
+    }
+    return i;
+}
+
+size_t countReserved(const char* data, size_t size) {
+    size_t count = 0;
+    size_t i = 0;
+#if defined(DATAAPI_SCAN_SSE2) || defined(DATAAPI_SCAN_NEON)
+    for (; i + kBlock <= size; i += kBlock) {
+        count += byteCount(reservedBits(data + i));
+    }
+#endif
+    for (; i < size; ++i) {
+        count += isUnreserved(data[i]) ? 0 : 1;
+    }
+    return count;
+}
+
+size_t findPercentOrPlus(const char* data, size_t size) {
+    size_t i = 0;
+#if defined(DATAAPI_SCAN_SSE2) || defined(DATAAPI_SCAN_NEON)
+    for (; i + kBlock <= size; i += kBlock) {
+        if (uint64_t bits = percentOrPlusBits(data + i)) {
+            return i + firstByte(bits);
+        }
+    }
+#endif
+    while (i < size && data[i] != '%' && data[i] != '+') {
+        ++i;
+    }
+    return i;
+}
+
+void asciiToLower(char* data, size_t size) {
+    size_t i = 0;
+#if defined(DATAAPI_SCAN_SSE2) || defined(DATAAPI_SCAN_NEON)
+    for (; i + kBlock <= size; i += kBlock) {
+        lowerBlock(data + i);
+    }
+#endif
+    for (; i < size; ++i) {
+        if (data[i] >= 'A' && data[i] <= 'Z') {
+            data[i] = static_cast<char>(data[i] + ('a' - 'A'));
+        }
+    }
+}
+
+void asciiToUpper(char* data, size_t size) {
+    size_t i = 0;
+#if defined(DATAAPI_SCAN_SSE2) || defined(DATAAPI_SCAN_NEON)
+    for (; i + kBlock <= size; i += kBlock) {
+        upperBlock(data + i);
+    }
+#endif
+    for (; i < size; ++i) {
+        if (data[i] >= 'a' && data[i] <= 'z') {
+            data[i] = static_cast<char>(data[i] - ('a' - 'A'));
+        }
+    }
+}
+
+} // namespace detail
+} // namespace utils
+} // namespace dataapi
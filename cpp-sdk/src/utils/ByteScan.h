@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+
+namespace dataapi {
+namespace utils {
+namespace detail {
+
+/**
+ * 字符串和URL处理的字节扫描原语
+ *
+ * 按16字节块处理：x86-64上使用SSE2，AArch64上使用NEON，两者都是各自架构的基线指令集，
+ * 无需运行时检测；其他平台或以DATAAPI_ENABLE_SIMD=OFF构建时逐字节处理，结果相同。
+ * 单字节查找（分隔符）直接使用memchr，C库已有向量化实现。
+ */
+
+/**
+ * 开头连续的无需URL编码（字母、数字和-_.~）的字节数
+ */
+size_t unreservedPrefix(const char* data, size_t size);
+
+/**
+ * 需要URL编码的字节数
+ */
+size_t countReserved(const char* data, size_t size);
+
+/**
+ * 第一个'%'或'+'的位置，不存在时为size
+ */
+size_t findPercentOrPlus(const char* data, size_t size);
+
+/**
+ * 就地转换ASCII字母的大小写，其他字节不变
+ */
+void asciiToLower(char* data, size_t size);
+void asciiToUpper(char* data, size_t size);
+
+} // namespace detail
+} // namespace utils
+} // namespace dataapi
@@ -1,58 +1,95 @@
 #include "dataapi/utils/StringUtils.h"
-#include <algorithm>
+#include "utils/ByteScan.h"
 #include <sstream>
 
 namespace dataapi {
 namespace utils {
 
+static bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static char foldCase(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
 std::string StringUtils::trim(const std::string& str) {
-    size_t start = str.find_first_not_of(" \t\r\n");
-    if (start == std::string::npos) {
-        return "";
+    return std::string(trimView(str));
+}
+
+std::string_view StringUtils::trimView(std::string_view str) {
+    while (!str.empty() && isSpace(str.front())) {
+        str.remove_prefix(1);
     }
-    
-    size_t end = str.find_last_not_of(" \t\r\n");
-    return str.substr(start, end - start + 1);
+    while (!str.empty() && isSpace(str.back())) {
+        str.remove_suffix(1);
+    }
+    return str;
 }
 
 std::string StringUtils::toLower(const std::string& str) {
     std::string result = str;
-    std::transform(result.begin(), result.end(), result.begin(), ::tolower);
+    toLowerInPlace(result);
     return result;
 }
 
 std::string StringUtils::toUpper(const std::string& str) {
     std::string result = str;
-    std::transform(result.begin(), result.end(), result.begin(), ::toupper);
+    toUpperInPlace(result);
     return result;
 }
 
-bool StringUtils::startsWith(const std::string& str, const std::string& prefix) {
-    if (prefix.length() > str.length()) {
-        return false;
-    }
-    return str.substr(0, prefix.length()) == prefix;
+void StringUtils::toLowerInPlace(std::string& str) {
+    detail::asciiToLower(&str[0], str.size());
 }
 
-bool StringUtils::endsWith(const std::string& str, const std::string& suffix) {
-    if (suffix.length() > str.length()) {
+void StringUtils::toUpperInPlace(std::string& str) {
+    detail::asciiToUpper(&str[0], str.size());
+}
+
+bool StringUtils::equalsIgnoreCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) {
         return false;
     }
-    return str.substr(str.length() - suffix.length()) == suffix;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i] != b[i] && foldCase(a[i]) != foldCase(b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool StringUtils::startsWith(std::string_view str, std::string_view prefix) {
+    return str.size() >= prefix.size() && str.compare(0, prefix.size(), prefix) == 0;
+}
+
+bool StringUtils::endsWith(std::string_view str, std::string_view suffix) {
+    return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
 }
 
 std::vector<std::string> StringUtils::split(const std::string& str, char delimiter) {
     std::vector<std::string> tokens;
-    std::stringstream ss(str);
-    std::string token;
-    
-    while (std::getline(ss, token, delimiter)) {
-        tokens.push_back(token);
+    for (std::string_view token : splitView(str, delimiter)) {
+        tokens.emplace_back(token);
     }
-    
     return tokens;
 }
 
+size_t StringUtils::splitInto(std::string_view str, char delimiter, std::string_view* out, size_t capacity) {
+    size_t count = 0;
+    while (!str.empty() && count < capacity) {
+        auto hit = static_cast<const char*>(std::memchr(str.data(), delimiter, str.size()));
+        if (hit == nullptr || count + 1 == capacity) {
+            out[count++] = str;
+            break;
+        }
+        size_t length = static_cast<size_t>(hit - str.data());
+        out[count++] = str.substr(0, length);
+        str.remove_prefix(length + 1);
+    }
+    return count;
+}
+
 std::string StringUtils::join(const std::vector<std::string>& strings, const std::string& delimiter) {
     if (strings.empty()) {
         return "";
@@ -70,14 +107,9 @@ std::string StringUtils::join(const std::vector<std::string>& strings, const std
 }
 
 std::string StringUtils::replace(const std::string& str, const std::string& from, const std::string& to) {
-    std::string result = str;
-    size_t pos = 0;
-    
-    while ((pos = result.find(from, pos)) != std::string::npos) {
-        result.replace(pos, from.length(), to);
-        pos += to.length();
-    }
-    
+    std::string result;
+    result.reserve(str.size());
+    appendReplaced(result, str, from, to);
     return result;
 }
 
@@ -86,7 +118,7 @@ bool StringUtils::isEmpty(const std::string& str) {
 }
 
 bool StringUtils::isBlank(const std::string& str) {
-    return trim(str).empty();
+    return trimView(str).empty();
 }
 
 } // namespace utils
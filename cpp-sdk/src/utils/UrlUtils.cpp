@@ -1,95 +1,107 @@
 #include "dataapi/utils/UrlUtils.h"
-#include <sstream>
-#include <iomanip>
-#include <cctype>
+#include "utils/ByteScan.h"
+#include <cstring>
 
 namespace dataapi {
 namespace utils {
 
-std::string UrlUtils::encode(const std::string& value) {
-    std::ostringstream encoded;
-    encoded.fill('0');
-    encoded << std::hex;
-    
-    for (char c : value) {
-        // 保留字母、数字和一些安全字符
-        if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
-            encoded << c;
-        } else {
-            encoded << std::uppercase;
-            encoded << '%' << std::setw(2) << int(static_cast<unsigned char>(c));
-            encoded << std::nouppercase;
+static constexpr char kHexDigits[] = "0123456789ABCDEF";
+
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    return -1;
+}
+
+size_t UrlUtils::encodedSize(std::string_view value) {
+    return value.size() + 2 * detail::countReserved(value.data(), value.size());
+}
+
+char* UrlUtils::encodeTo(char* dest, std::string_view value) {
+    const char* data = value.data();
+    size_t size = value.size();
+    size_t i = 0;
+    while (i < size) {
+        // 整段复制无需编码的字节，只有需要编码的字节逐个处理
+        size_t run = detail::unreservedPrefix(data + i, size - i);
+        std::memcpy(dest, data + i, run);
+        dest += run;
+        i += run;
+        if (i == size) {
+            break;
         }
+        auto byte = static_cast<unsigned char>(data[i++]);
+        *dest++ = '%';
+        *dest++ = kHexDigits[byte >> 4];
+        *dest++ = kHexDigits[byte & 0x0F];
     }
-    
-    return encoded.str();
+    return dest;
+}
+
+std::string UrlUtils::encode(const std::string& value) {
+    std::string encoded;
+    appendEncoded(encoded, value);
+    return encoded;
 }
 
 std::string UrlUtils::decode(const std::string& value) {
     std::string decoded;
-    
-    for (size_t i = 0; i < value.length(); ++i) {
-        if (value[i] == '%' && i + 2 < value.length()) {
-            // 解码百分号编码的字符
-            std::string hex = value.substr(i + 1, 2);
-            char decodedChar = static_cast<char>(std::stoi(hex, nullptr, 16));
-            decoded += decodedChar;
-            i += 2; // 跳过接下来的两个字符
-        } else if (value[i] == '+') {
+    appendDecoded(decoded, value);
+    return decoded;
+}
+
+char* UrlUtils::decodeTo(char* dest, std::string_view value) {
+    const char* data = value.data();
+    size_t size = value.size();
+    size_t i = 0;
+    while (i < size) {
+        size_t run = detail::findPercentOrPlus(data + i, size - i);
+        std::memmove(dest, data + i, run);
+        dest += run;
+        i += run;
+        if (i == size) {
+            break;
+        }
+        if (data[i] == '+') {
             // 将+替换为空格
-            decoded += ' ';
-        } else {
-            decoded += value[i];
+            *dest++ = ' ';
+            ++i;
+            continue;
         }
+        int high = i + 2 < size ? hexValue(data[i + 1]) : -1;
+        int low = i + 2 < size ? hexValue(data[i + 2]) : -1;
+        if (high < 0 || low < 0) {
+            *dest++ = data[i++];
+            continue;
+        }
+        *dest++ = static_cast<char>((high << 4) | low);
+        i += 3;
     }
-    
-    return decoded;
+    return dest;
 }
 
 std::string UrlUtils::buildQueryString(const Parameters& params) {
-    if (params.empty()) {
-        return "";
-    }
-    
-    std::ostringstream oss;
-    bool first = true;
-    
-    for (const auto& param : params) {
-        if (!first) {
-            oss << "&";
-        }
-        oss << encode(param.first) << "=" << encode(param.second);
-        first = false;
-    }
-    
-    return oss.str();
+    std::string query;
+    appendQueryString(query, params);
+    return query;
 }
 
 Parameters UrlUtils::parseQueryString(const std::string& queryString) {
     Parameters params;
-    
-    if (queryString.empty()) {
-        return params;
-    }
-    
-    std::string query = queryString;
-    // 移除开头的?字符（如果存在）
-    if (query[0] == '?') {
-        query = query.substr(1);
-    }
-    
-    std::istringstream iss(query);
-    std::string pair;
-    
-    while (std::getline(iss, pair, '&')) {
-        size_t equalPos = pair.find('=');
-        if (equalPos != std::string::npos) {
-            std::string key = decode(pair.substr(0, equalPos));
-            std::string value = decode(pair.substr(equalPos + 1));
-            params[key] = value;
-        }
-    }
-    
+    forEachQueryParam(queryString, [&params](std::string_view key, std::string_view value) {
+        std::string decodedKey;
+        appendDecoded(decodedKey, key);
+        std::string& decodedValue = params[std::move(decodedKey)];
+        decodedValue.clear();
+        appendDecoded(decodedValue, value);
+    });
     return params;
 }
 
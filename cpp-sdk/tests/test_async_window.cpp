@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "client/AsyncBatch.h"
+
+using dataapi::client::detail::AsyncWindow;
+
+namespace {
+
+struct Item {
+    std::exception_ptr error;
+    std::string errorMessage;
+};
+
+} // namespace
+
+TEST(AsyncWindowTest, BoundsInflightAndWaitsForAll) {
+    AsyncWindow window(3);
+    std::atomic<int> inflight{0};
+    std::atomic<int> peak{0};
+    std::atomic<int> finished{0};
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < 20; ++i) {
+        window.acquire();
+        int now = ++inflight;
+        int seen = peak.load();
+        while (now > seen && !peak.compare_exchange_weak(seen, now)) {
+        }
+        threads.emplace_back([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            --inflight;
+            ++finished;
+            window.release();
+        });
+    }
+    window.wait();
+
+    EXPECT_EQ(finished.load(), 20);
+    EXPECT_LE(peak.load(), 3);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+TEST(AsyncWindowTest, RecordsFailureMessage) {
+    Item item;
+    dataapi::client::detail::recordFailure(item, std::make_exception_ptr(std::runtime_error("boom")));
+    EXPECT_TRUE(item.error);
+    EXPECT_EQ(item.errorMessage, "boom");
+}
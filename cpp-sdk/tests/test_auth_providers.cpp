@@ -1,31 +1,38 @@
 #include <gtest/gtest.h>
-#include "dataapi/auth/ApiKeyAuthProvider.h"
-#include "dataapi/auth/BearerTokenAuthProvider.h"
-#include "dataapi/auth/BasicAuthProvider.h"
+#include "dataapi/auth/AuthenticationProvider.h"
 
 TEST(ApiKeyAuthProviderTest, GetAuthHeaders) {
     dataapi::auth::ApiKeyAuthProvider provider("test-api-key", "X-API-Key");
     auto headers = provider.getAuthHeaders();
     
-    EXPECT_EQ(headers.size(), 1);
+    EXPECT_EQ(headers.size(), 1u);
     EXPECT_EQ(headers["X-API-Key"], "test-api-key");
-    EXPECT_EQ(provider.getType(), dataapi::AuthenticationType::API_KEY);
+    EXPECT_EQ(provider.getType(), dataapi::auth::AuthenticationType::API_KEY);
 }
 
 TEST(BearerTokenAuthProviderTest, GetAuthHeaders) {
     dataapi::auth::BearerTokenAuthProvider provider("test-token");
     auto headers = provider.getAuthHeaders();
     
-    EXPECT_EQ(headers.size(), 1);
+    EXPECT_EQ(headers.size(), 1u);
     EXPECT_EQ(headers["Authorization"], "Bearer test-token");
-    EXPECT_EQ(provider.getType(), dataapi::AuthenticationType::BEARER_TOKEN);
+    EXPECT_EQ(provider.getType(), dataapi::auth::AuthenticationType::BEARER_TOKEN);
 }
 
 TEST(BasicAuthProviderTest, GetAuthHeaders) {
     dataapi::auth::BasicAuthProvider provider("username", "password");
     auto headers = provider.getAuthHeaders();
     
-    EXPECT_EQ(headers.size(), 1);
+    EXPECT_EQ(headers.size(), 1u);
     EXPECT_TRUE(headers["Authorization"].find("Basic ") == 0);
-    EXPECT_EQ(provider.getType(), dataapi::AuthenticationType::BASIC);
-}
\ No newline at end of file
+    EXPECT_EQ(provider.getType(), dataapi::auth::AuthenticationType::BASIC_AUTH);
+}
+
+TEST(BearerTokenAuthProviderTest, SetTokenChangesRevision) {
+    dataapi::auth::BearerTokenAuthProvider provider("test-token");
+    auto revision = provider.getRevision();
+    
+    provider.setToken("new-token");
+    EXPECT_NE(provider.getRevision(), revision);
+    EXPECT_EQ(provider.getAuthHeaders()["Authorization"], "Bearer new-token");
+}
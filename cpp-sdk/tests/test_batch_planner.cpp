@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include "client/BatchPlanner.h"
+
+using dataapi::BatchOptions;
+using dataapi::BatchResult;
+using dataapi::Json;
+using dataapi::client::detail::BatchRange;
+using dataapi::client::detail::mergeBatch;
+using dataapi::client::detail::splitBatch;
+
+TEST(BatchPlannerTest, SplitsByStatementCount) {
+    std::vector<std::string> sqls(10, "select 1");
+    BatchOptions options;
+    options.maxStatements = 4;
+    EXPECT_EQ(splitBatch(sqls, options), (std::vector<BatchRange>{{0, 4}, {4, 8}, {8, 10}}));
+    EXPECT_TRUE(splitBatch({}, options).empty());
+}
+
+TEST(BatchPlannerTest, SplitsByBytesAndIsolatesOversizedStatements) {
+    std::vector<std::string> sqls = {"aaaa", "bbbb", std::string(50, 'c'), "dd", "ee"};
+    BatchOptions options;
+    options.maxBytes = 10;
+    EXPECT_EQ(splitBatch(sqls, options), (std::vector<BatchRange>{{0, 2}, {2, 3}, {3, 5}}));
+}
+
+TEST(BatchPlannerTest, MergesResultsAndOffsetsErrorIndexes) {
+    BatchResult total{};
+    BatchResult first{{Json("r0"), Json("r1")}, 1, 1, Json::array({{{"index", 1}, {"message", "x"}}})};
+    BatchResult second{{Json("r2")}, 1, 0, Json()};
+    BatchResult third{{Json("r3"), Json("r4")}, 1, 1, Json::array({{{"index", 0}, {"message", "y"}}})};
+    mergeBatch(total, std::move(first), 0);
+    mergeBatch(total, std::move(second), 2);
+    mergeBatch(total, std::move(third), 3);
+
+    EXPECT_EQ(total.results, (std::vector<Json>{"r0", "r1", "r2", "r3", "r4"}));
+    EXPECT_EQ(total.successCount, 3);
+    EXPECT_EQ(total.errorCount, 2);
+    ASSERT_EQ(total.errors.size(), 2u);
+    EXPECT_EQ(total.errors[0]["index"], 1);
+    EXPECT_EQ(total.errors[1]["index"], 3);
+}
+
+TEST(BatchPlannerTest, DecodesBatchResult) {
+    BatchResult result = Json{{"results", {1, 2}}, {"successCount", 2}, {"errorCount", 0}}.get<BatchResult>();
+    EXPECT_EQ(result.results.size(), 2u);
+    EXPECT_EQ(result.successCount, 2);
+    EXPECT_TRUE(result.errors.is_null());
+}
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "dataapi/http/CircuitBreaker.h"
+#include "dataapi/http/ConcurrencyLimiter.h"
+#include "dataapi/http/HttpClient.h"
+#include "dataapi/http/Transport.h"
+#include "dataapi/error/DataApiError.h"
+
+using dataapi::http::AdaptiveConcurrencyLimiter;
+using dataapi::http::CircuitBreaker;
+using dataapi::http::CircuitBreakerOptions;
+using dataapi::http::CircuitBreakerRegistry;
+using dataapi::http::ConcurrencyLimitOptions;
+using dataapi::http::HttpClient;
+using dataapi::HttpRequestConfig;
+using dataapi::http::HttpResponse;
+using dataapi::http::InMemoryTransport;
+using dataapi::http::TransportRequest;
+
+namespace {
+
+CircuitBreakerOptions quickBreaker() {
+    CircuitBreakerOptions options;
+    options.windowSize = 4;
+    options.minimumCalls = 4;
+    options.failureRateThreshold = 0.5;
+    options.openDuration = std::chrono::milliseconds(50);
+    return options;
+}
+
+} // namespace
+
+TEST(CircuitBreakerTest, OpensWhenFailureRateReachesThreshold) {
+    CircuitBreaker breaker(quickBreaker());
+    uint64_t ticket = 0;
+    for (bool failed : {true, false, false}) {
+        ASSERT_TRUE(breaker.tryAcquire(ticket));
+        failed ? breaker.onFailure(ticket) : breaker.onSuccess(ticket);
+    }
+    EXPECT_EQ(breaker.getState(), CircuitBreaker::State::Closed);
+
+    ASSERT_TRUE(breaker.tryAcquire(ticket));
+    breaker.onFailure(ticket);
+    EXPECT_EQ(breaker.getState(), CircuitBreaker::State::Open);
+    EXPECT_FALSE(breaker.tryAcquire(ticket));
+}
+
+TEST(CircuitBreakerTest, HalfOpenProbeClosesOrReopens) {
+    CircuitBreaker breaker(quickBreaker());
+    uint64_t ticket = 0;
+    uint64_t stale = 0;
+    ASSERT_TRUE(breaker.tryAcquire(stale));
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(breaker.tryAcquire(ticket));
+        breaker.onFailure(ticket);
+    }
+    ASSERT_EQ(breaker.getState(), CircuitBreaker::State::Open);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    ASSERT_TRUE(breaker.tryAcquire(ticket));
+    EXPECT_EQ(breaker.getState(), CircuitBreaker::State::HalfOpen);
+    uint64_t second = 0;
+    EXPECT_FALSE(breaker.tryAcquire(second));
+    // 断开前放行的请求迟到的结果不影响探测
+    breaker.onSuccess(stale);
+    EXPECT_EQ(breaker.getState(), CircuitBreaker::State::HalfOpen);
+    breaker.onFailure(ticket);
+    EXPECT_EQ(breaker.getState(), CircuitBreaker::State::Open);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    ASSERT_TRUE(breaker.tryAcquire(ticket));
+    breaker.onIgnored(ticket);
+    ASSERT_TRUE(breaker.tryAcquire(ticket));
+    breaker.onSuccess(ticket);
+    EXPECT_EQ(breaker.getState(), CircuitBreaker::State::Closed);
+    EXPECT_DOUBLE_EQ(breaker.getFailureRate(), 0.0);
+}
+
+TEST(CircuitBreakerTest, GroupsByFirstPathSegment) {
+    EXPECT_EQ(CircuitBreakerRegistry::groupOf("/workflows/42/execute"), "/workflows");
+    EXPECT_EQ(CircuitBreakerRegistry::groupOf("/users?page=2"), "/users");
+    EXPECT_EQ(CircuitBreakerRegistry::groupOf("health"), "/health");
+
+    CircuitBreakerRegistry registry;
+    EXPECT_EQ(registry.get("/users"), registry.get("/users"));
+    EXPECT_NE(registry.get("/users"), registry.get("/workflows"));
+}
+
+TEST(AdaptiveConcurrencyLimiterTest, RejectsBeyondLimit) {
+    ConcurrencyLimitOptions options;
+    options.initialLimit = 2;
+    AdaptiveConcurrencyLimiter limiter(options);
+    EXPECT_TRUE(limiter.tryAcquire());
+    EXPECT_TRUE(limiter.tryAcquire());
+    EXPECT_FALSE(limiter.tryAcquire());
+    limiter.onIgnored();
+    EXPECT_TRUE(limiter.tryAcquire());
+    EXPECT_EQ(limiter.getInFlight(), 2);
+}
+
+TEST(AdaptiveConcurrencyLimiterTest, GrowsWhileLatencyStaysFlatAndShrinksWhenItRises) {
+    ConcurrencyLimitOptions options;
+    options.initialLimit = 10;
+    options.maxLimit = 20;
+    AdaptiveConcurrencyLimiter limiter(options);
+    auto round = [&](std::chrono::microseconds latency) {
+        int limit = limiter.getLimit();
+        for (int i = 0; i < limit; ++i) {
+            ASSERT_TRUE(limiter.tryAcquire());
+        }
+        for (int i = 0; i < limit; ++i) {
+            limiter.onSample(latency);
+        }
+    };
+
+    for (int i = 0; i < 5; ++i) {
+        round(std::chrono::microseconds(1000));
+    }
+    EXPECT_EQ(limiter.getLimit(), 20);
+
+    // 延迟翻倍说明约一半请求在服务端排队
+    round(std::chrono::microseconds(2000));
+    EXPECT_LT(limiter.getLimit(), 20);
+    EXPECT_EQ(limiter.getInFlight(), 0);
+}
+
+TEST(AdaptiveConcurrencyLimiterTest, BacksOffMultiplicativelyOnDrops) {
+    ConcurrencyLimitOptions options;
+    options.initialLimit = 100;
+    options.minLimit = 5;
+    options.backoffRatio = 0.5;
+    AdaptiveConcurrencyLimiter limiter(options);
+    ASSERT_TRUE(limiter.tryAcquire());
+    limiter.onDropped();
+    EXPECT_EQ(limiter.getLimit(), 50);
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(limiter.tryAcquire());
+        limiter.onDropped();
+    }
+    EXPECT_EQ(limiter.getLimit(), 5);
+}
+
+TEST(CircuitBreakerTest, SinkAbortsDoNotCountAsFailures) {
+    auto transport = std::make_shared<InMemoryTransport>([](const TransportRequest&) {
+        HttpResponse response;
+        response.statusCode = 200;
+        response.body = "[1,2,3]";
+        return response;
+    });
+    dataapi::ClientConfig config("http://sidecar/api");
+    config.transport = transport;
+    config.enableCircuitBreaker = true;
+    config.enableAdaptiveConcurrency = true;
+    config.maxRetries = 0;
+    HttpClient client(config, nullptr);
+    int limit = client.getConcurrencyLimiter()->getLimit();
+
+    // 调用方提前停止接收响应体，端点本身是健康的
+    HttpRequestConfig request;
+    request.url = "/databases";
+    for (int i = 0; i < 2 * config.circuitBreakerWindow; ++i) {
+        EXPECT_THROW(client.request(request, [](const char*, size_t) { return false; }),
+                     dataapi::error::SinkAbortedError);
+    }
+    EXPECT_EQ(client.getCircuitBreaker("/databases")->getState(), CircuitBreaker::State::Closed);
+    EXPECT_EQ(client.getConcurrencyLimiter()->getLimit(), limit);
+    EXPECT_EQ(client.getConcurrencyLimiter()->getInFlight(), 0);
+    EXPECT_EQ(client.get("/databases").statusCode, 200);
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "dataapi/types/ColumnarResult.h"
+
+using dataapi::Column;
+using dataapi::ColumnarResult;
+using dataapi::ColumnType;
+using dataapi::Json;
+
+TEST(ColumnarResultTest, InfersTypedColumnsFromObjectRows) {
+    ColumnarResult result({"id", "name", "score", "active"});
+    result.appendRow({{"id", 1}, {"name", "alice"}, {"score", 1.5}, {"active", true}});
+    result.appendRow({{"id", 2}, {"name", nullptr}, {"score", 2.5}, {"active", false}});
+
+    ASSERT_EQ(result.getRowCount(), 2u);
+    EXPECT_EQ(result.column("id").getType(), ColumnType::Int64);
+    EXPECT_EQ(result.column("id").int64Values(), (std::vector<int64_t>{1, 2}));
+    EXPECT_EQ(result.column("score").doubleValues(), (std::vector<double>{1.5, 2.5}));
+    EXPECT_EQ(result.column("active").boolValues(), (std::vector<uint8_t>{1, 0}));
+
+    const Column& name = result.column("name");
+    EXPECT_EQ(name.getType(), ColumnType::String);
+    EXPECT_EQ(name.stringAt(0), "alice");
+    EXPECT_TRUE(name.isNull(1));
+    EXPECT_EQ(name.getNullCount(), 1u);
+    EXPECT_EQ(name.stringOffsets(), (std::vector<int32_t>{0, 5, 5}));
+}
+
+TEST(ColumnarResultTest, BackfillsLeadingNullsAndPromotesTypes) {
+    ColumnarResult result({"value", "mixed"});
+    result.appendRow(Json::array({nullptr, 1}));
+    result.appendRow(Json::array({7, "text"}));
+    result.appendRow(Json::array({0.5, 2}));
+
+    const Column& value = result.column("value");
+    EXPECT_EQ(value.getType(), ColumnType::Double);
+    ASSERT_EQ(value.doubleValues().size(), 3u);
+    EXPECT_TRUE(value.isNull(0));
+    EXPECT_DOUBLE_EQ(value.doubleValues()[1], 7.0);
+    EXPECT_DOUBLE_EQ(value.doubleValues()[2], 0.5);
+
+    const Column& mixed = result.column("mixed");
+    EXPECT_EQ(mixed.getType(), ColumnType::Json);
+    EXPECT_EQ(mixed.valueAt(0), Json(1));
+    EXPECT_EQ(mixed.valueAt(1), Json("text"));
+    EXPECT_THROW(mixed.int64Values(), std::logic_error);
+}
+
+TEST(ColumnarResultTest, AddsColumnsForNewKeys) {
+    ColumnarResult result;
+    result.appendRow({{"a", 1}});
+    result.appendRow({{"a", 2}, {"b", "x"}});
+
+    ASSERT_EQ(result.getColumnCount(), 2u);
+    const Column& b = result.column("b");
+    EXPECT_EQ(b.size(), 2u);
+    EXPECT_TRUE(b.isNull(0));
+    EXPECT_EQ(b.stringAt(1), "x");
+    EXPECT_THROW(result.column("missing"), std::out_of_range);
+    EXPECT_THROW(result.setColumns({"a"}), std::logic_error);
+}
+
+TEST(ColumnarResultTest, ConvertsFromQueryResult) {
+    dataapi::QueryResult rows;
+    rows.columns = {"n"};
+    for (int i = 0; i < 20; ++i) {
+        rows.rows.push_back({{"n", i % 3 == 0 ? Json(nullptr) : Json(i)}});
+    }
+    rows.totalRows = 20;
+
+    ColumnarResult result = ColumnarResult::fromQueryResult(rows);
+    const Column& n = result.column(0);
+    EXPECT_EQ(result.totalRows, 20);
+    EXPECT_EQ(n.getNullCount(), 7u);
+    EXPECT_EQ(n.getValidity().size(), 3u);
+    for (size_t i = 0; i < 20; ++i) {
+        EXPECT_EQ(n.valueAt(i), rows.rows[i]["n"]);
+    }
+}
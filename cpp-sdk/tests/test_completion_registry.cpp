@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include "client/CompletionRegistry.h"
+
+using dataapi::WorkflowExecutionResult;
+using dataapi::client::detail::CompletionRegistry;
+
+namespace {
+
+WorkflowExecutionResult finished(const std::string& id, const std::string& status = "COMPLETED") {
+    WorkflowExecutionResult result;
+    result.executionId = id;
+    result.status = status;
+    return result;
+}
+
+} // namespace
+
+TEST(CompletionRegistryTest, NotifiesAllWaitersOfAnExecution) {
+    CompletionRegistry registry(8);
+    auto first = registry.watch("e1");
+    auto second = registry.watch("e1");
+    std::string seen;
+    registry.watch("e1", [&](WorkflowExecutionResult result, std::exception_ptr error) {
+        EXPECT_FALSE(error);
+        seen = result.status;
+    });
+    EXPECT_EQ(registry.size(), 1u);
+
+    EXPECT_TRUE(registry.complete(finished("e1", "FAILED")));
+    EXPECT_EQ(first.get().status, "FAILED");
+    EXPECT_EQ(second.get().executionId, "e1");
+    EXPECT_EQ(seen, "FAILED");
+    EXPECT_EQ(registry.size(), 0u);
+}
+
+TEST(CompletionRegistryTest, RetainsCompletionsBeforeWatch) {
+    CompletionRegistry registry(2);
+    EXPECT_FALSE(registry.complete(finished("a")));
+    EXPECT_FALSE(registry.complete(finished("b")));
+    EXPECT_FALSE(registry.complete(finished("c")));
+
+    auto c = registry.watch("c");
+    ASSERT_EQ(c.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_EQ(c.get().executionId, "c");
+    // 超出保留数量的最早结果被丢弃
+    auto a = registry.watch("a");
+    EXPECT_EQ(a.wait_for(std::chrono::seconds(0)), std::future_status::timeout);
+}
+
+TEST(CompletionRegistryTest, CloseFailsPendingAndLaterWaiters) {
+    CompletionRegistry registry(0);
+    auto pending = registry.watch("x");
+    registry.close(std::make_exception_ptr(std::runtime_error("stopped")));
+    EXPECT_THROW(pending.get(), std::runtime_error);
+
+    bool failed = false;
+    registry.watch("y", [&](WorkflowExecutionResult, std::exception_ptr error) {
+        failed = error != nullptr;
+    });
+    EXPECT_TRUE(failed);
+    EXPECT_THROW(registry.watch("z").get(), std::runtime_error);
+}
+
+TEST(CompletionRegistryTest, RecognizesTerminalStatuses) {
+    EXPECT_TRUE(dataapi::isTerminalExecutionStatus("completed"));
+    EXPECT_TRUE(dataapi::isTerminalExecutionStatus("CANCELLED"));
+    EXPECT_FALSE(dataapi::isTerminalExecutionStatus("RUNNING"));
+    EXPECT_FALSE(dataapi::isTerminalExecutionStatus(""));
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include "dataapi/client/DatabaseClient.h"
+#include "dataapi/http/ConditionalCache.h"
+#include "dataapi/http/Transport.h"
+
+using dataapi::Headers;
+using dataapi::http::ConditionalCache;
+using dataapi::http::HttpResponse;
+using dataapi::http::InMemoryTransport;
+using dataapi::http::TransportRequest;
+using dataapi::http::ResponseHeaders;
+using dataapi::http::Validators;
+
+namespace {
+
+ResponseHeaders headersOf(std::initializer_list<const char*> lines) {
+    ResponseHeaders headers;
+    for (const char* line : lines) {
+        headers.append(line, std::strlen(line));
+    }
+    return headers;
+}
+
+} // namespace
+
+TEST(ConditionalCacheTest, ExtractsAndAppliesValidators) {
+    auto validators = Validators::from(headersOf({"HTTP/1.1 200 OK\r\n",
+                                                  "etag: W/\"abc\"\r\n",
+                                                  "Last-Modified: Tue, 13 Oct 2026 08:00:00 GMT\r\n"}));
+    Headers request;
+    validators.apply(request);
+    EXPECT_EQ(request["If-None-Match"], "W/\"abc\"");
+    EXPECT_EQ(request["If-Modified-Since"], "Tue, 13 Oct 2026 08:00:00 GMT");
+
+    EXPECT_TRUE(Validators::from(headersOf({"ETag: \"x\"\r\n", "Cache-Control: private, No-Store\r\n"})).empty());
+    EXPECT_TRUE(Validators::from(headersOf({"Content-Type: application/json\r\n"})).empty());
+}
+
+TEST(ConditionalCacheTest, StoresDecodedObjectsWithLruBound) {
+    ConditionalCache cache(2);
+    Validators validators;
+    validators.etag = "\"1\"";
+    cache.store("/a", validators, typeid(int), std::make_shared<const int>(1));
+    cache.store("/b", validators, typeid(int), std::make_shared<const int>(2));
+    ASSERT_NE(cache.find("/a"), nullptr);
+    cache.store("/c", validators, typeid(int), std::make_shared<const int>(3));
+
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(cache.find("/b"), nullptr);
+    auto entry = cache.find("/a");
+    ASSERT_NE(entry, nullptr);
+    EXPECT_EQ(entry->type, std::type_index(typeid(int)));
+    EXPECT_EQ(*static_cast<const int*>(entry->value.get()), 1);
+
+    cache.store("/a", validators, typeid(int), std::make_shared<const int>(10));
+    EXPECT_EQ(*static_cast<const int*>(cache.find("/a")->value.get()), 10);
+    EXPECT_EQ(cache.getStats().stored, 4u);
+}
+
+TEST(ConditionalCacheTest, KeysTableListsByEncodedQuery) {
+    std::map<std::string, int> requests;
+    int notModified = 0;
+    auto transport = std::make_shared<InMemoryTransport>([&](const TransportRequest& request) {
+        std::string target(request.target());
+        ++requests[target];
+        HttpResponse response;
+        bool revalidating = std::any_of(request.headers.begin(), request.headers.end(), [](const auto& header) {
+            return header.first == "If-None-Match";
+        });
+        if (revalidating) {
+            ++notModified;
+            response.statusCode = 304;
+            return response;
+        }
+        response.statusCode = 200;
+        response.headers.append("ETag: \"1\"\r\n", 11);
+        response.body = "[{\"name\": \"" + target + "\"}]";
+        return response;
+    });
+    dataapi::ClientConfig config("http://sidecar/api");
+    config.transport = transport;
+    auto httpClient = std::make_shared<dataapi::http::HttpClient>(config, nullptr);
+    httpClient->setConditionalCache(std::make_shared<ConditionalCache>());
+    dataapi::client::DatabaseClient client(httpClient);
+
+    // 不同schema的结果分别缓存，再次请求时各自携带校验器
+    EXPECT_EQ(client.getTables("db", "sales data")[0].name, "/api/databases/db/tables?schema=sales%20data");
+    EXPECT_EQ(client.getTables("db", "")[0].name, "/api/databases/db/tables");
+    EXPECT_EQ(client.getTables("db", "sales data")[0].name, "/api/databases/db/tables?schema=sales%20data");
+    EXPECT_EQ(client.getTables("db", "")[0].name, "/api/databases/db/tables");
+    EXPECT_EQ(notModified, 2);
+    EXPECT_EQ(requests.size(), 2u);
+    EXPECT_EQ(httpClient->getConditionalCache()->size(), 2u);
+}
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "dataapi/DataApiClient.h"
+#include "dataapi/http/Transport.h"
+
+using namespace dataapi;
+using namespace dataapi::http;
+
+namespace {
+
+ClientConfig inMemoryConfig() {
+    ClientConfig config("http://sidecar/api");
+    config.transport = std::make_shared<InMemoryTransport>([](const TransportRequest&) {
+        HttpResponse response;
+        response.statusCode = 200;
+        response.body = R"({"content":[],"totalElements":0,"totalPages":0,"page":1,"size":20})";
+        return response;
+    });
+    return config;
+}
+
+} // namespace
+
+TEST(DataApiClientTest, ConcurrentFirstAccessCreatesOneServiceClient) {
+    DataApiClient client(inMemoryConfig(), nullptr);
+    std::vector<client::DatabaseClient*> seen(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < seen.size(); ++i) {
+        threads.emplace_back([&, i] { seen[i] = &client.getDatabaseClient(); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (auto* databaseClient : seen) {
+        EXPECT_EQ(databaseClient, seen[0]);
+    }
+    EXPECT_EQ(&client.getDatabaseClient(), seen[0]);
+    EXPECT_NO_THROW(client.getDatabaseClient().list());
+}
+
+TEST(DataApiClientTest, MovedClientKeepsItsServiceClients) {
+    DataApiClient client(inMemoryConfig(), nullptr);
+    client::WorkflowClient* workflowClient = &client.getWorkflowClient();
+    DataApiClient moved(std::move(client));
+    EXPECT_EQ(&moved.getWorkflowClient(), workflowClient);
+    // 移动前未使用的服务客户端在移动后按需创建
+    EXPECT_NO_THROW(moved.getDatabaseClient().list());
+}
+
+TEST(DataApiClientTest, BuildsOnAPrewarmedRuntime) {
+    ClientConfig config = inMemoryConfig();
+    auto runtime = DataApiClient::prewarmRuntime(config);
+    ASSERT_NE(runtime, nullptr);
+    EXPECT_EQ(runtime, CurlRuntime::instance());
+
+    DataApiClient client(config, nullptr, runtime);
+    EXPECT_NO_THROW(client.getDatabaseClient().list());
+}
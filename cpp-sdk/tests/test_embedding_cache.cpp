@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <unistd.h>
+#include "dataapi/client/EmbeddingCache.h"
+
+using dataapi::client::EmbeddingCache;
+using dataapi::client::EmbeddingCacheOptions;
+
+namespace {
+
+// 每个文本的向量为{长度, 首字符}
+std::vector<EmbeddingCache::Vector> embed(const std::vector<std::string>& texts) {
+    std::vector<EmbeddingCache::Vector> vectors;
+    for (const auto& text : texts) {
+        vectors.push_back({float(text.size()), text.empty() ? 0.0f : float(text[0])});
+    }
+    return vectors;
+}
+
+} // namespace
+
+TEST(EmbeddingCacheTest, FetchesOnlyMisses) {
+    EmbeddingCache cache;
+    std::vector<std::vector<std::string>> requests;
+    auto fetch = [&](const std::vector<std::string>& texts) {
+        requests.push_back(texts);
+        return embed(texts);
+    };
+
+    auto first = cache.resolve("p\nm", {"a", "bb", "a"}, fetch);
+    auto second = cache.resolve("p\nm", {"bb", "ccc"}, fetch);
+    cache.resolve("other", {"a"}, fetch);
+
+    ASSERT_EQ(requests.size(), 3u);
+    EXPECT_EQ(requests[0], (std::vector<std::string>{"a", "bb"}));
+    EXPECT_EQ(requests[1], (std::vector<std::string>{"ccc"}));
+    EXPECT_EQ(first[2], (EmbeddingCache::Vector{1, 'a'}));
+    EXPECT_EQ(second[0], (EmbeddingCache::Vector{2, 'b'}));
+    EXPECT_EQ(cache.getStats().memoryHits, 1u);
+    EXPECT_EQ(cache.getStats().coalesced, 1u);
+}
+
+TEST(EmbeddingCacheTest, EvictsLeastRecentlyUsed) {
+    EmbeddingCacheOptions options;
+    options.maxEntries = 2;
+    EmbeddingCache cache(options);
+    auto a = EmbeddingCache::makeKey("s", "a");
+    auto b = EmbeddingCache::makeKey("s", "b");
+    auto c = EmbeddingCache::makeKey("s", "c");
+    EmbeddingCache::Vector vector;
+
+    cache.store(a, {1});
+    cache.store(b, {2});
+    ASSERT_TRUE(cache.lookup(a, vector));
+    cache.store(c, {3});
+
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_TRUE(cache.lookup(a, vector));
+    EXPECT_FALSE(cache.lookup(b, vector));
+    EXPECT_TRUE(cache.lookup(c, vector));
+}
+
+TEST(EmbeddingCacheTest, CoalescesConcurrentCallsIntoOneRequest) {
+    EmbeddingCacheOptions options;
+    options.batchWindow = std::chrono::milliseconds(200);
+    options.maxBatchSize = 4;
+    EmbeddingCache cache(options);
+    std::atomic<int> requests{0};
+    auto fetch = [&](const std::vector<std::string>& texts) {
+        ++requests;
+        return embed(texts);
+    };
+
+    // 四个调用的文本凑满一批，窗口未到即发出
+    std::vector<std::thread> threads;
+    std::vector<EmbeddingCache::Vector> results(4);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&, i] {
+            results[i] = cache.resolve("s", {std::string(i + 1, 'x'), "shared"}, fetch)[0];
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(1000));
+    EXPECT_LE(requests.load(), 2);
+    EXPECT_EQ(cache.getStats().fetched, 5u);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(results[i][0], i + 1);
+    }
+}
+
+TEST(EmbeddingCacheTest, PropagatesFailureAndAllowsRetry) {
+    EmbeddingCache cache;
+    auto failing = [](const std::vector<std::string>&) -> std::vector<EmbeddingCache::Vector> {
+        throw std::runtime_error("quota exceeded");
+    };
+    EXPECT_THROW(cache.resolve("s", {"a"}, failing), std::runtime_error);
+    EXPECT_THROW(cache.resolve("s", {"a"}, [](const std::vector<std::string>&) {
+        return std::vector<EmbeddingCache::Vector>{};
+    }), std::runtime_error);
+    EXPECT_EQ(cache.resolve("s", {"a"}, embed)[0], (EmbeddingCache::Vector{1, 'a'}));
+}
+
+TEST(EmbeddingCacheTest, PersistsToDisk) {
+    std::string path = "/tmp/dataapi_embedding_cache_" + std::to_string(::getpid()) + ".bin";
+    std::remove(path.c_str());
+    EmbeddingCacheOptions options;
+    options.diskPath = path;
+    {
+        EmbeddingCache cache(options);
+        cache.resolve("s", {"hello", "world"}, embed);
+    }
+
+    EmbeddingCache reopened(options);
+    int requests = 0;
+    auto vectors = reopened.resolve("s", {"world", "hello"}, [&](const std::vector<std::string>& texts) {
+        ++requests;
+        return embed(texts);
+    });
+    EXPECT_EQ(requests, 0);
+    EXPECT_EQ(vectors[0], (EmbeddingCache::Vector{5, 'w'}));
+    EXPECT_EQ(reopened.getStats().diskHits, 2u);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include "client/EmbeddingDecoder.h"
+
+using dataapi::EmbeddingMatrix;
+using dataapi::EmbeddingPrecision;
+using dataapi::client::detail::decodeEmbeddings;
+
+TEST(EmbeddingMatrixTest, StoresRowsContiguously) {
+    EmbeddingMatrix matrix;
+    matrix.appendRow({1.0f, 2.0f, 3.0f});
+    matrix.appendRow({4.0f, 5.0f, 6.0f});
+
+    ASSERT_EQ(matrix.rows(), 2u);
+    EXPECT_EQ(matrix.stride(), 3u);
+    EXPECT_EQ(matrix[1].data(), matrix.data() + 3);
+    EXPECT_EQ(matrix[1][2], 6.0f);
+    EXPECT_EQ(matrix.toVector(0), (std::vector<float>{1, 2, 3}));
+    EXPECT_THROW(matrix.appendRow({1.0f}), std::invalid_argument);
+    EXPECT_THROW(matrix.halfData(), std::logic_error);
+}
+
+TEST(EmbeddingMatrixTest, ConvertsHalfPrecision) {
+    EXPECT_EQ(dataapi::floatToHalf(1.0f), 0x3c00);
+    EXPECT_EQ(dataapi::floatToHalf(-2.0f), 0xc000);
+    EXPECT_EQ(dataapi::floatToHalf(65520.0f), 0x7c00);
+    EXPECT_EQ(dataapi::halfToFloat(0x0001), std::ldexp(1.0f, -24));
+    EXPECT_TRUE(std::isnan(dataapi::halfToFloat(dataapi::floatToHalf(std::numeric_limits<float>::quiet_NaN()))));
+    for (float value : {0.0f, 0.5f, -0.333f, 1e-5f, 1234.5f}) {
+        EXPECT_NEAR(dataapi::halfToFloat(dataapi::floatToHalf(value)), value, std::fabs(value) * 1e-3f + 1e-7f);
+    }
+
+    EmbeddingMatrix matrix(EmbeddingPrecision::Float16);
+    matrix.appendRow({0.25f, -1.5f});
+    EXPECT_EQ(matrix.halfData()[1], dataapi::floatToHalf(-1.5f));
+    EXPECT_EQ(matrix.at(0, 0), 0.25f);
+    EXPECT_THROW(matrix.row(0), std::logic_error);
+}
+
+TEST(EmbeddingMatrixTest, DecodesResponseBodyDirectly) {
+    auto result = decodeEmbeddings(
+        R"({"model":"m","embeddings":[[0.5, -1e-2,3],[1,2,3]],"usage":{"tokens":4},"metadata":{"s":"]"}})",
+        EmbeddingPrecision::Float32);
+    EXPECT_EQ(result.model, "m");
+    EXPECT_EQ(result.usage["tokens"], 4);
+    EXPECT_EQ(result.metadata["s"], "]");
+    ASSERT_EQ(result.embeddings.rows(), 2u);
+    EXPECT_FLOAT_EQ(result.embeddings[0][1], -0.01f);
+    EXPECT_EQ(result.embeddings[1][2], 3.0f);
+
+    auto empty = decodeEmbeddings(R"({"embeddings":[]})", EmbeddingPrecision::Float16);
+    EXPECT_TRUE(empty.embeddings.empty());
+    EXPECT_EQ(empty.embeddings.precision(), EmbeddingPrecision::Float16);
+}
+
+TEST(EmbeddingMatrixTest, FallsBackForUnexpectedStructure) {
+    EXPECT_THROW(decodeEmbeddings(R"({"embeddings":[[1,2],[3]]})", EmbeddingPrecision::Float32), std::invalid_argument);
+    EXPECT_ANY_THROW(decodeEmbeddings(R"({"embeddings":[[1,null]]})", EmbeddingPrecision::Float32));
+    EXPECT_ANY_THROW(decodeEmbeddings(R"({"model":"m"})", EmbeddingPrecision::Float32));
+}
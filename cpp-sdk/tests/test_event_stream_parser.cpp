@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include "client/EventStreamParser.h"
+#include <string>
+#include <vector>
+
+using dataapi::client::detail::EventStreamParser;
+
+namespace {
+
+struct Collector {
+    std::vector<EventStreamParser::Event> events;
+    EventStreamParser::EventHandler handler() {
+        return [this](EventStreamParser::Event& event) {
+            events.push_back(event);
+            return true;
+        };
+    }
+};
+
+} // namespace
+
+TEST(EventStreamParserTest, ParsesEventsSplitAcrossChunks) {
+    Collector collector;
+    EventStreamParser parser(collector.handler());
+    std::string stream = ": keepalive\r\nevent: delta\r\ndata: first\r\ndata:second\r\nid: 7\r\n\r\ndata: {\"x\":1}\n\n";
+    // 逐字节输入，覆盖\r\n跨块的情况
+    for (char c : stream) {
+        ASSERT_TRUE(parser.feed(&c, 1));
+    }
+
+    ASSERT_EQ(collector.events.size(), 2u);
+    EXPECT_EQ(collector.events[0].type, "delta");
+    EXPECT_EQ(collector.events[0].data, "first\nsecond");
+    EXPECT_EQ(collector.events[0].id, "7");
+    EXPECT_EQ(collector.events[1].type, "");
+    EXPECT_EQ(collector.events[1].data, "{\"x\":1}");
+    EXPECT_EQ(collector.events[1].id, "7");
+}
+
+TEST(EventStreamParserTest, DropsUnterminatedServerSentEvent) {
+    Collector collector;
+    EventStreamParser parser(collector.handler());
+    std::string stream = "event: ping\n\ndata: partial";
+    parser.feed(stream.data(), stream.size());
+    EXPECT_TRUE(parser.finish());
+    EXPECT_TRUE(collector.events.empty());
+}
+
+TEST(EventStreamParserTest, SplitsNewlineDelimitedRecords) {
+    Collector collector;
+    EventStreamParser parser(collector.handler(), EventStreamParser::Framing::NewlineDelimited);
+    std::string stream = "{\"a\":1}\r\n\n{\"a\":2}\n{\"a\":";
+    parser.feed(stream.data(), stream.size());
+    parser.feed("3}", 2);
+    EXPECT_TRUE(parser.finish());
+
+    ASSERT_EQ(collector.events.size(), 3u);
+    EXPECT_EQ(collector.events[0].data, "{\"a\":1}");
+    EXPECT_EQ(collector.events[2].data, "{\"a\":3}");
+}
+
+TEST(EventStreamParserTest, StopsWhenHandlerReturnsFalse) {
+    int calls = 0;
+    EventStreamParser parser([&calls](EventStreamParser::Event&) {
+        return ++calls < 2;
+    });
+    std::string stream = "data: 1\n\ndata: 2\n\ndata: 3\n\n";
+    EXPECT_FALSE(parser.feed(stream.data(), stream.size()));
+    EXPECT_EQ(calls, 2);
+    EXPECT_FALSE(parser.feed("data: 4\n\n", 9));
+    EXPECT_EQ(calls, 2);
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "dataapi/client/ExecutionWatcher.h"
+#include "dataapi/error/DataApiError.h"
+#include "dataapi/http/Transport.h"
+
+using namespace dataapi;
+using namespace dataapi::client;
+using namespace dataapi::http;
+
+TEST(ExecutionWatcherTest, ReconnectsWithoutTrippingTheCircuitBreaker) {
+    std::mutex mutex;
+    std::vector<int> timeouts;
+    std::vector<std::string> lastEventIds;
+    auto transport = std::make_shared<InMemoryTransport>([&](const TransportRequest& request) {
+        HttpResponse response;
+        response.statusCode = 200;
+        if (request.target() != "/api/workflows/executions/events") {
+            response.body = "{}";
+            return response;
+        }
+        size_t connection;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            timeouts.push_back(request.timeoutMs);
+            lastEventIds.emplace_back(request.header("Last-Event-ID"));
+            connection = timeouts.size();
+        }
+        if (connection == 1) {
+            throw error::ConnectionError("connection refused");
+        }
+        // 服务端每次发送一个事件后结束连接
+        response.headers.append("Content-Type: text/event-stream\r\n", 33);
+        response.body = "id: " + std::to_string(connection) +
+                        "\ndata: {\"executionId\": \"exec-1\", \"status\": \"COMPLETED\"}\n\n";
+        return response;
+    });
+    ClientConfig config("http://sidecar/api");
+    config.transport = transport;
+    config.enableCircuitBreaker = true;
+    config.circuitBreakerWindow = 4;
+    config.circuitBreakerMinimumRequests = 4;
+    // 请求内重试会在10秒退避后才重连
+    config.maxRetries = 3;
+    config.retryDelay = 10000;
+    auto httpClient = std::make_shared<HttpClient>(config, nullptr);
+
+    ExecutionWatcherOptions options;
+    options.reconnectDelay = std::chrono::milliseconds(10);
+    ExecutionWatcher watcher(httpClient, options);
+    ASSERT_TRUE(watcher.waitConnected(std::chrono::seconds(2)));
+    EXPECT_EQ(watcher.watch("exec-1").get().status, "COMPLETED");
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (transport->getRequestCount() < 20 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    auto started = std::chrono::steady_clock::now();
+    watcher.stop();
+    EXPECT_LT(std::chrono::steady_clock::now() - started, std::chrono::seconds(1));
+
+    EXPECT_EQ(httpClient->getCircuitBreaker("/workflows")->getState(), CircuitBreaker::State::Closed);
+    EXPECT_EQ(httpClient->get("/workflows/abc").statusCode, 200);
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_GE(timeouts.size(), 20u);
+    for (int timeout : timeouts) {
+        EXPECT_EQ(timeout, 24 * 3600 * 1000);
+    }
+    EXPECT_EQ(lastEventIds[1], "");
+    EXPECT_EQ(lastEventIds[2], "2");
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include "client/FileWriter.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <unistd.h>
+
+using dataapi::client::detail::FileWriter;
+
+class FileWriterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path = "file_writer_test_" + std::to_string(::getpid()) + ".csv";
+    }
+    void TearDown() override {
+        std::remove(path.c_str());
+    }
+    std::string contents() const {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    std::string path;
+};
+
+TEST_F(FileWriterTest, BuffersSmallWritesAndPassesLargeOnes) {
+    std::string large(64, 'x');
+    {
+        FileWriter writer(path, false, 16);
+        writer.write("abc", 3);
+        EXPECT_EQ(contents(), "");
+        EXPECT_EQ(writer.size(), 3u);
+        writer.write(large.data(), large.size());
+        EXPECT_EQ(contents(), "abc" + large);
+        writer.write("def", 3);
+        writer.flush();
+        EXPECT_EQ(writer.size(), 70u);
+    }
+    EXPECT_EQ(contents(), "abc" + large + "def");
+}
+
+TEST_F(FileWriterTest, AppendsToExistingFileAndRewinds) {
+    std::ofstream(path, std::ios::binary) << "12345";
+    FileWriter writer(path, true, 1024);
+    EXPECT_EQ(writer.size(), 5u);
+    writer.write("678", 3);
+    writer.flush();
+    EXPECT_EQ(contents(), "12345678");
+
+    writer.rewind();
+    EXPECT_EQ(writer.size(), 0u);
+    writer.write("new", 3);
+    writer.flush();
+    EXPECT_EQ(contents(), "new");
+}
+
+TEST_F(FileWriterTest, TruncatesByDefault) {
+    std::ofstream(path, std::ios::binary) << "old content";
+    FileWriter writer(path, false, 1024);
+    EXPECT_EQ(writer.size(), 0u);
+    writer.write("x", 1);
+    writer.flush();
+    EXPECT_EQ(contents(), "x");
+}
+
+TEST_F(FileWriterTest, RewindFailsOnPipe) {
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    {
+        FileWriter writer(fds[1], 1024);
+        writer.write("data", 4);
+        EXPECT_THROW(writer.rewind(), std::runtime_error);
+    }
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include "http/GzipStream.h"
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+using dataapi::http::detail::GzipReader;
+
+static std::string gunzip(const std::string& compressed) {
+    z_stream stream{};
+    inflateInit2(&stream, 15 + 16);
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(compressed.data()));
+    stream.avail_in = static_cast<uInt>(compressed.size());
+    std::string output;
+    char buffer[4096];
+    int result = Z_OK;
+    while (result == Z_OK) {
+        stream.next_out = reinterpret_cast<Bytef*>(buffer);
+        stream.avail_out = sizeof(buffer);
+        result = inflate(&stream, Z_NO_FLUSH);
+        output.append(buffer, sizeof(buffer) - stream.avail_out);
+    }
+    inflateEnd(&stream);
+    EXPECT_EQ(result, Z_STREAM_END);
+    return output;
+}
+
+static GzipReader::Source stringSource(const std::string& data) {
+    return [&data, offset = size_t(0)](char* buffer, size_t size) mutable {
+        size_t count = std::min(size, data.size() - offset);
+        std::memcpy(buffer, data.data() + offset, count);
+        offset += count;
+        return count;
+    };
+}
+
+TEST(GzipStreamTest, RoundTripsWithSmallOutputBuffers) {
+    std::string data;
+    for (int i = 0; i < 50000; ++i) {
+        data += "{\"id\":" + std::to_string(i) + "},";
+    }
+
+    GzipReader reader(stringSource(data));
+    std::string compressed;
+    char chunk[100];
+    size_t count;
+    while ((count = reader.read(chunk, sizeof(chunk))) > 0) {
+        compressed.append(chunk, count);
+    }
+
+    EXPECT_LT(compressed.size(), data.size() / 4);
+    EXPECT_EQ(gunzip(compressed), data);
+    EXPECT_EQ(reader.read(chunk, sizeof(chunk)), 0u);
+}
+
+TEST(GzipStreamTest, CompressesEmptyInput) {
+    std::string empty;
+    GzipReader reader(stringSource(empty));
+    std::string compressed;
+    char chunk[64];
+    size_t count;
+    while ((count = reader.read(chunk, sizeof(chunk))) > 0) {
+        compressed.append(chunk, count);
+    }
+    EXPECT_FALSE(compressed.empty());
+    EXPECT_EQ(gunzip(compressed), "");
+}
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include <set>
+#include "dataapi/http/HostResolver.h"
+
+using dataapi::http::HostResolver;
+
+TEST(HostResolverTest, ResolvesAndCachesLiteralAddresses) {
+    HostResolver resolver;
+    auto addresses = resolver.resolve("127.0.0.1");
+    ASSERT_EQ(addresses.size(), 1u);
+    EXPECT_EQ(addresses[0], "127.0.0.1");
+    EXPECT_EQ(resolver.select("127.0.0.1", 7), "127.0.0.1");
+}
+
+TEST(HostResolverTest, UnresolvableHostYieldsNoAddress) {
+    HostResolver resolver;
+    EXPECT_TRUE(resolver.resolve("does-not-exist.invalid").empty());
+    EXPECT_EQ(resolver.select("does-not-exist.invalid", 0), "");
+}
+
+TEST(HostResolverTest, SelectSkipsUnreachableAddresses) {
+    HostResolver resolver;
+    auto addresses = resolver.resolve("localhost");
+    ASSERT_FALSE(addresses.empty());
+
+    std::string first = resolver.select("localhost", 0);
+    resolver.markUnreachable("localhost", first, std::chrono::milliseconds(60000));
+    if (addresses.size() > 1) {
+        EXPECT_NE(resolver.select("localhost", 0), first);
+    } else {
+        // 唯一的地址不可用时仍然返回它，由连接失败决定结果
+        EXPECT_EQ(resolver.select("localhost", 0), first);
+    }
+}
+
+TEST(HostResolverTest, FormatsConnectToEntries) {
+    EXPECT_EQ(HostResolver::connectTo("api.example.com", "10.0.0.5"), "api.example.com::10.0.0.5:");
+    EXPECT_EQ(HostResolver::connectTo("api.example.com", "2001:db8::1"), "api.example.com::[2001:db8::1]:");
+}
+
+TEST(HostResolverTest, RotatesSlots) {
+    HostResolver resolver;
+    std::set<size_t> slots;
+    for (int i = 0; i < 4; ++i) {
+        slots.insert(resolver.nextSlot());
+    }
+    EXPECT_EQ(slots.size(), 4u);
+}
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include "dataapi/http/HttpClient.h"
+#include "dataapi/http/LoadBalancer.h"
+#include "dataapi/http/Transport.h"
+#include "dataapi/error/DataApiError.h"
+
+using namespace dataapi;
+using namespace dataapi::http;
+
+namespace {
+
+std::vector<ServiceEndpoint> threeEndpoints() {
+    return {{"http://a/api"}, {"http://b/api"}, {"http://c/api"}};
+}
+
+LoadBalancerOptions withPolicy(LoadBalancingPolicy policy) {
+    LoadBalancerOptions options;
+    options.policy = policy;
+    return options;
+}
+
+std::shared_ptr<LoadBalancer> makeBalancer(std::vector<ServiceEndpoint> endpoints, const LoadBalancerOptions& options) {
+    return std::make_shared<LoadBalancer>(std::move(endpoints), options);
+}
+
+std::string host(const TransportRequest& request) {
+    std::string_view url = request.url;
+    url.remove_prefix(url.find("//") + 2);
+    return std::string(url.substr(0, url.find('/')));
+}
+
+} // namespace
+
+TEST(LoadBalancerTest, LeastOutstandingPrefersIdleEndpoints) {
+    auto balancer = makeBalancer(threeEndpoints(), withPolicy(LoadBalancingPolicy::LeastOutstanding));
+    auto first = balancer->acquire();
+    auto second = balancer->acquire();
+    auto third = balancer->acquire();
+    EXPECT_NE(first.getIndex(), second.getIndex());
+    EXPECT_NE(first.getIndex(), third.getIndex());
+    EXPECT_NE(second.getIndex(), third.getIndex());
+
+    size_t idle = second.getIndex();
+    second.complete(5.0, false);
+    EXPECT_EQ(balancer->acquire().getIndex(), idle);
+    EXPECT_EQ(balancer->getStats()[idle].requests, 1u);
+}
+
+TEST(LoadBalancerTest, WeightsShiftTheShareOfRequests) {
+    auto balancer = makeBalancer({{"http://a/api", 3.0}, {"http://b/api", 1.0}},
+                                 withPolicy(LoadBalancingPolicy::PowerOfTwoChoices));
+    // 每个租约都保留到最后，在途数按权重摊开
+    std::vector<LoadBalancer::Lease> leases;
+    for (int i = 0; i < 400; ++i) {
+        leases.push_back(balancer->acquire());
+    }
+    auto stats = balancer->getStats();
+    EXPECT_NEAR(static_cast<double>(stats[0].outstanding) / 400.0, 0.75, 0.03);
+    leases.clear();
+    EXPECT_EQ(balancer->getStats()[0].outstanding, 0);
+}
+
+TEST(LoadBalancerTest, LatencyEwmaAvoidsSlowEndpoints) {
+    auto balancer = makeBalancer({{"http://a/api"}, {"http://b/api"}}, withPolicy(LoadBalancingPolicy::LatencyEwma));
+    // 两个端点都取得样本后，慢端点几乎不再被选中
+    balancer->acquire(0b10).complete(200.0, false);
+    balancer->acquire(0b01).complete(5.0, false);
+    std::map<size_t, int> picks;
+    for (int i = 0; i < 100; ++i) {
+        auto lease = balancer->acquire();
+        ++picks[lease.getIndex()];
+        lease.complete(lease.getIndex() == 0 ? 200.0 : 5.0, false);
+    }
+    EXPECT_EQ(picks[1], 100);
+    EXPECT_NEAR(balancer->getStats()[0].latencyEwma, 200.0, 0.01);
+}
+
+TEST(LoadBalancerTest, AvoidsEndpointsAlreadyTried) {
+    auto balancer = makeBalancer(threeEndpoints(), withPolicy(LoadBalancingPolicy::PowerOfTwoChoices));
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_EQ(balancer->acquire(0b011).getIndex(), 2u);
+    }
+    // 全部尝试过时仍然返回端点
+    EXPECT_TRUE(balancer->acquire(0b111));
+}
+
+TEST(LoadBalancerTest, EjectsAfterConsecutiveFailures) {
+    LoadBalancerOptions options = withPolicy(LoadBalancingPolicy::LeastOutstanding);
+    options.failureThreshold = 2;
+    options.ejectionTime = std::chrono::milliseconds(50);
+    auto balancer = makeBalancer({{"http://a/api"}, {"http://b/api"}}, options);
+
+    balancer->acquire(0b10).complete(1.0, true);
+    EXPECT_TRUE(balancer->getStats()[0].available);
+    balancer->acquire(0b10).complete(1.0, true);
+    EXPECT_FALSE(balancer->getStats()[0].available);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(balancer->acquire().getIndex(), 1u);
+    }
+    EXPECT_EQ(balancer->getStats()[0].failures, 2u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    EXPECT_TRUE(balancer->getStats()[0].available);
+}
+
+TEST(LoadBalancerTest, HealthProbesEjectAndRestore) {
+    std::atomic<bool> bHealthy{false};
+    LoadBalancerOptions options;
+    options.healthCheckInterval = std::chrono::milliseconds(10);
+    auto balancer = makeBalancer({{"http://a/api"}, {"http://b/api"}}, options);
+    balancer->startHealthChecks([&](const std::string& baseUrl) {
+        return baseUrl != "http://b/api" || bHealthy.load();
+    });
+
+    auto waitFor = [&](bool available) {
+        for (int i = 0; i < 200 && balancer->getStats()[1].available != available; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return balancer->getStats()[1].available == available;
+    };
+    ASSERT_TRUE(waitFor(false));
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(balancer->acquire().getIndex(), 0u);
+    }
+    bHealthy = true;
+    EXPECT_TRUE(waitFor(true));
+    balancer.reset(); // 析构时停止探测线程
+}
+
+TEST(LoadBalancerTest, ClientRetriesFailOverToAnotherEndpoint) {
+    std::mutex mutex;
+    std::map<std::string, int> calls;
+    auto transport = std::make_shared<InMemoryTransport>([&](const TransportRequest& request) -> HttpResponse {
+        std::string name = host(request);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++calls[name];
+        }
+        if (name == "a") {
+            throw error::ConnectionError("region a is down");
+        }
+        HttpResponse response;
+        response.statusCode = 200;
+        response.body = "\"" + name + "\"";
+        return response;
+    });
+
+    ClientConfig config("http://a/api");
+    config.transport = transport;
+    config.endpoints = {{"http://a/api"}, {"http://b/api"}};
+    config.loadBalancingPolicy = LoadBalancingPolicy::LeastOutstanding;
+    config.healthCheckIntervalMs = 0;
+    config.endpointFailureThreshold = 1;
+    config.maxRetries = 1;
+    config.retryDelay = 1;
+    HttpClient client(config, nullptr);
+    ASSERT_NE(client.getLoadBalancer(), nullptr);
+
+    // 无论先选中哪个端点，重试都换到b
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(client.get("/workflows").body, "\"b\"");
+        HttpRequestConfig request;
+        request.url = "/workflows";
+        EXPECT_EQ(client.requestAsync(request).get().body, "\"b\"");
+    }
+    // a首次失败后被摘除，之后不再被选中
+    EXPECT_EQ(calls["a"], 1);
+    EXPECT_EQ(calls["b"], 10);
+    auto stats = client.getLoadBalancer()->getStats();
+    EXPECT_FALSE(stats[0].available);
+    EXPECT_EQ(stats[1].outstanding, 0);
+}
+
+TEST(LoadBalancerTest, ClientWithoutEndpointsUsesBaseUrl) {
+    auto transport = std::make_shared<InMemoryTransport>([](const TransportRequest& request) {
+        HttpResponse response;
+        response.statusCode = 200;
+        response.body = "\"" + request.url + "\"";
+        return response;
+    });
+    ClientConfig config("http://sidecar/api");
+    config.transport = transport;
+    HttpClient client(config, nullptr);
+    EXPECT_EQ(client.getLoadBalancer(), nullptr);
+    EXPECT_EQ(client.get("/health").body, "\"http://sidecar/api/health\"");
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "dataapi/client/AiProviderClient.h"
+#include "dataapi/http/Transport.h"
+#include "dataapi/error/DataApiError.h"
+
+using namespace dataapi;
+using namespace dataapi::client;
+using namespace dataapi::http;
+
+namespace {
+
+struct Captured {
+    std::string url;
+    std::string contentType;
+    std::string accept;
+    std::string body;
+};
+
+std::shared_ptr<HttpClient> mediaClient(Captured& captured, std::string responseType, std::string responseBody) {
+    ClientConfig config("http://sidecar/api");
+    config.maxRetries = 0;
+    config.transport = std::make_shared<InMemoryTransport>(
+        [&captured, responseType, responseBody](const TransportRequest& request) {
+            captured.url = request.url;
+            captured.contentType = std::string(request.header("Content-Type"));
+            captured.accept = std::string(request.header("Accept"));
+            captured.body = std::string(request.body);
+            HttpResponse response;
+            response.statusCode = 200;
+            std::string lines = "Content-Type: " + responseType + "\r\nX-Model: tts-1\r\n";
+            for (size_t start = 0, end; (end = lines.find("\r\n", start)) != std::string::npos; start = end + 2) {
+                response.headers.append(lines.data() + start, end + 2 - start);
+            }
+            response.body = responseBody;
+            return response;
+        });
+    return std::make_shared<HttpClient>(config, nullptr);
+}
+
+// 含NUL和高位字节的二进制内容
+const std::string kAudio("RIFF\0\x01\xff\xfe" "data", 12);
+
+} // namespace
+
+TEST(MediaPayloadTest, UploadsRawImageWithoutBase64) {
+    Captured captured;
+    AiProviderClient client(mediaClient(captured, "application/json", R"({"description":"a cat","model":"vision-1"})"));
+    ImageAnalysisOptions options;
+    options.model = "vision-1";
+    auto result = client.analyzeImage("p1", memoryBody(kAudio), "image/png", "what is it", options);
+
+    EXPECT_EQ(result.description, "a cat");
+    EXPECT_EQ(result.model, "vision-1");
+    EXPECT_EQ(captured.body, kAudio);
+    EXPECT_EQ(captured.contentType, "image/png");
+    EXPECT_EQ(captured.url.rfind("http://sidecar/api/ai-providers/p1/analyze/image?", 0), 0u);
+    EXPECT_NE(captured.url.find("prompt=what%20is%20it"), std::string::npos);
+    EXPECT_NE(captured.url.find("model=vision-1"), std::string::npos);
+}
+
+TEST(MediaPayloadTest, UploadsAudioFromFile) {
+    std::string path = ::testing::TempDir() + "media_payload_upload.wav";
+    std::ofstream(path, std::ios::binary) << kAudio;
+    Captured captured;
+    AiProviderClient client(mediaClient(captured, "application/json", R"({"text":"hello","language":"en"})"));
+    auto result = client.speechToText("p1", fileBody(path), "audio/wav");
+
+    EXPECT_EQ(result.text, "hello");
+    EXPECT_EQ(result.language, "en");
+    EXPECT_EQ(captured.body, kAudio);
+    EXPECT_EQ(captured.contentType, "audio/wav");
+    std::remove(path.c_str());
+}
+
+TEST(MediaPayloadTest, DownloadsSpeechIntoCallerBuffer) {
+    Captured captured;
+    AiProviderClient client(mediaClient(captured, "audio/wav", kAudio));
+    char buffer[64];
+    TextToSpeechOptions options;
+    options.voice = "alloy";
+    auto result = client.textToSpeech("p1", "hello", bufferOutput(buffer, sizeof(buffer)), options);
+
+    EXPECT_EQ(captured.accept, "audio/*");
+    EXPECT_EQ(Json::parse(captured.body)["voice"], "alloy");
+    EXPECT_EQ(result.contentType, "audio/wav");
+    EXPECT_EQ(result.model, "tts-1");
+    EXPECT_EQ(result.size, kAudio.size());
+    ASSERT_EQ(result.bytes.data(), buffer);
+    EXPECT_EQ(std::string(result.bytes.data(), result.bytes.size()), kAudio);
+
+    char tooSmall[4];
+    EXPECT_THROW(client.textToSpeech("p1", "hello", bufferOutput(tooSmall, sizeof(tooSmall))), std::length_error);
+}
+
+TEST(MediaPayloadTest, DownloadsImageIntoFile) {
+    std::string path = ::testing::TempDir() + "media_payload_image.png";
+    Captured captured;
+    AiProviderClient client(mediaClient(captured, "image/png", kAudio));
+    ImageGenerationOptions options;
+    options.n = 4;
+    auto result = client.generateImage("p1", "a cat", fileOutput(path), options);
+
+    EXPECT_EQ(captured.accept, "image/*");
+    EXPECT_EQ(Json::parse(captured.body)["n"], 1);
+    EXPECT_EQ(result.size, kAudio.size());
+    EXPECT_EQ(result.bytes.size(), 0u);
+    std::ifstream file(path, std::ios::binary);
+    std::stringstream content;
+    content << file.rdbuf();
+    EXPECT_EQ(content.str(), kAudio);
+    std::remove(path.c_str());
+}
+
+TEST(MediaPayloadTest, RejectsJsonWhereMediaWasRequested) {
+    Captured captured;
+    AiProviderClient client(mediaClient(captured, "application/json", R"({"audioUrl":"https://cdn/a.mp3"})"));
+    char buffer[64];
+    EXPECT_THROW(client.textToSpeech("p1", "hello", bufferOutput(buffer, sizeof(buffer))), error::ValidationError);
+
+    // JSON接口返回媒体的URL
+    auto result = client.textToSpeech("p1", "hello");
+    EXPECT_EQ(result.audioUrl, "https://cdn/a.mp3");
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+#include "dataapi/client/MetadataCache.h"
+
+using dataapi::client::MetadataCache;
+using dataapi::client::MetadataCacheOptions;
+using dataapi::client::MetadataKind;
+
+TEST(MetadataCacheTest, LoadsOnceUntilInvalidated) {
+    MetadataCache cache;
+    int loads = 0;
+    auto load = [&] {
+        ++loads;
+        return std::string("v") + std::to_string(loads);
+    };
+
+    EXPECT_EQ(cache.get<std::string>(MetadataKind::TableSchema, "db1", "users", load), "v1");
+    EXPECT_EQ(cache.get<std::string>(MetadataKind::TableSchema, "db1", "users", load), "v1");
+    EXPECT_EQ(cache.get<std::string>(MetadataKind::TableSchema, "db2", "users", load), "v2");
+
+    // 只影响db1在该类别下的条目
+    cache.invalidate(MetadataKind::TableSchema, "db1");
+    EXPECT_EQ(cache.get<std::string>(MetadataKind::TableSchema, "db1", "users", load), "v3");
+    EXPECT_EQ(cache.get<std::string>(MetadataKind::TableSchema, "db2", "users", load), "v2");
+    EXPECT_EQ(cache.getStats().hits, 2u);
+    EXPECT_EQ(cache.getStats().misses, 3u);
+}
+
+TEST(MetadataCacheTest, ExpiresByKind) {
+    MetadataCacheOptions options;
+    options.workflowTtl = std::chrono::milliseconds(20);
+    options.modelTtl = std::chrono::milliseconds(0);
+    MetadataCache cache(options);
+    int loads = 0;
+    auto load = [&] { return ++loads; };
+
+    cache.get<int>(MetadataKind::Workflow, "w", "", load);
+    cache.get<int>(MetadataKind::Workflow, "w", "", load);
+    EXPECT_EQ(loads, 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    cache.get<int>(MetadataKind::Workflow, "w", "", load);
+    EXPECT_EQ(loads, 2);
+
+    // 有效期为0的类别不缓存
+    cache.get<int>(MetadataKind::ModelList, "p", "", load);
+    cache.get<int>(MetadataKind::ModelList, "p", "", load);
+    EXPECT_EQ(loads, 4);
+}
+
+TEST(MetadataCacheTest, DropsLoadRacingWithInvalidation) {
+    MetadataCache cache;
+    cache.get<std::string>(MetadataKind::ProjectConfig, "p", "", [&] {
+        // 加载期间发生修改，旧值不应写回
+        cache.invalidate(MetadataKind::ProjectConfig, "p");
+        return std::string("stale");
+    });
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.get<std::string>(MetadataKind::ProjectConfig, "p", "", [] { return std::string("fresh"); }), "fresh");
+    EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST(MetadataCacheTest, DoesNotCacheFailuresAndEvicts) {
+    MetadataCacheOptions options;
+    options.shards = 1;
+    options.maxEntries = 2;
+    MetadataCache cache(options);
+
+    EXPECT_THROW(cache.get<int>(MetadataKind::TableList, "db", "", []() -> int {
+        throw std::runtime_error("unavailable");
+    }), std::runtime_error);
+    EXPECT_EQ(cache.size(), 0u);
+
+    for (int i = 0; i < 3; ++i) {
+        cache.get<int>(MetadataKind::TableList, "db" + std::to_string(i), "", [i] { return i; });
+    }
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(cache.getStats().evictions, 1u);
+}
+
+TEST(MetadataCacheTest, PeekAndPutForBatchedLoads) {
+    MetadataCache cache;
+    bool allowed = false;
+    uint64_t generation = 0;
+    EXPECT_FALSE(cache.peek(MetadataKind::ProjectPermissions, "p", "u\nread", allowed, generation));
+    cache.put(MetadataKind::ProjectPermissions, "p", "u\nread", true, generation);
+    ASSERT_TRUE(cache.peek(MetadataKind::ProjectPermissions, "p", "u\nread", allowed, generation));
+    EXPECT_TRUE(allowed);
+
+    // peek之后发生失效，put被丢弃
+    EXPECT_FALSE(cache.peek(MetadataKind::ProjectPermissions, "p", "u\nwrite", allowed, generation));
+    cache.invalidate(MetadataKind::ProjectPermissions, "p");
+    cache.put(MetadataKind::ProjectPermissions, "p", "u\nwrite", true, generation);
+    EXPECT_FALSE(cache.peek(MetadataKind::ProjectPermissions, "p", "u\nwrite", allowed, generation));
+    EXPECT_FALSE(cache.peek(MetadataKind::ProjectPermissions, "p", "u\nread", allowed, generation));
+}
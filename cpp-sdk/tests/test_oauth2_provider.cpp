@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "dataapi/auth/OAuth2AuthProvider.h"
+
+using dataapi::TokenResponse;
+using dataapi::auth::OAuth2AuthProvider;
+using dataapi::auth::OAuth2Options;
+
+namespace {
+
+OAuth2Options foreground() {
+    OAuth2Options options;
+    options.backgroundRefresh = false;
+    return options;
+}
+
+// 每次返回新令牌t1、t2……，有效期为lifetime秒
+OAuth2AuthProvider::TokenFetcher issuer(std::atomic<int>& calls, int lifetime,
+                                        std::chrono::milliseconds latency = std::chrono::milliseconds(0)) {
+    return [&calls, lifetime, latency](const std::string&) {
+        std::this_thread::sleep_for(latency);
+        TokenResponse response;
+        response.accessToken = "t" + std::to_string(++calls);
+        response.refreshToken = "r";
+        response.expiresIn = lifetime;
+        return response;
+    };
+}
+
+} // namespace
+
+TEST(OAuth2AuthProviderTest, SingleFlightsConcurrentRefreshes) {
+    std::atomic<int> calls{0};
+    OAuth2AuthProvider provider(issuer(calls, 3600, std::chrono::milliseconds(100)), foreground());
+    std::vector<std::thread> threads;
+    std::atomic<int> succeeded{0};
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&] {
+            succeeded += provider.refresh() ? 1 : 0;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(calls.load(), 1);
+    EXPECT_EQ(succeeded.load(), 8);
+    EXPECT_EQ(provider.getAuthHeaders()["Authorization"], "Bearer t1");
+}
+
+TEST(OAuth2AuthProviderTest, RefreshesExpiredTokenBeforeRequest) {
+    std::atomic<int> calls{0};
+    OAuth2AuthProvider provider(issuer(calls, 1), foreground());
+    auto first = provider.getRevision();
+    EXPECT_EQ(calls.load(), 1);
+    EXPECT_TRUE(provider.isValid());
+    EXPECT_EQ(provider.getRevision(), first);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    EXPECT_NE(provider.getRevision(), first);
+    EXPECT_EQ(calls.load(), 2);
+    EXPECT_EQ(provider.getAuthHeaders()["Authorization"], "Bearer t2");
+}
+
+TEST(OAuth2AuthProviderTest, RefreshesInBackgroundAheadOfExpiry) {
+    std::atomic<int> calls{0};
+    OAuth2Options options;
+    options.refreshAhead = std::chrono::seconds(60);
+    OAuth2AuthProvider provider(issuer(calls, 1), options);
+    // 有效期短于提前量，过半时刷新
+    std::this_thread::sleep_for(std::chrono::milliseconds(800));
+    EXPECT_GE(calls.load(), 2);
+    EXPECT_TRUE(provider.isValid());
+}
+
+TEST(OAuth2AuthProviderTest, ReplaysOnlyWithNewCredentials) {
+    std::atomic<int> calls{0};
+    bool failing = false;
+    auto fetch = issuer(calls, 3600);
+    OAuth2AuthProvider provider([&](const std::string& refreshToken) {
+        if (failing) {
+            throw std::runtime_error("invalid_grant");
+        }
+        return fetch(refreshToken);
+    }, foreground());
+
+    auto stale = provider.getRevision();
+    ASSERT_TRUE(provider.refresh());
+    // 请求发出后令牌已更新，无需再次刷新
+    EXPECT_TRUE(provider.refreshAfterRejection(stale));
+    EXPECT_EQ(calls.load(), 2);
+
+    failing = true;
+    EXPECT_FALSE(provider.refreshAfterRejection(provider.getRevision()));
+    EXPECT_EQ(provider.getLastError(), "invalid_grant");
+    EXPECT_EQ(provider.getAuthHeaders()["Authorization"], "Bearer t2");
+
+    provider.clearAuthentication();
+    EXPECT_FALSE(provider.refreshAfterRejection(0));
+    EXPECT_TRUE(provider.getAuthHeaders().empty());
+}
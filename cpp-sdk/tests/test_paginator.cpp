@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "dataapi/client/Paginator.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+using dataapi::PageResult;
+using dataapi::client::Paginator;
+using dataapi::client::PaginatorOptions;
+
+// 共totalPages页、每页pageSize个元素的模拟分页接口
+static PageResult<int> makePage(int page, int totalPages, int pageSize) {
+    PageResult<int> result;
+    if (page <= totalPages) {
+        for (int i = 0; i < pageSize; ++i) {
+            result.content.push_back((page - 1) * pageSize + i);
+        }
+    }
+    result.pageNumber = page;
+    result.pageSize = pageSize;
+    result.totalElements = static_cast<long>(totalPages) * pageSize;
+    result.totalPages = totalPages;
+    result.first = page == 1;
+    result.last = page >= totalPages;
+    result.empty = result.content.empty();
+    return result;
+}
+
+TEST(PaginatorTest, IteratesAllItemsInOrder) {
+    std::mutex mutex;
+    std::set<int> requested;
+    Paginator<int> paginator([&](int page) {
+        std::lock_guard<std::mutex> lock(mutex);
+        requested.insert(page);
+        return makePage(page, 5, 3);
+    }, 1, PaginatorOptions{3, 1});
+
+    int expected = 0;
+    for (int value : paginator) {
+        EXPECT_EQ(value, expected++);
+    }
+    EXPECT_EQ(expected, 15);
+    EXPECT_EQ(requested, (std::set<int>{1, 2, 3, 4, 5}));
+}
+
+// 等待fetch被调用到至少count次
+static bool waitForRequests(const std::atomic<int>& requested, int count) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (requested.load() < count && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return requested.load() >= count;
+}
+
+TEST(PaginatorTest, PrefetchesPagesConcurrently) {
+    std::atomic<int> active{0};
+    std::atomic<int> peak{0};
+    std::atomic<int> requested{0};
+    Paginator<int> paginator([&](int page) {
+        ++requested;
+        int now = ++active;
+        int previous = peak.load();
+        while (now > previous && !peak.compare_exchange_weak(previous, now)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        --active;
+        return makePage(page, 8, 2);
+    }, 1, PaginatorOptions{4, 1});
+
+    // 调用方处理第一页时后续页已在请求中
+    PageResult<int> page;
+    ASSERT_TRUE(paginator.nextPage(page));
+    EXPECT_TRUE(waitForRequests(requested, 4));
+
+    EXPECT_EQ(page.content.size() + paginator.collect().size(), 16u);
+    EXPECT_GT(peak.load(), 1);
+    EXPECT_LE(peak.load(), 4);
+}
+
+TEST(PaginatorTest, PrefetchesNextPageWithoutTotalPages) {
+    std::atomic<int> requested{0};
+    Paginator<int> paginator([&](int page) {
+        ++requested;
+        PageResult<int> result = makePage(page, 3, 2);
+        result.totalPages = 0;
+        return result;
+    }, 1, PaginatorOptions{4, 1});
+
+    PageResult<int> page;
+    ASSERT_TRUE(paginator.nextPage(page));
+    EXPECT_TRUE(waitForRequests(requested, 2));
+    EXPECT_EQ(paginator.collect().size(), 4u);
+    EXPECT_EQ(requested.load(), 3);
+}
+
+TEST(PaginatorTest, SinglePageIssuesOneRequest) {
+    std::atomic<int> calls{0};
+    Paginator<int> paginator([&](int page) {
+        ++calls;
+        return makePage(page, 1, 4);
+    }, 1, PaginatorOptions{4, 1});
+
+    EXPECT_EQ(paginator.collect().size(), 4u);
+    EXPECT_EQ(calls.load(), 1);
+}
+
+TEST(PaginatorTest, PropagatesErrorsAndStops) {
+    Paginator<int> paginator([](int page) {
+        if (page == 2) {
+            throw std::runtime_error("boom");
+        }
+        return makePage(page, 3, 1);
+    }, 1, PaginatorOptions{2, 1});
+
+    PageResult<int> page;
+    EXPECT_TRUE(paginator.nextPage(page));
+    EXPECT_THROW(paginator.nextPage(page), std::runtime_error);
+    EXPECT_FALSE(paginator.nextPage(page));
+}
+
+TEST(PaginatorTest, ParsesSpringStylePage) {
+    dataapi::Json json = {
+        {"content", {1, 2}}, {"totalElements", 5}, {"totalPages", 3},
+        {"size", 2}, {"number", 1}, {"first", true}, {"last", false}
+    };
+    PageResult<int> page = dataapi::parsePageResult<int>(json);
+    EXPECT_EQ(page.content, (std::vector<int>{1, 2}));
+    EXPECT_EQ(page.totalElements, 5);
+    EXPECT_EQ(page.totalPages, 3);
+    EXPECT_EQ(page.pageSize, 2);
+    EXPECT_EQ(page.pageNumber, 1);
+    EXPECT_TRUE(page.first);
+    EXPECT_FALSE(page.last);
+    EXPECT_FALSE(page.empty);
+}
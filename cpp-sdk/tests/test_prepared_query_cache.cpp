@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include "client/PreparedQueryCache.h"
+
+using dataapi::client::PreparedQuery;
+using dataapi::client::detail::PreparedQueryCache;
+
+namespace {
+
+PreparedQueryCache::Factory factory(const std::string& databaseId, const std::string& sql, int& created) {
+    return [databaseId, sql, &created] {
+        ++created;
+        return std::make_shared<PreparedQuery>(nullptr, databaseId, sql);
+    };
+}
+
+} // namespace
+
+TEST(PreparedQueryCacheTest, ReusesHandlesPerDatabaseAndSql) {
+    PreparedQueryCache cache(8);
+    int created = 0;
+    auto first = cache.get("db1", "SELECT 1", factory("db1", "SELECT 1", created));
+    auto again = cache.get("db1", "SELECT 1", factory("db1", "SELECT 1", created));
+    auto other = cache.get("db2", "SELECT 1", factory("db2", "SELECT 1", created));
+    EXPECT_EQ(first, again);
+    EXPECT_NE(first, other);
+    EXPECT_EQ(created, 2);
+    EXPECT_EQ(first->getStatementId(), "");
+}
+
+TEST(PreparedQueryCacheTest, EvictsLeastRecentlyUsed) {
+    PreparedQueryCache cache(2);
+    int created = 0;
+    auto a = cache.get("db", "a", factory("db", "a", created));
+    cache.get("db", "b", factory("db", "b", created));
+    cache.get("db", "a", factory("db", "a", created));
+    cache.get("db", "c", factory("db", "c", created));
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(created, 3);
+
+    // b已被淘汰，a仍被复用
+    EXPECT_EQ(cache.get("db", "a", factory("db", "a", created)), a);
+    cache.get("db", "b", factory("db", "b", created));
+    EXPECT_EQ(created, 4);
+
+    cache.erase("db", "a");
+    cache.get("db", "a", factory("db", "a", created));
+    EXPECT_EQ(created, 5);
+}
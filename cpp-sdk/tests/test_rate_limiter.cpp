@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include "dataapi/http/RateLimiter.h"
+#include "dataapi/client/AiProviderClient.h"
+#include <chrono>
+
+using dataapi::http::RateLimiter;
+
+TEST(RateLimiterTest, AllowsBurstThenReservesAtRate) {
+    RateLimiter limiter(10.0, 3.0);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(limiter.reserve(), RateLimiter::Clock::duration::zero());
+    }
+    EXPECT_FALSE(limiter.tryAcquire());
+
+    // 预支令牌后等待时间按顺序递增
+    auto first = limiter.reserve();
+    auto second = limiter.reserve();
+    EXPECT_GT(first, std::chrono::milliseconds(50));
+    EXPECT_LE(first, std::chrono::milliseconds(100));
+    EXPECT_GT(second, first + std::chrono::milliseconds(50));
+}
+
+TEST(RateLimiterTest, ZeroRateIsUnlimited) {
+    RateLimiter limiter(0.0, 1.0);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(limiter.tryAcquire());
+    }
+    EXPECT_EQ(limiter.reserve(5.0), RateLimiter::Clock::duration::zero());
+}
+
+TEST(RateLimiterTest, SetRateCapsTokens) {
+    RateLimiter limiter(1.0, 10.0);
+    limiter.setRate(2.0, 2.0);
+    EXPECT_DOUBLE_EQ(limiter.getRate(), 2.0);
+    EXPECT_LE(limiter.getTokens(), 2.0);
+}
+
+TEST(RateLimiterTest, BuildsLimitersFromQuota) {
+    using dataapi::client::AiProviderClient;
+    dataapi::AiQuotaSettings settings{120, 0, "minute", {}};
+    EXPECT_DOUBLE_EQ(AiProviderClient::rateLimiterFor(settings)->getRate(), 2.0);
+    settings.period = "fortnight";
+    EXPECT_THROW(AiProviderClient::rateLimiterFor(settings), std::invalid_argument);
+
+    dataapi::AiQuotaInfo exhausted{0, 0, std::chrono::system_clock::now() + std::chrono::seconds(10)};
+    auto limiter = AiProviderClient::rateLimiterFor(exhausted);
+    EXPECT_FALSE(limiter->tryAcquire());
+    EXPECT_GT(limiter->reserve(), std::chrono::seconds(5));
+}
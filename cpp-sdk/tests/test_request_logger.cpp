@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "http/RequestLogger.h"
+#include "http/Transfer.h"
+#include "dataapi/http/Transport.h"
+#include "dataapi/auth/AuthenticationProvider.h"
+#include "dataapi/error/DataApiError.h"
+
+using namespace dataapi;
+using namespace dataapi::http;
+using http::detail::LogRecord;
+using http::detail::RequestLogger;
+
+namespace {
+
+struct Lines {
+    std::mutex mutex;
+    std::vector<Json> parsed;
+
+    RequestLogger::Sink sink() {
+        return [this](const std::string& line) {
+            std::lock_guard<std::mutex> lock(mutex);
+            parsed.push_back(Json::parse(line));
+        };
+    }
+};
+
+ClientConfig loggingConfig(Lines& lines, std::shared_ptr<Transport> transport) {
+    ClientConfig config("http://sidecar/api");
+    config.transport = std::move(transport);
+    config.enableLogging = true;
+    config.logSink = lines.sink();
+    config.retryDelay = 1;
+    config.maxRetries = 0;
+    return config;
+}
+
+HttpResponse respond(int status, std::string body) {
+    HttpResponse response;
+    response.statusCode = status;
+    response.body = std::move(body);
+    return response;
+}
+
+} // namespace
+
+TEST(RequestLoggerTest, SamplesTheExactRate) {
+    RequestLogger logger(8, [](const std::string&) {});
+    int hits = 0;
+    for (int i = 0; i < 1000; ++i) {
+        hits += logger.sample(0.25) ? 1 : 0;
+    }
+    EXPECT_EQ(hits, 250);
+    EXPECT_TRUE(logger.sample(1.0));
+    EXPECT_FALSE(logger.sample(0.0));
+}
+
+TEST(RequestLoggerTest, FormatsRedactsAndTruncates) {
+    auto block = std::make_shared<http::detail::HeaderBlock>();
+    block->fields = {{"X-Service-Token", "secret"}, {"X-Tenant", "t1"}, {"Accept", "text/plain"}};
+    block->authCount = 1;
+
+    LogRecord record;
+    record.method = HttpMethod::POST;
+    record.url = "http://sidecar/api/workflows";
+    record.requestHeaders = {{"Accept", "application/json"}, {"cookie", "session=1"}};
+    record.clientHeaders = block;
+    record.requestBody = "0123";
+    record.requestBytes = 10;
+    record.statusCode = 201;
+    record.responseBody = "ok";
+    record.responseBytes = 2;
+
+    Json line = Json::parse(RequestLogger::format(record));
+    EXPECT_EQ(line["method"], "POST");
+    EXPECT_EQ(line["url"], "http://sidecar/api/workflows");
+    EXPECT_EQ(line["status"], 201);
+    EXPECT_EQ(line["requestHeaders"]["X-Service-Token"], "[REDACTED]");
+    EXPECT_EQ(line["requestHeaders"]["cookie"], "[REDACTED]");
+    EXPECT_EQ(line["requestHeaders"]["X-Tenant"], "t1");
+    EXPECT_EQ(line["requestHeaders"]["Accept"], "application/json");
+    EXPECT_EQ(line["requestBody"], "0123");
+    EXPECT_TRUE(line["requestTruncated"].get<bool>());
+    EXPECT_EQ(line["requestBytes"], 10);
+    EXPECT_FALSE(line["responseTruncated"].get<bool>());
+    EXPECT_EQ(line["time"].get<std::string>().size(), 24u);
+
+    // 截断落在多字节字符中间时替换无效字节
+    record.responseBody = std::string("\xe4\xb8", 2);
+    EXPECT_NO_THROW(Json::parse(RequestLogger::format(record)));
+}
+
+TEST(RequestLoggerTest, DropsWhenTheBufferIsFull) {
+    std::mutex mutex;
+    std::condition_variable released;
+    bool open = false;
+    auto logger = std::make_shared<RequestLogger>(2, [&](const std::string&) {
+        std::unique_lock<std::mutex> lock(mutex);
+        released.wait(lock, [&] { return open; });
+    });
+
+    ClientConfig config("http://sidecar");
+    HttpRequestConfig request;
+    request.url = "/health";
+    HttpResponse response = respond(200, "");
+    // 第一条被写入线程取出后阻塞在sink中，随后两条填满缓冲区
+    for (int i = 0; i < 10; ++i) {
+        RequestLogger::complete(logger->begin(config, request, "http://sidecar/health", {}), &response, nullptr);
+    }
+    EXPECT_GE(logger->getDropped(), 7u);
+    EXPECT_LE(logger->getDropped(), 8u);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        open = true;
+    }
+    released.notify_all();
+    logger->flush();
+}
+
+TEST(RequestLoggerTest, LogsRequestsThroughTheClient) {
+    Lines lines;
+    auto transport = std::make_shared<InMemoryTransport>([](const TransportRequest& request) -> HttpResponse {
+        if (request.target() == "/api/down") {
+            throw error::ConnectionError("sidecar is down");
+        }
+        return respond(200, std::string(1000, 'x'));
+    });
+    ClientConfig config = loggingConfig(lines, transport);
+    config.logMaxBodyBytes = 16;
+    HttpClient client(config, std::make_shared<auth::ApiKeyAuthProvider>("key-123"));
+
+    client.post("/workflows", Json{{"name", "nightly"}});
+    EXPECT_THROW(client.get("/down"), error::ConnectionError);
+    client.requestAsync(HttpRequestConfig{}).get();
+    client.flushLogs();
+
+    std::lock_guard<std::mutex> lock(lines.mutex);
+    ASSERT_EQ(lines.parsed.size(), 3u);
+    const Json& posted = lines.parsed[0];
+    EXPECT_EQ(posted["url"], "http://sidecar/api/workflows");
+    EXPECT_EQ(posted["requestBody"], R"({"name":"nightly)");
+    EXPECT_EQ(posted["requestBytes"], 18);
+    EXPECT_EQ(posted["responseBody"], std::string(16, 'x'));
+    EXPECT_EQ(posted["responseBytes"], 1000);
+    EXPECT_TRUE(posted["responseTruncated"].get<bool>());
+    for (const auto& header : posted["requestHeaders"].items()) {
+        EXPECT_EQ(header.value().get<std::string>().find("key-123"), std::string::npos) << header.key();
+    }
+    EXPECT_EQ(lines.parsed[1]["error"], "sidecar is down");
+    EXPECT_FALSE(lines.parsed[1].contains("status"));
+    EXPECT_EQ(client.getDroppedLogCount(), 0u);
+}
+
+TEST(RequestLoggerTest, HonoursSampleRateAndRuntimeToggle) {
+    Lines lines;
+    auto transport = std::make_shared<InMemoryTransport>([](const TransportRequest&) {
+        return respond(200, "{}");
+    });
+    ClientConfig config = loggingConfig(lines, transport);
+    config.enableLogging = false;
+    HttpClient client(config, nullptr);
+    client.get("/a");
+
+    config.enableLogging = true;
+    config.logSampleRate = 0.5;
+    client.updateConfig(config);
+    for (int i = 0; i < 10; ++i) {
+        client.get("/b");
+    }
+    client.flushLogs();
+
+    std::lock_guard<std::mutex> lock(lines.mutex);
+    EXPECT_EQ(lines.parsed.size(), 5u);
+}
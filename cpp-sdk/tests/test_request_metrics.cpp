@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "dataapi/http/RequestMetrics.h"
+
+using dataapi::http::LatencyHistogram;
+using dataapi::http::RequestEvent;
+using dataapi::http::RequestMetrics;
+using dataapi::http::RequestObserver;
+
+TEST(LatencyHistogramTest, PercentilesWithinBucketError) {
+    LatencyHistogram histogram;
+    for (uint64_t micros = 1; micros <= 10000; ++micros) {
+        histogram.record(micros);
+    }
+
+    EXPECT_EQ(histogram.getCount(), 10000u);
+    EXPECT_NEAR(histogram.getMean(), 5.0005, 1e-6);
+    EXPECT_DOUBLE_EQ(histogram.getMax(), 10.0);
+    EXPECT_NEAR(histogram.getPercentile(0.5), 5.0, 5.0 * 0.125);
+    EXPECT_NEAR(histogram.getPercentile(0.99), 9.9, 9.9 * 0.125);
+    EXPECT_DOUBLE_EQ(histogram.getPercentile(1.0), 10.0);
+
+    histogram.reset();
+    EXPECT_EQ(histogram.getCount(), 0u);
+    EXPECT_DOUBLE_EQ(histogram.getPercentile(0.5), 0.0);
+}
+
+TEST(RequestMetricsTest, NormalizeEndpoint) {
+    EXPECT_EQ(RequestMetrics::normalizeEndpoint("/api/workflows/42/executions?page=1"),
+              "/api/workflows/{id}/executions");
+    EXPECT_EQ(RequestMetrics::normalizeEndpoint("/api/users/550e8400-e29b-41d4-a716-446655440000"),
+              "/api/users/{id}");
+    EXPECT_EQ(RequestMetrics::normalizeEndpoint("/api/projects/"), "/api/projects/");
+}
+
+namespace {
+struct CountingObserver : RequestObserver {
+    int calls = 0;
+    int lastStatus = 0;
+    void onRequestComplete(const RequestEvent& event) override {
+        ++calls;
+        lastStatus = event.statusCode;
+    }
+};
+}
+
+TEST(RequestMetricsTest, RecordsStatsAndNotifiesObservers) {
+    RequestMetrics metrics;
+    auto observer = std::make_shared<CountingObserver>();
+    metrics.addObserver(observer);
+
+    RequestEvent event;
+    event.method = dataapi::HttpMethod::GET;
+    event.endpoint = "/api/health";
+    event.statusCode = 200;
+    event.stats.totalTime = 12.5;
+    event.stats.downloadSize = 128;
+    metrics.record(event);
+
+    EXPECT_EQ(observer->calls, 1);
+    EXPECT_EQ(observer->lastStatus, 200);
+    EXPECT_DOUBLE_EQ(metrics.getLastStats().totalTime, 12.5);
+    EXPECT_EQ(metrics.getLastStats().downloadSize, 128);
+    EXPECT_EQ(metrics.total.getCount(), 1u);
+
+    metrics.removeObserver(observer);
+    metrics.record(event);
+    EXPECT_EQ(observer->calls, 1);
+}
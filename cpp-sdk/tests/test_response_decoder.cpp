@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include "client/ResponseDecoder.h"
+#include "dataapi/error/DataApiError.h"
+
+using namespace dataapi;
+using client::detail::decode;
+using client::detail::decodePage;
+using client::detail::expectStatus;
+
+static http::HttpResponse makeResponse(int statusCode, std::string body) {
+    http::HttpResponse response;
+    response.statusCode = statusCode;
+    response.body = std::move(body);
+    return response;
+}
+
+TEST(ResponseDecoderTest, MapsStatusCodesToErrors) {
+    EXPECT_NO_THROW(expectStatus(makeResponse(200, ""), 200, "failed"));
+    EXPECT_THROW(expectStatus(makeResponse(400, ""), 200, "failed"), error::ValidationError);
+    EXPECT_THROW(expectStatus(makeResponse(401, ""), 200, "failed"), error::AuthenticationError);
+    EXPECT_THROW(expectStatus(makeResponse(403, ""), 200, "failed"), error::AuthorizationError);
+    EXPECT_THROW(expectStatus(makeResponse(409, ""), 200, "failed"), error::ConflictError);
+    EXPECT_THROW(expectStatus(makeResponse(429, ""), 200, "failed"), error::RateLimitError);
+    EXPECT_THROW(expectStatus(makeResponse(503, ""), 200, "failed"), error::ServiceUnavailableError);
+
+    try {
+        expectStatus(makeResponse(404, ""), 200, "failed", "Workflow not found: w1");
+        FAIL();
+    } catch (const error::NotFoundError& e) {
+        EXPECT_STREQ(e.what(), "Workflow not found: w1");
+    }
+
+    try {
+        expectStatus(makeResponse(500, "{\"message\":\"boom\"}"), 200, "failed");
+        FAIL();
+    } catch (const error::HttpError& e) {
+        EXPECT_EQ(e.getStatusCode(), 500);
+        EXPECT_EQ(e.getResponseBody()["message"], "boom");
+    }
+}
+
+TEST(ResponseDecoderTest, DecodesQueryResult) {
+    auto result = decode<QueryResult>(makeResponse(
+        200, R"({"rows":[{"id":1},{"id":2}],"columns":["id"],"totalRows":2,"metadata":{"ms":3}})"));
+    ASSERT_EQ(result.rows.size(), 2u);
+    EXPECT_EQ(result.rows[1]["id"], 2);
+    EXPECT_EQ(result.columns, std::vector<std::string>{"id"});
+    EXPECT_EQ(result.totalRows, 2);
+    EXPECT_EQ(result.metadata["ms"], 3);
+}
+
+TEST(ResponseDecoderTest, DecodesBinaryEncodedBodiesByContentType) {
+    Json document = {
+        {"rows", {{{"id", 1}, {"score", 0.5}}, {{"id", 2}, {"score", 1.25}}}},
+        {"columns", {"id", "score"}},
+        {"totalRows", 2},
+        {"metadata", Json::object()}
+    };
+    auto binary = [](const std::vector<uint8_t>& bytes) { return std::string(bytes.begin(), bytes.end()); };
+
+    for (const auto& [contentType, body] : std::vector<std::pair<std::string, std::string>>{
+             {"application/msgpack", binary(Json::to_msgpack(document))},
+             {"application/x-msgpack; charset=binary", binary(Json::to_msgpack(document))},
+             {"application/CBOR", binary(Json::to_cbor(document))}}) {
+        auto response = makeResponse(200, body);
+        std::string header = "Content-Type: " + contentType + "\r\n";
+        response.headers.append(header.data(), header.size());
+        auto result = decode<QueryResult>(std::move(response));
+        ASSERT_EQ(result.rows.size(), 2u) << contentType;
+        EXPECT_EQ(result.rows[1]["score"], 1.25);
+        EXPECT_EQ(result.totalRows, 2);
+    }
+
+    auto error = makeResponse(500, binary(Json::to_msgpack(Json{{"message", "boom"}})));
+    std::string header = "Content-Type: application/msgpack\r\n";
+    error.headers.append(header.data(), header.size());
+    try {
+        expectStatus(error, 200, "failed");
+        FAIL();
+    } catch (const error::HttpError& e) {
+        EXPECT_EQ(e.getResponseBody()["message"], "boom");
+    }
+}
+
+TEST(ResponseDecoderTest, DecodesWorkflowPage) {
+    auto page = decodePage<SysWorkflow>(makeResponse(200, R"({
+        "content": [{"id": "w1", "name": "etl", "definition": "{}", "projectId": "p", "userId": "u", "version": 2}],
+        "totalElements": 1, "totalPages": 1, "size": 20, "number": 1, "first": true, "last": true
+    })"));
+    ASSERT_EQ(page.content.size(), 1u);
+    const SysWorkflow& workflow = page.content[0];
+    EXPECT_EQ(workflow.id, "w1");
+    EXPECT_EQ(workflow.name, "etl");
+    EXPECT_EQ(workflow.definition, "{}");
+    EXPECT_FALSE(workflow.description.has_value());
+    EXPECT_EQ(workflow.version, 2);
+    EXPECT_TRUE(page.last);
+}
+
+TEST(ResponseDecoderTest, MovesJsonPayloadIntoRequest) {
+    Json input = {{"rows", Json::array({1, 2, 3})}};
+    const auto* rows = &input["rows"].get_ref<const Json::array_t&>();
+    auto request = client::detail::jsonRequest(HttpMethod::POST, "/workflows/w1/execute", std::move(input));
+    EXPECT_EQ(&request.data["rows"].get_ref<const Json::array_t&>(), rows);
+    EXPECT_EQ(request.url, "/workflows/w1/execute");
+}
+
+TEST(ResponseDecoderTest, AppliesRawRequestBody) {
+    HttpRequestConfig config;
+    RequestBody::raw("{\"a\":1}", "application/x-ndjson").applyTo(config);
+    EXPECT_EQ(config.body, "{\"a\":1}");
+    EXPECT_TRUE(config.data.is_null());
+    EXPECT_EQ(config.headers["Content-Type"], "application/x-ndjson");
+
+    HttpRequestConfig jsonConfig;
+    RequestBody(Json{{"a", 1}}).applyTo(jsonConfig);
+    EXPECT_EQ(jsonConfig.data["a"], 1);
+    EXPECT_TRUE(jsonConfig.body.empty());
+}
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include "dataapi/http/ResponseHeaders.h"
+#include <cstring>
+
+using dataapi::http::ResponseHeaders;
+
+static void appendLine(ResponseHeaders& headers, const char* line) {
+    headers.append(line, std::strlen(line));
+}
+
+TEST(ResponseHeadersTest, ParsesAndTrimsFields) {
+    ResponseHeaders headers;
+    appendLine(headers, "HTTP/1.1 200 OK\r\n");
+    appendLine(headers, "Content-Type:  application/json \r\n");
+    appendLine(headers, "X-Request-Id: abc\r\n");
+    appendLine(headers, "\r\n");
+
+    ASSERT_EQ(headers.size(), 2u);
+    EXPECT_EQ(headers.nameAt(0), "Content-Type");
+    EXPECT_EQ(headers.valueAt(0), "application/json");
+    EXPECT_EQ(headers.toMap().at("X-Request-Id"), "abc");
+}
+
+TEST(ResponseHeadersTest, LookupIsCaseInsensitive) {
+    ResponseHeaders headers;
+    appendLine(headers, "retry-after: 5\r\n");
+
+    auto value = headers.get("Retry-After");
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(*value, "5");
+    EXPECT_TRUE(headers.contains("RETRY-AFTER"));
+    EXPECT_FALSE(headers.get("ETag").has_value());
+}
+
+TEST(ResponseHeadersTest, StatusLineResetsPreviousResponse) {
+    ResponseHeaders headers;
+    appendLine(headers, "HTTP/1.1 100 Continue\r\n");
+    appendLine(headers, "X-Interim: 1\r\n");
+    appendLine(headers, "HTTP/1.1 200 OK\r\n");
+    appendLine(headers, "X-Final: 2\r\n");
+
+    ASSERT_EQ(headers.size(), 1u);
+    EXPECT_FALSE(headers.contains("X-Interim"));
+    EXPECT_EQ(*headers.get("x-final"), "2");
+}
+
+TEST(ResponseHeadersTest, ViewsSurviveMove) {
+    ResponseHeaders headers;
+    appendLine(headers, "A: 1\r\n");
+    ResponseHeaders moved = std::move(headers);
+    EXPECT_EQ(*moved.get("a"), "1");
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "dataapi/error/DataApiError.h"
+#include "dataapi/http/HttpClient.h"
+#include "dataapi/http/RetryPolicy.h"
+#include "dataapi/http/Transport.h"
+
+using dataapi::HttpMethod;
+using dataapi::HttpRequestConfig;
+using dataapi::http::RetryBudget;
+using dataapi::http::RetryPolicy;
+
+static HttpRequestConfig makeRequest(HttpMethod method) {
+    HttpRequestConfig request;
+    request.method = method;
+    request.url = "/test";
+    return request;
+}
+
+TEST(RetryPolicyTest, IdempotencyByMethod) {
+    EXPECT_TRUE(RetryPolicy::isIdempotent(makeRequest(HttpMethod::GET)));
+    EXPECT_TRUE(RetryPolicy::isIdempotent(makeRequest(HttpMethod::PUT)));
+    EXPECT_TRUE(RetryPolicy::isIdempotent(makeRequest(HttpMethod::DELETE)));
+    EXPECT_FALSE(RetryPolicy::isIdempotent(makeRequest(HttpMethod::POST)));
+    EXPECT_FALSE(RetryPolicy::isIdempotent(makeRequest(HttpMethod::PATCH)));
+
+    auto post = makeRequest(HttpMethod::POST);
+    post.idempotent = true;
+    EXPECT_TRUE(RetryPolicy::isIdempotent(post));
+}
+
+TEST(RetryPolicyTest, RetryableStatusCodes) {
+    RetryPolicy policy(RetryPolicy::Settings{});
+    auto get = makeRequest(HttpMethod::GET);
+    auto post = makeRequest(HttpMethod::POST);
+
+    EXPECT_TRUE(policy.shouldRetryStatus(get, 503));
+    EXPECT_TRUE(policy.shouldRetryStatus(get, 502));
+    EXPECT_FALSE(policy.shouldRetryStatus(get, 404));
+    EXPECT_TRUE(policy.shouldRetryStatus(post, 429));
+    EXPECT_FALSE(policy.shouldRetryStatus(post, 502));
+}
+
+TEST(RetryPolicyTest, ConnectionErrorsRetryNonIdempotent) {
+    RetryPolicy policy(RetryPolicy::Settings{});
+    auto post = makeRequest(HttpMethod::POST);
+
+    EXPECT_TRUE(policy.shouldRetryError(post, dataapi::error::ConnectionError("connect failed")));
+    EXPECT_FALSE(policy.shouldRetryError(post, dataapi::error::TimeoutError("timed out", 1000)));
+    EXPECT_TRUE(policy.shouldRetryError(makeRequest(HttpMethod::GET),
+                                        dataapi::error::TimeoutError("timed out", 1000)));
+}
+
+TEST(RetryPolicyTest, DecorrelatedJitterStaysInBounds) {
+    RetryPolicy::Settings settings;
+    settings.baseDelayMs = 100;
+    settings.maxDelayMs = 1000;
+    RetryPolicy policy(settings);
+
+    std::chrono::milliseconds delay(0);
+    for (int i = 0; i < 100; ++i) {
+        auto next = policy.nextDelay(delay);
+        EXPECT_GE(next.count(), 100);
+        EXPECT_LE(next.count(), std::max<long long>(100, delay.count() * 3));
+        EXPECT_LE(next.count(), 1000);
+        delay = next;
+    }
+}
+
+TEST(RetryPolicyTest, ParseRetryAfter) {
+    auto seconds = RetryPolicy::parseRetryAfter(" 5 ");
+    ASSERT_TRUE(seconds.has_value());
+    EXPECT_EQ(seconds->count(), 5000);
+
+    auto past = RetryPolicy::parseRetryAfter("Wed, 21 Oct 2015 07:28:00 GMT");
+    ASSERT_TRUE(past.has_value());
+    EXPECT_EQ(past->count(), 0);
+
+    EXPECT_FALSE(RetryPolicy::parseRetryAfter("soon").has_value());
+}
+
+TEST(RetryBudgetTest, LimitsRetriesToRatio) {
+    RetryBudget budget(0.5, 2);
+    EXPECT_TRUE(budget.tryAcquire());
+    EXPECT_TRUE(budget.tryAcquire());
+    EXPECT_FALSE(budget.tryAcquire());
+
+    budget.recordRequest();
+    EXPECT_FALSE(budget.tryAcquire());
+    budget.recordRequest();
+    EXPECT_TRUE(budget.tryAcquire());
+}
+
+TEST(RetryPolicyTest, CancelInterruptsBackoff) {
+    dataapi::ClientConfig config("http://sidecar/api");
+    auto transport = std::make_shared<dataapi::http::InMemoryTransport>([](const dataapi::http::TransportRequest&) {
+        dataapi::http::HttpResponse response;
+        response.statusCode = 503;
+        return response;
+    });
+    config.transport = transport;
+    config.maxRetries = 3;
+    config.retryDelay = 10000;
+    config.maxRetryDelay = 30000;
+    dataapi::http::HttpClient client(config, nullptr);
+
+    auto cancel = std::make_shared<std::atomic<bool>>(false);
+    HttpRequestConfig request = makeRequest(HttpMethod::GET);
+    request.cancel = cancel;
+    std::thread canceller([cancel] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        cancel->store(true);
+    });
+    auto start = std::chrono::steady_clock::now();
+    try {
+        client.request(request);
+        ADD_FAILURE() << "request was not cancelled";
+    } catch (const dataapi::error::DataApiError& e) {
+        EXPECT_EQ(e.getCode(), "REQUEST_CANCELLED");
+    }
+    canceller.join();
+    // 退避为10秒，取消后不等待退避结束
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+    EXPECT_EQ(transport->getRequestCount(), 1u);
+}
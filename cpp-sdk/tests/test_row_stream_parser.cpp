@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include "client/RowStreamParser.h"
+#include <map>
+#include <string>
+#include <vector>
+
+using dataapi::client::detail::RowStreamParser;
+
+namespace {
+struct Collector {
+    std::vector<std::string> rows;
+    std::map<std::string, std::string> fields;
+
+    RowStreamParser parser() {
+        return RowStreamParser(
+            "rows",
+            [this](std::string_view text) {
+                rows.emplace_back(text);
+                return true;
+            },
+            [this](const std::string& name, std::string_view text) {
+                fields[name] = std::string(text);
+            });
+    }
+};
+}
+
+static const std::string kBody =
+    R"({"columns": ["id", "name"], "rows": [{"id": 1, "name": "a,]}"}, )"
+    R"({"id": 2, "name": "b\"c"}, [3, {"x": [4]}]], "totalRows": 3, "metadata": {"ms": 5}})";
+
+TEST(RowStreamParserTest, SplitsRowsAndFields) {
+    Collector collector;
+    auto parser = collector.parser();
+    ASSERT_TRUE(parser.feed(kBody.data(), kBody.size()));
+    EXPECT_TRUE(parser.isComplete());
+
+    ASSERT_EQ(collector.rows.size(), 3u);
+    EXPECT_EQ(collector.rows[0], R"({"id": 1, "name": "a,]}"})");
+    EXPECT_EQ(collector.rows[1], R"({"id": 2, "name": "b\"c"})");
+    EXPECT_EQ(collector.rows[2], R"([3, {"x": [4]}])");
+    EXPECT_EQ(collector.fields["columns"], R"(["id", "name"])");
+    EXPECT_EQ(collector.fields["totalRows"], "3");
+    EXPECT_EQ(collector.fields["metadata"], R"({"ms": 5})");
+}
+
+TEST(RowStreamParserTest, HandlesArbitraryChunkBoundaries) {
+    Collector whole;
+    auto reference = whole.parser();
+    reference.feed(kBody.data(), kBody.size());
+
+    Collector split;
+    auto parser = split.parser();
+    for (char c : kBody) {
+        ASSERT_TRUE(parser.feed(&c, 1));
+    }
+    EXPECT_TRUE(parser.isComplete());
+    EXPECT_EQ(split.rows, whole.rows);
+    EXPECT_EQ(split.fields, whole.fields);
+}
+
+TEST(RowStreamParserTest, StopsWhenHandlerReturnsFalse) {
+    int seen = 0;
+    RowStreamParser parser("rows", [&seen](std::string_view) { return ++seen < 2; }, nullptr);
+    EXPECT_FALSE(parser.feed(kBody.data(), kBody.size()));
+    EXPECT_EQ(seen, 2);
+    EXPECT_FALSE(parser.isComplete());
+}
+
+TEST(RowStreamParserTest, RejectsMalformedInput) {
+    RowStreamParser parser("rows", [](std::string_view) { return true; }, nullptr);
+    const std::string body = R"({"rows": [1}])";
+    EXPECT_THROW(parser.feed(body.data(), body.size()), std::runtime_error);
+}
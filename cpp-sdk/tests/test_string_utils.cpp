@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "dataapi/utils/StringUtils.h"
+
+using dataapi::utils::StringUtils;
+
+namespace {
+
+std::vector<std::string> collect(std::string_view str, char delimiter) {
+    std::vector<std::string> pieces;
+    for (std::string_view piece : StringUtils::splitView(str, delimiter)) {
+        pieces.emplace_back(piece);
+    }
+    return pieces;
+}
+
+} // namespace
+
+TEST(StringUtilsTest, SplitViewMatchesSplit) {
+    for (const std::string str : {"", "a", "a,b,c", ",a", "a,", "a,,", ",,", "gzip, deflate, br"}) {
+        EXPECT_EQ(collect(str, ','), StringUtils::split(str, ',')) << str;
+    }
+    EXPECT_EQ(StringUtils::split("a,,b,", ','), (std::vector<std::string>{"a", "", "b"}));
+    EXPECT_TRUE(StringUtils::split("", ',').empty());
+}
+
+TEST(StringUtilsTest, SplitsIntoCallerArray) {
+    std::string_view pieces[3];
+    EXPECT_EQ(StringUtils::splitInto("a;b", ';', pieces, 3), 2u);
+    EXPECT_EQ(pieces[0], "a");
+    EXPECT_EQ(pieces[1], "b");
+
+    // 分段多于数组长度时最后一个元素为剩余部分
+    EXPECT_EQ(StringUtils::splitInto("a;b;c;d", ';', pieces, 3), 3u);
+    EXPECT_EQ(pieces[2], "c;d");
+    EXPECT_EQ(StringUtils::splitInto("", ';', pieces, 3), 0u);
+}
+
+TEST(StringUtilsTest, TrimsWithoutCopying) {
+    std::string header = " \t text/html \r\n";
+    std::string_view trimmed = StringUtils::trimView(header);
+    EXPECT_EQ(trimmed, "text/html");
+    EXPECT_EQ(trimmed.data(), header.data() + 3);
+    EXPECT_EQ(StringUtils::trim(" \r\n "), "");
+    EXPECT_TRUE(StringUtils::isBlank("\t "));
+    EXPECT_FALSE(StringUtils::isBlank(" x "));
+}
+
+TEST(StringUtilsTest, ConvertsAsciiCaseAcrossBlocks) {
+    // 超过一个16字节块，含边界字符和非ASCII字节
+    std::string mixed = "Content-Type@[`{AZaz09 \xC3\x89t\xC3\xA9 X-REQUEST-ID";
+    EXPECT_EQ(StringUtils::toLower(mixed), "content-type@[`{azaz09 \xC3\x89t\xC3\xA9 x-request-id");
+    EXPECT_EQ(StringUtils::toUpper(mixed), "CONTENT-TYPE@[`{AZAZ09 \xC3\x89T\xC3\xA9 X-REQUEST-ID");
+
+    std::string inPlace = "ABC";
+    StringUtils::toLowerInPlace(inPlace);
+    EXPECT_EQ(inPlace, "abc");
+    EXPECT_TRUE(StringUtils::equalsIgnoreCase("Content-Length", "content-LENGTH"));
+    EXPECT_FALSE(StringUtils::equalsIgnoreCase("Content-Length", "Content-Lengt"));
+    EXPECT_FALSE(StringUtils::equalsIgnoreCase("[", "{"));
+}
+
+TEST(StringUtilsTest, ReplacesInOnePass) {
+    EXPECT_EQ(StringUtils::replace("a-b-c", "-", "--"), "a--b--c");
+    EXPECT_EQ(StringUtils::replace("aaa", "aa", "b"), "ba");
+    EXPECT_EQ(StringUtils::replace("abc", "", "x"), "abc");
+    EXPECT_EQ(StringUtils::replace("abc", "abc", ""), "");
+
+    std::string out = "x=";
+    StringUtils::appendReplaced(out, "1 2 3", " ", "+");
+    EXPECT_EQ(out, "x=1+2+3");
+    EXPECT_TRUE(StringUtils::startsWith("Bearer abc", "Bearer "));
+    EXPECT_TRUE(StringUtils::endsWith("file.json", ".json"));
+    EXPECT_FALSE(StringUtils::endsWith("json", ".json"));
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+#include "dataapi/coro/Task.h"
+
+using dataapi::coro::Executor;
+using dataapi::coro::Task;
+
+namespace {
+
+Task<int> answer() {
+    co_return 42;
+}
+
+Task<int> doubled() {
+    int value = co_await answer();
+    co_return value * 2;
+}
+
+Task<void> fails() {
+    throw std::runtime_error("boom");
+    co_return;
+}
+
+Task<std::thread::id> currentThread() {
+    co_return std::this_thread::get_id();
+}
+
+/**
+ * 每个任务在新线程上运行的执行器
+ */
+Executor newThread(std::thread& worker) {
+    return [&worker](std::function<void()> task) {
+        worker = std::thread(std::move(task));
+    };
+}
+
+} // namespace
+
+TEST(TaskTest, ChainsAndReturnsValues) {
+    EXPECT_EQ(dataapi::coro::syncWait(doubled()), 84);
+}
+
+TEST(TaskTest, PropagatesExceptions) {
+    EXPECT_THROW(dataapi::coro::syncWait(fails()), std::runtime_error);
+}
+
+TEST(TaskTest, IsLazyUntilAwaited) {
+    bool started = false;
+    auto task = [&]() -> Task<void> {
+        started = true;
+        co_return;
+    }();
+    EXPECT_FALSE(started);
+    dataapi::coro::syncWait(std::move(task));
+    EXPECT_TRUE(started);
+}
+
+TEST(TaskTest, ResumesOnExecutor) {
+    std::thread worker;
+    auto resumed = [&]() -> Task<std::thread::id> {
+        co_await dataapi::coro::on(newThread(worker), answer());
+        co_return co_await currentThread();
+    };
+    auto future = dataapi::coro::spawn(resumed());
+    auto id = future.get();
+    worker.join();
+    EXPECT_NE(id, std::this_thread::get_id());
+}
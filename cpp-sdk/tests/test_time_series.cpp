@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <mutex>
+#include <set>
+#include <string>
+#include "dataapi/client/DatabaseClient.h"
+#include "dataapi/client/AiProviderClient.h"
+#include "dataapi/client/TimeSeriesTracker.h"
+#include "dataapi/http/Transport.h"
+#include "dataapi/error/DataApiError.h"
+
+using namespace dataapi;
+using namespace dataapi::client;
+using namespace dataapi::http;
+
+namespace {
+
+int64_t queryParam(const std::string& url, const std::string& name) {
+    size_t pos = url.find(name + "=");
+    if (pos == std::string::npos) {
+        return -1;
+    }
+    return std::stoll(url.substr(pos + name.size() + 1));
+}
+
+/**
+ * 按请求的[start, end)返回每step毫秒一个点的序列，值为时间戳/1000
+ */
+std::shared_ptr<HttpClient> seriesClient(std::set<std::string>& urls, std::mutex& mutex, int64_t step) {
+    ClientConfig config("http://sidecar/api");
+    config.maxRetries = 0;
+    config.transport = std::make_shared<InMemoryTransport>([&urls, &mutex, step](const TransportRequest& request) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            urls.insert(request.url);
+        }
+        int64_t start = queryParam(request.url, "start");
+        int64_t end = queryParam(request.url, "end");
+        std::string timestamps;
+        std::string values;
+        for (int64_t t = (start + step - 1) / step * step; t < end; t += step) {
+            timestamps += (timestamps.empty() ? "" : ",") + std::to_string(t);
+            values += (values.empty() ? "" : ",") + std::to_string(t / 1000);
+        }
+        HttpResponse response;
+        response.statusCode = 200;
+        response.body = R"({"timestamps":[)" + timestamps + R"(],"values":{"cpu":[)" + values + "]}}";
+        return response;
+    });
+    return std::make_shared<HttpClient>(config, nullptr);
+}
+
+} // namespace
+
+TEST(TimeSeriesTest, ParsesColumnsWithoutDom) {
+    auto series = TimeSeries::parse(R"({
+        "database": {"id": "db1", "tags": ["a", null, true]},
+        "timestamps": [1000, 2000, 3000],
+        "values": {"cpu": [0.5, null, 1.5], "qps": [10, 20]}
+    })");
+
+    ASSERT_EQ(series.size(), 3u);
+    EXPECT_EQ(series.getTimestamps()[2], 3000);
+    EXPECT_EQ(series.getFields(), (std::vector<std::string>{"cpu", "qps"}));
+    auto cpu = series.getValues("cpu");
+    EXPECT_DOUBLE_EQ(cpu[0], 0.5);
+    EXPECT_TRUE(std::isnan(cpu[1]));
+    EXPECT_DOUBLE_EQ(cpu[2], 1.5);
+    auto qps = series.getValues("qps");
+    ASSERT_EQ(qps.size(), 3u);
+    EXPECT_DOUBLE_EQ(qps[1], 20);
+    EXPECT_TRUE(std::isnan(qps[2]));
+    EXPECT_EQ(series.getValues("missing").size(), 0u);
+}
+
+TEST(TimeSeriesTest, RejectsMalformedResponses) {
+    EXPECT_THROW(TimeSeries::parse(R"({"timestamps":[2000, 1000],"values":{}})"), std::invalid_argument);
+    EXPECT_THROW(TimeSeries::parse(R"({"timestamps":["1000"],"values":{}})"), std::invalid_argument);
+    EXPECT_THROW(TimeSeries::parse(R"({"timestamps":[1000],"values":{"cpu":{"v":1}}})"), std::invalid_argument);
+    EXPECT_THROW(TimeSeries::parse(R"({"timestamps":[1000],)"), std::invalid_argument);
+    EXPECT_TRUE(TimeSeries::parse(R"({"timestamps":[],"values":{}})").empty());
+}
+
+TEST(TimeSeriesTest, AppendsTruncatesAndDrops) {
+    TimeSeries series;
+    series.appendPoint(1000);
+    series.setValue("cpu", 1);
+    series.appendPoint(2000);
+    series.setValue("cpu", 2);
+    EXPECT_THROW(series.appendPoint(2000), std::invalid_argument);
+
+    // 重叠的点被跳过，新字段之前的点为NaN
+    auto tail = TimeSeries::parse(R"({"timestamps":[2000,3000],"values":{"cpu":[9,3],"mem":[7,8]}})");
+    series.append(tail);
+    ASSERT_EQ(series.size(), 3u);
+    EXPECT_DOUBLE_EQ(series.getValues("cpu")[1], 2);
+    EXPECT_DOUBLE_EQ(series.getValues("cpu")[2], 3);
+    EXPECT_TRUE(std::isnan(series.getValues("mem")[1]));
+    EXPECT_DOUBLE_EQ(series.getValues("mem")[2], 8);
+
+    series.truncateFrom(2500);
+    EXPECT_EQ(series.lastTimestamp(), 2000);
+    series.dropBefore(1500);
+    ASSERT_EQ(series.size(), 1u);
+    EXPECT_EQ(series.getTimestamps()[0], 2000);
+    EXPECT_DOUBLE_EQ(series.getValues("cpu")[0], 2);
+}
+
+TEST(TimeSeriesTest, FetchesAlignedWindowsConcurrently) {
+    std::set<std::string> urls;
+    std::mutex mutex;
+    DatabaseClient client(seriesClient(urls, mutex, 1000));
+    TimeSeriesOptions options;
+    options.step = std::chrono::seconds(1);
+    options.window = std::chrono::milliseconds(2500); // 向上取整为3秒
+    auto series = client.getMetricsSeries("db1", fromUnixMillis(1500), fromUnixMillis(10000), options);
+
+    EXPECT_EQ(urls, (std::set<std::string>{
+        "http://sidecar/api/databases/db1/metrics/series?end=3000&start=1500&step=1000",
+        "http://sidecar/api/databases/db1/metrics/series?end=6000&start=3000&step=1000",
+        "http://sidecar/api/databases/db1/metrics/series?end=9000&start=6000&step=1000",
+        "http://sidecar/api/databases/db1/metrics/series?end=10000&start=9000&step=1000",
+    }));
+    ASSERT_EQ(series.size(), 8u);
+    for (size_t i = 0; i < series.size(); ++i) {
+        EXPECT_EQ(series.getTimestamps()[i], static_cast<int64_t>(i + 2) * 1000);
+        EXPECT_DOUBLE_EQ(series.getValues("cpu")[i], static_cast<double>(i + 2));
+    }
+    EXPECT_TRUE(client.getMetricsSeries("db1", fromUnixMillis(5000), fromUnixMillis(5000)).empty());
+}
+
+TEST(TimeSeriesTest, PropagatesWindowFailures) {
+    ClientConfig config("http://sidecar/api");
+    config.maxRetries = 0;
+    config.transport = std::make_shared<InMemoryTransport>([](const TransportRequest&) {
+        HttpResponse response;
+        response.statusCode = 404;
+        response.body = R"({"message":"not found"})";
+        return response;
+    });
+    AiProviderClient client(std::make_shared<HttpClient>(config, nullptr));
+    TimeSeriesOptions options;
+    options.window = std::chrono::seconds(1);
+    EXPECT_THROW(client.getUsageSeries("p1", fromUnixMillis(0), fromUnixMillis(5000), options), error::DataApiError);
+}
+
+TEST(TimeSeriesTest, TrackerRefreshesIncrementally) {
+    std::set<std::string> urls;
+    std::mutex mutex;
+    AiProviderClient client(seriesClient(urls, mutex, 1000));
+    TimeSeriesOptions options;
+    options.step = std::chrono::seconds(1);
+    options.window = std::chrono::hours(1);
+    auto tracker = client.trackUsage("p1", std::chrono::seconds(5), options);
+
+    const TimeSeries& first = tracker.refresh(fromUnixMillis(10500));
+    ASSERT_EQ(first.size(), 5u);
+    EXPECT_EQ(first.getTimestamps()[0], 6000);
+    EXPECT_EQ(first.lastTimestamp(), 10000);
+
+    // 只获取从最后一个桶开始的增量，滑出范围的点被丢弃
+    urls.clear();
+    const TimeSeries& second = tracker.refresh(fromUnixMillis(12500));
+    EXPECT_EQ(urls, (std::set<std::string>{
+        "http://sidecar/api/ai-providers/p1/usage/series?end=12500&start=10000&step=1000"}));
+    ASSERT_EQ(second.size(), 5u);
+    EXPECT_EQ(second.getTimestamps()[0], 8000);
+    EXPECT_EQ(second.lastTimestamp(), 12000);
+    EXPECT_DOUBLE_EQ(second.getValues("cpu")[4], 12);
+}
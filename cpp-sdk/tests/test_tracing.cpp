@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "dataapi/http/Tracing.h"
+#include "dataapi/http/Transport.h"
+#include "dataapi/error/DataApiError.h"
+
+using namespace dataapi;
+using namespace dataapi::http;
+
+namespace {
+
+class CollectingExporter : public SpanExporter {
+public:
+    void exportSpan(const TraceSpan& span) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        spans.push_back(span);
+    }
+
+    std::vector<TraceSpan> take() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return std::move(spans);
+    }
+
+private:
+    std::mutex mutex;
+    std::vector<TraceSpan> spans;
+};
+
+struct Seen {
+    std::mutex mutex;
+    std::vector<std::string> traceparents;
+    std::vector<std::string> tracestates;
+};
+
+std::shared_ptr<InMemoryTransport> recordingTransport(Seen& seen, int status = 200) {
+    return std::make_shared<InMemoryTransport>([&seen, status](const TransportRequest& request) -> HttpResponse {
+        if (request.target() == "/api/down") {
+            throw error::ConnectionError("sidecar is down");
+        }
+        std::lock_guard<std::mutex> lock(seen.mutex);
+        seen.traceparents.emplace_back(request.header("traceparent"));
+        seen.tracestates.emplace_back(request.header("tracestate"));
+        HttpResponse response;
+        response.statusCode = status;
+        response.body = "{}";
+        return response;
+    });
+}
+
+ClientConfig tracingConfig(std::shared_ptr<Transport> transport, std::shared_ptr<SpanExporter> exporter) {
+    ClientConfig config("http://sidecar/api");
+    config.transport = std::move(transport);
+    config.spanExporter = std::move(exporter);
+    config.maxRetries = 0;
+    return config;
+}
+
+const char* kParent = "00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01";
+
+} // namespace
+
+TEST(TracingTest, ParsesAndFormatsTraceparent) {
+    auto context = TraceContext::parse(kParent, "vendor=abc");
+    ASSERT_TRUE(context);
+    EXPECT_EQ(context->traceId, "4bf92f3577b34da6a3ce929d0e0e4736");
+    EXPECT_EQ(context->spanId, "00f067aa0ba902b7");
+    EXPECT_TRUE(context->sampled);
+    EXPECT_EQ(context->traceState, "vendor=abc");
+    EXPECT_EQ(context->traceparent(), kParent);
+
+    auto child = context->child();
+    EXPECT_EQ(child.traceId, context->traceId);
+    EXPECT_NE(child.spanId, context->spanId);
+    EXPECT_EQ(child.spanId.size(), 16u);
+    EXPECT_EQ(child.traceState, "vendor=abc");
+
+    // 未来版本可以追加字段
+    EXPECT_TRUE(TraceContext::parse("01-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-00-extra"));
+    EXPECT_FALSE(TraceContext::parse("00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01-extra"));
+    EXPECT_FALSE(TraceContext::parse("ff-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01"));
+    EXPECT_FALSE(TraceContext::parse("00-00000000000000000000000000000000-00f067aa0ba902b7-01"));
+    EXPECT_FALSE(TraceContext::parse("00-4BF92F3577B34DA6A3CE929D0E0E4736-00f067aa0ba902b7-01"));
+    EXPECT_FALSE(TraceContext::parse("00-4bf92f3577b34da6a3ce929d0e0e4736-0000000000000000-01"));
+    EXPECT_FALSE(TraceContext::parse(""));
+}
+
+TEST(TracingTest, RootSamplingFollowsTheRate) {
+    int sampled = 0;
+    for (int i = 0; i < 4000; ++i) {
+        auto context = TraceContext::root(0.25);
+        EXPECT_EQ(context.traceId.size(), 32u);
+        sampled += context.sampled ? 1 : 0;
+    }
+    EXPECT_NEAR(sampled, 1000, 150);
+    EXPECT_TRUE(TraceContext::root(1.0).sampled);
+    EXPECT_FALSE(TraceContext::root(0.0).sampled);
+}
+
+TEST(TracingTest, ScopesNestAndRestore) {
+    EXPECT_EQ(TraceContext::current(), nullptr);
+    {
+        TraceScope outer(*TraceContext::parse(kParent));
+        ASSERT_NE(TraceContext::current(), nullptr);
+        {
+            TraceScope inner(TraceContext::current()->child());
+            EXPECT_NE(TraceContext::current()->spanId, "00f067aa0ba902b7");
+        }
+        EXPECT_EQ(TraceContext::current()->spanId, "00f067aa0ba902b7");
+    }
+    EXPECT_EQ(TraceContext::current(), nullptr);
+}
+
+TEST(TracingTest, InjectsChildContextAndExportsSpans) {
+    Seen seen;
+    auto exporter = std::make_shared<CollectingExporter>();
+    HttpClient client(tracingConfig(recordingTransport(seen), exporter), nullptr);
+    {
+        TraceScope scope(*TraceContext::parse(kParent, "vendor=abc"));
+        client.get("/workflows/42");
+        client.requestAsync(HttpRequestConfig{}).get();
+        EXPECT_THROW(client.get("/down"), error::ConnectionError);
+    }
+
+    ASSERT_EQ(seen.traceparents.size(), 2u);
+    auto sent = TraceContext::parse(seen.traceparents[0]);
+    ASSERT_TRUE(sent);
+    EXPECT_EQ(sent->traceId, "4bf92f3577b34da6a3ce929d0e0e4736");
+    EXPECT_TRUE(sent->sampled);
+    EXPECT_EQ(seen.tracestates[0], "vendor=abc");
+
+    auto spans = exporter->take();
+    ASSERT_EQ(spans.size(), 3u);
+    EXPECT_EQ(spans[0].name, "GET /workflows/{id}");
+    EXPECT_EQ(spans[0].context.spanId, sent->spanId);
+    EXPECT_EQ(spans[0].parentSpanId, "00f067aa0ba902b7");
+    EXPECT_EQ(spans[0].statusCode, 200);
+    EXPECT_EQ(spans[0].url, "http://sidecar/api/workflows/42");
+    EXPECT_GE(spans[0].endTime, spans[0].startTime);
+    EXPECT_EQ(spans[2].error, "sidecar is down");
+    EXPECT_EQ(spans[2].statusCode, 0);
+}
+
+TEST(TracingTest, StartsRootTracesAndHonoursSampling) {
+    Seen seen;
+    auto exporter = std::make_shared<CollectingExporter>();
+    ClientConfig config = tracingConfig(recordingTransport(seen), exporter);
+    config.traceSampleRate = 0.0;
+    HttpClient client(config, nullptr);
+    client.get("/workflows");
+
+    // 未采样的trace仍向服务端传递，sampled标志为0
+    ASSERT_EQ(seen.traceparents.size(), 1u);
+    auto sent = TraceContext::parse(seen.traceparents[0]);
+    ASSERT_TRUE(sent);
+    EXPECT_FALSE(sent->sampled);
+    EXPECT_TRUE(exporter->take().empty());
+
+    // 调用方自行设置traceparent时不改写
+    HttpRequestConfig request;
+    request.url = "/workflows";
+    request.headers["traceparent"] = kParent;
+    client.request(request);
+    EXPECT_EQ(seen.traceparents[1], kParent);
+}
+
+TEST(TracingTest, DisabledTracingSendsNoHeaders) {
+    Seen seen;
+    HttpClient client(tracingConfig(recordingTransport(seen), nullptr), nullptr);
+    client.get("/workflows");
+    ASSERT_EQ(seen.traceparents.size(), 1u);
+    EXPECT_EQ(seen.traceparents[0], "");
+
+    // 没有导出器时只传递上游上下文
+    TraceScope scope(*TraceContext::parse(kParent));
+    client.get("/workflows");
+    EXPECT_EQ(TraceContext::parse(seen.traceparents[1])->traceId, "4bf92f3577b34da6a3ce929d0e0e4736");
+}
+
+TEST(TracingTest, ConvertsSpansToOtlpJson) {
+    TraceSpan span;
+    span.name = "GET /workflows/{id}";
+    span.context = *TraceContext::parse(kParent);
+    span.parentSpanId = "b7ad6b7169203331";
+    span.method = HttpMethod::GET;
+    span.url = "https://api.example.com/workflows/42";
+    span.endpoint = "/workflows/{id}";
+    span.statusCode = 503;
+    span.startTime = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000));
+    span.endTime = span.startTime + std::chrono::milliseconds(12);
+    span.stats.nameLookupTime = 1.0;
+    span.stats.connectTime = 2.0;
+    span.stats.startTransferTime = 10.0;
+
+    Json otlp = toOtlpJson({span}, "billing");
+    const Json& resource = otlp["resourceSpans"][0];
+    EXPECT_EQ(resource["resource"]["attributes"][0]["value"]["stringValue"], "billing");
+    const Json& exported = resource["scopeSpans"][0]["spans"][0];
+    EXPECT_EQ(exported["traceId"], "4bf92f3577b34da6a3ce929d0e0e4736");
+    EXPECT_EQ(exported["parentSpanId"], "b7ad6b7169203331");
+    EXPECT_EQ(exported["kind"], 3);
+    EXPECT_EQ(exported["startTimeUnixNano"], "1700000000000000000");
+    EXPECT_EQ(exported["endTimeUnixNano"], "1700000000012000000");
+    EXPECT_EQ(exported["status"]["code"], 2);
+    ASSERT_EQ(exported["events"].size(), 3u); // 未发生TLS握手
+    EXPECT_EQ(exported["events"][0]["name"], "dns");
+    EXPECT_EQ(exported["events"][0]["timeUnixNano"], "1700000000001000000");
+    EXPECT_EQ(exported["events"][2]["name"], "first_byte");
+    bool hasStatus = false;
+    for (const auto& attribute : exported["attributes"]) {
+        if (attribute["key"] == "http.response.status_code") {
+            hasStatus = attribute["value"]["intValue"] == "503";
+        }
+    }
+    EXPECT_TRUE(hasStatus);
+}
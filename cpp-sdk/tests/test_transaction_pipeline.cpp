@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include "client/TransactionPipeline.h"
+
+using dataapi::Json;
+using dataapi::client::detail::TransactionPipeline;
+
+namespace {
+
+Json resultsFor(size_t count, const std::string& transactionId = "tx1") {
+    Json response;
+    response["transactionId"] = transactionId;
+    response["results"] = Json::array();
+    for (size_t i = 0; i < count; ++i) {
+        response["results"].push_back({{"rows", Json::array({{{"n", i}}})}, {"columns", {"n"}}, {"totalRows", 1}, {"metadata", Json::object()}});
+    }
+    return response;
+}
+
+} // namespace
+
+TEST(TransactionPipelineTest, CoalescesStatementsWhileABatchIsInFlight) {
+    TransactionPipeline pipeline(false);
+    auto first = pipeline.add("INSERT 1", {{"a", "1"}});
+    auto batch = pipeline.takeBatch();
+    ASSERT_TRUE(batch);
+    EXPECT_TRUE((*batch)["begin"].get<bool>());
+    EXPECT_FALSE((*batch)["commit"].get<bool>());
+    EXPECT_EQ((*batch)["statements"][0]["params"]["a"], "1");
+
+    auto second = pipeline.add("INSERT 2", {});
+    auto third = pipeline.add("INSERT 3", {});
+    pipeline.requestCommit();
+    EXPECT_FALSE(pipeline.takeBatch());
+
+    pipeline.complete(resultsFor(1));
+    EXPECT_EQ(first.get().totalRows, 1);
+    EXPECT_EQ(pipeline.getTransactionId(), "tx1");
+
+    // 剩余语句与commit合并为一个批次
+    batch = pipeline.takeBatch();
+    ASSERT_TRUE(batch);
+    EXPECT_FALSE((*batch)["begin"].get<bool>());
+    EXPECT_EQ((*batch)["transactionId"], "tx1");
+    EXPECT_TRUE((*batch)["commit"].get<bool>());
+    EXPECT_EQ((*batch)["statements"].size(), 2u);
+    EXPECT_FALSE(pipeline.isCommitted());
+
+    pipeline.complete(resultsFor(2));
+    EXPECT_EQ(third.get().rows[0]["n"], 1);
+    EXPECT_TRUE(pipeline.isCommitted());
+    EXPECT_NO_THROW(pipeline.waitCommitted());
+    EXPECT_THROW(pipeline.add("INSERT 4", {}).get(), std::exception);
+}
+
+TEST(TransactionPipelineTest, BundlesTheWholeTransactionIntoOneBatch) {
+    TransactionPipeline pipeline(true);
+    auto first = pipeline.add("UPDATE a", {});
+    auto second = pipeline.add("UPDATE b", {});
+    EXPECT_FALSE(pipeline.takeBatch());
+
+    pipeline.requestCommit();
+    auto batch = pipeline.takeBatch();
+    ASSERT_TRUE(batch);
+    EXPECT_TRUE((*batch)["begin"].get<bool>());
+    EXPECT_TRUE((*batch)["commit"].get<bool>());
+    EXPECT_EQ((*batch)["statements"].size(), 2u);
+
+    pipeline.complete(resultsFor(2));
+    EXPECT_TRUE(pipeline.isCommitted());
+    EXPECT_FALSE(pipeline.takeBatch());
+}
+
+TEST(TransactionPipelineTest, CommitWithoutStatementsSendsNothing) {
+    TransactionPipeline pipeline(false);
+    pipeline.requestCommit();
+    EXPECT_FALSE(pipeline.takeBatch());
+    EXPECT_TRUE(pipeline.isCommitted());
+}
+
+TEST(TransactionPipelineTest, FailurePropagatesToQueuedStatementsAndCommit) {
+    TransactionPipeline pipeline(false);
+    auto first = pipeline.add("INSERT 1", {});
+    ASSERT_TRUE(pipeline.takeBatch());
+    auto second = pipeline.add("INSERT 2", {});
+
+    pipeline.fail(std::make_exception_ptr(std::runtime_error("constraint violated")));
+    EXPECT_THROW(first.get(), std::runtime_error);
+    EXPECT_THROW(second.get(), std::runtime_error);
+    EXPECT_FALSE(pipeline.takeBatch());
+
+    pipeline.requestCommit();
+    EXPECT_THROW(pipeline.waitCommitted(), std::runtime_error);
+}
+
+TEST(TransactionPipelineTest, RejectsMismatchedResultCount) {
+    TransactionPipeline pipeline(false);
+    auto first = pipeline.add("INSERT 1", {});
+    auto second = pipeline.add("INSERT 2", {});
+    ASSERT_TRUE(pipeline.takeBatch());
+    pipeline.complete(resultsFor(1));
+    EXPECT_THROW(first.get(), std::runtime_error);
+    EXPECT_THROW(second.get(), std::runtime_error);
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include "dataapi/http/HttpClient.h"
+#include "dataapi/http/Transport.h"
+#include "dataapi/error/DataApiError.h"
+
+using namespace dataapi;
+using namespace dataapi::http;
+
+namespace {
+
+HttpResponse respond(int status, std::string body) {
+    HttpResponse response;
+    response.statusCode = status;
+    response.body = std::move(body);
+    return response;
+}
+
+ClientConfig transportConfig(std::shared_ptr<Transport> transport) {
+    ClientConfig config("http://sidecar/api");
+    config.transport = std::move(transport);
+    config.retryDelay = 1;
+    config.setDefaultHeader("X-Tenant", "t1");
+    return config;
+}
+
+} // namespace
+
+TEST(TransportTest, TargetStripsSchemeAndAuthority) {
+    TransportRequest request;
+    request.url = "http://sidecar:8080/api/workflows?page=1";
+    EXPECT_EQ(request.target(), "/api/workflows?page=1");
+    request.url = "http://sidecar";
+    EXPECT_EQ(request.target(), "/");
+    request.headers = {{"Content-Type", "application/json"}};
+    EXPECT_EQ(request.header("content-type"), "application/json");
+    EXPECT_EQ(request.header("Accept"), "");
+}
+
+TEST(TransportTest, SendsMergedRequestThroughTransport) {
+    TransportRequest seen;
+    std::string body;
+    auto transport = std::make_shared<InMemoryTransport>([&](const TransportRequest& request) {
+        seen.method = request.method;
+        seen.url = request.url;
+        seen.headers = request.headers;
+        body = std::string(request.body);
+        return respond(201, R"({"id":"wf-1"})");
+    });
+    HttpClient client(transportConfig(transport), nullptr);
+
+    HttpRequestConfig request;
+    request.method = HttpMethod::POST;
+    request.url = "/workflows";
+    request.params = {{"dryRun", "a b"}};
+    request.headers = {{"x-tenant", "t2"}};
+    request.data = {{"name", "nightly"}};
+    auto response = client.request(request);
+
+    EXPECT_EQ(response.statusCode, 201);
+    EXPECT_EQ(response.body, R"({"id":"wf-1"})");
+    EXPECT_EQ(seen.method, HttpMethod::POST);
+    EXPECT_EQ(seen.url, "http://sidecar/api/workflows?dryRun=a%20b");
+    EXPECT_EQ(seen.header("X-Tenant"), "t2");
+    EXPECT_EQ(seen.header("Content-Type"), "application/json");
+    EXPECT_EQ(body, R"({"name":"nightly"})");
+    EXPECT_EQ(transport->getRequestCount(), 1u);
+}
+
+TEST(TransportTest, RetriesServerErrorsAndRecordsMetrics) {
+    std::atomic<int> calls{0};
+    auto transport = std::make_shared<InMemoryTransport>([&](const TransportRequest&) {
+        return ++calls < 3 ? respond(503, "") : respond(200, "[]");
+    });
+    HttpClient client(transportConfig(transport), nullptr);
+
+    auto response = client.get("/workflows");
+    EXPECT_EQ(response.statusCode, 200);
+    EXPECT_EQ(calls.load(), 3);
+}
+
+TEST(TransportTest, TransportErrorsPropagateAfterRetries) {
+    auto transport = std::make_shared<InMemoryTransport>([](const TransportRequest&) -> HttpResponse {
+        throw error::ConnectionError("sidecar is down");
+    });
+    HttpClient client(transportConfig(transport), nullptr);
+
+    EXPECT_THROW(client.get("/workflows"), error::ConnectionError);
+    EXPECT_EQ(transport->getRequestCount(), 4u); // 首次 + maxRetries(3)
+}
+
+TEST(TransportTest, AsyncRequestsKeepTheirBodyUntilCompletion) {
+    auto transport = std::make_shared<InMemoryTransport>([](const TransportRequest& request) {
+        return respond(200, std::string(request.body));
+    });
+    HttpClient client(transportConfig(transport), nullptr);
+
+    HttpRequestConfig request;
+    request.method = HttpMethod::PUT;
+    request.url = "/workflows/1";
+    request.body = "payload";
+    auto future = client.requestAsync(std::move(request));
+    EXPECT_EQ(future.get().body, "payload");
+}
+
+TEST(TransportTest, SuccessfulBodiesGoToTheSink) {
+    auto transport = std::make_shared<InMemoryTransport>([](const TransportRequest&) {
+        return respond(200, "a,b\n1,2\n");
+    });
+    HttpClient client(transportConfig(transport), nullptr);
+
+    HttpRequestConfig request;
+    request.method = HttpMethod::GET;
+    request.url = "/export";
+    std::string received;
+    int startedWith = 0;
+    auto response = client.request(request,
+        [&](const char* data, size_t size) {
+            received.append(data, size);
+            return true;
+        },
+        [&](int status, const ResponseHeaders&) { startedWith = status; });
+
+    EXPECT_EQ(received, "a,b\n1,2\n");
+    EXPECT_EQ(startedWith, 200);
+    EXPECT_TRUE(response.body.empty());
+}
+
+TEST(TransportTest, NegotiatesBinaryEncodingForMarkedRequests) {
+    std::vector<std::string> accepts;
+    auto transport = std::make_shared<InMemoryTransport>([&](const TransportRequest& request) {
+        accepts.emplace_back(request.header("Accept"));
+        return respond(200, "{}");
+    });
+    ClientConfig config = transportConfig(transport);
+    config.wireFormat = WireFormat::MessagePack;
+    HttpClient client(config, nullptr);
+
+    HttpRequestConfig request;
+    request.method = HttpMethod::POST;
+    request.url = "/databases/db/execute";
+    client.request(request);
+    request.binaryResponse = true;
+    client.request(request);
+    request.headers["Accept"] = "application/json";
+    client.request(request);
+
+    ASSERT_EQ(accepts.size(), 3u);
+    EXPECT_EQ(accepts[0], "");
+    EXPECT_EQ(accepts[1], "application/msgpack, application/json;q=0.5");
+    EXPECT_EQ(accepts[2], "application/json");
+}
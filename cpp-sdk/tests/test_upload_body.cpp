@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include "dataapi/http/UploadBody.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+
+using dataapi::http::UploadBody;
+
+static std::string drain(UploadBody& body, size_t chunk) {
+    std::string output;
+    std::string buffer(chunk, '\0');
+    while (size_t count = body.source(&buffer[0], buffer.size())) {
+        output.append(buffer.data(), count);
+    }
+    return output;
+}
+
+class UploadBodyTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path = "upload_body_test_" + std::to_string(::getpid()) + ".csv";
+        for (int i = 0; i < 5000; ++i) {
+            content += std::to_string(i) + ",row" + std::to_string(i) + "\n";
+        }
+        std::ofstream(path, std::ios::binary) << content;
+    }
+    void TearDown() override {
+        std::remove(path.c_str());
+    }
+
+    std::string path;
+    std::string content;
+};
+
+TEST_F(UploadBodyTest, ReadsMemoryInChunks) {
+    UploadBody body = dataapi::http::memoryBody(content);
+    EXPECT_EQ(body.length, static_cast<int64_t>(content.size()));
+    EXPECT_EQ(drain(body, 7), content);
+    char byte;
+    EXPECT_EQ(body.source(&byte, 1), 0u);
+}
+
+TEST_F(UploadBodyTest, ReadsFile) {
+    UploadBody body = dataapi::http::fileBody(path);
+    EXPECT_EQ(body.length, static_cast<int64_t>(content.size()));
+    EXPECT_EQ(drain(body, 4096), content);
+}
+
+TEST_F(UploadBodyTest, ReadsMappedFile) {
+    UploadBody body = dataapi::http::mappedFileBody(path);
+    EXPECT_EQ(body.length, static_cast<int64_t>(content.size()));
+    EXPECT_EQ(drain(body, 1000), content);
+}
+
+TEST_F(UploadBodyTest, MapsEmptyFile) {
+    std::ofstream(path, std::ios::binary | std::ios::trunc);
+    UploadBody body = dataapi::http::mappedFileBody(path);
+    EXPECT_EQ(body.length, 0);
+    EXPECT_EQ(drain(body, 16), "");
+}
+
+TEST_F(UploadBodyTest, ThrowsForMissingFile) {
+    EXPECT_THROW(dataapi::http::fileBody(path + ".missing"), std::runtime_error);
+    EXPECT_THROW(dataapi::http::mappedFileBody(path + ".missing"), std::runtime_error);
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <utility>
+#include <vector>
+#include "dataapi/utils/UrlUtils.h"
+
+using dataapi::utils::UrlUtils;
+
+TEST(UrlUtilsTest, EncodesReservedAndNonAsciiBytes) {
+    EXPECT_EQ(UrlUtils::encode("abcXYZ019-_.~"), "abcXYZ019-_.~");
+    EXPECT_EQ(UrlUtils::encode("a b&c=d/e?"), "a%20b%26c%3Dd%2Fe%3F");
+    EXPECT_EQ(UrlUtils::encode("\xE4\xB8\xAD"), "%E4%B8%AD");
+    EXPECT_EQ(UrlUtils::encode(""), "");
+}
+
+TEST(UrlUtilsTest, AppendsToExistingBuffer) {
+    std::string url = "/users?";
+    UrlUtils::appendEncoded(url, "a+b");
+    EXPECT_EQ(url, "/users?a%2Bb");
+}
+
+TEST(UrlUtilsTest, BuildsAndParsesQueryString) {
+    dataapi::utils::Parameters params{{"size", "20"}, {"page", "1"}, {"search", "a b"}};
+    std::string query = UrlUtils::buildQueryString(params);
+    EXPECT_EQ(query, "page=1&search=a%20b&size=20");
+    EXPECT_EQ(UrlUtils::parseQueryString(query), params);
+    EXPECT_EQ(UrlUtils::buildQueryString({}), "");
+
+    std::string url = "/workflows?";
+    UrlUtils::appendQueryString(url, {{"projectId", "p/1"}});
+    EXPECT_EQ(url, "/workflows?projectId=p%2F1");
+}
+
+TEST(UrlUtilsTest, EncodesLongValuesAcrossBlocks) {
+    std::string value;
+    std::string expected;
+    for (int i = 0; i < 40; ++i) {
+        value += "abcdefghij0123456789"[i % 20];
+        expected += "abcdefghij0123456789"[i % 20];
+        if (i % 7 == 0) {
+            value += '/';
+            expected += "%2F";
+        }
+    }
+    value += std::string(33, '~') + " ";
+    expected += std::string(33, '~') + "%20";
+    EXPECT_EQ(UrlUtils::encodedSize(value), expected.size());
+    EXPECT_EQ(UrlUtils::encode(value), expected);
+    EXPECT_EQ(UrlUtils::decode(expected), value);
+
+    std::string binary;
+    for (int c = 0; c < 256; ++c) {
+        binary += static_cast<char>(c);
+    }
+    EXPECT_EQ(UrlUtils::decode(UrlUtils::encode(binary)), binary);
+}
+
+TEST(UrlUtilsTest, DecodesPlusAndKeepsMalformedEscapes) {
+    EXPECT_EQ(UrlUtils::decode("a+b%20c%2fd"), "a b c/d");
+    EXPECT_EQ(UrlUtils::decode("100%"), "100%");
+    EXPECT_EQ(UrlUtils::decode("%zz%4"), "%zz%4");
+    EXPECT_EQ(UrlUtils::decode(""), "");
+
+    std::string out = "q=";
+    UrlUtils::appendDecoded(out, "%E4%B8%AD+x");
+    EXPECT_EQ(out, "q=\xE4\xB8\xAD x");
+}
+
+TEST(UrlUtilsTest, VisitsQueryParamsWithoutDecoding) {
+    std::vector<std::pair<std::string, std::string>> seen;
+    UrlUtils::forEachQueryParam("?a=1&flag&b=x%20y&=empty", [&seen](std::string_view key, std::string_view value) {
+        seen.emplace_back(key, value);
+    });
+    EXPECT_EQ(seen, (std::vector<std::pair<std::string, std::string>>{{"a", "1"}, {"b", "x%20y"}, {"", "empty"}}));
+    EXPECT_EQ(UrlUtils::parseQueryString("?b=x%20y&b=2"), (dataapi::utils::Parameters{{"b", "2"}}));
+}
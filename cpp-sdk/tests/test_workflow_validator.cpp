@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include "dataapi/client/WorkflowClient.h"
+#include "dataapi/http/Transport.h"
+
+using namespace dataapi;
+using namespace dataapi::client;
+using namespace dataapi::http;
+
+namespace {
+
+const char* kSchema = R"({
+    "type": "object",
+    "required": ["nodes", "edges"],
+    "additionalProperties": false,
+    "properties": {
+        "name": {"type": "string", "minLength": 1, "maxLength": 4},
+        "nodes": {"type": "array", "minItems": 1, "items": {"$ref": "#/definitions/node"}},
+        "edges": {
+            "type": "array",
+            "items": {"type": "array", "minItems": 2, "maxItems": 2, "items": {"type": "string"}}
+        },
+        "timeout": {"type": "number", "exclusiveMinimum": 0, "maximum": 3600}
+    },
+    "definitions": {
+        "node": {
+            "type": "object",
+            "required": ["id", "type"],
+            "properties": {
+                "id": {"type": "string", "pattern": "^[a-z][a-z0-9_]*$"},
+                "type": {"enum": ["trigger", "query", "subflow"]},
+                "retries": {"type": "integer", "minimum": 0},
+                "children": {"type": "array", "items": {"$ref": "#/definitions/node"}},
+                "config": {
+                    "oneOf": [
+                        {"type": "object", "required": ["sql"]},
+                        {"type": "object", "required": ["url"]}
+                    ]
+                }
+            }
+        }
+    }
+})";
+
+Json validDefinition() {
+    return Json::parse(R"({
+        "name": "etl",
+        "nodes": [
+            {"id": "start", "type": "trigger"},
+            {"id": "load", "type": "query", "retries": 2, "config": {"sql": "SELECT 1"}},
+            {"id": "sub", "type": "subflow", "children": [{"id": "inner", "type": "query"}]}
+        ],
+        "edges": [["start", "load"], ["load", "sub"]]
+    })");
+}
+
+std::shared_ptr<const WorkflowSchema> compiledSchema() {
+    return WorkflowSchema::compile(Json::parse(kSchema));
+}
+
+} // namespace
+
+TEST(WorkflowValidatorTest, ValidatesWholeDefinition) {
+    WorkflowValidator validator(compiledSchema());
+    auto result = validator.validate(validDefinition());
+    EXPECT_TRUE(result.isValid);
+    EXPECT_TRUE(result.errors.empty());
+
+    Json definition = validDefinition();
+    definition["name"] = "too long";
+    definition["extra"] = true;
+    definition["timeout"] = 0;
+    definition["nodes"][0]["id"] = "Start";
+    definition["nodes"][1]["retries"] = 1.5;
+    definition["nodes"][1]["config"] = {{"sql", "x"}, {"url", "y"}};
+    definition["nodes"][2]["children"][0].erase("type");
+    definition["edges"][1] = {"load"};
+    result = validator.validate(definition);
+    EXPECT_FALSE(result.isValid);
+    EXPECT_EQ(result.errors, (std::vector<std::string>{
+        "#: property 'extra' is not allowed",
+        "#/edges/1: expected at least 2 items",
+        "#/name: expected at most 4 characters",
+        "#/nodes/0/id: value does not match pattern ^[a-z][a-z0-9_]*$",
+        "#/nodes/1/config: value matches more than one of the exclusive schemas",
+        "#/nodes/1/retries: expected integer, got number",
+        "#/nodes/2/children/0: missing required property 'type'",
+        "#/timeout: expected a value > 0",
+    }));
+}
+
+TEST(WorkflowValidatorTest, RevalidatesOnlyChangedSubtrees) {
+    WorkflowValidator validator(compiledSchema());
+    Json definition = validDefinition();
+    validator.validate(definition);
+
+    // 未列出的位置不重新检查
+    definition["nodes"][0]["id"] = "Bad";
+    definition["nodes"][1]["type"] = "unknown";
+    auto result = validator.revalidate(definition, {"/nodes/1/type"});
+    EXPECT_EQ(result.errors, (std::vector<std::string>{"#/nodes/1/type: value is not one of the allowed values"}));
+
+    result = validator.revalidate(definition, {"/nodes/0"});
+    EXPECT_EQ(result.errors.size(), 2u);
+
+    // 修正后只清除对应子树的错误
+    definition["nodes"][1]["type"] = "query";
+    result = validator.revalidate(definition, {"/nodes/1/type"});
+    EXPECT_EQ(result.errors, (std::vector<std::string>{"#/nodes/0/id: value does not match pattern ^[a-z][a-z0-9_]*$"}));
+
+    // 删除的属性由祖先的required检查发现
+    definition["nodes"][0].erase("id");
+    result = validator.revalidate(definition, {"/nodes/0/id"});
+    EXPECT_EQ(result.errors, (std::vector<std::string>{"#/nodes/0: missing required property 'id'"}));
+
+    definition["nodes"][0]["id"] = "start";
+    definition["nodes"].push_back({{"id", "x"}});
+    result = validator.revalidate(definition, {"/nodes/0/id", "/nodes"});
+    EXPECT_EQ(result.errors, (std::vector<std::string>{"#/nodes/3: missing required property 'type'"}));
+    EXPECT_EQ(result.errors, validator.validate(definition).errors);
+}
+
+TEST(WorkflowValidatorTest, FallsBackToFullValidationThroughCombinators) {
+    WorkflowValidator validator(compiledSchema());
+    Json definition = validDefinition();
+    validator.validate(definition);
+
+    // config的Schema是oneOf，其子树的位置无法单独确定
+    definition["nodes"][1]["config"]["sql"] = 1;
+    definition["nodes"][1]["config"]["url"] = "u";
+    definition["name"] = "";
+    auto result = validator.revalidate(definition, {"/nodes/1/config/url"});
+    EXPECT_EQ(result.errors, (std::vector<std::string>{
+        "#/name: expected at least 1 characters",
+        "#/nodes/1/config: value matches more than one of the exclusive schemas",
+    }));
+}
+
+TEST(WorkflowValidatorTest, RejectsInvalidSchemas) {
+    EXPECT_THROW(WorkflowSchema::compile(Json::parse(R"({"$ref": "#/definitions/missing"})")), std::invalid_argument);
+    EXPECT_THROW(WorkflowSchema::compile(Json::parse(R"({"type": "text"})")), std::invalid_argument);
+    EXPECT_THROW(WorkflowSchema::compile(Json::parse(R"({"pattern": "(["})")), std::invalid_argument);
+    EXPECT_THROW(WorkflowSchema::compile(Json::parse(R"({"definitions": {"a": {"allOf": [{"$ref": "#/definitions/a"}]}},
+                                                        "$ref": "#/definitions/a"})")), std::invalid_argument);
+    EXPECT_THROW(WorkflowSchema::compile(Json::parse(R"({"$ref": "https://example.com/schema"})")), std::invalid_argument);
+
+    // 递归定义只编译一次
+    auto schema = compiledSchema();
+    EXPECT_EQ(schema->size(), 17u);
+
+    std::vector<WorkflowSchema::Issue> issues;
+    WorkflowSchema::compile(Json(false))->validate(Json::object(), issues);
+    ASSERT_EQ(issues.size(), 1u);
+    EXPECT_EQ(issues[0].message, "value is not allowed");
+}
+
+TEST(WorkflowValidatorTest, FetchesSchemaOncePerCache) {
+    std::atomic<int> requests{0};
+    ClientConfig config("http://sidecar/api");
+    config.maxRetries = 0;
+    config.transport = std::make_shared<InMemoryTransport>([&requests](const TransportRequest& request) {
+        ++requests;
+        EXPECT_EQ(request.url, "http://sidecar/api/workflows/schema");
+        HttpResponse response;
+        response.statusCode = 200;
+        response.body = kSchema;
+        return response;
+    });
+    WorkflowClient client(std::make_shared<HttpClient>(config, nullptr));
+    client.setMetadataCache(std::make_shared<MetadataCache>());
+
+    auto first = client.createValidator();
+    auto second = client.createValidator();
+    EXPECT_EQ(requests.load(), 1);
+    EXPECT_EQ(first.getSchema(), second.getSchema());
+    EXPECT_TRUE(second.validate(validDefinition()).isValid);
+}
+
+TEST(WorkflowValidatorTest, KeepsCompiledSchemaWithoutMetadataCache) {
+    auto transport = std::make_shared<InMemoryTransport>([](const TransportRequest&) {
+        HttpResponse response;
+        response.statusCode = 200;
+        response.body = kSchema;
+        return response;
+    });
+    ClientConfig config("http://sidecar/api");
+    config.transport = transport;
+    WorkflowClient client(std::make_shared<HttpClient>(config, nullptr));
+
+    auto first = client.createValidator();
+    auto second = client.createValidator();
+    EXPECT_EQ(transport->getRequestCount(), 1u);
+    EXPECT_EQ(first.getSchema(), second.getSchema());
+}